@@ -0,0 +1,224 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "actions.h"
+
+namespace benchmarks::actions {
+
+    const std::vector<ActionDesc> GameplayActions = {
+        {"trigger_value", XR_ACTION_TYPE_FLOAT_INPUT},
+        {"trigger_click", XR_ACTION_TYPE_BOOLEAN_INPUT},
+        {"trigger_touch", XR_ACTION_TYPE_BOOLEAN_INPUT},
+        {"squeeze_value", XR_ACTION_TYPE_FLOAT_INPUT},
+        {"squeeze_force", XR_ACTION_TYPE_FLOAT_INPUT},
+        {"thumbstick", XR_ACTION_TYPE_VECTOR2F_INPUT},
+        {"thumbstick_click", XR_ACTION_TYPE_BOOLEAN_INPUT},
+        {"thumbstick_touch", XR_ACTION_TYPE_BOOLEAN_INPUT},
+        {"trackpad", XR_ACTION_TYPE_VECTOR2F_INPUT},
+        {"trackpad_click", XR_ACTION_TYPE_BOOLEAN_INPUT},
+        {"trackpad_touch", XR_ACTION_TYPE_BOOLEAN_INPUT},
+        {"primary_click", XR_ACTION_TYPE_BOOLEAN_INPUT},
+        {"primary_touch", XR_ACTION_TYPE_BOOLEAN_INPUT},
+        {"secondary_click", XR_ACTION_TYPE_BOOLEAN_INPUT},
+        {"secondary_touch", XR_ACTION_TYPE_BOOLEAN_INPUT},
+        {"menu", XR_ACTION_TYPE_BOOLEAN_INPUT},
+        {"grip_pose", XR_ACTION_TYPE_POSE_INPUT},
+        {"aim_pose", XR_ACTION_TYPE_POSE_INPUT},
+        {"haptic", XR_ACTION_TYPE_VIBRATION_OUTPUT},
+    };
+
+    const std::vector<InteractionProfile> InteractionProfiles = {
+        {"Touch",
+         "/interaction_profiles/oculus/touch_controller",
+         {
+             {"trigger_value", "input/trigger/value"},
+             {"trigger_click", "input/trigger/value"},
+             {"trigger_touch", "input/trigger/touch"},
+             {"squeeze_value", "input/squeeze/value"},
+             {"thumbstick", "input/thumbstick"},
+             {"thumbstick_click", "input/thumbstick/click"},
+             {"thumbstick_touch", "input/thumbstick/touch"},
+             {"primary_click", "input/x/click", "input/a/click"},
+             {"primary_touch", "input/x/touch", "input/a/touch"},
+             {"secondary_click", "input/y/click", "input/b/click"},
+             {"secondary_touch", "input/y/touch", "input/b/touch"},
+             {"menu", "input/menu/click", ""},
+             {"grip_pose", "input/grip/pose"},
+             {"aim_pose", "input/aim/pose"},
+             {"haptic", "output/haptic"},
+         }},
+        {"Index",
+         "/interaction_profiles/valve/index_controller",
+         {
+             {"trigger_value", "input/trigger/value"},
+             {"trigger_click", "input/trigger/click"},
+             {"trigger_touch", "input/trigger/touch"},
+             {"squeeze_value", "input/squeeze/value"},
+             {"squeeze_force", "input/squeeze/force"},
+             {"thumbstick", "input/thumbstick"},
+             {"thumbstick_click", "input/thumbstick/click"},
+             {"thumbstick_touch", "input/thumbstick/touch"},
+             {"trackpad", "input/trackpad"},
+             {"trackpad_click", "input/trackpad/force"},
+             {"trackpad_touch", "input/trackpad/touch"},
+             {"primary_click", "input/a/click"},
+             {"primary_touch", "input/a/touch"},
+             {"secondary_click", "input/b/click"},
+             {"secondary_touch", "input/b/touch"},
+             {"menu", "input/system/click"},
+             {"grip_pose", "input/grip/pose"},
+             {"aim_pose", "input/aim/pose"},
+             {"haptic", "output/haptic"},
+         }},
+        {"WMR",
+         "/interaction_profiles/microsoft/motion_controller",
+         {
+             {"trigger_value", "input/trigger/value"},
+             {"trigger_click", "input/trigger/value"},
+             {"squeeze_value", "input/squeeze/click"},
+             {"thumbstick", "input/thumbstick"},
+             {"thumbstick_click", "input/thumbstick/click"},
+             {"trackpad", "input/trackpad"},
+             {"trackpad_click", "input/trackpad/click"},
+             {"trackpad_touch", "input/trackpad/touch"},
+             {"menu", "input/menu/click"},
+             {"grip_pose", "input/grip/pose"},
+             {"aim_pose", "input/aim/pose"},
+             {"haptic", "output/haptic"},
+         }},
+        {"Vive",
+         "/interaction_profiles/htc/vive_controller",
+         {
+             {"trigger_value", "input/trigger/value"},
+             {"trigger_click", "input/trigger/click"},
+             {"squeeze_value", "input/squeeze/click"},
+             {"trackpad", "input/trackpad"},
+             {"trackpad_click", "input/trackpad/click"},
+             {"trackpad_touch", "input/trackpad/touch"},
+             {"menu", "input/menu/click"},
+             {"grip_pose", "input/grip/pose"},
+             {"aim_pose", "input/aim/pose"},
+             {"haptic", "output/haptic"},
+         }},
+        {"Simple",
+         "/interaction_profiles/khr/simple_controller",
+         {
+             {"trigger_click", "input/select/click"},
+             {"menu", "input/menu/click"},
+             {"grip_pose", "input/grip/pose"},
+             {"aim_pose", "input/aim/pose"},
+             {"haptic", "output/haptic"},
+         }},
+    };
+
+    ActionSet::ActionSet(const client::Client& client, const std::string& name, uint32_t priority, uint32_t copies)
+        : m_client(client), m_copies(copies) {
+        const auto& xr = client.dispatch();
+
+        XrActionSetCreateInfo actionSetCreateInfo{XR_TYPE_ACTION_SET_CREATE_INFO};
+        strcpy_s(actionSetCreateInfo.actionSetName, name.c_str());
+        strcpy_s(actionSetCreateInfo.localizedActionSetName, name.c_str());
+        actionSetCreateInfo.priority = priority;
+        CHECK_XRCMD(xr.xrCreateActionSet(client.getInstance(), &actionSetCreateInfo, &m_actionSet));
+
+        const XrPath subactionPaths[] = {client.getPath("/user/hand/left"), client.getPath("/user/hand/right")};
+        for (uint32_t copy = 0; copy < copies; copy++) {
+            for (const auto& desc : GameplayActions) {
+                const std::string actionName = copy ? fmt::format("{}_{}", desc.name, copy) : desc.name;
+
+                XrActionCreateInfo actionCreateInfo{XR_TYPE_ACTION_CREATE_INFO};
+                strcpy_s(actionCreateInfo.actionName, actionName.c_str());
+                strcpy_s(actionCreateInfo.localizedActionName, actionName.c_str());
+                actionCreateInfo.actionType = desc.type;
+                actionCreateInfo.countSubactionPaths = (uint32_t)std::size(subactionPaths);
+                actionCreateInfo.subactionPaths = subactionPaths;
+                XrAction action;
+                CHECK_XRCMD(xr.xrCreateAction(m_actionSet, &actionCreateInfo, &action));
+
+                m_actionsByName.insert_or_assign(actionName, action);
+                m_actions.push_back({action, desc.type});
+            }
+        }
+    }
+
+    ActionSet::~ActionSet() {
+        // This also destroys the actions.
+        if (m_actionSet != XR_NULL_HANDLE) {
+            m_client.dispatch().xrDestroyActionSet(m_actionSet);
+        }
+    }
+
+    std::vector<XrActionSuggestedBinding> ActionSet::getSuggestedBindings(const InteractionProfile& profile) const {
+        std::vector<XrActionSuggestedBinding> suggestedBindings;
+        for (uint32_t copy = 0; copy < m_copies; copy++) {
+            for (const auto& binding : profile.bindings) {
+                const XrAction action = getAction(binding.action, copy);
+                if (binding.left && binding.left[0]) {
+                    suggestedBindings.push_back(
+                        {action, m_client.getPath(std::string("/user/hand/left/") + binding.left)});
+                }
+                const char* right = binding.right ? binding.right : binding.left;
+                if (right && right[0]) {
+                    suggestedBindings.push_back({action, m_client.getPath(std::string("/user/hand/right/") + right)});
+                }
+            }
+        }
+        return suggestedBindings;
+    }
+
+    XrAction ActionSet::getAction(const std::string& name, uint32_t copy) const {
+        const auto it = m_actionsByName.find(copy ? fmt::format("{}_{}", name, copy) : name);
+        CHECK_MSG(it != m_actionsByName.cend(), fmt::format("Unknown action {}", name));
+        return it->second;
+    }
+
+    void SuggestBindings(const client::Client& client,
+                         const std::vector<const ActionSet*>& actionSets,
+                         const InteractionProfile& profile) {
+        std::vector<XrActionSuggestedBinding> suggestedBindings;
+        for (const auto actionSet : actionSets) {
+            const auto bindings = actionSet->getSuggestedBindings(profile);
+            suggestedBindings.insert(suggestedBindings.end(), bindings.cbegin(), bindings.cend());
+        }
+
+        XrInteractionProfileSuggestedBinding suggestion{XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
+        suggestion.interactionProfile = client.getPath(profile.path);
+        suggestion.countSuggestedBindings = (uint32_t)suggestedBindings.size();
+        suggestion.suggestedBindings = suggestedBindings.data();
+        CHECK_XRCMD(client.dispatch().xrSuggestInteractionProfileBindings(client.getInstance(), &suggestion));
+    }
+
+    void AttachActionSets(const client::Client& client, const std::vector<const ActionSet*>& actionSets) {
+        std::vector<XrActionSet> handles;
+        for (const auto actionSet : actionSets) {
+            handles.push_back(actionSet->getHandle());
+        }
+
+        XrSessionActionSetsAttachInfo attachInfo{XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO};
+        attachInfo.countActionSets = (uint32_t)handles.size();
+        attachInfo.actionSets = handles.data();
+        CHECK_XRCMD(client.dispatch().xrAttachSessionActionSets(client.getSession(), &attachInfo));
+    }
+
+} // namespace benchmarks::actions
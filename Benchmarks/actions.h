@@ -0,0 +1,87 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "client.h"
+
+namespace benchmarks::actions {
+
+    struct ActionDesc {
+        const char* name;
+        XrActionType type;
+    };
+
+    // Binding of an action for both hands. The path is relative to /user/hand/<side>/. When right is null, the same
+    // path is used for both hands. An empty path leaves the action unbound for that hand.
+    struct Binding {
+        const char* action;
+        const char* left;
+        const char* right{nullptr};
+    };
+
+    struct InteractionProfile {
+        const char* name;
+        const char* path;
+        std::vector<Binding> bindings;
+    };
+
+    // A typical set of actions for a game, bound on both hands.
+    extern const std::vector<ActionDesc> GameplayActions;
+
+    // The full suggestions that a game typically makes for the most common controllers.
+    extern const std::vector<InteractionProfile> InteractionProfiles;
+
+    class ActionSet {
+      public:
+        // Replicate the gameplay actions the specified number of times, to emulate games with large action sets.
+        ActionSet(const client::Client& client, const std::string& name, uint32_t priority = 0, uint32_t copies = 1);
+        ~ActionSet();
+
+        std::vector<XrActionSuggestedBinding> getSuggestedBindings(const InteractionProfile& profile) const;
+
+        XrActionSet getHandle() const {
+            return m_actionSet;
+        }
+
+        XrAction getAction(const std::string& name, uint32_t copy = 0) const;
+
+        const std::vector<std::pair<XrAction, XrActionType>>& getActions() const {
+            return m_actions;
+        }
+
+      private:
+        const client::Client& m_client;
+        XrActionSet m_actionSet{XR_NULL_HANDLE};
+        std::map<std::string, XrAction> m_actionsByName;
+        std::vector<std::pair<XrAction, XrActionType>> m_actions;
+        uint32_t m_copies;
+    };
+
+    // The bindings of all the action sets for a given interaction profile must be suggested in a single call.
+    void SuggestBindings(const client::Client& client,
+                         const std::vector<const ActionSet*>& actionSets,
+                         const InteractionProfile& profile);
+
+    void AttachActionSets(const client::Client& client, const std::vector<const ActionSet*>& actionSets);
+
+} // namespace benchmarks::actions
@@ -0,0 +1,502 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "benchmarks.h"
+
+namespace benchmarks {
+
+    using namespace benchmarks::harness;
+
+    Fixture::Fixture(client::Client& client) : m_client(client) {
+    }
+
+    const actions::ActionSet& Fixture::getActionSet() {
+        if (!m_actionSet) {
+            m_actionSet = std::make_unique<actions::ActionSet>(m_client, "gameplay");
+            for (const auto& profile : actions::InteractionProfiles) {
+                actions::SuggestBindings(m_client, {m_actionSet.get()}, profile);
+            }
+        }
+        return *m_actionSet;
+    }
+
+    void Fixture::resetSession() {
+        m_client.destroySession();
+        m_client.createSession();
+        m_isAttached = false;
+        m_actionSpaces.clear();
+    }
+
+    void Fixture::ensureFocusedSession() {
+        const auto& actionSet = getActionSet();
+        if (m_client.getSession() == XR_NULL_HANDLE) {
+            resetSession();
+        }
+        if (!m_isAttached) {
+            actions::AttachActionSets(m_client, {&actionSet});
+            m_isAttached = true;
+        }
+        m_client.waitForFocus();
+
+        // Let the runtime bind the actions to the current controllers.
+        XrActiveActionSet activeActionSet{actionSet.getHandle(), XR_NULL_PATH};
+        XrActionsSyncInfo syncInfo{XR_TYPE_ACTIONS_SYNC_INFO};
+        syncInfo.countActiveActionSets = 1;
+        syncInfo.activeActionSets = &activeActionSet;
+        CHECK_XRCMD(m_client.dispatch().xrSyncActions(m_client.getSession(), &syncInfo));
+    }
+
+    const std::vector<XrSpace>& Fixture::getActionSpaces() {
+        ensureFocusedSession();
+        if (m_actionSpaces.empty()) {
+            const auto& actionSet = getActionSet();
+            for (const char* action : {"grip_pose", "aim_pose"}) {
+                for (const char* hand : {"/user/hand/left", "/user/hand/right"}) {
+                    XrActionSpaceCreateInfo createInfo{XR_TYPE_ACTION_SPACE_CREATE_INFO};
+                    createInfo.action = actionSet.getAction(action);
+                    createInfo.subactionPath = m_client.getPath(hand);
+                    createInfo.poseInActionSpace.orientation.w = 1.f;
+                    XrSpace space;
+                    CHECK_XRCMD(m_client.dispatch().xrCreateActionSpace(m_client.getSession(), &createInfo, &space));
+                    m_actionSpaces.push_back(space);
+                }
+            }
+        }
+        return m_actionSpaces;
+    }
+
+    XrTime Fixture::runFrame() {
+        const XrTime displayTime = m_client.beginFrame();
+        m_client.endFrame(displayTime);
+        return displayTime;
+    }
+
+    namespace {
+
+        void BM_StringToPath(State& state, Fixture& fixture) {
+            auto& client = fixture.getClient();
+
+            // The paths that a game typically queries: subaction paths, interaction profiles and bindings.
+            std::vector<std::string> paths = {"/user/hand/left", "/user/hand/right", "/user/head", "/user/gamepad"};
+            for (const auto& profile : actions::InteractionProfiles) {
+                paths.push_back(profile.path);
+                for (const auto& binding : profile.bindings) {
+                    if (binding.left[0]) {
+                        paths.push_back(std::string("/user/hand/left/") + binding.left);
+                    }
+                }
+            }
+            state.setCounter("paths", (double)paths.size());
+
+            size_t i = 0;
+            XrPath path;
+            while (state.keepRunning()) {
+                CHECK_XRCMD(client.dispatch().xrStringToPath(client.getInstance(), paths[i].c_str(), &path));
+                i = (i + 1) % paths.size();
+            }
+        }
+
+        void BM_SuggestInteractionProfileBindings(State& state,
+                                                  Fixture& fixture,
+                                                  const actions::InteractionProfile& profile) {
+            auto& client = fixture.getClient();
+            const auto& actionSet = fixture.getActionSet();
+
+            // Suggestions are only accepted until the action sets are attached.
+            fixture.resetSession();
+
+            const auto suggestedBindings = actionSet.getSuggestedBindings(profile);
+            XrInteractionProfileSuggestedBinding suggestion{XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
+            suggestion.interactionProfile = client.getPath(profile.path);
+            suggestion.countSuggestedBindings = (uint32_t)suggestedBindings.size();
+            suggestion.suggestedBindings = suggestedBindings.data();
+            state.setCounter("bindings", (double)suggestedBindings.size());
+
+            while (state.keepRunning()) {
+                CHECK_XRCMD(client.dispatch().xrSuggestInteractionProfileBindings(client.getInstance(), &suggestion));
+            }
+        }
+
+        void BM_AttachSessionActionSets(State& state, Fixture& fixture) {
+            auto& client = fixture.getClient();
+            const auto& actionSet = fixture.getActionSet();
+
+            while (state.keepRunning()) {
+                // Action sets can only be attached once per session.
+                state.pauseTiming();
+                fixture.resetSession();
+                state.resumeTiming();
+
+                actions::AttachActionSets(client, {&actionSet});
+            }
+
+            // Leave the session in a usable state for the next benchmarks.
+            fixture.resetSession();
+        }
+
+        void BM_SyncActions(State& state, Fixture& fixture) {
+            auto& client = fixture.getClient();
+            fixture.ensureFocusedSession();
+
+            XrActiveActionSet activeActionSet{fixture.getActionSet().getHandle(), XR_NULL_PATH};
+            XrActionsSyncInfo syncInfo{XR_TYPE_ACTIONS_SYNC_INFO};
+            syncInfo.countActiveActionSets = 1;
+            syncInfo.activeActionSets = &activeActionSet;
+            state.setCounter("actions", (double)fixture.getActionSet().getActions().size());
+
+            while (state.keepRunning()) {
+                CHECK_XRCMD(client.dispatch().xrSyncActions(client.getSession(), &syncInfo));
+            }
+        }
+
+        template <typename TState, typename TGetActionState>
+        void BM_GetActionState(State& state,
+                               Fixture& fixture,
+                               const char* action,
+                               XrStructureType type,
+                               TGetActionState getActionState) {
+            auto& client = fixture.getClient();
+            fixture.ensureFocusedSession();
+
+            XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
+            getInfo.action = fixture.getActionSet().getAction(action);
+            getInfo.subactionPath = client.getPath("/user/hand/left");
+            TState actionState{type};
+
+            while (state.keepRunning()) {
+                CHECK_XRCMD(getActionState(client.getSession(), &getInfo, &actionState));
+            }
+        }
+
+        void BM_LocateSpace(State& state, Fixture& fixture, bool useActionSpace) {
+            auto& client = fixture.getClient();
+            const XrSpace space = useActionSpace ? fixture.getActionSpaces()[0] : client.getViewSpace();
+            const XrTime time = fixture.runFrame();
+
+            XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
+            while (state.keepRunning()) {
+                CHECK_XRCMD(client.dispatch().xrLocateSpace(space, client.getLocalSpace(), time, &location));
+            }
+        }
+
+        void BM_LocateSpaces(State& state, Fixture& fixture) {
+            auto& client = fixture.getClient();
+            if (!client.isExtensionEnabled(XR_KHR_LOCATE_SPACES_EXTENSION_NAME)) {
+                state.skip(XR_KHR_LOCATE_SPACES_EXTENSION_NAME " is not supported");
+                return;
+            }
+
+            std::vector<XrSpace> spaces = fixture.getActionSpaces();
+            spaces.push_back(client.getViewSpace());
+            const XrTime time = fixture.runFrame();
+
+            XrSpacesLocateInfoKHR locateInfo{XR_TYPE_SPACES_LOCATE_INFO_KHR};
+            locateInfo.baseSpace = client.getLocalSpace();
+            locateInfo.time = time;
+            locateInfo.spaceCount = (uint32_t)spaces.size();
+            locateInfo.spaces = spaces.data();
+            std::vector<XrSpaceLocationDataKHR> locationData(spaces.size());
+            XrSpaceLocationsKHR locations{XR_TYPE_SPACE_LOCATIONS_KHR};
+            locations.locationCount = (uint32_t)locationData.size();
+            locations.locations = locationData.data();
+            state.setCounter("spaces", (double)spaces.size());
+
+            while (state.keepRunning()) {
+                CHECK_XRCMD(client.dispatch().xrLocateSpacesKHR(client.getSession(), &locateInfo, &locations));
+            }
+        }
+
+        void BM_LocateViews(State& state, Fixture& fixture) {
+            auto& client = fixture.getClient();
+            fixture.ensureFocusedSession();
+            const XrTime time = fixture.runFrame();
+
+            XrViewLocateInfo locateInfo{XR_TYPE_VIEW_LOCATE_INFO};
+            locateInfo.viewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+            locateInfo.displayTime = time;
+            locateInfo.space = client.getLocalSpace();
+            XrViewState viewState{XR_TYPE_VIEW_STATE};
+            XrView views[2]{{XR_TYPE_VIEW}, {XR_TYPE_VIEW}};
+            uint32_t count;
+
+            while (state.keepRunning()) {
+                CHECK_XRCMD(client.dispatch().xrLocateViews(
+                    client.getSession(), &locateInfo, &viewState, (uint32_t)std::size(views), &count, views));
+            }
+        }
+
+        void BM_LocateHandJoints(State& state, Fixture& fixture) {
+            auto& client = fixture.getClient();
+            if (!client.isExtensionEnabled(XR_EXT_HAND_TRACKING_EXTENSION_NAME)) {
+                state.skip(XR_EXT_HAND_TRACKING_EXTENSION_NAME " is not supported");
+                return;
+            }
+            fixture.ensureFocusedSession();
+
+            XrHandTrackerCreateInfoEXT createInfo{XR_TYPE_HAND_TRACKER_CREATE_INFO_EXT};
+            createInfo.hand = XR_HAND_LEFT_EXT;
+            createInfo.handJointSet = XR_HAND_JOINT_SET_DEFAULT_EXT;
+            XrHandTrackerEXT handTracker;
+            const XrResult result =
+                client.dispatch().xrCreateHandTrackerEXT(client.getSession(), &createInfo, &handTracker);
+            if (XR_FAILED(result)) {
+                state.skip(fmt::format("xrCreateHandTrackerEXT failed with {}", (int)result));
+                return;
+            }
+            auto scopeGuard = MakeScopeGuard([&] { client.dispatch().xrDestroyHandTrackerEXT(handTracker); });
+
+            const XrTime time = fixture.runFrame();
+            XrHandJointsLocateInfoEXT locateInfo{XR_TYPE_HAND_JOINTS_LOCATE_INFO_EXT};
+            locateInfo.baseSpace = client.getLocalSpace();
+            locateInfo.time = time;
+            XrHandJointLocationEXT jointLocations[XR_HAND_JOINT_COUNT_EXT];
+            XrHandJointVelocityEXT jointVelocities[XR_HAND_JOINT_COUNT_EXT];
+            XrHandJointVelocitiesEXT velocities{XR_TYPE_HAND_JOINT_VELOCITIES_EXT};
+            velocities.jointCount = XR_HAND_JOINT_COUNT_EXT;
+            velocities.jointVelocities = jointVelocities;
+            XrHandJointLocationsEXT locations{XR_TYPE_HAND_JOINT_LOCATIONS_EXT, &velocities};
+            locations.jointCount = XR_HAND_JOINT_COUNT_EXT;
+            locations.jointLocations = jointLocations;
+
+            while (state.keepRunning()) {
+                CHECK_XRCMD(client.dispatch().xrLocateHandJointsEXT(handTracker, &locateInfo, &locations));
+            }
+        }
+
+        void BM_LocateBodyJoints(State& state, Fixture& fixture) {
+            auto& client = fixture.getClient();
+            if (!client.isExtensionEnabled(XR_FB_BODY_TRACKING_EXTENSION_NAME)) {
+                state.skip(XR_FB_BODY_TRACKING_EXTENSION_NAME " is not supported");
+                return;
+            }
+            fixture.ensureFocusedSession();
+
+            XrBodyTrackerCreateInfoFB createInfo{XR_TYPE_BODY_TRACKER_CREATE_INFO_FB};
+            createInfo.bodyJointSet = XR_BODY_JOINT_SET_DEFAULT_FB;
+            XrBodyTrackerFB bodyTracker;
+            const XrResult result =
+                client.dispatch().xrCreateBodyTrackerFB(client.getSession(), &createInfo, &bodyTracker);
+            if (XR_FAILED(result)) {
+                state.skip(fmt::format("xrCreateBodyTrackerFB failed with {}", (int)result));
+                return;
+            }
+            auto scopeGuard = MakeScopeGuard([&] { client.dispatch().xrDestroyBodyTrackerFB(bodyTracker); });
+
+            const XrTime time = fixture.runFrame();
+            XrBodyJointsLocateInfoFB locateInfo{XR_TYPE_BODY_JOINTS_LOCATE_INFO_FB};
+            locateInfo.baseSpace = client.getLocalSpace();
+            locateInfo.time = time;
+            XrBodyJointLocationFB jointLocations[XR_BODY_JOINT_COUNT_FB];
+            XrBodyJointLocationsFB locations{XR_TYPE_BODY_JOINT_LOCATIONS_FB};
+            locations.jointCount = XR_BODY_JOINT_COUNT_FB;
+            locations.jointLocations = jointLocations;
+
+            while (state.keepRunning()) {
+                CHECK_XRCMD(client.dispatch().xrLocateBodyJointsFB(bodyTracker, &locateInfo, &locations));
+            }
+        }
+
+        void BM_GetVisibilityMask(State& state, Fixture& fixture) {
+            auto& client = fixture.getClient();
+            if (!client.isExtensionEnabled(XR_KHR_VISIBILITY_MASK_EXTENSION_NAME)) {
+                state.skip(XR_KHR_VISIBILITY_MASK_EXTENSION_NAME " is not supported");
+                return;
+            }
+            fixture.ensureFocusedSession();
+
+            std::vector<XrVector2f> vertices;
+            std::vector<uint32_t> indices;
+            while (state.keepRunning()) {
+                // Applications query the size first, then the contents.
+                XrVisibilityMaskKHR mask{XR_TYPE_VISIBILITY_MASK_KHR};
+                CHECK_XRCMD(client.dispatch().xrGetVisibilityMaskKHR(client.getSession(),
+                                                                     XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO,
+                                                                     0,
+                                                                     XR_VISIBILITY_MASK_TYPE_HIDDEN_TRIANGLE_MESH_KHR,
+                                                                     &mask));
+                vertices.resize(mask.vertexCountOutput);
+                indices.resize(mask.indexCountOutput);
+                mask.vertexCapacityInput = mask.vertexCountOutput;
+                mask.vertices = vertices.data();
+                mask.indexCapacityInput = mask.indexCountOutput;
+                mask.indices = indices.data();
+                CHECK_XRCMD(client.dispatch().xrGetVisibilityMaskKHR(client.getSession(),
+                                                                     XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO,
+                                                                     0,
+                                                                     XR_VISIBILITY_MASK_TYPE_HIDDEN_TRIANGLE_MESH_KHR,
+                                                                     &mask));
+            }
+            state.setCounter("vertices", (double)vertices.size());
+        }
+
+        // Measure the translation of the layers in xrEndFrame. Frame pacing and swapchain handling are excluded.
+        void BM_EndFrame(State& state, Fixture& fixture, uint32_t quadCount, bool withCylinder) {
+            auto& client = fixture.getClient();
+            if (withCylinder && !client.isExtensionEnabled(XR_KHR_COMPOSITION_LAYER_CYLINDER_EXTENSION_NAME)) {
+                state.skip(XR_KHR_COMPOSITION_LAYER_CYLINDER_EXTENSION_NAME " is not supported");
+                return;
+            }
+            fixture.ensureFocusedSession();
+
+            std::vector<client::Swapchain> swapchains;
+            auto scopeGuard = MakeScopeGuard([&] {
+                for (auto& swapchain : swapchains) {
+                    client.destroySwapchain(swapchain);
+                }
+            });
+            const auto& views = client.getViews();
+            swapchains.push_back(client.createSwapchain(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,
+                                                        views[0].recommendedImageRectWidth,
+                                                        views[0].recommendedImageRectHeight,
+                                                        2));
+            for (uint32_t i = 0; i < quadCount + (withCylinder ? 1 : 0); i++) {
+                swapchains.push_back(client.createSwapchain(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 1024, 1024));
+            }
+
+            XrCompositionLayerProjectionView projectionViews[2]{{XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW},
+                                                                {XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW}};
+            XrCompositionLayerProjection projection{XR_TYPE_COMPOSITION_LAYER_PROJECTION};
+            projection.space = client.getLocalSpace();
+            projection.viewCount = (uint32_t)std::size(projectionViews);
+            projection.views = projectionViews;
+            std::vector<XrCompositionLayerQuad> quads(quadCount, {XR_TYPE_COMPOSITION_LAYER_QUAD});
+            XrCompositionLayerCylinderKHR cylinder{XR_TYPE_COMPOSITION_LAYER_CYLINDER_KHR};
+
+            std::vector<const XrCompositionLayerBaseHeader*> layers;
+            layers.push_back(reinterpret_cast<const XrCompositionLayerBaseHeader*>(&projection));
+            for (uint32_t i = 0; i < quadCount; i++) {
+                auto& quad = quads[i];
+                quad.layerFlags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT;
+                quad.space = client.getLocalSpace();
+                quad.subImage.swapchain = swapchains[1 + i].handle;
+                quad.subImage.imageRect.extent = {1024, 1024};
+                quad.pose = {{0, 0, 0, 1}, {-0.6f + 0.4f * i, 0, -1.5f}};
+                quad.size = {0.35f, 0.35f};
+                layers.push_back(reinterpret_cast<const XrCompositionLayerBaseHeader*>(&quad));
+            }
+            if (withCylinder) {
+                cylinder.layerFlags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT;
+                cylinder.space = client.getLocalSpace();
+                cylinder.subImage.swapchain = swapchains.back().handle;
+                cylinder.subImage.imageRect.extent = {1024, 1024};
+                cylinder.pose = {{0, 0, 0, 1}, {0, 0, 0}};
+                cylinder.radius = 2.f;
+                cylinder.centralAngle = 1.f;
+                cylinder.aspectRatio = 2.f;
+                layers.push_back(reinterpret_cast<const XrCompositionLayerBaseHeader*>(&cylinder));
+            }
+            state.setCounter("layers", (double)layers.size());
+
+            XrViewLocateInfo locateInfo{XR_TYPE_VIEW_LOCATE_INFO};
+            locateInfo.viewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+            locateInfo.space = client.getLocalSpace();
+            XrViewState viewState{XR_TYPE_VIEW_STATE};
+            XrView eyeViews[2]{{XR_TYPE_VIEW}, {XR_TYPE_VIEW}};
+            uint32_t count;
+
+            while (state.keepRunning()) {
+                state.pauseTiming();
+                const XrTime displayTime = client.beginFrame();
+                locateInfo.displayTime = displayTime;
+                CHECK_XRCMD(client.dispatch().xrLocateViews(
+                    client.getSession(), &locateInfo, &viewState, (uint32_t)std::size(eyeViews), &count, eyeViews));
+                for (uint32_t eye = 0; eye < 2; eye++) {
+                    projectionViews[eye].pose = eyeViews[eye].pose;
+                    projectionViews[eye].fov = eyeViews[eye].fov;
+                    projectionViews[eye].subImage.swapchain = swapchains[0].handle;
+                    projectionViews[eye].subImage.imageArrayIndex = eye;
+                    projectionViews[eye].subImage.imageRect.extent = {
+                        (int32_t)views[0].recommendedImageRectWidth, (int32_t)views[0].recommendedImageRectHeight};
+                }
+                for (const auto& swapchain : swapchains) {
+                    client.acquireAndReleaseImage(swapchain);
+                }
+                state.resumeTiming();
+
+                client.endFrame(displayTime, layers);
+            }
+        }
+
+    } // namespace
+
+    std::vector<Benchmark> GetBenchmarks(Fixture& fixture) {
+        std::vector<Benchmark> benchmarks;
+        const auto add = [&](const std::string& name, std::function<void(State&)> function) -> Benchmark& {
+            benchmarks.push_back({name, std::move(function)});
+            return benchmarks.back();
+        };
+
+        add("xrStringToPath", [&](State& state) { BM_StringToPath(state, fixture); });
+        for (const auto& profile : actions::InteractionProfiles) {
+            add(fmt::format("xrSuggestInteractionProfileBindings/{}", profile.name),
+                [&, profile = &profile](State& state) {
+                    BM_SuggestInteractionProfileBindings(state, fixture, *profile);
+                });
+        }
+        add("xrAttachSessionActionSets", [&](State& state) { BM_AttachSessionActionSets(state, fixture); })
+            .maxIterations = 20;
+        add("xrSyncActions", [&](State& state) { BM_SyncActions(state, fixture); });
+        add("xrGetActionStateBoolean", [&](State& state) {
+            BM_GetActionState<XrActionStateBoolean>(state,
+                                                    fixture,
+                                                    "trigger_click",
+                                                    XR_TYPE_ACTION_STATE_BOOLEAN,
+                                                    fixture.getClient().dispatch().xrGetActionStateBoolean);
+        });
+        add("xrGetActionStateFloat", [&](State& state) {
+            BM_GetActionState<XrActionStateFloat>(state,
+                                                  fixture,
+                                                  "trigger_value",
+                                                  XR_TYPE_ACTION_STATE_FLOAT,
+                                                  fixture.getClient().dispatch().xrGetActionStateFloat);
+        });
+        add("xrGetActionStateVector2f", [&](State& state) {
+            BM_GetActionState<XrActionStateVector2f>(state,
+                                                     fixture,
+                                                     "thumbstick",
+                                                     XR_TYPE_ACTION_STATE_VECTOR2F,
+                                                     fixture.getClient().dispatch().xrGetActionStateVector2f);
+        });
+        add("xrGetActionStatePose", [&](State& state) {
+            BM_GetActionState<XrActionStatePose>(state,
+                                                 fixture,
+                                                 "grip_pose",
+                                                 XR_TYPE_ACTION_STATE_POSE,
+                                                 fixture.getClient().dispatch().xrGetActionStatePose);
+        });
+        add("xrLocateSpace/ActionSpace", [&](State& state) { BM_LocateSpace(state, fixture, true); });
+        add("xrLocateSpace/ViewSpace", [&](State& state) { BM_LocateSpace(state, fixture, false); });
+        add("xrLocateSpacesKHR", [&](State& state) { BM_LocateSpaces(state, fixture); });
+        add("xrLocateViews", [&](State& state) { BM_LocateViews(state, fixture); });
+        add("xrLocateHandJointsEXT", [&](State& state) { BM_LocateHandJoints(state, fixture); });
+        add("xrLocateBodyJointsFB", [&](State& state) { BM_LocateBodyJoints(state, fixture); });
+        add("xrGetVisibilityMaskKHR", [&](State& state) { BM_GetVisibilityMask(state, fixture); });
+        add("xrEndFrame/Projection", [&](State& state) { BM_EndFrame(state, fixture, 0, false); });
+        add("xrEndFrame/Projection+4Quads", [&](State& state) { BM_EndFrame(state, fixture, 4, false); });
+        add("xrEndFrame/Projection+4Quads+Cylinder", [&](State& state) { BM_EndFrame(state, fixture, 4, true); });
+
+        return benchmarks;
+    }
+
+} // namespace benchmarks
@@ -0,0 +1,63 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "actions.h"
+#include "client.h"
+#include "harness.h"
+
+namespace benchmarks {
+
+    // State shared between the benchmarks. It is created lazily, so that any subset of the benchmarks can be run.
+    class Fixture {
+      public:
+        Fixture(client::Client& client);
+
+        client::Client& getClient() {
+            return m_client;
+        }
+
+        // Action set with the bindings of all the interaction profiles suggested.
+        const actions::ActionSet& getActionSet();
+
+        // Recreate the session, which also detaches the action sets.
+        void resetSession();
+
+        // Make sure that the session is running and focused, with the action set attached.
+        void ensureFocusedSession();
+
+        const std::vector<XrSpace>& getActionSpaces();
+
+        // Run a frame and return its predicted display time.
+        XrTime runFrame();
+
+      private:
+        client::Client& m_client;
+        std::unique_ptr<actions::ActionSet> m_actionSet;
+        bool m_isAttached{false};
+        std::vector<XrSpace> m_actionSpaces;
+    };
+
+    std::vector<harness::Benchmark> GetBenchmarks(Fixture& fixture);
+
+} // namespace benchmarks
@@ -0,0 +1,298 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "client.h"
+
+namespace benchmarks::client {
+
+    Client::Client(const std::filesystem::path& runtimePath) {
+        // Let the runtime find its dependencies (such as the OVR driver) next to it.
+        m_runtimeModule = LoadLibraryExW(runtimePath.wstring().c_str(), nullptr, LOAD_WITH_ALTERED_SEARCH_PATH);
+        CHECK_MSG(m_runtimeModule, fmt::format("Failed to load {}", runtimePath.string()));
+
+        const auto negotiateLoaderRuntimeInterface = (PFN_xrNegotiateLoaderRuntimeInterface)GetProcAddress(
+            m_runtimeModule, "xrNegotiateLoaderRuntimeInterface");
+        CHECK_MSG(negotiateLoaderRuntimeInterface, "Not an OpenXR runtime");
+
+        XrNegotiateLoaderInfo loaderInfo{XR_LOADER_INTERFACE_STRUCT_LOADER_INFO,
+                                         XR_LOADER_INFO_STRUCT_VERSION,
+                                         sizeof(XrNegotiateLoaderInfo)};
+        loaderInfo.minInterfaceVersion = loaderInfo.maxInterfaceVersion = XR_CURRENT_LOADER_RUNTIME_VERSION;
+        loaderInfo.minApiVersion = XR_API_VERSION_1_0;
+        loaderInfo.maxApiVersion = XR_CURRENT_API_VERSION;
+        XrNegotiateRuntimeRequest runtimeRequest{XR_LOADER_INTERFACE_STRUCT_RUNTIME_REQUEST,
+                                                 XR_RUNTIME_INFO_STRUCT_VERSION,
+                                                 sizeof(XrNegotiateRuntimeRequest)};
+        CHECK_XRCMD(negotiateLoaderRuntimeInterface(&loaderInfo, &runtimeRequest));
+        m_getInstanceProcAddr = runtimeRequest.getInstanceProcAddr;
+
+        CHECK_XRCMD(m_getInstanceProcAddr(XR_NULL_HANDLE,
+                                          "xrEnumerateInstanceExtensionProperties",
+                                          (PFN_xrVoidFunction*)&m_dispatch.xrEnumerateInstanceExtensionProperties));
+        CHECK_XRCMD(m_getInstanceProcAddr(
+            XR_NULL_HANDLE, "xrCreateInstance", (PFN_xrVoidFunction*)&m_dispatch.xrCreateInstance));
+    }
+
+    Client::~Client() {
+        destroySession();
+        if (m_instance != XR_NULL_HANDLE) {
+            m_dispatch.xrDestroyInstance(m_instance);
+        }
+        if (m_runtimeModule) {
+            FreeLibrary(m_runtimeModule);
+        }
+    }
+
+    void Client::createInstance(const std::vector<std::string>& extensions) {
+        uint32_t count = 0;
+        CHECK_XRCMD(m_dispatch.xrEnumerateInstanceExtensionProperties(nullptr, 0, &count, nullptr));
+        std::vector<XrExtensionProperties> properties(count, {XR_TYPE_EXTENSION_PROPERTIES});
+        CHECK_XRCMD(m_dispatch.xrEnumerateInstanceExtensionProperties(nullptr, count, &count, properties.data()));
+
+        std::vector<const char*> enabledExtensions;
+        const auto enableIfSupported = [&](const std::string& extension) {
+            for (const auto& property : properties) {
+                if (extension == property.extensionName && m_enabledExtensions.insert(extension).second) {
+                    enabledExtensions.push_back(property.extensionName);
+                    return true;
+                }
+            }
+            return false;
+        };
+        CHECK_MSG(enableIfSupported(XR_KHR_D3D11_ENABLE_EXTENSION_NAME), "D3D11 is not supported");
+        for (const auto& extension : extensions) {
+            enableIfSupported(extension);
+        }
+
+        XrInstanceCreateInfo createInfo{XR_TYPE_INSTANCE_CREATE_INFO};
+        strcpy_s(createInfo.applicationInfo.applicationName, "VirtualDesktopOpenXR-Benchmarks");
+        strcpy_s(createInfo.applicationInfo.engineName, "VirtualDesktopOpenXR-Benchmarks");
+        createInfo.applicationInfo.apiVersion = XR_API_VERSION_1_0;
+        createInfo.enabledExtensionCount = (uint32_t)enabledExtensions.size();
+        createInfo.enabledExtensionNames = enabledExtensions.data();
+        CHECK_XRCMD(m_dispatch.xrCreateInstance(&createInfo, &m_instance));
+
+#define LOAD_XR_FUNCTION(name)                                                                                         \
+    if (XR_FAILED(m_getInstanceProcAddr(m_instance, #name, (PFN_xrVoidFunction*)&m_dispatch.name))) {                  \
+        m_dispatch.name = nullptr;                                                                                     \
+    }
+        FOR_EACH_XR_FUNCTION(LOAD_XR_FUNCTION)
+#undef LOAD_XR_FUNCTION
+
+        XrInstanceProperties instanceProperties{XR_TYPE_INSTANCE_PROPERTIES};
+        CHECK_XRCMD(m_dispatch.xrGetInstanceProperties(m_instance, &instanceProperties));
+        m_runtimeName = fmt::format("{} {}.{}.{}",
+                                    instanceProperties.runtimeName,
+                                    XR_VERSION_MAJOR(instanceProperties.runtimeVersion),
+                                    XR_VERSION_MINOR(instanceProperties.runtimeVersion),
+                                    XR_VERSION_PATCH(instanceProperties.runtimeVersion));
+
+        // The headset might take a moment to be reported.
+        XrSystemGetInfo getInfo{XR_TYPE_SYSTEM_GET_INFO};
+        getInfo.formFactor = XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        XrResult result;
+        while ((result = m_dispatch.xrGetSystem(m_instance, &getInfo, &m_systemId)) ==
+                   XR_ERROR_FORM_FACTOR_UNAVAILABLE &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        CHECK_XRCMD(result);
+
+        CHECK_XRCMD(m_dispatch.xrEnumerateViewConfigurationViews(
+            m_instance, m_systemId, XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO, 0, &count, nullptr));
+        m_views.resize(count, {XR_TYPE_VIEW_CONFIGURATION_VIEW});
+        CHECK_XRCMD(m_dispatch.xrEnumerateViewConfigurationViews(
+            m_instance, m_systemId, XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO, count, &count, m_views.data()));
+    }
+
+    bool Client::isExtensionEnabled(const std::string& extension) const {
+        return m_enabledExtensions.count(extension);
+    }
+
+    void Client::createSession() {
+        if (!m_device) {
+            XrGraphicsRequirementsD3D11KHR requirements{XR_TYPE_GRAPHICS_REQUIREMENTS_D3D11_KHR};
+            CHECK_XRCMD(m_dispatch.xrGetD3D11GraphicsRequirementsKHR(m_instance, m_systemId, &requirements));
+
+            ComPtr<IDXGIFactory1> factory;
+            CHECK_HRCMD(CreateDXGIFactory1(IID_PPV_ARGS(factory.ReleaseAndGetAddressOf())));
+            ComPtr<IDXGIAdapter1> adapter;
+            for (UINT i = 0; factory->EnumAdapters1(i, adapter.ReleaseAndGetAddressOf()) == S_OK; i++) {
+                DXGI_ADAPTER_DESC1 desc{};
+                CHECK_HRCMD(adapter->GetDesc1(&desc));
+                if (!memcmp(&desc.AdapterLuid, &requirements.adapterLuid, sizeof(LUID))) {
+                    break;
+                }
+            }
+            CHECK_MSG(adapter, "Failed to find the adapter requested by the runtime");
+
+            const D3D_FEATURE_LEVEL featureLevel = requirements.minFeatureLevel;
+            CHECK_HRCMD(D3D11CreateDevice(adapter.Get(),
+                                          D3D_DRIVER_TYPE_UNKNOWN,
+                                          nullptr,
+                                          D3D11_CREATE_DEVICE_BGRA_SUPPORT,
+                                          &featureLevel,
+                                          1,
+                                          D3D11_SDK_VERSION,
+                                          m_device.ReleaseAndGetAddressOf(),
+                                          nullptr,
+                                          m_context.ReleaseAndGetAddressOf()));
+        }
+
+        XrGraphicsBindingD3D11KHR graphicsBindings{XR_TYPE_GRAPHICS_BINDING_D3D11_KHR};
+        graphicsBindings.device = m_device.Get();
+        XrSessionCreateInfo createInfo{XR_TYPE_SESSION_CREATE_INFO};
+        createInfo.next = &graphicsBindings;
+        createInfo.systemId = m_systemId;
+        CHECK_XRCMD(m_dispatch.xrCreateSession(m_instance, &createInfo, &m_session));
+
+        XrReferenceSpaceCreateInfo spaceCreateInfo{XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
+        spaceCreateInfo.poseInReferenceSpace.orientation.w = 1.f;
+        spaceCreateInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_LOCAL;
+        CHECK_XRCMD(m_dispatch.xrCreateReferenceSpace(m_session, &spaceCreateInfo, &m_localSpace));
+        spaceCreateInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_VIEW;
+        CHECK_XRCMD(m_dispatch.xrCreateReferenceSpace(m_session, &spaceCreateInfo, &m_viewSpace));
+    }
+
+    void Client::destroySession() {
+        if (m_session == XR_NULL_HANDLE) {
+            return;
+        }
+
+        // This also destroys all the objects tied to the session (spaces, swapchains...).
+        m_dispatch.xrDestroySession(m_session);
+        m_session = XR_NULL_HANDLE;
+        m_localSpace = m_viewSpace = XR_NULL_HANDLE;
+        m_sessionState = XR_SESSION_STATE_UNKNOWN;
+        m_sessionRunning = false;
+    }
+
+    void Client::waitForFocus(std::chrono::milliseconds timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (m_sessionState != XR_SESSION_STATE_FOCUSED) {
+            CHECK_MSG(std::chrono::steady_clock::now() < deadline, "Timed out waiting for the session to be focused");
+
+            pollEvents();
+            if (m_sessionRunning) {
+                endFrame(beginFrame());
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+    }
+
+    void Client::pollEvents() {
+        while (true) {
+            XrEventDataBuffer event{XR_TYPE_EVENT_DATA_BUFFER};
+            const XrResult result = m_dispatch.xrPollEvent(m_instance, &event);
+            CHECK_XRCMD(result);
+            if (result == XR_EVENT_UNAVAILABLE) {
+                break;
+            }
+
+            if (event.type != XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED) {
+                continue;
+            }
+            const auto& stateChanged = *reinterpret_cast<const XrEventDataSessionStateChanged*>(&event);
+            if (stateChanged.session != m_session) {
+                // Leftover from a previous session.
+                continue;
+            }
+            m_sessionState = stateChanged.state;
+            if (m_sessionState == XR_SESSION_STATE_READY) {
+                XrSessionBeginInfo beginInfo{XR_TYPE_SESSION_BEGIN_INFO};
+                beginInfo.primaryViewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+                CHECK_XRCMD(m_dispatch.xrBeginSession(m_session, &beginInfo));
+                m_sessionRunning = true;
+            } else if (m_sessionState == XR_SESSION_STATE_STOPPING) {
+                CHECK_XRCMD(m_dispatch.xrEndSession(m_session));
+                m_sessionRunning = false;
+            }
+        }
+    }
+
+    XrPath Client::getPath(const std::string& path) const {
+        XrPath xrPath = XR_NULL_PATH;
+        CHECK_XRCMD(m_dispatch.xrStringToPath(m_instance, path.c_str(), &xrPath));
+        return xrPath;
+    }
+
+    Swapchain Client::createSwapchain(int64_t format, uint32_t width, uint32_t height, uint32_t arraySize) {
+        Swapchain swapchain;
+        swapchain.createInfo.usageFlags = XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT | XR_SWAPCHAIN_USAGE_SAMPLED_BIT;
+        swapchain.createInfo.format = format;
+        swapchain.createInfo.sampleCount = 1;
+        swapchain.createInfo.width = width;
+        swapchain.createInfo.height = height;
+        swapchain.createInfo.faceCount = 1;
+        swapchain.createInfo.arraySize = arraySize;
+        swapchain.createInfo.mipCount = 1;
+        CHECK_XRCMD(m_dispatch.xrCreateSwapchain(m_session, &swapchain.createInfo, &swapchain.handle));
+
+        uint32_t count = 0;
+        CHECK_XRCMD(m_dispatch.xrEnumerateSwapchainImages(swapchain.handle, 0, &count, nullptr));
+        swapchain.images.resize(count, {XR_TYPE_SWAPCHAIN_IMAGE_D3D11_KHR});
+        CHECK_XRCMD(m_dispatch.xrEnumerateSwapchainImages(
+            swapchain.handle,
+            count,
+            &count,
+            reinterpret_cast<XrSwapchainImageBaseHeader*>(swapchain.images.data())));
+
+        return swapchain;
+    }
+
+    void Client::destroySwapchain(Swapchain& swapchain) {
+        if (swapchain.handle != XR_NULL_HANDLE) {
+            CHECK_XRCMD(m_dispatch.xrDestroySwapchain(swapchain.handle));
+            swapchain.handle = XR_NULL_HANDLE;
+        }
+    }
+
+    void Client::acquireAndReleaseImage(const Swapchain& swapchain) {
+        uint32_t index;
+        CHECK_XRCMD(m_dispatch.xrAcquireSwapchainImage(swapchain.handle, nullptr, &index));
+        XrSwapchainImageWaitInfo waitInfo{XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO};
+        waitInfo.timeout = XR_INFINITE_DURATION;
+        CHECK_XRCMD(m_dispatch.xrWaitSwapchainImage(swapchain.handle, &waitInfo));
+        CHECK_XRCMD(m_dispatch.xrReleaseSwapchainImage(swapchain.handle, nullptr));
+    }
+
+    XrTime Client::beginFrame() {
+        XrFrameState frameState{XR_TYPE_FRAME_STATE};
+        CHECK_XRCMD(m_dispatch.xrWaitFrame(m_session, nullptr, &frameState));
+        CHECK_XRCMD(m_dispatch.xrBeginFrame(m_session, nullptr));
+        return frameState.predictedDisplayTime;
+    }
+
+    void Client::endFrame(XrTime displayTime, const std::vector<const XrCompositionLayerBaseHeader*>& layers) {
+        XrFrameEndInfo endInfo{XR_TYPE_FRAME_END_INFO};
+        endInfo.displayTime = displayTime;
+        endInfo.environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE;
+        endInfo.layerCount = (uint32_t)layers.size();
+        endInfo.layers = layers.data();
+        CHECK_XRCMD(m_dispatch.xrEndFrame(m_session, &endInfo));
+    }
+
+} // namespace benchmarks::client
@@ -0,0 +1,199 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+namespace benchmarks::client {
+
+#define FOR_EACH_XR_FUNCTION(_)                                                                                        \
+    _(xrEnumerateInstanceExtensionProperties)                                                                          \
+    _(xrCreateInstance)                                                                                                \
+    _(xrDestroyInstance)                                                                                               \
+    _(xrGetInstanceProperties)                                                                                         \
+    _(xrGetSystem)                                                                                                     \
+    _(xrGetSystemProperties)                                                                                           \
+    _(xrEnumerateEnvironmentBlendModes)                                                                                \
+    _(xrEnumerateViewConfigurations)                                                                                   \
+    _(xrGetViewConfigurationProperties)                                                                                \
+    _(xrEnumerateViewConfigurationViews)                                                                               \
+    _(xrGetD3D11GraphicsRequirementsKHR)                                                                               \
+    _(xrCreateSession)                                                                                                 \
+    _(xrDestroySession)                                                                                                \
+    _(xrBeginSession)                                                                                                  \
+    _(xrEndSession)                                                                                                    \
+    _(xrRequestExitSession)                                                                                            \
+    _(xrPollEvent)                                                                                                     \
+    _(xrStringToPath)                                                                                                  \
+    _(xrPathToString)                                                                                                  \
+    _(xrCreateActionSet)                                                                                               \
+    _(xrDestroyActionSet)                                                                                              \
+    _(xrCreateAction)                                                                                                  \
+    _(xrDestroyAction)                                                                                                 \
+    _(xrSuggestInteractionProfileBindings)                                                                             \
+    _(xrAttachSessionActionSets)                                                                                       \
+    _(xrGetCurrentInteractionProfile)                                                                                  \
+    _(xrSyncActions)                                                                                                   \
+    _(xrGetActionStateBoolean)                                                                                         \
+    _(xrGetActionStateFloat)                                                                                           \
+    _(xrGetActionStateVector2f)                                                                                        \
+    _(xrGetActionStatePose)                                                                                            \
+    _(xrEnumerateBoundSourcesForAction)                                                                                \
+    _(xrGetInputSourceLocalizedName)                                                                                   \
+    _(xrApplyHapticFeedback)                                                                                           \
+    _(xrStopHapticFeedback)                                                                                            \
+    _(xrEnumerateReferenceSpaces)                                                                                      \
+    _(xrGetReferenceSpaceBoundsRect)                                                                                   \
+    _(xrCreateActionSpace)                                                                                             \
+    _(xrCreateReferenceSpace)                                                                                          \
+    _(xrDestroySpace)                                                                                                  \
+    _(xrLocateSpace)                                                                                                   \
+    _(xrLocateSpaces)                                                                                                  \
+    _(xrLocateSpacesKHR)                                                                                               \
+    _(xrLocateViews)                                                                                                   \
+    _(xrCreateHandTrackerEXT)                                                                                          \
+    _(xrDestroyHandTrackerEXT)                                                                                         \
+    _(xrLocateHandJointsEXT)                                                                                           \
+    _(xrCreateBodyTrackerFB)                                                                                           \
+    _(xrDestroyBodyTrackerFB)                                                                                          \
+    _(xrLocateBodyJointsFB)                                                                                            \
+    _(xrGetBodySkeletonFB)                                                                                             \
+    _(xrCreateFaceTracker2FB)                                                                                          \
+    _(xrDestroyFaceTracker2FB)                                                                                         \
+    _(xrGetFaceExpressionWeights2FB)                                                                                   \
+    _(xrCreateEyeTrackerFB)                                                                                            \
+    _(xrDestroyEyeTrackerFB)                                                                                           \
+    _(xrGetEyeGazesFB)                                                                                                 \
+    _(xrGetVisibilityMaskKHR)                                                                                          \
+    _(xrEnumerateSwapchainFormats)                                                                                     \
+    _(xrCreateSwapchain)                                                                                               \
+    _(xrDestroySwapchain)                                                                                              \
+    _(xrEnumerateSwapchainImages)                                                                                      \
+    _(xrAcquireSwapchainImage)                                                                                         \
+    _(xrWaitSwapchainImage)                                                                                            \
+    _(xrReleaseSwapchainImage)                                                                                         \
+    _(xrWaitFrame)                                                                                                     \
+    _(xrBeginFrame)                                                                                                    \
+    _(xrEndFrame)                                                                                                      \
+    _(xrEnumerateDisplayRefreshRatesFB)                                                                                \
+    _(xrGetDisplayRefreshRateFB)                                                                                       \
+    _(xrRequestDisplayRefreshRateFB)
+
+    // Entry points of the runtime. Functions from extensions that are not enabled are left null.
+    struct Dispatch {
+#define DECLARE_XR_FUNCTION(name) PFN_##name name{nullptr};
+        FOR_EACH_XR_FUNCTION(DECLARE_XR_FUNCTION)
+#undef DECLARE_XR_FUNCTION
+    };
+
+    struct Swapchain {
+        XrSwapchain handle{XR_NULL_HANDLE};
+        XrSwapchainCreateInfo createInfo{XR_TYPE_SWAPCHAIN_CREATE_INFO};
+        std::vector<XrSwapchainImageD3D11KHR> images;
+    };
+
+    // A minimal D3D11 application talking directly to the runtime DLL, without going through the OpenXR loader. This
+    // way, only the cost of the runtime is measured.
+    class Client {
+      public:
+        Client(const std::filesystem::path& runtimePath);
+        ~Client();
+
+        // Enable all the requested extensions that the runtime advertises.
+        void createInstance(const std::vector<std::string>& extensions);
+        bool isExtensionEnabled(const std::string& extension) const;
+
+        void createSession();
+        void destroySession();
+
+        // Begin the session and submit empty frames until the session is focused (actions are only active then).
+        void waitForFocus(std::chrono::milliseconds timeout = std::chrono::seconds(10));
+
+        void pollEvents();
+
+        XrPath getPath(const std::string& path) const;
+
+        Swapchain createSwapchain(int64_t format, uint32_t width, uint32_t height, uint32_t arraySize = 1);
+        void destroySwapchain(Swapchain& swapchain);
+        void acquireAndReleaseImage(const Swapchain& swapchain);
+
+        // Returns the predicted display time of the frame.
+        XrTime beginFrame();
+        void endFrame(XrTime displayTime, const std::vector<const XrCompositionLayerBaseHeader*>& layers = {});
+
+        const Dispatch& dispatch() const {
+            return m_dispatch;
+        }
+
+        XrInstance getInstance() const {
+            return m_instance;
+        }
+
+        XrSystemId getSystemId() const {
+            return m_systemId;
+        }
+
+        XrSession getSession() const {
+            return m_session;
+        }
+
+        XrSessionState getSessionState() const {
+            return m_sessionState;
+        }
+
+        const std::string& getRuntimeName() const {
+            return m_runtimeName;
+        }
+
+        const std::vector<XrViewConfigurationView>& getViews() const {
+            return m_views;
+        }
+
+        XrSpace getLocalSpace() const {
+            return m_localSpace;
+        }
+
+        XrSpace getViewSpace() const {
+            return m_viewSpace;
+        }
+
+      private:
+        HMODULE m_runtimeModule{nullptr};
+        PFN_xrGetInstanceProcAddr m_getInstanceProcAddr{nullptr};
+        Dispatch m_dispatch;
+
+        XrInstance m_instance{XR_NULL_HANDLE};
+        std::set<std::string> m_enabledExtensions;
+        XrSystemId m_systemId{XR_NULL_SYSTEM_ID};
+        std::string m_runtimeName;
+        std::vector<XrViewConfigurationView> m_views;
+
+        ComPtr<ID3D11Device> m_device;
+        ComPtr<ID3D11DeviceContext> m_context;
+
+        XrSession m_session{XR_NULL_HANDLE};
+        XrSessionState m_sessionState{XR_SESSION_STATE_UNKNOWN};
+        bool m_sessionRunning{false};
+        XrSpace m_localSpace{XR_NULL_HANDLE};
+        XrSpace m_viewSpace{XR_NULL_HANDLE};
+    };
+
+} // namespace benchmarks::client
@@ -0,0 +1,322 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+namespace benchmarks::harness {
+
+    using clock = std::chrono::steady_clock;
+
+    // Once calibrated, each batch of iterations should last at least this long, so that reading the clock does not
+    // dominate the measurement of the fastest calls.
+    constexpr auto TargetBatchDuration = std::chrono::microseconds(200);
+    constexpr uint64_t MaxBatchSize = 1 << 20;
+    constexpr size_t MinBatches = 10;
+
+    inline double ThreadCpuTimeNs() {
+#ifdef _WIN32
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+            return 0;
+        }
+        const auto toNs = [](const FILETIME& time) {
+            return (((uint64_t)time.dwHighDateTime << 32) | time.dwLowDateTime) * 100.0;
+        };
+        return toNs(kernelTime) + toNs(userTime);
+#else
+        timespec time{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+        return time.tv_sec * 1e9 + time.tv_nsec;
+#endif
+    }
+
+    // Returns the value at the given percentile (0 to 100) of a sorted set of samples.
+    inline double Percentile(const std::vector<double>& sortedSamples, double percentile) {
+        if (sortedSamples.empty()) {
+            return 0;
+        }
+        const size_t index = std::min(
+            (size_t)std::ceil(percentile / 100.0 * sortedSamples.size()) - (percentile > 0 ? 1 : 0),
+            sortedSamples.size() - 1);
+        return sortedSamples[index];
+    }
+
+    struct Result {
+        std::string name;
+        uint64_t iterations{0};
+
+        // All times are per iteration, in nanoseconds.
+        double realTime{0};
+        double cpuTime{0};
+        double minTime{0};
+        double medianTime{0};
+        double p90Time{0};
+        double p99Time{0};
+
+        std::map<std::string, double> counters;
+        std::string label;
+        std::string error;
+        bool skipped{false};
+    };
+
+    // Controls the loop of a benchmark. The body of the loop is what is measured:
+    //   while (state.keepRunning()) { ... }
+    class State {
+      public:
+        State(std::chrono::duration<double> minTime, uint64_t maxIterations)
+            : m_minTime(std::chrono::duration_cast<clock::duration>(minTime)), m_maxIterations(maxIterations),
+              // Warming up would eat into the few iterations needed for the minimum number of batches.
+              m_calibrating(maxIterations >= 2 * MinBatches) {
+        }
+
+        bool keepRunning() {
+            if (m_remainingInBatch) {
+                m_remainingInBatch--;
+                return true;
+            }
+            return nextBatch();
+        }
+
+        // Exclude the per-iteration setup (such as frame pacing) from the measurement.
+        void pauseTiming() {
+            m_pauseStart = clock::now();
+            m_pauseCpuStart = ThreadCpuTimeNs();
+        }
+
+        void resumeTiming() {
+            m_paused += clock::now() - m_pauseStart;
+            m_pausedCpu += ThreadCpuTimeNs() - m_pauseCpuStart;
+        }
+
+        void setCounter(const std::string& name, double value) {
+            m_result.counters[name] = value;
+        }
+
+        void setLabel(const std::string& label) {
+            m_result.label = label;
+        }
+
+        // Abort the benchmark, for example if the runtime does not support the feature.
+        void skip(const std::string& reason) {
+            m_result.skipped = true;
+            m_result.error = reason;
+            m_remainingInBatch = 0;
+            m_done = true;
+        }
+
+        void setError(const std::string& error) {
+            m_result.error = error;
+            m_remainingInBatch = 0;
+            m_done = true;
+        }
+
+        uint64_t iterations() const {
+            return m_result.iterations;
+        }
+
+        Result finalize(const std::string& name) {
+            Result result = std::move(m_result);
+            result.name = name;
+            if (result.iterations) {
+                result.realTime = std::chrono::duration<double, std::nano>(m_measured).count() / result.iterations;
+                result.cpuTime = m_measuredCpu / result.iterations;
+            }
+            std::sort(m_samples.begin(), m_samples.end());
+            result.minTime = m_samples.empty() ? 0 : m_samples.front();
+            result.medianTime = Percentile(m_samples, 50);
+            result.p90Time = Percentile(m_samples, 90);
+            result.p99Time = Percentile(m_samples, 99);
+            return result;
+        }
+
+      private:
+        bool nextBatch() {
+            const auto now = clock::now();
+            const double nowCpu = ThreadCpuTimeNs();
+            if (m_batchStart != clock::time_point{}) {
+                const auto elapsed = now - m_batchStart - m_paused;
+                const double elapsedCpu = nowCpu - m_batchCpuStart - m_pausedCpu;
+                if (m_calibrating) {
+                    // Grow the batch until it is long enough, and discard the measurements until then (warm up). The
+                    // discarded iterations still count against the maximum, and may use up to half of it.
+                    m_calibrated += m_batchSize;
+                    if (elapsed >= TargetBatchDuration || m_batchSize >= MaxBatchSize ||
+                        m_calibrated + 2 * m_batchSize > m_maxIterations / 2) {
+                        m_calibrating = false;
+                    } else {
+                        m_batchSize *= 2;
+                    }
+                } else {
+                    m_result.iterations += m_batchSize;
+                    m_measured += elapsed;
+                    m_measuredCpu += elapsedCpu;
+                    m_samples.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / m_batchSize);
+                }
+            } else {
+                m_start = now;
+            }
+
+            if (m_done || (m_samples.size() >= MinBatches && now - m_start >= m_minTime) ||
+                m_calibrated + m_result.iterations + m_batchSize > m_maxIterations) {
+                m_done = true;
+                return false;
+            }
+
+            m_remainingInBatch = m_batchSize - 1;
+            m_paused = {};
+            m_pausedCpu = 0;
+            m_batchStart = clock::now();
+            m_batchCpuStart = ThreadCpuTimeNs();
+            return true;
+        }
+
+        const clock::duration m_minTime;
+        const uint64_t m_maxIterations;
+
+        bool m_calibrating;
+        bool m_done{false};
+        uint64_t m_calibrated{0};
+        uint64_t m_batchSize{1};
+        uint64_t m_remainingInBatch{0};
+        clock::time_point m_start{};
+        clock::time_point m_batchStart{};
+        double m_batchCpuStart{0};
+        clock::time_point m_pauseStart{};
+        double m_pauseCpuStart{0};
+        clock::duration m_paused{};
+        double m_pausedCpu{0};
+
+        clock::duration m_measured{};
+        double m_measuredCpu{0};
+        std::vector<double> m_samples;
+        Result m_result;
+    };
+
+    struct Benchmark {
+        std::string name;
+        std::function<void(State&)> function;
+
+        // Some entry points can only be called a handful of times (eg: once per session).
+        uint64_t maxIterations{std::numeric_limits<uint64_t>::max()};
+    };
+
+    struct Options {
+        std::chrono::duration<double> minTime{0.5};
+        std::string filter;
+    };
+
+    inline std::vector<Result> Run(const std::vector<Benchmark>& benchmarks,
+                                   const Options& options,
+                                   const std::function<void(const Result&)>& onResult = {}) {
+        std::vector<Result> results;
+        for (const auto& benchmark : benchmarks) {
+            if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) {
+                continue;
+            }
+
+            State state(options.minTime, benchmark.maxIterations);
+            try {
+                benchmark.function(state);
+            } catch (std::exception& exc) {
+                state.setError(exc.what());
+            }
+            results.push_back(state.finalize(benchmark.name));
+            if (onResult) {
+                onResult(results.back());
+            }
+        }
+        return results;
+    }
+
+    inline std::string EscapeJson(const std::string& value) {
+        std::string escaped;
+        for (const char c : value) {
+            switch (c) {
+            case '"':
+                escaped += "\\\"";
+                break;
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            case '\t':
+                escaped += "\\t";
+                break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    char buffer[8];
+                    snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    escaped += buffer;
+                } else {
+                    escaped += c;
+                }
+                break;
+            }
+        }
+        return escaped;
+    }
+
+    // Same layout as Google Benchmark's --benchmark_format=json, so that the existing comparison tools can be used to
+    // track the results across releases.
+    inline void WriteJson(std::ostream& out,
+                          const std::vector<Result>& results,
+                          const std::map<std::string, std::string>& context) {
+        out << "{\n  \"context\": {";
+        bool first = true;
+        for (const auto& [key, value] : context) {
+            out << (first ? "\n" : ",\n") << "    \"" << EscapeJson(key) << "\": \"" << EscapeJson(value) << "\"";
+            first = false;
+        }
+        out << "\n  },\n  \"benchmarks\": [";
+        first = true;
+        for (const auto& result : results) {
+            out << (first ? "\n" : ",\n") << "    {\n";
+            out << "      \"name\": \"" << EscapeJson(result.name) << "\",\n";
+            out << "      \"run_name\": \"" << EscapeJson(result.name) << "\",\n";
+            out << "      \"run_type\": \"iteration\",\n";
+            if (!result.error.empty()) {
+                out << "      \"error_occurred\": " << (result.skipped ? "false" : "true") << ",\n";
+                out << "      \"" << (result.skipped ? "skip_message" : "error_message") << "\": \""
+                    << EscapeJson(result.error) << "\",\n";
+            }
+            if (!result.label.empty()) {
+                out << "      \"label\": \"" << EscapeJson(result.label) << "\",\n";
+            }
+            out << "      \"iterations\": " << result.iterations << ",\n";
+            out << "      \"real_time\": " << result.realTime << ",\n";
+            out << "      \"cpu_time\": " << result.cpuTime << ",\n";
+            out << "      \"min_time\": " << result.minTime << ",\n";
+            out << "      \"median_time\": " << result.medianTime << ",\n";
+            out << "      \"p90_time\": " << result.p90Time << ",\n";
+            out << "      \"p99_time\": " << result.p99Time << ",\n";
+            for (const auto& [name, value] : result.counters) {
+                out << "      \"" << EscapeJson(name) << "\": " << value << ",\n";
+            }
+            out << "      \"time_unit\": \"ns\"\n    }";
+            first = false;
+        }
+        out << "\n  ]\n}\n";
+    }
+
+} // namespace benchmarks::harness
@@ -0,0 +1,122 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+namespace benchmarks::latency {
+
+    // Log-linear histogram of durations in nanoseconds: each power of two is split in 2^SubBucketBits buckets, which
+    // bounds the error of the percentiles to about 6%. Recording is lock-free as long as each thread has its own.
+    class Histogram {
+      public:
+        static constexpr uint32_t SubBucketBits = 4;
+        static constexpr uint32_t SubBuckets = 1 << SubBucketBits;
+        static constexpr uint32_t Buckets = (64 - SubBucketBits + 1) * SubBuckets;
+
+        void record(uint64_t durationNs) {
+            m_counts[GetBucket(durationNs)]++;
+            m_count++;
+            m_total += durationNs;
+            m_max = std::max(m_max, durationNs);
+        }
+
+        void merge(const Histogram& other) {
+            for (uint32_t i = 0; i < Buckets; i++) {
+                m_counts[i] += other.m_counts[i];
+            }
+            m_count += other.m_count;
+            m_total += other.m_total;
+            m_max = std::max(m_max, other.m_max);
+        }
+
+        // Returns the upper bound of the bucket containing the given percentile (0 to 100).
+        uint64_t getPercentile(double percentile) const {
+            if (!m_count) {
+                return 0;
+            }
+            const uint64_t rank = std::max((uint64_t)std::ceil(percentile / 100.0 * m_count), (uint64_t)1);
+            uint64_t seen = 0;
+            for (uint32_t i = 0; i < Buckets; i++) {
+                seen += m_counts[i];
+                if (seen >= rank) {
+                    return std::min(GetBucketUpperBound(i), m_max);
+                }
+            }
+            return m_max;
+        }
+
+        uint64_t getCountAbove(uint64_t durationNs) const {
+            uint64_t count = 0;
+            for (uint32_t i = GetBucket(durationNs) + 1; i < Buckets; i++) {
+                count += m_counts[i];
+            }
+            return count;
+        }
+
+        uint64_t getCount() const {
+            return m_count;
+        }
+
+        uint64_t getMax() const {
+            return m_max;
+        }
+
+        double getMean() const {
+            return m_count ? (double)m_total / m_count : 0;
+        }
+
+        static uint32_t GetBucket(uint64_t value) {
+            if (value < SubBuckets) {
+                return (uint32_t)value;
+            }
+            const uint32_t log2 = 63 - CountLeadingZeros(value);
+            const uint32_t shift = log2 - SubBucketBits;
+            return (shift + 1) * SubBuckets + (uint32_t)((value >> shift) & (SubBuckets - 1));
+        }
+
+        static uint64_t GetBucketUpperBound(uint32_t bucket) {
+            if (bucket < SubBuckets) {
+                return bucket;
+            }
+            const uint32_t shift = bucket / SubBuckets - 1;
+            const uint64_t base = (uint64_t)(SubBuckets + bucket % SubBuckets) << shift;
+            return base + ((uint64_t)1 << shift) - 1;
+        }
+
+      private:
+        static uint32_t CountLeadingZeros(uint64_t value) {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanReverse64(&index, value);
+            return 63 - index;
+#else
+            return __builtin_clzll(value);
+#endif
+        }
+
+        std::array<uint64_t, Buckets> m_counts{};
+        uint64_t m_count{0};
+        uint64_t m_total{0};
+        uint64_t m_max{0};
+    };
+
+} // namespace benchmarks::latency
@@ -0,0 +1,504 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "actions.h"
+#include "harness.h"
+#include "loadgen.h"
+
+namespace benchmarks::loadgen {
+
+    using Histograms = std::array<latency::Histogram, (size_t)Api::Count>;
+
+    namespace {
+
+        // The OVR compositor accepts up to 16 layers.
+        constexpr uint32_t MaxLayers = 16;
+
+        constexpr uint32_t LayerImageSize = 512;
+
+        template <typename Function>
+        XrResult Measure(Histograms& histograms, Api api, Function&& function) {
+            const auto start = std::chrono::steady_clock::now();
+            const XrResult result = function();
+            histograms[(size_t)api].record(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                    .count());
+            return result;
+        }
+
+    } // namespace
+
+    const char* ToString(Api api) {
+        switch (api) {
+        case Api::WaitFrame:
+            return "xrWaitFrame";
+        case Api::BeginFrame:
+            return "xrBeginFrame";
+        case Api::EndFrame:
+            return "xrEndFrame";
+        case Api::AcquireSwapchainImage:
+            return "xrAcquireSwapchainImage";
+        case Api::WaitSwapchainImage:
+            return "xrWaitSwapchainImage";
+        case Api::ReleaseSwapchainImage:
+            return "xrReleaseSwapchainImage";
+        case Api::SyncActions:
+            return "xrSyncActions";
+        case Api::LocateViews:
+            return "xrLocateViews";
+        case Api::LocateSpace:
+            return "xrLocateSpace";
+        case Api::GetActionStateBoolean:
+            return "xrGetActionStateBoolean";
+        case Api::GetActionStateFloat:
+            return "xrGetActionStateFloat";
+        case Api::GetActionStateVector2f:
+            return "xrGetActionStateVector2f";
+        case Api::GetActionStatePose:
+            return "xrGetActionStatePose";
+        case Api::LocateHandJoints:
+            return "xrLocateHandJointsEXT";
+        case Api::LocateBodyJoints:
+            return "xrLocateBodyJointsFB";
+        default:
+            return "Unknown";
+        }
+    }
+
+    Report Run(client::Client& client, const Options& options) {
+        const auto& xr = client.dispatch();
+        const uint32_t layerCount = std::clamp(options.layers, 1u, MaxLayers);
+
+        client.createSession();
+        auto sessionGuard = MakeScopeGuard([&] { client.destroySession(); });
+        const XrSession session = client.getSession();
+        const XrSpace localSpace = client.getLocalSpace();
+
+        // Action sets with decreasing priorities, all bound to the same controls.
+        std::vector<std::unique_ptr<actions::ActionSet>> actionSets;
+        std::vector<const actions::ActionSet*> actionSetsToAttach;
+        std::vector<XrActiveActionSet> activeActionSets;
+        for (uint32_t i = 0; i < options.actionSets; i++) {
+            actionSets.push_back(std::make_unique<actions::ActionSet>(
+                client, fmt::format("load_{}", i), options.actionSets - i, options.actionCopies));
+            actionSetsToAttach.push_back(actionSets.back().get());
+            activeActionSets.push_back({actionSets.back()->getHandle(), XR_NULL_PATH});
+        }
+        for (const auto& profile : actions::InteractionProfiles) {
+            actions::SuggestBindings(client, actionSetsToAttach, profile);
+        }
+        actions::AttachActionSets(client, actionSetsToAttach);
+
+        const XrPath hands[] = {client.getPath("/user/hand/left"), client.getPath("/user/hand/right")};
+        std::vector<std::pair<XrAction, XrActionType>> inputActions;
+        std::vector<XrSpace> actionSpaces;
+        for (const auto& actionSet : actionSets) {
+            for (const auto& [action, type] : actionSet->getActions()) {
+                if (type == XR_ACTION_TYPE_VIBRATION_OUTPUT) {
+                    continue;
+                }
+                inputActions.push_back({action, type});
+
+                if (type == XR_ACTION_TYPE_POSE_INPUT) {
+                    for (const XrPath hand : hands) {
+                        XrActionSpaceCreateInfo createInfo{XR_TYPE_ACTION_SPACE_CREATE_INFO};
+                        createInfo.action = action;
+                        createInfo.subactionPath = hand;
+                        createInfo.poseInActionSpace.orientation.w = 1.f;
+                        XrSpace space;
+                        CHECK_XRCMD(xr.xrCreateActionSpace(session, &createInfo, &space));
+                        actionSpaces.push_back(space);
+                    }
+                }
+            }
+        }
+
+        std::vector<XrHandTrackerEXT> handTrackers;
+        if (client.isExtensionEnabled(XR_EXT_HAND_TRACKING_EXTENSION_NAME)) {
+            for (const XrHandEXT hand : {XR_HAND_LEFT_EXT, XR_HAND_RIGHT_EXT}) {
+                XrHandTrackerCreateInfoEXT createInfo{XR_TYPE_HAND_TRACKER_CREATE_INFO_EXT};
+                createInfo.hand = hand;
+                createInfo.handJointSet = XR_HAND_JOINT_SET_DEFAULT_EXT;
+                XrHandTrackerEXT handTracker;
+                if (XR_SUCCEEDED(xr.xrCreateHandTrackerEXT(session, &createInfo, &handTracker))) {
+                    handTrackers.push_back(handTracker);
+                }
+            }
+        }
+        XrBodyTrackerFB bodyTracker = XR_NULL_HANDLE;
+        if (client.isExtensionEnabled(XR_FB_BODY_TRACKING_EXTENSION_NAME)) {
+            XrBodyTrackerCreateInfoFB createInfo{XR_TYPE_BODY_TRACKER_CREATE_INFO_FB};
+            createInfo.bodyJointSet = XR_BODY_JOINT_SET_DEFAULT_FB;
+            if (XR_FAILED(xr.xrCreateBodyTrackerFB(session, &createInfo, &bodyTracker))) {
+                bodyTracker = XR_NULL_HANDLE;
+            }
+        }
+        auto trackersGuard = MakeScopeGuard([&] {
+            for (const auto handTracker : handTrackers) {
+                xr.xrDestroyHandTrackerEXT(handTracker);
+            }
+            if (bodyTracker != XR_NULL_HANDLE) {
+                xr.xrDestroyBodyTrackerFB(bodyTracker);
+            }
+        });
+
+        // One projection layer, then a mix of quad and cylinder layers, each with its own swapchain.
+        const bool useCylinders = client.isExtensionEnabled(XR_KHR_COMPOSITION_LAYER_CYLINDER_EXTENSION_NAME);
+        const auto& views = client.getViews();
+        const XrExtent2Di eyeExtent{(int32_t)views[0].recommendedImageRectWidth,
+                                    (int32_t)views[0].recommendedImageRectHeight};
+        std::vector<client::Swapchain> swapchains;
+        auto swapchainsGuard = MakeScopeGuard([&] {
+            for (auto& swapchain : swapchains) {
+                client.destroySwapchain(swapchain);
+            }
+        });
+        swapchains.push_back(
+            client.createSwapchain(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, eyeExtent.width, eyeExtent.height, 2));
+
+        XrCompositionLayerProjectionView projectionViews[2]{{XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW},
+                                                            {XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW}};
+        XrCompositionLayerProjection projection{XR_TYPE_COMPOSITION_LAYER_PROJECTION};
+        projection.space = localSpace;
+        projection.viewCount = (uint32_t)std::size(projectionViews);
+        projection.views = projectionViews;
+        for (uint32_t eye = 0; eye < 2; eye++) {
+            projectionViews[eye].subImage.swapchain = swapchains[0].handle;
+            projectionViews[eye].subImage.imageArrayIndex = eye;
+            projectionViews[eye].subImage.imageRect.extent = eyeExtent;
+        }
+
+        std::vector<XrCompositionLayerQuad> quads;
+        std::vector<XrCompositionLayerCylinderKHR> cylinders;
+        quads.reserve(layerCount);
+        cylinders.reserve(layerCount);
+        std::vector<const XrCompositionLayerBaseHeader*> layers;
+        layers.push_back(reinterpret_cast<const XrCompositionLayerBaseHeader*>(&projection));
+        for (uint32_t i = 1; i < layerCount; i++) {
+            swapchains.push_back(
+                client.createSwapchain(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, LayerImageSize, LayerImageSize));
+
+            XrSwapchainSubImage subImage{};
+            subImage.swapchain = swapchains.back().handle;
+            subImage.imageRect.extent = {(int32_t)LayerImageSize, (int32_t)LayerImageSize};
+            const float angle = (i - layerCount / 2.f) * 0.2f;
+            const XrPosef pose{{0, std::sin(angle / 2), 0, std::cos(angle / 2)},
+                               {1.5f * std::sin(angle), 0.25f * (i % 3) - 0.25f, -1.5f * std::cos(angle)}};
+            if (useCylinders && i % 2 == 0) {
+                XrCompositionLayerCylinderKHR cylinder{XR_TYPE_COMPOSITION_LAYER_CYLINDER_KHR};
+                cylinder.layerFlags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT;
+                cylinder.space = localSpace;
+                cylinder.subImage = subImage;
+                cylinder.pose = {{0, 0, 0, 1}, pose.position};
+                cylinder.radius = 1.5f;
+                cylinder.centralAngle = 0.2f;
+                cylinder.aspectRatio = 1.f;
+                cylinders.push_back(cylinder);
+                layers.push_back(reinterpret_cast<const XrCompositionLayerBaseHeader*>(&cylinders.back()));
+            } else {
+                XrCompositionLayerQuad quad{XR_TYPE_COMPOSITION_LAYER_QUAD};
+                quad.layerFlags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT;
+                quad.space = localSpace;
+                quad.subImage = subImage;
+                quad.pose = pose;
+                quad.size = {0.3f, 0.3f};
+                quads.push_back(quad);
+                layers.push_back(reinterpret_cast<const XrCompositionLayerBaseHeader*>(&quads.back()));
+            }
+        }
+
+        client.waitForFocus();
+
+        // Everything below runs concurrently with the frame loop.
+        std::atomic<bool> stopWorkers{false};
+        std::atomic<XrTime> displayTime{0};
+        std::atomic<uint64_t> errors{0};
+        std::vector<Histograms> workerHistograms(options.threads);
+        std::vector<std::thread> workers;
+        const auto worker = [&](uint32_t index) {
+            auto& histograms = workerHistograms[index];
+            std::mt19937 random(index);
+            XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
+            XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
+            XrActionStateBoolean booleanState{XR_TYPE_ACTION_STATE_BOOLEAN};
+            XrActionStateFloat floatState{XR_TYPE_ACTION_STATE_FLOAT};
+            XrActionStateVector2f vector2fState{XR_TYPE_ACTION_STATE_VECTOR2F};
+            XrActionStatePose poseState{XR_TYPE_ACTION_STATE_POSE};
+            XrHandJointLocationEXT handJoints[XR_HAND_JOINT_COUNT_EXT];
+            XrHandJointLocationsEXT handLocations{XR_TYPE_HAND_JOINT_LOCATIONS_EXT};
+            handLocations.jointCount = XR_HAND_JOINT_COUNT_EXT;
+            handLocations.jointLocations = handJoints;
+            XrBodyJointLocationFB bodyJoints[XR_BODY_JOINT_COUNT_FB];
+            XrBodyJointLocationsFB bodyLocations{XR_TYPE_BODY_JOINT_LOCATIONS_FB};
+            bodyLocations.jointCount = XR_BODY_JOINT_COUNT_FB;
+            bodyLocations.jointLocations = bodyJoints;
+
+            while (!stopWorkers) {
+                // Queries need a display time, which the frame loop only publishes after its first xrWaitFrame().
+                const XrTime time = displayTime;
+                if (!time) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                XrResult result;
+
+                for (uint32_t i = 0; !actionSpaces.empty() && i < 4; i++) {
+                    const XrSpace space = actionSpaces[random() % actionSpaces.size()];
+                    result = Measure(histograms, Api::LocateSpace, [&] {
+                        return xr.xrLocateSpace(space, localSpace, time, &location);
+                    });
+                    errors += XR_FAILED(result) ? 1 : 0;
+                }
+
+                for (uint32_t i = 0; !inputActions.empty() && i < 8; i++) {
+                    const auto& [action, type] = inputActions[random() % inputActions.size()];
+                    getInfo.action = action;
+                    getInfo.subactionPath = hands[random() % std::size(hands)];
+                    switch (type) {
+                    case XR_ACTION_TYPE_BOOLEAN_INPUT:
+                        result = Measure(histograms, Api::GetActionStateBoolean, [&] {
+                            return xr.xrGetActionStateBoolean(session, &getInfo, &booleanState);
+                        });
+                        break;
+                    case XR_ACTION_TYPE_FLOAT_INPUT:
+                        result = Measure(histograms, Api::GetActionStateFloat, [&] {
+                            return xr.xrGetActionStateFloat(session, &getInfo, &floatState);
+                        });
+                        break;
+                    case XR_ACTION_TYPE_VECTOR2F_INPUT:
+                        result = Measure(histograms, Api::GetActionStateVector2f, [&] {
+                            return xr.xrGetActionStateVector2f(session, &getInfo, &vector2fState);
+                        });
+                        break;
+                    default:
+                        result = Measure(histograms, Api::GetActionStatePose, [&] {
+                            return xr.xrGetActionStatePose(session, &getInfo, &poseState);
+                        });
+                        break;
+                    }
+                    errors += XR_FAILED(result) ? 1 : 0;
+                }
+
+                XrHandJointsLocateInfoEXT handLocateInfo{XR_TYPE_HAND_JOINTS_LOCATE_INFO_EXT};
+                handLocateInfo.baseSpace = localSpace;
+                handLocateInfo.time = time;
+                for (const auto handTracker : handTrackers) {
+                    result = Measure(histograms, Api::LocateHandJoints, [&] {
+                        return xr.xrLocateHandJointsEXT(handTracker, &handLocateInfo, &handLocations);
+                    });
+                    errors += XR_FAILED(result) ? 1 : 0;
+                }
+
+                if (bodyTracker != XR_NULL_HANDLE) {
+                    XrBodyJointsLocateInfoFB bodyLocateInfo{XR_TYPE_BODY_JOINTS_LOCATE_INFO_FB};
+                    bodyLocateInfo.baseSpace = localSpace;
+                    bodyLocateInfo.time = time;
+                    result = Measure(histograms, Api::LocateBodyJoints, [&] {
+                        return xr.xrLocateBodyJointsFB(bodyTracker, &bodyLocateInfo, &bodyLocations);
+                    });
+                    errors += XR_FAILED(result) ? 1 : 0;
+                }
+            }
+        };
+
+        Histograms histograms;
+        latency::Histogram frameTimes;
+        uint64_t frames = 0;
+        XrActionsSyncInfo syncInfo{XR_TYPE_ACTIONS_SYNC_INFO};
+        syncInfo.countActiveActionSets = (uint32_t)activeActionSets.size();
+        syncInfo.activeActionSets = activeActionSets.data();
+        XrViewLocateInfo viewLocateInfo{XR_TYPE_VIEW_LOCATE_INFO};
+        viewLocateInfo.viewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+        viewLocateInfo.space = localSpace;
+        XrViewState viewState{XR_TYPE_VIEW_STATE};
+        XrView eyeViews[2]{{XR_TYPE_VIEW}, {XR_TYPE_VIEW}};
+
+        const auto start = std::chrono::steady_clock::now();
+        auto lastFrame = start;
+        {
+            auto workersGuard = MakeScopeGuard([&] {
+                stopWorkers = true;
+                for (auto& thread : workers) {
+                    thread.join();
+                }
+            });
+            for (uint32_t i = 0; i < options.threads; i++) {
+                workers.emplace_back(worker, i);
+            }
+
+            while (std::chrono::steady_clock::now() - start < options.duration) {
+                client.pollEvents();
+
+                XrFrameState frameState{XR_TYPE_FRAME_STATE};
+                CHECK_XRCMD(
+                    Measure(histograms, Api::WaitFrame, [&] { return xr.xrWaitFrame(session, nullptr, &frameState); }));
+                displayTime = frameState.predictedDisplayTime;
+                CHECK_XRCMD(Measure(histograms, Api::BeginFrame, [&] { return xr.xrBeginFrame(session, nullptr); }));
+
+                CHECK_XRCMD(
+                    Measure(histograms, Api::SyncActions, [&] { return xr.xrSyncActions(session, &syncInfo); }));
+
+                viewLocateInfo.displayTime = frameState.predictedDisplayTime;
+                uint32_t viewCount;
+                CHECK_XRCMD(Measure(histograms, Api::LocateViews, [&] {
+                    return xr.xrLocateViews(
+                        session, &viewLocateInfo, &viewState, (uint32_t)std::size(eyeViews), &viewCount, eyeViews);
+                }));
+                for (uint32_t eye = 0; eye < 2; eye++) {
+                    projectionViews[eye].pose = eyeViews[eye].pose;
+                    projectionViews[eye].fov = eyeViews[eye].fov;
+                }
+
+                for (const auto& swapchain : swapchains) {
+                    uint32_t index;
+                    CHECK_XRCMD(Measure(histograms, Api::AcquireSwapchainImage, [&] {
+                        return xr.xrAcquireSwapchainImage(swapchain.handle, nullptr, &index);
+                    }));
+                    XrSwapchainImageWaitInfo waitInfo{XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO};
+                    waitInfo.timeout = XR_INFINITE_DURATION;
+                    CHECK_XRCMD(Measure(histograms, Api::WaitSwapchainImage, [&] {
+                        return xr.xrWaitSwapchainImage(swapchain.handle, &waitInfo);
+                    }));
+                    CHECK_XRCMD(Measure(histograms, Api::ReleaseSwapchainImage, [&] {
+                        return xr.xrReleaseSwapchainImage(swapchain.handle, nullptr);
+                    }));
+                }
+
+                XrFrameEndInfo endInfo{XR_TYPE_FRAME_END_INFO};
+                endInfo.displayTime = frameState.predictedDisplayTime;
+                endInfo.environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE;
+                endInfo.layerCount = frameState.shouldRender ? (uint32_t)layers.size() : 0;
+                endInfo.layers = layers.data();
+                CHECK_XRCMD(Measure(histograms, Api::EndFrame, [&] { return xr.xrEndFrame(session, &endInfo); }));
+
+                const auto now = std::chrono::steady_clock::now();
+                frameTimes.record(std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastFrame).count());
+                lastFrame = now;
+                frames++;
+            }
+        }
+        const double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        CHECK_MSG(!errors, fmt::format("{} calls failed on the worker threads", errors.load()));
+
+        for (const auto& workerHistogram : workerHistograms) {
+            for (size_t i = 0; i < histograms.size(); i++) {
+                histograms[i].merge(workerHistogram[i]);
+            }
+        }
+
+        Report report;
+        report.frames = frames;
+        report.duration = duration;
+        report.frameRate = frames / duration;
+        report.frameTimeP50 = frameTimes.getPercentile(50) / 1e6;
+        report.frameTimeP99 = frameTimes.getPercentile(99) / 1e6;
+        report.actions = (uint32_t)inputActions.size();
+        report.actionSpaces = (uint32_t)actionSpaces.size();
+        report.layers = (uint32_t)layers.size();
+        report.threads = options.threads;
+        for (size_t i = 0; i < histograms.size(); i++) {
+            const auto& histogram = histograms[i];
+            if (!histogram.getCount()) {
+                continue;
+            }
+            const uint64_t median = histogram.getPercentile(50);
+            report.apis.push_back({ToString((Api)i),
+                                   histogram.getCount(),
+                                   histogram.getMean() / 1e3,
+                                   median / 1e3,
+                                   histogram.getPercentile(90) / 1e3,
+                                   histogram.getPercentile(99) / 1e3,
+                                   histogram.getMax() / 1e3,
+                                   histogram.getCountAbove(10 * median)});
+        }
+
+        return report;
+    }
+
+    void Print(const Report& report) {
+        printf("%llu frames in %.1f s: %.1f fps (frame time p50 %.2f ms, p99 %.2f ms)\n",
+               report.frames,
+               report.duration,
+               report.frameRate,
+               report.frameTimeP50,
+               report.frameTimeP99);
+        printf("%u actions, %u action spaces, %u layers, %u threads\n",
+               report.actions,
+               report.actionSpaces,
+               report.layers,
+               report.threads);
+        printf("%-28s %12s %10s %10s %10s %10s %10s %10s\n",
+               "API",
+               "Calls",
+               "Mean (us)",
+               "P50",
+               "P90",
+               "P99",
+               "Max",
+               "Stalls");
+        printf("%s\n", std::string(107, '-').c_str());
+        for (const auto& api : report.apis) {
+            printf("%-28s %12llu %10.2f %10.2f %10.2f %10.2f %10.2f %10llu\n",
+                   api.name.c_str(),
+                   api.calls,
+                   api.mean,
+                   api.p50,
+                   api.p90,
+                   api.p99,
+                   api.max,
+                   api.stalls);
+        }
+    }
+
+    void WriteJson(std::ostream& out, const Report& report, const std::map<std::string, std::string>& context) {
+        out << "{\n  \"context\": {";
+        bool first = true;
+        for (const auto& [key, value] : context) {
+            out << (first ? "\n" : ",\n") << "    \"" << harness::EscapeJson(key) << "\": \""
+                << harness::EscapeJson(value) << "\"";
+            first = false;
+        }
+        out << "\n  },\n";
+        out << "  \"frames\": " << report.frames << ",\n";
+        out << "  \"duration\": " << report.duration << ",\n";
+        out << "  \"frame_rate\": " << report.frameRate << ",\n";
+        out << "  \"frame_time_p50_ms\": " << report.frameTimeP50 << ",\n";
+        out << "  \"frame_time_p99_ms\": " << report.frameTimeP99 << ",\n";
+        out << "  \"actions\": " << report.actions << ",\n";
+        out << "  \"action_spaces\": " << report.actionSpaces << ",\n";
+        out << "  \"layers\": " << report.layers << ",\n";
+        out << "  \"threads\": " << report.threads << ",\n";
+        out << "  \"apis\": [";
+        first = true;
+        for (const auto& api : report.apis) {
+            out << (first ? "\n" : ",\n") << "    {\"name\": \"" << api.name << "\", \"calls\": " << api.calls
+                << ", \"mean_us\": " << api.mean << ", \"p50_us\": " << api.p50 << ", \"p90_us\": " << api.p90
+                << ", \"p99_us\": " << api.p99 << ", \"max_us\": " << api.max << ", \"stalls\": " << api.stalls
+                << "}";
+            first = false;
+        }
+        out << "\n  ]\n}\n";
+    }
+
+} // namespace benchmarks::loadgen
@@ -0,0 +1,95 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "client.h"
+#include "latency.h"
+
+namespace benchmarks::loadgen {
+
+    // The shape of the workload, defaulting to a heavy simulator.
+    struct Options {
+        std::chrono::duration<double> duration{10.0};
+        uint32_t actionSets{4};
+        // Number of copies of the gameplay actions in each action set (19 actions each).
+        uint32_t actionCopies{4};
+        // Total number of composition layers, including the projection layer.
+        uint32_t layers{12};
+        // Threads calling the locate and action APIs concurrently with the frame loop.
+        uint32_t threads{4};
+    };
+
+    enum class Api {
+        WaitFrame = 0,
+        BeginFrame,
+        EndFrame,
+        AcquireSwapchainImage,
+        WaitSwapchainImage,
+        ReleaseSwapchainImage,
+        SyncActions,
+        LocateViews,
+        LocateSpace,
+        GetActionStateBoolean,
+        GetActionStateFloat,
+        GetActionStateVector2f,
+        GetActionStatePose,
+        LocateHandJoints,
+        LocateBodyJoints,
+
+        Count
+    };
+
+    const char* ToString(Api api);
+
+    struct ApiStatistics {
+        std::string name;
+        uint64_t calls;
+        // Latencies in microseconds.
+        double mean;
+        double p50;
+        double p90;
+        double p99;
+        double max;
+        // Calls more than 10x slower than the median, typically caused by waiting on a lock.
+        uint64_t stalls;
+    };
+
+    struct Report {
+        uint64_t frames{0};
+        double duration{0};
+        double frameRate{0};
+        double frameTimeP50{0};
+        double frameTimeP99{0};
+        uint32_t actions{0};
+        uint32_t actionSpaces{0};
+        uint32_t layers{0};
+        uint32_t threads{0};
+        std::vector<ApiStatistics> apis;
+    };
+
+    Report Run(client::Client& client, const Options& options);
+
+    void Print(const Report& report);
+    void WriteJson(std::ostream& out, const Report& report, const std::map<std::string, std::string>& context);
+
+} // namespace benchmarks::loadgen
@@ -0,0 +1,122 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <async_log.h>
+
+#include "logging.h"
+
+namespace {
+
+    using namespace benchmarks::harness;
+    using virtualdesktop_openxr::log::AsyncLogger;
+
+    // Representative of the logs on the frame loop: a few scalars and strings, including a wide string.
+    constexpr const char* FrameMessage = "Frame %llu: submitted %u layers to %ls in %.3f ms (%s)\n";
+
+    // Let the writer catch up periodically, so that the measurement is of logging, rather than of dropping messages.
+    constexpr uint32_t FlushPeriod = 256;
+
+    void BM_AsyncLog(State& state, uint32_t threads) {
+        // Discard the output, it is only formatted.
+        AsyncLogger logger([](const std::string&) {});
+        logger.start();
+
+        // The other threads log as fast as they can, sharing the writer with the measured thread.
+        std::atomic<bool> isDone{false};
+        std::vector<std::thread> contendingThreads;
+        for (uint32_t i = 1; i < threads; i++) {
+            contendingThreads.emplace_back([&]() {
+                for (uint64_t frame = 0; !isDone.load(std::memory_order_relaxed); frame++) {
+                    logger.log(FrameMessage, frame, 3u, L"Compositor", 1.234, "XR_SUCCESS");
+                    if (frame % FlushPeriod == FlushPeriod - 1) {
+                        logger.flush();
+                    }
+                }
+            });
+        }
+
+        for (uint64_t frame = 0; state.keepRunning(); frame++) {
+            logger.log(FrameMessage, frame, 3u, L"Compositor", 1.234, "XR_SUCCESS");
+            if (frame % FlushPeriod == FlushPeriod - 1) {
+                state.pauseTiming();
+                logger.flush();
+                state.resumeTiming();
+            }
+        }
+
+        isDone = true;
+        for (auto& thread : contendingThreads) {
+            thread.join();
+        }
+        logger.stop();
+        state.setCounter("threads", threads);
+        state.setCounter("dropped", (double)logger.dropped());
+    }
+
+    // The logging prior to the deferred logger, which formats and flushes to the file on the calling thread.
+    void SynchronousLog(std::ofstream& stream, const char* fmt, ...) {
+        const std::time_t now = std::time(nullptr);
+
+        char buf[1024];
+        size_t offset = std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S %z: ", std::localtime(&now));
+        va_list va;
+        va_start(va, fmt);
+        vsnprintf(buf + offset, sizeof(buf) - offset, fmt, va);
+        va_end(va);
+        stream << buf;
+        stream.flush();
+    }
+
+    void BM_SynchronousLog(State& state) {
+        const auto path = std::filesystem::temp_directory_path() / "benchmark-log.txt";
+        {
+            std::ofstream stream(path);
+            if (!stream.is_open()) {
+                state.skip("Failed to open " + path.string());
+                return;
+            }
+
+            for (uint64_t frame = 0; state.keepRunning(); frame++) {
+                SynchronousLog(stream, FrameMessage, frame, 3u, L"Compositor", 1.234, "XR_SUCCESS");
+            }
+        }
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+} // namespace
+
+namespace benchmarks::logging {
+
+    std::vector<Benchmark> GetBenchmarks() {
+        std::vector<Benchmark> benchmarks;
+        benchmarks.push_back({"Log/Synchronous", [](State& state) { BM_SynchronousLog(state); }});
+        for (const uint32_t threads : {1u, 2u, 4u, 8u}) {
+            benchmarks.push_back({"Log/Async/Threads:" + std::to_string(threads),
+                                  [threads](State& state) { BM_AsyncLog(state, threads); }});
+        }
+        return benchmarks;
+    }
+
+} // namespace benchmarks::logging
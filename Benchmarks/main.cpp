@@ -0,0 +1,231 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "benchmarks.h"
+#include "loadgen.h"
+#include "logging.h"
+#include "replay.h"
+
+using namespace benchmarks;
+
+namespace {
+
+    void PrintUsage(const char* program) {
+        fprintf(stderr,
+                "Usage: %s [--runtime=<path>] [--benchmark_filter=<substring>] [--benchmark_min_time=<seconds>]\n"
+                "       [--benchmark_out=<file.json>]\n"
+                "       %s --load [--runtime=<path>] [--load_duration=<seconds>] [--load_action_sets=<count>]\n"
+                "       [--load_action_copies=<count>] [--load_layers=<count>] [--load_threads=<count>]\n"
+                "       [--benchmark_out=<file.json>]\n"
+                "       %s --replay=<file.capture> [--runtime=<path>] [--replay_speed=<factor>]\n"
+                "       [--benchmark_out=<file.json>]\n"
+                "       %s --logging [--benchmark_filter=<substring>] [--benchmark_min_time=<seconds>]\n"
+                "       [--benchmark_out=<file.json>]\n"
+                "\n"
+                "--load runs a synthetic application with many actions, layers and threads instead of the\n"
+                "microbenchmarks, and reports the latency distribution of each API under load.\n"
+                "\n"
+                "--replay re-issues the API calls captured by the runtime (with the \"capture\" registry setting),\n"
+                "at the original pacing by default, or as fast as possible with --replay_speed=0.\n"
+                "\n"
+                "--logging measures the cost of logging on the calling thread, under contention from other threads.\n"
+                "It does not load the runtime.\n"
+                "\n"
+                "The runtime defaults to the one next to this program. Place the OVRNull driver (LibOVRRT64_1.dll)\n"
+                "next to the runtime to run without a headset.\n",
+                program,
+                program,
+                program,
+                program);
+    }
+
+    std::filesystem::path GetProgramDirectory() {
+        wchar_t path[_MAX_PATH];
+        GetModuleFileNameW(nullptr, path, (DWORD)std::size(path));
+        return std::filesystem::path(path).parent_path();
+    }
+
+    std::string GetDateTime() {
+        const auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::tm tm{};
+        localtime_s(&tm, &now);
+        std::stringstream ss;
+        ss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%S");
+        return ss.str();
+    }
+
+    std::vector<harness::Result> RunBenchmarks(const std::vector<harness::Benchmark>& benchmarks,
+                                               const harness::Options& options) {
+        printf("%-48s %12s %12s %12s %12s %12s\n", "Benchmark", "Time (ns)", "CPU (ns)", "Median", "P99", "Iterations");
+        printf("%s\n", std::string(113, '-').c_str());
+        return harness::Run(benchmarks, options, [](const harness::Result& result) {
+            if (!result.error.empty()) {
+                printf("%-48s %s: %s\n",
+                       result.name.c_str(),
+                       result.skipped ? "SKIPPED" : "ERROR",
+                       result.error.c_str());
+                return;
+            }
+            printf("%-48s %12.1f %12.1f %12.1f %12.1f %12llu\n",
+                   result.name.c_str(),
+                   result.realTime,
+                   result.cpuTime,
+                   result.medianTime,
+                   result.p99Time,
+                   result.iterations);
+        });
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::filesystem::path runtimePath = GetProgramDirectory() /
+#ifdef _WIN64
+                                        L"virtualdesktop-openxr.dll";
+#else
+                                        L"virtualdesktop-openxr-32.dll";
+#endif
+    harness::Options options;
+    bool runLoad = false;
+    bool runLogging = false;
+    loadgen::Options loadOptions;
+    std::optional<std::filesystem::path> replayPath;
+    replay::Options replayOptions;
+    std::optional<std::filesystem::path> outputPath;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        const auto value = [&](const std::string& option) -> std::optional<std::string> {
+            if (arg.rfind(option + "=", 0) == 0) {
+                return arg.substr(option.size() + 1);
+            }
+            return {};
+        };
+
+        if (const auto path = value("--runtime")) {
+            runtimePath = path.value();
+        } else if (const auto filter = value("--benchmark_filter")) {
+            options.filter = filter.value();
+        } else if (const auto minTime = value("--benchmark_min_time")) {
+            options.minTime = std::chrono::duration<double>(std::stod(minTime.value()));
+        } else if (const auto out = value("--benchmark_out")) {
+            outputPath = out.value();
+        } else if (arg == "--load") {
+            runLoad = true;
+        } else if (arg == "--logging") {
+            runLogging = true;
+        } else if (const auto duration = value("--load_duration")) {
+            loadOptions.duration = std::chrono::duration<double>(std::stod(duration.value()));
+        } else if (const auto actionSets = value("--load_action_sets")) {
+            loadOptions.actionSets = std::stoul(actionSets.value());
+        } else if (const auto actionCopies = value("--load_action_copies")) {
+            loadOptions.actionCopies = std::stoul(actionCopies.value());
+        } else if (const auto layers = value("--load_layers")) {
+            loadOptions.layers = std::stoul(layers.value());
+        } else if (const auto threads = value("--load_threads")) {
+            loadOptions.threads = std::stoul(threads.value());
+        } else if (const auto path = value("--replay")) {
+            replayPath = path.value();
+        } else if (const auto speed = value("--replay_speed")) {
+            replayOptions.speed = std::stod(speed.value());
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    try {
+        if (runLogging) {
+            const auto results = RunBenchmarks(logging::GetBenchmarks(), options);
+            if (outputPath) {
+                std::ofstream out(outputPath.value());
+                CHECK_MSG(out.is_open(), fmt::format("Failed to open {}", outputPath.value().string()));
+                harness::WriteJson(out, results, {{"date", GetDateTime()}, {"executable", argv[0]}});
+            }
+            return 0;
+        }
+
+        std::optional<replay::Capture> capture;
+        if (replayPath) {
+            capture = replay::Load(replayPath.value());
+        }
+
+        client::Client client(runtimePath);
+        client.createInstance(capture ? capture->extensions
+                                      : std::vector<std::string>{XR_EXT_HAND_TRACKING_EXTENSION_NAME,
+                                                                 XR_FB_BODY_TRACKING_EXTENSION_NAME,
+                                                                 XR_KHR_VISIBILITY_MASK_EXTENSION_NAME,
+                                                                 XR_KHR_COMPOSITION_LAYER_CYLINDER_EXTENSION_NAME,
+                                                                 XR_KHR_LOCATE_SPACES_EXTENSION_NAME});
+        const std::map<std::string, std::string> context{
+            {"date", GetDateTime()},
+            {"executable", argv[0]},
+            {"runtime", client.getRuntimeName()},
+            {"runtime_path", runtimePath.string()},
+#ifdef _DEBUG
+            {"library_build_type", "debug"},
+#else
+            {"library_build_type", "release"},
+#endif
+        };
+        const auto openOutput = [&]() {
+            std::ofstream out(outputPath.value());
+            CHECK_MSG(out.is_open(), fmt::format("Failed to open {}", outputPath.value().string()));
+            return out;
+        };
+
+        printf("Runtime: %s\n", client.getRuntimeName().c_str());
+        if (capture) {
+            const auto report = replay::Run(client, capture.value(), replayOptions);
+            replay::Print(report);
+            if (outputPath) {
+                auto out = openOutput();
+                replay::WriteJson(out, report, context);
+            }
+            return 0;
+        }
+
+        if (runLoad) {
+            const auto report = loadgen::Run(client, loadOptions);
+            loadgen::Print(report);
+            if (outputPath) {
+                auto out = openOutput();
+                loadgen::WriteJson(out, report, context);
+            }
+            return 0;
+        }
+
+        Fixture fixture(client);
+        const auto results = RunBenchmarks(GetBenchmarks(fixture), options);
+
+        if (outputPath) {
+            auto out = openOutput();
+            harness::WriteJson(out, results, context);
+        }
+    } catch (std::exception& exc) {
+        fprintf(stderr, "%s\n", exc.what());
+        return 1;
+    }
+
+    return 0;
+}
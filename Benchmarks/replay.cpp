@@ -0,0 +1,570 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <capture.h>
+#include <capture.gen.h>
+
+#include "harness.h"
+#include "replay.h"
+
+namespace benchmarks::replay {
+
+    namespace capture = virtualdesktop_openxr::capture;
+
+    namespace {
+
+        // Translation of the handles, atoms and times of the capture to their counterparts in the replay.
+        class Translator {
+          public:
+            template <typename T>
+            void translateArgument(T& argument, bool isAtom) {
+                if constexpr (capture::detail::IsAtomType<T>) {
+                    if (isAtom) {
+                        translate(argument);
+                    }
+                } else if constexpr (std::is_same_v<T, XrTime>) {
+                    translateTime(argument);
+                } else if constexpr (std::is_pointer_v<T>) {
+                    using Pointee = std::remove_pointer_t<T>;
+                    if constexpr (std::is_const_v<Pointee> &&
+                                  capture::detail::IsStructure<std::remove_const_t<Pointee>>::value) {
+                        translateChain(argument);
+                    } else if constexpr (std::is_same_v<Pointee, XrSwapchainImageBaseHeader>) {
+                        // The replay always uses D3D11, and the D3D12 images have the same layout.
+                        auto images = reinterpret_cast<XrSwapchainImageD3D11KHR*>(argument);
+                        for (uint32_t i = 0; images && i < m_capacity; i++) {
+                            if (images[i].type == XR_TYPE_SWAPCHAIN_IMAGE_D3D12_KHR) {
+                                images[i].type = XR_TYPE_SWAPCHAIN_IMAGE_D3D11_KHR;
+                            }
+                        }
+                    }
+                }
+
+                if constexpr (std::is_same_v<T, uint32_t>) {
+                    m_capacity = argument;
+                }
+            }
+
+            // Associate the outputs of the capture with the outputs of the replay.
+            template <typename T>
+            void learnOutput(capture::Decoder& decoder, const T& argument, bool isAtom, bool succeeded) {
+                uint64_t captured;
+                if (!decoder.readOutput(argument, isAtom, captured) || !succeeded) {
+                    return;
+                }
+
+                if constexpr (std::is_same_v<T, XrFrameState*>) {
+                    m_timeOffset = argument->predictedDisplayTime - (XrTime)captured;
+                } else if constexpr (std::is_pointer_v<T> && capture::detail::IsAtomType<std::remove_pointer_t<T>>) {
+                    m_atoms[captured] = capture::detail::AtomToValue(*argument);
+                }
+            }
+
+          private:
+            template <typename T>
+            void translate(const T& atom) {
+                const auto it = m_atoms.find(capture::detail::AtomToValue(atom));
+                if (it != m_atoms.cend()) {
+                    const_cast<T&>(atom) = capture::detail::ValueToAtom<T>(it->second);
+                }
+            }
+
+            void translateTime(const XrTime& time) {
+                const_cast<XrTime&>(time) += m_timeOffset;
+            }
+
+            template <typename T>
+            void translateArray(const T* array, uint32_t count) {
+                for (uint32_t i = 0; array && i < count; i++) {
+                    translate(array[i]);
+                }
+            }
+
+            // The decoded structures are owned by the decoder, so they may be modified in place.
+            void translateChain(const void* structure) {
+                auto entry = reinterpret_cast<const XrBaseInStructure*>(structure);
+                while (entry) {
+                    translateStructure(entry);
+                    entry = entry->next;
+                }
+            }
+
+            void translateStructure(const XrBaseInStructure* entry) {
+                switch (entry->type) {
+                case XR_TYPE_ACTION_CREATE_INFO: {
+                    const auto& createInfo = *reinterpret_cast<const XrActionCreateInfo*>(entry);
+                    translateArray(createInfo.subactionPaths, createInfo.countSubactionPaths);
+                    break;
+                }
+                case XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING: {
+                    const auto& bindings = *reinterpret_cast<const XrInteractionProfileSuggestedBinding*>(entry);
+                    translate(bindings.interactionProfile);
+                    for (uint32_t i = 0; bindings.suggestedBindings && i < bindings.countSuggestedBindings; i++) {
+                        translate(bindings.suggestedBindings[i].action);
+                        translate(bindings.suggestedBindings[i].binding);
+                    }
+                    break;
+                }
+                case XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO: {
+                    const auto& attachInfo = *reinterpret_cast<const XrSessionActionSetsAttachInfo*>(entry);
+                    translateArray(attachInfo.actionSets, attachInfo.countActionSets);
+                    break;
+                }
+                case XR_TYPE_ACTIONS_SYNC_INFO: {
+                    const auto& syncInfo = *reinterpret_cast<const XrActionsSyncInfo*>(entry);
+                    for (uint32_t i = 0; syncInfo.activeActionSets && i < syncInfo.countActiveActionSets; i++) {
+                        translate(syncInfo.activeActionSets[i].actionSet);
+                        translate(syncInfo.activeActionSets[i].subactionPath);
+                    }
+                    break;
+                }
+                case XR_TYPE_ACTIVE_ACTION_SET_PRIORITIES_EXT: {
+                    const auto& priorities = *reinterpret_cast<const XrActiveActionSetPrioritiesEXT*>(entry);
+                    for (uint32_t i = 0; priorities.actionSetPriorities && i < priorities.actionSetPriorityCount; i++) {
+                        translate(priorities.actionSetPriorities[i].actionSet);
+                    }
+                    break;
+                }
+                case XR_TYPE_ACTION_STATE_GET_INFO: {
+                    const auto& getInfo = *reinterpret_cast<const XrActionStateGetInfo*>(entry);
+                    translate(getInfo.action);
+                    translate(getInfo.subactionPath);
+                    break;
+                }
+                case XR_TYPE_HAPTIC_ACTION_INFO: {
+                    const auto& hapticInfo = *reinterpret_cast<const XrHapticActionInfo*>(entry);
+                    translate(hapticInfo.action);
+                    translate(hapticInfo.subactionPath);
+                    break;
+                }
+                case XR_TYPE_ACTION_SPACE_CREATE_INFO: {
+                    const auto& createInfo = *reinterpret_cast<const XrActionSpaceCreateInfo*>(entry);
+                    translate(createInfo.action);
+                    translate(createInfo.subactionPath);
+                    break;
+                }
+                case XR_TYPE_BOUND_SOURCES_FOR_ACTION_ENUMERATE_INFO: {
+                    const auto& enumerateInfo = *reinterpret_cast<const XrBoundSourcesForActionEnumerateInfo*>(entry);
+                    translate(enumerateInfo.action);
+                    break;
+                }
+                case XR_TYPE_INPUT_SOURCE_LOCALIZED_NAME_GET_INFO: {
+                    const auto& getInfo = *reinterpret_cast<const XrInputSourceLocalizedNameGetInfo*>(entry);
+                    translate(getInfo.sourcePath);
+                    break;
+                }
+                case XR_TYPE_VIEW_LOCATE_INFO: {
+                    const auto& locateInfo = *reinterpret_cast<const XrViewLocateInfo*>(entry);
+                    translateTime(locateInfo.displayTime);
+                    translate(locateInfo.space);
+                    break;
+                }
+                case XR_TYPE_SPACES_LOCATE_INFO_KHR: {
+                    const auto& locateInfo = *reinterpret_cast<const XrSpacesLocateInfoKHR*>(entry);
+                    translate(locateInfo.baseSpace);
+                    translateTime(locateInfo.time);
+                    translateArray(locateInfo.spaces, locateInfo.spaceCount);
+                    break;
+                }
+                case XR_TYPE_HAND_JOINTS_LOCATE_INFO_EXT: {
+                    const auto& locateInfo = *reinterpret_cast<const XrHandJointsLocateInfoEXT*>(entry);
+                    translate(locateInfo.baseSpace);
+                    translateTime(locateInfo.time);
+                    break;
+                }
+                case XR_TYPE_BODY_JOINTS_LOCATE_INFO_FB: {
+                    const auto& locateInfo = *reinterpret_cast<const XrBodyJointsLocateInfoFB*>(entry);
+                    translate(locateInfo.baseSpace);
+                    translateTime(locateInfo.time);
+                    break;
+                }
+                case XR_TYPE_FACE_EXPRESSION_INFO2_FB: {
+                    const auto& expressionInfo = *reinterpret_cast<const XrFaceExpressionInfo2FB*>(entry);
+                    translateTime(expressionInfo.time);
+                    break;
+                }
+                case XR_TYPE_EYE_GAZES_INFO_FB: {
+                    const auto& gazesInfo = *reinterpret_cast<const XrEyeGazesInfoFB*>(entry);
+                    translate(gazesInfo.baseSpace);
+                    translateTime(gazesInfo.time);
+                    break;
+                }
+                case XR_TYPE_FRAME_END_INFO: {
+                    const auto& frameEndInfo = *reinterpret_cast<const XrFrameEndInfo*>(entry);
+                    translateTime(frameEndInfo.displayTime);
+                    for (uint32_t i = 0; frameEndInfo.layers && i < frameEndInfo.layerCount; i++) {
+                        translateChain(frameEndInfo.layers[i]);
+                    }
+                    break;
+                }
+                case XR_TYPE_COMPOSITION_LAYER_PROJECTION: {
+                    const auto& projection = *reinterpret_cast<const XrCompositionLayerProjection*>(entry);
+                    translate(projection.space);
+                    for (uint32_t i = 0; projection.views && i < projection.viewCount; i++) {
+                        translateChain(&projection.views[i]);
+                    }
+                    break;
+                }
+                case XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW: {
+                    const auto& view = *reinterpret_cast<const XrCompositionLayerProjectionView*>(entry);
+                    translate(view.subImage.swapchain);
+                    break;
+                }
+                case XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR: {
+                    const auto& depthInfo = *reinterpret_cast<const XrCompositionLayerDepthInfoKHR*>(entry);
+                    translate(depthInfo.subImage.swapchain);
+                    break;
+                }
+                case XR_TYPE_COMPOSITION_LAYER_QUAD: {
+                    const auto& quad = *reinterpret_cast<const XrCompositionLayerQuad*>(entry);
+                    translate(quad.space);
+                    translate(quad.subImage.swapchain);
+                    break;
+                }
+                case XR_TYPE_COMPOSITION_LAYER_CYLINDER_KHR: {
+                    const auto& cylinder = *reinterpret_cast<const XrCompositionLayerCylinderKHR*>(entry);
+                    translate(cylinder.space);
+                    translate(cylinder.subImage.swapchain);
+                    break;
+                }
+                case XR_TYPE_COMPOSITION_LAYER_EQUIRECT2_KHR: {
+                    const auto& equirect = *reinterpret_cast<const XrCompositionLayerEquirect2KHR*>(entry);
+                    translate(equirect.space);
+                    translate(equirect.subImage.swapchain);
+                    break;
+                }
+                case XR_TYPE_COMPOSITION_LAYER_CUBE_KHR: {
+                    const auto& cube = *reinterpret_cast<const XrCompositionLayerCubeKHR*>(entry);
+                    translate(cube.space);
+                    translate(cube.swapchain);
+                    break;
+                }
+                default:
+                    break;
+                }
+            }
+
+            std::map<uint64_t, uint64_t> m_atoms;
+            XrTime m_timeOffset{0};
+            uint32_t m_capacity{0};
+        };
+
+        struct Outcome {
+            XrResult result{XR_SUCCESS};
+            int64_t duration{0};
+            // Whether the call was issued to the runtime.
+            bool replayed{false};
+        };
+
+        using Replayer = std::function<Outcome(capture::Decoder& decoder)>;
+
+        template <typename... Args, size_t... I>
+        void ReadArguments(capture::Decoder& decoder, std::tuple<Args...>& arguments, std::index_sequence<I...>) {
+            // The fold expression guarantees the order of evaluation.
+            ((std::get<I>(arguments) = decoder.readArgument<Args>()), ...);
+        }
+
+        template <typename... Args>
+        std::tuple<Args...> ReadArguments(capture::Decoder& decoder) {
+            std::tuple<Args...> arguments;
+            ReadArguments(decoder, arguments, std::index_sequence_for<Args...>{});
+            return arguments;
+        }
+
+        template <typename... Args>
+        void LearnOutputs(Translator& translator,
+                          capture::Decoder& decoder,
+                          uint32_t atoms,
+                          XrResult result,
+                          const std::tuple<Args...>& arguments) {
+            std::apply(
+                [&](const auto&... argument) {
+                    uint32_t index = 0;
+                    (translator.learnOutput(decoder, argument, (atoms >> index++) & 1, XR_SUCCEEDED(result)), ...);
+                },
+                arguments);
+        }
+
+        template <typename Function>
+        int64_t Measure(Function&& function) {
+            const auto start = std::chrono::steady_clock::now();
+            function();
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                .count();
+        }
+
+        // Decode, translate and issue a call with the signature of the function.
+        template <typename... Args>
+        Outcome Invoke(XrResult(XRAPI_PTR* function)(Args...),
+                       uint32_t atoms,
+                       Translator& translator,
+                       capture::Decoder& decoder) {
+            auto arguments = ReadArguments<Args...>(decoder);
+            std::apply(
+                [&](auto&... argument) {
+                    uint32_t index = 0;
+                    (translator.translateArgument(argument, (atoms >> index++) & 1), ...);
+                },
+                arguments);
+
+            Outcome outcome;
+            outcome.duration = Measure([&] { outcome.result = std::apply(function, arguments); });
+            outcome.replayed = true;
+            LearnOutputs(translator, decoder, atoms, outcome.result, arguments);
+
+            return outcome;
+        }
+
+        std::map<std::string, Replayer> GetReplayers(client::Client& client, Translator& translator) {
+            std::map<std::string, Replayer> replayers;
+            const auto& xr = client.dispatch();
+#define REPLAY_XR_FUNCTION(name)                                                                                       \
+    if (xr.name) {                                                                                                     \
+        replayers[#name] = [&translator, function = xr.name](capture::Decoder& decoder) {                              \
+            return Invoke(function, capture::atoms::name, translator, decoder);                                        \
+        };                                                                                                             \
+    }
+            FOR_EACH_XR_FUNCTION(REPLAY_XR_FUNCTION)
+#undef REPLAY_XR_FUNCTION
+
+            // The client owns the instance and the session, since they depend on the graphics device of the
+            // application.
+            replayers["xrCreateInstance"] = [&](capture::Decoder& decoder) {
+                auto arguments = ReadArguments<const XrInstanceCreateInfo*, XrInstance*>(decoder);
+                *std::get<1>(arguments) = client.getInstance();
+                LearnOutputs(translator, decoder, capture::atoms::xrCreateInstance, XR_SUCCESS, arguments);
+                return Outcome{};
+            };
+            replayers["xrDestroyInstance"] = [](capture::Decoder&) { return Outcome{}; };
+            replayers["xrCreateSession"] = [&](capture::Decoder& decoder) {
+                auto arguments = ReadArguments<XrInstance, const XrSessionCreateInfo*, XrSession*>(decoder);
+                Outcome outcome;
+                outcome.duration = Measure([&] {
+                    client.destroySession();
+                    client.createSession();
+                });
+                outcome.replayed = true;
+                *std::get<2>(arguments) = client.getSession();
+                LearnOutputs(translator, decoder, capture::atoms::xrCreateSession, outcome.result, arguments);
+                return outcome;
+            };
+            replayers["xrDestroySession"] = [&](capture::Decoder&) {
+                Outcome outcome;
+                outcome.duration = Measure([&] { client.destroySession(); });
+                outcome.replayed = true;
+                return outcome;
+            };
+
+            return replayers;
+        }
+
+        struct Statistics {
+            latency::Histogram histogram;
+            int64_t capturedTotal{0};
+            uint64_t failed{0};
+        };
+
+    } // namespace
+
+    Capture Load(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        CHECK_MSG(file.is_open(), fmt::format("Failed to open {}", path.string()));
+
+        capture::FileHeader header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        CHECK_MSG(file && header.magic == capture::FileMagic && header.version == capture::FileVersion,
+                  fmt::format("{} is not a supported capture", path.string()));
+
+        // The capture is cut short when the application is terminated, so the last record might be incomplete.
+        Capture result;
+        int type;
+        while ((type = file.get()) != EOF) {
+            if (type == (int)capture::RecordType::ApiName) {
+                capture::ApiNameRecord record{};
+                file.read(reinterpret_cast<char*>(&record), sizeof(record));
+                std::string name(record.length, '\0');
+                file.read(name.data(), name.size());
+                if (!file) {
+                    break;
+                }
+                if (record.api >= result.apis.size()) {
+                    result.apis.resize(record.api + 1);
+                }
+                result.apis[record.api] = name;
+            } else if (type == (int)capture::RecordType::Call) {
+                capture::CallRecord record{};
+                file.read(reinterpret_cast<char*>(&record), sizeof(record));
+                Call call{record.api, record.thread, (XrResult)record.result, record.startTime, record.duration};
+                call.payload.resize(record.payloadSize);
+                file.read(reinterpret_cast<char*>(call.payload.data()), call.payload.size());
+                if (!file) {
+                    break;
+                }
+                CHECK_MSG(record.api < result.apis.size(), "Invalid capture");
+                result.calls.push_back(std::move(call));
+            } else {
+                CHECK_MSG(false, "Invalid capture");
+            }
+        }
+
+        // The replay must enable the same extensions as the application.
+        for (const auto& call : result.calls) {
+            if (result.apis[call.api] == "xrCreateInstance" && XR_SUCCEEDED(call.result)) {
+                capture::Decoder decoder(call.payload.data(), call.payload.size());
+                const auto createInfo = decoder.readArgument<const XrInstanceCreateInfo*>();
+                for (uint32_t i = 0; createInfo && createInfo->enabledExtensionNames &&
+                                     i < createInfo->enabledExtensionCount;
+                     i++) {
+                    result.extensions.push_back(createInfo->enabledExtensionNames[i]);
+                }
+                break;
+            }
+        }
+
+        return result;
+    }
+
+    Report Run(client::Client& client, const Capture& capture, const Options& options) {
+        Translator translator;
+        const auto replayers = GetReplayers(client, translator);
+        auto sessionGuard = MakeScopeGuard([&] { client.destroySession(); });
+
+        Report report;
+        std::vector<Statistics> statistics(capture.apis.size());
+        const int64_t origin = capture.calls.empty() ? 0 : capture.calls.front().startTime;
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto& call : capture.calls) {
+            report.calls++;
+
+            // Reproduce the original pacing, scaled by the requested speed.
+            if (options.speed > 0) {
+                std::this_thread::sleep_until(
+                    start + std::chrono::nanoseconds((int64_t)((call.startTime - origin) / options.speed)));
+            }
+
+            const auto it = replayers.find(capture.apis[call.api]);
+            if (it == replayers.cend()) {
+                report.skipped++;
+                continue;
+            }
+
+            capture::Decoder decoder(call.payload.data(), call.payload.size());
+            const Outcome outcome = it->second(decoder);
+            if (!outcome.replayed) {
+                report.skipped++;
+                continue;
+            }
+
+            report.replayed++;
+            auto& apiStatistics = statistics[call.api];
+            apiStatistics.histogram.record(outcome.duration);
+            apiStatistics.capturedTotal += call.duration;
+            if (XR_SUCCEEDED(call.result) && XR_FAILED(outcome.result)) {
+                apiStatistics.failed++;
+                report.failed++;
+            }
+        }
+        report.duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (!capture.calls.empty()) {
+            const auto& last = capture.calls.back();
+            report.capturedDuration = (last.startTime + last.duration - origin) / 1e9;
+        }
+
+        for (size_t i = 0; i < statistics.size(); i++) {
+            const auto& histogram = statistics[i].histogram;
+            if (!histogram.getCount()) {
+                continue;
+            }
+            report.apis.push_back({capture.apis[i],
+                                   histogram.getCount(),
+                                   statistics[i].capturedTotal / 1e3 / histogram.getCount(),
+                                   histogram.getMean() / 1e3,
+                                   histogram.getPercentile(50) / 1e3,
+                                   histogram.getPercentile(99) / 1e3,
+                                   histogram.getMax() / 1e3,
+                                   statistics[i].failed});
+        }
+
+        return report;
+    }
+
+    void Print(const Report& report) {
+        printf("%llu calls (%llu replayed, %llu skipped, %llu failed) in %.1f s, captured in %.1f s\n",
+               report.calls,
+               report.replayed,
+               report.skipped,
+               report.failed,
+               report.duration,
+               report.capturedDuration);
+        printf("%-40s %12s %12s %10s %10s %10s %10s %10s\n",
+               "API",
+               "Calls",
+               "Captured",
+               "Mean (us)",
+               "P50",
+               "P99",
+               "Max",
+               "Failed");
+        printf("%s\n", std::string(131, '-').c_str());
+        for (const auto& api : report.apis) {
+            printf("%-40s %12llu %12.2f %10.2f %10.2f %10.2f %10.2f %10llu\n",
+                   api.name.c_str(),
+                   api.calls,
+                   api.capturedMean,
+                   api.mean,
+                   api.p50,
+                   api.p99,
+                   api.max,
+                   api.failed);
+        }
+    }
+
+    void WriteJson(std::ostream& out, const Report& report, const std::map<std::string, std::string>& context) {
+        out << "{\n  \"context\": {";
+        bool first = true;
+        for (const auto& [key, value] : context) {
+            out << (first ? "\n" : ",\n") << "    \"" << harness::EscapeJson(key) << "\": \""
+                << harness::EscapeJson(value) << "\"";
+            first = false;
+        }
+        out << "\n  },\n";
+        out << "  \"calls\": " << report.calls << ",\n";
+        out << "  \"replayed\": " << report.replayed << ",\n";
+        out << "  \"skipped\": " << report.skipped << ",\n";
+        out << "  \"failed\": " << report.failed << ",\n";
+        out << "  \"captured_duration\": " << report.capturedDuration << ",\n";
+        out << "  \"duration\": " << report.duration << ",\n";
+        out << "  \"apis\": [";
+        first = true;
+        for (const auto& api : report.apis) {
+            out << (first ? "\n" : ",\n") << "    {\"name\": \"" << api.name << "\", \"calls\": " << api.calls
+                << ", \"captured_mean_us\": " << api.capturedMean << ", \"mean_us\": " << api.mean
+                << ", \"p50_us\": " << api.p50 << ", \"p99_us\": " << api.p99 << ", \"max_us\": " << api.max
+                << ", \"failed\": " << api.failed << "}";
+            first = false;
+        }
+        out << "\n  ]\n}\n";
+    }
+
+} // namespace benchmarks::replay
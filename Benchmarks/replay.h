@@ -0,0 +1,84 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "client.h"
+#include "latency.h"
+
+namespace benchmarks::replay {
+
+    struct Options {
+        // Pacing relative to the capture: 1 for the original pacing, 2 for twice as fast, 0 for as fast as possible.
+        double speed{1.0};
+    };
+
+    struct Call {
+        uint16_t api;
+        uint16_t thread;
+        XrResult result;
+        int64_t startTime;
+        int64_t duration;
+        std::vector<uint8_t> payload;
+    };
+
+    // A capture written by the runtime when the "capture" registry setting is enabled.
+    struct Capture {
+        std::vector<std::string> apis;
+        std::vector<Call> calls;
+        std::vector<std::string> extensions;
+    };
+
+    Capture Load(const std::filesystem::path& path);
+
+    struct ApiStatistics {
+        std::string name;
+        uint64_t calls;
+        // Latencies in microseconds.
+        double capturedMean;
+        double mean;
+        double p50;
+        double p99;
+        double max;
+        // Calls that succeeded in the capture but failed during the replay.
+        uint64_t failed;
+    };
+
+    struct Report {
+        uint64_t calls{0};
+        uint64_t replayed{0};
+        // Calls to APIs that the replayer does not support.
+        uint64_t skipped{0};
+        uint64_t failed{0};
+        double capturedDuration{0};
+        double duration{0};
+        std::vector<ApiStatistics> apis;
+    };
+
+    // Re-issue the captured calls on a single thread in order of completion. The instance and session are created by
+    // the client, and the handles, paths and times of the capture are translated to their replayed counterparts.
+    Report Run(client::Client& client, const Capture& capture, const Options& options);
+
+    void Print(const Report& report);
+    void WriteJson(std::ostream& out, const Report& report, const std::map<std::string, std::string>& context);
+
+} // namespace benchmarks::replay
@@ -22,10 +22,12 @@
 
 #include "pch.h"
 
+#include "clock.h"
 #include "log.h"
 #include "driver.h"
 #include "utils.h"
 
+using namespace ovrnull::clock;
 using namespace ovrnull::driver;
 using namespace ovrnull::log;
 using namespace ovrnull::utils;
@@ -83,6 +85,9 @@ OVR_PUBLIC_FUNCTION(void) ovr_Destroy(ovrSession session) {
 }
 
 OVR_PUBLIC_FUNCTION(double) ovr_GetTimeInSeconds() {
+    if (const auto clock = GetVirtualClock()) {
+        return clock->now();
+    }
     LARGE_INTEGER now{};
     QueryPerformanceCounter(&now);
     return QpcToOvrTime(now);
@@ -427,10 +432,13 @@ OVR_PUBLIC_FUNCTION(double) ovr_GetPredictedDisplayTime(ovrSession session, long
 
 OVR_PUBLIC_FUNCTION(ovrResult) ovr_GetPerfStats(ovrSession session, ovrPerfStats* outStats) {
     DECLARE_INTEROP(interop);
-    *outStats = {};
-    // VDXR only uses this information.
-    outStats->FrameStatsCount = 1;
-    outStats->FrameStats[0].AswIsActive = interop->IsAswActive();
+    *outStats = interop->GetPerfStats();
+    return OvrResultWrapper(ovrSuccess);
+}
+
+OVR_PUBLIC_FUNCTION(ovrResult) ovr_ResetPerfStats(ovrSession session) {
+    DECLARE_INTEROP(interop);
+    interop->ResetPerfStats();
     return OvrResultWrapper(ovrSuccess);
 }
 
@@ -486,3 +494,60 @@ OVR_PUBLIC_FUNCTION(float) ovr_GetFloat(ovrSession session, const char* property
     TraceLoggingWrite(g_traceProvider, "OVR_GetFloat_Unsupported", TLArg(propertyName, "Property"));
     return defaultVal;
 }
+
+// Controls for the virtual clock (see clock.h), meant to be resolved with GetProcAddress() by a test harness. They
+// return false when the virtual clock is not enabled.
+
+OVR_PUBLIC_FUNCTION(ovrBool) ovrnull_IsVirtualTime() {
+    return GetVirtualClock() != nullptr;
+}
+
+OVR_PUBLIC_FUNCTION(ovrBool) ovrnull_SetFastForward(ovrBool enable) {
+    const auto clock = GetVirtualClock();
+    if (!clock) {
+        return false;
+    }
+    TraceLoggingWrite(g_traceProvider, "OVRNull_SetFastForward", TLArg(!!enable, "Enable"));
+    clock->setFastForward(enable);
+    return true;
+}
+
+OVR_PUBLIC_FUNCTION(ovrBool) ovrnull_AdvanceTime(double seconds) {
+    const auto clock = GetVirtualClock();
+    if (!clock) {
+        return false;
+    }
+    TraceLoggingWrite(g_traceProvider, "OVRNull_AdvanceTime", TLArg(seconds, "Seconds"));
+    clock->advance(seconds);
+    return true;
+}
+
+OVR_PUBLIC_FUNCTION(ovrBool) ovrnull_StepVsyncs(unsigned int count) {
+    const auto clock = GetVirtualClock();
+    if (!clock) {
+        return false;
+    }
+    TraceLoggingWrite(g_traceProvider, "OVRNull_StepVsyncs", TLArg(count, "Count"));
+    clock->stepVsyncs(count);
+    return true;
+}
+
+OVR_PUBLIC_FUNCTION(ovrBool) ovrnull_InjectVsyncJitter(double seconds) {
+    const auto clock = GetVirtualClock();
+    if (!clock) {
+        return false;
+    }
+    TraceLoggingWrite(g_traceProvider, "OVRNull_InjectVsyncJitter", TLArg(seconds, "Seconds"));
+    clock->injectJitter(seconds);
+    return true;
+}
+
+OVR_PUBLIC_FUNCTION(ovrBool) ovrnull_MissVsyncs(unsigned int count) {
+    const auto clock = GetVirtualClock();
+    if (!clock) {
+        return false;
+    }
+    TraceLoggingWrite(g_traceProvider, "OVRNull_MissVsyncs", TLArg(count, "Count"));
+    clock->missVsyncs(count);
+    return true;
+}
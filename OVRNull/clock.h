@@ -0,0 +1,154 @@
+// MIT License
+//
+// Copyright(c) 2024-2026 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+namespace ovrnull::clock {
+
+    // A simulated timeline (in seconds) replacing the wall clock and the vsync thread of the driver.
+    // Time only moves forward when the harness advances it, or when the app waits for a vsync in fast-forward mode.
+    // This makes frame pacing deterministic and lets tests run many times faster than real time.
+    class VirtualClock {
+      public:
+        VirtualClock(double startTime, double vsyncPeriod)
+            : m_now(startTime), m_vsyncPeriod(vsyncPeriod), m_nominalVsyncTime(startTime + vsyncPeriod),
+              m_lastVsyncTime(startTime) {
+        }
+
+        double now() const {
+            std::unique_lock lock(m_mutex);
+            return m_now;
+        }
+
+        // The time of the last signaled vsync.
+        double getLastVsyncTime() const {
+            std::unique_lock lock(m_mutex);
+            return m_lastVsyncTime;
+        }
+
+        long long getVsyncCount() const {
+            std::unique_lock lock(m_mutex);
+            return m_vsyncCount;
+        }
+
+        // Takes effect after the next vsync.
+        void setVsyncPeriod(double period) {
+            std::unique_lock lock(m_mutex);
+            m_vsyncPeriod = period;
+        }
+
+        void setFastForward(bool enable) {
+            std::unique_lock lock(m_mutex);
+            m_fastForward = enable;
+        }
+
+        bool isFastForward() const {
+            std::unique_lock lock(m_mutex);
+            return m_fastForward;
+        }
+
+        // Move the timeline forward and signal all the vsyncs that elapsed.
+        void advance(double seconds) {
+            std::unique_lock lock(m_mutex);
+            advanceTo(m_now + std::max(seconds, 0.0));
+        }
+
+        // Move the timeline forward to the next vsync(s).
+        void stepVsyncs(uint32_t count) {
+            std::unique_lock lock(m_mutex);
+            for (uint32_t i = 0; i < count; i++) {
+                advanceTo(getNextVsyncTime());
+            }
+        }
+
+        // Displace the next vsync from its nominal time, by at most one period.
+        void injectJitter(double seconds) {
+            std::unique_lock lock(m_mutex);
+            m_jitter = std::clamp(seconds, -m_vsyncPeriod, m_vsyncPeriod);
+        }
+
+        // The next vsyncs still elapse on the timeline, but they are not signaled, as if the compositor missed them.
+        void missVsyncs(uint32_t count) {
+            std::unique_lock lock(m_mutex);
+            m_vsyncsToMiss += count;
+        }
+
+        // Wait until a vsync later than lastVsync is signaled, and return the new vsync count. In fast-forward mode,
+        // the timeline is moved to that vsync immediately. Otherwise, the timeout (in real time) guards against a
+        // stalled harness.
+        long long waitForVsync(long long lastVsync, std::chrono::milliseconds timeout) {
+            std::unique_lock lock(m_mutex);
+            if (m_fastForward) {
+                while (m_vsyncCount <= lastVsync) {
+                    advanceTo(getNextVsyncTime());
+                }
+            } else {
+                m_vsyncSignaled.wait_for(lock, timeout, [&]() { return m_vsyncCount > lastVsync; });
+            }
+            return m_vsyncCount;
+        }
+
+      private:
+        double getNextVsyncTime() const {
+            return std::max(m_nominalVsyncTime + m_jitter, m_now);
+        }
+
+        void advanceTo(double time) {
+            bool signaled = false;
+            while (getNextVsyncTime() <= time) {
+                const double vsyncTime = getNextVsyncTime();
+                m_nominalVsyncTime += m_vsyncPeriod;
+                m_jitter = 0;
+                m_now = vsyncTime;
+                if (m_vsyncsToMiss) {
+                    m_vsyncsToMiss--;
+                    continue;
+                }
+                m_lastVsyncTime = vsyncTime;
+                m_vsyncCount++;
+                signaled = true;
+            }
+            m_now = std::max(m_now, time);
+
+            if (signaled) {
+                m_vsyncSignaled.notify_all();
+            }
+        }
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_vsyncSignaled;
+        double m_now;
+        double m_vsyncPeriod;
+        double m_nominalVsyncTime;
+        double m_jitter{0};
+        double m_lastVsyncTime;
+        long long m_vsyncCount{0};
+        uint32_t m_vsyncsToMiss{0};
+        bool m_fastForward{false};
+    };
+
+    // Returns the virtual clock when the OVRNULL_VIRTUAL_TIME environment variable is set ("manual" to only advance
+    // from the harness, any other value for fast-forward), or nullptr to use the wall clock.
+    VirtualClock* GetVirtualClock();
+
+} // namespace ovrnull::clock
@@ -0,0 +1,203 @@
+// MIT License
+//
+// Copyright(c) 2024-2026 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "pch.h"
+
+#include "compositor.h"
+
+namespace {
+
+    using namespace ovrnull::compositor;
+
+    // Keep a bit more than ovrMaxProvidedFrameStats.
+    constexpr size_t k_MaxHistory = 16;
+
+    constexpr const char* k_LayerTypeNames[] = {"projection", "quad", "cylinder", "cube"};
+    static_assert(std::size(k_LayerTypeNames) == (size_t)LayerType::Count);
+
+} // namespace
+
+namespace ovrnull::compositor {
+
+    Config ParseConfig(const std::string& config) {
+        Config result;
+
+        std::stringstream stream(config);
+        std::string entry;
+        while (std::getline(stream, entry, ',')) {
+            const auto separator = entry.find('=');
+            if (separator == std::string::npos) {
+                continue;
+            }
+            const std::string key = entry.substr(0, separator);
+            const std::string value = entry.substr(separator + 1);
+            const double number = std::strtod(value.c_str(), nullptr);
+
+            if (key == "frame_cost_ms") {
+                result.frameCost = number / 1000;
+            } else if (key == "layer_cost_ms") {
+                result.layerCost = number / 1000;
+            } else if (key == "submit_cpu_ms") {
+                result.submitCpuCost = number / 1000;
+            } else if (key == "contention") {
+                result.gpuContention = std::clamp(number, 0.0, 0.99);
+            } else if (key == "miss_rate") {
+                result.missedFrameRate = std::clamp(number, 0.0, 1.0);
+            } else if (key == "seed") {
+                result.seed = (uint32_t)number;
+            } else if (key == "asw") {
+                result.aswPolicy = value == "auto"     ? AswPolicy::Auto
+                                   : value == "forced" ? AswPolicy::Forced
+                                                       : AswPolicy::Off;
+            } else if (key == "asw_engage") {
+                result.aswEngageMissedFrames = std::max((uint32_t)number, 1u);
+            } else if (key == "asw_window") {
+                result.aswWindow = std::max((uint32_t)number, 1u);
+            } else if (key == "asw_disengage") {
+                result.aswDisengageFrames = std::max((uint32_t)number, 1u);
+            } else {
+                for (size_t i = 0; i < (size_t)LayerType::Count; i++) {
+                    if (key == std::string(k_LayerTypeNames[i]) + "_cost_ms_per_mp") {
+                        result.costPerMegapixel[i] = number / 1000;
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+    Model::Model(const Config& config)
+        : m_config(config), m_random(config.seed), m_aswActive(config.aswPolicy == AswPolicy::Forced) {
+    }
+
+    double Model::getGpuTime(const std::vector<Layer>& layers) const {
+        double gpuTime = m_config.frameCost;
+        for (const auto& layer : layers) {
+            gpuTime += m_config.layerCost + m_config.costPerMegapixel[(size_t)layer.type] * layer.pixels / 1e6;
+        }
+        return gpuTime / (1.0 - m_config.gpuContention);
+    }
+
+    bool Model::submit(const Submission& submission, const std::vector<Layer>& layers) {
+        const double gpuTime = getGpuTime(layers);
+        const double gpuEndTime = submission.submitTime + m_config.submitCpuCost + gpuTime;
+        const double deadline = submission.vsyncTime + getVsyncInterval() * submission.vsyncPeriod;
+        const double fullRateDeadline = submission.vsyncTime + submission.vsyncPeriod;
+
+        const bool forcedMiss = m_config.missedFrameRate > 0 &&
+                                std::uniform_real_distribution<double>(0.0, 1.0)(m_random) < m_config.missedFrameRate;
+        const bool missed = forcedMiss || gpuEndTime > deadline;
+        const bool onTimeAtFullRate = !forcedMiss && gpuEndTime <= fullRateDeadline;
+
+        if (missed) {
+            m_appDroppedFrameCount++;
+        }
+        if (m_config.submitCpuCost + gpuTime > submission.vsyncPeriod) {
+            m_compositorDroppedFrameCount++;
+        }
+        if (m_aswActive) {
+            if (missed) {
+                m_aswFailedFrameCount++;
+            } else {
+                m_aswPresentedFrameCount += getVsyncInterval() - 1;
+            }
+        }
+        m_adaptiveGpuPerformanceScale =
+            (float)(submission.vsyncPeriod / std::max(gpuEndTime - submission.vsyncTime, 1e-6));
+
+        FrameStats stats;
+        stats.hmdVsyncIndex = (int)submission.vsyncIndex;
+        stats.appFrameIndex = (int)submission.frameIndex;
+        stats.appDroppedFrameCount = m_appDroppedFrameCount;
+        stats.appMotionToPhotonLatency = (float)submission.motionToPhotonLatency;
+        stats.appCpuElapsedTime = (float)std::max(submission.submitTime - submission.vsyncTime, 0.0);
+        stats.compositorFrameIndex = m_compositorFrameIndex++;
+        stats.compositorDroppedFrameCount = m_compositorDroppedFrameCount;
+        stats.compositorLatency = (float)(m_config.submitCpuCost + gpuTime);
+        stats.compositorCpuElapsedTime = (float)m_config.submitCpuCost;
+        stats.compositorGpuElapsedTime = (float)gpuTime;
+        stats.compositorCpuStartToGpuEndElapsedTime = (float)(m_config.submitCpuCost + gpuTime);
+        stats.compositorGpuEndToVsyncElapsedTime = (float)std::max(deadline - gpuEndTime, 0.0);
+        stats.aswIsActive = m_aswActive;
+        stats.aswActivatedToggleCount = m_aswActivatedToggleCount;
+        stats.aswPresentedFrameCount = m_aswPresentedFrameCount;
+        stats.aswFailedFrameCount = m_aswFailedFrameCount;
+        m_history.push_front(stats);
+        if (m_history.size() > k_MaxHistory) {
+            m_history.pop_back();
+        }
+        m_unreportedFrames++;
+
+        // ASW changes apply to the next frame.
+        updateAsw(missed, onTimeAtFullRate);
+
+        return !missed;
+    }
+
+    void Model::updateAsw(bool missed, bool onTimeAtFullRate) {
+        if (m_config.aswPolicy != AswPolicy::Auto) {
+            return;
+        }
+
+        if (!m_aswActive) {
+            m_recentMisses.push_back(missed);
+            if (m_recentMisses.size() > m_config.aswWindow) {
+                m_recentMisses.pop_front();
+            }
+            if (std::count(m_recentMisses.cbegin(), m_recentMisses.cend(), true) >= m_config.aswEngageMissedFrames) {
+                m_aswActive = true;
+                m_aswActivatedToggleCount++;
+                m_onTimeStreak = 0;
+                m_recentMisses.clear();
+            }
+        } else {
+            m_onTimeStreak = onTimeAtFullRate ? m_onTimeStreak + 1 : 0;
+            if (m_onTimeStreak >= m_config.aswDisengageFrames) {
+                m_aswActive = false;
+                m_aswActivatedToggleCount++;
+            }
+        }
+    }
+
+    std::vector<FrameStats> Model::getStats(size_t maxCount, bool& anyDropped) {
+        const size_t count = std::min({maxCount, m_unreportedFrames, m_history.size()});
+        anyDropped = m_unreportedFrames > count;
+        m_unreportedFrames = 0;
+        return std::vector<FrameStats>(m_history.cbegin(), m_history.cbegin() + count);
+    }
+
+    void Model::reset() {
+        m_history.clear();
+        m_unreportedFrames = 0;
+        m_recentMisses.clear();
+        m_onTimeStreak = 0;
+        m_appDroppedFrameCount = 0;
+        m_compositorDroppedFrameCount = 0;
+        m_aswActivatedToggleCount = 0;
+        m_aswPresentedFrameCount = 0;
+        m_aswFailedFrameCount = 0;
+        m_adaptiveGpuPerformanceScale = 1.f;
+    }
+
+} // namespace ovrnull::compositor
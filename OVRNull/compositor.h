@@ -0,0 +1,157 @@
+// MIT License
+//
+// Copyright(c) 2024-2026 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+namespace ovrnull::compositor {
+
+    enum class LayerType : uint32_t { Projection = 0, Quad, Cylinder, Cube, Count };
+
+    enum class AswPolicy {
+        // Never engage.
+        Off,
+        // Engage after repeated missed frames, disengage after a streak of frames that would make it at full rate.
+        Auto,
+        // Always engaged.
+        Forced,
+    };
+
+    // All durations are in seconds.
+    struct Config {
+        // Compositor GPU work: a fixed cost per frame and per layer, plus a cost per megapixel sampled that depends on
+        // the type of layer.
+        double frameCost{0.0003};
+        double layerCost{0.00005};
+        double costPerMegapixel[(size_t)LayerType::Count]{0.0002, 0.00015, 0.0002, 0.0003};
+        // CPU time spent in ovr_EndFrame().
+        double submitCpuCost{0};
+        // Fraction of the GPU used by other work, in [0, 1). The compositor GPU work is stretched accordingly.
+        double gpuContention{0};
+        // Probability for a frame to be missed regardless of its timing. Deterministic for a given seed.
+        double missedFrameRate{0};
+        uint32_t seed{0};
+
+        AswPolicy aswPolicy{AswPolicy::Off};
+        // With the Auto policy, ASW engages after aswEngageMissedFrames missed frames within the last aswWindow frames.
+        uint32_t aswEngageMissedFrames{4};
+        uint32_t aswWindow{30};
+        uint32_t aswDisengageFrames{90};
+    };
+
+    // Parses comma-separated key=value pairs, eg: "asw=auto,contention=0.3,miss_rate=0.01". Costs are in
+    // milliseconds (frame_cost_ms, layer_cost_ms, submit_cpu_ms, <type>_cost_ms_per_mp with type being projection,
+    // quad, cylinder or cube). Unknown keys are ignored.
+    Config ParseConfig(const std::string& config);
+
+    struct Layer {
+        LayerType type;
+        uint64_t pixels;
+    };
+
+    struct Submission {
+        long long frameIndex{0};
+        long long vsyncIndex{0};
+        double vsyncPeriod{0};
+        // The vsync that released the app for this frame.
+        double vsyncTime{0};
+        double submitTime{0};
+        double motionToPhotonLatency{0};
+    };
+
+    // Mirrors ovrPerfStatsPerCompositorFrame.
+    struct FrameStats {
+        int hmdVsyncIndex{0};
+        int appFrameIndex{0};
+        int appDroppedFrameCount{0};
+        float appMotionToPhotonLatency{0};
+        float appQueueAheadTime{0};
+        float appCpuElapsedTime{0};
+        float appGpuElapsedTime{0};
+        int compositorFrameIndex{0};
+        int compositorDroppedFrameCount{0};
+        float compositorLatency{0};
+        float compositorCpuElapsedTime{0};
+        float compositorGpuElapsedTime{0};
+        float compositorCpuStartToGpuEndElapsedTime{0};
+        float compositorGpuEndToVsyncElapsedTime{0};
+        bool aswIsActive{false};
+        int aswActivatedToggleCount{0};
+        int aswPresentedFrameCount{0};
+        int aswFailedFrameCount{0};
+    };
+
+    // Decides whether each submitted frame makes it to its vsync, drives ASW, and keeps the frame statistics.
+    // Not thread-safe.
+    class Model {
+      public:
+        explicit Model(const Config& config = {});
+
+        const Config& getConfig() const {
+            return m_config;
+        }
+
+        double getGpuTime(const std::vector<Layer>& layers) const;
+
+        // Returns false when the frame missed its vsync.
+        bool submit(const Submission& submission, const std::vector<Layer>& layers);
+
+        bool isAswActive() const {
+            return m_aswActive;
+        }
+
+        // Number of vsyncs per app frame.
+        uint32_t getVsyncInterval() const {
+            return m_aswActive ? 2 : 1;
+        }
+
+        // Statistics for the frames submitted since the last call, most recent first.
+        std::vector<FrameStats> getStats(size_t maxCount, bool& anyDropped);
+
+        // Below 1 when the app and the compositor do not fit in a frame.
+        float getAdaptiveGpuPerformanceScale() const {
+            return m_adaptiveGpuPerformanceScale;
+        }
+
+        // Clears the counters and history, but not the state of ASW.
+        void reset();
+
+      private:
+        void updateAsw(bool missed, bool onTimeAtFullRate);
+
+        Config m_config;
+        std::mt19937 m_random;
+        std::deque<FrameStats> m_history;
+        size_t m_unreportedFrames{0};
+        std::deque<bool> m_recentMisses;
+        uint32_t m_onTimeStreak{0};
+        bool m_aswActive{false};
+        int m_compositorFrameIndex{0};
+        int m_appDroppedFrameCount{0};
+        int m_compositorDroppedFrameCount{0};
+        int m_aswActivatedToggleCount{0};
+        int m_aswPresentedFrameCount{0};
+        int m_aswFailedFrameCount{0};
+        float m_adaptiveGpuPerformanceScale{1.f};
+    };
+
+} // namespace ovrnull::compositor
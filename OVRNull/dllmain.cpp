@@ -22,6 +22,7 @@
 
 #include "pch.h"
 
+#include "clock.h"
 #include "log.h"
 #include "Utils.h"
 
@@ -33,6 +34,31 @@ namespace ovrnull::utils {
     }();
 } // namespace ovrnull::utils
 
+namespace ovrnull::clock {
+    VirtualClock* GetVirtualClock() {
+        static const std::unique_ptr<VirtualClock> clock = []() -> std::unique_ptr<VirtualClock> {
+            const auto value = utils::GetEnvironmentString("OVRNULL_VIRTUAL_TIME");
+            if (!value || value.value() == "0") {
+                return {};
+            }
+
+            // Start the timeline at the current time, so that it remains close to QPC.
+            LARGE_INTEGER now{};
+            QueryPerformanceCounter(&now);
+            auto clock = std::make_unique<VirtualClock>(utils::QpcToOvrTime(now), 1.0 / 72);
+            clock->setFastForward(value.value() != "manual");
+
+            TraceLoggingWrite(log::g_traceProvider,
+                              "VirtualClock",
+                              TLArg(clock->now(), "StartTime"),
+                              TLArg(clock->isFastForward(), "FastForward"));
+
+            return clock;
+        }();
+        return clock.get();
+    }
+} // namespace ovrnull::clock
+
 BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserved) {
     switch (ul_reason_for_call) {
     case DLL_PROCESS_ATTACH:
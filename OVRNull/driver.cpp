@@ -22,20 +22,44 @@
 
 #include "pch.h"
 
+#include "clock.h"
+#include "compositor.h"
 #include "constantsbuffer.h"
 #include "log.h"
 #include "driver.h"
+#include "playback.h"
 #include "utils.h"
 
 #include "ReprojectVS.h"
 #include "ReprojectPS.h"
 
+using namespace ovrnull::clock;
 using namespace ovrnull::driver;
 using namespace ovrnull::log;
 using namespace ovrnull::utils;
 
+namespace compositor = ovrnull::compositor;
+namespace playback = ovrnull::playback;
+
 namespace {
 
+    playback::Pose ToPlaybackPose(const ovrPosef& pose) {
+        return {{pose.Orientation.x, pose.Orientation.y, pose.Orientation.z, pose.Orientation.w},
+                {pose.Position.x, pose.Position.y, pose.Position.z}};
+    }
+
+    ovrPoseStatef FromPlaybackMotion(const playback::Motion& motion, double time) {
+        ovrPoseStatef pose{};
+        const auto& orientation = motion.pose.orientation;
+        const auto& position = motion.pose.position;
+        pose.ThePose.Orientation = {orientation[0], orientation[1], orientation[2], orientation[3]};
+        pose.ThePose.Position = {position[0], position[1], position[2]};
+        pose.LinearVelocity = {motion.linearVelocity[0], motion.linearVelocity[1], motion.linearVelocity[2]};
+        pose.AngularVelocity = {motion.angularVelocity[0], motion.angularVelocity[1], motion.angularVelocity[2]};
+        pose.TimeInSeconds = time;
+        return pose;
+    }
+
     class NullDriver : public IDriver {
       private:
         static inline const OVR::Posef k_HeadToLeftController = {{0, 0, 0, 1}, {-0.15f, -0.2f, -0.35f}};
@@ -78,9 +102,46 @@ namespace {
             m_controllerPose[1].ThePose = OVR::Posef(m_hmdPose.ThePose) * k_HeadToRightController;
             m_controllerSides = 0x3;
 
-            LARGE_INTEGER now{};
-            QueryPerformanceCounter(&now);
-            m_nextFramePredictedDisplayTime = QpcToOvrTime(now);
+            m_virtualClock = GetVirtualClock();
+            if (m_virtualClock) {
+                m_virtualClock->setVsyncPeriod(1.0 / m_displayRate);
+            }
+            m_nextFramePredictedDisplayTime = m_lastVsyncTime = GetTimeInSeconds();
+
+            {
+                const auto compositorConfig = GetEnvironmentString("OVRNULL_COMPOSITOR");
+                m_compositor = compositor::Model(compositor::ParseConfig(compositorConfig.value_or("")));
+                TraceLoggingWriteTagged(local,
+                                        "NullDriver_Ctor",
+                                        TLArg(compositorConfig.value_or("").c_str(), "Compositor"),
+                                        TLArg(m_compositor.isAswActive(), "AswActive"));
+            }
+
+            // Scripted motion and input, either from a file or generated.
+            if (const auto playbackFile = GetEnvironmentString("OVRNULL_PLAYBACK")) {
+                if (playbackFile.value() == "procedural") {
+                    m_playback = playback::GenerateProcedural(120.0, 1000.0);
+                } else {
+                    m_playback = playback::LoadTimeline(playbackFile.value());
+                }
+                if (m_playback && m_playback->empty()) {
+                    m_playback.reset();
+                }
+                m_playbackStartTime = GetTimeInSeconds();
+
+                TraceLoggingWriteTagged(local,
+                                        "NullDriver_Ctor",
+                                        TLArg(playbackFile.value().c_str(), "Playback"),
+                                        TLArg(m_playback.has_value(), "Loaded"),
+                                        TLArg(m_playback ? m_playback->getDuration() : 0.0, "Duration"),
+                                        TLArg(m_playback ? m_playback->isLooping() : false, "Loop"));
+            }
+            if (const auto recordFile = GetEnvironmentString("OVRNULL_RECORD")) {
+                m_recordPath = recordFile.value();
+                m_recordingStartTime = GetTimeInSeconds();
+
+                TraceLoggingWriteTagged(local, "NullDriver_Ctor", TLArg(recordFile.value().c_str(), "Record"));
+            }
 
             TraceLoggingWriteStop(local, "NullDriver_Ctor");
         }
@@ -95,6 +156,15 @@ namespace {
                 m_serverThread = {};
             }
 
+            if (m_recordPath && !m_recording.empty()) {
+                const bool saved = playback::SaveTimeline(m_recordPath.value(), m_recording);
+                TraceLoggingWriteTagged(local,
+                                        "NullDriver_Dtor",
+                                        TLArg(m_recordPath.value().c_str(), "Record"),
+                                        TLArg(m_recording.getSamples().size(), "Samples"),
+                                        TLArg(saved, "Saved"));
+            }
+
             while (!m_swapchains.empty()) {
                 Swapchain* swapchain = (Swapchain*)*m_swapchains.begin();
                 TraceLoggingWriteTagged(local, "NullDriver_Dtor", TLPArg(swapchain, "DeleteSwapchain"));
@@ -159,7 +229,8 @@ namespace {
                 }
             }
 
-            if (!m_serverThread.joinable()) {
+            // With the virtual clock, vsync is signaled by the clock itself.
+            if (!m_virtualClock && !m_serverThread.joinable()) {
                 m_terminateServerThread = false;
                 m_serverThread = std::thread([&]() {
                     SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
@@ -196,8 +267,8 @@ namespace {
                         }
 
                         std::unique_lock lock(m_frameMutex);
-                        m_nextFramePredictedDisplayTime =
-                            QpcToOvrTime(currentTime) + (1.0 / m_displayRate) + m_photonsTime;
+                        m_lastVsyncTime = QpcToOvrTime(currentTime);
+                        m_nextFramePredictedDisplayTime = m_lastVsyncTime + (1.0 / m_displayRate) + m_photonsTime;
                         m_lastSignaledVsync++;
                         m_frameVsync.notify_all();
 
@@ -442,11 +513,38 @@ namespace {
                                        "NullDriver_WaitForVsync_DirectModeComponent",
                                        TLArg(m_lastSignaledVsync, "LastSignaledVsync"));
 
+                // With ASW engaged, the app only gets every other vsync.
+                uint32_t vsyncInterval;
+                {
+                    std::unique_lock compositorLock(m_compositorMutex);
+                    vsyncInterval = m_compositor.getVsyncInterval();
+                }
+
                 // TODO: If the app fell behind, we shouldn't be waiting here.
-                const auto lastSignaledVsync = m_lastSignaledVsync;
-                m_frameVsync.wait_for(lock, 100ms, [&]() { return m_lastSignaledVsync > lastSignaledVsync; });
+                if (m_virtualClock) {
+                    // The timeline only moves when the harness advances it, or right away in fast-forward mode.
+                    m_lastSignaledVsync =
+                        m_virtualClock->waitForVsync(m_virtualClock->getVsyncCount() + vsyncInterval - 1, 5s);
+                    m_lastVsyncTime = m_virtualClock->getLastVsyncTime();
+                } else {
+                    const auto lastSignaledVsync = m_lastSignaledVsync;
+                    m_frameVsync.wait_for(lock, vsyncInterval * 100ms, [&]() {
+                        return m_lastSignaledVsync >= lastSignaledVsync + vsyncInterval;
+                    });
+                }
+                m_nextFramePredictedDisplayTime =
+                    m_lastVsyncTime + vsyncInterval * (1.0 / m_displayRate) + m_photonsTime;
                 m_lastWaitedFrame = frameIndex;
 
+                {
+                    std::unique_lock compositorLock(m_compositorMutex);
+                    m_currentFrame.frameIndex = frameIndex;
+                    m_currentFrame.vsyncIndex = m_lastSignaledVsync;
+                    m_currentFrame.vsyncPeriod = 1.0 / m_displayRate;
+                    m_currentFrame.vsyncTime = m_lastVsyncTime;
+                    m_currentFramePredictedDisplayTime = m_nextFramePredictedDisplayTime;
+                }
+
                 TraceLoggingWriteStop(wait,
                                       "NullDriver_WaitForVsync_DirectModeComponent",
                                       TLArg(m_lastSignaledVsync, "LastSignaledVsync"));
@@ -461,6 +559,9 @@ namespace {
             TraceLocalActivity(local);
             TraceLoggingWriteStart(local, "NullDriver_SubmitFrame");
 
+            double sensorSampleTime = 0;
+            const auto compositorLayers = GetCompositorLayers(layers, sensorSampleTime);
+
             if (m_mirrorRTV) {
                 const float clearColor[] = {0.f, 0.f, 0.f, 1.f};
                 m_submissionContext->ClearRenderTargetView(m_mirrorRTV.Get(), clearColor);
@@ -562,25 +663,103 @@ namespace {
                 }
             }
 
-            ProcessActionKeys();
+            // Account for the compositor work, which decides whether the frame made it and whether ASW engages.
+            {
+                std::unique_lock lock(m_compositorMutex);
+                compositor::Submission submission = m_currentFrame;
+                submission.submitTime = GetTimeInSeconds();
+                if (sensorSampleTime > 0) {
+                    submission.motionToPhotonLatency = m_currentFramePredictedDisplayTime - sensorSampleTime;
+                }
+                const bool onTime = m_compositor.submit(submission, compositorLayers);
+
+                TraceLoggingWriteTagged(local,
+                                        "NullDriver_SubmitFrame",
+                                        TLArg(compositorLayers.size(), "Layers"),
+                                        TLArg(m_compositor.getGpuTime(compositorLayers), "CompositorGpuTime"),
+                                        TLArg(onTime, "OnTime"),
+                                        TLArg(m_compositor.isAswActive(), "AswActive"));
+            }
+
+            if (!m_playback) {
+                ProcessActionKeys();
+            }
 
             // "Maintain" the pose time.
             {
-                LARGE_INTEGER now{};
-                QueryPerformanceCounter(&now);
+                const double now = GetTimeInSeconds();
 
                 std::unique_lock lock(m_hmdPoseMutex);
-                m_hmdPose.TimeInSeconds = QpcToOvrTime(now);
+                m_hmdPose.TimeInSeconds = now;
                 std::unique_lock lock2(m_controllerMutex);
                 m_controllerPose[0].TimeInSeconds = m_controllerPose[1].TimeInSeconds =
                     m_controllerButtons.TimeInSeconds = m_hmdPose.TimeInSeconds;
             }
 
+            if (m_recordPath) {
+                RecordSample();
+            }
+
+            // Simulate the CPU time of the compositor submission.
+            const double submitCpuCost = m_compositor.getConfig().submitCpuCost;
+            if (submitCpuCost > 0) {
+                if (m_virtualClock) {
+                    if (m_virtualClock->isFastForward()) {
+                        m_virtualClock->advance(submitCpuCost);
+                    }
+                } else {
+                    const double endTime = GetTimeInSeconds() + submitCpuCost;
+                    while (GetTimeInSeconds() < endTime) {
+                        _mm_pause();
+                    }
+                }
+            }
+
             TraceLoggingWriteStop(local, "NullDriver_SubmitFrame");
 
             return true;
         }
 
+        std::vector<compositor::Layer> GetCompositorLayers(const std::vector<const ovrLayerHeader*>& layers,
+                                                           double& sensorSampleTime) const {
+            std::vector<compositor::Layer> compositorLayers;
+            const auto pixels = [](const ovrRecti& viewport) { return (uint64_t)viewport.Size.w * viewport.Size.h; };
+
+            std::shared_lock lock(m_swapchainMutex);
+            for (const ovrLayerHeader* layerHeader : layers) {
+                const ovrLayer_Union* layer = (ovrLayer_Union*)layerHeader;
+                if (!layer) {
+                    continue;
+                }
+
+                switch (layer->Header.Type) {
+                case ovrLayerType_EyeFov:
+                case ovrLayerType_EyeFovDepth:
+                    compositorLayers.push_back({compositor::LayerType::Projection,
+                                                pixels(layer->EyeFov.Viewport[ovrEye_Left]) +
+                                                    pixels(layer->EyeFov.Viewport[ovrEye_Right])});
+                    sensorSampleTime = layer->EyeFov.SensorSampleTime;
+                    break;
+                case ovrLayerType_Quad:
+                    compositorLayers.push_back({compositor::LayerType::Quad, pixels(layer->Quad.Viewport)});
+                    break;
+                case ovrLayerType_Cylinder:
+                    compositorLayers.push_back({compositor::LayerType::Cylinder, pixels(layer->Cylinder.Viewport)});
+                    break;
+                case ovrLayerType_Cube:
+                    if (m_swapchains.count(layer->Cube.CubeMapTexture)) {
+                        const auto& desc = ((Swapchain*)layer->Cube.CubeMapTexture)->desc;
+                        compositorLayers.push_back({compositor::LayerType::Cube, 6ull * desc.Width * desc.Height});
+                    }
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            return compositorLayers;
+        }
+
         void ProcessActionKeys() {
 #define ACTION_KEY(label, key, action)                                                                                 \
     static bool wasCtrl##label##Pressed = false;                                                                       \
@@ -621,6 +800,41 @@ namespace {
             m_controllerPose[1].ThePose = OVR::Posef(m_hmdPose.ThePose) * k_HeadToRightController;
         }
 
+        void RecordSample() {
+            const double now = GetTimeInSeconds();
+
+            playback::Sample sample;
+            sample.time = now - m_recordingStartTime;
+            sample.poses[(size_t)playback::Device::Hmd] = ToPlaybackPose(GetHmdPose(now).ThePose);
+            sample.controllers = 0;
+            for (uint32_t side = 0; side < ovrHand_Count; side++) {
+                sample.poses[(size_t)playback::Device::LeftController + side] =
+                    ToPlaybackPose(GetControllerPose((ovrHandType)side, now).ThePose);
+                if (HasController((ovrHandType)side)) {
+                    sample.controllers |= 1 << side;
+                }
+            }
+            const ovrInputState inputState = GetControllerButtons();
+            sample.buttons = inputState.Buttons;
+            sample.touches = inputState.Touches;
+            for (uint32_t side = 0; side < ovrHand_Count; side++) {
+                sample.indexTrigger[side] = inputState.IndexTriggerRaw[side];
+                sample.handTrigger[side] = inputState.HandTriggerRaw[side];
+                sample.thumbstick[side][0] = inputState.ThumbstickRaw[side].x;
+                sample.thumbstick[side][1] = inputState.ThumbstickRaw[side].y;
+            }
+            m_recording.add(sample);
+        }
+
+        double GetTimeInSeconds() const {
+            if (m_virtualClock) {
+                return m_virtualClock->now();
+            }
+            LARGE_INTEGER now{};
+            QueryPerformanceCounter(&now);
+            return QpcToOvrTime(now);
+        }
+
         ovrPoseStatef PropagatePose(const ovrPoseStatef& pose, double time) const {
             const float deltaTime = (float)(time - pose.TimeInSeconds);
             if (deltaTime < FLT_EPSILON) {
@@ -691,10 +905,58 @@ namespace {
         }
 
         bool IsAswActive() const override {
-            return false;
+            std::unique_lock lock(m_compositorMutex);
+            return m_compositor.isAswActive();
+        }
+
+        ovrPerfStats GetPerfStats() override {
+            ovrPerfStats stats{};
+
+            std::unique_lock lock(m_compositorMutex);
+            bool anyDropped = false;
+            const auto frames = m_compositor.getStats(ovrMaxProvidedFrameStats, anyDropped);
+            for (size_t i = 0; i < frames.size(); i++) {
+                const auto& frame = frames[i];
+                auto& frameStats = stats.FrameStats[i];
+                frameStats.HmdVsyncIndex = frame.hmdVsyncIndex;
+                frameStats.AppFrameIndex = frame.appFrameIndex;
+                frameStats.AppDroppedFrameCount = frame.appDroppedFrameCount;
+                frameStats.AppMotionToPhotonLatency = frame.appMotionToPhotonLatency;
+                frameStats.AppQueueAheadTime = frame.appQueueAheadTime;
+                frameStats.AppCpuElapsedTime = frame.appCpuElapsedTime;
+                frameStats.AppGpuElapsedTime = frame.appGpuElapsedTime;
+                frameStats.CompositorFrameIndex = frame.compositorFrameIndex;
+                frameStats.CompositorDroppedFrameCount = frame.compositorDroppedFrameCount;
+                frameStats.CompositorLatency = frame.compositorLatency;
+                frameStats.CompositorCpuElapsedTime = frame.compositorCpuElapsedTime;
+                frameStats.CompositorGpuElapsedTime = frame.compositorGpuElapsedTime;
+                frameStats.CompositorCpuStartToGpuEndElapsedTime = frame.compositorCpuStartToGpuEndElapsedTime;
+                frameStats.CompositorGpuEndToVsyncElapsedTime = frame.compositorGpuEndToVsyncElapsedTime;
+                frameStats.AswIsActive = frame.aswIsActive;
+                frameStats.AswActivatedToggleCount = frame.aswActivatedToggleCount;
+                frameStats.AswPresentedFrameCount = frame.aswPresentedFrameCount;
+                frameStats.AswFailedFrameCount = frame.aswFailedFrameCount;
+            }
+            stats.FrameStatsCount = (int)frames.size();
+            stats.AnyFrameStatsDropped = anyDropped;
+            stats.AdaptiveGpuPerformanceScale = m_compositor.getAdaptiveGpuPerformanceScale();
+            stats.AswIsAvailable = m_compositor.getConfig().aswPolicy != compositor::AswPolicy::Off;
+            stats.VisibleProcessId = GetCurrentProcessId();
+
+            return stats;
+        }
+
+        void ResetPerfStats() override {
+            std::unique_lock lock(m_compositorMutex);
+            m_compositor.reset();
         }
 
         ovrPoseStatef GetHmdPose(double absTime) const override {
+            if (m_playback) {
+                return FromPlaybackMotion(m_playback->getMotion(playback::Device::Hmd, absTime - m_playbackStartTime),
+                                          absTime);
+            }
+
             ovrPoseStatef latched;
             {
                 std::shared_lock lock(m_hmdPoseMutex);
@@ -704,11 +966,20 @@ namespace {
         }
 
         bool HasController(ovrHandType side) const override {
+            if (m_playback) {
+                return m_playback->getSample(GetTimeInSeconds() - m_playbackStartTime).controllers & (1 << side);
+            }
+
             std::shared_lock lock(m_controllerMutex);
             return m_controllerSides & (1 << side);
         }
 
         ovrPoseStatef GetControllerPose(ovrHandType side, double absTime) const override {
+            if (m_playback) {
+                const auto device = (playback::Device)((uint32_t)playback::Device::LeftController + side);
+                return FromPlaybackMotion(m_playback->getMotion(device, absTime - m_playbackStartTime), absTime);
+            }
+
             ovrPoseStatef latched;
             {
                 std::shared_lock lock(m_controllerMutex);
@@ -719,6 +990,18 @@ namespace {
 
         ovrInputState GetControllerButtons() const override {
             ovrInputState inputState = m_controllerButtons;
+            if (m_playback) {
+                const double now = GetTimeInSeconds();
+                const auto sample = m_playback->getSample(now - m_playbackStartTime);
+                inputState.TimeInSeconds = now;
+                inputState.Buttons = sample.buttons;
+                inputState.Touches = sample.touches;
+                for (uint32_t side = 0; side < ovrHand_Count; side++) {
+                    inputState.IndexTriggerRaw[side] = sample.indexTrigger[side];
+                    inputState.HandTriggerRaw[side] = sample.handTrigger[side];
+                    inputState.ThumbstickRaw[side] = {sample.thumbstick[side][0], sample.thumbstick[side][1]};
+                }
+            }
             for (uint32_t side = 0; side < ovrHand_Count; side++) {
                 inputState.IndexTrigger[side] = inputState.IndexTriggerNoDeadzone[side] =
                     inputState.IndexTriggerRaw[side];
@@ -735,6 +1018,7 @@ namespace {
       private:
         std::thread m_serverThread;
         std::atomic<bool> m_terminateServerThread = false;
+        VirtualClock* m_virtualClock{nullptr};
 
         LUID m_adapterLuid{};
         ComPtr<ID3D11Device> m_submissionDevice;
@@ -763,6 +1047,12 @@ namespace {
         ovrPoseStatef m_controllerPose[ovrHand_Count]{{OVR::Posef::Identity()}, {OVR::Posef::Identity()}};
         ovrInputState m_controllerButtons{};
 
+        std::optional<playback::Timeline> m_playback;
+        double m_playbackStartTime{0.0};
+        std::optional<std::filesystem::path> m_recordPath;
+        playback::Timeline m_recording;
+        double m_recordingStartTime{0.0};
+
         mutable std::shared_mutex m_hmdPoseMutex;
         ovrPoseStatef m_hmdPose{OVR::Posef::Identity()};
         ovrPosef m_eyePose[ovrEye_Count]{OVR::Posef::Identity(), OVR::Posef::Identity()};
@@ -771,7 +1061,13 @@ namespace {
         long long m_lastSignaledVsync{};
         long long m_lastWaitedFrame{};
         double m_nextFramePredictedDisplayTime{0.0};
+        double m_lastVsyncTime{0.0};
         std::condition_variable m_frameVsync;
+
+        mutable std::mutex m_compositorMutex;
+        compositor::Model m_compositor;
+        compositor::Submission m_currentFrame;
+        double m_currentFramePredictedDisplayTime{0.0};
     };
 
 } // namespace
@@ -54,6 +54,8 @@ namespace ovrnull::driver {
         virtual bool IsStageTracking() const = 0;
         virtual float GetEyeHeight() const = 0;
         virtual bool IsAswActive() const = 0;
+        virtual ovrPerfStats GetPerfStats() = 0;
+        virtual void ResetPerfStats() = 0;
 
         virtual ovrPoseStatef GetHmdPose(double absTime) const = 0;
 
@@ -37,13 +37,23 @@ using Microsoft::WRL::ComPtr;
 #include <intrin.h>
 #include <timeapi.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <ctime>
 #define _USE_MATH_DEFINES
 #include <cmath>
+#include <deque>
 #include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
 #include <shared_mutex>
+#include <sstream>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -0,0 +1,393 @@
+// MIT License
+//
+// Copyright(c) 2024-2026 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "pch.h"
+
+#include "playback.h"
+
+#include <cJSON.h>
+
+namespace {
+
+    using namespace ovrnull::playback;
+
+    constexpr char k_Magic[4] = {'O', 'V', 'N', 'T'};
+    constexpr uint32_t k_Version = 1;
+    constexpr uint32_t k_FlagLoop = 1 << 0;
+
+    struct BinaryHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t flags;
+        uint32_t sampleSize;
+        uint64_t sampleCount;
+    };
+
+    constexpr const char* k_DeviceNames[] = {"hmd", "left", "right"};
+    static_assert(std::size(k_DeviceNames) == (size_t)Device::Count);
+
+    void Multiply(const float a[4], const float b[4], float out[4]) {
+        const float x = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+        const float y = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+        const float z = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+        const float w = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+        out[0] = x;
+        out[1] = y;
+        out[2] = z;
+        out[3] = w;
+    }
+
+    void Rotate(const float q[4], const float v[3], float out[3]) {
+        const float p[4] = {v[0], v[1], v[2], 0};
+        const float conjugate[4] = {-q[0], -q[1], -q[2], q[3]};
+        float temp[4], result[4];
+        Multiply(q, p, temp);
+        Multiply(temp, conjugate, result);
+        out[0] = result[0];
+        out[1] = result[1];
+        out[2] = result[2];
+    }
+
+    void FromAxisAngle(float x, float y, float z, float angle, float out[4]) {
+        const float s = std::sin(angle / 2);
+        out[0] = x * s;
+        out[1] = y * s;
+        out[2] = z * s;
+        out[3] = std::cos(angle / 2);
+    }
+
+    // Normalized linear interpolation along the shortest arc, accurate enough between closely spaced samples.
+    Pose Interpolate(const Pose& a, const Pose& b, float t) {
+        Pose pose;
+        float dot = 0;
+        for (int i = 0; i < 4; i++) {
+            dot += a.orientation[i] * b.orientation[i];
+        }
+        const float sign = dot < 0 ? -1.f : 1.f;
+        float length = 0;
+        for (int i = 0; i < 4; i++) {
+            pose.orientation[i] = a.orientation[i] * (1 - t) + sign * b.orientation[i] * t;
+            length += pose.orientation[i] * pose.orientation[i];
+        }
+        length = std::sqrt(length);
+        for (int i = 0; i < 4; i++) {
+            pose.orientation[i] /= length;
+        }
+        for (int i = 0; i < 3; i++) {
+            pose.position[i] = a.position[i] * (1 - t) + b.position[i] * t;
+        }
+        return pose;
+    }
+
+    void ParseFloats(const cJSON* array, float* values, int count) {
+        if (!cJSON_IsArray(array)) {
+            return;
+        }
+        for (int i = 0; i < count && i < cJSON_GetArraySize(array); i++) {
+            const cJSON* item = cJSON_GetArrayItem(array, i);
+            if (cJSON_IsNumber(item)) {
+                values[i] = (float)item->valuedouble;
+            }
+        }
+    }
+
+    template <typename T>
+    void WriteArray(std::ostream& out, const T* values, int count) {
+        out << "[";
+        for (int i = 0; i < count; i++) {
+            out << (i ? ", " : "") << values[i];
+        }
+        out << "]";
+    }
+
+} // namespace
+
+namespace ovrnull::playback {
+
+    Timeline::Timeline(std::vector<Sample> samples, bool loop) : m_samples(std::move(samples)), m_loop(loop) {
+        std::stable_sort(m_samples.begin(), m_samples.end(), [](const Sample& a, const Sample& b) {
+            return a.time < b.time;
+        });
+    }
+
+    void Timeline::add(const Sample& sample) {
+        m_samples.push_back(sample);
+    }
+
+    double Timeline::wrap(double time) const {
+        const double duration = getDuration();
+        if (m_loop && duration > 0) {
+            time = std::fmod(time, duration);
+            return time < 0 ? time + duration : time;
+        }
+        return std::clamp(time, m_samples.front().time, duration);
+    }
+
+    size_t Timeline::findSegment(double time) const {
+        const auto it = std::upper_bound(
+            m_samples.cbegin(), m_samples.cend(), time, [](double t, const Sample& sample) { return t < sample.time; });
+        return it == m_samples.cbegin() ? 0 : (size_t)std::distance(m_samples.cbegin(), it) - 1;
+    }
+
+    Sample Timeline::getSample(double time) const {
+        if (m_samples.empty()) {
+            return {};
+        }
+
+        time = wrap(time);
+        const size_t index = findSegment(time);
+        Sample sample = m_samples[index];
+        if (index + 1 < m_samples.size()) {
+            const Sample& next = m_samples[index + 1];
+            const double span = next.time - sample.time;
+            const float t = span > 0 ? (float)std::clamp((time - sample.time) / span, 0.0, 1.0) : 0.f;
+            for (size_t i = 0; i < (size_t)Device::Count; i++) {
+                sample.poses[i] = Interpolate(m_samples[index].poses[i], next.poses[i], t);
+            }
+        }
+        sample.time = time;
+        return sample;
+    }
+
+    Motion Timeline::getMotion(Device device, double time) const {
+        Motion motion;
+        if (m_samples.empty()) {
+            return motion;
+        }
+
+        motion.pose = getSample(time).poses[(size_t)device];
+
+        const size_t index = findSegment(wrap(time));
+        if (index + 1 < m_samples.size()) {
+            const Pose& a = m_samples[index].poses[(size_t)device];
+            const Pose& b = m_samples[index + 1].poses[(size_t)device];
+            const float span = (float)(m_samples[index + 1].time - m_samples[index].time);
+            if (span > 0) {
+                for (int i = 0; i < 3; i++) {
+                    motion.linearVelocity[i] = (b.position[i] - a.position[i]) / span;
+                }
+
+                // Angular velocity (world frame) from the rotation delta b * a^-1.
+                const float inverse[4] = {-a.orientation[0], -a.orientation[1], -a.orientation[2], a.orientation[3]};
+                float delta[4];
+                Multiply(b.orientation, inverse, delta);
+                if (delta[3] < 0) {
+                    for (int i = 0; i < 4; i++) {
+                        delta[i] = -delta[i];
+                    }
+                }
+                const float sinHalfAngle = std::sqrt(delta[0] * delta[0] + delta[1] * delta[1] + delta[2] * delta[2]);
+                if (sinHalfAngle > FLT_EPSILON) {
+                    const float angle = 2 * std::atan2(sinHalfAngle, delta[3]);
+                    for (int i = 0; i < 3; i++) {
+                        motion.angularVelocity[i] = delta[i] / sinHalfAngle * angle / span;
+                    }
+                }
+            }
+        }
+        return motion;
+    }
+
+    std::optional<Timeline> LoadTimeline(const std::filesystem::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open()) {
+            return {};
+        }
+        if (path.extension() == ".json") {
+            std::ostringstream content;
+            content << in.rdbuf();
+            return ParseJson(content.str());
+        }
+        return ReadBinary(in);
+    }
+
+    bool SaveTimeline(const std::filesystem::path& path, const Timeline& timeline) {
+        std::ofstream out(path, std::ios::binary);
+        if (!out.is_open()) {
+            return false;
+        }
+        if (path.extension() == ".json") {
+            WriteJson(out, timeline);
+        } else {
+            WriteBinary(out, timeline);
+        }
+        return out.good();
+    }
+
+    std::optional<Timeline> ReadBinary(std::istream& in) {
+        BinaryHeader header{};
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            memcmp(header.magic, k_Magic, sizeof(k_Magic)) || header.version != k_Version ||
+            header.sampleSize != sizeof(Sample)) {
+            return {};
+        }
+
+        std::vector<Sample> samples(header.sampleCount);
+        if (!in.read(reinterpret_cast<char*>(samples.data()), samples.size() * sizeof(Sample))) {
+            return {};
+        }
+        return Timeline(std::move(samples), header.flags & k_FlagLoop);
+    }
+
+    void WriteBinary(std::ostream& out, const Timeline& timeline) {
+        BinaryHeader header{};
+        memcpy(header.magic, k_Magic, sizeof(k_Magic));
+        header.version = k_Version;
+        header.flags = timeline.isLooping() ? k_FlagLoop : 0;
+        header.sampleSize = sizeof(Sample);
+        header.sampleCount = timeline.getSamples().size();
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(timeline.getSamples().data()),
+                  timeline.getSamples().size() * sizeof(Sample));
+    }
+
+    std::optional<Timeline> ParseJson(const std::string& json) {
+        cJSON* root = cJSON_ParseWithLength(json.c_str(), json.size());
+        if (!root) {
+            return {};
+        }
+
+        std::vector<Sample> samples;
+        const cJSON* items = cJSON_GetObjectItemCaseSensitive(root, "samples");
+        const cJSON* item = nullptr;
+        cJSON_ArrayForEach(item, items) {
+            Sample sample;
+            if (const cJSON* time = cJSON_GetObjectItemCaseSensitive(item, "t"); cJSON_IsNumber(time)) {
+                sample.time = time->valuedouble;
+            }
+            for (size_t i = 0; i < (size_t)Device::Count; i++) {
+                // Orientation (x, y, z, w) followed by position.
+                float pose[7] = {0, 0, 0, 1, 0, 0, 0};
+                ParseFloats(cJSON_GetObjectItemCaseSensitive(item, k_DeviceNames[i]), pose, 7);
+                memcpy(sample.poses[i].orientation, pose, sizeof(sample.poses[i].orientation));
+                memcpy(sample.poses[i].position, pose + 4, sizeof(sample.poses[i].position));
+            }
+            if (const cJSON* controllers = cJSON_GetObjectItemCaseSensitive(item, "controllers");
+                cJSON_IsNumber(controllers)) {
+                sample.controllers = (uint32_t)controllers->valuedouble;
+            }
+            if (const cJSON* buttons = cJSON_GetObjectItemCaseSensitive(item, "buttons"); cJSON_IsNumber(buttons)) {
+                sample.buttons = (uint32_t)buttons->valuedouble;
+            }
+            if (const cJSON* touches = cJSON_GetObjectItemCaseSensitive(item, "touches"); cJSON_IsNumber(touches)) {
+                sample.touches = (uint32_t)touches->valuedouble;
+            }
+            ParseFloats(cJSON_GetObjectItemCaseSensitive(item, "trigger"), sample.indexTrigger, 2);
+            ParseFloats(cJSON_GetObjectItemCaseSensitive(item, "grip"), sample.handTrigger, 2);
+            ParseFloats(cJSON_GetObjectItemCaseSensitive(item, "thumbstick"), &sample.thumbstick[0][0], 4);
+            samples.push_back(sample);
+        }
+        const bool loop = cJSON_IsTrue(cJSON_GetObjectItemCaseSensitive(root, "loop"));
+
+        cJSON_Delete(root);
+
+        return Timeline(std::move(samples), loop);
+    }
+
+    void WriteJson(std::ostream& out, const Timeline& timeline) {
+        out << std::setprecision(9);
+        out << "{\n  \"loop\": " << (timeline.isLooping() ? "true" : "false") << ",\n  \"samples\": [";
+        bool first = true;
+        for (const auto& sample : timeline.getSamples()) {
+            out << (first ? "\n" : ",\n") << "    {\"t\": " << sample.time;
+            for (size_t i = 0; i < (size_t)Device::Count; i++) {
+                float pose[7];
+                memcpy(pose, sample.poses[i].orientation, sizeof(sample.poses[i].orientation));
+                memcpy(pose + 4, sample.poses[i].position, sizeof(sample.poses[i].position));
+                out << ", \"" << k_DeviceNames[i] << "\": ";
+                WriteArray(out, pose, 7);
+            }
+            out << ", \"controllers\": " << sample.controllers << ", \"buttons\": " << sample.buttons
+                << ", \"touches\": " << sample.touches << ", \"trigger\": ";
+            WriteArray(out, sample.indexTrigger, 2);
+            out << ", \"grip\": ";
+            WriteArray(out, sample.handTrigger, 2);
+            out << ", \"thumbstick\": ";
+            WriteArray(out, &sample.thumbstick[0][0], 4);
+            out << "}";
+            first = false;
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    Timeline GenerateProcedural(double duration, double sampleRate) {
+        constexpr float k_TwoPi = 2 * (float)M_PI;
+        const size_t count = (size_t)(duration * sampleRate) + 1;
+
+        std::vector<Sample> samples;
+        samples.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            Sample sample;
+            sample.time = i / sampleRate;
+            const float t = (float)sample.time;
+
+            // Look around slowly, with a bit of head bob.
+            float yaw[4], pitch[4];
+            FromAxisAngle(0, 1, 0, 0.6f * std::sin(k_TwoPi * t / 8), yaw);
+            FromAxisAngle(1, 0, 0, 0.2f * std::sin(k_TwoPi * t / 5), pitch);
+            Pose& hmd = sample.poses[(size_t)Device::Hmd];
+            Multiply(yaw, pitch, hmd.orientation);
+            hmd.position[0] = 0.05f * std::sin(k_TwoPi * t / 6);
+            hmd.position[1] = 0.02f * std::sin(k_TwoPi * t / 2);
+
+            // Figure-eights in front of the body, following the head yaw.
+            for (uint32_t side = 0; side < 2; side++) {
+                const float phase = k_TwoPi * t / 3 + side * (float)M_PI;
+                const float offset[3] = {(side ? 0.2f : -0.2f) + 0.15f * std::sin(phase),
+                                         -0.25f + 0.1f * std::sin(2 * phase),
+                                         -0.35f};
+                Pose& controller = sample.poses[(size_t)Device::LeftController + side];
+                float rotated[3];
+                Rotate(yaw, offset, rotated);
+                for (int j = 0; j < 3; j++) {
+                    controller.position[j] = hmd.position[j] + rotated[j];
+                }
+                float roll[4];
+                FromAxisAngle(0, 0, 1, 0.5f * std::sin(phase), roll);
+                Multiply(yaw, roll, controller.orientation);
+
+                sample.indexTrigger[side] = std::clamp(1.5f * std::sin(k_TwoPi * t / 2 + side), 0.f, 1.f);
+                sample.handTrigger[side] = std::fmod(t + side, 4.f) < 1.f ? 1.f : 0.f;
+                sample.thumbstick[side][0] = std::sin(k_TwoPi * t / 4);
+                sample.thumbstick[side][1] = std::cos(k_TwoPi * t / 4);
+            }
+            if (std::fmod(t, 2.f) < 0.25f) {
+                sample.buttons |= ovrButton_A;
+                sample.touches |= ovrTouch_A;
+            }
+            if (std::fmod(t + 1, 2.f) < 0.25f) {
+                sample.buttons |= ovrButton_X;
+                sample.touches |= ovrTouch_X;
+            }
+            for (uint32_t side = 0; side < 2; side++) {
+                if (sample.indexTrigger[side] > 0) {
+                    sample.touches |= side ? ovrTouch_RIndexTrigger : ovrTouch_LIndexTrigger;
+                }
+            }
+            samples.push_back(sample);
+        }
+
+        return Timeline(std::move(samples), true);
+    }
+
+} // namespace ovrnull::playback
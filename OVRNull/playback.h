@@ -0,0 +1,109 @@
+// MIT License
+//
+// Copyright(c) 2024-2026 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+namespace ovrnull::playback {
+
+    enum class Device : uint32_t { Hmd = 0, LeftController, RightController, Count };
+
+    struct Pose {
+        float orientation[4]{0, 0, 0, 1}; // x, y, z, w
+        float position[3]{};
+    };
+
+    // One point of a motion and input timeline. The layout is also the record layout of the binary file format.
+    struct Sample {
+        // Seconds since the start of the timeline.
+        double time{0};
+        Pose poses[(size_t)Device::Count]{};
+        // Bit mask of the connected controllers (1 << ovrHandType).
+        uint32_t controllers{0x3};
+        // ovrButton and ovrTouch bit masks.
+        uint32_t buttons{0};
+        uint32_t touches{0};
+        float indexTrigger[2]{};
+        float handTrigger[2]{};
+        float thumbstick[2][2]{};
+    };
+
+    struct Motion {
+        Pose pose;
+        float linearVelocity[3]{};
+        float angularVelocity[3]{};
+    };
+
+    class Timeline {
+      public:
+        Timeline() = default;
+        Timeline(std::vector<Sample> samples, bool loop);
+
+        bool empty() const {
+            return m_samples.empty();
+        }
+
+        bool isLooping() const {
+            return m_loop;
+        }
+
+        double getDuration() const {
+            return m_samples.empty() ? 0.0 : m_samples.back().time;
+        }
+
+        const std::vector<Sample>& getSamples() const {
+            return m_samples;
+        }
+
+        // Samples must be added in chronological order.
+        void add(const Sample& sample);
+
+        // Poses are interpolated between the surrounding samples, inputs are taken from the latest sample. Past the
+        // end, the timeline either wraps around or holds the last sample.
+        Sample getSample(double time) const;
+
+        // The pose along with the velocities of the segment containing the time.
+        Motion getMotion(Device device, double time) const;
+
+      private:
+        double wrap(double time) const;
+        size_t findSegment(double time) const;
+
+        std::vector<Sample> m_samples;
+        bool m_loop{false};
+    };
+
+    // Files ending in .json use the JSON format, anything else uses the binary format. Both formats have the same
+    // precision (double-precision timestamps).
+    std::optional<Timeline> LoadTimeline(const std::filesystem::path& path);
+    bool SaveTimeline(const std::filesystem::path& path, const Timeline& timeline);
+
+    std::optional<Timeline> ReadBinary(std::istream& in);
+    void WriteBinary(std::ostream& out, const Timeline& timeline);
+    std::optional<Timeline> ParseJson(const std::string& json);
+    void WriteJson(std::ostream& out, const Timeline& timeline);
+
+    // A looping timeline with the head looking around, the controllers tracing figure-eights, and periodic trigger,
+    // grip, button and thumbstick activity.
+    Timeline GenerateProcedural(double duration, double sampleRate);
+
+} // namespace ovrnull::playback
@@ -416,10 +416,6 @@ ovr_GetMirrorTextureBufferVk(ovrSession session, ovrMirrorTexture mirrorTexture,
     return ovrError_Unsupported;
 }
 
-OVR_PUBLIC_FUNCTION(ovrResult) ovr_ResetPerfStats(ovrSession session) {
-    return ovrSuccess;
-}
-
 OVR_PUBLIC_FUNCTION(void)
 ovr_ReportClientInfo(unsigned int compilerVersion,
                      int productVersion,
@@ -40,6 +40,15 @@ namespace ovrnull::utils {
         return qpcTime;
     }
 
+    static inline std::optional<std::string> GetEnvironmentString(const char* name) {
+        char value[MAX_PATH]{};
+        const DWORD length = GetEnvironmentVariableA(name, value, (DWORD)std::size(value));
+        if (!length || length >= std::size(value)) {
+            return {};
+        }
+        return std::string(value, length);
+    }
+
     static inline DirectX::XMMATRIX LoadOvrPose(const ovrPosef& pose) {
         const DirectX::XMVECTOR orientation = DirectX::XMLoadFloat4((DirectX::XMFLOAT4*)&pose.Orientation);
         const DirectX::XMVECTOR position = DirectX::XMLoadFloat3((DirectX::XMFLOAT3*)&pose.Position);
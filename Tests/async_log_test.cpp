@@ -0,0 +1,116 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <framework/async_log.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::log;
+
+    // Collects the batches handed over by the writer thread.
+    struct Sink {
+        std::string contents() {
+            std::unique_lock lock(mutex);
+            return text;
+        }
+
+        std::mutex mutex;
+        std::string text;
+    };
+
+    AsyncLogger MakeLogger(Sink& sink) {
+        return AsyncLogger([&sink](const std::string& batch) {
+            std::unique_lock lock(sink.mutex);
+            sink.text += batch;
+        });
+    }
+
+    TEST(AsyncLogger, SynchronousUntilStarted) {
+        Sink sink;
+        AsyncLogger logger = MakeLogger(sink);
+        EXPECT_FALSE(logger.isRunning());
+        EXPECT_FALSE(logger.log("Hello %d\n", 1));
+
+        // Nothing to wait for.
+        logger.flush();
+        EXPECT_TRUE(sink.contents().empty());
+    }
+
+    TEST(AsyncLogger, FlushWritesPendingMessages) {
+        Sink sink;
+        AsyncLogger logger = MakeLogger(sink);
+        logger.start();
+        EXPECT_TRUE(logger.isRunning());
+
+        EXPECT_TRUE(logger.log("Hello %d %s\n", 42, "world"));
+        logger.flush();
+        const std::string text = sink.contents();
+        EXPECT_NE(text.find("Hello 42 world\n"), std::string::npos);
+
+        // The messages are prefixed like the synchronous ones.
+        EXPECT_NE(text.find(": Hello"), std::string::npos);
+
+        logger.stop();
+        EXPECT_FALSE(logger.isRunning());
+        EXPECT_FALSE(logger.log("After\n"));
+    }
+
+    TEST(AsyncLogger, StopWritesPendingMessages) {
+        Sink sink;
+        AsyncLogger logger = MakeLogger(sink);
+        logger.start();
+        logger.log("Before stop\n");
+        logger.stop();
+        EXPECT_NE(sink.contents().find("Before stop\n"), std::string::npos);
+
+        // Flushing a stopped logger returns immediately.
+        logger.flush();
+    }
+
+    TEST(AsyncLogger, FlushWhileStopping) {
+        Sink sink;
+        AsyncLogger logger = MakeLogger(sink);
+        for (int i = 0; i < 50; i++) {
+            logger.start();
+            std::thread flusher([&] {
+                logger.log("Message %d\n", i);
+                logger.flush();
+            });
+            logger.stop();
+
+            // Must not wait forever for a flush that the stopped writer never completes.
+            flusher.join();
+        }
+    }
+
+    TEST(AsyncLogger, FormatConversions) {
+        Sink sink;
+        AsyncLogger logger = MakeLogger(sink);
+        logger.start();
+        logger.log("%5.2f|%-3d|%.3s|%llu|%%|%*d|%s\n", 3.14159, 7, "abcdef", 1234567890123ull, 4, 9, nullptr);
+        logger.flush();
+        EXPECT_NE(sink.contents().find(" 3.14|7  |abc|1234567890123|%|   9|(null)\n"), std::string::npos);
+    }
+
+} // namespace
@@ -0,0 +1,208 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <BodyState.h>
+#include <body_state_source.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::BodyTracking;
+
+    std::unique_ptr<BodyStateV2> MakeState(double time, uint32_t parts) {
+        auto state = std::make_unique<BodyStateV2>();
+        std::memset(state.get(), 0, sizeof(BodyStateV2));
+        Synthesize(time, parts, *state);
+        return state;
+    }
+
+    float Length(const Quaternion& q) {
+        return std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    }
+
+    float Distance(const Vector3& a, const Vector3& b) {
+        return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) + (a.z - b.z) * (a.z - b.z));
+    }
+
+    void ExpectSamePose(const Pose& a, const Pose& b) {
+        EXPECT_FLOAT_EQ(a.orientation.x, b.orientation.x);
+        EXPECT_FLOAT_EQ(a.orientation.y, b.orientation.y);
+        EXPECT_FLOAT_EQ(a.orientation.z, b.orientation.z);
+        EXPECT_FLOAT_EQ(a.orientation.w, b.orientation.w);
+        EXPECT_FLOAT_EQ(a.position.x, b.position.x);
+        EXPECT_FLOAT_EQ(a.position.y, b.position.y);
+        EXPECT_FLOAT_EQ(a.position.z, b.position.z);
+    }
+
+    TEST(Synthesize, OnlyDependsOnTime) {
+        const auto first = MakeState(12.345, SyntheticAll);
+        const auto second = MakeState(12.345, SyntheticAll);
+        EXPECT_EQ(std::memcmp(first.get(), second.get(), sizeof(BodyStateV2)), 0);
+
+        const auto later = MakeState(12.5, SyntheticAll);
+        EXPECT_NE(std::memcmp(first.get(), later.get(), sizeof(BodyStateV2)), 0);
+    }
+
+    TEST(Synthesize, OnlyFillsTheRequestedParts) {
+        const auto eyes = MakeState(1.0, SyntheticEyes);
+        EXPECT_TRUE(eyes->LeftEyeIsValid);
+        EXPECT_TRUE(eyes->RightEyeIsValid);
+        EXPECT_FALSE(eyes->FaceIsValid);
+        EXPECT_FALSE(eyes->LeftHandActive);
+        EXPECT_FALSE(eyes->BodyTrackingCalibrated);
+
+        const auto hands = MakeState(1.0, SyntheticHands);
+        EXPECT_TRUE(hands->LeftHandActive);
+        EXPECT_TRUE(hands->RightHandActive);
+        EXPECT_FALSE(hands->BodyTrackingCalibrated);
+        EXPECT_FALSE(hands->SkeletonChangedCount);
+        EXPECT_FALSE(hands->LeftEyeIsValid);
+
+        const auto body = MakeState(1.0, SyntheticBody);
+        EXPECT_TRUE(body->BodyTrackingCalibrated);
+        EXPECT_FALSE(body->LeftHandActive);
+        EXPECT_EQ(body->SkeletonChangedCount, 1);
+    }
+
+    TEST(Synthesize, OrientationsAreNormalized) {
+        for (const double time : {0.0, 0.7, 3.3, 100.1}) {
+            const auto state = MakeState(time, SyntheticAll);
+            for (uint32_t i = 0; i < HandJointCount; i++) {
+                EXPECT_NEAR(Length(state->LeftHandJointStates[i].Pose.orientation), 1.f, 1e-4f);
+                EXPECT_NEAR(Length(state->RightHandJointStates[i].Pose.orientation), 1.f, 1e-4f);
+            }
+            for (uint32_t i = 0; i < FullBodyJointCount; i++) {
+                EXPECT_NEAR(Length(state->BodyJoints[i].Pose.orientation), 1.f, 1e-4f);
+            }
+            EXPECT_NEAR(Length(state->LeftEyePose.orientation), 1.f, 1e-4f);
+        }
+    }
+
+    TEST(Synthesize, HandsAreRigid) {
+        // The fingers curl, but the bones keep their length.
+        const auto open = MakeState(0.0, SyntheticHands);
+        const auto curled = MakeState(0.9, SyntheticHands);
+        for (int32_t joint = XR_HAND_JOINT_INDEX_PROXIMAL_EXT; joint <= XR_HAND_JOINT_INDEX_TIP_EXT; joint++) {
+            EXPECT_NEAR(Distance(open->LeftHandJointStates[joint].Pose.position,
+                                 open->LeftHandJointStates[joint - 1].Pose.position),
+                        Distance(curled->LeftHandJointStates[joint].Pose.position,
+                                 curled->LeftHandJointStates[joint - 1].Pose.position),
+                        1e-4f);
+        }
+        EXPECT_GT(Distance(open->LeftHandJointStates[XR_HAND_JOINT_INDEX_TIP_EXT].Pose.position,
+                           curled->LeftHandJointStates[XR_HAND_JOINT_INDEX_TIP_EXT].Pose.position),
+                  1e-3f);
+
+        // The hands are mirrored on each side of the body.
+        const auto& left = open->LeftHandJointStates[XR_HAND_JOINT_WRIST_EXT].Pose.position;
+        const auto& right = open->RightHandJointStates[XR_HAND_JOINT_WRIST_EXT].Pose.position;
+        EXPECT_LT(left.x, 0.f);
+        EXPECT_GT(right.x, 0.f);
+    }
+
+    TEST(Synthesize, BodyAndHandsAgree) {
+        const auto state = MakeState(2.2, SyntheticAll);
+        for (uint32_t i = 0; i < HandJointCount; i++) {
+            ExpectSamePose(state->BodyJoints[XR_FULL_BODY_JOINT_LEFT_HAND_PALM_META + i].Pose,
+                           state->LeftHandJointStates[i].Pose);
+            ExpectSamePose(state->BodyJoints[XR_FULL_BODY_JOINT_RIGHT_HAND_PALM_META + i].Pose,
+                           state->RightHandJointStates[i].Pose);
+        }
+        for (uint32_t i = 0; i < FullBodyJointCount; i++) {
+            EXPECT_EQ(state->BodyJoints[i].LocationFlags,
+                      XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT |
+                          XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT);
+        }
+    }
+
+    TEST(Synthesize, SkeletonIsAHierarchy) {
+        const auto state = MakeState(0.0, SyntheticBody);
+        for (int32_t i = 0; i < FullBodyJointCount; i++) {
+            const SkeletonJoint& joint = state->SkeletonJoints[i];
+            EXPECT_EQ(joint.Joint, i);
+            if (i == XR_FULL_BODY_JOINT_ROOT_META) {
+                EXPECT_EQ(joint.ParentJoint, XR_FULL_BODY_JOINT_NONE_META);
+                continue;
+            }
+            ASSERT_GE(joint.ParentJoint, 0);
+            ASSERT_LT(joint.ParentJoint, FullBodyJointCount);
+
+            // Walking up the parents reaches the root.
+            int32_t current = i;
+            for (int32_t depth = 0; depth < FullBodyJointCount && current != XR_FULL_BODY_JOINT_ROOT_META; depth++) {
+                current = state->SkeletonJoints[current].ParentJoint;
+            }
+            EXPECT_EQ(current, XR_FULL_BODY_JOINT_ROOT_META);
+        }
+        EXPECT_EQ(state->SkeletonJoints[XR_FULL_BODY_JOINT_LEFT_HAND_INDEX_TIP_META].ParentJoint,
+                  XR_FULL_BODY_JOINT_LEFT_HAND_INDEX_DISTAL_META);
+    }
+
+    TEST(Synthesize, SkeletonIsOnlyFilledOnce) {
+        auto state = std::make_unique<BodyStateV2>();
+        std::memset(state.get(), 0, sizeof(BodyStateV2));
+        state->SkeletonChangedCount = 5;
+        Synthesize(1.0, SyntheticBody, *state);
+        EXPECT_EQ(state->SkeletonChangedCount, 5);
+        EXPECT_EQ(state->SkeletonJoints[XR_FULL_BODY_JOINT_HEAD_META].ParentJoint, 0);
+        EXPECT_TRUE(state->BodyTrackingCalibrated);
+    }
+
+    TEST(Synthesize, PinchesAlternateBetweenHands) {
+        const auto start = MakeState(0.0, SyntheticHands);
+        EXPECT_FALSE(start->LeftAimState.AimStatus & XR_HAND_TRACKING_AIM_INDEX_PINCHING_BIT_FB);
+        EXPECT_TRUE(start->RightAimState.AimStatus & XR_HAND_TRACKING_AIM_INDEX_PINCHING_BIT_FB);
+        EXPECT_TRUE(start->LeftAimState.AimStatus & XR_HAND_TRACKING_AIM_VALID_BIT_FB);
+        EXPECT_EQ(start->LeftAimState.PinchStrengthIndex, 0.f);
+
+        const auto half = MakeState(2.0, SyntheticHands);
+        EXPECT_TRUE(half->LeftAimState.AimStatus & XR_HAND_TRACKING_AIM_INDEX_PINCHING_BIT_FB);
+        EXPECT_FALSE(half->RightAimState.AimStatus & XR_HAND_TRACKING_AIM_INDEX_PINCHING_BIT_FB);
+        EXPECT_NEAR(half->LeftAimState.PinchStrengthIndex, 1.f, 1e-5f);
+    }
+
+    TEST(Synthesize, EyesFixateBetweenSaccades) {
+        const auto a = MakeState(0.41, SyntheticEyes);
+        const auto b = MakeState(0.79, SyntheticEyes);
+        const auto c = MakeState(0.81, SyntheticEyes);
+        ExpectSamePose(a->LeftEyePose, b->LeftEyePose);
+        EXPECT_NE(std::memcmp(&b->LeftEyePose, &c->LeftEyePose, sizeof(Pose)), 0);
+        EXPECT_LT(a->LeftEyePose.position.x, a->RightEyePose.position.x);
+    }
+
+    TEST(Synthesize, FaceBlinks) {
+        const auto blink = MakeState(4.05, SyntheticFace);
+        EXPECT_EQ(blink->ExpressionWeights[XR_FACE_EXPRESSION2_EYES_CLOSED_L_FB], 1.f);
+        EXPECT_EQ(blink->ExpressionWeights[XR_FACE_EXPRESSION2_EYES_CLOSED_R_FB], 1.f);
+
+        const auto open = MakeState(5.0, SyntheticFace);
+        EXPECT_EQ(open->ExpressionWeights[XR_FACE_EXPRESSION2_EYES_CLOSED_L_FB], 0.f);
+        for (uint32_t i = 0; i < ExpressionCount; i++) {
+            EXPECT_GE(open->ExpressionWeights[i], 0.f);
+            EXPECT_LE(open->ExpressionWeights[i], 1.f);
+        }
+        EXPECT_TRUE(open->FaceIsValid);
+        EXPECT_EQ(open->ExpressionConfidences[0], 1.f);
+    }
+
+} // namespace
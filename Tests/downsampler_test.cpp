@@ -0,0 +1,203 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <downsampler.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::downsampling;
+
+    constexpr float Pi = 3.14159265f;
+
+    std::vector<float> Downsample(Filter filter,
+                                  const std::vector<float>& source,
+                                  uint32_t sourceWidth,
+                                  uint32_t sourceHeight,
+                                  uint32_t destWidth,
+                                  uint32_t destHeight) {
+        std::vector<float> dest(destWidth * destHeight);
+        virtualdesktop_openxr::downsampling::Downsample(
+            filter, source.data(), sourceWidth, sourceHeight, dest.data(), destWidth, destHeight);
+        return dest;
+    }
+
+    // A horizontal sine wave with values in [0, 1], evaluated at pixel centers of an image covering [0, 1].
+    std::vector<float> MakeSine(uint32_t width, uint32_t height, float cycles) {
+        std::vector<float> image(width * height);
+        for (uint32_t y = 0; y < height; y++) {
+            for (uint32_t x = 0; x < width; x++) {
+                image[y * width + x] = 0.5f + 0.5f * std::sin(2 * Pi * cycles * (x + 0.5f) / width);
+            }
+        }
+        return image;
+    }
+
+    // Root mean square error, ignoring the columns near the edges where the kernels are truncated.
+    float ComputeError(const std::vector<float>& a, const std::vector<float>& b, uint32_t width, uint32_t margin) {
+        double total = 0;
+        uint32_t count = 0;
+        for (size_t i = 0; i < a.size(); i++) {
+            const uint32_t x = (uint32_t)(i % width);
+            if (x < margin || x >= width - margin) {
+                continue;
+            }
+            total += (double)(a[i] - b[i]) * (a[i] - b[i]);
+            count++;
+        }
+        return (float)std::sqrt(total / count);
+    }
+
+    TEST(Downsampler, KernelsAreNormalizedAtTheCenter) {
+        EXPECT_EQ(EvaluateKernel(Filter::Box, 0.f), 1.f);
+        EXPECT_EQ(EvaluateKernel(Filter::Box, 0.49f), 1.f);
+        EXPECT_EQ(EvaluateKernel(Filter::Box, -0.5f), 0.f);
+
+        EXPECT_EQ(EvaluateKernel(Filter::Lanczos, 0.f), 1.f);
+        EXPECT_NEAR(EvaluateKernel(Filter::Lanczos, 1.f), 0.f, 1e-6f);
+        EXPECT_EQ(EvaluateKernel(Filter::Lanczos, 2.f), 0.f);
+        EXPECT_EQ(EvaluateKernel(Filter::Lanczos, 0.7f), EvaluateKernel(Filter::Lanczos, -0.7f));
+        // The negative lobe.
+        EXPECT_LT(EvaluateKernel(Filter::Lanczos, 1.5f), 0.f);
+        EXPECT_STREQ(ToString(Filter::Lanczos), "Lanczos");
+    }
+
+    TEST(Downsampler, BoxTapsAverageTheCoveredPixels) {
+        for (uint32_t i = 0; i < 4; i++) {
+            const auto taps = ComputeTaps(Filter::Box, i, 2.f, 8);
+            ASSERT_EQ(taps.size(), 2u);
+            EXPECT_EQ(taps[0].index, (int32_t)i * 2);
+            EXPECT_EQ(taps[1].index, (int32_t)i * 2 + 1);
+            EXPECT_FLOAT_EQ(taps[0].weight, 0.5f);
+            EXPECT_FLOAT_EQ(taps[1].weight, 0.5f);
+        }
+    }
+
+    TEST(Downsampler, TapsAreNormalizedAndBounded) {
+        for (const Filter filter : {Filter::Box, Filter::Lanczos}) {
+            for (const float scale : {0.75f, 1.f, 1.5f, 2.f, 3.3f, 10.f}) {
+                const int32_t sourceSize = 100;
+                const uint32_t destSize = (uint32_t)(sourceSize / scale);
+                for (uint32_t i = 0; i < destSize; i++) {
+                    const auto taps = ComputeTaps(filter, i, scale, sourceSize);
+                    ASSERT_FALSE(taps.empty());
+                    float total = 0;
+                    for (const auto& tap : taps) {
+                        EXPECT_GE(tap.index, 0);
+                        EXPECT_LT(tap.index, sourceSize);
+                        total += tap.weight;
+                    }
+                    EXPECT_NEAR(total, 1.f, 1e-5f);
+                    EXPECT_LE(taps.back().index - taps.front().index, 2 * (int32_t)MaxRadius);
+                }
+            }
+        }
+    }
+
+    TEST(Downsampler, PreservesConstantImages) {
+        const std::vector<float> source(96 * 64, 0.3f);
+        for (const Filter filter : {Filter::Box, Filter::Lanczos}) {
+            for (const float value : Downsample(filter, source, 96, 64, 48, 32)) {
+                EXPECT_NEAR(value, 0.3f, 1e-5f);
+            }
+            for (const float value : Downsample(filter, source, 96, 64, 64, 40)) {
+                EXPECT_NEAR(value, 0.3f, 1e-5f);
+            }
+        }
+    }
+
+    TEST(Downsampler, BoxMatchesTheAverageOfEachBlock) {
+        constexpr uint32_t Width = 8;
+        constexpr uint32_t Height = 6;
+        std::vector<float> source(Width * Height);
+        for (size_t i = 0; i < source.size(); i++) {
+            source[i] = (float)((i * 37) % 11);
+        }
+        const auto dest = Downsample(Filter::Box, source, Width, Height, Width / 2, Height / 2);
+        for (uint32_t y = 0; y < Height / 2; y++) {
+            for (uint32_t x = 0; x < Width / 2; x++) {
+                const float expected = (source[(2 * y) * Width + 2 * x] + source[(2 * y) * Width + 2 * x + 1] +
+                                        source[(2 * y + 1) * Width + 2 * x] + source[(2 * y + 1) * Width + 2 * x + 1]) /
+                                       4.f;
+                EXPECT_NEAR(dest[y * (Width / 2) + x], expected, 1e-5f);
+            }
+        }
+    }
+
+    TEST(Downsampler, InterleavedChannelsAreIndependent) {
+        constexpr uint32_t Width = 16;
+        std::vector<float> source(Width * Width * 2);
+        for (size_t i = 0; i < source.size(); i += 2) {
+            source[i] = 1.f;
+            source[i + 1] = 0.25f;
+        }
+        std::vector<float> dest(8 * 8 * 2);
+        virtualdesktop_openxr::downsampling::Downsample(
+            Filter::Lanczos, source.data(), Width, Width, dest.data(), 8, 8, 2);
+        for (size_t i = 0; i < dest.size(); i += 2) {
+            EXPECT_NEAR(dest[i], 1.f, 1e-5f);
+            EXPECT_NEAR(dest[i + 1], 0.25f, 1e-5f);
+        }
+    }
+
+    // Lanczos keeps the detail that fits in the destination better than the box filter, and both remove the detail
+    // that does not (instead of aliasing it).
+    TEST(Downsampler, LanczosPreservesDetailBetterThanBox) {
+        constexpr uint32_t SourceWidth = 256;
+        constexpr uint32_t DestWidth = 128;
+        constexpr uint32_t Height = 4;
+        constexpr uint32_t Margin = 4;
+
+        // 16 cycles is well below the Nyquist frequency of the destination (64 cycles).
+        const auto source = MakeSine(SourceWidth, Height, 16);
+        const auto ideal = MakeSine(DestWidth, Height, 16);
+        const float boxError = ComputeError(
+            Downsample(Filter::Box, source, SourceWidth, Height, DestWidth, Height), ideal, DestWidth, Margin);
+        const float lanczosError = ComputeError(
+            Downsample(Filter::Lanczos, source, SourceWidth, Height, DestWidth, Height), ideal, DestWidth, Margin);
+        EXPECT_LT(lanczosError, boxError);
+        EXPECT_LT(lanczosError, 0.01f);
+
+        // 120 cycles is above the Nyquist frequency of the destination: the result should be close to flat gray.
+        const auto fine = MakeSine(SourceWidth, Height, 120);
+        const std::vector<float> gray(DestWidth * Height, 0.5f);
+        const float lanczosAliasing = ComputeError(
+            Downsample(Filter::Lanczos, fine, SourceWidth, Height, DestWidth, Height), gray, DestWidth, Margin);
+        EXPECT_LT(lanczosAliasing, 0.1f);
+    }
+
+    TEST(Downsampler, NeverUndershoots) {
+        // A sharp edge makes the negative lobes of Lanczos ring.
+        constexpr uint32_t Width = 64;
+        std::vector<float> source(Width * 2);
+        for (uint32_t y = 0; y < 2; y++) {
+            for (uint32_t x = 0; x < Width; x++) {
+                source[y * Width + x] = x < Width / 2 + 3 ? 0.f : 1.f;
+            }
+        }
+        for (const float value : Downsample(Filter::Lanczos, source, Width, 2, 24, 1)) {
+            EXPECT_GE(value, 0.f);
+        }
+    }
+
+} // namespace
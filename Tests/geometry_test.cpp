@@ -0,0 +1,283 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <geometry.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::utils;
+
+    // The tangents of the FOV, like ovrFovPort.
+    struct FovPort {
+        float UpTan;
+        float DownTan;
+        float LeftTan;
+        float RightTan;
+    };
+
+    constexpr FovPort SymmetricFov{1.f, 1.f, 1.f, 1.f};
+
+    // A hidden area mesh made of an axis-aligned rectangle in the tangent space of the eye, split into two triangles.
+    struct Mesh {
+        std::vector<XrVector2f> vertices;
+        std::vector<uint32_t> indices;
+
+        void addRect(float left, float bottom, float right, float top) {
+            const uint32_t base = (uint32_t)vertices.size();
+            vertices.push_back({left, bottom});
+            vertices.push_back({right, bottom});
+            vertices.push_back({right, top});
+            vertices.push_back({left, top});
+            indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+        }
+    };
+
+    bool IsVisible(const std::vector<uint8_t>& tiles, uint32_t tilesX, uint32_t x, uint32_t y) {
+        return tiles[y * tilesX + x];
+    }
+
+    TEST(ComputeVisibleTiles, NoHiddenArea) {
+        uint32_t hiddenTiles = ~0u;
+        const auto tiles = computeVisibleTiles({}, {}, SymmetricFov, 64, 64, 8, &hiddenTiles);
+        ASSERT_EQ(tiles.size(), 64u);
+        EXPECT_EQ(std::count(tiles.cbegin(), tiles.cend(), 1), 64);
+        EXPECT_EQ(hiddenTiles, 0u);
+    }
+
+    TEST(ComputeVisibleTiles, FullyHidden) {
+        // The diagonal shared by both triangles must not leave a crack of visible pixels.
+        Mesh mesh;
+        mesh.addRect(-1.f, -1.f, 1.f, 1.f);
+
+        uint32_t hiddenTiles = 0;
+        const auto tiles = computeVisibleTiles(mesh.vertices, mesh.indices, SymmetricFov, 64, 64, 8, &hiddenTiles);
+        EXPECT_EQ(std::count(tiles.cbegin(), tiles.cend(), 1), 0);
+        EXPECT_EQ(hiddenTiles, 64u);
+    }
+
+    TEST(ComputeVisibleTiles, KeepsOneTileAroundTheVisibleArea) {
+        // Hide the left half of the image.
+        Mesh mesh;
+        mesh.addRect(-1.5f, -1.5f, 0.f, 1.5f);
+
+        uint32_t hiddenTiles = 0;
+        const auto tiles = computeVisibleTiles(mesh.vertices, mesh.indices, SymmetricFov, 64, 64, 8, &hiddenTiles);
+        for (uint32_t y = 0; y < 8; y++) {
+            for (uint32_t x = 0; x < 8; x++) {
+                // Columns 0-3 are hidden, but column 3 neighbors the visible area.
+                EXPECT_EQ(IsVisible(tiles, 8, x, y), x >= 3) << x << "," << y;
+            }
+        }
+        EXPECT_EQ(hiddenTiles, 3u * 8);
+    }
+
+    TEST(ComputeVisibleTiles, PartialTiles) {
+        // 70 pixels make 9 tiles, the last one being partial. Pixels 0-34 are hidden, so tile 4 (pixels 32-39) has
+        // visible pixels.
+        Mesh mesh;
+        mesh.addRect(-1.5f, -1.5f, 0.f, 1.5f);
+
+        uint32_t hiddenTiles = 0;
+        const auto tiles = computeVisibleTiles(mesh.vertices, mesh.indices, SymmetricFov, 70, 70, 8, &hiddenTiles);
+        ASSERT_EQ(tiles.size(), 81u);
+        for (uint32_t x = 0; x < 9; x++) {
+            EXPECT_EQ(IsVisible(tiles, 9, x, 0), x >= 3) << x;
+        }
+        EXPECT_EQ(hiddenTiles, 3u * 9);
+    }
+
+    TEST(ComputeVisibleTiles, AsymmetricFov) {
+        // With an asymmetric FOV, the center of the tangent space is at one quarter of the image.
+        constexpr FovPort fov{1.f, 1.f, 0.5f, 1.5f};
+        Mesh mesh;
+        mesh.addRect(-1.f, -1.5f, 0.f, 1.5f);
+
+        uint32_t hiddenTiles = 0;
+        const auto tiles = computeVisibleTiles(mesh.vertices, mesh.indices, fov, 64, 64, 8, &hiddenTiles);
+        for (uint32_t x = 0; x < 8; x++) {
+            EXPECT_EQ(IsVisible(tiles, 8, x, 4), x >= 1) << x;
+        }
+        EXPECT_EQ(hiddenTiles, 8u);
+    }
+
+    TEST(ComputeVisibleTiles, UpIsTheTopOfTheImage) {
+        Mesh mesh;
+        mesh.addRect(-1.5f, 0.f, 1.5f, 1.5f);
+
+        const auto tiles = computeVisibleTiles(mesh.vertices, mesh.indices, SymmetricFov, 64, 64, 8);
+        for (uint32_t y = 0; y < 8; y++) {
+            EXPECT_EQ(IsVisible(tiles, 8, 4, y), y >= 3) << y;
+        }
+    }
+
+    TEST(ComputeVisibleTiles, CornerTriangles) {
+        // A typical lens mask: one triangle in each corner of the image.
+        Mesh mesh;
+        mesh.vertices = {{-1, 1}, {0, 1}, {-1, 0}, {1, 1}, {1, 0}, {0, 1}, {-1, -1}, {-1, 0}, {0, -1}, {1, -1}, {0, -1},
+                         {1, 0}};
+        mesh.indices = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+        uint32_t hiddenTiles = 0;
+        const auto tiles = computeVisibleTiles(mesh.vertices, mesh.indices, SymmetricFov, 128, 128, 8, &hiddenTiles);
+
+        // The corner tiles are hidden, the center is visible, and the result is symmetric.
+        EXPECT_FALSE(IsVisible(tiles, 16, 0, 0));
+        EXPECT_FALSE(IsVisible(tiles, 16, 15, 0));
+        EXPECT_FALSE(IsVisible(tiles, 16, 0, 15));
+        EXPECT_FALSE(IsVisible(tiles, 16, 15, 15));
+        EXPECT_TRUE(IsVisible(tiles, 16, 8, 8));
+        for (uint32_t y = 0; y < 16; y++) {
+            for (uint32_t x = 0; x < 16; x++) {
+                EXPECT_EQ(IsVisible(tiles, 16, x, y), IsVisible(tiles, 16, 15 - x, y)) << x << "," << y;
+                EXPECT_EQ(IsVisible(tiles, 16, x, y), IsVisible(tiles, 16, x, 15 - y)) << x << "," << y;
+            }
+        }
+        EXPECT_GT(hiddenTiles, 0u);
+        EXPECT_EQ(hiddenTiles, (uint32_t)std::count(tiles.cbegin(), tiles.cend(), 0));
+    }
+
+    // A typical asymmetric FOV of a left eye.
+    constexpr XrFovf FullFov{-0.95f, 0.75f, 0.85f, -0.9f};
+
+    void ExpectFovWithin(const XrFovf& fov, const XrFovf& outer) {
+        EXPECT_GE(fov.angleLeft, outer.angleLeft - 1e-6f);
+        EXPECT_LE(fov.angleRight, outer.angleRight + 1e-6f);
+        EXPECT_LE(fov.angleUp, outer.angleUp + 1e-6f);
+        EXPECT_GE(fov.angleDown, outer.angleDown - 1e-6f);
+        EXPECT_LT(fov.angleLeft, fov.angleRight);
+        EXPECT_LT(fov.angleDown, fov.angleUp);
+    }
+
+    TEST(ComputeFocusFov, CenteredWithoutGaze) {
+        const XrFovf focus = computeFocusFov(FullFov, 0.4f, 0.5f);
+        ExpectFovWithin(focus, FullFov);
+
+        // Centered straight ahead, and sized as a fraction of the tangent span.
+        EXPECT_NEAR(std::tan(focus.angleLeft), -std::tan(focus.angleRight), 1e-5f);
+        EXPECT_NEAR(std::tan(focus.angleUp), -std::tan(focus.angleDown), 1e-5f);
+        EXPECT_NEAR(std::tan(focus.angleRight) - std::tan(focus.angleLeft),
+                    0.4f * (std::tan(FullFov.angleRight) - std::tan(FullFov.angleLeft)),
+                    1e-5f);
+        EXPECT_NEAR(std::tan(focus.angleUp) - std::tan(focus.angleDown),
+                    0.5f * (std::tan(FullFov.angleUp) - std::tan(FullFov.angleDown)),
+                    1e-5f);
+    }
+
+    TEST(ComputeFocusFov, FollowsTheGaze) {
+        // Looking slightly left and up.
+        XrVector3f gaze{-0.2f, 0.1f, -1.f};
+        const float length = std::sqrt(gaze.x * gaze.x + gaze.y * gaze.y + gaze.z * gaze.z);
+        gaze = {gaze.x / length, gaze.y / length, gaze.z / length};
+
+        const XrFovf focus = computeFocusFov(FullFov, 0.3f, 0.3f, gaze);
+        ExpectFovWithin(focus, FullFov);
+        EXPECT_NEAR((std::tan(focus.angleLeft) + std::tan(focus.angleRight)) / 2, -0.2f, 1e-5f);
+        EXPECT_NEAR((std::tan(focus.angleDown) + std::tan(focus.angleUp)) / 2, 0.1f, 1e-5f);
+    }
+
+    TEST(ComputeFocusFov, StaysWithinTheFullFov) {
+        // Looking far to the right, past the edge of the display.
+        const XrFovf focus = computeFocusFov(FullFov, 0.4f, 0.4f, XrVector3f{0.9f, -0.3f, -0.3f});
+        ExpectFovWithin(focus, FullFov);
+        EXPECT_NEAR(focus.angleRight, FullFov.angleRight, 1e-5f);
+
+        // A gaze pointing backward is ignored.
+        const XrFovf backward = computeFocusFov(FullFov, 0.4f, 0.4f, XrVector3f{0.f, 0.f, 1.f});
+        const XrFovf centered = computeFocusFov(FullFov, 0.4f, 0.4f);
+        EXPECT_FLOAT_EQ(backward.angleLeft, centered.angleLeft);
+        EXPECT_FLOAT_EQ(backward.angleUp, centered.angleUp);
+
+        // Sizes are clamped to the full FOV.
+        const XrFovf full = computeFocusFov(FullFov, 2.f, 2.f, XrVector3f{0.5f, 0.f, -0.5f});
+        EXPECT_NEAR(full.angleLeft, FullFov.angleLeft, 1e-5f);
+        EXPECT_NEAR(full.angleRight, FullFov.angleRight, 1e-5f);
+        EXPECT_NEAR(full.angleUp, FullFov.angleUp, 1e-5f);
+        EXPECT_NEAR(full.angleDown, FullFov.angleDown, 1e-5f);
+    }
+
+    TEST(ComputeFocusRect, MapsTheFocusViewIntoTheFullView) {
+        const XrRect2Df whole = computeFocusRect(FullFov, FullFov);
+        EXPECT_NEAR(whole.offset.x, 0.f, 1e-6f);
+        EXPECT_NEAR(whole.offset.y, 0.f, 1e-6f);
+        EXPECT_NEAR(whole.extent.width, 1.f, 1e-6f);
+        EXPECT_NEAR(whole.extent.height, 1.f, 1e-6f);
+
+        const XrFovf focus = computeFocusFov(FullFov, 0.4f, 0.5f, XrVector3f{-0.1f, 0.2f, -0.97f});
+        const XrRect2Df rect = computeFocusRect(FullFov, focus);
+        EXPECT_NEAR(rect.extent.width, 0.4f, 1e-5f);
+        EXPECT_NEAR(rect.extent.height, 0.5f, 1e-5f);
+        EXPECT_GE(rect.offset.x, 0.f);
+        EXPECT_GE(rect.offset.y, 0.f);
+        EXPECT_LE(rect.offset.x + rect.extent.width, 1.f + 1e-6f);
+        EXPECT_LE(rect.offset.y + rect.extent.height, 1.f + 1e-6f);
+
+        // Looking up moves the focus view toward the top of the image.
+        const XrRect2Df up =
+            computeFocusRect(FullFov, computeFocusFov(FullFov, 0.4f, 0.5f, XrVector3f{0, 0.3f, -0.95f}));
+        const XrRect2Df down =
+            computeFocusRect(FullFov, computeFocusFov(FullFov, 0.4f, 0.5f, XrVector3f{0, -0.3f, -0.95f}));
+        EXPECT_LT(up.offset.y, down.offset.y);
+    }
+
+    TEST(Rect, UnionContainsBoth) {
+        const XrRect2Di rect = unionRect({{10, 20}, {30, 40}}, {{-5, 50}, {10, 20}});
+        EXPECT_EQ(rect.offset.x, -5);
+        EXPECT_EQ(rect.offset.y, 20);
+        EXPECT_EQ(rect.extent.width, 45);
+        EXPECT_EQ(rect.extent.height, 50);
+    }
+
+    TEST(Rect, IntersectIsEmptyWithoutOverlap) {
+        const XrRect2Di overlap = intersectRect({{0, 0}, {100, 100}}, {{50, 60}, {100, 100}});
+        EXPECT_EQ(overlap.offset.x, 50);
+        EXPECT_EQ(overlap.offset.y, 60);
+        EXPECT_EQ(overlap.extent.width, 50);
+        EXPECT_EQ(overlap.extent.height, 40);
+        EXPECT_EQ(getArea(overlap), 2000u);
+
+        const XrRect2Di disjoint = intersectRect({{0, 0}, {10, 10}}, {{20, 0}, {10, 10}});
+        EXPECT_EQ(disjoint.extent.width, 0);
+        EXPECT_EQ(getArea(disjoint), 0u);
+    }
+
+    TEST(Rect, InflateStaysInsideTheImage) {
+        const XrRect2Di inner = inflateRect({{10, 10}, {20, 20}}, 2, 100, 100);
+        EXPECT_EQ(inner.offset.x, 8);
+        EXPECT_EQ(inner.offset.y, 8);
+        EXPECT_EQ(inner.extent.width, 24);
+        EXPECT_EQ(inner.extent.height, 24);
+
+        const XrRect2Di edge = inflateRect({{0, 90}, {10, 10}}, 4, 100, 100);
+        EXPECT_EQ(edge.offset.x, 0);
+        EXPECT_EQ(edge.offset.y, 86);
+        EXPECT_EQ(edge.extent.width, 14);
+        EXPECT_EQ(edge.extent.height, 14);
+    }
+
+    TEST(Rect, AreaOfNegativeExtentIsZero) {
+        EXPECT_EQ(getArea({{0, 0}, {-4, 10}}), 0u);
+        EXPECT_EQ(getArea({{0, 0}, {4096, 4096}}), 4096ull * 4096);
+    }
+
+} // namespace
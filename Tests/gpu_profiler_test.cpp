@@ -0,0 +1,126 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <gpu_profiler.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::profiler;
+
+    TEST(ProfilerStatistics, AggregatesTheSamples) {
+        ProfilerStatistics statistics;
+        statistics.record("Frame", 300);
+        statistics.record("Frame", 100);
+        statistics.record("Frame", 200);
+
+        const auto snapshot = statistics.snapshot();
+        ASSERT_EQ(snapshot.size(), 1u);
+        EXPECT_EQ(snapshot[0].first, "Frame");
+        const ScopeStatistics& frame = snapshot[0].second;
+        EXPECT_EQ(frame.count, 3u);
+        EXPECT_EQ(frame.lastUs, 200u);
+        EXPECT_EQ(frame.averageUs, 200u);
+        EXPECT_EQ(frame.minUs, 100u);
+        EXPECT_EQ(frame.maxUs, 300u);
+        EXPECT_EQ(frame.depth, 0u);
+    }
+
+    TEST(ProfilerStatistics, KeepsARollingWindow) {
+        ProfilerStatistics statistics;
+        statistics.record("Frame", 10000);
+        for (size_t i = 0; i < ScopeStatistics::WindowSize; i++) {
+            statistics.record("Frame", 10);
+        }
+
+        const ScopeStatistics frame = statistics.snapshot()[0].second;
+        EXPECT_EQ(frame.count, ScopeStatistics::WindowSize + 1);
+        EXPECT_EQ(frame.maxUs, 10u);
+        EXPECT_EQ(frame.averageUs, 10u);
+    }
+
+    TEST(ProfilerStatistics, OrdersParentsBeforeChildren) {
+        ProfilerStatistics statistics;
+        statistics.record("Layer1/Resolve", 5);
+        statistics.record("Layer10", 5);
+        statistics.record("Layer1", 10);
+        statistics.record("Layer1/Resolve/Depth", 2);
+        statistics.record("Composition", 1);
+
+        const auto snapshot = statistics.snapshot();
+        std::vector<std::string> paths;
+        for (const auto& [path, scope] : snapshot) {
+            paths.push_back(path);
+        }
+        EXPECT_EQ(paths,
+                  (std::vector<std::string>{
+                      "Composition", "Layer1", "Layer1/Resolve", "Layer1/Resolve/Depth", "Layer10"}));
+        EXPECT_EQ(snapshot[1].second.depth, 0u);
+        EXPECT_EQ(snapshot[2].second.depth, 1u);
+        EXPECT_EQ(snapshot[3].second.depth, 2u);
+
+        statistics.reset();
+        EXPECT_TRUE(statistics.snapshot().empty());
+    }
+
+    TEST(ProfilerStatistics, ConcurrentRecordAndSnapshot) {
+        ProfilerStatistics statistics;
+        std::atomic<bool> done{false};
+        std::thread reader([&] {
+            while (!done) {
+                for (const auto& [path, scope] : statistics.snapshot()) {
+                    EXPECT_LE(scope.minUs, scope.maxUs);
+                }
+            }
+        });
+        for (uint64_t i = 0; i < 10000; i++) {
+            statistics.record(i % 2 ? "Frame/Resolve" : "Frame", i);
+        }
+        done = true;
+        reader.join();
+        EXPECT_EQ(statistics.snapshot()[0].second.count, 5000u);
+    }
+
+    TEST(ScopeStack, BuildsNestedPaths) {
+        ScopeStack stack;
+        EXPECT_TRUE(stack.empty());
+        EXPECT_EQ(stack.push("Layer", 2), "Layer2");
+        EXPECT_EQ(stack.push("Resolve"), "Layer2/Resolve");
+        EXPECT_EQ(stack.push("Slice", 0), "Layer2/Resolve/Slice0");
+        stack.pop();
+        EXPECT_EQ(stack.push("Sharpen"), "Layer2/Resolve/Sharpen");
+        stack.pop();
+        stack.pop();
+        EXPECT_EQ(stack.push("Upscale"), "Layer2/Upscale");
+        stack.pop();
+        stack.pop();
+        EXPECT_TRUE(stack.empty());
+        EXPECT_EQ(stack.push("Mirror"), "Mirror");
+
+        // Popping more than pushed is harmless.
+        stack.pop();
+        stack.pop();
+        EXPECT_TRUE(stack.empty());
+    }
+
+} // namespace
@@ -0,0 +1,103 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <graphics_backend.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::graphics;
+
+    struct FakeSwapchain {
+        uint32_t imageCount{0};
+        bool cleanedUp{false};
+    };
+
+    struct FakeImage {
+        XrStructureType type;
+        void* next;
+        uint32_t index;
+    };
+
+    TEST(HeadlessBackend, IsANoOp) {
+        HeadlessBackend<FakeSwapchain> backend;
+        EXPECT_EQ(backend.getApi(), Api::Headless);
+        EXPECT_STREQ(ToString(backend.getApi()), "Headless");
+
+        backend.serializeFrame();
+        backend.flush();
+
+        // Headless sessions cannot have swapchains.
+        FakeSwapchain swapchain;
+        XrSwapchainImageBaseHeader image{};
+        EXPECT_EQ(backend.getSwapchainImages(swapchain, &image, 1), XR_ERROR_RUNTIME_FAILURE);
+        backend.cleanupSwapchainImages(swapchain);
+        EXPECT_FALSE(swapchain.cleanedUp);
+    }
+
+    TEST(DelegateBackend, ForwardsToTheInterop) {
+        uint32_t serializeCount = 0;
+        uint32_t flushCount = 0;
+        DelegateBackend<FakeSwapchain, FakeImage> backend(
+            Api::D3D11,
+            [&] { serializeCount++; },
+            [&] { flushCount++; },
+            [](FakeSwapchain& swapchain, FakeImage* images, uint32_t count) {
+                for (uint32_t i = 0; i < count; i++) {
+                    images[i].index = i;
+                }
+                swapchain.imageCount = count;
+                return XR_SUCCESS;
+            },
+            [](FakeSwapchain& swapchain) { swapchain.cleanedUp = true; });
+        EXPECT_EQ(backend.getApi(), Api::D3D11);
+
+        backend.serializeFrame();
+        backend.serializeFrame();
+        backend.flush();
+        EXPECT_EQ(serializeCount, 2u);
+        EXPECT_EQ(flushCount, 1u);
+
+        // The images are passed as the API-specific structure.
+        FakeSwapchain swapchain;
+        FakeImage images[3]{};
+        EXPECT_EQ(
+            backend.getSwapchainImages(swapchain, reinterpret_cast<XrSwapchainImageBaseHeader*>(images), 3),
+            XR_SUCCESS);
+        EXPECT_EQ(swapchain.imageCount, 3u);
+        EXPECT_EQ(images[2].index, 2u);
+
+        backend.cleanupSwapchainImages(swapchain);
+        EXPECT_TRUE(swapchain.cleanedUp);
+    }
+
+    TEST(DelegateBackend, CleanupIsOptional) {
+        DelegateBackend<FakeSwapchain, FakeImage> backend(
+            Api::OpenGL, [] {}, [] {}, [](FakeSwapchain&, FakeImage*, uint32_t) { return XR_SUCCESS; });
+
+        FakeSwapchain swapchain;
+        backend.cleanupSwapchainImages(swapchain);
+        EXPECT_FALSE(swapchain.cleanedUp);
+    }
+
+} // namespace
@@ -0,0 +1,122 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <interop_worker.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::interop;
+
+    TEST(WorkerQueue, RunsOnTheWorkerThreadInOrder) {
+        std::thread::id startThread, stopThread;
+        std::vector<int> order;
+        {
+            WorkerQueue queue([&] { startThread = std::this_thread::get_id(); },
+                              [&] { stopThread = std::this_thread::get_id(); });
+            for (int i = 0; i < 100; i++) {
+                queue.submit([&order, i] { order.push_back(i); });
+            }
+            const auto workThread = queue.run([] { return std::this_thread::get_id(); });
+            EXPECT_EQ(workThread, startThread);
+            EXPECT_NE(workThread, std::this_thread::get_id());
+        }
+        EXPECT_EQ(stopThread, startThread);
+        ASSERT_EQ(order.size(), 100u);
+        for (int i = 0; i < 100; i++) {
+            EXPECT_EQ(order[i], i);
+        }
+    }
+
+    TEST(WorkerQueue, WaitForCoversEarlierWork) {
+        WorkerQueue queue;
+        std::atomic<int> done{0};
+        WorkerQueue::Ticket last = 0;
+        for (int i = 0; i < 10; i++) {
+            last = queue.submit([&] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                done++;
+            });
+        }
+        queue.waitFor(last - 5);
+        EXPECT_GE(done.load(), 5);
+        queue.waitFor(last);
+        EXPECT_EQ(done.load(), 10);
+        EXPECT_EQ(queue.getCompletedTicket(), last);
+    }
+
+    TEST(WorkerQueue, RunReturnsTheResultOrThrows) {
+        WorkerQueue queue;
+        EXPECT_EQ(queue.run([] { return 42; }), 42);
+        EXPECT_THROW(queue.run([]() -> int { throw std::runtime_error("failed"); }), std::runtime_error);
+
+        // The failure does not leak into the next operations.
+        EXPECT_EQ(queue.run([] { return 7; }), 7);
+    }
+
+    TEST(WorkerQueue, SubmittedFailureIsRethrownOnce) {
+        WorkerQueue queue;
+        queue.submit([] { throw std::runtime_error("failed"); });
+        const auto ticket = queue.submit([] {});
+        EXPECT_THROW(queue.waitFor(ticket), std::runtime_error);
+        EXPECT_NO_THROW(queue.waitFor(ticket));
+    }
+
+    TEST(WorkerQueue, StartFailureIsRethrown) {
+        bool stopped = false;
+        EXPECT_THROW(WorkerQueue([] { throw std::runtime_error("no context"); }, [&] { stopped = true; }),
+                     std::runtime_error);
+        EXPECT_FALSE(stopped);
+    }
+
+    TEST(WorkerQueue, StopCompletesPendingWork) {
+        std::atomic<int> done{0};
+        WorkerQueue queue;
+        for (int i = 0; i < 10; i++) {
+            queue.submit([&] { done++; });
+        }
+        queue.stop();
+        EXPECT_EQ(done.load(), 10);
+
+        // Stopping again, and the destructor, are harmless.
+        queue.stop();
+    }
+
+    TEST(WorkerQueue, ConcurrentSubmitters) {
+        WorkerQueue queue;
+        std::atomic<int> done{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 1000; i++) {
+                    queue.waitFor(queue.submit([&] { done++; }));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        EXPECT_EQ(done.load(), 4000);
+    }
+
+} // namespace
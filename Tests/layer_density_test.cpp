@@ -0,0 +1,124 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <layer_density.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::density;
+
+    // 90 degrees field of view.
+    constexpr XrFovf Fov{-0.785398f, 0.785398f, 0.785398f, -0.785398f};
+    constexpr XrVector3f Origin{0, 0, 0};
+
+    TEST(LayerDensity, DisplayDensity) {
+        const XrVector2f density = GetDisplayDensity(Fov, {2000, 1000});
+        EXPECT_NEAR(density.x, 1000.f, 1.f);
+        EXPECT_NEAR(density.y, 500.f, 1.f);
+    }
+
+    TEST(LayerDensity, QuadAngularExtent) {
+        const AngularExtent extent = GetQuadAngularExtent({0, 0, -2}, {1, 0.5625f}, Origin);
+        EXPECT_NEAR(extent.width, 2 * std::atan(0.25f), 1e-5f);
+        EXPECT_NEAR(extent.height, 2 * std::atan(0.140625f), 1e-5f);
+
+        // A quad at the eye does not produce an infinite density.
+        const AngularExtent atEye = GetQuadAngularExtent(Origin, {1, 1}, Origin);
+        EXPECT_NEAR(atEye.width, 2 * std::atan(0.5f / MinDistance), 1e-5f);
+    }
+
+    TEST(LayerDensity, CylinderAngularExtent) {
+        // Viewed from the axis, the width is the central angle.
+        const AngularExtent inside = GetCylinderAngularExtent(Origin, 2, 1.5f, 2, Origin);
+        EXPECT_NEAR(inside.width, 1.5f, 1e-5f);
+        EXPECT_NEAR(inside.height, 2 * std::atan(0.375f), 1e-5f);
+
+        // A full cylinder around the viewer never exceeds a full turn.
+        const AngularExtent around = GetCylinderAngularExtent({0, 0, -0.5f}, 1, 6.28f, 1, Origin);
+        EXPECT_LE(around.width, 2 * 3.14159265f + 1e-5f);
+
+        // From outside, the extent shrinks with the distance.
+        const AngularExtent outside = GetCylinderAngularExtent(Origin, 1, 3.f, 2, {0, 0, 5});
+        EXPECT_GT(outside.width, 0.f);
+        EXPECT_LT(outside.width, 1.f);
+        const AngularExtent further = GetCylinderAngularExtent(Origin, 1, 3.f, 2, {0, 0, 10});
+        EXPECT_LT(further.width, outside.width);
+
+        // No aspect ratio means no height.
+        EXPECT_EQ(GetCylinderAngularExtent(Origin, 1, 1.f, 0, {0, 0, 5}).height, 0.f);
+    }
+
+    TEST(LayerDensity, Oversampling) {
+        const XrVector2f density = GetDisplayDensity(Fov, {2000, 2000});
+
+        // A 4K quad 1m wide at 2m is about 7.8 times denser than the display.
+        const float far =
+            GetOversampling({3840, 2160}, GetQuadAngularExtent({0, 0, -2}, {1, 0.5625f}, Origin), density);
+        EXPECT_GT(far, 7.f);
+        EXPECT_LT(far, 8.5f);
+
+        // Up close, the same quad is below the display density.
+        const float close = GetOversampling({1024, 1024}, GetQuadAngularExtent({0, 0, -0.3f}, {1, 1}, Origin), density);
+        EXPECT_LT(close, 1.f);
+
+        // Degenerate inputs are not oversampled.
+        EXPECT_EQ(GetOversampling({1024, 1024}, {0.f, 1.f}, density), 1.f);
+        EXPECT_EQ(GetOversampling({1024, 1024}, {1.f, 1.f}, {0.f, 0.f}), 1.f);
+    }
+
+    TEST(LayerDensity, DownsamplingLevel) {
+        EXPECT_EQ(GetDownsamplingLevel(1.9f, {3840, 2160}), 0u);
+        EXPECT_EQ(GetDownsamplingLevel(7.8f, {3840, 2160}), 2u);
+        EXPECT_EQ(GetDownsamplingLevel(1000.f, {3840, 2160}), MaxLevel);
+        EXPECT_EQ(GetDownsamplingLevel(NAN, {3840, 2160}), 0u);
+
+        // Never go below the minimum size.
+        EXPECT_EQ(GetDownsamplingLevel(1000.f, {64, 64}), 2u);
+        EXPECT_EQ(GetDownsamplingLevel(1000.f, {4096, 16}), 0u);
+    }
+
+    TEST(LayerDensity, DownsamplingLevelHysteresis) {
+        // Going up requires some margin above the threshold.
+        EXPECT_EQ(GetDownsamplingLevel(2.1f, {3840, 2160}, 0), 0u);
+        EXPECT_EQ(GetDownsamplingLevel(2.4f, {3840, 2160}, 0), 1u);
+        EXPECT_EQ(GetDownsamplingLevel(4.2f, {3840, 2160}, 1), 1u);
+        EXPECT_EQ(GetDownsamplingLevel(4.7f, {3840, 2160}, 1), 2u);
+
+        // Staying or going down does not.
+        EXPECT_EQ(GetDownsamplingLevel(4.1f, {3840, 2160}, 2), 2u);
+        EXPECT_EQ(GetDownsamplingLevel(3.9f, {3840, 2160}, 2), 1u);
+        EXPECT_EQ(GetDownsamplingLevel(1.9f, {3840, 2160}, 2), 0u);
+    }
+
+    TEST(LayerDensity, DownsampledExtent) {
+        const XrExtent2Di extent = GetDownsampledExtent({3840, 2160}, 2);
+        EXPECT_EQ(extent.width, 960);
+        EXPECT_EQ(extent.height, 540);
+
+        const XrExtent2Di thin = GetDownsampledExtent({4, 1}, 3);
+        EXPECT_EQ(thin.width, 1);
+        EXPECT_EQ(thin.height, 1);
+    }
+
+} // namespace
@@ -0,0 +1,64 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <platform.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::platform;
+
+    TEST(MemorySettingsStore, ReturnsNothingWhenUnset) {
+        MemorySettingsStore store;
+        EXPECT_FALSE(store.getDword("upscaling").has_value());
+    }
+
+    TEST(MemorySettingsStore, SetAndClear) {
+        MemorySettingsStore store;
+        store.set("upscaling", 1);
+        EXPECT_EQ(store.getDword("upscaling"), 1);
+
+        store.set("upscaling", 2);
+        EXPECT_EQ(store.getDword("upscaling"), 2);
+
+        store.clear("upscaling");
+        EXPECT_FALSE(store.getDword("upscaling").has_value());
+    }
+
+    TEST(MemorySettingsStore, OverridesFallback) {
+        auto fallback = std::make_shared<MemorySettingsStore>();
+        fallback->set("upscaling", 1);
+        fallback->set("sharpening", 50);
+
+        MemorySettingsStore store(fallback);
+        store.set("upscaling", 0);
+        EXPECT_EQ(store.getDword("upscaling"), 0);
+        EXPECT_EQ(store.getDword("sharpening"), 50);
+        EXPECT_FALSE(store.getDword("dynamic_resolution").has_value());
+
+        // Clearing a value exposes the fallback again.
+        store.clear("upscaling");
+        EXPECT_EQ(store.getDword("upscaling"), 1);
+    }
+
+} // namespace
@@ -0,0 +1,105 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <recycling_pool.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::pool;
+
+    using Pool = RecyclingPool<std::pair<int, int>, std::string>;
+
+    TEST(RecyclingPool, HandsOutMatchingObjects) {
+        Pool pool(4);
+        EXPECT_FALSE(pool.acquire({1024, 1024}).has_value());
+        EXPECT_EQ(pool.misses(), 1u);
+
+        EXPECT_TRUE(pool.recycle({1024, 1024}, "a").empty());
+        EXPECT_TRUE(pool.recycle({2048, 2048}, "b").empty());
+        EXPECT_EQ(pool.size(), 2u);
+
+        EXPECT_FALSE(pool.acquire({512, 512}).has_value());
+        EXPECT_EQ(pool.acquire({2048, 2048}), "b");
+        EXPECT_FALSE(pool.acquire({2048, 2048}).has_value());
+        EXPECT_EQ(pool.acquire({1024, 1024}), "a");
+        EXPECT_EQ(pool.size(), 0u);
+        EXPECT_EQ(pool.hits(), 2u);
+        EXPECT_EQ(pool.misses(), 3u);
+    }
+
+    TEST(RecyclingPool, HandsOutTheMostRecentlyReleasedFirst) {
+        Pool pool(4);
+        pool.recycle({1, 1}, "older");
+        pool.recycle({1, 1}, "newer");
+        EXPECT_EQ(pool.acquire({1, 1}), "newer");
+        EXPECT_EQ(pool.acquire({1, 1}), "older");
+    }
+
+    TEST(RecyclingPool, EvictsTheLeastRecentlyReleased) {
+        Pool pool(2);
+        EXPECT_TRUE(pool.recycle({1, 1}, "a").empty());
+        EXPECT_TRUE(pool.recycle({2, 2}, "b").empty());
+        EXPECT_EQ(pool.recycle({3, 3}, "c"), std::vector<std::string>{"a"});
+        EXPECT_EQ(pool.evictions(), 1u);
+        EXPECT_FALSE(pool.acquire({1, 1}).has_value());
+
+        // Shrinking the pool returns the evicted objects to the caller, who destroys them.
+        EXPECT_EQ(pool.setCapacity(1), std::vector<std::string>{"b"});
+        EXPECT_EQ(pool.size(), 1u);
+        EXPECT_EQ(pool.evictions(), 2u);
+    }
+
+    TEST(RecyclingPool, DisabledPoolKeepsNothing) {
+        Pool pool;
+        EXPECT_EQ(pool.recycle({1, 1}, "a"), std::vector<std::string>{"a"});
+        EXPECT_EQ(pool.size(), 0u);
+        EXPECT_FALSE(pool.acquire({1, 1}).has_value());
+    }
+
+    TEST(RecyclingPool, Drain) {
+        Pool pool(4);
+        pool.recycle({1, 1}, "a");
+        pool.recycle({2, 2}, "b");
+        EXPECT_EQ(pool.drain(), (std::vector<std::string>{"b", "a"}));
+        EXPECT_EQ(pool.size(), 0u);
+
+        pool.resetStatistics();
+        EXPECT_EQ(pool.hits(), 0u);
+        EXPECT_EQ(pool.misses(), 0u);
+        EXPECT_EQ(pool.evictions(), 0u);
+    }
+
+    TEST(RecyclingPool, MoveOnlyObjects) {
+        RecyclingPool<int, std::unique_ptr<int>> pool(1);
+        pool.recycle(1, std::make_unique<int>(42));
+        const auto evicted = pool.recycle(2, std::make_unique<int>(43));
+        ASSERT_EQ(evicted.size(), 1u);
+        EXPECT_EQ(*evicted[0], 42);
+
+        const auto value = pool.acquire(2);
+        ASSERT_TRUE(value.has_value());
+        EXPECT_EQ(**value, 43);
+    }
+
+} // namespace
@@ -0,0 +1,141 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <resolution_controller.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::dynres;
+
+    constexpr double FrameDuration = 1 / 90.0;
+
+    // A GPU whose cost is proportional to the number of pixels rendered, plus a fixed cost.
+    double SimulateGpuTimeUs(double nativeCostUs, float scale, double fixedCostUs = 500) {
+        return fixedCostUs + nativeCostUs * scale * scale;
+    }
+
+    // Run the closed loop for a number of frames and return the scale at the end.
+    float RunClosedLoop(ScaleController& controller, double nativeCostUs, uint32_t frames) {
+        for (uint32_t i = 0; i < frames; i++) {
+            controller.addSample(SimulateGpuTimeUs(nativeCostUs, controller.getScale()));
+            controller.adjust(FrameDuration);
+        }
+        return controller.getScale();
+    }
+
+    TEST(ScaleController, StaysNativeWithHeadroom) {
+        ScaleController controller;
+        controller.reset(0.5f, 0.9f);
+        EXPECT_EQ(RunClosedLoop(controller, 5000, 300), 1.f);
+    }
+
+    TEST(ScaleController, ConvergesToTheBudget) {
+        ScaleController controller;
+        controller.reset(0.25f, 0.9f);
+        const float scale = RunClosedLoop(controller, 16000, 600);
+        EXPECT_LT(scale, 1.f);
+
+        // Within the hysteresis, the GPU time lands on the budget.
+        const double budgetUs = controller.getGpuBudgetUs(FrameDuration);
+        EXPECT_NEAR(SimulateGpuTimeUs(16000, scale), budgetUs, budgetUs * 2 * 2 * ScaleHysteresis);
+        EXPECT_LE(SimulateGpuTimeUs(16000, scale), FrameDuration * 1e6);
+    }
+
+    TEST(ScaleController, HonorsTheMinimumScale) {
+        ScaleController controller;
+        controller.reset(0.6f, 0.9f);
+        EXPECT_EQ(RunClosedLoop(controller, 100000, 600), 0.6f);
+    }
+
+    TEST(ScaleController, ReactsFasterToOverloadThanToHeadroom) {
+        ScaleController controller;
+        controller.reset(0.25f, 0.9f);
+
+        // A sudden load: the scale goes down by at most the maximum step per frame.
+        controller.addSample(40000);
+        controller.adjust(FrameDuration);
+        EXPECT_FLOAT_EQ(controller.getScale(), 1.f - MaxScaleDecreasePerFrame);
+
+        // The load disappears: the scale goes up by at most the (smaller) maximum step per frame.
+        ScaleController recovering;
+        recovering.reset(0.25f, 0.9f);
+        RunClosedLoop(recovering, 30000, 600);
+        const float before = recovering.getScale();
+        recovering.addSample(100);
+        recovering.adjust(FrameDuration);
+        EXPECT_LE(recovering.getScale() - before, MaxScaleIncreasePerFrame + 1e-6f);
+        EXPECT_GT(recovering.getScale(), before);
+    }
+
+    TEST(ScaleController, FiltersSpikes) {
+        ScaleController controller;
+        controller.reset(0.25f, 0.9f);
+        RunClosedLoop(controller, 5000, 100);
+
+        // A single slow frame (eg: a shader compilation) must not cause a visible drop.
+        controller.addSample(50000);
+        controller.adjust(FrameDuration);
+        EXPECT_GE(controller.getScale(), 1.f - MaxScaleDecreasePerFrame);
+        EXPECT_LT(controller.getFilteredGpuTimeUs(), 10000);
+    }
+
+    TEST(ScaleController, FollowsAGpuTimeTrace) {
+        ScaleController controller;
+        controller.reset(0.5f, 0.9f);
+
+        // A scene getting heavier, then lighter again.
+        std::vector<float> scales;
+        for (uint32_t i = 0; i < 1800; i++) {
+            const double load = i < 600 ? 8000 : i < 1200 ? 18000 : 8000;
+            controller.addSample(SimulateGpuTimeUs(load, controller.getScale()));
+            controller.adjust(FrameDuration);
+            scales.push_back(controller.getScale());
+        }
+        EXPECT_EQ(scales[599], 1.f);
+        EXPECT_LT(scales[1199], 0.9f);
+        EXPECT_EQ(scales.back(), 1.f);
+
+        // The scale never oscillates frame to frame.
+        uint32_t directionChanges = 0;
+        for (size_t i = 2; i < scales.size(); i++) {
+            const float previous = scales[i - 1] - scales[i - 2];
+            const float current = scales[i] - scales[i - 1];
+            if (previous * current < 0) {
+                directionChanges++;
+            }
+        }
+        EXPECT_LE(directionChanges, 4u);
+    }
+
+    TEST(ScaleController, ResetScale) {
+        ScaleController controller;
+        controller.reset(0.5f, 0.9f);
+        RunClosedLoop(controller, 30000, 300);
+        EXPECT_LT(controller.getScale(), 1.f);
+
+        controller.resetScale();
+        EXPECT_EQ(controller.getScale(), 1.f);
+    }
+
+} // namespace
@@ -0,0 +1,200 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <geometry.h>
+#include <resolve_planner.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::resolve;
+
+    bool IsEmpty(const XrRect2Di& rect) {
+        return rect.extent.width <= 0 || rect.extent.height <= 0;
+    }
+
+    TEST(SelectOperation, MatchesTheSwapchainProperties) {
+        EXPECT_EQ(SelectOperation(false, 4, true), Operation::None);
+        EXPECT_EQ(SelectOperation(true, 1, false), Operation::Copy);
+        EXPECT_EQ(SelectOperation(true, 1, true), Operation::Copy);
+        EXPECT_EQ(SelectOperation(true, 4, false), Operation::ResolveColor);
+        EXPECT_EQ(SelectOperation(true, 4, true), Operation::ResolveDepth);
+        EXPECT_STREQ(ToString(Operation::ResolveDepth), "Depth");
+    }
+
+    TEST(MakeBatch, OrdersAndDeduplicatesSlices) {
+        const Batch batch = MakeBatch(Operation::Copy,
+                                      {{1, 2, {{0, 0}, {10, 10}}},
+                                       {0, 2, {{0, 0}, {20, 10}}},
+                                       {1, 2, {{0, 0}, {30, 30}}}});
+        ASSERT_EQ(batch.slices.size(), 2u);
+        EXPECT_EQ(batch.slices[0].slice, 0u);
+        EXPECT_EQ(batch.slices[1].slice, 1u);
+        EXPECT_EQ(batch.slices[1].region.extent.width, 10);
+    }
+
+    TEST(Batch, WorkSkipsEmptyRegions) {
+        const Batch batch = MakeBatch(Operation::ResolveDepth,
+                                      {{0, 0, {{0, 0}, {100, 50}}},
+                                       {1, 0, {{10, 10}, {0, 50}}},
+                                       {2, 0, {{0, 0}, {8, 8}}}});
+        const auto work = batch.work();
+        ASSERT_EQ(work.size(), 2u);
+        EXPECT_EQ(work[0]->slice, 0u);
+        EXPECT_EQ(work[1]->slice, 2u);
+        EXPECT_EQ(batch.pixels(), 100u * 50 + 8 * 8);
+
+        const Batch nothing = MakeBatch(Operation::None, {{0, 0, {{0, 0}, {100, 50}}}});
+        EXPECT_TRUE(nothing.work().empty());
+        EXPECT_EQ(nothing.pixels(), 0u);
+    }
+
+    TEST(ResolveDepthTexel, KeepsTheLargestSample) {
+        const float samples[] = {0.25f, 0.75f, 0.5f, 0.f};
+        EXPECT_EQ(ResolveDepthTexel(4, [&](uint32_t i) { return samples[i]; }), 0.75f);
+        EXPECT_EQ(ResolveDepthTexel(1, [&](uint32_t i) { return samples[i]; }), 0.25f);
+        EXPECT_EQ(ResolveDepthTexel(0, [&](uint32_t i) { return samples[i]; }), 0.f);
+    }
+
+    // Resolve a multisampled depth array the way the D3D11 backend drives ResolveMultisampledDepthPS: one draw per
+    // slice of the batch, restricted to the region of the slice.
+    TEST(ResolveDepthTexel, ResolvesTheRegionsOfABatch) {
+        constexpr uint32_t Width = 16;
+        constexpr uint32_t Height = 8;
+        constexpr uint32_t Slices = 2;
+        constexpr uint32_t Samples = 4;
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> distribution(0.f, 1.f);
+        std::vector<float> source(Slices * Height * Width * Samples);
+        for (auto& depth : source) {
+            depth = distribution(rng);
+        }
+        const auto load = [&](uint32_t slice, uint32_t x, uint32_t y, uint32_t i) {
+            return source[((slice * Height + y) * Width + x) * Samples + i];
+        };
+
+        const Batch batch = MakeBatch(SelectOperation(true, Samples, true),
+                                      {{1, 0, {{4, 2}, {8, 4}}}, {0, 0, {{0, 0}, {Width, Height}}}});
+        ASSERT_EQ(batch.operation, Operation::ResolveDepth);
+
+        constexpr float Untouched = -1.f;
+        std::vector<float> destination(Slices * Height * Width, Untouched);
+        for (const auto* entry : batch.work()) {
+            const XrRect2Di& region = entry->region;
+            for (int32_t y = region.offset.y; y < region.offset.y + region.extent.height; y++) {
+                for (int32_t x = region.offset.x; x < region.offset.x + region.extent.width; x++) {
+                    destination[(entry->slice * Height + y) * Width + x] = ResolveDepthTexel(
+                        Samples, [&](uint32_t i) { return load(entry->slice, x, y, i); });
+                }
+            }
+        }
+
+        uint64_t resolved = 0;
+        for (uint32_t slice = 0; slice < Slices; slice++) {
+            for (uint32_t y = 0; y < Height; y++) {
+                for (uint32_t x = 0; x < Width; x++) {
+                    const float depth = destination[(slice * Height + y) * Width + x];
+                    const bool isInRegion = slice == 0 || (x >= 4 && x < 12 && y >= 2 && y < 6);
+                    if (!isInRegion) {
+                        EXPECT_EQ(depth, Untouched);
+                        continue;
+                    }
+                    float expected = 0;
+                    for (uint32_t i = 0; i < Samples; i++) {
+                        expected = std::max(expected, load(slice, x, y, i));
+                    }
+                    EXPECT_EQ(depth, expected);
+                    resolved++;
+                }
+            }
+        }
+        EXPECT_EQ(resolved, batch.pixels());
+    }
+
+    TEST(DamageHistory, NeverWrittenNeedsTheWholeImage) {
+        DamageHistory history;
+        history.record(1, XrRect2Di{{0, 0}, {10, 10}});
+        EXPECT_FALSE(history.getDamageSince(0).has_value());
+    }
+
+    TEST(DamageHistory, UpToDateNeedsNothing) {
+        DamageHistory history;
+        history.record(1, XrRect2Di{{0, 0}, {10, 10}});
+        const auto damage = history.getDamageSince(1);
+        ASSERT_TRUE(damage.has_value());
+        EXPECT_TRUE(IsEmpty(damage.value()));
+    }
+
+    TEST(DamageHistory, AccumulatesTheReleasesSinceTheLastWrite) {
+        // With 3 OVR images, the image written at generation 1 is reused at generation 4 and misses 2, 3 and 4.
+        DamageHistory history;
+        history.record(1, XrRect2Di{{0, 0}, {100, 100}});
+        history.record(2, XrRect2Di{{10, 10}, {10, 10}});
+        history.record(3, XrRect2Di{{50, 50}, {10, 10}});
+        history.record(4, XrRect2Di{{30, 0}, {5, 5}});
+
+        const auto damage = history.getDamageSince(1);
+        ASSERT_TRUE(damage.has_value());
+        EXPECT_EQ(damage->offset.x, 10);
+        EXPECT_EQ(damage->offset.y, 0);
+        EXPECT_EQ(damage->extent.width, 50);
+        EXPECT_EQ(damage->extent.height, 60);
+
+        // The image written at generation 3 only misses the last release.
+        const auto recent = history.getDamageSince(3);
+        ASSERT_TRUE(recent.has_value());
+        EXPECT_EQ(recent->offset.x, 30);
+        EXPECT_EQ(recent->extent.width, 5);
+    }
+
+    TEST(DamageHistory, ReleaseWithoutRegionNeedsTheWholeImage) {
+        DamageHistory history;
+        history.record(1, XrRect2Di{{0, 0}, {10, 10}});
+        history.record(2, std::nullopt);
+        history.record(3, XrRect2Di{{0, 0}, {10, 10}});
+        EXPECT_FALSE(history.getDamageSince(1).has_value());
+        EXPECT_TRUE(history.getDamageSince(2).has_value());
+    }
+
+    TEST(DamageHistory, EmptyRegionsAreSkipped) {
+        DamageHistory history;
+        history.record(1, XrRect2Di{{0, 0}, {10, 10}});
+        history.record(2, XrRect2Di{{0, 0}, {0, 0}});
+        history.record(3, XrRect2Di{{20, 20}, {10, 10}});
+        const auto damage = history.getDamageSince(1);
+        ASSERT_TRUE(damage.has_value());
+        EXPECT_EQ(damage->offset.x, 20);
+        EXPECT_EQ(damage->extent.width, 10);
+    }
+
+    TEST(DamageHistory, TooOldNeedsTheWholeImage) {
+        DamageHistory history;
+        for (uint64_t generation = 1; generation <= DamageHistory::MaxEntries + 2; generation++) {
+            history.record(generation, XrRect2Di{{0, 0}, {1, 1}});
+        }
+        EXPECT_FALSE(history.getDamageSince(1).has_value());
+        EXPECT_TRUE(history.getDamageSince(3).has_value());
+    }
+
+} // namespace
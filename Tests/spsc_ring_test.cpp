@@ -0,0 +1,102 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <spsc_ring.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::utils;
+
+    TEST(SpscRing, Fifo) {
+        SpscRing<int, 3> ring;
+        EXPECT_TRUE(ring.empty());
+        EXPECT_FALSE(ring.front().has_value());
+        EXPECT_FALSE(ring.pop());
+
+        EXPECT_TRUE(ring.push(1));
+        EXPECT_TRUE(ring.push(2));
+        EXPECT_TRUE(ring.push(3));
+        EXPECT_FALSE(ring.push(4));
+        EXPECT_EQ(ring.size(), 3u);
+
+        EXPECT_EQ(ring.front(), 1);
+        EXPECT_TRUE(ring.pop());
+        EXPECT_EQ(ring.front(), 2);
+
+        // Wrap around.
+        EXPECT_TRUE(ring.push(4));
+        EXPECT_EQ(ring.size(), 3u);
+        for (int expected : {2, 3, 4}) {
+            EXPECT_EQ(ring.front(), expected);
+            EXPECT_TRUE(ring.pop());
+        }
+        EXPECT_TRUE(ring.empty());
+    }
+
+    TEST(SpscRing, Clear) {
+        SpscRing<int, 4> ring;
+        ring.push(1);
+        ring.push(2);
+        ring.clear();
+        EXPECT_TRUE(ring.empty());
+        EXPECT_TRUE(ring.push(3));
+        EXPECT_EQ(ring.front(), 3);
+    }
+
+    TEST(SpscRing, ConcurrentProducerAndConsumer) {
+        // Like the acquired image indices of a swapchain: one thread acquires, another one releases.
+        constexpr uint32_t Count = 1'000'000;
+        SpscRing<uint32_t, 3> ring;
+
+        std::thread producer([&] {
+            for (uint32_t i = 0; i < Count;) {
+                if (ring.push(i)) {
+                    i++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        // Every value is received exactly once and in order.
+        uint32_t expected = 0;
+        bool inOrder = true;
+        while (expected < Count) {
+            const auto value = ring.front();
+            if (!value) {
+                std::this_thread::yield();
+                continue;
+            }
+            inOrder = inOrder && *value == expected;
+            EXPECT_LE(ring.size(), 3u);
+            EXPECT_TRUE(ring.pop());
+            expected++;
+        }
+        producer.join();
+
+        EXPECT_TRUE(inOrder);
+        EXPECT_TRUE(ring.empty());
+    }
+
+} // namespace
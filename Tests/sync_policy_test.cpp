@@ -0,0 +1,119 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <sync_policy.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::sync;
+
+    TEST(SyncPolicy, GpuWaitsByDefault) {
+        SyncPolicy policy;
+        EXPECT_EQ(policy.getMode(), WaitMode::Gpu);
+        EXPECT_EQ(policy.decide(10, 10), WaitDecision::None);
+        EXPECT_EQ(policy.decide(9, 10), WaitDecision::Gpu);
+        EXPECT_EQ(policy.getCpuWaitBudgetUs(), 0u);
+        EXPECT_FALSE(policy.isPreferringCpu());
+    }
+
+    TEST(SyncPolicy, CpuWaitsAreUnbounded) {
+        SyncPolicy policy;
+        policy.setMode(WaitMode::Cpu);
+        EXPECT_EQ(policy.decide(10, 10), WaitDecision::None);
+        EXPECT_EQ(policy.decide(9, 10), WaitDecision::Cpu);
+        EXPECT_EQ(policy.getCpuWaitBudgetUs(), 0u);
+        EXPECT_TRUE(policy.isPreferringCpu());
+    }
+
+    TEST(SyncPolicy, AdaptiveNeverStallsAGpuBoundApplication) {
+        SyncPolicy policy(500, 4);
+        policy.setMode(WaitMode::Adaptive);
+        EXPECT_EQ(policy.getCpuWaitBudgetUs(), 500u);
+
+        // The work is never done in time: no frame is ever probed with a CPU wait.
+        for (uint32_t i = 0; i < 1000; i++) {
+            EXPECT_EQ(policy.decide(i, i + 1), WaitDecision::Gpu) << i;
+        }
+    }
+
+    TEST(SyncPolicy, AdaptiveProbesWhenTheWorkIsMostlyDone) {
+        SyncPolicy policy(500, 4);
+        policy.setMode(WaitMode::Adaptive);
+
+        // Most frames of the period found the work done, so the last one probes a CPU wait.
+        EXPECT_EQ(policy.decide(10, 10), WaitDecision::None);
+        EXPECT_EQ(policy.decide(11, 11), WaitDecision::None);
+        EXPECT_EQ(policy.decide(12, 12), WaitDecision::None);
+        EXPECT_EQ(policy.decide(12, 13), WaitDecision::Cpu);
+
+        // The probe was cheap: keep waiting on the CPU.
+        policy.recordCpuWait(50, true);
+        EXPECT_TRUE(policy.isPreferringCpu());
+        EXPECT_EQ(policy.decide(13, 14), WaitDecision::Cpu);
+        policy.recordCpuWait(100, true);
+        EXPECT_TRUE(policy.isPreferringCpu());
+
+        // An expensive wait that ran out of budget falls back to GPU waits.
+        policy.recordCpuWait(2000, false);
+        EXPECT_FALSE(policy.isPreferringCpu());
+        EXPECT_EQ(policy.decide(15, 16), WaitDecision::Gpu);
+    }
+
+    TEST(SyncPolicy, AdaptiveIgnoresASingleHitch) {
+        SyncPolicy policy(1000, 1);
+        policy.setMode(WaitMode::Adaptive);
+        policy.recordCpuWait(100, true);
+        policy.recordCpuWait(100, true);
+        policy.recordCpuWait(100, true);
+        ASSERT_TRUE(policy.isPreferringCpu());
+
+        // The average absorbs an occasional slow (but completed) wait.
+        policy.recordCpuWait(700, true);
+        EXPECT_TRUE(policy.isPreferringCpu());
+    }
+
+    TEST(SyncPolicy, ChangingModeResetsTheHistory) {
+        SyncPolicy policy(500, 4);
+        policy.setMode(WaitMode::Adaptive);
+        policy.recordCpuWait(50, true);
+        ASSERT_TRUE(policy.isPreferringCpu());
+
+        policy.setMode(WaitMode::Gpu);
+        policy.setMode(WaitMode::Adaptive);
+        EXPECT_FALSE(policy.isPreferringCpu());
+        EXPECT_EQ(policy.decide(9, 10), WaitDecision::Gpu);
+    }
+
+    TEST(WaitStatistics, Record) {
+        WaitStatistics statistics;
+        statistics.record(100, false);
+        statistics.record(1000000, true);
+        statistics.record(50, false);
+        EXPECT_EQ(statistics.count, 3u);
+        EXPECT_EQ(statistics.timeouts, 1u);
+        EXPECT_EQ(statistics.totalUs, 1000150u);
+        EXPECT_EQ(statistics.maxUs, 1000000u);
+    }
+
+} // namespace
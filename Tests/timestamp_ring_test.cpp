@@ -0,0 +1,104 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <timestamp_ring.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::utils;
+
+    TEST(TimestampRing, HandsOutEachSlotOnce) {
+        TimestampRing ring(3);
+        EXPECT_EQ(ring.size(), 3u);
+
+        std::set<uint32_t> slots;
+        for (uint32_t i = 0; i < ring.size(); i++) {
+            const auto slot = ring.acquire(0);
+            ASSERT_TRUE(slot.has_value());
+            slots.insert(slot.value());
+        }
+        EXPECT_EQ(slots.size(), 3u);
+
+        EXPECT_FALSE(ring.acquire(0).has_value());
+        EXPECT_EQ(ring.exhausted(), 1u);
+    }
+
+    TEST(TimestampRing, SlotIsReusedOnlyOnceTheGpuIsDone) {
+        TimestampRing ring(1);
+        const uint32_t slot = ring.acquire(0).value();
+        EXPECT_FALSE(ring.isReady(slot, 0));
+
+        ring.submit(slot, 5);
+        EXPECT_FALSE(ring.isReady(slot, 4));
+        EXPECT_TRUE(ring.isReady(slot, 5));
+
+        // Released while still in flight.
+        ring.release(slot);
+        EXPECT_FALSE(ring.acquire(4).has_value());
+        const auto reused = ring.acquire(5);
+        ASSERT_TRUE(reused.has_value());
+        EXPECT_EQ(reused.value(), slot);
+
+        // A newly acquired slot has no submission.
+        EXPECT_FALSE(ring.isReady(slot, 5));
+        EXPECT_EQ(ring.exhausted(), 1u);
+    }
+
+    TEST(TimestampRing, RotatesThroughTheSlots) {
+        TimestampRing ring(4);
+        uint32_t previous = ring.acquire(0).value();
+        ring.release(previous);
+        for (uint32_t i = 0; i < 8; i++) {
+            const uint32_t slot = ring.acquire(0).value();
+            EXPECT_EQ(slot, (previous + 1) % ring.size());
+            ring.release(slot);
+            previous = slot;
+        }
+    }
+
+    TEST(TimestampRing, SkipsBusySlots) {
+        TimestampRing ring(3);
+        const uint32_t first = ring.acquire(0).value();
+        const uint32_t second = ring.acquire(0).value();
+        const uint32_t third = ring.acquire(0).value();
+        ring.submit(first, 10);
+        ring.release(first);
+        ring.submit(third, 2);
+        ring.release(third);
+
+        // The slot still in flight is passed over.
+        EXPECT_EQ(ring.acquire(2).value(), third);
+        EXPECT_FALSE(ring.acquire(2).has_value());
+        ring.release(second);
+        EXPECT_EQ(ring.acquire(2).value(), second);
+    }
+
+    TEST(TimestampRing, QueriesArePaired) {
+        EXPECT_EQ(TimestampRing::startQuery(0), 0u);
+        EXPECT_EQ(TimestampRing::stopQuery(0), 1u);
+        EXPECT_EQ(TimestampRing::startQuery(5), 10u);
+        EXPECT_EQ(TimestampRing::stopQuery(5), 11u);
+    }
+
+} // namespace
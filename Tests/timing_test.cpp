@@ -0,0 +1,101 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <timing.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::utils;
+
+    using clock = RateLimiter::clock;
+
+    TEST(RateLimiter, PacesOnAFixedGrid) {
+        RateLimiter limiter;
+        limiter.setRate(50);
+
+        const clock::time_point start = clock::now();
+        EXPECT_TRUE(limiter.poll(start));
+        EXPECT_FALSE(limiter.poll(start + 10ms));
+        EXPECT_EQ(limiter.timeUntilNext(start + 15ms), 5ms);
+
+        // A late occurrence does not delay the following ones.
+        EXPECT_TRUE(limiter.poll(start + 25ms));
+        EXPECT_FALSE(limiter.poll(start + 39ms));
+        EXPECT_TRUE(limiter.poll(start + 40ms));
+    }
+
+    TEST(RateLimiter, DoesNotBurstAfterFallingBehind) {
+        RateLimiter limiter;
+        limiter.setRate(100);
+
+        const clock::time_point start = clock::now();
+        EXPECT_TRUE(limiter.poll(start));
+
+        // Stalled for many periods: only one occurrence is due, and the grid restarts from there.
+        EXPECT_TRUE(limiter.poll(start + 105ms));
+        EXPECT_FALSE(limiter.poll(start + 106ms));
+        EXPECT_EQ(limiter.timeUntilNext(start + 106ms), 9ms);
+        EXPECT_TRUE(limiter.poll(start + 115ms));
+    }
+
+    TEST(RateLimiter, MatchesTheRateOverTime) {
+        RateLimiter limiter;
+        limiter.setRate(30);
+
+        // Poll every millisecond for 10 seconds.
+        const clock::time_point start = clock::now();
+        uint32_t occurrences = 0;
+        for (uint32_t i = 0; i < 10000; i++) {
+            if (limiter.poll(start + std::chrono::milliseconds(i))) {
+                occurrences++;
+            }
+        }
+        EXPECT_NEAR(occurrences, 300, 1);
+    }
+
+    TEST(RateLimiter, ZeroRateIsUnlimited) {
+        RateLimiter limiter;
+        limiter.setRate(0);
+
+        const clock::time_point now = clock::now();
+        EXPECT_TRUE(limiter.poll(now));
+        EXPECT_TRUE(limiter.poll(now));
+        EXPECT_EQ(limiter.timeUntilNext(now), clock::duration::zero());
+    }
+
+    TEST(CpuTimer, AccumulatesUntilQueried) {
+        CpuTimer timer;
+        timer.start();
+        std::this_thread::sleep_for(2ms);
+        timer.stop();
+        timer.start();
+        std::this_thread::sleep_for(2ms);
+        timer.stop();
+
+        EXPECT_GE(timer.query(false), 4000u);
+        EXPECT_GE(timer.query(), 4000u);
+        EXPECT_EQ(timer.query(), 0u);
+    }
+
+} // namespace
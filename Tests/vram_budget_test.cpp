@@ -0,0 +1,157 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <vram_budget.h>
+
+namespace {
+
+    using namespace virtualdesktop_openxr::vram;
+
+    constexpr uint64_t MiB = 1024 * 1024;
+
+    TEST(BudgetManager, AccountsByCategoryAndOwner) {
+        BudgetManager manager;
+        int first, second;
+        manager.add(Category::AppSwapchain, &first, 10 * MiB);
+        manager.add(Category::AppSwapchain, &first, 5 * MiB);
+        manager.add(Category::ResolvedSlice, &second, 20 * MiB);
+        EXPECT_EQ(manager.getUsage(Category::AppSwapchain), 15 * MiB);
+        EXPECT_EQ(manager.getUsage(Category::ResolvedSlice), 20 * MiB);
+        EXPECT_EQ(manager.getTotalUsage(), 35 * MiB);
+
+        // Setting replaces the previous size, in both directions.
+        manager.set(Category::AppSwapchain, &first, 4 * MiB);
+        EXPECT_EQ(manager.getUsage(Category::AppSwapchain), 4 * MiB);
+        manager.set(Category::AppSwapchain, &first, 8 * MiB);
+        EXPECT_EQ(manager.getUsage(Category::AppSwapchain), 8 * MiB);
+
+        manager.release(&first);
+        EXPECT_EQ(manager.getUsage(Category::AppSwapchain), 0u);
+        EXPECT_EQ(manager.getTotalUsage(), 20 * MiB);
+
+        // Releasing an unknown owner is harmless.
+        manager.release(&first);
+        EXPECT_EQ(manager.getTotalUsage(), 20 * MiB);
+    }
+
+    TEST(BudgetManager, AccountsPooledOwnersSeparately) {
+        BudgetManager manager;
+        int owner;
+        manager.add(Category::AppSwapchain, &owner, 10 * MiB);
+        manager.add(Category::ResolvedSlice, &owner, 6 * MiB);
+        EXPECT_EQ(manager.getPooledUsage(), 0u);
+
+        manager.setPooled(&owner, true);
+        manager.setPooled(&owner, true);
+        EXPECT_EQ(manager.getPooledUsage(), 16 * MiB);
+        EXPECT_EQ(manager.getTotalUsage(), 16 * MiB);
+
+        manager.add(Category::ResolvedSlice, &owner, 2 * MiB);
+        EXPECT_EQ(manager.getPooledUsage(), 18 * MiB);
+        manager.set(Category::AppSwapchain, &owner, 4 * MiB);
+        EXPECT_EQ(manager.getPooledUsage(), 12 * MiB);
+
+        manager.setPooled(&owner, false);
+        EXPECT_EQ(manager.getPooledUsage(), 0u);
+
+        manager.setPooled(&owner, true);
+        manager.release(&owner);
+        EXPECT_EQ(manager.getPooledUsage(), 0u);
+        EXPECT_EQ(manager.getTotalUsage(), 0u);
+    }
+
+    TEST(BudgetManager, PressureHasHysteresis) {
+        BudgetManager manager;
+        constexpr uint64_t Budget = 1000 * MiB;
+        EXPECT_FALSE(manager.update(Budget, 500 * MiB));
+        EXPECT_EQ(manager.getPressure(), Pressure::None);
+
+        EXPECT_TRUE(manager.update(Budget, 860 * MiB));
+        EXPECT_EQ(manager.getPressure(), Pressure::Moderate);
+        EXPECT_EQ(manager.getBudget(), Budget);
+        EXPECT_EQ(manager.getProcessUsage(), 860 * MiB);
+
+        // Between the release and moderate thresholds, the pressure stays.
+        EXPECT_FALSE(manager.update(Budget, 800 * MiB));
+        EXPECT_EQ(manager.getPressure(), Pressure::Moderate);
+
+        EXPECT_TRUE(manager.update(Budget, 960 * MiB));
+        EXPECT_EQ(manager.getPressure(), Pressure::Critical);
+
+        // Critical is only lowered once below the release threshold.
+        EXPECT_FALSE(manager.update(Budget, 900 * MiB));
+        EXPECT_EQ(manager.getPressure(), Pressure::Critical);
+        EXPECT_TRUE(manager.update(Budget, 700 * MiB));
+        EXPECT_EQ(manager.getPressure(), Pressure::None);
+    }
+
+    TEST(BudgetManager, NoBudgetMeansNoPressure) {
+        BudgetManager manager;
+        manager.update(1000 * MiB, 990 * MiB);
+        EXPECT_EQ(manager.getPressure(), Pressure::Critical);
+        EXPECT_TRUE(manager.update(0, 990 * MiB));
+        EXPECT_EQ(manager.getPressure(), Pressure::None);
+    }
+
+    TEST(BudgetManager, SheddingPolicyFollowsThePressure) {
+        BudgetManager manager;
+        SheddingPolicy policy = manager.getSheddingPolicy();
+        EXPECT_FALSE(policy.releaseSwapchainPool);
+        EXPECT_FALSE(policy.skipSharpeningIntermediate);
+        EXPECT_FALSE(policy.shrinkMirrorWindow);
+
+        manager.update(100, 90);
+        policy = manager.getSheddingPolicy();
+        EXPECT_TRUE(policy.releaseSwapchainPool);
+        EXPECT_FALSE(policy.skipSharpeningIntermediate);
+        EXPECT_FALSE(policy.shrinkMirrorWindow);
+
+        manager.update(100, 99);
+        policy = manager.getSheddingPolicy();
+        EXPECT_TRUE(policy.releaseSwapchainPool);
+        EXPECT_TRUE(policy.skipSharpeningIntermediate);
+        EXPECT_TRUE(policy.shrinkMirrorWindow);
+        EXPECT_STREQ(ToString(manager.getPressure()), "Critical");
+    }
+
+    TEST(BudgetManager, ConcurrentAccounting) {
+        BudgetManager manager;
+        constexpr uint32_t Threads = 4;
+        constexpr uint32_t Iterations = 10000;
+        std::vector<int> owners(Threads);
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < Threads; t++) {
+            threads.emplace_back([&, t] {
+                for (uint32_t i = 0; i < Iterations; i++) {
+                    manager.add(Category::MirrorWindow, &owners[t], 1);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        EXPECT_EQ(manager.getUsage(Category::MirrorWindow), (uint64_t)Threads * Iterations);
+    }
+
+} // namespace
@@ -0,0 +1,596 @@
+# MIT License
+#
+# Copyright(c) 2022-2024 Matthieu Bucchianeri
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this softwareand associated documentation files(the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions :
+#
+# The above copyright noticeand this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Offline analysis of the runtime's trace events: reconstruct the timeline of each frame, attribute the frame time to
+# its stages, and report the percentiles, the causes of the hitches and the ASW transitions.
+#
+# Supported inputs:
+# - CSV exported from WPA (Generic Events table) or tracerpt. The columns are found by name, and the "Field N" columns
+#   are mapped to the arguments of the known events.
+# - JSON: a list of events, one event per line, or Chrome/Perfetto trace events ({"traceEvents": [...]}).
+#   Each event has a name, a time ("ts" in microseconds or "time" in seconds), an opcode ("Start", "Stop" or "Info",
+#   or a Chrome "ph"), and optionally a thread ("tid"), an activity and its fields ("fields" or "args").
+# - The API capture written by the runtime when the "capture" registry setting is enabled (OpenXR.capture).
+#
+# Only the Python standard library is needed.
+
+import argparse
+import csv
+import json
+import math
+import os
+import struct
+import sys
+
+# Stages of a frame, in order of the timeline.
+STAGES = [
+    ('wait', 'xrWaitFrame'),
+    ('begin', 'xrBeginFrame'),
+    ('app_cpu', 'App CPU'),
+    ('submission', 'xrEndFrame'),
+    ('app_gpu', 'App GPU'),
+    ('precomposition', 'Precomposition GPU'),
+    ('compositor', 'Compositor'),
+]
+
+# Arguments of the events, in order, for the exports that only have positional fields.
+KNOWN_FIELDS = {
+    'WaitFrame': ['Now', 'PredictedDisplayTime', 'PhotonTime', 'WaitDurationUs'],
+    'BeginFrame': ['FrameDiscarded', 'WaitDurationUs'],
+    'AcquiredFrame': ['FrameId'],
+    'SubmitLayers': ['FrameId', 'Fps', 'LastPrecompositionTimeUs'],
+    'OVR_EndFrame': ['FrameId', 'NumLayers', 'Fps', 'LastPrecompositionTimeUs'],
+    'OVR_WaitToBeginFrame': ['FrameId'],
+    'OVR_AswStatus': ['AsyncReprojectionActive'],
+    'GpuProfiler_Scope': ['Scope', 'DurationUs'],
+    'DynamicResolution': ['AppGpuTimeUs', 'PrecompositionGpuTimeUs', 'FilteredGpuTimeUs', 'BudgetUs',
+                          'SubmittedWidth', 'Scale'],
+    'PreprocessSwapchainImage': ['DestIndex', 'Slice', 'NeedClearAlpha', 'NeedPremultiplyAlpha'],
+}
+
+CAPTURE_MAGIC = 0x43584456
+CAPTURE_VERSION = 2
+
+
+class Event:
+    __slots__ = ('time', 'name', 'opcode', 'thread', 'activity', 'fields')
+
+    def __init__(self, time, name, opcode, thread=None, activity=None, fields=None):
+        self.time = time            # Microseconds.
+        self.name = name
+        self.opcode = opcode        # 'start', 'stop' or 'info'.
+        self.thread = thread
+        self.activity = activity
+        self.fields = fields or {}
+
+
+def parse_number(value):
+    if isinstance(value, (int, float)):
+        return value
+    if value is None:
+        return None
+    value = str(value).strip()
+    if ',' in value and '.' in value:
+        # Thousands separators.
+        value = value.replace(',', '')
+    if value.lower() in ('true', 'false'):
+        return 1 if value.lower() == 'true' else 0
+    try:
+        return int(value, 0)
+    except ValueError:
+        pass
+    try:
+        return float(value)
+    except ValueError:
+        return None
+
+
+def parse_opcode(value):
+    value = str(value or '').strip().lower()
+    if value in ('start', 'win:start', '1', 'b'):
+        return 'start'
+    if value in ('stop', 'end', 'win:stop', '2', 'e'):
+        return 'stop'
+    return 'info'
+
+
+#
+# Loaders.
+#
+
+def find_column(header, candidates):
+    lowered = [column.strip().lower() for column in header]
+    for candidate in candidates:
+        for index, column in enumerate(lowered):
+            if column == candidate or column.startswith(candidate + ' ('):
+                return index
+    return None
+
+
+def time_scale(column):
+    column = column.lower()
+    for unit, scale in (('(ns)', 1e-3), ('(us)', 1.0), ('(µs)', 1.0), ('(ms)', 1e3), ('(s)', 1e6)):
+        if unit in column:
+            return scale
+    return 1e6
+
+
+def load_csv(path):
+    events = []
+    with open(path, newline='', encoding='utf-8-sig', errors='replace') as file:
+        reader = csv.reader(file)
+        header = next(reader, None)
+        if not header:
+            return events
+        name_index = find_column(header, ['task name', 'event name', 'name', 'task'])
+        opcode_index = find_column(header, ['opcode name', 'opcode', 'type'])
+        time_index = find_column(header, ['time', 'timestamp', 'clock-time', 'time (s)'])
+        thread_index = find_column(header, ['threadid', 'thread id', 'tid'])
+        activity_index = find_column(header, ['activityid', 'activity id'])
+        if name_index is None or time_index is None:
+            raise ValueError(f'{path}: missing the event name or time column')
+        scale = time_scale(header[time_index])
+        reserved = {name_index, opcode_index, time_index, thread_index, activity_index}
+        field_columns = [(index, column.strip()) for index, column in enumerate(header) if index not in reserved]
+
+        for row in reader:
+            if len(row) <= max(name_index, time_index):
+                continue
+            name = row[name_index].strip()
+            time = parse_number(row[time_index])
+            if not name or time is None:
+                continue
+            fields = {}
+            positional = []
+            for index, column in field_columns:
+                if index >= len(row) or row[index].strip() == '':
+                    continue
+                if column.lower().startswith('field '):
+                    positional.append(row[index].strip())
+                else:
+                    fields[column] = row[index].strip()
+            for field_name, value in zip(KNOWN_FIELDS.get(name, []), positional):
+                fields.setdefault(field_name, value)
+            events.append(Event(time * scale,
+                                name,
+                                parse_opcode(row[opcode_index]) if opcode_index is not None else 'info',
+                                row[thread_index].strip() if thread_index is not None else None,
+                                row[activity_index].strip() if activity_index is not None else None,
+                                fields))
+    return events
+
+
+def load_json(path):
+    with open(path, encoding='utf-8') as file:
+        text = file.read()
+    try:
+        document = json.loads(text)
+        entries = document.get('traceEvents', []) if isinstance(document, dict) else document
+    except json.JSONDecodeError:
+        entries = [json.loads(line) for line in text.splitlines() if line.strip()]
+
+    events = []
+    for entry in entries:
+        name = entry.get('name')
+        if not name:
+            continue
+        if 'ts' in entry:
+            time = float(entry['ts'])
+        elif 'time' in entry:
+            time = float(entry['time']) * 1e6
+        else:
+            continue
+        fields = dict(entry.get('fields') or entry.get('args') or {})
+        thread = entry.get('tid', entry.get('thread'))
+        activity = entry.get('activity')
+        phase = entry.get('ph')
+        if phase == 'X':
+            # Complete events carry their duration.
+            events.append(Event(time, name, 'start', thread, activity, fields))
+            events.append(Event(time + float(entry.get('dur', 0)), name, 'stop', thread, activity, {}))
+            continue
+        events.append(Event(time, name, parse_opcode(phase or entry.get('opcode')), thread, activity, fields))
+    return events
+
+
+def load_capture(path):
+    events = []
+    with open(path, 'rb') as file:
+        data = file.read()
+    magic, version, _ = struct.unpack_from('<IIQ', data, 0)
+    if magic != CAPTURE_MAGIC or version != CAPTURE_VERSION:
+        raise ValueError(f'{path}: not a supported capture')
+    offset = 16
+    apis = {}
+    # framework/capture.h writes CallRecord as-is: api, thread, result, startTime, duration, payloadSize, then 4 bytes
+    # of zeroed padding.
+    call_record = struct.Struct('<HHiqqI4x')
+    while offset < len(data):
+        kind = data[offset]
+        offset += 1
+        if kind == 0:
+            if offset + 4 > len(data):
+                break
+            api, length = struct.unpack_from('<HH', data, offset)
+            offset += 4
+            apis[api] = data[offset:offset + length].decode('ascii', errors='replace')
+            offset += length
+        elif kind == 1:
+            if offset + call_record.size > len(data):
+                break
+            api, thread, result, start, duration, payload_size = call_record.unpack_from(data, offset)
+            offset += call_record.size + payload_size
+            if offset > len(data):
+                break
+            name = apis.get(api, f'api{api}')
+            events.append(Event(start / 1e3, name, 'start', thread, None, {}))
+            events.append(Event((start + duration) / 1e3, name, 'stop', thread, None, {'Result': result}))
+        else:
+            raise ValueError(f'{path}: invalid record at offset {offset - 1}')
+    events.sort(key=lambda event: event.time)
+    return events
+
+
+def load(path):
+    extension = os.path.splitext(path)[1].lower()
+    if extension == '.csv':
+        return load_csv(path)
+    if extension in ('.json', '.jsonl'):
+        return load_json(path)
+    if extension == '.capture':
+        return load_capture(path)
+    with open(path, 'rb') as file:
+        if file.read(4) == struct.pack('<I', CAPTURE_MAGIC):
+            return load_capture(path)
+    raise ValueError(f'{path}: unknown format (expected .csv, .json or .capture)')
+
+
+#
+# Reconstruction of the frames.
+#
+
+class Span:
+    __slots__ = ('name', 'start', 'stop', 'thread', 'fields')
+
+    def __init__(self, name, start, stop, thread, fields):
+        self.name = name
+        self.start = start
+        self.stop = stop
+        self.thread = thread
+        self.fields = fields
+
+    @property
+    def duration(self):
+        return self.stop - self.start
+
+
+class Frame:
+    def __init__(self, index, wait):
+        self.index = index
+        self.wait = wait
+        self.begin = None
+        self.end = None
+        self.interval = None
+        self.stages = {}
+        self.discarded = False
+        self.asw = None
+        self.preprocessed = 0
+        self.hitch_cause = None
+
+
+def pair_spans(events):
+    '''Match the start and stop events, by activity when available or by thread otherwise.'''
+    spans = []
+    instants = []
+    open_spans = {}
+    for event in events:
+        key = event.activity if event.activity not in (None, '', '{00000000-0000-0000-0000-000000000000}') else (
+            event.thread, event.name)
+        if event.opcode == 'start':
+            open_spans.setdefault(key, []).append(event)
+        elif event.opcode == 'stop':
+            stack = open_spans.get(key)
+            if stack:
+                start = stack.pop()
+                fields = dict(start.fields)
+                fields.update(event.fields)
+                spans.append(Span(start.name, start.time, event.time, start.thread, fields))
+        else:
+            instants.append(event)
+    spans.sort(key=lambda span: span.start)
+    return spans, instants
+
+
+def field(fields, name):
+    return parse_number(fields.get(name))
+
+
+def build_frames(events):
+    events = sorted(events, key=lambda event: event.time)
+    spans, instants = pair_spans(events)
+
+    frames = []
+    for span in spans:
+        if span.name == 'xrWaitFrame':
+            frames.append(Frame(len(frames), span))
+    if not frames:
+        return frames, []
+
+    starts = [frame.wait.start for frame in frames]
+
+    def frame_at(time):
+        # The last frame whose xrWaitFrame started before the given time.
+        low, high = 0, len(starts)
+        while low < high:
+            middle = (low + high) // 2
+            if starts[middle] <= time:
+                low = middle + 1
+            else:
+                high = middle
+        return frames[low - 1] if low else None
+
+    for span in spans:
+        frame = frame_at(span.start)
+        if frame is None:
+            continue
+        if span.name == 'xrBeginFrame' and frame.begin is None:
+            frame.begin = span
+        elif span.name == 'xrEndFrame' and frame.end is None:
+            frame.end = span
+
+    # The OVR frame ID identifies the frame for the events of the asynchronous submission thread.
+    ovr_frames = {}
+    for event in instants:
+        if event.name == 'SubmitLayers':
+            frame = frame_at(event.time)
+            frame_id = field(event.fields, 'FrameId')
+            if frame and frame_id is not None:
+                ovr_frames[frame_id] = frame
+            precomposition = field(event.fields, 'LastPrecompositionTimeUs')
+            if frame and precomposition:
+                frame.stages['precomposition'] = precomposition
+    for span in spans:
+        if span.name != 'OVR_EndFrame':
+            continue
+        frame_id = field(span.fields, 'FrameId')
+        frame = ovr_frames.get(frame_id) if frame_id is not None else None
+        if frame is None:
+            frame = frame_at(span.start)
+        if frame is None:
+            continue
+        frame.stages['compositor'] = frame.stages.get('compositor', 0) + span.duration
+        precomposition = field(span.fields, 'LastPrecompositionTimeUs')
+        if precomposition:
+            frame.stages['precomposition'] = precomposition
+
+    asw_transitions = []
+    asw_active = None
+    for event in instants:
+        frame = frame_at(event.time)
+        if frame is None:
+            continue
+        if event.name == 'BeginFrame':
+            frame.discarded = frame.discarded or bool(field(event.fields, 'FrameDiscarded'))
+        elif event.name == 'PreprocessSwapchainImage':
+            frame.preprocessed += 1
+        elif event.name == 'DynamicResolution':
+            app_gpu = field(event.fields, 'AppGpuTimeUs')
+            if app_gpu:
+                frame.stages['app_gpu'] = app_gpu
+            precomposition = field(event.fields, 'PrecompositionGpuTimeUs')
+            if precomposition and 'precomposition' not in frame.stages:
+                frame.stages['precomposition'] = precomposition
+        elif event.name == 'App_Statistics':
+            app_gpu = field(event.fields, 'AppRenderGpuTime')
+            if app_gpu:
+                frame.stages['app_gpu'] = app_gpu
+        elif event.name == 'OVR_AswStatus':
+            active = bool(field(event.fields, 'AsyncReprojectionActive'))
+            frame.asw = active
+            if asw_active is not None and active != asw_active:
+                asw_transitions.append((event.time, frame.index, active))
+            asw_active = active
+
+    for index, frame in enumerate(frames):
+        frame.stages['wait'] = frame.wait.duration
+        if frame.begin:
+            frame.stages['begin'] = frame.begin.duration
+        if frame.end:
+            frame.stages['submission'] = frame.end.duration
+            if frame.begin and frame.end.start >= frame.begin.stop:
+                frame.stages['app_cpu'] = frame.end.start - frame.begin.stop
+        if index + 1 < len(frames):
+            frame.interval = frames[index + 1].wait.stop - frame.wait.stop
+
+    return frames, asw_transitions
+
+
+#
+# Statistics.
+#
+
+def percentile(values, p):
+    '''Nearest-rank percentile of sorted values.'''
+    if not values:
+        return 0.0
+    rank = max(1, math.ceil(p / 100.0 * len(values)))
+    return values[min(rank, len(values)) - 1]
+
+
+def summarize(values):
+    values = sorted(values)
+    return {
+        'count': len(values),
+        'mean': sum(values) / len(values) if values else 0.0,
+        'p50': percentile(values, 50),
+        'p90': percentile(values, 90),
+        'p99': percentile(values, 99),
+        'max': values[-1] if values else 0.0,
+    }
+
+
+def classify_hitches(frames, threshold):
+    '''Flag the frames much longer than the median, and blame the stage that exceeded its median the most.'''
+    intervals = sorted(frame.interval for frame in frames if frame.interval is not None)
+    if not intervals:
+        return []
+    median_interval = percentile(intervals, 50)
+    medians = {}
+    for stage, _ in STAGES:
+        medians[stage] = percentile(sorted(frame.stages[stage] for frame in frames if stage in frame.stages), 50)
+
+    hitches = []
+    for index, frame in enumerate(frames):
+        if frame.interval is None or frame.interval <= threshold * median_interval:
+            continue
+        previous = frames[index - 1] if index else None
+        if previous is not None and frame.asw is not None and previous.asw is not None and frame.asw != previous.asw:
+            cause = 'ASW engaged' if frame.asw else 'ASW disengaged'
+        elif frame.discarded:
+            cause = 'Frame discarded'
+        else:
+            excess = {stage: frame.stages[stage] - medians[stage] for stage, _ in STAGES if stage in frame.stages}
+            stage = max(excess, key=excess.get) if excess else None
+            cause = dict(STAGES)[stage] if stage and excess[stage] > 0 else 'Unknown'
+        frame.hitch_cause = cause
+        hitches.append(frame)
+    return hitches
+
+
+def analyze(events, threshold):
+    frames, asw_transitions = build_frames(events)
+    hitches = classify_hitches(frames, threshold)
+
+    stages = {}
+    for stage, label in STAGES:
+        values = [frame.stages[stage] for frame in frames if stage in frame.stages]
+        if values:
+            stages[stage] = dict(summarize(values), label=label)
+    intervals = [frame.interval for frame in frames if frame.interval is not None]
+    causes = {}
+    for frame in hitches:
+        causes[frame.hitch_cause] = causes.get(frame.hitch_cause, 0) + 1
+    duration = (frames[-1].wait.stop - frames[0].wait.start) / 1e6 if frames else 0.0
+
+    return {
+        'frames': len(frames),
+        'duration': duration,
+        'frame_rate': len(frames) / duration if duration > 0 else 0.0,
+        'frame_interval': summarize(intervals),
+        'stages': stages,
+        'discarded': sum(1 for frame in frames if frame.discarded),
+        'hitches': len(hitches),
+        'hitch_causes': causes,
+        'worst_hitches': [{'frame': frame.index,
+                           'time': frame.wait.start / 1e6,
+                           'interval_us': frame.interval,
+                           'cause': frame.hitch_cause,
+                           'stages_us': dict(frame.stages)}
+                          for frame in sorted(hitches, key=lambda frame: frame.interval, reverse=True)],
+        'asw_transitions': [{'time': time / 1e6, 'frame': index, 'active': active}
+                            for time, index, active in asw_transitions],
+    }, frames
+
+
+#
+# Output.
+#
+
+def print_report(report, top):
+    print(f'{report["frames"]} frames in {report["duration"]:.1f} s: {report["frame_rate"]:.1f} fps, '
+          f'{report["discarded"]} discarded, {report["hitches"]} hitches')
+    print(f'{"Stage":<24} {"Frames":>8} {"Mean (ms)":>10} {"P50":>8} {"P90":>8} {"P99":>8} {"Max":>8}')
+    print('-' * 80)
+    rows = [('Frame interval', report['frame_interval'])]
+    rows += [(stage['label'], stage) for stage in report['stages'].values()]
+    for label, stats in rows:
+        print(f'{label:<24} {stats["count"]:>8} {stats["mean"] / 1e3:>10.2f} {stats["p50"] / 1e3:>8.2f} '
+              f'{stats["p90"] / 1e3:>8.2f} {stats["p99"] / 1e3:>8.2f} {stats["max"] / 1e3:>8.2f}')
+
+    if report['hitch_causes']:
+        print()
+        print('Hitch causes:')
+        for cause, count in sorted(report['hitch_causes'].items(), key=lambda item: item[1], reverse=True):
+            print(f'  {cause:<24} {count:>6}')
+        print()
+        print('Worst hitches:')
+        for hitch in report['worst_hitches'][:top]:
+            print(f'  frame {hitch["frame"]:>7} at {hitch["time"]:>10.3f} s: {hitch["interval_us"] / 1e3:>7.2f} ms '
+                  f'({hitch["cause"]})')
+
+    if report['asw_transitions']:
+        print()
+        print('ASW transitions:')
+        for transition in report['asw_transitions']:
+            print(f'  frame {transition["frame"]:>7} at {transition["time"]:>10.3f} s: '
+                  f'{"engaged" if transition["active"] else "disengaged"}')
+
+
+def write_frames_csv(path, frames):
+    with open(path, 'w', newline='') as file:
+        writer = csv.writer(file)
+        writer.writerow(['frame', 'time_s', 'interval_us'] + [f'{stage}_us' for stage, _ in STAGES] +
+                        ['discarded', 'asw', 'preprocessed_images', 'hitch_cause'])
+        for frame in frames:
+            writer.writerow([frame.index, f'{frame.wait.start / 1e6:.6f}',
+                             '' if frame.interval is None else f'{frame.interval:.1f}'] +
+                            ['' if stage not in frame.stages else f'{frame.stages[stage]:.1f}' for stage, _ in STAGES] +
+                            [int(frame.discarded), '' if frame.asw is None else int(frame.asw), frame.preprocessed,
+                             frame.hitch_cause or ''])
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Analyze the frame timing of a VirtualDesktop-OpenXR trace.')
+    parser.add_argument('trace', help='trace exported to .csv or .json, or an API capture (.capture)')
+    parser.add_argument('--hitch-threshold', type=float, default=1.5,
+                        help='frames longer than this multiple of the median are hitches (default: 1.5)')
+    parser.add_argument('--top', type=int, default=10, help='number of hitches to list (default: 10)')
+    parser.add_argument('--json', metavar='FILE', help='write the report as JSON ("-" for stdout)')
+    parser.add_argument('--frames', metavar='FILE', help='write the timeline of each frame as CSV')
+    args = parser.parse_args()
+
+    try:
+        events = load(args.trace)
+    except (OSError, ValueError, struct.error) as exc:
+        print(exc, file=sys.stderr)
+        return 1
+
+    report, frames = analyze(events, args.hitch_threshold)
+    if not frames:
+        print(f'{args.trace}: no xrWaitFrame start/stop events found', file=sys.stderr)
+        return 1
+
+    if args.json == '-':
+        json.dump(report, sys.stdout, indent=2)
+        print()
+    else:
+        print_report(report, args.top)
+        if args.json:
+            with open(args.json, 'w') as file:
+                json.dump(report, file, indent=2)
+    if args.frames:
+        write_frames_csv(args.frames, frames)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -52,7 +52,7 @@ namespace virtualdesktop_openxr {
         };
 
         struct FingerJointState {
-            Pose Pose;
+            BodyTracking::Pose Pose;
             float Radius;
             Vector3 AngularVelocity;
             Vector3 LinearVelocity;
@@ -60,13 +60,13 @@ namespace virtualdesktop_openxr {
 
         struct BodyJointLocation {
             uint64_t LocationFlags;
-            Pose Pose;
+            BodyTracking::Pose Pose;
         };
 
         struct SkeletonJoint {
             int32_t Joint;
             int32_t ParentJoint;
-            Pose Pose;
+            BodyTracking::Pose Pose;
         };
 
         static constexpr int ExpressionCount = 70;
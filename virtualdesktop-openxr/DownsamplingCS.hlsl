@@ -0,0 +1,123 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Downsample a supersampled image with a box or Lanczos filter.
+
+#include "Common.hlsli"
+
+cbuffer config : register(b0)
+{
+    int2 topLeft;
+    int2 sourceSize;
+    float2 scale;
+    uint2 destSize;
+    uint filter;
+    bool isSRGB;
+    bool useTileMask;
+    bool preserveAlpha;
+};
+
+Texture2D<float4> sourceTexture : register(t0);
+Texture2D<uint> tileMask : register(t1);
+RWTexture2D<float4> downsampledTexture : register(u0);
+
+// Must match downsampler.h.
+#define FILTER_BOX 1
+#define FILTER_LANCZOS 2
+#define MAX_RADIUS 8.0
+#define PI 3.14159265
+
+float GetSupport()
+{
+    return filter == FILTER_LANCZOS ? 2.0 : 0.5;
+}
+
+float EvaluateKernel(float x)
+{
+    x = abs(x);
+    if (filter == FILTER_BOX)
+    {
+        return x < 0.5 ? 1.0 : 0.0;
+    }
+
+    // Lanczos-2.
+    if (x < 1e-5)
+    {
+        return 1.0;
+    }
+    if (x >= 2.0)
+    {
+        return 0.0;
+    }
+    const float pix = PI * x;
+    return 2.0 * sin(pix) * sin(pix / 2.0) / (pix * pix);
+}
+
+[numthreads(16, 16, 1)]
+void main(uint3 dtid : SV_DispatchThreadID, uint3 wgid : SV_GroupID)
+{
+    // Skip the 16x16 tiles that are not visible through the lenses.
+    if (useTileMask && !tileMask[wgid.xy])
+    {
+        return;
+    }
+
+    if (any(dtid.xy >= destSize))
+    {
+        return;
+    }
+
+    // Never narrow the kernel below one source pixel (when the destination is larger than the source).
+    const float2 filterScale = max(scale, 1.0);
+    const float2 center = (dtid.xy + 0.5) * scale - 0.5;
+    const float2 radius = min(GetSupport() * filterScale, MAX_RADIUS);
+    const int2 first = max(int2(ceil(center - radius)), 0);
+    const int2 last = min(int2(floor(center + radius)), sourceSize - 1);
+
+    float4 color = 0;
+    float total = 0;
+    for (int y = first.y; y <= last.y; y++)
+    {
+        const float weightY = EvaluateKernel((y - center.y) / filterScale.y);
+        for (int x = first.x; x <= last.x; x++)
+        {
+            const float weight = weightY * EvaluateKernel((x - center.x) / filterScale.x);
+            color += weight * sourceTexture.Load(int3(topLeft + int2(x, y), 0));
+            total += weight;
+        }
+    }
+    if (total != 0)
+    {
+        color /= total;
+    }
+
+    // Lanczos may undershoot.
+    color = max(color, 0);
+    if (isSRGB)
+    {
+        color.rgb = ToSRGB(color.rgb);
+    }
+
+    // Projection layers are opaque, but quad layers are blended with their premultiplied alpha.
+    downsampledTexture[dtid.xy] = float4(color.rgb, preserveAlpha ? color.a : 1);
+}
@@ -0,0 +1,75 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Stitch the focus view of quad views rendering on top of the peripheral view.
+
+#include "Common.hlsli"
+
+cbuffer config : register(b0)
+{
+    float2 peripheralTopLeft;
+    float2 peripheralSize;
+    float2 focusTopLeft;
+    float2 focusSize;
+    float2 focusRectTopLeft;
+    float2 focusRectSize;
+    float featherWidth;
+    bool isSRGB;
+};
+
+SamplerState linearClamp : register(s0);
+
+Texture2D<float4> peripheralTexture : register(t0);
+Texture2D<float4> focusTexture : register(t1);
+RWTexture2D<float4> outputTexture : register(u0);
+
+[numthreads(16, 16, 1)]
+void main(uint2 pos : SV_DispatchThreadID)
+{
+    uint2 dimension;
+    outputTexture.GetDimensions(dimension.x, dimension.y);
+    if (any(pos >= dimension))
+    {
+        return;
+    }
+
+    const float2 uv = (pos + 0.5) / dimension;
+    float3 color = peripheralTexture.SampleLevel(linearClamp, peripheralTopLeft + uv * peripheralSize, 0).rgb;
+
+    const float2 focusUv = (uv - focusRectTopLeft) / focusRectSize;
+    if (all(focusUv >= 0) && all(focusUv <= 1))
+    {
+        // Feather the edges of the focus view to hide the transition in resolution.
+        const float2 distanceToEdge = min(focusUv, 1 - focusUv);
+        const float weight = smoothstep(0, featherWidth, min(distanceToEdge.x, distanceToEdge.y));
+        const float3 focusColor = focusTexture.SampleLevel(linearClamp, focusTopLeft + focusUv * focusSize, 0).rgb;
+        color = lerp(color, focusColor, weight);
+    }
+
+    if (isSRGB)
+    {
+        color = ToSRGB(color);
+    }
+
+    // TODO: We don't passthrough alpha channel. This is typically OK since we should be layer 0.
+    outputTexture[pos] = float4(color, 1);
+}
@@ -20,7 +20,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-// A shader to resolve multisampled depth into single samples.
+// A shader to resolve multisampled depth into single samples. Must match ResolveDepthTexel() in resolve_planner.h.
 SamplerState sourceSampler : register(s0);
 
 cbuffer config : register(b0)
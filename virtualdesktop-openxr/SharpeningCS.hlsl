@@ -28,12 +28,13 @@ cbuffer config : register(b0)
 {
     uint2 topLeft;
     bool isSRGB;
-    uint padding;
+    bool useTileMask;
     uint4 const0; // CAS
     uint4 const1; // CAS
 };
 
 Texture2D<float4> sourceTexture : register(t0);
+Texture2D<uint> tileMask : register(t1);
 RWTexture2D<float4> sharpenedTexture : register(u0);
 
 #define A_GPU 1
@@ -67,6 +68,12 @@ void CasStore(AU2 p, AF3 c)
 [numthreads(64, 1, 1)]
 void main(uint3 tid : SV_GroupThreadID, uint3 wgid : SV_GroupID)
 {
+    // Skip the 16x16 tiles that are not visible through the lenses.
+    if (useTileMask && !tileMask[wgid.xy])
+    {
+        return;
+    }
+
     // Do remapping of local xy in workgroup for a more PS-like swizzle pattern.
     AU2 gxy = ARmp8x8(tid.x) + AU2(wgid.x << 4u, wgid.y << 4u);
 
@@ -28,7 +28,7 @@ cbuffer config : register(b0)
 {
     float2 topLeftNormalized;
     bool isSRGB;
-    uint padding;
+    bool useTileMask;
     uint4 const0; // FSR
     uint4 const1; // FSR
     uint4 const2; // FSR
@@ -38,6 +38,7 @@ cbuffer config : register(b0)
 SamplerState linearClamp : register(s0);
 
 Texture2D<float4> sourceTexture : register(t0);
+Texture2D<uint> tileMask : register(t1);
 RWTexture2D<float4> upscaledTexture : register(u0);
 
 #define A_GPU 1
@@ -79,6 +80,12 @@ void FsrStore(AU2 p, AF3 c)
 [numthreads(64, 1, 1)]
 void main(uint3 tid : SV_GroupThreadID, uint3 wgid : SV_GroupID)
 {
+    // Skip the 16x16 tiles that are not visible through the lenses.
+    if (useTileMask && !tileMask[wgid.xy])
+    {
+        return;
+    }
+
     // Do remapping of local xy in workgroup for a more PS-like swizzle pattern.
     AU2 gxy = ARmp8x8(tid.x) + AU2(wgid.x << 4u, wgid.y << 4u);
 
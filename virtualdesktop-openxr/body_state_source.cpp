@@ -0,0 +1,282 @@
+// MIT License
+//
+// Copyright(c) 2025 Microsoft Corp.
+// Initial implementation by Matthieu Bucchianeri, Jonas Holderman and Heather Kemp.
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+
+#include "pch.h"
+
+#include "BodyState.h"
+#include "body_state_source.h"
+#include "log.h"
+
+// Implements the sources of body state: the memory mapped file from Virtual Desktop, plus the recording, replaying and
+// procedural generation (see body_state_synthesis.cpp) of samples to exercise hand, body, eye and face tracking without
+// a headset.
+
+namespace {
+
+    using namespace virtualdesktop_openxr;
+    using namespace virtualdesktop_openxr::BodyTracking;
+    using namespace virtualdesktop_openxr::log;
+
+    using namespace std::chrono_literals;
+
+    // Recording files are a header followed by a sequence of records.
+    static constexpr uint32_t k_RecordingMagic = 0x53424456; // 'VDBS'
+    static constexpr uint32_t k_RecordingVersion = 1;
+
+    struct RecordingHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t stateSize;
+        uint32_t reserved;
+    };
+
+    struct RecordingSample {
+        double time; // Seconds since the start of the recording.
+        BodyStateV2 state;
+    };
+
+    struct MmfBodyStateSource : BodyStateSource {
+        MmfBodyStateSource(wil::unique_handle file, const BodyStateV2* view, wil::unique_handle event)
+            : m_file(std::move(file)), m_view(view), m_event(std::move(event)) {
+        }
+
+        ~MmfBodyStateSource() override {
+            UnmapViewOfFile(m_view);
+        }
+
+        const char* GetName() const override {
+            return "VirtualDesktop";
+        }
+
+        bool WaitForSample(std::chrono::milliseconds timeout, BodyStateV2& state) override {
+            {
+                TraceLocalActivity(wait);
+                TraceLoggingWriteStart(wait, "BodyStateWatcherThread_Wait");
+                const auto status = WaitForSingleObject(m_event.get(), (DWORD)timeout.count());
+                TraceLoggingWriteStop(wait, "BodyStateWatcherThread_Wait", TLArg(status, "Status"));
+            }
+
+            // Virtual Desktop does not always signal the event, so we always take the latest state.
+            state = *m_view;
+
+            // Avoid spurious wakeup when the event was not reset quickly-enough.
+            std::this_thread::sleep_for(5ms);
+
+            return true;
+        }
+
+        const wil::unique_handle m_file;
+        const BodyStateV2* const m_view;
+        const wil::unique_handle m_event;
+    };
+
+    struct SyntheticBodyStateSource : BodyStateSource {
+        SyntheticBodyStateSource(uint32_t parts, double rate)
+            : m_parts(parts), m_period(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                  std::chrono::duration<double>(1.0 / std::max(rate, 1.0)))) {
+        }
+
+        const char* GetName() const override {
+            return "Synthetic";
+        }
+
+        bool WaitForSample(std::chrono::milliseconds timeout, BodyStateV2& state) override {
+            const auto now = std::chrono::steady_clock::now();
+            if (!m_sampleCount) {
+                m_start = now;
+            }
+
+            const auto due = m_start + m_sampleCount * m_period;
+            if (due > now + timeout) {
+                std::this_thread::sleep_for(timeout);
+                return false;
+            }
+            std::this_thread::sleep_until(due);
+
+            // The animation follows the sample index rather than the wall clock, so that sequences are repeatable.
+            Synthesize(std::chrono::duration<double>(m_sampleCount * m_period).count(), m_parts, state);
+            m_sampleCount++;
+
+            return true;
+        }
+
+        const uint32_t m_parts;
+        const std::chrono::steady_clock::duration m_period;
+        std::chrono::steady_clock::time_point m_start;
+        uint64_t m_sampleCount{0};
+    };
+
+    struct BodyStateRecorder : BodyStateSource {
+        BodyStateRecorder(std::unique_ptr<BodyStateSource> source, std::ofstream file)
+            : m_source(std::move(source)), m_file(std::move(file)), m_start(std::chrono::steady_clock::now()) {
+        }
+
+        ~BodyStateRecorder() override {
+            Log("Recorded %llu body state samples\n", m_sampleCount);
+        }
+
+        const char* GetName() const override {
+            return m_source->GetName();
+        }
+
+        bool WaitForSample(std::chrono::milliseconds timeout, BodyStateV2& state) override {
+            if (!m_source->WaitForSample(timeout, state)) {
+                return false;
+            }
+
+            const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+            m_file.write(reinterpret_cast<const char*>(&time), sizeof(time));
+            m_file.write(reinterpret_cast<const char*>(&state), sizeof(state));
+            m_sampleCount++;
+
+            return true;
+        }
+
+        const std::unique_ptr<BodyStateSource> m_source;
+        std::ofstream m_file;
+        const std::chrono::steady_clock::time_point m_start;
+        uint64_t m_sampleCount{0};
+    };
+
+    struct BodyStateReplayer : BodyStateSource {
+        BodyStateReplayer(std::vector<RecordingSample> samples, double speed, bool loop)
+            : m_samples(std::move(samples)), m_speed(speed), m_loop(loop) {
+        }
+
+        const char* GetName() const override {
+            return "Replay";
+        }
+
+        bool WaitForSample(std::chrono::milliseconds timeout, BodyStateV2& state) override {
+            const auto now = std::chrono::steady_clock::now();
+            if (m_next == m_samples.size()) {
+                if (!m_loop) {
+                    std::this_thread::sleep_for(timeout);
+                    return false;
+                }
+                m_next = 0;
+            }
+            if (m_next == 0) {
+                m_start = now;
+            }
+
+            if (m_speed > 0) {
+                const auto offset =
+                    std::chrono::duration<double>((m_samples[m_next].time - m_samples[0].time) / m_speed);
+                const auto due = m_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset);
+                if (due > now + timeout) {
+                    std::this_thread::sleep_for(timeout);
+                    return false;
+                }
+                std::this_thread::sleep_until(due);
+            }
+
+            state = m_samples[m_next++].state;
+
+            return true;
+        }
+
+        const std::vector<RecordingSample> m_samples;
+        const double m_speed;
+        const bool m_loop;
+        std::chrono::steady_clock::time_point m_start;
+        size_t m_next{0};
+    };
+
+} // namespace
+
+namespace virtualdesktop_openxr::BodyTracking {
+
+    std::unique_ptr<BodyStateSource> CreateMmfBodyStateSource() {
+        wil::unique_handle file;
+        *file.put() = OpenFileMapping(FILE_MAP_READ, false, L"VirtualDesktop.BodyState");
+        if (!file) {
+            TraceLoggingWrite(g_traceProvider, "VirtualDesktopBodyTracker_NotAvailable");
+            return {};
+        }
+
+        const auto view = reinterpret_cast<const BodyStateV2*>(
+            MapViewOfFile(file.get(), FILE_MAP_READ, 0, 0, sizeof(BodyStateV2)));
+        if (!view) {
+            TraceLoggingWrite(g_traceProvider, "VirtualDesktopBodyTracker_MappingError_BodyStateV2");
+            return {};
+        }
+
+        wil::unique_handle event;
+        *event.put() = OpenEvent(SYNCHRONIZE, false, L"VirtualDesktop.BodyStateEvent2");
+
+        return std::make_unique<MmfBodyStateSource>(std::move(file), view, std::move(event));
+    }
+
+    std::unique_ptr<BodyStateSource> CreateSyntheticBodyStateSource(uint32_t parts, double rate) {
+        Log("Using synthetic body state (parts: 0x%x, rate: %.1f Hz)\n", parts, rate);
+        return std::make_unique<SyntheticBodyStateSource>(parts, rate);
+    }
+
+    std::unique_ptr<BodyStateSource> CreateBodyStateRecorder(std::unique_ptr<BodyStateSource> source,
+                                                             const std::filesystem::path& path) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            ErrorLog("Failed to open body state recording: %s\n", path.string().c_str());
+            return source;
+        }
+
+        const RecordingHeader header{k_RecordingMagic, k_RecordingVersion, (uint32_t)sizeof(BodyStateV2), 0};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        Log("Recording body state to: %s\n", path.string().c_str());
+        return std::make_unique<BodyStateRecorder>(std::move(source), std::move(file));
+    }
+
+    std::unique_ptr<BodyStateSource> CreateBodyStateReplayer(const std::filesystem::path& path,
+                                                             double speed,
+                                                             bool loop) {
+        std::ifstream file(path, std::ios::binary);
+        RecordingHeader header{};
+        if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            header.magic != k_RecordingMagic || header.version != k_RecordingVersion ||
+            header.stateSize != sizeof(BodyStateV2)) {
+            ErrorLog("Failed to load body state recording: %s\n", path.string().c_str());
+            return {};
+        }
+
+        std::vector<RecordingSample> samples;
+        RecordingSample sample;
+        while (file.read(reinterpret_cast<char*>(&sample.time), sizeof(sample.time)) &&
+               file.read(reinterpret_cast<char*>(&sample.state), sizeof(sample.state))) {
+            samples.push_back(sample);
+        }
+        if (samples.empty()) {
+            ErrorLog("Body state recording is empty: %s\n", path.string().c_str());
+            return {};
+        }
+
+        Log("Replaying %zu body state samples (speed: %.2f, loop: %s) from: %s\n",
+            samples.size(),
+            speed,
+            loop ? "yes" : "no",
+            path.string().c_str());
+        return std::make_unique<BodyStateReplayer>(std::move(samples), speed, loop);
+    }
+
+} // namespace virtualdesktop_openxr::BodyTracking
@@ -0,0 +1,64 @@
+// MIT License
+//
+// Copyright(c) 2025 Microsoft Corp.
+// Initial implementation by Matthieu Bucchianeri, Jonas Holderman and Heather Kemp.
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+
+#pragma once
+
+namespace virtualdesktop_openxr::BodyTracking {
+
+    // A producer of body state samples (hands, body, eyes and face), consumed by the body state watcher thread.
+    struct BodyStateSource {
+        virtual ~BodyStateSource() = default;
+
+        virtual const char* GetName() const = 0;
+
+        // Wait up to timeout for the next sample. Returns false if no new sample was produced.
+        virtual bool WaitForSample(std::chrono::milliseconds timeout, BodyStateV2& state) = 0;
+    };
+
+    // Parts filled by the synthetic generator.
+    static constexpr uint32_t SyntheticHands = 1 << 0;
+    static constexpr uint32_t SyntheticBody = 1 << 1;
+    static constexpr uint32_t SyntheticEyes = 1 << 2;
+    static constexpr uint32_t SyntheticFace = 1 << 3;
+    static constexpr uint32_t SyntheticAll = SyntheticHands | SyntheticBody | SyntheticEyes | SyntheticFace;
+
+    // Fill the requested parts of a state with a procedural animation. The result only depends on time (in seconds).
+    void Synthesize(double time, uint32_t parts, BodyStateV2& state);
+
+    // The memory mapped file written by Virtual Desktop. Returns nullptr if Virtual Desktop is not exposing one.
+    std::unique_ptr<BodyStateSource> CreateMmfBodyStateSource();
+
+    // Procedural samples produced at a fixed rate (in Hz).
+    std::unique_ptr<BodyStateSource> CreateSyntheticBodyStateSource(uint32_t parts, double rate);
+
+    // Forward the samples of another source while appending them (timestamped) to a recording file.
+    std::unique_ptr<BodyStateSource> CreateBodyStateRecorder(std::unique_ptr<BodyStateSource> source,
+                                                             const std::filesystem::path& path);
+
+    // Play back a recording file with the original pacing scaled by speed (0 means as fast as possible). Returns
+    // nullptr if the file cannot be loaded.
+    std::unique_ptr<BodyStateSource> CreateBodyStateReplayer(const std::filesystem::path& path,
+                                                             double speed,
+                                                             bool loop);
+
+} // namespace virtualdesktop_openxr::BodyTracking
@@ -0,0 +1,378 @@
+// MIT License
+//
+// Copyright(c) 2025 Microsoft Corp.
+// Initial implementation by Matthieu Bucchianeri, Jonas Holderman and Heather Kemp.
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+
+#include "core.h"
+
+#include "BodyState.h"
+#include "body_state_source.h"
+
+// Implements the procedural generation of body state samples. This file only depends on the portable core (see core.h),
+// so that it is also built and tested outside of the Visual Studio solution.
+
+namespace {
+
+    using namespace virtualdesktop_openxr::BodyTracking;
+
+    static constexpr XrSpaceLocationFlags k_FullyTracked =
+        XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT |
+        XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+
+    // Minimal math on the Virtual Desktop types, so that the generator does not depend on any other library.
+
+    Quaternion Multiply(const Quaternion& a, const Quaternion& b) {
+        return {a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+                a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z};
+    }
+
+    Vector3 Rotate(const Quaternion& q, const Vector3& v) {
+        // v' = v + 2w(u x v) + 2u x (u x v)
+        const Vector3 t{2 * (q.y * v.z - q.z * v.y), 2 * (q.z * v.x - q.x * v.z), 2 * (q.x * v.y - q.y * v.x)};
+        return {v.x + q.w * t.x + (q.y * t.z - q.z * t.y),
+                v.y + q.w * t.y + (q.z * t.x - q.x * t.z),
+                v.z + q.w * t.z + (q.x * t.y - q.y * t.x)};
+    }
+
+    Vector3 Add(const Vector3& a, const Vector3& b) {
+        return {a.x + b.x, a.y + b.y, a.z + b.z};
+    }
+
+    Vector3 Subtract(const Vector3& a, const Vector3& b) {
+        return {a.x - b.x, a.y - b.y, a.z - b.z};
+    }
+
+    Quaternion AxisAngle(const Vector3& axis, float angle) {
+        const float s = std::sin(angle / 2);
+        return {axis.x * s, axis.y * s, axis.z * s, std::cos(angle / 2)};
+    }
+
+    Pose Multiply(const Pose& parent, const Pose& local) {
+        return {Multiply(parent.orientation, local.orientation),
+                Add(parent.position, Rotate(parent.orientation, local.position))};
+    }
+
+    static constexpr Quaternion k_Identity{0, 0, 0, 1};
+    static constexpr Vector3 k_AxisX{1, 0, 0};
+    static constexpr Vector3 k_AxisY{0, 1, 0};
+    static constexpr Vector3 k_AxisZ{0, 0, 1};
+    static constexpr float k_Pi = 3.14159265f;
+
+    // Deterministic hash in [0, 1) used to vary the animation.
+    float Noise(uint32_t seed) {
+        seed ^= seed >> 16;
+        seed *= 0x7feb352d;
+        seed ^= seed >> 15;
+        seed *= 0x846ca68b;
+        seed ^= seed >> 16;
+        return (seed >> 8) / float(1 << 24);
+    }
+
+    // The rest pose of the body (not including the fingers), standing at the origin and facing -Z, with the forearms
+    // held forward.
+    struct RestJoint {
+        int32_t joint;
+        int32_t parent;
+        Vector3 position;
+    };
+
+    // clang-format off
+    static constexpr RestJoint k_RestBody[] = {
+        {XR_FULL_BODY_JOINT_ROOT_META, XR_FULL_BODY_JOINT_NONE_META, {0.f, 0.f, 0.f}},
+        {XR_FULL_BODY_JOINT_HIPS_META, XR_FULL_BODY_JOINT_ROOT_META, {0.f, 0.95f, 0.f}},
+        {XR_FULL_BODY_JOINT_SPINE_LOWER_META, XR_FULL_BODY_JOINT_HIPS_META, {0.f, 1.05f, 0.f}},
+        {XR_FULL_BODY_JOINT_SPINE_MIDDLE_META, XR_FULL_BODY_JOINT_SPINE_LOWER_META, {0.f, 1.15f, 0.f}},
+        {XR_FULL_BODY_JOINT_SPINE_UPPER_META, XR_FULL_BODY_JOINT_SPINE_MIDDLE_META, {0.f, 1.25f, 0.f}},
+        {XR_FULL_BODY_JOINT_CHEST_META, XR_FULL_BODY_JOINT_SPINE_UPPER_META, {0.f, 1.35f, 0.f}},
+        {XR_FULL_BODY_JOINT_NECK_META, XR_FULL_BODY_JOINT_CHEST_META, {0.f, 1.5f, 0.f}},
+        {XR_FULL_BODY_JOINT_HEAD_META, XR_FULL_BODY_JOINT_NECK_META, {0.f, 1.62f, 0.f}},
+        {XR_FULL_BODY_JOINT_LEFT_SHOULDER_META, XR_FULL_BODY_JOINT_CHEST_META, {-0.05f, 1.45f, 0.f}},
+        {XR_FULL_BODY_JOINT_LEFT_SCAPULA_META, XR_FULL_BODY_JOINT_LEFT_SHOULDER_META, {-0.1f, 1.42f, 0.03f}},
+        {XR_FULL_BODY_JOINT_LEFT_ARM_UPPER_META, XR_FULL_BODY_JOINT_LEFT_SCAPULA_META, {-0.18f, 1.42f, 0.f}},
+        {XR_FULL_BODY_JOINT_LEFT_ARM_LOWER_META, XR_FULL_BODY_JOINT_LEFT_ARM_UPPER_META, {-0.2f, 1.15f, -0.02f}},
+        {XR_FULL_BODY_JOINT_LEFT_HAND_WRIST_TWIST_META, XR_FULL_BODY_JOINT_LEFT_ARM_LOWER_META, {-0.2f, 1.1f, -0.2f}},
+        {XR_FULL_BODY_JOINT_LEFT_HAND_WRIST_META, XR_FULL_BODY_JOINT_LEFT_ARM_LOWER_META, {-0.2f, 1.08f, -0.28f}},
+        {XR_FULL_BODY_JOINT_RIGHT_SHOULDER_META, XR_FULL_BODY_JOINT_CHEST_META, {0.05f, 1.45f, 0.f}},
+        {XR_FULL_BODY_JOINT_RIGHT_SCAPULA_META, XR_FULL_BODY_JOINT_RIGHT_SHOULDER_META, {0.1f, 1.42f, 0.03f}},
+        {XR_FULL_BODY_JOINT_RIGHT_ARM_UPPER_META, XR_FULL_BODY_JOINT_RIGHT_SCAPULA_META, {0.18f, 1.42f, 0.f}},
+        {XR_FULL_BODY_JOINT_RIGHT_ARM_LOWER_META, XR_FULL_BODY_JOINT_RIGHT_ARM_UPPER_META, {0.2f, 1.15f, -0.02f}},
+        {XR_FULL_BODY_JOINT_RIGHT_HAND_WRIST_TWIST_META, XR_FULL_BODY_JOINT_RIGHT_ARM_LOWER_META, {0.2f, 1.1f, -0.2f}},
+        {XR_FULL_BODY_JOINT_RIGHT_HAND_WRIST_META, XR_FULL_BODY_JOINT_RIGHT_ARM_LOWER_META, {0.2f, 1.08f, -0.28f}},
+        {XR_FULL_BODY_JOINT_LEFT_UPPER_LEG_META, XR_FULL_BODY_JOINT_HIPS_META, {-0.1f, 0.9f, 0.f}},
+        {XR_FULL_BODY_JOINT_LEFT_LOWER_LEG_META, XR_FULL_BODY_JOINT_LEFT_UPPER_LEG_META, {-0.1f, 0.5f, 0.f}},
+        {XR_FULL_BODY_JOINT_LEFT_FOOT_ANKLE_TWIST_META, XR_FULL_BODY_JOINT_LEFT_LOWER_LEG_META, {-0.1f, 0.1f, 0.f}},
+        {XR_FULL_BODY_JOINT_LEFT_FOOT_ANKLE_META, XR_FULL_BODY_JOINT_LEFT_FOOT_ANKLE_TWIST_META, {-0.1f, 0.08f, 0.f}},
+        {XR_FULL_BODY_JOINT_LEFT_FOOT_SUBTALAR_META, XR_FULL_BODY_JOINT_LEFT_FOOT_ANKLE_META, {-0.1f, 0.04f, 0.02f}},
+        {XR_FULL_BODY_JOINT_LEFT_FOOT_TRANSVERSE_META, XR_FULL_BODY_JOINT_LEFT_FOOT_SUBTALAR_META,
+         {-0.1f, 0.04f, -0.05f}},
+        {XR_FULL_BODY_JOINT_LEFT_FOOT_BALL_META, XR_FULL_BODY_JOINT_LEFT_FOOT_TRANSVERSE_META, {-0.1f, 0.02f, -0.12f}},
+        {XR_FULL_BODY_JOINT_RIGHT_UPPER_LEG_META, XR_FULL_BODY_JOINT_HIPS_META, {0.1f, 0.9f, 0.f}},
+        {XR_FULL_BODY_JOINT_RIGHT_LOWER_LEG_META, XR_FULL_BODY_JOINT_RIGHT_UPPER_LEG_META, {0.1f, 0.5f, 0.f}},
+        {XR_FULL_BODY_JOINT_RIGHT_FOOT_ANKLE_TWIST_META, XR_FULL_BODY_JOINT_RIGHT_LOWER_LEG_META, {0.1f, 0.1f, 0.f}},
+        {XR_FULL_BODY_JOINT_RIGHT_FOOT_ANKLE_META, XR_FULL_BODY_JOINT_RIGHT_FOOT_ANKLE_TWIST_META, {0.1f, 0.08f, 0.f}},
+        {XR_FULL_BODY_JOINT_RIGHT_FOOT_SUBTALAR_META, XR_FULL_BODY_JOINT_RIGHT_FOOT_ANKLE_META, {0.1f, 0.04f, 0.02f}},
+        {XR_FULL_BODY_JOINT_RIGHT_FOOT_TRANSVERSE_META, XR_FULL_BODY_JOINT_RIGHT_FOOT_SUBTALAR_META,
+         {0.1f, 0.04f, -0.05f}},
+        {XR_FULL_BODY_JOINT_RIGHT_FOOT_BALL_META, XR_FULL_BODY_JOINT_RIGHT_FOOT_TRANSVERSE_META, {0.1f, 0.02f, -0.12f}},
+    };
+    // clang-format on
+
+    // The rest pose of the fingers of the left hand, relative to the wrist (fingers pointing -Z, back of the hand +Y).
+    // The right hand is mirrored. Each finger is a chain from its metacarpal to its tip.
+    struct RestFinger {
+        int32_t firstJoint;
+        int32_t jointCount;
+        Vector3 positions[5];
+    };
+
+    // clang-format off
+    static constexpr RestFinger k_RestFingers[] = {
+        {XR_HAND_JOINT_THUMB_METACARPAL_EXT, 4,
+         {{0.02f, -0.01f, -0.02f}, {0.035f, -0.01f, -0.05f}, {0.045f, -0.01f, -0.08f}, {0.05f, -0.01f, -0.105f}}},
+        {XR_HAND_JOINT_INDEX_METACARPAL_EXT, 5,
+         {{0.01f, 0.f, -0.02f}, {0.02f, 0.f, -0.085f}, {0.022f, 0.f, -0.125f}, {0.023f, 0.f, -0.15f},
+          {0.024f, 0.f, -0.17f}}},
+        {XR_HAND_JOINT_MIDDLE_METACARPAL_EXT, 5,
+         {{0.f, 0.f, -0.02f}, {0.f, 0.f, -0.09f}, {0.f, 0.f, -0.135f}, {0.f, 0.f, -0.163f}, {0.f, 0.f, -0.185f}}},
+        {XR_HAND_JOINT_RING_METACARPAL_EXT, 5,
+         {{-0.01f, 0.f, -0.02f}, {-0.02f, 0.f, -0.085f}, {-0.022f, 0.f, -0.125f}, {-0.023f, 0.f, -0.15f},
+          {-0.024f, 0.f, -0.17f}}},
+        {XR_HAND_JOINT_LITTLE_METACARPAL_EXT, 5,
+         {{-0.018f, 0.f, -0.02f}, {-0.036f, 0.f, -0.075f}, {-0.038f, 0.f, -0.105f}, {-0.039f, 0.f, -0.125f},
+          {-0.04f, 0.f, -0.14f}}},
+    };
+    // clang-format on
+
+    // Offset of the hand joints within the full body joints.
+    static constexpr int32_t k_BodyHandJointOffset[] = {XR_FULL_BODY_JOINT_LEFT_HAND_PALM_META,
+                                                        XR_FULL_BODY_JOINT_RIGHT_HAND_PALM_META};
+    static_assert(XR_FULL_BODY_JOINT_LEFT_HAND_WRIST_META - XR_FULL_BODY_JOINT_LEFT_HAND_PALM_META ==
+                  XR_HAND_JOINT_WRIST_EXT);
+    static_assert(XR_FULL_BODY_JOINT_LEFT_HAND_LITTLE_TIP_META - XR_FULL_BODY_JOINT_LEFT_HAND_PALM_META ==
+                  XR_HAND_JOINT_LITTLE_TIP_EXT);
+
+    // Slow breathing sway of the torso and swing of the arms and legs.
+    void SynthesizeSkeleton(double time, Pose (&joints)[FullBodyJointCount]) {
+        const float phase = float(2 * k_Pi * 0.25 * time);
+
+        Quaternion local[FullBodyJointCount];
+        std::fill(std::begin(local), std::end(local), k_Identity);
+        local[XR_FULL_BODY_JOINT_SPINE_LOWER_META] = AxisAngle(k_AxisY, 0.15f * std::sin(phase));
+        local[XR_FULL_BODY_JOINT_NECK_META] = AxisAngle(k_AxisX, 0.1f * std::sin(2 * phase));
+        local[XR_FULL_BODY_JOINT_LEFT_ARM_UPPER_META] = AxisAngle(k_AxisX, 0.2f * std::sin(phase));
+        local[XR_FULL_BODY_JOINT_RIGHT_ARM_UPPER_META] = AxisAngle(k_AxisX, -0.2f * std::sin(phase));
+        local[XR_FULL_BODY_JOINT_LEFT_ARM_LOWER_META] = AxisAngle(k_AxisZ, -0.3f * std::sin(2 * phase));
+        local[XR_FULL_BODY_JOINT_RIGHT_ARM_LOWER_META] = AxisAngle(k_AxisZ, 0.3f * std::sin(2 * phase));
+        local[XR_FULL_BODY_JOINT_LEFT_UPPER_LEG_META] = AxisAngle(k_AxisX, -0.1f * std::sin(phase));
+        local[XR_FULL_BODY_JOINT_RIGHT_UPPER_LEG_META] = AxisAngle(k_AxisX, 0.1f * std::sin(phase));
+
+        Vector3 rest[FullBodyJointCount]{};
+        for (const auto& joint : k_RestBody) {
+            rest[joint.joint] = joint.position;
+        }
+
+        // The table is ordered parents first.
+        for (const auto& joint : k_RestBody) {
+            if (joint.parent == XR_FULL_BODY_JOINT_NONE_META) {
+                joints[joint.joint] = {local[joint.joint],
+                                       {0.03f * std::sin(phase), 0.f, 0.02f * std::cos(phase)}};
+            } else {
+                joints[joint.joint] = Multiply(
+                    joints[joint.parent],
+                    Pose{local[joint.joint], Subtract(joint.position, rest[joint.parent])});
+            }
+        }
+    }
+
+    // Fingers opening and closing out of phase from each other, from the wrist pose computed for the body.
+    void SynthesizeHand(double time, uint32_t side, const Pose& wrist, FingerJointState (&joints)[HandJointCount]) {
+        const float mirror = side == 0 ? 1.f : -1.f;
+
+        joints[XR_HAND_JOINT_WRIST_EXT] = {};
+        joints[XR_HAND_JOINT_WRIST_EXT].Pose = wrist;
+        joints[XR_HAND_JOINT_WRIST_EXT].Radius = 0.016f;
+
+        for (uint32_t finger = 0; finger < std::size(k_RestFingers); finger++) {
+            const auto& rest = k_RestFingers[finger];
+            const float curl =
+                0.4f * (1 - std::cos(float(2 * k_Pi * 0.5 * time) + finger * 0.6f + side * k_Pi)) / 2;
+
+            Pose local{k_Identity, {mirror * rest.positions[0].x, rest.positions[0].y, rest.positions[0].z}};
+            for (int32_t i = 0; i < rest.jointCount; i++) {
+                if (i > 0) {
+                    const Vector3 bone = Subtract(rest.positions[i], rest.positions[i - 1]);
+                    local.position =
+                        Add(local.position, Rotate(local.orientation, {mirror * bone.x, bone.y, bone.z}));
+                    local.orientation = Multiply(local.orientation, AxisAngle(k_AxisX, -curl));
+                }
+
+                auto& joint = joints[rest.firstJoint + i];
+                joint = {};
+                joint.Pose = Multiply(wrist, local);
+                joint.Radius = i < 2 ? 0.016f : 0.008f;
+            }
+        }
+
+        // Palm is between the middle metacarpal and proximal.
+        const auto& metacarpal = joints[XR_HAND_JOINT_MIDDLE_METACARPAL_EXT].Pose;
+        const auto& proximal = joints[XR_HAND_JOINT_MIDDLE_PROXIMAL_EXT].Pose;
+        joints[XR_HAND_JOINT_PALM_EXT] = {};
+        joints[XR_HAND_JOINT_PALM_EXT].Pose = {metacarpal.orientation,
+                                               {(metacarpal.position.x + proximal.position.x) / 2,
+                                                (metacarpal.position.y + proximal.position.y) / 2,
+                                                (metacarpal.position.z + proximal.position.z) / 2}};
+        joints[XR_HAND_JOINT_PALM_EXT].Radius = 0.016f;
+    }
+
+    // Pinches every 4s, alternating hands.
+    void SynthesizeAim(double time,
+                       uint32_t side,
+                       const FingerJointState (&joints)[HandJointCount],
+                       HandTrackingAimState& aim) {
+        const float pinch = std::clamp(
+            1.25f * (1 - std::cos(float(2 * k_Pi * 0.25 * time) + side * k_Pi)) / 2 - 0.25f, 0.f, 1.f);
+
+        aim = {};
+        aim.AimStatus = XR_HAND_TRACKING_AIM_COMPUTED_BIT_FB | XR_HAND_TRACKING_AIM_VALID_BIT_FB;
+        if (pinch >= 0.9f) {
+            aim.AimStatus |= XR_HAND_TRACKING_AIM_INDEX_PINCHING_BIT_FB;
+        }
+        aim.AimPose = joints[XR_HAND_JOINT_PALM_EXT].Pose;
+        aim.PinchStrengthIndex = pinch;
+    }
+
+    // Fixations on pseudo-random targets, with a saccade every 400ms.
+    void SynthesizeEyes(double time, BodyStateV2& state) {
+        static constexpr double FixationDuration = 0.4;
+        const uint32_t fixation = uint32_t(time / FixationDuration);
+        const float yaw = (Noise(2 * fixation) - 0.5f) * 0.6f;
+        const float pitch = (Noise(2 * fixation + 1) - 0.5f) * 0.4f;
+        const Quaternion gaze = Multiply(AxisAngle(k_AxisY, yaw), AxisAngle(k_AxisX, pitch));
+
+        state.LeftEyeIsValid = state.RightEyeIsValid = 1;
+        state.LeftEyePose = {gaze, {-0.032f, 0.f, 0.f}};
+        state.RightEyePose = {gaze, {0.032f, 0.f, 0.f}};
+        state.LeftEyeConfidence = state.RightEyeConfidence = 1.f;
+    }
+
+    // Low amplitude expressions, with a blink every 4s.
+    void SynthesizeFace(double time, BodyStateV2& state) {
+        for (uint32_t i = 0; i < ExpressionCount; i++) {
+            state.ExpressionWeights[i] =
+                0.15f * (1 + std::sin(float(2 * k_Pi * (0.2 + 0.01 * i) * time) + Noise(i) * 2 * k_Pi));
+        }
+        const bool blink = std::fmod(time, 4.0) < 0.15;
+        state.ExpressionWeights[XR_FACE_EXPRESSION2_EYES_CLOSED_L_FB] =
+            state.ExpressionWeights[XR_FACE_EXPRESSION2_EYES_CLOSED_R_FB] = blink ? 1.f : 0.f;
+        for (uint32_t i = 0; i < ConfidenceCount; i++) {
+            state.ExpressionConfidences[i] = 1.f;
+        }
+        state.FaceIsValid = 1;
+        state.IsEyeFollowingBlendshapesValid = 1;
+    }
+
+} // namespace
+
+namespace virtualdesktop_openxr::BodyTracking {
+
+    void Synthesize(double time, uint32_t parts, BodyStateV2& state) {
+        if (parts & (SyntheticHands | SyntheticBody)) {
+            Pose skeleton[FullBodyJointCount]{};
+            SynthesizeSkeleton(time, skeleton);
+
+            FingerJointState hands[2][HandJointCount];
+            for (uint32_t side = 0; side < 2; side++) {
+                SynthesizeHand(time,
+                               side,
+                               skeleton[k_BodyHandJointOffset[side] + XR_HAND_JOINT_WRIST_EXT],
+                               hands[side]);
+            }
+
+            if (parts & SyntheticHands) {
+                state.LeftHandActive = state.RightHandActive = 1;
+                std::copy(std::begin(hands[0]), std::end(hands[0]), state.LeftHandJointStates);
+                std::copy(std::begin(hands[1]), std::end(hands[1]), state.RightHandJointStates);
+                SynthesizeAim(time, 0, hands[0], state.LeftAimState);
+                SynthesizeAim(time, 1, hands[1], state.RightAimState);
+            }
+
+            if (parts & SyntheticBody) {
+                for (uint32_t side = 0; side < 2; side++) {
+                    for (uint32_t i = 0; i < HandJointCount; i++) {
+                        skeleton[k_BodyHandJointOffset[side] + i] = hands[side][i].Pose;
+                    }
+                }
+
+                state.BodyTrackingCalibrated = 1;
+                state.BodyTrackingHighFidelity = 1;
+                state.BodyTrackingConfidence = 1.f;
+                for (uint32_t i = 0; i < FullBodyJointCount; i++) {
+                    state.BodyJoints[i].LocationFlags = k_FullyTracked;
+                    state.BodyJoints[i].Pose = skeleton[i];
+                }
+
+                // The skeleton is the rest pose, which never changes. We only fill it into a fresh state.
+                if (!state.SkeletonChangedCount) {
+                    Pose rest[FullBodyJointCount]{};
+                    SynthesizeSkeleton(0, rest);
+                    FingerJointState restHands[2][HandJointCount];
+                    for (uint32_t side = 0; side < 2; side++) {
+                        SynthesizeHand(
+                            0, side, rest[k_BodyHandJointOffset[side] + XR_HAND_JOINT_WRIST_EXT], restHands[side]);
+                        for (uint32_t i = 0; i < HandJointCount; i++) {
+                            rest[k_BodyHandJointOffset[side] + i] = restHands[side][i].Pose;
+                        }
+                    }
+
+                    for (uint32_t i = 0; i < FullBodyJointCount; i++) {
+                        state.SkeletonJoints[i] = {(int32_t)i, XR_FULL_BODY_JOINT_ROOT_META, rest[i]};
+                    }
+                    for (const auto& joint : k_RestBody) {
+                        state.SkeletonJoints[joint.joint].ParentJoint = joint.parent;
+                    }
+                    for (uint32_t side = 0; side < 2; side++) {
+                        const int32_t palm = k_BodyHandJointOffset[side];
+                        const int32_t wrist = palm + XR_HAND_JOINT_WRIST_EXT;
+                        state.SkeletonJoints[palm].ParentJoint = wrist;
+                        for (const auto& finger : k_RestFingers) {
+                            for (int32_t i = 0; i < finger.jointCount; i++) {
+                                state.SkeletonJoints[palm + finger.firstJoint + i].ParentJoint =
+                                    i == 0 ? wrist : palm + finger.firstJoint + i - 1;
+                            }
+                        }
+                    }
+                    state.SkeletonChangedCount = 1;
+                }
+            }
+        }
+
+        if (parts & SyntheticEyes) {
+            SynthesizeEyes(time, state);
+        }
+
+        if (parts & SyntheticFace) {
+            SynthesizeFace(time, state);
+        }
+    }
+
+} // namespace virtualdesktop_openxr::BodyTracking
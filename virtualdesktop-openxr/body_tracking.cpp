@@ -167,7 +167,7 @@ namespace virtualdesktop_openxr {
             std::shared_lock lock(m_bodyStateMutex);
 
             // Check the hand state.
-            if (m_bodyState && m_cachedBodyState.BodyTrackingConfidence > 0.f) {
+            if (m_bodyStateSource && m_cachedBodyState.BodyTrackingConfidence > 0.f) {
                 const BodyTracking::BodyJointLocation* const joints = m_cachedBodyState.BodyJoints;
 
                 TraceLoggingWrite(
@@ -287,8 +287,8 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
-        // Forward the state from the memory mapped file.
-        if (m_bodyState) {
+        // Forward the state from the body state source.
+        if (m_bodyStateSource) {
             std::shared_lock lock(m_bodyStateMutex);
 
             for (uint32_t i = 0; i < skeleton->jointCount; i++) {
@@ -145,7 +145,6 @@ namespace virtualdesktop_openxr {
         CHECK_HRCMD(m_ovrSubmissionFence->CreateSharedHandle(nullptr, GENERIC_ALL, nullptr, fenceHandle.put()));
         CHECK_HRCMD(
             m_d3d11Device->OpenSharedFence(fenceHandle.get(), IID_PPV_ARGS(m_d3d11Fence.ReleaseAndGetAddressOf())));
-        *m_eventForSubmissionFence.put() = CreateEventEx(nullptr, L"Submission Fence", 0, EVENT_ALL_ACCESS);
 
         // Frame timers.
         for (uint32_t i = 0; i < k_numGpuTimers; i++) {
@@ -213,6 +212,16 @@ namespace virtualdesktop_openxr {
         // Create the synchronization fence to serialize work between the application device and submission device.
         CHECK_HRCMD(m_ovrSubmissionDevice->CreateFence(
             0, D3D11_FENCE_FLAG_SHARED, IID_PPV_ARGS(m_ovrSubmissionFence.ReleaseAndGetAddressOf())));
+        // The events and timers for the blocking waits on fences are reused, rather than creating them for every wait.
+        // The timers are high-resolution when supported, since the CPU wait budget is below the scheduler tick.
+        for (uint32_t i = 0; i < (uint32_t)sync::WaitSite::Count; i++) {
+            *m_eventForFenceWait[i].put() = CreateEventEx(nullptr, nullptr, 0, EVENT_ALL_ACCESS);
+            *m_timerForFenceWait[i].put() =
+                CreateWaitableTimerEx(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+            if (!m_timerForFenceWait[i]) {
+                *m_timerForFenceWait[i].put() = CreateWaitableTimerEx(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+            }
+        }
         m_fenceValue = 0;
 
         // Create the resources for pre-processing.
@@ -275,6 +284,8 @@ namespace virtualdesktop_openxr {
             m_gpuTimerPrecomposition[i] =
                 std::make_unique<D3D11GpuTimer>(m_ovrSubmissionDevice.Get(), m_ovrSubmissionContext.Get());
         }
+        m_gpuProfiler = std::make_unique<D3D11GpuProfiler>(
+            m_ovrSubmissionDevice.Get(), m_ovrSubmissionContext.Get(), k_numGpuTimers, m_gpuProfilerStatistics);
 
         // If RenderDoc is loaded, then create a DXGI swapchain to signal events. Otherwise RenderDoc will
         // not see our OpenXR frames.
@@ -322,10 +333,48 @@ namespace virtualdesktop_openxr {
     void OpenXrRuntime::cleanupSubmissionDevice() {
         flushSubmissionContext();
 
+        for (uint32_t i = 0; i < (uint32_t)sync::WaitSite::Count; i++) {
+            const auto& statistics = m_waitStatistics[i];
+            if (statistics.count) {
+                TraceLoggingWrite(g_traceProvider,
+                                  "WaitStatistics",
+                                  TLArg(sync::ToString((sync::WaitSite)i), "Site"),
+                                  TLArg(statistics.count, "Count"),
+                                  TLArg(statistics.timeouts, "Timeouts"),
+                                  TLArg(statistics.totalUs, "TotalUs"),
+                                  TLArg(statistics.maxUs, "MaxUs"));
+                Log("Blocking waits in %s: %llu (%llu timeouts), %.3f ms total, %.3f ms max\n",
+                    sync::ToString((sync::WaitSite)i),
+                    statistics.count,
+                    statistics.timeouts,
+                    statistics.totalUs / 1000.0,
+                    statistics.maxUs / 1000.0);
+            }
+            m_waitStatistics[i] = {};
+        }
+
         for (uint32_t i = 0; i < k_numGpuTimers; i++) {
             m_gpuTimerPrecomposition[i].reset();
         }
 
+        for (const auto& [path, statistics] : m_gpuProfilerStatistics.snapshot()) {
+            TraceLoggingWrite(g_traceProvider,
+                              "GpuProfiler_Summary",
+                              TLArg(path.c_str(), "Scope"),
+                              TLArg(statistics.count, "Count"),
+                              TLArg(statistics.averageUs, "AverageUs"),
+                              TLArg(statistics.minUs, "MinUs"),
+                              TLArg(statistics.maxUs, "MaxUs"));
+            Log("GPU scope %s: %llu samples, %llu us avg, %llu us min, %llu us max\n",
+                path.c_str(),
+                statistics.count,
+                statistics.averageUs,
+                statistics.minUs,
+                statistics.maxUs);
+        }
+        m_gpuProfilerStatistics.reset();
+        m_gpuProfiler.reset();
+
         m_dxgiSwapchain.Reset();
         m_fullQuadVS.Reset();
         m_resolveMultisampledDepthPS.Reset();
@@ -334,7 +383,13 @@ namespace virtualdesktop_openxr {
         m_alphaCorrectConstants.Reset();
         m_sharpenShader.Reset();
         m_upscaleShader.Reset();
+        m_downsampleShader.Reset();
         m_upscalerConstants.Reset();
+        for (uint32_t i = 0; i < xr::StereoView::Count; i++) {
+            m_visibilityTileMask[i] = {};
+        }
+        m_quadViewsShader.Reset();
+        m_quadViewsConstants.Reset();
         m_linearClampSampler.Reset();
         m_pointClampSampler.Reset();
         m_noDepthReadState.Reset();
@@ -343,7 +398,10 @@ namespace virtualdesktop_openxr {
         m_ovrSubmissionContextState.Reset();
         m_ovrSubmissionContext.Reset();
         m_ovrSubmissionDevice.Reset();
-        m_eventForSubmissionFence.reset();
+        for (uint32_t i = 0; i < (uint32_t)sync::WaitSite::Count; i++) {
+            m_eventForFenceWait[i].reset();
+            m_timerForFenceWait[i].reset();
+        }
     }
 
     // Retrieve generic handles to the swapchain images to import into the application device.
@@ -518,187 +576,269 @@ namespace virtualdesktop_openxr {
                                               uint32_t slice,
                                               std::set<std::pair<Swapchain*, uint32_t>>& resolved,
                                               bool skipCommit) {
-        ensureSwapchainSliceResources(xrSwapchain, slice);
+        resolveSwapchainImages(xrSwapchain, {slice}, resolved, skipCommit);
+    }
 
-        // If the texture was never used or already committed, do nothing.
-        const auto tuple = std::make_pair(&xrSwapchain, slice);
-        if (xrSwapchain.appSwapchain.images.empty() || resolved.count(tuple)) {
+    // Prepare several slices of a swapchain to be used by OVR, recording the GPU work for all of them at once.
+    void OpenXrRuntime::resolveSwapchainImages(Swapchain& xrSwapchain,
+                                               const std::vector<uint32_t>& slices,
+                                               std::set<std::pair<Swapchain*, uint32_t>>& resolved,
+                                               bool skipCommit) {
+        // If the texture was never used, do nothing.
+        if (xrSwapchain.appSwapchain.images.empty()) {
             return;
         }
 
-        const bool needCopy = (slice > 0 || !xrSwapchain.appSwapchain.ovrSwapchain);
-
+        // Remember the first generation resolved this frame, since only that one may be marked as consumed. The
+        // generation is read before the index, so a concurrent release can only make the swapchain stay dirty.
+        const uint64_t releaseGeneration = xrSwapchain.releaseGeneration;
+        m_precompositor.consumedGenerations.emplace(&xrSwapchain, releaseGeneration);
         const int lastReleasedIndex = xrSwapchain.lastReleasedIndex;
+        const bool isDepthBuffer = (xrSwapchain.xrDesc.usageFlags & XR_SWAPCHAIN_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
+        const bool isColorResolve = xrSwapchain.ovrDesc.SampleCount != 1 && !isDepthBuffer;
+        const int32_t width = xrSwapchain.ovrDesc.Width;
+        const int32_t height = xrSwapchain.ovrDesc.Height;
+
+        std::vector<resolve::SliceWork> copies;
+        for (const uint32_t slice : slices) {
+            ensureSwapchainSliceResources(xrSwapchain, slice);
+
+            // If the slice was already committed, do nothing.
+            const auto tuple = std::make_pair(&xrSwapchain, slice);
+            if (resolved.count(tuple)) {
+                continue;
+            }
 
-        TraceLoggingWrite(g_traceProvider,
-                          "ResolveSwapchainImage",
-                          TLArg(lastReleasedIndex, "LastReleasedIndex"),
-                          TLArg(slice, "Slice"),
-                          TLArg(needCopy, "NeedCopy"),
-                          TLArg(skipCommit, "SkipCommit"));
-
-        int ovrDestIndex = -1;
-        while (true) {
-            CHECK_OVRCMD(ovr_GetTextureSwapChainCurrentIndex(
-                m_ovrSession, xrSwapchain.resolvedSlices[slice].ovrSwapchain, &ovrDestIndex));
-
-            // If we can use the swapchain with LibOVR directly (without a copy), then let's commit to the swapchain
-            // until the last committed image matches the last released image index.
-            int ovrCommittedIndex = ovrDestIndex - 1;
-            if (ovrCommittedIndex < 0) {
-                ovrCommittedIndex = xrSwapchain.ovrSwapchainLength - 1;
-            }
-            if (needCopy || skipCommit) {
-                TraceLoggingWrite(g_traceProvider, "ResolveSwapchainImage", TLArg(ovrDestIndex, "DestIndex"));
-                // lastCommittedIndex must be set below.
-                break;
+            const bool needCopy = (slice > 0 || !xrSwapchain.appSwapchain.ovrSwapchain);
+
+            TraceLoggingWrite(g_traceProvider,
+                              "ResolveSwapchainImage",
+                              TLArg(lastReleasedIndex, "LastReleasedIndex"),
+                              TLArg(slice, "Slice"),
+                              TLArg(needCopy, "NeedCopy"),
+                              TLArg(skipCommit, "SkipCommit"));
+
+            int ovrDestIndex = -1;
+            while (true) {
+                CHECK_OVRCMD(ovr_GetTextureSwapChainCurrentIndex(
+                    m_ovrSession, xrSwapchain.resolvedSlices[slice].ovrSwapchain, &ovrDestIndex));
+
+                // If we can use the swapchain with LibOVR directly (without a copy), then let's commit to the
+                // swapchain until the last committed image matches the last released image index.
+                int ovrCommittedIndex = ovrDestIndex - 1;
+                if (ovrCommittedIndex < 0) {
+                    ovrCommittedIndex = xrSwapchain.ovrSwapchainLength - 1;
+                }
+                if (needCopy || skipCommit) {
+                    TraceLoggingWrite(g_traceProvider, "ResolveSwapchainImage", TLArg(ovrDestIndex, "DestIndex"));
+                    // lastCommittedIndex must be set below.
+                    break;
+                }
+                TraceLoggingWrite(
+                    g_traceProvider, "ResolveSwapchainImage_SyncImage", TLArg(ovrCommittedIndex, "CommittedIndex"));
+                if (ovrCommittedIndex == lastReleasedIndex) {
+                    // We still need to commit a static swapchain once!
+                    if (xrSwapchain.ovrSwapchainLength == 1 &&
+                        releaseGeneration != xrSwapchain.consumedGeneration) {
+                        CHECK_OVRCMD(
+                            ovr_CommitTextureSwapChain(m_ovrSession, xrSwapchain.resolvedSlices[slice].ovrSwapchain));
+                    }
+                    xrSwapchain.resolvedSlices[slice].lastCommittedIndex = ovrCommittedIndex;
+                    break;
+                }
+                CHECK_OVRCMD(
+                    ovr_CommitTextureSwapChain(m_ovrSession, xrSwapchain.resolvedSlices[slice].ovrSwapchain));
             }
-            TraceLoggingWrite(
-                g_traceProvider, "ResolveSwapchainImage_SyncImage", TLArg(ovrCommittedIndex, "CommittedIndex"));
-            if (ovrCommittedIndex == lastReleasedIndex) {
-                // We still need to commit a static swapchain once!
-                if (xrSwapchain.ovrSwapchainLength == 1 && xrSwapchain.dirty) {
-                    CHECK_OVRCMD(
-                        ovr_CommitTextureSwapChain(m_ovrSession, xrSwapchain.resolvedSlices[slice].ovrSwapchain));
+
+            if (needCopy) {
+                // Only process the region read by the layers (with a margin for texture filtering), and that the
+                // application updated since the destination image was last written. Resolving MSAA color does not
+                // support regions.
+                resolve::SliceWork work;
+                work.slice = slice;
+                work.destIndex = ovrDestIndex;
+                work.region = {{0, 0}, {width, height}};
+                auto& writtenGeneration = xrSwapchain.resolvedSlices[slice].writtenGenerations[ovrDestIndex];
+                bool isUpToDate = true;
+                if (!isColorResolve) {
+                    const auto it = m_precompositor.resolveRegions.find(tuple);
+                    if (it != m_precompositor.resolveRegions.end()) {
+                        work.region = inflateRect(it->second, 2, width, height);
+                    }
+
+                    std::optional<XrRect2Di> damage;
+                    {
+                        std::unique_lock lock(xrSwapchain.damageHistoryMutex);
+                        damage = xrSwapchain.damageHistory.getDamageSince(writtenGeneration);
+                    }
+                    const XrRect2Di staleRegion = damage.value_or(XrRect2Di{{0, 0}, {width, height}});
+                    const XrRect2Di region = intersectRect(work.region, staleRegion);
+                    isUpToDate = getArea(region) == getArea(staleRegion);
+                    work.region = region;
                 }
-                xrSwapchain.resolvedSlices[slice].lastCommittedIndex = ovrCommittedIndex;
-                break;
+
+                // Otherwise, the parts of the image that are not read by the layers stay stale.
+                if (isUpToDate) {
+                    writtenGeneration = releaseGeneration;
+                }
+                copies.push_back(work);
+            } else if (skipCommit) {
+                xrSwapchain.resolvedSlices[slice].lastCommittedIndex = lastReleasedIndex;
             }
-            CHECK_OVRCMD(ovr_CommitTextureSwapChain(m_ovrSession, xrSwapchain.resolvedSlices[slice].ovrSwapchain));
+
+            resolved.insert(tuple);
         }
 
-        if (needCopy) {
-            const bool isDepthBuffer =
-                (xrSwapchain.xrDesc.usageFlags & XR_SWAPCHAIN_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
-            TraceLoggingWrite(g_traceProvider,
-                              "ResolveSwapchainImage_Copy",
-                              TLArg(xrSwapchain.ovrDesc.SampleCount == 1 ? "None"
-                                    : !isDepthBuffer                     ? "Color"
-                                                                         : "Depth",
-                                    "Resolve"));
-
-            // Circumvent some of OVR's limitations:
-            // - For texture arrays, we must do a copy to slice 0 into another swapchain.
-            // - For MSAA, we must resolve into a non-MSAA swapchain.
-            if (xrSwapchain.ovrDesc.SampleCount == 1) {
+        if (copies.empty()) {
+            return;
+        }
+
+        // Circumvent some of OVR's limitations:
+        // - For texture arrays, we must do a copy to slice 0 into another swapchain.
+        // - For MSAA, we must resolve into a non-MSAA swapchain.
+        const auto batch = resolve::MakeBatch(
+            resolve::SelectOperation(true, xrSwapchain.ovrDesc.SampleCount, isDepthBuffer), std::move(copies));
+        const auto work = batch.work();
+        m_resolvedPixels += batch.pixels();
+        m_resolvablePixels += (uint64_t)width * height * batch.slices.size();
+
+        TraceLoggingWrite(g_traceProvider,
+                          "ResolveSwapchainImage_Copy",
+                          TLArg(resolve::ToString(batch.operation), "Resolve"),
+                          TLArg(batch.slices.size(), "Slices"),
+                          TLArg(work.size(), "Operations"));
+
+        GpuProfilerScope gpuProfilerScope(!work.empty() ? m_gpuProfiler.get() : nullptr,
+                                          resolve::ToString(batch.operation));
+
+        if (batch.operation == resolve::Operation::Copy) {
+            for (const auto* entry : work) {
+                D3D11_BOX box{};
+                box.left = entry->region.offset.x;
+                box.top = entry->region.offset.y;
+                box.right = entry->region.offset.x + entry->region.extent.width;
+                box.bottom = entry->region.offset.y + entry->region.extent.height;
+                box.back = 1;
                 m_ovrSubmissionContext->CopySubresourceRegion(
-                    xrSwapchain.resolvedSlices[slice].images[ovrDestIndex].Get(),
-                    0,
+                    xrSwapchain.resolvedSlices[entry->slice].images[entry->destIndex].Get(),
                     0,
+                    entry->region.offset.x,
+                    entry->region.offset.y,
                     0,
+                    xrSwapchain.appSwapchain.images[lastReleasedIndex].Get(),
+                    entry->slice,
+                    &box);
+            }
+        } else if (batch.operation == resolve::Operation::ResolveColor) {
+            for (const auto* entry : work) {
+                m_ovrSubmissionContext->ResolveSubresource(
+                    xrSwapchain.resolvedSlices[entry->slice].images[entry->destIndex].Get(),
                     0,
                     xrSwapchain.appSwapchain.images[lastReleasedIndex].Get(),
-                    slice,
-                    nullptr);
-            } else {
-                // Resolve MSAA. For depth buffers, this requires a shader.
-                if (!isDepthBuffer) {
-                    m_ovrSubmissionContext->ResolveSubresource(
-                        xrSwapchain.resolvedSlices[slice].images[ovrDestIndex].Get(),
-                        0,
-                        xrSwapchain.appSwapchain.images[lastReleasedIndex].Get(),
-                        slice,
-                        xrSwapchain.dxgiFormatForSubmission);
-                } else {
-                    // We are about to do something destructive to the application context. Save the context. It will be
-                    // restored at the end of xrEndFrame().
-                    if (m_d3d11Device == m_ovrSubmissionDevice && !m_d3d11ContextState) {
-                        m_ovrSubmissionContext->SwapDeviceContextState(m_ovrSubmissionContextState.Get(),
-                                                                       m_d3d11ContextState.ReleaseAndGetAddressOf());
-                    }
-
-                    if ((int)xrSwapchain.appSwapchain.srvs.size() <= lastReleasedIndex) {
-                        xrSwapchain.appSwapchain.srvs.resize(lastReleasedIndex + 1);
-                    }
-                    if (!xrSwapchain.appSwapchain.srvs[lastReleasedIndex]) {
-                        D3D11_SHADER_RESOURCE_VIEW_DESC desc{};
-                        desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DMSARRAY;
-                        desc.Format = getShaderResourceViewFormat(xrSwapchain.dxgiFormatForSubmission);
-                        desc.Texture2DMSArray.ArraySize = xrSwapchain.ovrDesc.ArraySize;
-                        CHECK_HRCMD(m_ovrSubmissionDevice->CreateShaderResourceView(
-                            xrSwapchain.appSwapchain.images[lastReleasedIndex].Get(),
-                            &desc,
-                            xrSwapchain.appSwapchain.srvs[lastReleasedIndex].ReleaseAndGetAddressOf()));
-                        setDebugName(
-                            xrSwapchain.appSwapchain.srvs[lastReleasedIndex].Get(),
-                            fmt::format(
-                                "Runtime Slice SRV[{}, {}, {}]", slice, lastReleasedIndex, (void*)&xrSwapchain));
-                    }
-                    if ((int)xrSwapchain.resolvedSlices[slice].dsvs.size() <= ovrDestIndex) {
-                        xrSwapchain.resolvedSlices[slice].dsvs.resize(ovrDestIndex + 1);
-                    }
-                    if (!xrSwapchain.resolvedSlices[slice].dsvs[ovrDestIndex]) {
-                        D3D11_DEPTH_STENCIL_VIEW_DESC desc{};
-                        desc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
-                        desc.Format = xrSwapchain.dxgiFormatForSubmission;
-                        CHECK_HRCMD(m_ovrSubmissionDevice->CreateDepthStencilView(
-                            xrSwapchain.resolvedSlices[slice].images[ovrDestIndex].Get(),
-                            &desc,
-                            xrSwapchain.resolvedSlices[slice].dsvs[ovrDestIndex].ReleaseAndGetAddressOf()));
-                        setDebugName(
-                            xrSwapchain.resolvedSlices[slice].dsvs[ovrDestIndex].Get(),
-                            fmt::format("Runtime Slice DSV[{}, {}, {}]", slice, ovrDestIndex, (void*)&xrSwapchain));
-                    }
+                    entry->slice,
+                    xrSwapchain.dxgiFormatForSubmission);
+            }
+        } else if (batch.operation == resolve::Operation::ResolveDepth && !work.empty()) {
+            // Resolving MSAA depth requires a shader. The pipeline is set up once for all the slices.
+
+            // We are about to do something destructive to the application context. Save the context. It will be
+            // restored at the end of xrEndFrame().
+            if (m_d3d11Device == m_ovrSubmissionDevice && !m_d3d11ContextState) {
+                m_ovrSubmissionContext->SwapDeviceContextState(m_ovrSubmissionContextState.Get(),
+                                                               m_d3d11ContextState.ReleaseAndGetAddressOf());
+            }
 
-                    m_ovrSubmissionContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+            if ((int)xrSwapchain.appSwapchain.srvs.size() <= lastReleasedIndex) {
+                xrSwapchain.appSwapchain.srvs.resize(lastReleasedIndex + 1);
+            }
+            if (!xrSwapchain.appSwapchain.srvs[lastReleasedIndex]) {
+                D3D11_SHADER_RESOURCE_VIEW_DESC desc{};
+                desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DMSARRAY;
+                desc.Format = getShaderResourceViewFormat(xrSwapchain.dxgiFormatForSubmission);
+                desc.Texture2DMSArray.ArraySize = xrSwapchain.ovrDesc.ArraySize;
+                CHECK_HRCMD(m_ovrSubmissionDevice->CreateShaderResourceView(
+                    xrSwapchain.appSwapchain.images[lastReleasedIndex].Get(),
+                    &desc,
+                    xrSwapchain.appSwapchain.srvs[lastReleasedIndex].ReleaseAndGetAddressOf()));
+                setDebugName(xrSwapchain.appSwapchain.srvs[lastReleasedIndex].Get(),
+                             fmt::format("Runtime Slice SRV[{}, {}]", lastReleasedIndex, (void*)&xrSwapchain));
+            }
 
-                    m_ovrSubmissionContext->VSSetShader(m_fullQuadVS.Get(), nullptr, 0);
-                    m_ovrSubmissionContext->PSSetShader(m_resolveMultisampledDepthPS.Get(), nullptr, 0);
+            m_ovrSubmissionContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+
+            m_ovrSubmissionContext->VSSetShader(m_fullQuadVS.Get(), nullptr, 0);
+            m_ovrSubmissionContext->PSSetShader(m_resolveMultisampledDepthPS.Get(), nullptr, 0);
+            m_ovrSubmissionContext->OMSetDepthStencilState(m_noDepthReadState.Get(), 0xff);
+            m_ovrSubmissionContext->PSSetConstantBuffers(0, 1, m_resolveMultisampledDepthConstants.GetAddressOf());
+            ID3D11SamplerState* sampler[] = {m_pointClampSampler.Get()};
+            m_ovrSubmissionContext->PSSetSamplers(0, 1, sampler);
+            ID3D11ShaderResourceView* SRV[] = {xrSwapchain.appSwapchain.srvs[lastReleasedIndex].Get()};
+            m_ovrSubmissionContext->PSSetShaderResources(0, 1, SRV);
+
+            for (const auto* entry : work) {
+                auto& resolvedSlice = xrSwapchain.resolvedSlices[entry->slice];
+                if ((int)resolvedSlice.dsvs.size() <= entry->destIndex) {
+                    resolvedSlice.dsvs.resize(entry->destIndex + 1);
+                }
+                if (!resolvedSlice.dsvs[entry->destIndex]) {
+                    D3D11_DEPTH_STENCIL_VIEW_DESC desc{};
+                    desc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
+                    desc.Format = xrSwapchain.dxgiFormatForSubmission;
+                    CHECK_HRCMD(m_ovrSubmissionDevice->CreateDepthStencilView(
+                        resolvedSlice.images[entry->destIndex].Get(),
+                        &desc,
+                        resolvedSlice.dsvs[entry->destIndex].ReleaseAndGetAddressOf()));
+                    setDebugName(resolvedSlice.dsvs[entry->destIndex].Get(),
+                                 fmt::format("Runtime Slice DSV[{}, {}, {}]",
+                                             entry->slice,
+                                             entry->destIndex,
+                                             (void*)&xrSwapchain));
+                }
 
-                    m_ovrSubmissionContext->OMSetRenderTargets(
-                        0, nullptr, xrSwapchain.resolvedSlices[slice].dsvs[ovrDestIndex].Get());
-                    D3D11_VIEWPORT viewport{};
-                    viewport.Width = (float)xrSwapchain.ovrDesc.Width;
-                    viewport.Height = (float)xrSwapchain.ovrDesc.Height;
-                    viewport.MaxDepth = 1.f;
-                    m_ovrSubmissionContext->RSSetViewports(1, &viewport);
-                    m_ovrSubmissionContext->OMSetDepthStencilState(m_noDepthReadState.Get(), 0xff);
-                    {
-                        ResolveMultisampledDepthPSConstants constants{};
-                        constants.slice = slice;
-
-                        D3D11_MAPPED_SUBRESOURCE mappedResources;
-                        CHECK_HRCMD(m_ovrSubmissionContext->Map(m_resolveMultisampledDepthConstants.Get(),
-                                                                0,
-                                                                D3D11_MAP_WRITE_DISCARD,
-                                                                0,
-                                                                &mappedResources));
-                        memcpy(mappedResources.pData, &constants, sizeof(constants));
-                        m_ovrSubmissionContext->Unmap(m_resolveMultisampledDepthConstants.Get(), 0);
-                        m_ovrSubmissionContext->PSSetConstantBuffers(
-                            0, 1, m_resolveMultisampledDepthConstants.GetAddressOf());
-                    }
-                    ID3D11SamplerState* sampler[] = {m_pointClampSampler.Get()};
-                    m_ovrSubmissionContext->PSSetSamplers(0, 1, sampler);
-                    ID3D11ShaderResourceView* SRV[] = {xrSwapchain.appSwapchain.srvs[lastReleasedIndex].Get()};
-                    m_ovrSubmissionContext->PSSetShaderResources(0, 1, SRV);
+                m_ovrSubmissionContext->OMSetRenderTargets(0, nullptr, resolvedSlice.dsvs[entry->destIndex].Get());
+                // The shader loads the samples at the pixel position, so the viewport restricts the region.
+                D3D11_VIEWPORT viewport{};
+                viewport.TopLeftX = (float)entry->region.offset.x;
+                viewport.TopLeftY = (float)entry->region.offset.y;
+                viewport.Width = (float)entry->region.extent.width;
+                viewport.Height = (float)entry->region.extent.height;
+                viewport.MaxDepth = 1.f;
+                m_ovrSubmissionContext->RSSetViewports(1, &viewport);
+                {
+                    ResolveMultisampledDepthPSConstants constants{};
+                    constants.slice = entry->slice;
+
+                    D3D11_MAPPED_SUBRESOURCE mappedResources;
+                    CHECK_HRCMD(m_ovrSubmissionContext->Map(
+                        m_resolveMultisampledDepthConstants.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResources));
+                    memcpy(mappedResources.pData, &constants, sizeof(constants));
+                    m_ovrSubmissionContext->Unmap(m_resolveMultisampledDepthConstants.Get(), 0);
+                }
 
-                    m_ovrSubmissionContext->Draw(3, 0);
+                m_ovrSubmissionContext->Draw(3, 0);
+            }
 
-                    // Unbind all resources to avoid D3D validation errors.
-                    {
-                        m_ovrSubmissionContext->OMSetRenderTargets(0, nullptr, nullptr);
-                        m_ovrSubmissionContext->VSSetShader(nullptr, nullptr, 0);
-                        m_ovrSubmissionContext->PSSetShader(nullptr, nullptr, 0);
-                        ID3D11Buffer* nullCBV[] = {nullptr};
-                        m_ovrSubmissionContext->PSSetConstantBuffers(0, 1, nullCBV);
-                        ID3D11SamplerState* nullSampler[] = {nullptr};
-                        m_ovrSubmissionContext->PSSetSamplers(0, 1, nullSampler);
-                        ID3D11ShaderResourceView* nullSRV[] = {nullptr};
-                        m_ovrSubmissionContext->PSGetShaderResources(0, 1, nullSRV);
-                    }
-                }
+            // Unbind all resources to avoid D3D validation errors.
+            {
+                m_ovrSubmissionContext->OMSetRenderTargets(0, nullptr, nullptr);
+                m_ovrSubmissionContext->VSSetShader(nullptr, nullptr, 0);
+                m_ovrSubmissionContext->PSSetShader(nullptr, nullptr, 0);
+                ID3D11Buffer* nullCBV[] = {nullptr};
+                m_ovrSubmissionContext->PSSetConstantBuffers(0, 1, nullCBV);
+                ID3D11SamplerState* nullSampler[] = {nullptr};
+                m_ovrSubmissionContext->PSSetSamplers(0, 1, nullSampler);
+                ID3D11ShaderResourceView* nullSRV[] = {nullptr};
+                m_ovrSubmissionContext->PSGetShaderResources(0, 1, nullSRV);
             }
+        }
 
+        for (const auto& entry : batch.slices) {
             if (!skipCommit) {
-                CHECK_OVRCMD(ovr_CommitTextureSwapChain(m_ovrSession, xrSwapchain.resolvedSlices[slice].ovrSwapchain));
+                CHECK_OVRCMD(
+                    ovr_CommitTextureSwapChain(m_ovrSession, xrSwapchain.resolvedSlices[entry.slice].ovrSwapchain));
             }
-            xrSwapchain.resolvedSlices[slice].lastCommittedIndex = ovrDestIndex;
-        } else if (skipCommit) {
-            xrSwapchain.resolvedSlices[slice].lastCommittedIndex = lastReleasedIndex;
+            xrSwapchain.resolvedSlices[entry.slice].lastCommittedIndex = entry.destIndex;
         }
-
-        resolved.insert(tuple);
     }
 
     // Ensure necessary resources for submission: lazily create a second swapchain for this slice of the array or
@@ -718,76 +858,106 @@ namespace virtualdesktop_openxr {
             // No need for arrays.
             desc.ArraySize = 1;
             populateSwapchainSlice(xrSwapchain, desc, xrSwapchain.resolvedSlices[slice], slice, "Runtime Slice");
+            m_vramBudget.add(vram::Category::ResolvedSlice,
+                             &xrSwapchain,
+                             estimateSwapchainMemory(desc, xrSwapchain.ovrSwapchainLength));
         }
     }
 
+    // The resolution of each eye may differ when the FOV is asymmetric.
     void OpenXrRuntime::ensureSwapchainPrecompositorResources(Swapchain& xrSwapchain,
-                                                              const ovrSizei& resolution) const {
+                                                              const ovrSizei* resolutions) const {
+        bool isAllocated = false;
         for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
-            ovrSizei currentResolution{};
-            if (xrSwapchain.stereoProjection[eye].ovrSwapchain) {
-                ovrTextureSwapChainDesc desc{};
-                CHECK_OVRCMD(
-                    ovr_GetTextureSwapChainDesc(m_ovrSession, xrSwapchain.stereoProjection[eye].ovrSwapchain, &desc));
-                currentResolution.w = desc.Width;
-                currentResolution.h = desc.Height;
+            const auto allocatedMemory = ensurePrecompositorOutputSlice(
+                xrSwapchain, xrSwapchain.stereoProjection[eye], eye, resolutions[eye], "Precompositor");
+            if (allocatedMemory) {
+                xrSwapchain.stereoProjectionMemory[eye] = allocatedMemory.value();
+                isAllocated = true;
             }
+        }
+        if (isAllocated) {
+            m_vramBudget.set(vram::Category::StereoProjection,
+                             &xrSwapchain,
+                             xrSwapchain.stereoProjectionMemory[xr::StereoView::Left] +
+                                 xrSwapchain.stereoProjectionMemory[xr::StereoView::Right]);
+        }
+    }
 
-            if (!xrSwapchain.stereoProjection[eye].ovrSwapchain || currentResolution.w != resolution.w ||
-                currentResolution.h != resolution.h) {
-                if (xrSwapchain.stereoProjection[eye].ovrSwapchain) {
-                    xrSwapchain.stereoProjection[eye].rtvs.clear();
-                    xrSwapchain.stereoProjection[eye].uavs.clear();
-                    ovr_DestroyTextureSwapChain(m_ovrSession, xrSwapchain.stereoProjection[eye].ovrSwapchain);
-                }
+    // (Re)create an OVR swapchain written by the precompositor shaders. Returns the estimated memory of the swapchain
+    // when it was (re)created.
+    std::optional<uint64_t> OpenXrRuntime::ensurePrecompositorOutputSlice(const Swapchain& xrSwapchain,
+                                                                          SwapchainSlice& slice,
+                                                                          uint32_t sliceIndex,
+                                                                          const ovrSizei& resolution,
+                                                                          const char* debugName) const {
+        ovrSizei currentResolution{};
+        if (slice.ovrSwapchain) {
+            ovrTextureSwapChainDesc desc{};
+            CHECK_OVRCMD(ovr_GetTextureSwapChainDesc(m_ovrSession, slice.ovrSwapchain, &desc));
+            currentResolution.w = desc.Width;
+            currentResolution.h = desc.Height;
+        }
 
-                DXGI_FORMAT format;
-                {
-                    ovrTextureSwapChainDesc desc{};
-                    desc.Type = ovrTexture_2D;
-                    desc.ArraySize = 1;
-                    desc.Width = resolution.w;
-                    desc.Height = resolution.h;
-                    desc.MipLevels = 1;
-                    desc.SampleCount = 1;
-                    if (isSRGBFormat((DXGI_FORMAT)xrSwapchain.xrDesc.format)) {
-                        desc.Format = OVR_FORMAT_B8G8R8A8_UNORM_SRGB;
-                        format = DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
-                    } else {
-                        desc.Format = OVR_FORMAT_B8G8R8A8_UNORM;
-                        format = DXGI_FORMAT_B8G8R8A8_UNORM;
-                    }
-                    desc.BindFlags = ovrTextureBind_DX_RenderTarget | ovrTextureBind_DX_UnorderedAccess;
-                    desc.MiscFlags = ovrTextureMisc_DX_Typeless;
-                    populateSwapchainSlice(xrSwapchain, desc, xrSwapchain.stereoProjection[eye], eye, "Precompositor");
-                }
+        if (slice.ovrSwapchain && currentResolution.w == resolution.w && currentResolution.h == resolution.h) {
+            return {};
+        }
 
-                for (uint32_t i = 0; i < xrSwapchain.stereoProjection[eye].images.size(); i++) {
-                    {
-                        D3D11_RENDER_TARGET_VIEW_DESC desc{};
-                        desc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2D;
-                        desc.Format = format;
-                        ComPtr<ID3D11RenderTargetView> rtv;
-                        CHECK_HRCMD(m_ovrSubmissionDevice->CreateRenderTargetView(
-                            xrSwapchain.stereoProjection[eye].images[i].Get(), &desc, rtv.ReleaseAndGetAddressOf()));
-                        setDebugName(rtv.Get(),
-                                     fmt::format("Precompositor RTV [{}, {}, {}]", eye, i, (void*)&xrSwapchain));
-                        xrSwapchain.stereoProjection[eye].rtvs.push_back(std::move(rtv));
-                    }
-                    {
-                        D3D11_UNORDERED_ACCESS_VIEW_DESC desc{};
-                        desc.ViewDimension = D3D11_UAV_DIMENSION_TEXTURE2D;
-                        desc.Format = getUnorderedAccessViewFormat(format);
-                        ComPtr<ID3D11UnorderedAccessView> uav;
-                        CHECK_HRCMD(m_ovrSubmissionDevice->CreateUnorderedAccessView(
-                            xrSwapchain.stereoProjection[eye].images[i].Get(), &desc, uav.ReleaseAndGetAddressOf()));
-                        setDebugName(uav.Get(),
-                                     fmt::format("Precompositor UAV [{}, {}, {}]", eye, i, (void*)&xrSwapchain));
-                        xrSwapchain.stereoProjection[eye].uavs.push_back(std::move(uav));
-                    }
-                }
+        if (slice.ovrSwapchain) {
+            slice.rtvs.clear();
+            slice.uavs.clear();
+            ovr_DestroyTextureSwapChain(m_ovrSession, slice.ovrSwapchain);
+        }
+
+        DXGI_FORMAT format;
+        uint64_t allocatedMemory;
+        {
+            ovrTextureSwapChainDesc desc{};
+            desc.Type = ovrTexture_2D;
+            desc.ArraySize = 1;
+            desc.Width = resolution.w;
+            desc.Height = resolution.h;
+            desc.MipLevels = 1;
+            desc.SampleCount = 1;
+            if (isSRGBFormat((DXGI_FORMAT)xrSwapchain.xrDesc.format)) {
+                desc.Format = OVR_FORMAT_B8G8R8A8_UNORM_SRGB;
+                format = DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
+            } else {
+                desc.Format = OVR_FORMAT_B8G8R8A8_UNORM;
+                format = DXGI_FORMAT_B8G8R8A8_UNORM;
+            }
+            desc.BindFlags = ovrTextureBind_DX_RenderTarget | ovrTextureBind_DX_UnorderedAccess;
+            desc.MiscFlags = ovrTextureMisc_DX_Typeless;
+            populateSwapchainSlice(xrSwapchain, desc, slice, sliceIndex, debugName);
+            allocatedMemory = estimateSwapchainMemory(desc, xrSwapchain.ovrSwapchainLength);
+        }
+
+        for (uint32_t i = 0; i < slice.images.size(); i++) {
+            {
+                D3D11_RENDER_TARGET_VIEW_DESC desc{};
+                desc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2D;
+                desc.Format = format;
+                ComPtr<ID3D11RenderTargetView> rtv;
+                CHECK_HRCMD(m_ovrSubmissionDevice->CreateRenderTargetView(
+                    slice.images[i].Get(), &desc, rtv.ReleaseAndGetAddressOf()));
+                setDebugName(rtv.Get(),
+                             fmt::format("{} RTV [{}, {}, {}]", debugName, sliceIndex, i, (void*)&xrSwapchain));
+                slice.rtvs.push_back(std::move(rtv));
+            }
+            {
+                D3D11_UNORDERED_ACCESS_VIEW_DESC desc{};
+                desc.ViewDimension = D3D11_UAV_DIMENSION_TEXTURE2D;
+                desc.Format = getUnorderedAccessViewFormat(format);
+                ComPtr<ID3D11UnorderedAccessView> uav;
+                CHECK_HRCMD(m_ovrSubmissionDevice->CreateUnorderedAccessView(
+                    slice.images[i].Get(), &desc, uav.ReleaseAndGetAddressOf()));
+                setDebugName(uav.Get(),
+                             fmt::format("{} UAV [{}, {}, {}]", debugName, sliceIndex, i, (void*)&xrSwapchain));
+                slice.uavs.push_back(std::move(uav));
             }
         }
+
+        return allocatedMemory;
     }
 
     void OpenXrRuntime::populateSwapchainSlice(const Swapchain& xrSwapchain,
@@ -803,6 +973,7 @@ namespace virtualdesktop_openxr {
         if (count != xrSwapchain.ovrSwapchainLength) {
             throw std::runtime_error("Swapchain image count mismatch");
         }
+        slice.writtenGenerations.assign(count, 0);
 
         // Query the textures for the swapchain.
         slice.images.clear();
@@ -821,30 +992,26 @@ namespace virtualdesktop_openxr {
     // Flush any pending work in the app context.
     void OpenXrRuntime::flushD3D11Context() {
         if (m_d3d11Context && m_d3d11Fence) {
-            wil::unique_handle eventHandle;
             m_fenceValue++;
             TraceLoggingWrite(
                 g_traceProvider, "FlushContext_Wait", TLArg("D3D11", "Api"), TLArg(m_fenceValue, "FenceValue"));
             CHECK_HRCMD(m_d3d11Context->Signal(m_d3d11Fence.Get(), m_fenceValue));
-            *eventHandle.put() = CreateEventEx(nullptr, L"Flush Fence", 0, EVENT_ALL_ACCESS);
-            CHECK_HRCMD(m_d3d11Fence->SetEventOnCompletion(m_fenceValue, eventHandle.get()));
-            WaitForSingleObject(eventHandle.get(), INFINITE);
-            ResetEvent(eventHandle.get());
+            if (!waitForFence(sync::WaitSite::FlushD3D11Context, m_d3d11Fence.Get(), m_fenceValue)) {
+                waitForFenceEventInfinite(sync::WaitSite::FlushD3D11Context);
+            }
         }
     }
 
     // Flush any pending work in the submission context.
     void OpenXrRuntime::flushSubmissionContext() {
         if (m_ovrSubmissionContext && m_ovrSubmissionFence) {
-            wil::unique_handle eventHandle;
             m_fenceValue++;
             TraceLoggingWrite(
                 g_traceProvider, "FlushContext_Wait", TLArg("D3D11", "Api"), TLArg(m_fenceValue, "FenceValue"));
             CHECK_HRCMD(m_ovrSubmissionContext->Signal(m_ovrSubmissionFence.Get(), m_fenceValue));
-            *eventHandle.put() = CreateEventEx(nullptr, L"Flush Fence", 0, EVENT_ALL_ACCESS);
-            CHECK_HRCMD(m_ovrSubmissionFence->SetEventOnCompletion(m_fenceValue, eventHandle.get()));
-            WaitForSingleObject(eventHandle.get(), INFINITE);
-            ResetEvent(eventHandle.get());
+            if (!waitForFence(sync::WaitSite::FlushSubmissionContext, m_ovrSubmissionFence.Get(), m_fenceValue)) {
+                waitForFenceEventInfinite(sync::WaitSite::FlushSubmissionContext);
+            }
         }
     }
 
@@ -861,15 +1028,119 @@ namespace virtualdesktop_openxr {
     }
 
     void OpenXrRuntime::waitOnSubmissionDevice() {
-        if (!m_syncGpuWorkInEndFrame) {
+        const auto decision = m_syncPolicy.decide(m_ovrSubmissionFence->GetCompletedValue(), m_fenceValue);
+        TraceLoggingWrite(g_traceProvider,
+                          "WaitOnSubmissionDevice",
+                          TLArg((int)decision, "Decision"),
+                          TLArg(m_fenceValue, "FenceValue"));
+
+        bool needGpuWait = decision == sync::WaitDecision::Gpu;
+        if (decision == sync::WaitDecision::Cpu) {
+            const auto budgetUs = m_syncPolicy.getCpuWaitBudgetUs();
+            uint64_t durationUs = 0;
+            const bool completed = waitForFence(sync::WaitSite::EndFrameSync,
+                                                m_ovrSubmissionFence.Get(),
+                                                m_fenceValue,
+                                                budgetUs ? std::optional(budgetUs) : std::nullopt,
+                                                &durationUs);
+            m_syncPolicy.recordCpuWait(durationUs, completed);
+
+            // The application's work is not done yet, let the GPU finish the wait.
+            needGpuWait = !completed;
+        }
+
+        if (needGpuWait) {
             CHECK_HRCMD(m_ovrSubmissionContext->Wait(m_ovrSubmissionFence.Get(), m_fenceValue));
-        } else {
-            CHECK_HRCMD(m_ovrSubmissionFence->SetEventOnCompletion(m_fenceValue, m_eventForSubmissionFence.get()));
-            WaitForSingleObject(m_eventForSubmissionFence.get(), INFINITE);
-            ResetEvent(m_eventForSubmissionFence.get());
         }
     }
 
+    // Block until the fence reaches the value, or until the budget (if any) or the deadline expires.
+    bool OpenXrRuntime::waitForFence(sync::WaitSite site,
+                                     ID3D11Fence* fence,
+                                     uint64_t value,
+                                     std::optional<uint64_t> budgetUs,
+                                     uint64_t* durationUs) {
+        // Clear any signal left over from a previous wait that timed out.
+        const HANDLE event = m_eventForFenceWait[(uint32_t)site].get();
+        ResetEvent(event);
+        CHECK_HRCMD(fence->SetEventOnCompletion(value, event));
+        return waitForFenceEvent(site, value, budgetUs, durationUs, [&]() { return fence->GetCompletedValue(); });
+    }
+
+    bool OpenXrRuntime::waitForFenceEvent(sync::WaitSite site,
+                                          uint64_t value,
+                                          std::optional<uint64_t> budgetUs,
+                                          uint64_t* durationUs,
+                                          const std::function<uint64_t()>& getCompletedValue) {
+        CpuTimer timer;
+        timer.start();
+
+        const auto waitUs = budgetUs.value_or(k_fenceWaitTimeoutUs);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(waitUs);
+        bool completed = getCompletedValue() >= value;
+        if (!completed) {
+            // The millisecond timeout of WaitForMultipleObjects() cannot honor a sub-millisecond budget, so the
+            // deadline is armed on a waitable timer (in 100ns units, negative for relative time).
+            const HANDLE handles[] = {m_eventForFenceWait[(uint32_t)site].get(),
+                                      m_timerForFenceWait[(uint32_t)site].get()};
+            LARGE_INTEGER dueTime;
+            dueTime.QuadPart = -static_cast<LONGLONG>(waitUs * 10);
+            CHECK_MSG(SetWaitableTimer(handles[1], &dueTime, 0, nullptr, nullptr, FALSE), "Failed to arm fence timer");
+
+            while (!completed) {
+                const auto remaining =
+                    std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+                if (remaining.count() <= 0) {
+                    break;
+                }
+                const DWORD result =
+                    WaitForMultipleObjects(2, handles, FALSE, static_cast<DWORD>(remaining.count()));
+                completed = getCompletedValue() >= value;
+                if (result == WAIT_OBJECT_0 + 1) {
+                    break;
+                }
+            }
+            CancelWaitableTimer(handles[1]);
+        }
+
+        timer.stop();
+        const auto elapsedUs = timer.query();
+        if (durationUs) {
+            *durationUs = elapsedUs;
+        }
+
+        // Running out of budget is expected, but missing the deadline means something went wrong.
+        const bool timedOut = !completed && !budgetUs;
+        recordWait(site, elapsedUs, timedOut);
+        if (timedOut) {
+            ErrorLog("Timed out waiting in %s for fence value %llu (completed: %llu)\n",
+                     sync::ToString(site),
+                     value,
+                     getCompletedValue());
+        }
+
+        return completed;
+    }
+
+    // Flushes precede the release of resources, so they cannot give up after the deadline of waitForFence(), which is
+    // only there to report the stall. The event of the site must still be armed by the timed out wait.
+    void OpenXrRuntime::waitForFenceEventInfinite(sync::WaitSite site) {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "WaitForFenceEventInfinite", TLArg(sync::ToString(site), "Site"));
+        CHECK_MSG(WaitForSingleObject(m_eventForFenceWait[(uint32_t)site].get(), INFINITE) == WAIT_OBJECT_0,
+                  "Failed to wait for fence");
+        TraceLoggingWriteStop(local, "WaitForFenceEventInfinite");
+    }
+
+    void OpenXrRuntime::recordWait(sync::WaitSite site, uint64_t durationUs, bool timedOut) {
+        m_waitStatistics[(uint32_t)site].record(durationUs, timedOut);
+        TraceLoggingWrite(g_traceProvider,
+                          "FenceWait",
+                          TLArg(sync::ToString(site), "Site"),
+                          TLArg(durationUs, "DurationUs"),
+                          TLArg(timedOut, "TimedOut"));
+    }
+
     bool OpenXrRuntime::requireNTHandleSharing() const {
         // Intel ARC driver does not support sharing KMT HANDLE to Vulkan/OpenGL.
         return m_gpuVendor == 0x8086 && (m_vkDevice || m_glContext.valid);
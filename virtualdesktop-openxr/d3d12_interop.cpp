@@ -132,9 +132,13 @@ namespace virtualdesktop_openxr {
                                                      IID_PPV_ARGS(m_d3d12CommandList.ReleaseAndGetAddressOf())));
         CHECK_HRCMD(m_d3d12CommandList->Close());
 
-        // Frame timers.
-        for (uint32_t i = 0; i < k_numGpuTimers; i++) {
-            m_gpuTimerApp[i] = std::make_unique<D3D12GpuTimer>(m_d3d12Device.Get(), m_d3d12CommandQueue.Get());
+        // Frame timers. They share a query heap, with spare slots for measurements still in flight when queried.
+        {
+            auto queryPool = std::make_shared<D3D12TimestampQueryPool>(
+                m_d3d12Device.Get(), m_d3d12CommandQueue.Get(), 2 * k_numGpuTimers);
+            for (uint32_t i = 0; i < k_numGpuTimers; i++) {
+                m_gpuTimerApp[i] = std::make_unique<D3D12GpuTimer>(queryPool);
+            }
         }
 
         return XR_SUCCESS;
@@ -248,18 +252,23 @@ namespace virtualdesktop_openxr {
     // Wait for all pending commands to finish.
     void OpenXrRuntime::flushD3D12CommandQueue() {
         if (m_d3d12CommandQueue && m_d3d12Fence) {
-            wil::unique_handle eventHandle;
             m_fenceValue++;
             TraceLoggingWrite(
                 g_traceProvider, "FlushContext_Wait", TLArg("D3D12", "Api"), TLArg(m_fenceValue, "FenceValue"));
             m_d3d12CommandQueue->Signal(m_d3d12Fence.Get(), m_fenceValue);
-            *eventHandle.put() = CreateEventEx(nullptr, L"Flush Fence", 0, EVENT_ALL_ACCESS);
-            CHECK_HRCMD(m_d3d12Fence->SetEventOnCompletion(m_fenceValue, eventHandle.get()));
-            WaitForSingleObject(eventHandle.get(), INFINITE);
-            ResetEvent(eventHandle.get());
+            if (!waitForFence(sync::WaitSite::FlushD3D12CommandQueue, m_d3d12Fence.Get(), m_fenceValue)) {
+                waitForFenceEventInfinite(sync::WaitSite::FlushD3D12CommandQueue);
+            }
         }
     }
 
+    bool OpenXrRuntime::waitForFence(sync::WaitSite site, ID3D12Fence* fence, uint64_t value) {
+        const HANDLE event = m_eventForFenceWait[(uint32_t)site].get();
+        ResetEvent(event);
+        CHECK_HRCMD(fence->SetEventOnCompletion(value, event));
+        return waitForFenceEvent(site, value, {}, nullptr, [&]() { return fence->GetCompletedValue(); });
+    }
+
     // Serialize commands from the D3D12 queue to the D3D11 context used by OVR.
     void OpenXrRuntime::serializeD3D12Frame() {
         m_fenceValue++;
@@ -0,0 +1,136 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+namespace virtualdesktop_openxr::downsampling {
+
+    enum class Filter : uint32_t {
+        None = 0,
+        Box,
+        Lanczos,
+
+        Count
+    };
+
+    static inline const char* ToString(Filter filter) {
+        switch (filter) {
+        case Filter::None:
+            return "None";
+        case Filter::Box:
+            return "Box";
+        case Filter::Lanczos:
+            return "Lanczos";
+        default:
+            return "Unknown";
+        }
+    }
+
+    // The footprint of the filter is bounded, in source pixels from the center. Must match DownsamplingCS.hlsl.
+    constexpr float MaxRadius = 8.f;
+
+    // Half-width of the kernel, in destination pixels.
+    static inline float GetSupport(Filter filter) {
+        return filter == Filter::Lanczos ? 2.f : 0.5f;
+    }
+
+    // Weight of the kernel at a distance in destination pixels. Must match DownsamplingCS.hlsl.
+    static inline float EvaluateKernel(Filter filter, float x) {
+        x = std::abs(x);
+        if (filter == Filter::Box) {
+            return x < 0.5f ? 1.f : 0.f;
+        }
+
+        // Lanczos-2.
+        if (x < 1e-5f) {
+            return 1.f;
+        }
+        if (x >= 2.f) {
+            return 0.f;
+        }
+        const float pix = 3.14159265f * x;
+        return 2.f * std::sin(pix) * std::sin(pix / 2.f) / (pix * pix);
+    }
+
+    struct Tap {
+        int32_t index;
+        float weight;
+    };
+
+    // Compute the normalized weights of the source pixels contributing to a destination pixel along one axis.
+    static inline std::vector<Tap> ComputeTaps(Filter filter, uint32_t destIndex, float scale, int32_t sourceSize) {
+        // Never narrow the kernel below one source pixel (when the destination is larger than the source).
+        const float filterScale = std::max(scale, 1.f);
+        const float center = (destIndex + 0.5f) * scale - 0.5f;
+        const float radius = std::min(GetSupport(filter) * filterScale, MaxRadius);
+        const int32_t first = std::max((int32_t)std::ceil(center - radius), 0);
+        const int32_t last = std::min((int32_t)std::floor(center + radius), sourceSize - 1);
+
+        std::vector<Tap> taps;
+        float total = 0.f;
+        for (int32_t i = first; i <= last; i++) {
+            const float weight = EvaluateKernel(filter, (i - center) / filterScale);
+            if (weight != 0.f) {
+                taps.push_back({i, weight});
+                total += weight;
+            }
+        }
+        if (total != 0.f) {
+            for (auto& tap : taps) {
+                tap.weight /= total;
+            }
+        }
+        return taps;
+    }
+
+    // CPU reference for DownsamplingCS.hlsl, on images of interleaved float channels.
+    static inline void Downsample(Filter filter,
+                                  const float* source,
+                                  uint32_t sourceWidth,
+                                  uint32_t sourceHeight,
+                                  float* dest,
+                                  uint32_t destWidth,
+                                  uint32_t destHeight,
+                                  uint32_t channels = 1) {
+        const float scaleX = (float)sourceWidth / destWidth;
+        const float scaleY = (float)sourceHeight / destHeight;
+        for (uint32_t y = 0; y < destHeight; y++) {
+            const auto tapsY = ComputeTaps(filter, y, scaleY, (int32_t)sourceHeight);
+            for (uint32_t x = 0; x < destWidth; x++) {
+                const auto tapsX = ComputeTaps(filter, x, scaleX, (int32_t)sourceWidth);
+                for (uint32_t c = 0; c < channels; c++) {
+                    float value = 0.f;
+                    for (const auto& tapY : tapsY) {
+                        for (const auto& tapX : tapsX) {
+                            value += tapY.weight * tapX.weight *
+                                     source[(tapY.index * sourceWidth + tapX.index) * channels + c];
+                        }
+                    }
+                    // Lanczos may undershoot.
+                    dest[(y * destWidth + x) * channels + c] = std::max(value, 0.f);
+                }
+            }
+        }
+    }
+
+} // namespace virtualdesktop_openxr::downsampling
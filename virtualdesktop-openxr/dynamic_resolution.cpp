@@ -0,0 +1,200 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "log.h"
+#include "runtime.h"
+#include "utils.h"
+
+// Implements the dynamic resolution controller and the XR_META_recommended_layer_resolution extension:
+// https://registry.khronos.org/OpenXR/specs/1.1/html/xrspec.html#XR_META_recommended_layer_resolution
+
+namespace virtualdesktop_openxr {
+
+    using namespace virtualdesktop_openxr::log;
+    using namespace virtualdesktop_openxr::utils;
+
+    namespace {
+        // How many consecutive frames the application may submit larger images than recommended before we consider
+        // that it is not following the recommendation.
+        constexpr uint32_t MaxIgnoredFrames = 90;
+    } // namespace
+
+    XrResult OpenXrRuntime::xrGetRecommendedLayerResolutionMETA(XrSession session,
+                                                                const XrRecommendedLayerResolutionGetInfoMETA* info,
+                                                                XrRecommendedLayerResolutionMETA* resolution) {
+        if (info->type != XR_TYPE_RECOMMENDED_LAYER_RESOLUTION_GET_INFO_META ||
+            resolution->type != XR_TYPE_RECOMMENDED_LAYER_RESOLUTION_META) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        TraceLoggingWrite(g_traceProvider,
+                          "xrGetRecommendedLayerResolutionMETA",
+                          TLXArg(session, "Session"),
+                          TLPArg(info->layer, "Layer"),
+                          TLArg(info->predictedDisplayTime, "PredictedDisplayTime"));
+
+        if (!has_XR_META_recommended_layer_resolution) {
+            return XR_ERROR_FUNCTION_UNSUPPORTED;
+        }
+
+        if (!m_sessionCreated || session != (XrSession)1) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+
+        if (!info->layer) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        if (info->predictedDisplayTime <= 0) {
+            return XR_ERROR_TIME_INVALID;
+        }
+
+        resolution->isValid = XR_FALSE;
+        resolution->recommendedImageDimensions = {};
+
+        // We only steer the resolution of projection layers.
+        if (m_useDynamicResolution && info->layer->type == XR_TYPE_COMPOSITION_LAYER_PROJECTION) {
+            const XrCompositionLayerProjection* proj =
+                reinterpret_cast<const XrCompositionLayerProjection*>(info->layer);
+            if (proj->viewCount != xr::StereoView::Count || !proj->views) {
+                return XR_ERROR_VALIDATION_FAILURE;
+            }
+
+            auto lock = lockSwapchainsShared();
+
+            // The recommendation applies to all the views of the layer, so it must satisfy the larger eye (the FOV of
+            // the eyes may be asymmetric). Do not recommend more than what the swapchains can hold.
+            for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+                if (!m_swapchains.count(proj->views[eye].subImage.swapchain)) {
+                    return XR_ERROR_HANDLE_INVALID;
+                }
+
+                const Swapchain& xrSwapchain = *(Swapchain*)proj->views[eye].subImage.swapchain;
+                const XrExtent2Di recommendedSize = getDynamicResolutionRecommendedSize(eye);
+                resolution->recommendedImageDimensions.width =
+                    std::max(resolution->recommendedImageDimensions.width,
+                             std::min(recommendedSize.width, (int32_t)xrSwapchain.xrDesc.width));
+                resolution->recommendedImageDimensions.height =
+                    std::max(resolution->recommendedImageDimensions.height,
+                             std::min(recommendedSize.height, (int32_t)xrSwapchain.xrDesc.height));
+            }
+            resolution->isValid = XR_TRUE;
+        }
+
+        TraceLoggingWrite(g_traceProvider,
+                          "xrGetRecommendedLayerResolutionMETA",
+                          TLArg(!!resolution->isValid, "IsValid"),
+                          TLArg(resolution->recommendedImageDimensions.width, "RecommendedWidth"),
+                          TLArg(resolution->recommendedImageDimensions.height, "RecommendedHeight"));
+
+        return XR_SUCCESS;
+    }
+
+    void OpenXrRuntime::initializeDynamicResolution() {
+        // Dynamic resolution requires the application to follow our recommendation. Otherwise we fall back to the
+        // static upscaling setting.
+        m_useDynamicResolution =
+            has_XR_META_recommended_layer_resolution && getSetting("dynamic_resolution").value_or(false);
+        m_dynamicResolutionController.reset(
+            std::clamp(getSetting("dynamic_resolution_min").value_or(60) / 100.f, 0.25f, 1.f),
+            std::clamp(getSetting("dynamic_resolution_gpu_budget").value_or(90) / 100.f, 0.5f, 1.f));
+        m_dynamicResolutionIgnoredFrames = 0;
+        m_dynamicResolutionIsIgnored = false;
+
+        if (m_useDynamicResolution) {
+            // The swapchains are sized for native resolution, and we upscale back to that resolution.
+            m_upscalingMultiplier = 1.f;
+
+            for (uint32_t i = 0; i < xr::StereoView::Count; i++) {
+                ovrFovPort fov;
+                fov.UpTan = tan(m_cachedEyeFov[i].angleUp);
+                fov.DownTan = tan(-m_cachedEyeFov[i].angleDown);
+                fov.LeftTan = tan(-m_cachedEyeFov[i].angleLeft);
+                fov.RightTan = tan(m_cachedEyeFov[i].angleRight);
+
+                const ovrSizei viewportSize = ovr_GetFovTextureSize(
+                    m_ovrSession, i == xr::StereoView::Left ? ovrEye_Left : ovrEye_Right, fov, m_supersamplingFactor);
+                m_dynamicResolutionNativeSize[i].w = (int)xr::math::AlignTo<4>((uint32_t)viewportSize.w);
+                m_dynamicResolutionNativeSize[i].h = (int)xr::math::AlignTo<4>((uint32_t)viewportSize.h);
+            }
+        }
+
+        TraceLoggingWrite(g_traceProvider,
+                          "VDXR_Config",
+                          TLArg(m_useDynamicResolution, "UseDynamicResolution"),
+                          TLArg(m_dynamicResolutionController.getMinScale(), "DynamicResolutionMinScale"),
+                          TLArg(m_dynamicResolutionController.getGpuBudget(), "DynamicResolutionGpuBudget"));
+    }
+
+    void OpenXrRuntime::updateDynamicResolution(uint64_t appGpuTimeUs, uint64_t precompositionGpuTimeUs) {
+        // The GPU timers have a few frames of latency, and they read 0 until then.
+        if (!m_useDynamicResolution || m_dynamicResolutionIsIgnored || !appGpuTimeUs) {
+            return;
+        }
+
+        m_dynamicResolutionController.addSample((double)(appGpuTimeUs + precompositionGpuTimeUs));
+
+        // Detect applications that do not follow the recommendation. Lowering the resolution further would only result
+        // in more upscaling work without lowering the application's cost. We then fall back to recommending the native
+        // resolution, and we keep upscaling whatever smaller images the application submits.
+        bool isIgnored = false;
+        for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+            const XrExtent2Di expectedSize = getDynamicResolutionRecommendedSize(eye);
+            isIgnored = isIgnored || m_dynamicResolutionSubmittedSize[eye].width > expectedSize.width + 4 ||
+                        m_dynamicResolutionSubmittedSize[eye].height > expectedSize.height + 4;
+        }
+        m_dynamicResolutionIgnoredFrames = isIgnored ? m_dynamicResolutionIgnoredFrames + 1 : 0;
+        if (m_dynamicResolutionIgnoredFrames > MaxIgnoredFrames) {
+            Log("Application does not follow the recommended resolution, falling back to native resolution\n");
+            m_dynamicResolutionIsIgnored = true;
+            m_dynamicResolutionController.resetScale();
+            return;
+        }
+
+        m_dynamicResolutionController.adjust(m_idealFrameDuration);
+
+        TraceLoggingWrite(g_traceProvider,
+                          "DynamicResolution",
+                          TLArg(appGpuTimeUs, "AppGpuTimeUs"),
+                          TLArg(precompositionGpuTimeUs, "PrecompositionGpuTimeUs"),
+                          TLArg(m_dynamicResolutionController.getFilteredGpuTimeUs(), "FilteredGpuTimeUs"),
+                          TLArg(m_dynamicResolutionController.getGpuBudgetUs(m_idealFrameDuration), "BudgetUs"),
+                          TLArg(m_dynamicResolutionSubmittedSize[xr::StereoView::Left].width, "SubmittedWidthLeft"),
+                          TLArg(m_dynamicResolutionSubmittedSize[xr::StereoView::Right].width, "SubmittedWidthRight"),
+                          TLArg(m_dynamicResolutionController.getScale(), "Scale"));
+    }
+
+    XrExtent2Di OpenXrRuntime::getDynamicResolutionRecommendedSize(uint32_t eye) const {
+        const ovrSizei& nativeSize = m_dynamicResolutionNativeSize[eye];
+        const float scale = m_dynamicResolutionController.getScale();
+        return {(int32_t)xr::math::AlignTo<4>((uint32_t)(nativeSize.w * scale)),
+                (int32_t)xr::math::AlignTo<4>((uint32_t)(nativeSize.h * scale))};
+    }
+
+    bool OpenXrRuntime::needDynamicResolutionUpscaling(const XrRect2Di& imageRect, uint32_t eye) const {
+        return m_useDynamicResolution && (imageRect.extent.width < m_dynamicResolutionNativeSize[eye].w ||
+                                          imageRect.extent.height < m_dynamicResolutionNativeSize[eye].h);
+    }
+
+} // namespace virtualdesktop_openxr
@@ -119,8 +119,8 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        // Forward the state from the memory mapped file.
-        if (m_bodyState) {
+        // Forward the state from the body state source.
+        if (m_bodyStateSource) {
             std::shared_lock lock(m_bodyStateMutex);
 
             eyeGazes->gaze[xr::Side::Left].gazeConfidence = m_cachedBodyState.LeftEyeConfidence;
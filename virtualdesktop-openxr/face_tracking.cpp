@@ -130,8 +130,8 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
-        // Forward the state from the memory mapped file.
-        if (m_bodyState) {
+        // Forward the state from the body state source.
+        if (m_bodyStateSource) {
             std::shared_lock lock(m_bodyStateMutex);
 
             for (uint32_t i = 0; i < XR_FACE_EXPRESSION_COUNT_FB; i++) {
@@ -275,8 +275,8 @@ namespace virtualdesktop_openxr {
 
         const FaceTracker& xrFaceTracker = *(FaceTracker*)faceTracker;
 
-        // Forward the state from the memory mapped file.
-        if (m_bodyState) {
+        // Forward the state from the body state source.
+        if (m_bodyStateSource) {
             std::shared_lock lock(m_bodyStateMutex);
 
             for (uint32_t i = 0; i < XR_FACE_EXPRESSION2_COUNT_FB; i++) {
@@ -373,7 +373,7 @@ namespace virtualdesktop_openxr {
 
         // Critical section.
         {
-            std::unique_lock lock1(m_swapchainsMutex);
+            auto lock1 = lockSwapchainsShared();
             std::unique_lock lock2(m_frameMutex);
 
             if (m_frameBegun == m_frameCompleted) {
@@ -393,16 +393,8 @@ namespace virtualdesktop_openxr {
                 // context.
             }
 
-            // Serializes the app work between D3D12/Vulkan and D3D11.
-            if (isD3D12Session()) {
-                serializeD3D12Frame();
-            } else if (isVulkanSession()) {
-                serializeVulkanFrame();
-            } else if (isOpenGLSession()) {
-                serializeOpenGLFrame();
-            } else if (!m_isHeadless) {
-                serializeD3D11Frame();
-            }
+            // Serializes the app work between D3D12/Vulkan/OpenGL and D3D11.
+            m_graphicsBackend->serializeFrame();
 
             // Ensure that we always restore the application device context if needed.
             auto scopeGuard = MakeScopeGuard([&] {
@@ -415,13 +407,35 @@ namespace virtualdesktop_openxr {
             const auto lastPrecompositionTime = m_gpuTimerPrecomposition[m_currentTimerIndex]
                                                     ? m_gpuTimerPrecomposition[m_currentTimerIndex]->query()
                                                     : 0;
-            if (IsTraceEnabled() && m_gpuTimerPrecomposition[0]) {
+            if ((IsTraceEnabled() || m_useDynamicResolution) && m_gpuTimerPrecomposition[0]) {
                 m_gpuTimerPrecomposition[m_currentTimerIndex]->start();
             }
 
+            // Ensure that the profiled frame is closed even upon error.
+            auto gpuProfilerScopeGuard = MakeScopeGuard([&] {
+                if (m_gpuProfiler) {
+                    m_gpuProfiler->endFrame();
+                }
+            });
+            if ((IsTraceEnabled() || m_useGpuProfiler) && m_gpuProfiler) {
+                m_gpuProfiler->beginFrame();
+                for (const auto& [path, durationUs] : m_gpuProfiler->getLastMeasurements()) {
+                    TraceLoggingWrite(g_traceProvider,
+                                      "GpuProfiler_Scope",
+                                      TLArg(path.c_str(), "Scope"),
+                                      TLArg(durationUs, "DurationUs"));
+                }
+            }
+
+            updateDynamicResolution(m_lastGpuFrameTimeUs, lastPrecompositionTime);
+
             m_precompositor.displayTime = frameEndInfo->displayTime;
+            m_precompositor.headPose.reset();
             m_precompositor.isFirstProjectionLayer = true;
             m_precompositor.resolvedSwapchainImages.clear();
+            m_precompositor.consumedGenerations.clear();
+            collectResolveRegions(*frameEndInfo);
+            updateVideoMemoryBudget();
 
             // Construct the list of layers.
             std::vector<ovrLayer_Union> layersAllocator;
@@ -442,6 +456,7 @@ namespace virtualdesktop_openxr {
                 layer.Header.Flags = 0;
 
                 m_precompositor.layerIndex = i;
+                GpuProfilerScope gpuProfilerScope(m_gpuProfiler.get(), "Layer", i);
 
                 // OpenGL needs to flip the texture vertically, which OVR can conveniently do for us.
                 if (isOpenGLSession()) {
@@ -487,9 +502,10 @@ namespace virtualdesktop_openxr {
                 }
             }
 
-            // Mark all swapchain images as clean (aka already pre-processed).
-            for (auto resolvedSwapchain : m_precompositor.resolvedSwapchainImages) {
-                resolvedSwapchain.first->dirty = false;
+            // Mark all swapchain images as clean (aka already pre-processed), up to the release they were resolved
+            // from.
+            for (auto consumedGeneration : m_precompositor.consumedGenerations) {
+                consumedGeneration.first->consumedGeneration = consumedGeneration.second;
             }
 
             // Add a dummy layer so we can still call ovr_endFrame() for timing purposes.
@@ -498,7 +514,10 @@ namespace virtualdesktop_openxr {
                 layersAllocator.back().Header.Type = ovrLayerType_Disabled;
             }
 
-            if (IsTraceEnabled() && m_gpuTimerPrecomposition[0]) {
+            if (m_gpuProfiler) {
+                m_gpuProfiler->endFrame();
+            }
+            if ((IsTraceEnabled() || m_useDynamicResolution) && m_gpuTimerPrecomposition[0]) {
                 m_gpuTimerPrecomposition[m_currentTimerIndex]->stop();
             }
 
@@ -549,7 +568,7 @@ namespace virtualdesktop_openxr {
                 if (!m_isHeadless && m_useMirrorWindow && !m_mirrorWindowThread.joinable()) {
                     createMirrorWindow();
                 }
-                updateMirrorWindow(m_precompositor.isProj0SRGB);
+                m_mirrorWindowPreferSRGB = m_precompositor.isProj0SRGB;
             } catch (std::exception& exc) {
                 TraceLoggingWrite(g_traceProvider, "MirrorWindow", TLArg(exc.what(), "Error"));
                 ErrorLog("Failed to update the mirror window: %s\n", exc.what());
@@ -603,7 +622,8 @@ namespace virtualdesktop_openxr {
                           TLArg(proj.layerFlags, "Flags"),
                           TLXArg(proj.space, "Space"));
 
-        if (proj.viewCount != xr::StereoView::Count) {
+        const bool isQuadViews = m_primaryViewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_QUAD_VARJO;
+        if (proj.viewCount != (!isQuadViews ? xr::StereoView::Count : xr::QuadView::Count)) {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
@@ -620,20 +640,55 @@ namespace virtualdesktop_openxr {
         // Start without depth. We might change the type to ovrLayerType_EyeFovDepth further below.
         layer.Header.Type = ovrLayerType_EyeFov;
 
-        Swapchain* swapchains[xr::StereoView::Count] = {};
-        const XrSwapchainSubImage* subImages[xr::StereoView::Count] = {};
+        Swapchain* swapchains[xr::QuadView::Count] = {};
+        const XrSwapchainSubImage* subImages[xr::QuadView::Count] = {};
 
-        for (uint32_t viewIndex = 0; viewIndex < xr::StereoView::Count; viewIndex++) {
-            TraceLoggingWrite(g_traceProvider,
-                              "xrEndFrame_View",
-                              TLArg("Proj", "Type"),
-                              TLArg(viewIndex, "ViewIndex"),
-                              TLXArg(proj.views[viewIndex].subImage.swapchain, "Swapchain"),
-                              TLArg(proj.views[viewIndex].subImage.imageArrayIndex, "ImageArrayIndex"),
-                              TLArg(xr::ToString(proj.views[viewIndex].subImage.imageRect).c_str(), "ImageRect"),
-                              TLArg(xr::ToString(proj.views[viewIndex].pose).c_str(), "Pose"),
-                              TLArg(xr::ToString(proj.views[viewIndex].fov).c_str(), "Fov"));
+        // We only stitch the focus views into the bottom projection layer. For other layers, we only use the peripheral
+        // views.
+        const bool needQuadViewsStitching = isQuadViews && m_precompositor.isFirstProjectionLayer;
+
+        // When the application follows our dynamic resolution, we must bring the image back to native resolution.
+        bool useDynamicResolutionUpscaling = false;
+        if (m_precompositor.isFirstProjectionLayer) {
+            for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+                useDynamicResolutionUpscaling = useDynamicResolutionUpscaling ||
+                                                needDynamicResolutionUpscaling(proj.views[eye].subImage.imageRect, eye);
+                m_dynamicResolutionSubmittedSize[eye] = proj.views[eye].subImage.imageRect.extent;
+            }
+        }
 
+        // With texture arrays, both views are usually in the same swapchain. Gather all the slices of a swapchain
+        // used by the stereo views, so they are resolved in one batch.
+        const auto findDepthInfo = [&](uint32_t viewIndex) -> const XrCompositionLayerDepthInfoKHR* {
+            const XrBaseInStructure* entry = reinterpret_cast<const XrBaseInStructure*>(proj.views[viewIndex].next);
+            while (entry) {
+                if (entry->type == XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR) {
+                    return reinterpret_cast<const XrCompositionLayerDepthInfoKHR*>(entry);
+                }
+                entry = entry->next;
+            }
+            return nullptr;
+        };
+        const auto getStereoSlices = [&](const Swapchain& xrSwapchain, bool isDepth) {
+            std::vector<uint32_t> slices;
+            for (uint32_t viewIndex = 0; viewIndex < xr::StereoView::Count; viewIndex++) {
+                const XrCompositionLayerDepthInfoKHR* depth = isDepth ? findDepthInfo(viewIndex) : nullptr;
+                const XrSwapchainSubImage* subImage = !isDepth ? &proj.views[viewIndex].subImage
+                                                      : depth  ? &depth->subImage
+                                                               : nullptr;
+                if (subImage && subImage->swapchain == (XrSwapchain)&xrSwapchain &&
+                    subImage->imageArrayIndex < xrSwapchain.xrDesc.arraySize) {
+                    slices.push_back(subImage->imageArrayIndex);
+                }
+            }
+            return slices;
+        };
+
+        // The slices of both views are resolved together, so both views must be validated before resolving either.
+        // Some games (like WRC) will not properly submit depth. We bypass all the checks if the runtime does not care
+        // about depth.
+        const bool shouldUseDepth = has_XR_KHR_composition_layer_depth && (m_shouldUseDepth || m_isConformanceTest);
+        for (uint32_t viewIndex = 0; viewIndex < xr::StereoView::Count; viewIndex++) {
             if (!Quaternion::IsNormalized(proj.views[viewIndex].pose.orientation)) {
                 return XR_ERROR_POSE_INVALID;
             }
@@ -642,7 +697,7 @@ namespace virtualdesktop_openxr {
                 return XR_ERROR_HANDLE_INVALID;
             }
 
-            Swapchain& xrSwapchain = *(Swapchain*)proj.views[viewIndex].subImage.swapchain;
+            const Swapchain& xrSwapchain = *(Swapchain*)proj.views[viewIndex].subImage.swapchain;
 
             if (xrSwapchain.lastReleasedIndex == -1) {
                 return XR_ERROR_LAYER_INVALID;
@@ -653,27 +708,66 @@ namespace virtualdesktop_openxr {
                 return XR_ERROR_VALIDATION_FAILURE;
             }
 
+            if (!isValidSwapchainRect(xrSwapchain.ovrDesc, proj.views[viewIndex].subImage.imageRect)) {
+                return XR_ERROR_SWAPCHAIN_RECT_INVALID;
+            }
+
+            const XrCompositionLayerDepthInfoKHR* depth = shouldUseDepth ? findDepthInfo(viewIndex) : nullptr;
+            if (depth) {
+                if (!m_swapchains.count(depth->subImage.swapchain)) {
+                    return XR_ERROR_HANDLE_INVALID;
+                }
+
+                const Swapchain& xrDepthSwapchain = *(Swapchain*)depth->subImage.swapchain;
+
+                if (xrDepthSwapchain.lastReleasedIndex == -1) {
+                    return XR_ERROR_LAYER_INVALID;
+                }
+
+                if (depth->subImage.imageArrayIndex >= xrDepthSwapchain.xrDesc.arraySize ||
+                    xrDepthSwapchain.xrDesc.faceCount != 1) {
+                    return XR_ERROR_VALIDATION_FAILURE;
+                }
+
+                // TODO: We don't enforce that the viewport must match the color buffer.
+                if (!isValidSwapchainRect(xrDepthSwapchain.ovrDesc, depth->subImage.imageRect)) {
+                    return XR_ERROR_SWAPCHAIN_RECT_INVALID;
+                }
+            }
+        }
+
+        for (uint32_t viewIndex = 0; viewIndex < xr::StereoView::Count; viewIndex++) {
+            TraceLoggingWrite(g_traceProvider,
+                              "xrEndFrame_View",
+                              TLArg("Proj", "Type"),
+                              TLArg(viewIndex, "ViewIndex"),
+                              TLXArg(proj.views[viewIndex].subImage.swapchain, "Swapchain"),
+                              TLArg(proj.views[viewIndex].subImage.imageArrayIndex, "ImageArrayIndex"),
+                              TLArg(xr::ToString(proj.views[viewIndex].subImage.imageRect).c_str(), "ImageRect"),
+                              TLArg(xr::ToString(proj.views[viewIndex].pose).c_str(), "Pose"),
+                              TLArg(xr::ToString(proj.views[viewIndex].fov).c_str(), "Fov"));
+
+            Swapchain& xrSwapchain = *(Swapchain*)proj.views[viewIndex].subImage.swapchain;
+
             if (m_precompositor.isFirstProjectionLayer) {
                 m_precompositor.isProj0SRGB = isSRGBFormat(xrSwapchain.dxgiFormatForSubmission);
             }
 
-            // We only upscale the bottom projection layer and only the focus view (when applicable).
-            const bool canUpscale = std::abs(m_upscalingMultiplier - 1.f) > FLT_EPSILON;
+            // We only upscale (or downsample) the bottom projection layer and only the focus view (when applicable).
+            const bool canUpscale = std::abs(m_upscalingMultiplier - 1.f) > FLT_EPSILON ||
+                                    useDynamicResolutionUpscaling || needSupersamplingDownsampling();
             const bool canSharpen = m_sharpenFactor > 0.f;
-            const bool needUpscaling = m_precompositor.isFirstProjectionLayer && (canUpscale || canSharpen);
+            const bool needUpscaling =
+                needQuadViewsStitching || (m_precompositor.isFirstProjectionLayer && (canUpscale || canSharpen));
 
             // Fill out color buffer information.
-            resolveSwapchainImage(xrSwapchain,
-                                  proj.views[viewIndex].subImage.imageArrayIndex,
-                                  m_precompositor.resolvedSwapchainImages,
-                                  needUpscaling /* Skip committing if we will not use the swapchain directly */);
+            resolveSwapchainImages(xrSwapchain,
+                                   getStereoSlices(xrSwapchain, false /* isDepth */),
+                                   m_precompositor.resolvedSwapchainImages,
+                                   needUpscaling /* Skip committing if we will not use the swapchain directly */);
             layer.EyeFov.ColorTexture[viewIndex] =
                 xrSwapchain.resolvedSlices[proj.views[viewIndex].subImage.imageArrayIndex].ovrSwapchain;
 
-            if (!isValidSwapchainRect(xrSwapchain.ovrDesc, proj.views[viewIndex].subImage.imageRect)) {
-                return XR_ERROR_SWAPCHAIN_RECT_INVALID;
-            }
-
             preprocessSwapchainImage(xrSwapchain,
                                      m_precompositor.layerIndex,
                                      proj.views[viewIndex].subImage.imageArrayIndex,
@@ -725,38 +819,18 @@ namespace virtualdesktop_openxr {
                                           TLArg(depth->minDepth, "MinDepth"),
                                           TLArg(depth->maxDepth, "MaxDepth"));
 
-                        // Some games (like WRC) will not properly submit depth. We bypass all the checks if the runtime
-                        // does not care about depth.
-                        if (m_shouldUseDepth || m_isConformanceTest) {
+                        if (shouldUseDepth) {
                             layer.Header.Type = ovrLayerType_EyeFovDepth;
 
-                            if (!m_swapchains.count(depth->subImage.swapchain)) {
-                                return XR_ERROR_HANDLE_INVALID;
-                            }
-
                             Swapchain& xrDepthSwapchain = *(Swapchain*)depth->subImage.swapchain;
 
-                            if (xrDepthSwapchain.lastReleasedIndex == -1) {
-                                return XR_ERROR_LAYER_INVALID;
-                            }
-
-                            if (depth->subImage.imageArrayIndex >= xrDepthSwapchain.xrDesc.arraySize ||
-                                xrSwapchain.xrDesc.faceCount != 1) {
-                                return XR_ERROR_VALIDATION_FAILURE;
-                            }
-
                             // Fill out depth buffer information.
-                            resolveSwapchainImage(xrDepthSwapchain,
-                                                  depth->subImage.imageArrayIndex,
-                                                  m_precompositor.resolvedSwapchainImages);
+                            resolveSwapchainImages(xrDepthSwapchain,
+                                                   getStereoSlices(xrDepthSwapchain, true /* isDepth */),
+                                                   m_precompositor.resolvedSwapchainImages);
                             layer.EyeFovDepth.DepthTexture[viewIndex] =
                                 xrDepthSwapchain.resolvedSlices[depth->subImage.imageArrayIndex].ovrSwapchain;
 
-                            // TODO: We don't enforce that the viewport must match the color buffer.
-                            if (!isValidSwapchainRect(xrDepthSwapchain.ovrDesc, depth->subImage.imageRect)) {
-                                return XR_ERROR_SWAPCHAIN_RECT_INVALID;
-                            }
-
                             // Fill out projection information.
                             layer.EyeFovDepth.ProjectionDesc.Projection22 = depth->farZ / (depth->nearZ - depth->farZ);
                             layer.EyeFovDepth.ProjectionDesc.Projection23 =
@@ -773,6 +847,51 @@ namespace virtualdesktop_openxr {
             }
         }
 
+        if (needQuadViewsStitching) {
+            for (uint32_t viewIndex = xr::StereoView::Count; viewIndex < xr::QuadView::Count; viewIndex++) {
+                TraceLoggingWrite(g_traceProvider,
+                                  "xrEndFrame_View",
+                                  TLArg("Proj", "Type"),
+                                  TLArg(viewIndex, "ViewIndex"),
+                                  TLXArg(proj.views[viewIndex].subImage.swapchain, "Swapchain"),
+                                  TLArg(proj.views[viewIndex].subImage.imageArrayIndex, "ImageArrayIndex"),
+                                  TLArg(xr::ToString(proj.views[viewIndex].subImage.imageRect).c_str(), "ImageRect"),
+                                  TLArg(xr::ToString(proj.views[viewIndex].pose).c_str(), "Pose"),
+                                  TLArg(xr::ToString(proj.views[viewIndex].fov).c_str(), "Fov"));
+
+                if (!Quaternion::IsNormalized(proj.views[viewIndex].pose.orientation)) {
+                    return XR_ERROR_POSE_INVALID;
+                }
+
+                if (!m_swapchains.count(proj.views[viewIndex].subImage.swapchain)) {
+                    return XR_ERROR_HANDLE_INVALID;
+                }
+
+                Swapchain& xrSwapchain = *(Swapchain*)proj.views[viewIndex].subImage.swapchain;
+
+                if (xrSwapchain.lastReleasedIndex == -1) {
+                    return XR_ERROR_LAYER_INVALID;
+                }
+
+                if (proj.views[viewIndex].subImage.imageArrayIndex >= xrSwapchain.xrDesc.arraySize ||
+                    xrSwapchain.xrDesc.faceCount != 1) {
+                    return XR_ERROR_VALIDATION_FAILURE;
+                }
+
+                if (!isValidSwapchainRect(xrSwapchain.ovrDesc, proj.views[viewIndex].subImage.imageRect)) {
+                    return XR_ERROR_SWAPCHAIN_RECT_INVALID;
+                }
+
+                resolveSwapchainImage(xrSwapchain,
+                                      proj.views[viewIndex].subImage.imageArrayIndex,
+                                      m_precompositor.resolvedSwapchainImages,
+                                      true /* Skip committing since we will not use the swapchain directly */);
+
+                swapchains[viewIndex] = &xrSwapchain;
+                subImages[viewIndex] = &proj.views[viewIndex].subImage;
+            }
+        }
+
         // Restore the original IPD, otherwise the compositor will reproject the altered IPD
         // into the real IPD.
         if (m_lastSeenIpd) {
@@ -780,8 +899,14 @@ namespace virtualdesktop_openxr {
                 layer.EyeFov.RenderPose[ovrEye_Left], layer.EyeFov.RenderPose[ovrEye_Right], m_lastSeenIpd.value());
         }
 
-        // Run the upscaler or sharpening if needed.
-        if (swapchains[xr::StereoView::Right]) {
+        // Stitch the quad views, or run the upscaler or sharpening if needed.
+        if (needQuadViewsStitching) {
+            const XrFovf fovs[] = {proj.views[xr::QuadView::Left].fov,
+                                   proj.views[xr::QuadView::Right].fov,
+                                   proj.views[xr::QuadView::FocusLeft].fov,
+                                   proj.views[xr::QuadView::FocusRight].fov};
+            stitchQuadViews(swapchains, subImages, fovs, layer.EyeFov);
+        } else if (swapchains[xr::StereoView::Right]) {
             upscaler(swapchains, subImages, layer.EyeFov);
         }
 
@@ -914,6 +1039,32 @@ namespace virtualdesktop_openxr {
             layer.Cylinder.CylinderAspectRatio = cylinder.aspectRatio;
         }
 
+        // Reduce the layer if it is sampled much more finely than the display can show.
+        if (m_useLayerDownsampling) {
+            // Head-locked layers are measured from the origin of the view space.
+            XrVector3f headPosition{};
+            if (xrSpace.referenceType != XR_REFERENCE_SPACE_TYPE_VIEW) {
+                if (!m_precompositor.headPose) {
+                    XrPosef headPose = Pose::Identity();
+                    locateSpace(*m_viewSpace, *m_originSpace, m_precompositor.displayTime, headPose);
+                    m_precompositor.headPose = headPose;
+                }
+                headPosition = m_precompositor.headPose->position;
+            }
+
+            const XrVector3f layerPosition{layer.Quad.QuadPoseCenter.Position.x,
+                                           layer.Quad.QuadPoseCenter.Position.y,
+                                           layer.Quad.QuadPoseCenter.Position.z};
+            const density::AngularExtent angularExtent =
+                !isCylinder ? density::GetQuadAngularExtent(layerPosition, quad.size, headPosition)
+                            : density::GetCylinderAngularExtent(layerPosition,
+                                                                cylinder.radius,
+                                                                cylinder.centralAngle,
+                                                                cylinder.aspectRatio,
+                                                                headPosition);
+            downsampleQuadLayer(xrSwapchain, quad.subImage, angularExtent, layer.Quad);
+        }
+
         return XR_SUCCESS;
     }
 
@@ -995,12 +1146,68 @@ namespace virtualdesktop_openxr {
         return XR_SUCCESS;
     }
 
+    // Gather the union of the image rects referenced by the layers for each swapchain slice, so that we only resolve
+    // or copy what will actually be read. Also count the quad and cylinder layers using each swapchain.
+    void OpenXrRuntime::collectResolveRegions(const XrFrameEndInfo& frameEndInfo) {
+        m_precompositor.resolveRegions.clear();
+        m_precompositor.quadLayerReferences.clear();
+
+        const auto addRegion = [&](const XrSwapchainSubImage& subImage) {
+            // Invalid submissions are rejected later.
+            if (!m_useResolveRegions || !m_swapchains.count(subImage.swapchain)) {
+                return;
+            }
+
+            const auto key = std::make_pair((Swapchain*)subImage.swapchain, subImage.imageArrayIndex);
+            const auto it = m_precompositor.resolveRegions.find(key);
+            if (it == m_precompositor.resolveRegions.end()) {
+                m_precompositor.resolveRegions.insert_or_assign(key, subImage.imageRect);
+            } else {
+                it->second = unionRect(it->second, subImage.imageRect);
+            }
+        };
+
+        for (uint32_t i = 0; i < frameEndInfo.layerCount; i++) {
+            const XrCompositionLayerBaseHeader* header = frameEndInfo.layers[i];
+            if (!header) {
+                continue;
+            }
+
+            if (header->type == XR_TYPE_COMPOSITION_LAYER_PROJECTION) {
+                const XrCompositionLayerProjection* proj =
+                    reinterpret_cast<const XrCompositionLayerProjection*>(header);
+                for (uint32_t viewIndex = 0; proj->views && viewIndex < proj->viewCount; viewIndex++) {
+                    addRegion(proj->views[viewIndex].subImage);
+
+                    const XrBaseInStructure* entry =
+                        reinterpret_cast<const XrBaseInStructure*>(proj->views[viewIndex].next);
+                    while (entry) {
+                        if (entry->type == XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR) {
+                            addRegion(reinterpret_cast<const XrCompositionLayerDepthInfoKHR*>(entry)->subImage);
+                        }
+                        entry = entry->next;
+                    }
+                }
+            } else if (header->type == XR_TYPE_COMPOSITION_LAYER_QUAD) {
+                const XrSwapchainSubImage& subImage = reinterpret_cast<const XrCompositionLayerQuad*>(header)->subImage;
+                addRegion(subImage);
+                m_precompositor.quadLayerReferences[(Swapchain*)subImage.swapchain]++;
+            } else if (header->type == XR_TYPE_COMPOSITION_LAYER_CYLINDER_KHR) {
+                const XrSwapchainSubImage& subImage =
+                    reinterpret_cast<const XrCompositionLayerCylinderKHR*>(header)->subImage;
+                addRegion(subImage);
+                m_precompositor.quadLayerReferences[(Swapchain*)subImage.swapchain]++;
+            }
+            // Cube layers always use the entire images.
+        }
+    }
+
     void OpenXrRuntime::preprocessSwapchainImage(Swapchain& xrSwapchain,
                                                  uint32_t layerIndex,
                                                  uint32_t slice,
                                                  XrCompositionLayerFlags compositionFlags,
                                                  XrRect2Di viewport) {
-        if (!xrSwapchain.dirty) {
+        if (xrSwapchain.releaseGeneration == xrSwapchain.consumedGeneration) {
             return;
         }
 
@@ -1025,6 +1232,7 @@ namespace virtualdesktop_openxr {
             // - For alpha-blended layers, we must pre-process the alpha channel.
 
             ensurePreprocessResources();
+            GpuProfilerScope gpuProfilerScope(m_gpuProfiler.get(), "AlphaBlending");
 
             // We are about to do something destructive to the application context. Save the context. It will be
             // restored at the end of xrEndFrame().
@@ -0,0 +1,822 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Deferred logging for the threads that cannot afford to wait on the log file (frame loop, actions). The calling
+// thread only copies the arguments of the printf-style format into a ring buffer of its own, without locks or
+// allocations. A background writer formats the messages and hands them over to the sink in batches. When a ring is
+// full, the message is dropped and counted, and the writer reports the number of dropped messages in the log.
+// The format string is read by the writer, hence it must outlive the logger (string literals do).
+// This header is shared between the runtime and the benchmarks tool, and does not depend on the platform.
+
+namespace virtualdesktop_openxr::log {
+
+    namespace detail {
+
+        enum class ArgumentType : uint8_t {
+            None, // %% or an unsupported conversion, which is written as-is.
+            Int,
+            Long,
+            LongLong,
+            IntMax,
+            Size,
+            PtrDiff,
+            Double,
+            LongDouble,
+            Pointer,
+            String,
+            WideString,
+            Count, // %n, which is ignored.
+        };
+
+        // A conversion specification of a printf-style format.
+        struct Conversion {
+            const char* begin;
+            const char* end;
+            bool hasStarWidth;
+            bool hasStarPrecision;
+            int precision; // -1 when not specified.
+            ArgumentType type;
+        };
+
+        // Find the next conversion specification from the cursor, following the C99 and MSVC (I64, I32, I) syntax.
+        inline bool FindConversion(const char* cursor, Conversion& conversion) {
+            const char* p = strchr(cursor, '%');
+            if (!p) {
+                return false;
+            }
+
+            conversion = {p, p, false, false, -1, ArgumentType::None};
+            p++;
+            if (*p == '%') {
+                conversion.end = p + 1;
+                return true;
+            }
+
+            while (*p && strchr("-+ #0'", *p)) {
+                p++;
+            }
+            if (*p == '*') {
+                conversion.hasStarWidth = true;
+                p++;
+            } else {
+                while (*p >= '0' && *p <= '9') {
+                    p++;
+                }
+            }
+            if (*p == '.') {
+                p++;
+                if (*p == '*') {
+                    conversion.hasStarPrecision = true;
+                    p++;
+                } else {
+                    conversion.precision = 0;
+                    while (*p >= '0' && *p <= '9') {
+                        conversion.precision = conversion.precision * 10 + (*p++ - '0');
+                    }
+                }
+            }
+
+            ArgumentType integer = ArgumentType::Int;
+            bool isWide = false;
+            bool isLongDouble = false;
+            if (p[0] == 'h') {
+                p += p[1] == 'h' ? 2 : 1;
+            } else if (p[0] == 'l' && p[1] == 'l') {
+                integer = ArgumentType::LongLong;
+                p += 2;
+            } else if (p[0] == 'l' || p[0] == 'w') {
+                integer = ArgumentType::Long;
+                isWide = true;
+                p++;
+            } else if (p[0] == 'j') {
+                integer = ArgumentType::IntMax;
+                p++;
+            } else if (p[0] == 'z') {
+                integer = ArgumentType::Size;
+                p++;
+            } else if (p[0] == 't') {
+                integer = ArgumentType::PtrDiff;
+                p++;
+            } else if (p[0] == 'L') {
+                isLongDouble = true;
+                p++;
+            } else if (p[0] == 'I' && p[1] == '6' && p[2] == '4') {
+                integer = ArgumentType::LongLong;
+                p += 3;
+            } else if (p[0] == 'I' && p[1] == '3' && p[2] == '2') {
+                p += 3;
+            } else if (p[0] == 'I') {
+                integer = ArgumentType::Size;
+                p++;
+            }
+
+            switch (*p) {
+            case 'd':
+            case 'i':
+            case 'o':
+            case 'u':
+            case 'x':
+            case 'X':
+                conversion.type = integer;
+                break;
+            case 'c':
+                // Both char and wint_t are promoted to int.
+                conversion.type = ArgumentType::Int;
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                conversion.type = isLongDouble ? ArgumentType::LongDouble : ArgumentType::Double;
+                break;
+            case 's':
+                conversion.type = isWide ? ArgumentType::WideString : ArgumentType::String;
+                break;
+            case 'p':
+                conversion.type = ArgumentType::Pointer;
+                break;
+            case 'n':
+                conversion.type = ArgumentType::Count;
+                break;
+            default:
+                // Not consuming an argument, like %% (the format is invalid anyway).
+                conversion.hasStarWidth = conversion.hasStarPrecision = false;
+                conversion.end = *p ? p + 1 : p;
+                return true;
+            }
+            conversion.end = p + 1;
+            return true;
+        }
+
+        // Each message is stored as a header followed by the arguments in the order of the format.
+        struct RecordHeader {
+            uint32_t size;
+            uint32_t reserved;
+            int64_t time; // std::chrono::system_clock ticks.
+            const char* format;
+        };
+
+        // Strings are stored with their length, and a terminator for the writer to use them in place.
+        static constexpr uint32_t NullString = ~0u;
+
+        class Encoder {
+          public:
+            Encoder(uint8_t* buffer, size_t capacity) : m_buffer(buffer), m_capacity(capacity) {
+            }
+
+            template <typename T>
+            void write(const T& value) {
+                if (m_size + sizeof(T) > m_capacity) {
+                    m_overflow = true;
+                    return;
+                }
+                memcpy(m_buffer + m_size, &value, sizeof(T));
+                m_size += sizeof(T);
+            }
+
+            // Strings are truncated to the precision and to the space left in the record.
+            template <typename Char>
+            void writeString(const Char* string, int precision) {
+                if (!string) {
+                    write(NullString);
+                    return;
+                }
+
+                const size_t available = (m_capacity - std::min(m_capacity, m_size + sizeof(uint32_t))) / sizeof(Char);
+                if (!available) {
+                    m_overflow = true;
+                    return;
+                }
+                size_t limit = available - 1;
+                if (precision >= 0) {
+                    limit = std::min(limit, (size_t)precision);
+                }
+                uint32_t length = 0;
+                while (length < limit && string[length]) {
+                    length++;
+                }
+
+                write(length);
+                memcpy(m_buffer + m_size, string, length * sizeof(Char));
+                m_size += length * sizeof(Char);
+                write(Char{0});
+            }
+
+            size_t size() const {
+                return m_size;
+            }
+
+            bool overflow() const {
+                return m_overflow;
+            }
+
+          private:
+            uint8_t* const m_buffer;
+            const size_t m_capacity;
+            size_t m_size{0};
+            bool m_overflow{false};
+        };
+
+        class Decoder {
+          public:
+            Decoder(const uint8_t* buffer, size_t size) : m_buffer(buffer), m_size(size) {
+            }
+
+            template <typename T>
+            bool read(T& value) {
+                if (m_offset + sizeof(T) > m_size) {
+                    return false;
+                }
+                memcpy(&value, m_buffer + m_offset, sizeof(T));
+                m_offset += sizeof(T);
+                return true;
+            }
+
+            template <typename Char>
+            bool readString(const Char*& string) {
+                uint32_t length;
+                if (!read(length)) {
+                    return false;
+                }
+                if (length == NullString) {
+                    string = nullptr;
+                    return true;
+                }
+                const size_t size = (length + 1) * sizeof(Char);
+                if (m_offset + size > m_size) {
+                    return false;
+                }
+                // The encoder does not align the strings, but this is only a concern for wide strings on platforms
+                // without unaligned accesses, which we do not target.
+                string = reinterpret_cast<const Char*>(m_buffer + m_offset);
+                m_offset += size;
+                return true;
+            }
+
+          private:
+            const uint8_t* const m_buffer;
+            const size_t m_size;
+            size_t m_offset{0};
+        };
+
+        template <typename... Args>
+        void AppendFormatted(std::string& out, const char* spec, Args... args) {
+            char buffer[256];
+            const int length = snprintf(buffer, sizeof(buffer), spec, args...);
+            if (length < 0) {
+                return;
+            }
+            if ((size_t)length < sizeof(buffer)) {
+                out.append(buffer, length);
+                return;
+            }
+            const size_t offset = out.size();
+            out.resize(offset + length + 1);
+            snprintf(&out[offset], length + 1, spec, args...);
+            out.resize(offset + length);
+        }
+
+        // Pass the width and precision that were given as arguments (if any) along with the value.
+        template <typename T>
+        void AppendConversion(
+            std::string& out, const char* spec, const Conversion& conversion, int width, int precision, T value) {
+            if (conversion.hasStarWidth && conversion.hasStarPrecision) {
+                AppendFormatted(out, spec, width, precision, value);
+            } else if (conversion.hasStarWidth) {
+                AppendFormatted(out, spec, width, value);
+            } else if (conversion.hasStarPrecision) {
+                AppendFormatted(out, spec, precision, value);
+            } else {
+                AppendFormatted(out, spec, value);
+            }
+        }
+
+        template <typename T>
+        bool FormatArgument(std::string& out,
+                            Decoder& decoder,
+                            const char* spec,
+                            const Conversion& conversion,
+                            int width,
+                            int precision) {
+            T value;
+            if (!decoder.read(value)) {
+                return false;
+            }
+            AppendConversion(out, spec, conversion, width, precision, value);
+            return true;
+        }
+
+        template <typename Char>
+        bool FormatString(std::string& out,
+                          Decoder& decoder,
+                          const char* spec,
+                          const Conversion& conversion,
+                          int width,
+                          int precision,
+                          const Char* null) {
+            const Char* value;
+            if (!decoder.readString(value)) {
+                return false;
+            }
+            AppendConversion(out, spec, conversion, width, precision, value ? value : null);
+            return true;
+        }
+
+        // Format a message from its record. Returns false if the record is malformed (the output is then partial).
+        inline bool FormatRecord(std::string& out, const RecordHeader& header, const uint8_t* arguments, size_t size) {
+            Decoder decoder(arguments, size);
+            const char* cursor = header.format;
+            Conversion conversion;
+            while (FindConversion(cursor, conversion)) {
+                out.append(cursor, conversion.begin);
+                cursor = conversion.end;
+
+                int width = 0;
+                int precision = 0;
+                if ((conversion.hasStarWidth && !decoder.read(width)) ||
+                    (conversion.hasStarPrecision && !decoder.read(precision))) {
+                    return false;
+                }
+
+                const size_t specLength = conversion.end - conversion.begin;
+                if (conversion.type == ArgumentType::None) {
+                    if (specLength == 2 && conversion.begin[1] == '%') {
+                        out += '%';
+                    } else {
+                        out.append(conversion.begin, conversion.end);
+                    }
+                    continue;
+                }
+
+                char spec[64];
+                if (specLength >= sizeof(spec)) {
+                    return false;
+                }
+                memcpy(spec, conversion.begin, specLength);
+                spec[specLength] = 0;
+
+                bool isValid = true;
+                switch (conversion.type) {
+                case ArgumentType::Int:
+                    isValid = FormatArgument<int>(out, decoder, spec, conversion, width, precision);
+                    break;
+                case ArgumentType::Long:
+                    isValid = FormatArgument<long>(out, decoder, spec, conversion, width, precision);
+                    break;
+                case ArgumentType::LongLong:
+                    isValid = FormatArgument<long long>(out, decoder, spec, conversion, width, precision);
+                    break;
+                case ArgumentType::IntMax:
+                    isValid = FormatArgument<intmax_t>(out, decoder, spec, conversion, width, precision);
+                    break;
+                case ArgumentType::Size:
+                    isValid = FormatArgument<size_t>(out, decoder, spec, conversion, width, precision);
+                    break;
+                case ArgumentType::PtrDiff:
+                    isValid = FormatArgument<ptrdiff_t>(out, decoder, spec, conversion, width, precision);
+                    break;
+                case ArgumentType::Double:
+                    isValid = FormatArgument<double>(out, decoder, spec, conversion, width, precision);
+                    break;
+                case ArgumentType::LongDouble:
+                    isValid = FormatArgument<long double>(out, decoder, spec, conversion, width, precision);
+                    break;
+                case ArgumentType::Pointer:
+                    isValid = FormatArgument<void*>(out, decoder, spec, conversion, width, precision);
+                    break;
+                case ArgumentType::String:
+                    isValid = FormatString<char>(out, decoder, spec, conversion, width, precision, "(null)");
+                    break;
+                case ArgumentType::WideString:
+                    isValid = FormatString<wchar_t>(out, decoder, spec, conversion, width, precision, L"(null)");
+                    break;
+                default:
+                    break;
+                }
+                if (!isValid) {
+                    return false;
+                }
+            }
+            out.append(cursor);
+            return true;
+        }
+
+        // A single-producer (the owning thread), single-consumer (the writer) ring of records.
+        class Ring {
+          public:
+            explicit Ring(size_t capacity) : m_buffer(new uint8_t[capacity]), m_capacity(capacity) {
+            }
+
+            // Producer side.
+            bool write(const void* data, size_t size) {
+                const uint64_t head = m_head.load(std::memory_order_relaxed);
+                if (head + size - m_cachedTail > m_capacity) {
+                    m_cachedTail = m_tail.load(std::memory_order_acquire);
+                    if (head + size - m_cachedTail > m_capacity) {
+                        countDrop();
+                        return false;
+                    }
+                }
+
+                const size_t offset = head % m_capacity;
+                const size_t first = std::min(size, m_capacity - offset);
+                memcpy(m_buffer.get() + offset, data, first);
+                memcpy(m_buffer.get(), (const uint8_t*)data + first, size - first);
+                m_head.store(head + size, std::memory_order_release);
+                return true;
+            }
+
+            // Producer side.
+            void countDrop() {
+                m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+            // Producer side, when the thread exits.
+            void orphan() {
+                m_isOrphaned.store(true, std::memory_order_release);
+            }
+
+            // Consumer side. Append all the pending records.
+            void read(std::vector<uint8_t>& out) {
+                const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+                const uint64_t head = m_head.load(std::memory_order_acquire);
+                const size_t size = (size_t)(head - tail);
+                if (!size) {
+                    return;
+                }
+
+                const size_t offset = tail % m_capacity;
+                const size_t first = std::min(size, m_capacity - offset);
+                const size_t outOffset = out.size();
+                out.resize(outOffset + size);
+                memcpy(out.data() + outOffset, m_buffer.get() + offset, first);
+                memcpy(out.data() + outOffset + first, m_buffer.get(), size - first);
+                m_tail.store(head, std::memory_order_release);
+            }
+
+            // Consumer side. The ring can be forgotten once its thread exited and it was read entirely.
+            bool isRetired() const {
+                return m_isOrphaned.load(std::memory_order_acquire) &&
+                       m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed);
+            }
+
+            uint64_t dropped() const {
+                return m_dropped.load(std::memory_order_relaxed);
+            }
+
+          private:
+            const std::unique_ptr<uint8_t[]> m_buffer;
+            const size_t m_capacity;
+
+            // Keep the indices written by the producer and by the consumer on separate cache lines.
+            alignas(64) std::atomic<uint64_t> m_head{0};
+            uint64_t m_cachedTail{0};
+            std::atomic<uint64_t> m_dropped{0};
+            alignas(64) std::atomic<uint64_t> m_tail{0};
+            std::atomic<bool> m_isOrphaned{false};
+        };
+
+    } // namespace detail
+
+    class AsyncLogger {
+      public:
+        // Receives the formatted messages, one batch at a time, from the writer thread.
+        using Sink = std::function<void(const std::string& batch)>;
+
+        static constexpr size_t DefaultRingCapacity = 64 * 1024;
+        static constexpr size_t MaxRecordSize = 2048;
+        static constexpr std::chrono::milliseconds WriteInterval{20};
+
+        explicit AsyncLogger(Sink sink, size_t ringCapacity = DefaultRingCapacity)
+            : m_sink(std::move(sink)), m_ringCapacity(ringCapacity) {
+        }
+
+        ~AsyncLogger() {
+            stop();
+        }
+
+        void start() {
+            std::unique_lock lock(m_mutex);
+            if (m_writerThread.joinable()) {
+                return;
+            }
+
+            m_stopRequested = false;
+            m_writerThread = std::thread([&]() { writerThread(); });
+            m_isRunning.store(true, std::memory_order_release);
+        }
+
+        // Write the pending messages and stop the writer thread. A message logged concurrently with stopping may only
+        // be written upon the next start.
+        void stop() {
+            {
+                std::unique_lock lock(m_mutex);
+                if (!m_writerThread.joinable()) {
+                    return;
+                }
+                m_isRunning.store(false, std::memory_order_release);
+                m_stopRequested = true;
+            }
+            m_wakeup.notify_all();
+            m_writerThread.join();
+        }
+
+        bool isRunning() const {
+            return m_isRunning.load(std::memory_order_acquire);
+        }
+
+        // Wait for the messages logged so far to be handed over to the sink. Returns early when the logger is stopping,
+        // since its last batch may not include the messages logged concurrently (see stop()).
+        void flush() {
+            std::unique_lock lock(m_mutex);
+            if (!m_writerThread.joinable() || m_stopRequested) {
+                return;
+            }
+
+            const uint64_t request = ++m_flushRequested;
+            m_wakeup.notify_all();
+            m_flushed.wait(lock, [&] { return m_flushCompleted >= request || m_stopRequested; });
+        }
+
+        // Returns false if the writer is not running, in which case the caller must log by other means.
+        bool vlog(const char* format, va_list va) {
+            if (!isRunning()) {
+                return false;
+            }
+
+            detail::Ring& ring = getThreadRing();
+            alignas(8) uint8_t record[MaxRecordSize];
+            constexpr size_t headerSize = sizeof(detail::RecordHeader);
+            detail::Encoder encoder(record + headerSize, sizeof(record) - headerSize);
+            detail::Conversion conversion;
+            for (const char* cursor = format; detail::FindConversion(cursor, conversion); cursor = conversion.end) {
+                int precision = conversion.precision;
+                if (conversion.hasStarWidth) {
+                    encoder.write(va_arg(va, int));
+                }
+                if (conversion.hasStarPrecision) {
+                    precision = va_arg(va, int);
+                    encoder.write(precision);
+                }
+
+                switch (conversion.type) {
+                case detail::ArgumentType::Int:
+                    encoder.write(va_arg(va, int));
+                    break;
+                case detail::ArgumentType::Long:
+                    encoder.write(va_arg(va, long));
+                    break;
+                case detail::ArgumentType::LongLong:
+                    encoder.write(va_arg(va, long long));
+                    break;
+                case detail::ArgumentType::IntMax:
+                    encoder.write(va_arg(va, intmax_t));
+                    break;
+                case detail::ArgumentType::Size:
+                    encoder.write(va_arg(va, size_t));
+                    break;
+                case detail::ArgumentType::PtrDiff:
+                    encoder.write(va_arg(va, ptrdiff_t));
+                    break;
+                case detail::ArgumentType::Double:
+                    encoder.write(va_arg(va, double));
+                    break;
+                case detail::ArgumentType::LongDouble:
+                    encoder.write(va_arg(va, long double));
+                    break;
+                case detail::ArgumentType::Pointer:
+                    encoder.write(va_arg(va, void*));
+                    break;
+                case detail::ArgumentType::String:
+                    encoder.writeString(va_arg(va, const char*), precision);
+                    break;
+                case detail::ArgumentType::WideString:
+                    encoder.writeString(va_arg(va, const wchar_t*), precision);
+                    break;
+                case detail::ArgumentType::Count:
+                    (void)va_arg(va, void*);
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            if (encoder.overflow()) {
+                // Too many arguments to fit in a record.
+                ring.countDrop();
+                return true;
+            }
+
+            const detail::RecordHeader header{(uint32_t)(sizeof(detail::RecordHeader) + encoder.size()),
+                                              0,
+                                              (int64_t)std::chrono::system_clock::now().time_since_epoch().count(),
+                                              format};
+            memcpy(record, &header, sizeof(header));
+            ring.write(record, header.size);
+            return true;
+        }
+
+        bool log(const char* format, ...) {
+            va_list va;
+            va_start(va, format);
+            const bool logged = vlog(format, va);
+            va_end(va);
+            return logged;
+        }
+
+        // The number of messages dropped because a ring was full.
+        uint64_t dropped() const {
+            std::unique_lock lock(m_ringsMutex);
+            uint64_t dropped = m_retiredDropped;
+            for (const auto& ring : m_rings) {
+                dropped += ring->dropped();
+            }
+            return dropped;
+        }
+
+      private:
+        // Each thread gets its ring upon its first message, and gives it up when it exits.
+        detail::Ring& getThreadRing() {
+            struct ThreadRing {
+                ~ThreadRing() {
+                    if (ring) {
+                        ring->orphan();
+                    }
+                }
+
+                uint64_t owner{0};
+                std::shared_ptr<detail::Ring> ring;
+            };
+            static thread_local ThreadRing threadRing;
+
+            if (threadRing.owner != m_id) {
+                if (threadRing.ring) {
+                    threadRing.ring->orphan();
+                }
+                threadRing.ring = std::make_shared<detail::Ring>(m_ringCapacity);
+                threadRing.owner = m_id;
+
+                std::unique_lock lock(m_ringsMutex);
+                m_rings.push_back(threadRing.ring);
+            }
+            return *threadRing.ring;
+        }
+
+        void writerThread() {
+            std::unique_lock lock(m_mutex);
+            while (true) {
+                m_wakeup.wait_for(lock, WriteInterval, [&] {
+                    return m_stopRequested || m_flushCompleted < m_flushRequested;
+                });
+                const bool isStopping = m_stopRequested;
+                const uint64_t flushRequest = m_flushRequested;
+                lock.unlock();
+
+                write();
+
+                lock.lock();
+                m_flushCompleted = flushRequest;
+                m_flushed.notify_all();
+                if (isStopping) {
+                    break;
+                }
+            }
+        }
+
+        // Format the pending messages of all threads in chronological order, and hand them over to the sink at once.
+        void write() {
+            std::vector<std::shared_ptr<detail::Ring>> rings;
+            {
+                std::unique_lock lock(m_ringsMutex);
+                rings = m_rings;
+            }
+
+            m_records.clear();
+            uint64_t dropped = 0;
+            for (const auto& ring : rings) {
+                // Read the counter first, so that a drop is never reported ahead of the messages that preceded it.
+                dropped += ring->dropped();
+                ring->read(m_records);
+            }
+
+            m_entries.clear();
+            for (size_t offset = 0; offset + sizeof(detail::RecordHeader) <= m_records.size();) {
+                detail::RecordHeader header;
+                memcpy(&header, m_records.data() + offset, sizeof(header));
+                m_entries.push_back({header.time, offset});
+                offset += header.size;
+            }
+            std::stable_sort(m_entries.begin(), m_entries.end(), [](const Entry& a, const Entry& b) {
+                return a.time < b.time;
+            });
+
+            m_batch.clear();
+            for (const auto& entry : m_entries) {
+                detail::RecordHeader header;
+                memcpy(&header, m_records.data() + entry.offset, sizeof(header));
+                appendTimestamp(header.time);
+                if (!detail::FormatRecord(m_batch,
+                                          header,
+                                          m_records.data() + entry.offset + sizeof(header),
+                                          header.size - sizeof(header))) {
+                    m_batch += "<truncated>\n";
+                }
+            }
+
+            {
+                std::unique_lock lock(m_ringsMutex);
+                dropped += m_retiredDropped;
+                for (auto it = m_rings.begin(); it != m_rings.end();) {
+                    if ((*it)->isRetired()) {
+                        m_retiredDropped += (*it)->dropped();
+                        it = m_rings.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+            if (dropped > m_droppedReported) {
+                appendTimestamp((int64_t)std::chrono::system_clock::now().time_since_epoch().count());
+                detail::AppendFormatted(
+                    m_batch, "%llu log messages were dropped\n", (unsigned long long)(dropped - m_droppedReported));
+                m_droppedReported = dropped;
+            }
+
+            if (!m_batch.empty()) {
+                m_sink(m_batch);
+            }
+        }
+
+        // Same prefix as the synchronous logging, which only changes once per second.
+        void appendTimestamp(int64_t time) {
+            const std::time_t seconds = std::chrono::system_clock::to_time_t(
+                std::chrono::system_clock::time_point(std::chrono::system_clock::duration(time)));
+            if (seconds != m_prefixTime) {
+                char buffer[64];
+                const size_t length =
+                    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S %z: ", std::localtime(&seconds));
+                m_prefix.assign(buffer, length);
+                m_prefixTime = seconds;
+            }
+            m_batch += m_prefix;
+        }
+
+        struct Entry {
+            int64_t time;
+            size_t offset;
+        };
+
+        inline static std::atomic<uint64_t> s_nextId{1};
+
+        const uint64_t m_id{s_nextId++};
+        const Sink m_sink;
+        const size_t m_ringCapacity;
+        std::atomic<bool> m_isRunning{false};
+
+        mutable std::mutex m_ringsMutex;
+        std::vector<std::shared_ptr<detail::Ring>> m_rings;
+        uint64_t m_retiredDropped{0};
+
+        std::mutex m_mutex;
+        std::condition_variable m_wakeup;
+        std::condition_variable m_flushed;
+        std::thread m_writerThread;
+        bool m_stopRequested{false};
+        uint64_t m_flushRequested{0};
+        uint64_t m_flushCompleted{0};
+
+        // Only accessed by the writer thread.
+        std::vector<uint8_t> m_records;
+        std::vector<Entry> m_entries;
+        std::string m_batch;
+        std::string m_prefix;
+        std::time_t m_prefixTime{-1};
+        uint64_t m_droppedReported{0};
+    };
+
+} // namespace virtualdesktop_openxr::log
@@ -0,0 +1,131 @@
+// *********** THIS FILE IS GENERATED - DO NOT EDIT ***********
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+namespace virtualdesktop_openxr::capture::atoms {
+
+
+	// Auto-generated masks of the parameters that are atoms (handles, paths and system IDs), or that point to atoms:
+	// bit N is set for the N-th parameter.
+	inline constexpr uint32_t xrEnumerateInstanceExtensionProperties = 0x0;
+	inline constexpr uint32_t xrCreateInstance = 0x2;
+	inline constexpr uint32_t xrDestroyInstance = 0x1;
+	inline constexpr uint32_t xrGetInstanceProperties = 0x1;
+	inline constexpr uint32_t xrPollEvent = 0x1;
+	inline constexpr uint32_t xrResultToString = 0x1;
+	inline constexpr uint32_t xrStructureTypeToString = 0x1;
+	inline constexpr uint32_t xrGetSystem = 0x5;
+	inline constexpr uint32_t xrGetSystemProperties = 0x3;
+	inline constexpr uint32_t xrEnumerateEnvironmentBlendModes = 0x3;
+	inline constexpr uint32_t xrCreateSession = 0x5;
+	inline constexpr uint32_t xrDestroySession = 0x1;
+	inline constexpr uint32_t xrEnumerateReferenceSpaces = 0x1;
+	inline constexpr uint32_t xrCreateReferenceSpace = 0x5;
+	inline constexpr uint32_t xrGetReferenceSpaceBoundsRect = 0x1;
+	inline constexpr uint32_t xrCreateActionSpace = 0x5;
+	inline constexpr uint32_t xrLocateSpace = 0x3;
+	inline constexpr uint32_t xrDestroySpace = 0x1;
+	inline constexpr uint32_t xrEnumerateViewConfigurations = 0x3;
+	inline constexpr uint32_t xrGetViewConfigurationProperties = 0x3;
+	inline constexpr uint32_t xrEnumerateViewConfigurationViews = 0x3;
+	inline constexpr uint32_t xrEnumerateSwapchainFormats = 0x1;
+	inline constexpr uint32_t xrCreateSwapchain = 0x5;
+	inline constexpr uint32_t xrDestroySwapchain = 0x1;
+	inline constexpr uint32_t xrEnumerateSwapchainImages = 0x1;
+	inline constexpr uint32_t xrAcquireSwapchainImage = 0x1;
+	inline constexpr uint32_t xrWaitSwapchainImage = 0x1;
+	inline constexpr uint32_t xrReleaseSwapchainImage = 0x1;
+	inline constexpr uint32_t xrBeginSession = 0x1;
+	inline constexpr uint32_t xrEndSession = 0x1;
+	inline constexpr uint32_t xrRequestExitSession = 0x1;
+	inline constexpr uint32_t xrWaitFrame = 0x1;
+	inline constexpr uint32_t xrBeginFrame = 0x1;
+	inline constexpr uint32_t xrEndFrame = 0x1;
+	inline constexpr uint32_t xrLocateViews = 0x1;
+	inline constexpr uint32_t xrStringToPath = 0x5;
+	inline constexpr uint32_t xrPathToString = 0x3;
+	inline constexpr uint32_t xrCreateActionSet = 0x5;
+	inline constexpr uint32_t xrDestroyActionSet = 0x1;
+	inline constexpr uint32_t xrCreateAction = 0x5;
+	inline constexpr uint32_t xrDestroyAction = 0x1;
+	inline constexpr uint32_t xrSuggestInteractionProfileBindings = 0x1;
+	inline constexpr uint32_t xrAttachSessionActionSets = 0x1;
+	inline constexpr uint32_t xrGetCurrentInteractionProfile = 0x3;
+	inline constexpr uint32_t xrGetActionStateBoolean = 0x1;
+	inline constexpr uint32_t xrGetActionStateFloat = 0x1;
+	inline constexpr uint32_t xrGetActionStateVector2f = 0x1;
+	inline constexpr uint32_t xrGetActionStatePose = 0x1;
+	inline constexpr uint32_t xrSyncActions = 0x1;
+	inline constexpr uint32_t xrEnumerateBoundSourcesForAction = 0x11;
+	inline constexpr uint32_t xrGetInputSourceLocalizedName = 0x1;
+	inline constexpr uint32_t xrApplyHapticFeedback = 0x1;
+	inline constexpr uint32_t xrStopHapticFeedback = 0x1;
+	inline constexpr uint32_t xrLocateSpaces = 0x1;
+	inline constexpr uint32_t xrGetOpenGLGraphicsRequirementsKHR = 0x3;
+	inline constexpr uint32_t xrGetVulkanInstanceExtensionsKHR = 0x3;
+	inline constexpr uint32_t xrGetVulkanDeviceExtensionsKHR = 0x3;
+	inline constexpr uint32_t xrGetVulkanGraphicsDeviceKHR = 0x3;
+	inline constexpr uint32_t xrGetVulkanGraphicsRequirementsKHR = 0x3;
+	inline constexpr uint32_t xrGetD3D11GraphicsRequirementsKHR = 0x3;
+	inline constexpr uint32_t xrGetD3D12GraphicsRequirementsKHR = 0x3;
+	inline constexpr uint32_t xrGetVisibilityMaskKHR = 0x1;
+	inline constexpr uint32_t xrConvertWin32PerformanceCounterToTimeKHR = 0x1;
+	inline constexpr uint32_t xrConvertTimeToWin32PerformanceCounterKHR = 0x1;
+	inline constexpr uint32_t xrConvertTimespecTimeToTimeKHR = 0x1;
+	inline constexpr uint32_t xrConvertTimeToTimespecTimeKHR = 0x1;
+	inline constexpr uint32_t xrCreateVulkanInstanceKHR = 0x1;
+	inline constexpr uint32_t xrCreateVulkanDeviceKHR = 0x1;
+	inline constexpr uint32_t xrGetVulkanGraphicsDevice2KHR = 0x1;
+	inline constexpr uint32_t xrGetVulkanGraphicsRequirements2KHR = 0x3;
+	inline constexpr uint32_t xrLocateSpacesKHR = 0x1;
+	inline constexpr uint32_t xrCreateHandTrackerEXT = 0x5;
+	inline constexpr uint32_t xrDestroyHandTrackerEXT = 0x1;
+	inline constexpr uint32_t xrLocateHandJointsEXT = 0x1;
+	inline constexpr uint32_t xrCreateBodyTrackerFB = 0x5;
+	inline constexpr uint32_t xrDestroyBodyTrackerFB = 0x1;
+	inline constexpr uint32_t xrLocateBodyJointsFB = 0x1;
+	inline constexpr uint32_t xrGetBodySkeletonFB = 0x1;
+	inline constexpr uint32_t xrEnumerateDisplayRefreshRatesFB = 0x1;
+	inline constexpr uint32_t xrGetDisplayRefreshRateFB = 0x1;
+	inline constexpr uint32_t xrRequestDisplayRefreshRateFB = 0x1;
+	inline constexpr uint32_t xrEnumerateViveTrackerPathsHTCX = 0x1;
+	inline constexpr uint32_t xrGetAudioOutputDeviceGuidOculus = 0x1;
+	inline constexpr uint32_t xrGetAudioInputDeviceGuidOculus = 0x1;
+	inline constexpr uint32_t xrCreateFaceTrackerFB = 0x5;
+	inline constexpr uint32_t xrDestroyFaceTrackerFB = 0x1;
+	inline constexpr uint32_t xrGetFaceExpressionWeightsFB = 0x1;
+	inline constexpr uint32_t xrCreateEyeTrackerFB = 0x5;
+	inline constexpr uint32_t xrDestroyEyeTrackerFB = 0x1;
+	inline constexpr uint32_t xrGetEyeGazesFB = 0x1;
+	inline constexpr uint32_t xrSuggestBodyTrackingCalibrationOverrideMETA = 0x1;
+	inline constexpr uint32_t xrResetBodyTrackingCalibrationMETA = 0x1;
+	inline constexpr uint32_t xrRequestBodyTrackingFidelityMETA = 0x1;
+	inline constexpr uint32_t xrCreateFaceTracker2FB = 0x5;
+	inline constexpr uint32_t xrDestroyFaceTracker2FB = 0x1;
+	inline constexpr uint32_t xrGetFaceExpressionWeights2FB = 0x1;
+	inline constexpr uint32_t xrGetRecommendedLayerResolutionMETA = 0x1;
+
+
+} // namespace virtualdesktop_openxr::capture::atoms
+
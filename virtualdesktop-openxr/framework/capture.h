@@ -0,0 +1,832 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+// Capture of the OpenXR API calls going through the dispatch layer, for replay by the benchmarks tool. Arguments are
+// serialized according to their C type, which lets the replayer decode them from the signature of the function alone:
+// - scalars, enums and handles are stored by value;
+// - input strings and input structures (with their next chain and the arrays they point to) are stored deeply;
+// - output structures only have their shape (structure types and capacities) stored, so they can be reallocated;
+// - after the call, the output handles, atoms (paths, system IDs) and frame state are stored for translation.
+// Which parameters hold atoms is decided from the registry by the dispatch generator (see capture.gen.h), since paths
+// and system IDs are plain uint64_t in C.
+// This header is shared between the runtime (capturing) and the benchmarks tool (replaying).
+
+namespace virtualdesktop_openxr::capture {
+
+    static constexpr uint32_t FileMagic = 0x43584456; // 'VDXC'
+    static constexpr uint32_t FileVersion = 2;
+
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t reserved;
+    };
+
+    enum class RecordType : uint8_t {
+        // Associate an API name with the identifier used by the following calls. Followed by the name.
+        ApiName = 0,
+
+        // An API call, in order of completion. Followed by the payload.
+        Call = 1,
+    };
+
+    struct ApiNameRecord {
+        uint16_t api;
+        uint16_t length;
+    };
+
+    struct CallRecord {
+        uint16_t api;
+        uint16_t thread;
+        int32_t result;
+        int64_t startTime; // Nanoseconds since the start of the capture.
+        int64_t duration;  // Nanoseconds.
+        uint32_t payloadSize;
+    };
+    // Written as-is, including the 4 bytes of trailing padding which are always zero: '<HHiqqI4x'. Must match
+    // scripts/Analyze-Trace.py.
+    static_assert(sizeof(CallRecord) == 32);
+    static_assert(offsetof(CallRecord, startTime) == 8 && offsetof(CallRecord, payloadSize) == 24);
+
+    namespace detail {
+
+        template <typename T, typename = void>
+        struct IsComplete : std::false_type {};
+        template <typename T>
+        struct IsComplete<T, std::void_t<decltype(sizeof(T))>> : std::true_type {};
+
+        template <typename T, typename = void>
+        struct IsStructure : std::false_type {};
+        template <typename T>
+        struct IsStructure<T, std::void_t<decltype(std::declval<T&>().type), decltype(std::declval<T&>().next)>>
+            : std::true_type {};
+
+        // Handles are pointers to opaque types on 64-bit and integers on 32-bit.
+        template <typename T>
+        constexpr bool IsHandle = std::is_pointer_v<T> && std::is_class_v<std::remove_pointer_t<T>> &&
+                                  !IsComplete<std::remove_pointer_t<T>>::value;
+
+        // Types that can hold a value produced by the runtime that the replayer must translate. Whether a parameter of
+        // such a type is an atom comes from the masks in capture.gen.h.
+        template <typename T>
+        constexpr bool IsAtomType = IsHandle<T> || std::is_same_v<T, uint64_t>;
+
+        template <typename T>
+        uint64_t AtomToValue(T atom) {
+            if constexpr (IsHandle<T>) {
+                return (uint64_t)reinterpret_cast<uintptr_t>(atom);
+            } else {
+                return (uint64_t)atom;
+            }
+        }
+
+        template <typename T>
+        T ValueToAtom(uint64_t value) {
+            if constexpr (IsHandle<T>) {
+                return reinterpret_cast<T>((uintptr_t)value);
+            } else {
+                return (T)value;
+            }
+        }
+
+    } // namespace detail
+
+    // The size of a structure from its type, or 0 when the type is not known.
+    inline uint32_t GetStructureSize(XrStructureType type) {
+        switch (type) {
+#define CAPTURE_STRUCTURE_SIZE(name, structureType)                                                                    \
+    case structureType:                                                                                                \
+        return (uint32_t)sizeof(name);
+            XR_LIST_STRUCTURE_TYPES(CAPTURE_STRUCTURE_SIZE)
+#undef CAPTURE_STRUCTURE_SIZE
+        default:
+            return 0;
+        }
+    }
+
+    // Output structures whose content must be kept because they carry inputs (capacities) for arrays they point to.
+    inline bool IsOutputWithCapacities(XrStructureType type) {
+        switch (type) {
+        case XR_TYPE_HAND_JOINT_LOCATIONS_EXT:
+        case XR_TYPE_HAND_JOINT_VELOCITIES_EXT:
+        case XR_TYPE_BODY_JOINT_LOCATIONS_FB:
+        case XR_TYPE_BODY_SKELETON_FB:
+        case XR_TYPE_SPACE_LOCATIONS_KHR:
+        case XR_TYPE_SPACE_VELOCITIES_KHR:
+        case XR_TYPE_VISIBILITY_MASK_KHR:
+        case XR_TYPE_FACE_EXPRESSION_WEIGHTS_FB:
+        case XR_TYPE_FACE_EXPRESSION_WEIGHTS2_FB:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    class Encoder {
+      public:
+        Encoder(std::vector<uint8_t>& buffer) : m_buffer(buffer) {
+        }
+
+        void write(const void* data, size_t size) {
+            const auto bytes = reinterpret_cast<const uint8_t*>(data);
+            m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+        }
+
+        template <typename T>
+        void write(const T& value) {
+            write(&value, sizeof(value));
+        }
+
+        void writeString(const char* string) {
+            const uint32_t length = string ? (uint32_t)strlen(string) : UINT32_MAX;
+            write(length);
+            if (string) {
+                write(string, length);
+            }
+        }
+
+        // Serialize an argument before the call.
+        template <typename T>
+        void writeArgument(const T& argument) {
+            if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+                write(argument);
+            } else if constexpr (detail::IsHandle<T>) {
+                write(detail::AtomToValue(argument));
+            } else if constexpr (std::is_same_v<T, const char*>) {
+                writeString(argument);
+            } else if constexpr (std::is_pointer_v<T>) {
+                using Pointee = std::remove_pointer_t<T>;
+                using Value = std::remove_const_t<Pointee>;
+                if constexpr (std::is_const_v<Pointee>) {
+                    write<uint8_t>(argument != nullptr);
+                    if (argument) {
+                        if constexpr (detail::IsStructure<Value>::value) {
+                            writeChain(argument, sizeof(Value));
+                        } else if constexpr (detail::IsComplete<Value>::value) {
+                            write(*argument);
+                        }
+                    }
+                } else {
+                    // Buffers follow the (capacityInput, countOutput) pair of the two-call idiom.
+                    const uint32_t count = !argument ? 0 : m_capacityState == 2 ? m_capacity : 1;
+                    write(count);
+                    if constexpr (detail::IsStructure<Value>::value) {
+                        if (count) {
+                            writeShape(argument, sizeof(Value));
+                        }
+                    }
+                }
+            }
+
+            if constexpr (std::is_same_v<T, uint32_t>) {
+                m_capacity = argument;
+                m_capacityState = 1;
+            } else if constexpr (std::is_same_v<T, uint32_t*>) {
+                m_capacityState = m_capacityState == 1 ? 2 : 0;
+            } else {
+                m_capacityState = 0;
+            }
+        }
+
+        // Serialize the outputs needed to translate atoms and time after the call.
+        template <typename T>
+        void writeOutput(const T& argument, bool isAtom, bool succeeded) {
+            if constexpr (std::is_pointer_v<T> && !std::is_const_v<std::remove_pointer_t<T>>) {
+                using Value = std::remove_pointer_t<T>;
+                if constexpr (detail::IsAtomType<Value>) {
+                    if (isAtom) {
+                        write<uint8_t>(succeeded && argument);
+                        if (succeeded && argument) {
+                            write(detail::AtomToValue(*argument));
+                        }
+                    }
+                } else if constexpr (std::is_same_v<Value, XrFrameState>) {
+                    write<uint8_t>(succeeded && argument);
+                    if (succeeded && argument) {
+                        write(argument->predictedDisplayTime);
+                        write(argument->predictedDisplayPeriod);
+                    }
+                }
+            }
+        }
+
+      private:
+        // A structure and its next chain. Structures of unknown types are dropped from the chain.
+        void writeChain(const void* structure, uint32_t headSize) {
+            auto entry = reinterpret_cast<const XrBaseInStructure*>(structure);
+            bool isHead = true;
+            while (entry) {
+                uint32_t size = GetStructureSize(entry->type);
+                if (!size && isHead) {
+                    size = headSize;
+                }
+                if (size) {
+                    write(entry->type);
+                    write(size);
+                    write(entry, size);
+                    writeReferencedData(entry);
+                }
+                isHead = false;
+                entry = entry->next;
+            }
+            write(XR_TYPE_UNKNOWN);
+        }
+
+        void writeShape(const void* structure, uint32_t headSize) {
+            auto entry = reinterpret_cast<const XrBaseInStructure*>(structure);
+            bool isHead = true;
+            while (entry) {
+                uint32_t size = GetStructureSize(entry->type);
+                if (!size && isHead) {
+                    size = headSize;
+                }
+                if (size) {
+                    write(entry->type);
+                    write(size);
+                    const bool hasContent = IsOutputWithCapacities(entry->type);
+                    write<uint8_t>(hasContent);
+                    if (hasContent) {
+                        write(entry, size);
+                    }
+                }
+                isHead = false;
+                entry = entry->next;
+            }
+            write(XR_TYPE_UNKNOWN);
+        }
+
+        template <typename T>
+        void writeArray(const T* array, uint32_t count) {
+            write<uint8_t>(array != nullptr);
+            if (array) {
+                write(array, count * sizeof(T));
+            }
+        }
+
+        template <typename T>
+        void writeStructureArray(const T* array, uint32_t count) {
+            write<uint8_t>(array != nullptr);
+            for (uint32_t i = 0; array && i < count; i++) {
+                writeChain(&array[i], sizeof(T));
+            }
+        }
+
+        void writeStrings(const char* const* strings, uint32_t count) {
+            write<uint8_t>(strings != nullptr);
+            for (uint32_t i = 0; strings && i < count; i++) {
+                writeString(strings[i]);
+            }
+        }
+
+        // The arrays pointed to by the input structures that matter for replay.
+        void writeReferencedData(const XrBaseInStructure* entry) {
+            switch (entry->type) {
+            case XR_TYPE_INSTANCE_CREATE_INFO: {
+                const auto& createInfo = *reinterpret_cast<const XrInstanceCreateInfo*>(entry);
+                writeStrings(createInfo.enabledApiLayerNames, createInfo.enabledApiLayerCount);
+                writeStrings(createInfo.enabledExtensionNames, createInfo.enabledExtensionCount);
+                break;
+            }
+            case XR_TYPE_ACTION_CREATE_INFO: {
+                const auto& createInfo = *reinterpret_cast<const XrActionCreateInfo*>(entry);
+                writeArray(createInfo.subactionPaths, createInfo.countSubactionPaths);
+                break;
+            }
+            case XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING: {
+                const auto& suggestedBinding = *reinterpret_cast<const XrInteractionProfileSuggestedBinding*>(entry);
+                writeArray(suggestedBinding.suggestedBindings, suggestedBinding.countSuggestedBindings);
+                break;
+            }
+            case XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO: {
+                const auto& attachInfo = *reinterpret_cast<const XrSessionActionSetsAttachInfo*>(entry);
+                writeArray(attachInfo.actionSets, attachInfo.countActionSets);
+                break;
+            }
+            case XR_TYPE_ACTIONS_SYNC_INFO: {
+                const auto& syncInfo = *reinterpret_cast<const XrActionsSyncInfo*>(entry);
+                writeArray(syncInfo.activeActionSets, syncInfo.countActiveActionSets);
+                break;
+            }
+            case XR_TYPE_ACTIVE_ACTION_SET_PRIORITIES_EXT: {
+                const auto& priorities = *reinterpret_cast<const XrActiveActionSetPrioritiesEXT*>(entry);
+                writeArray(priorities.actionSetPriorities, priorities.actionSetPriorityCount);
+                break;
+            }
+            case XR_TYPE_SPACES_LOCATE_INFO_KHR: {
+                const auto& locateInfo = *reinterpret_cast<const XrSpacesLocateInfoKHR*>(entry);
+                writeArray(locateInfo.spaces, locateInfo.spaceCount);
+                break;
+            }
+            case XR_TYPE_FRAME_END_INFO: {
+                const auto& frameEndInfo = *reinterpret_cast<const XrFrameEndInfo*>(entry);
+                write<uint8_t>(frameEndInfo.layers != nullptr);
+                for (uint32_t i = 0; frameEndInfo.layers && i < frameEndInfo.layerCount; i++) {
+                    write<uint8_t>(frameEndInfo.layers[i] != nullptr);
+                    if (frameEndInfo.layers[i]) {
+                        writeChain(frameEndInfo.layers[i], sizeof(XrCompositionLayerBaseHeader));
+                    }
+                }
+                break;
+            }
+            case XR_TYPE_COMPOSITION_LAYER_PROJECTION: {
+                const auto& projection = *reinterpret_cast<const XrCompositionLayerProjection*>(entry);
+                writeStructureArray(projection.views, projection.viewCount);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        std::vector<uint8_t>& m_buffer;
+        uint32_t m_capacity{0};
+        uint32_t m_capacityState{0};
+    };
+
+    class Decoder {
+      public:
+        Decoder(const uint8_t* data, size_t size) : m_data(data), m_size(size) {
+        }
+
+        void read(void* data, size_t size) {
+            CHECK_MSG(m_offset + size <= m_size, "Truncated capture");
+            memcpy(data, m_data + m_offset, size);
+            m_offset += size;
+        }
+
+        template <typename T>
+        T read() {
+            T value;
+            read(&value, sizeof(value));
+            return value;
+        }
+
+        const char* readString() {
+            const auto length = read<uint32_t>();
+            if (length == UINT32_MAX) {
+                return nullptr;
+            }
+            const auto string = reinterpret_cast<char*>(allocate(length + 1));
+            read(string, length);
+            return string;
+        }
+
+        // Deserialize an argument, with the storage it references owned by the decoder.
+        template <typename T>
+        T readArgument() {
+            if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+                return read<T>();
+            } else if constexpr (detail::IsHandle<T>) {
+                return detail::ValueToAtom<T>(read<uint64_t>());
+            } else if constexpr (std::is_same_v<T, const char*>) {
+                return readString();
+            } else if constexpr (std::is_pointer_v<T>) {
+                using Pointee = std::remove_pointer_t<T>;
+                using Value = std::remove_const_t<Pointee>;
+                if constexpr (std::is_const_v<Pointee>) {
+                    if (!read<uint8_t>()) {
+                        return nullptr;
+                    }
+                    if constexpr (detail::IsStructure<Value>::value) {
+                        return reinterpret_cast<T>(readChain());
+                    } else if constexpr (detail::IsComplete<Value>::value) {
+                        const auto value = reinterpret_cast<Value*>(allocate(sizeof(Value)));
+                        read(value, sizeof(Value));
+                        return value;
+                    } else {
+                        return nullptr;
+                    }
+                } else {
+                    const auto count = read<uint32_t>();
+                    if (!count) {
+                        return nullptr;
+                    }
+                    if constexpr (detail::IsStructure<Value>::value) {
+                        return reinterpret_cast<T>(readShape(count));
+                    } else if constexpr (detail::IsComplete<Value>::value) {
+                        return reinterpret_cast<T>(allocate(count * sizeof(Value)));
+                    } else {
+                        return nullptr;
+                    }
+                }
+            } else {
+                return T{};
+            }
+        }
+
+        // Deserialize the value of an output captured after the call, if any.
+        template <typename T>
+        bool readOutput(const T& argument, bool isAtom, uint64_t& value) {
+            if constexpr (std::is_pointer_v<T> && !std::is_const_v<std::remove_pointer_t<T>>) {
+                using Value = std::remove_pointer_t<T>;
+                if constexpr (detail::IsAtomType<Value>) {
+                    if (isAtom && read<uint8_t>()) {
+                        value = read<uint64_t>();
+                        return true;
+                    }
+                } else if constexpr (std::is_same_v<Value, XrFrameState>) {
+                    if (read<uint8_t>()) {
+                        value = read<XrTime>();
+                        read<XrDuration>();
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+      private:
+        uint8_t* allocate(size_t size) {
+            m_allocations.push_back(std::make_unique<uint8_t[]>(std::max(size, (size_t)1)));
+            return m_allocations.back().get();
+        }
+
+        XrBaseInStructure* readChain() {
+            XrBaseInStructure* head = nullptr;
+            XrBaseInStructure** link = &head;
+            while (true) {
+                const auto type = read<XrStructureType>();
+                if (type == XR_TYPE_UNKNOWN) {
+                    break;
+                }
+                const auto size = read<uint32_t>();
+                CHECK_MSG(size >= sizeof(XrBaseInStructure), "Invalid capture");
+                const auto entry = reinterpret_cast<XrBaseInStructure*>(allocate(size));
+                read(entry, size);
+                entry->next = nullptr;
+                readReferencedData(entry);
+                *link = entry;
+                link = const_cast<XrBaseInStructure**>(&entry->next);
+            }
+            return head;
+        }
+
+        // Allocate count elements of the captured shape, contiguous for the head structure.
+        XrBaseOutStructure* readShape(uint32_t count) {
+            struct Entry {
+                XrStructureType type;
+                uint32_t size;
+                const uint8_t* content;
+            };
+            std::vector<Entry> entries;
+            while (true) {
+                const auto type = read<XrStructureType>();
+                if (type == XR_TYPE_UNKNOWN) {
+                    break;
+                }
+                const auto size = read<uint32_t>();
+                CHECK_MSG(size >= sizeof(XrBaseOutStructure), "Invalid capture");
+                const uint8_t* content = nullptr;
+                if (read<uint8_t>()) {
+                    CHECK_MSG(m_offset + size <= m_size, "Truncated capture");
+                    content = m_data + m_offset;
+                    m_offset += size;
+                }
+                entries.push_back({type, size, content});
+            }
+            if (entries.empty()) {
+                return nullptr;
+            }
+
+            const auto heads = allocate(count * entries[0].size);
+            for (uint32_t i = 0; i < count; i++) {
+                XrBaseOutStructure** link = nullptr;
+                for (size_t j = 0; j < entries.size(); j++) {
+                    const auto storage = j ? allocate(entries[j].size) : heads + i * entries[0].size;
+                    const auto entry = reinterpret_cast<XrBaseOutStructure*>(storage);
+                    if (entries[j].content) {
+                        memcpy(entry, entries[j].content, entries[j].size);
+                    }
+                    entry->type = entries[j].type;
+                    entry->next = nullptr;
+                    allocateReferencedData(entry);
+                    if (link) {
+                        *link = entry;
+                    }
+                    link = &entry->next;
+                }
+            }
+            return reinterpret_cast<XrBaseOutStructure*>(heads);
+        }
+
+        template <typename T>
+        const T* readArray(uint32_t count) {
+            if (!read<uint8_t>()) {
+                return nullptr;
+            }
+            const auto array = reinterpret_cast<T*>(allocate(count * sizeof(T)));
+            read(array, count * sizeof(T));
+            return array;
+        }
+
+        template <typename T>
+        const T* readStructureArray(uint32_t count) {
+            if (!read<uint8_t>()) {
+                return nullptr;
+            }
+            const auto array = reinterpret_cast<T*>(allocate(count * sizeof(T)));
+            for (uint32_t i = 0; i < count; i++) {
+                const auto entry = readChain();
+                CHECK_MSG(entry, "Invalid capture");
+                memcpy(&array[i], entry, sizeof(T));
+            }
+            return array;
+        }
+
+        const char* const* readStrings(uint32_t count) {
+            if (!read<uint8_t>()) {
+                return nullptr;
+            }
+            const auto strings = reinterpret_cast<const char**>(allocate(count * sizeof(const char*)));
+            for (uint32_t i = 0; i < count; i++) {
+                strings[i] = readString();
+            }
+            return strings;
+        }
+
+        void readReferencedData(XrBaseInStructure* entry) {
+            switch (entry->type) {
+            case XR_TYPE_INSTANCE_CREATE_INFO: {
+                auto& createInfo = *reinterpret_cast<XrInstanceCreateInfo*>(entry);
+                createInfo.enabledApiLayerNames = readStrings(createInfo.enabledApiLayerCount);
+                createInfo.enabledExtensionNames = readStrings(createInfo.enabledExtensionCount);
+                break;
+            }
+            case XR_TYPE_ACTION_CREATE_INFO: {
+                auto& createInfo = *reinterpret_cast<XrActionCreateInfo*>(entry);
+                createInfo.subactionPaths = readArray<XrPath>(createInfo.countSubactionPaths);
+                break;
+            }
+            case XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING: {
+                auto& suggestedBinding = *reinterpret_cast<XrInteractionProfileSuggestedBinding*>(entry);
+                suggestedBinding.suggestedBindings =
+                    readArray<XrActionSuggestedBinding>(suggestedBinding.countSuggestedBindings);
+                break;
+            }
+            case XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO: {
+                auto& attachInfo = *reinterpret_cast<XrSessionActionSetsAttachInfo*>(entry);
+                attachInfo.actionSets = readArray<XrActionSet>(attachInfo.countActionSets);
+                break;
+            }
+            case XR_TYPE_ACTIONS_SYNC_INFO: {
+                auto& syncInfo = *reinterpret_cast<XrActionsSyncInfo*>(entry);
+                syncInfo.activeActionSets = readArray<XrActiveActionSet>(syncInfo.countActiveActionSets);
+                break;
+            }
+            case XR_TYPE_ACTIVE_ACTION_SET_PRIORITIES_EXT: {
+                auto& priorities = *reinterpret_cast<XrActiveActionSetPrioritiesEXT*>(entry);
+                priorities.actionSetPriorities =
+                    readArray<XrActiveActionSetPriorityEXT>(priorities.actionSetPriorityCount);
+                break;
+            }
+            case XR_TYPE_SPACES_LOCATE_INFO_KHR: {
+                auto& locateInfo = *reinterpret_cast<XrSpacesLocateInfoKHR*>(entry);
+                locateInfo.spaces = readArray<XrSpace>(locateInfo.spaceCount);
+                break;
+            }
+            case XR_TYPE_FRAME_END_INFO: {
+                auto& frameEndInfo = *reinterpret_cast<XrFrameEndInfo*>(entry);
+                if (!read<uint8_t>()) {
+                    frameEndInfo.layers = nullptr;
+                    break;
+                }
+                const auto layers = reinterpret_cast<const XrCompositionLayerBaseHeader**>(
+                    allocate(frameEndInfo.layerCount * sizeof(const XrCompositionLayerBaseHeader*)));
+                for (uint32_t i = 0; i < frameEndInfo.layerCount; i++) {
+                    layers[i] =
+                        read<uint8_t>() ? reinterpret_cast<const XrCompositionLayerBaseHeader*>(readChain()) : nullptr;
+                }
+                frameEndInfo.layers = layers;
+                break;
+            }
+            case XR_TYPE_COMPOSITION_LAYER_PROJECTION: {
+                auto& projection = *reinterpret_cast<XrCompositionLayerProjection*>(entry);
+                projection.views = readStructureArray<XrCompositionLayerProjectionView>(projection.viewCount);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        template <typename T>
+        T* allocateArray(uint32_t count) {
+            return reinterpret_cast<T*>(allocate(count * sizeof(T)));
+        }
+
+        void allocateReferencedData(XrBaseOutStructure* entry) {
+            switch (entry->type) {
+            case XR_TYPE_HAND_JOINT_LOCATIONS_EXT: {
+                auto& locations = *reinterpret_cast<XrHandJointLocationsEXT*>(entry);
+                locations.jointLocations = allocateArray<XrHandJointLocationEXT>(locations.jointCount);
+                break;
+            }
+            case XR_TYPE_HAND_JOINT_VELOCITIES_EXT: {
+                auto& velocities = *reinterpret_cast<XrHandJointVelocitiesEXT*>(entry);
+                velocities.jointVelocities = allocateArray<XrHandJointVelocityEXT>(velocities.jointCount);
+                break;
+            }
+            case XR_TYPE_BODY_JOINT_LOCATIONS_FB: {
+                auto& locations = *reinterpret_cast<XrBodyJointLocationsFB*>(entry);
+                locations.jointLocations = allocateArray<XrBodyJointLocationFB>(locations.jointCount);
+                break;
+            }
+            case XR_TYPE_BODY_SKELETON_FB: {
+                auto& skeleton = *reinterpret_cast<XrBodySkeletonFB*>(entry);
+                skeleton.joints = allocateArray<XrBodySkeletonJointFB>(skeleton.jointCount);
+                break;
+            }
+            case XR_TYPE_SPACE_LOCATIONS_KHR: {
+                auto& locations = *reinterpret_cast<XrSpaceLocationsKHR*>(entry);
+                locations.locations = allocateArray<XrSpaceLocationDataKHR>(locations.locationCount);
+                break;
+            }
+            case XR_TYPE_SPACE_VELOCITIES_KHR: {
+                auto& velocities = *reinterpret_cast<XrSpaceVelocitiesKHR*>(entry);
+                velocities.velocities = allocateArray<XrSpaceVelocityDataKHR>(velocities.velocityCount);
+                break;
+            }
+            case XR_TYPE_VISIBILITY_MASK_KHR: {
+                auto& mask = *reinterpret_cast<XrVisibilityMaskKHR*>(entry);
+                mask.vertices = allocateArray<XrVector2f>(mask.vertexCapacityInput);
+                mask.indices = allocateArray<uint32_t>(mask.indexCapacityInput);
+                break;
+            }
+            case XR_TYPE_FACE_EXPRESSION_WEIGHTS_FB: {
+                auto& weights = *reinterpret_cast<XrFaceExpressionWeightsFB*>(entry);
+                weights.weights = allocateArray<float>(weights.weightCount);
+                weights.confidences = allocateArray<float>(weights.confidenceCount);
+                break;
+            }
+            case XR_TYPE_FACE_EXPRESSION_WEIGHTS2_FB: {
+                auto& weights = *reinterpret_cast<XrFaceExpressionWeights2FB*>(entry);
+                weights.weights = allocateArray<float>(weights.weightCount);
+                weights.confidences = allocateArray<float>(weights.confidenceCount);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        const uint8_t* const m_data;
+        const size_t m_size;
+        size_t m_offset{0};
+        std::vector<std::unique_ptr<uint8_t[]>> m_allocations;
+    };
+
+    // The capture file written by the runtime.
+    class Writer {
+      public:
+        Writer(const std::filesystem::path& path)
+            : m_file(path, std::ios::binary | std::ios::trunc), m_start(std::chrono::steady_clock::now()) {
+            const FileHeader header{FileMagic, FileVersion, 0};
+            m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+
+        bool isOpen() const {
+            return m_file.is_open();
+        }
+
+        int64_t now() const {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start)
+                .count();
+        }
+
+        void writeCall(const char* api,
+                       int32_t result,
+                       int64_t startTime,
+                       int64_t duration,
+                       const std::vector<uint8_t>& payload) {
+            // Each thread gets a small identifier, in order of first call.
+            static std::atomic<uint16_t> nextThread{0};
+            thread_local const uint16_t thread = nextThread++;
+
+            std::unique_lock lock(m_mutex);
+
+            // API names are string literals, so they can be compared by address.
+            auto it = m_apis.find(api);
+            if (it == m_apis.end()) {
+                it = m_apis.insert({api, (uint16_t)m_apis.size()}).first;
+                const ApiNameRecord record{it->second, (uint16_t)strlen(api)};
+                m_file.put((char)RecordType::ApiName);
+                m_file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+                m_file.write(api, record.length);
+            }
+
+            // Clear the padding, so that no uninitialized memory ends up in the file.
+            CallRecord record;
+            ZeroMemory(&record, sizeof(record));
+            record.api = it->second;
+            record.thread = thread;
+            record.result = result;
+            record.startTime = startTime;
+            record.duration = duration;
+            record.payloadSize = (uint32_t)payload.size();
+            m_file.put((char)RecordType::Call);
+            m_file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+            m_file.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+        }
+
+        void flush() {
+            std::unique_lock lock(m_mutex);
+            m_file.flush();
+        }
+
+      private:
+        std::mutex m_mutex;
+        std::ofstream m_file;
+        const std::chrono::steady_clock::time_point m_start;
+        std::map<const char*, uint16_t> m_apis;
+    };
+
+    namespace detail {
+        // Owns the writer for the lifetime of the process. Only touched by Start().
+        inline std::unique_ptr<Writer> g_writerOwner;
+    } // namespace detail
+
+    // Published once when capture is enabled, and read by every API call from any thread.
+    inline std::atomic<Writer*> g_writer{nullptr};
+
+    inline bool Start(const std::filesystem::path& path) {
+        if (g_writer.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        auto writer = std::make_unique<Writer>(path);
+        if (!writer->isOpen()) {
+            return false;
+        }
+        detail::g_writerOwner = std::move(writer);
+        g_writer.store(detail::g_writerOwner.get(), std::memory_order_release);
+        return true;
+    }
+
+    inline void Flush() {
+        if (Writer* writer = g_writer.load(std::memory_order_acquire)) {
+            writer->flush();
+        }
+    }
+
+    // Capture a call from the dispatch layer. This is a no-op unless capture is enabled. The atoms mask of the API
+    // comes from capture.gen.h.
+    class Call {
+      public:
+        template <typename... Args>
+        Call(const char* api, uint32_t atoms, const Args&... args) {
+            m_writer = g_writer.load(std::memory_order_acquire);
+            if (!m_writer) {
+                return;
+            }
+
+            m_api = api;
+            m_atoms = atoms;
+            m_startTime = m_writer->now();
+            Encoder encoder(m_payload);
+            (encoder.writeArgument(args), ...);
+        }
+
+        template <typename... Args>
+        void end(XrResult result, const Args&... args) {
+            if (!m_api) {
+                return;
+            }
+
+            const int64_t duration = m_writer->now() - m_startTime;
+            Encoder encoder(m_payload);
+            uint32_t index = 0;
+            (encoder.writeOutput(args, (m_atoms >> index++) & 1, XR_SUCCEEDED(result)), ...);
+            m_writer->writeCall(m_api, result, m_startTime, duration, m_payload);
+        }
+
+      private:
+        Writer* m_writer{nullptr};
+        const char* m_api{nullptr};
+        uint32_t m_atoms{0};
+        int64_t m_startTime{0};
+        std::vector<uint8_t> m_payload;
+    };
+
+} // namespace virtualdesktop_openxr::capture
@@ -24,6 +24,8 @@
 
 #include <runtime.h>
 
+#include "capture.h"
+#include "capture.gen.h"
 #include "dispatch.h"
 #include "log.h"
 
@@ -39,6 +41,7 @@ namespace RUNTIME_NAMESPACE {
     XrResult XRAPI_CALL xrDestroyInstance(XrInstance instance) {
         TraceLocalActivity(local);
         TraceLoggingWriteStart(local, "xrDestroyInstance");
+        capture::Call call("xrDestroyInstance", capture::atoms::xrDestroyInstance, instance);
 
         XrResult result;
         try {
@@ -52,6 +55,8 @@ namespace RUNTIME_NAMESPACE {
             result = XR_ERROR_RUNTIME_FAILURE;
         }
 
+        call.end(result, instance);
+        capture::Flush();
         TraceLoggingWriteStop(local, "xrDestroyInstance", TLArg(xr::ToCString(result), "Result"));
         if (XR_FAILED(result)) {
             ErrorLog("xrDestroyInstance failed with %s\n", xr::ToCString(result));
@@ -86,6 +91,7 @@ namespace RUNTIME_NAMESPACE {
     XrResult XRAPI_CALL xrGetInstanceProperties(XrInstance instance, XrInstanceProperties* instanceProperties) {
         TraceLocalActivity(local);
         TraceLoggingWriteStart(local, "xrGetInstanceProperties");
+        capture::Call call("xrGetInstanceProperties", capture::atoms::xrGetInstanceProperties, instance, instanceProperties);
 
         XrResult result;
         try {
@@ -96,6 +102,7 @@ namespace RUNTIME_NAMESPACE {
             result = XR_ERROR_RUNTIME_FAILURE;
         }
 
+        call.end(result, instance, instanceProperties);
         TraceLoggingWriteStop(local, "xrGetInstanceProperties", TLArg(xr::ToCString(result), "Result"));
         if (XR_FAILED(result)) {
             ErrorLog("xrGetInstanceProperties failed with %s\n", xr::ToCString(result));
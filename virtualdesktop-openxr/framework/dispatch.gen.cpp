@@ -25,6 +25,8 @@
 
 #include <runtime.h>
 
+#include "capture.h"
+#include "capture.gen.h"
 #include "dispatch.h"
 #include "log.h"
 
@@ -41,6 +43,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateInstanceExtensionProperties(const char* layerName, uint32_t propertyCapacityInput, uint32_t* propertyCountOutput, XrExtensionProperties* properties) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateInstanceExtensionProperties");
+		capture::Call call("xrEnumerateInstanceExtensionProperties", capture::atoms::xrEnumerateInstanceExtensionProperties, layerName, propertyCapacityInput, propertyCountOutput, properties);
 
 		XrResult result;
 		try {
@@ -51,6 +54,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, layerName, propertyCapacityInput, propertyCountOutput, properties);
 		TraceLoggingWriteStop(local, "xrEnumerateInstanceExtensionProperties", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrEnumerateInstanceExtensionProperties failed with %s\n", xr::ToCString(result));
@@ -62,6 +66,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateInstance(const XrInstanceCreateInfo* createInfo, XrInstance* instance) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateInstance");
+		capture::Call call("xrCreateInstance", capture::atoms::xrCreateInstance, createInfo, instance);
 
 		XrResult result;
 		try {
@@ -72,6 +77,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, createInfo, instance);
 		TraceLoggingWriteStop(local, "xrCreateInstance", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrCreateInstance failed with %s\n", xr::ToCString(result));
@@ -83,6 +89,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrPollEvent(XrInstance instance, XrEventDataBuffer* eventData) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrPollEvent");
+		capture::Call call("xrPollEvent", capture::atoms::xrPollEvent, instance, eventData);
 
 		XrResult result;
 		try {
@@ -93,6 +100,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, eventData);
 		TraceLoggingWriteStop(local, "xrPollEvent", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrPollEvent failed with %s\n", xr::ToCString(result));
@@ -104,6 +112,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrResultToString(XrInstance instance, XrResult value, char buffer[XR_MAX_RESULT_STRING_SIZE]) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrResultToString");
+		capture::Call call("xrResultToString", capture::atoms::xrResultToString, instance, value, buffer);
 
 		XrResult result;
 		try {
@@ -114,6 +123,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, value, buffer);
 		TraceLoggingWriteStop(local, "xrResultToString", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrResultToString failed with %s\n", xr::ToCString(result));
@@ -125,6 +135,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrStructureTypeToString(XrInstance instance, XrStructureType value, char buffer[XR_MAX_STRUCTURE_NAME_SIZE]) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrStructureTypeToString");
+		capture::Call call("xrStructureTypeToString", capture::atoms::xrStructureTypeToString, instance, value, buffer);
 
 		XrResult result;
 		try {
@@ -135,6 +146,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, value, buffer);
 		TraceLoggingWriteStop(local, "xrStructureTypeToString", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrStructureTypeToString failed with %s\n", xr::ToCString(result));
@@ -146,6 +158,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetSystem(XrInstance instance, const XrSystemGetInfo* getInfo, XrSystemId* systemId) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetSystem");
+		capture::Call call("xrGetSystem", capture::atoms::xrGetSystem, instance, getInfo, systemId);
 
 		XrResult result;
 		try {
@@ -156,6 +169,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, getInfo, systemId);
 		TraceLoggingWriteStop(local, "xrGetSystem", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetSystem failed with %s\n", xr::ToCString(result));
@@ -167,6 +181,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetSystemProperties(XrInstance instance, XrSystemId systemId, XrSystemProperties* properties) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetSystemProperties");
+		capture::Call call("xrGetSystemProperties", capture::atoms::xrGetSystemProperties, instance, systemId, properties);
 
 		XrResult result;
 		try {
@@ -177,6 +192,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, systemId, properties);
 		TraceLoggingWriteStop(local, "xrGetSystemProperties", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetSystemProperties failed with %s\n", xr::ToCString(result));
@@ -188,6 +204,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateEnvironmentBlendModes(XrInstance instance, XrSystemId systemId, XrViewConfigurationType viewConfigurationType, uint32_t environmentBlendModeCapacityInput, uint32_t* environmentBlendModeCountOutput, XrEnvironmentBlendMode* environmentBlendModes) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateEnvironmentBlendModes");
+		capture::Call call("xrEnumerateEnvironmentBlendModes", capture::atoms::xrEnumerateEnvironmentBlendModes, instance, systemId, viewConfigurationType, environmentBlendModeCapacityInput, environmentBlendModeCountOutput, environmentBlendModes);
 
 		XrResult result;
 		try {
@@ -198,6 +215,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, systemId, viewConfigurationType, environmentBlendModeCapacityInput, environmentBlendModeCountOutput, environmentBlendModes);
 		TraceLoggingWriteStop(local, "xrEnumerateEnvironmentBlendModes", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrEnumerateEnvironmentBlendModes failed with %s\n", xr::ToCString(result));
@@ -209,6 +227,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateSession(XrInstance instance, const XrSessionCreateInfo* createInfo, XrSession* session) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateSession");
+		capture::Call call("xrCreateSession", capture::atoms::xrCreateSession, instance, createInfo, session);
 
 		XrResult result;
 		try {
@@ -219,6 +238,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, createInfo, session);
 		TraceLoggingWriteStop(local, "xrCreateSession", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrCreateSession failed with %s\n", xr::ToCString(result));
@@ -230,6 +250,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrDestroySession(XrSession session) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrDestroySession");
+		capture::Call call("xrDestroySession", capture::atoms::xrDestroySession, session);
 
 		XrResult result;
 		try {
@@ -240,6 +261,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session);
 		TraceLoggingWriteStop(local, "xrDestroySession", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrDestroySession failed with %s\n", xr::ToCString(result));
@@ -251,6 +273,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateReferenceSpaces(XrSession session, uint32_t spaceCapacityInput, uint32_t* spaceCountOutput, XrReferenceSpaceType* spaces) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateReferenceSpaces");
+		capture::Call call("xrEnumerateReferenceSpaces", capture::atoms::xrEnumerateReferenceSpaces, session, spaceCapacityInput, spaceCountOutput, spaces);
 
 		XrResult result;
 		try {
@@ -261,6 +284,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, spaceCapacityInput, spaceCountOutput, spaces);
 		TraceLoggingWriteStop(local, "xrEnumerateReferenceSpaces", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrEnumerateReferenceSpaces failed with %s\n", xr::ToCString(result));
@@ -272,6 +296,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateReferenceSpace(XrSession session, const XrReferenceSpaceCreateInfo* createInfo, XrSpace* space) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateReferenceSpace");
+		capture::Call call("xrCreateReferenceSpace", capture::atoms::xrCreateReferenceSpace, session, createInfo, space);
 
 		XrResult result;
 		try {
@@ -282,6 +307,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, createInfo, space);
 		TraceLoggingWriteStop(local, "xrCreateReferenceSpace", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrCreateReferenceSpace failed with %s\n", xr::ToCString(result));
@@ -293,6 +319,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetReferenceSpaceBoundsRect(XrSession session, XrReferenceSpaceType referenceSpaceType, XrExtent2Df* bounds) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetReferenceSpaceBoundsRect");
+		capture::Call call("xrGetReferenceSpaceBoundsRect", capture::atoms::xrGetReferenceSpaceBoundsRect, session, referenceSpaceType, bounds);
 
 		XrResult result;
 		try {
@@ -303,6 +330,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, referenceSpaceType, bounds);
 		TraceLoggingWriteStop(local, "xrGetReferenceSpaceBoundsRect", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetReferenceSpaceBoundsRect failed with %s\n", xr::ToCString(result));
@@ -314,6 +342,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateActionSpace(XrSession session, const XrActionSpaceCreateInfo* createInfo, XrSpace* space) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateActionSpace");
+		capture::Call call("xrCreateActionSpace", capture::atoms::xrCreateActionSpace, session, createInfo, space);
 
 		XrResult result;
 		try {
@@ -324,6 +353,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, createInfo, space);
 		TraceLoggingWriteStop(local, "xrCreateActionSpace", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrCreateActionSpace failed with %s\n", xr::ToCString(result));
@@ -335,6 +365,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrLocateSpace(XrSpace space, XrSpace baseSpace, XrTime time, XrSpaceLocation* location) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrLocateSpace");
+		capture::Call call("xrLocateSpace", capture::atoms::xrLocateSpace, space, baseSpace, time, location);
 
 		XrResult result;
 		try {
@@ -345,6 +376,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, space, baseSpace, time, location);
 		TraceLoggingWriteStop(local, "xrLocateSpace", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrLocateSpace failed with %s\n", xr::ToCString(result));
@@ -356,6 +388,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrDestroySpace(XrSpace space) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrDestroySpace");
+		capture::Call call("xrDestroySpace", capture::atoms::xrDestroySpace, space);
 
 		XrResult result;
 		try {
@@ -366,6 +399,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, space);
 		TraceLoggingWriteStop(local, "xrDestroySpace", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrDestroySpace failed with %s\n", xr::ToCString(result));
@@ -377,6 +411,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateViewConfigurations(XrInstance instance, XrSystemId systemId, uint32_t viewConfigurationTypeCapacityInput, uint32_t* viewConfigurationTypeCountOutput, XrViewConfigurationType* viewConfigurationTypes) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateViewConfigurations");
+		capture::Call call("xrEnumerateViewConfigurations", capture::atoms::xrEnumerateViewConfigurations, instance, systemId, viewConfigurationTypeCapacityInput, viewConfigurationTypeCountOutput, viewConfigurationTypes);
 
 		XrResult result;
 		try {
@@ -387,6 +422,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, systemId, viewConfigurationTypeCapacityInput, viewConfigurationTypeCountOutput, viewConfigurationTypes);
 		TraceLoggingWriteStop(local, "xrEnumerateViewConfigurations", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrEnumerateViewConfigurations failed with %s\n", xr::ToCString(result));
@@ -398,6 +434,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetViewConfigurationProperties(XrInstance instance, XrSystemId systemId, XrViewConfigurationType viewConfigurationType, XrViewConfigurationProperties* configurationProperties) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetViewConfigurationProperties");
+		capture::Call call("xrGetViewConfigurationProperties", capture::atoms::xrGetViewConfigurationProperties, instance, systemId, viewConfigurationType, configurationProperties);
 
 		XrResult result;
 		try {
@@ -408,6 +445,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, systemId, viewConfigurationType, configurationProperties);
 		TraceLoggingWriteStop(local, "xrGetViewConfigurationProperties", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetViewConfigurationProperties failed with %s\n", xr::ToCString(result));
@@ -419,6 +457,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateViewConfigurationViews(XrInstance instance, XrSystemId systemId, XrViewConfigurationType viewConfigurationType, uint32_t viewCapacityInput, uint32_t* viewCountOutput, XrViewConfigurationView* views) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateViewConfigurationViews");
+		capture::Call call("xrEnumerateViewConfigurationViews", capture::atoms::xrEnumerateViewConfigurationViews, instance, systemId, viewConfigurationType, viewCapacityInput, viewCountOutput, views);
 
 		XrResult result;
 		try {
@@ -429,6 +468,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, systemId, viewConfigurationType, viewCapacityInput, viewCountOutput, views);
 		TraceLoggingWriteStop(local, "xrEnumerateViewConfigurationViews", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrEnumerateViewConfigurationViews failed with %s\n", xr::ToCString(result));
@@ -440,6 +480,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateSwapchainFormats(XrSession session, uint32_t formatCapacityInput, uint32_t* formatCountOutput, int64_t* formats) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateSwapchainFormats");
+		capture::Call call("xrEnumerateSwapchainFormats", capture::atoms::xrEnumerateSwapchainFormats, session, formatCapacityInput, formatCountOutput, formats);
 
 		XrResult result;
 		try {
@@ -450,6 +491,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, formatCapacityInput, formatCountOutput, formats);
 		TraceLoggingWriteStop(local, "xrEnumerateSwapchainFormats", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrEnumerateSwapchainFormats failed with %s\n", xr::ToCString(result));
@@ -461,6 +503,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateSwapchain(XrSession session, const XrSwapchainCreateInfo* createInfo, XrSwapchain* swapchain) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateSwapchain");
+		capture::Call call("xrCreateSwapchain", capture::atoms::xrCreateSwapchain, session, createInfo, swapchain);
 
 		XrResult result;
 		try {
@@ -471,6 +514,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, createInfo, swapchain);
 		TraceLoggingWriteStop(local, "xrCreateSwapchain", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrCreateSwapchain failed with %s\n", xr::ToCString(result));
@@ -482,6 +526,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrDestroySwapchain(XrSwapchain swapchain) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrDestroySwapchain");
+		capture::Call call("xrDestroySwapchain", capture::atoms::xrDestroySwapchain, swapchain);
 
 		XrResult result;
 		try {
@@ -492,6 +537,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, swapchain);
 		TraceLoggingWriteStop(local, "xrDestroySwapchain", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrDestroySwapchain failed with %s\n", xr::ToCString(result));
@@ -503,6 +549,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateSwapchainImages(XrSwapchain swapchain, uint32_t imageCapacityInput, uint32_t* imageCountOutput, XrSwapchainImageBaseHeader* images) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateSwapchainImages");
+		capture::Call call("xrEnumerateSwapchainImages", capture::atoms::xrEnumerateSwapchainImages, swapchain, imageCapacityInput, imageCountOutput, images);
 
 		XrResult result;
 		try {
@@ -513,6 +560,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, swapchain, imageCapacityInput, imageCountOutput, images);
 		TraceLoggingWriteStop(local, "xrEnumerateSwapchainImages", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrEnumerateSwapchainImages failed with %s\n", xr::ToCString(result));
@@ -524,6 +572,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrAcquireSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageAcquireInfo* acquireInfo, uint32_t* index) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrAcquireSwapchainImage");
+		capture::Call call("xrAcquireSwapchainImage", capture::atoms::xrAcquireSwapchainImage, swapchain, acquireInfo, index);
 
 		XrResult result;
 		try {
@@ -534,6 +583,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, swapchain, acquireInfo, index);
 		TraceLoggingWriteStop(local, "xrAcquireSwapchainImage", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrAcquireSwapchainImage failed with %s\n", xr::ToCString(result));
@@ -545,6 +595,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrWaitSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageWaitInfo* waitInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrWaitSwapchainImage");
+		capture::Call call("xrWaitSwapchainImage", capture::atoms::xrWaitSwapchainImage, swapchain, waitInfo);
 
 		XrResult result;
 		try {
@@ -555,6 +606,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, swapchain, waitInfo);
 		TraceLoggingWriteStop(local, "xrWaitSwapchainImage", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrWaitSwapchainImage failed with %s\n", xr::ToCString(result));
@@ -566,6 +618,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrReleaseSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageReleaseInfo* releaseInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrReleaseSwapchainImage");
+		capture::Call call("xrReleaseSwapchainImage", capture::atoms::xrReleaseSwapchainImage, swapchain, releaseInfo);
 
 		XrResult result;
 		try {
@@ -576,6 +629,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, swapchain, releaseInfo);
 		TraceLoggingWriteStop(local, "xrReleaseSwapchainImage", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrReleaseSwapchainImage failed with %s\n", xr::ToCString(result));
@@ -587,6 +641,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrBeginSession(XrSession session, const XrSessionBeginInfo* beginInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrBeginSession");
+		capture::Call call("xrBeginSession", capture::atoms::xrBeginSession, session, beginInfo);
 
 		XrResult result;
 		try {
@@ -597,6 +652,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, beginInfo);
 		TraceLoggingWriteStop(local, "xrBeginSession", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrBeginSession failed with %s\n", xr::ToCString(result));
@@ -608,6 +664,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEndSession(XrSession session) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEndSession");
+		capture::Call call("xrEndSession", capture::atoms::xrEndSession, session);
 
 		XrResult result;
 		try {
@@ -618,6 +675,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session);
 		TraceLoggingWriteStop(local, "xrEndSession", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrEndSession failed with %s\n", xr::ToCString(result));
@@ -629,6 +687,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrRequestExitSession(XrSession session) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrRequestExitSession");
+		capture::Call call("xrRequestExitSession", capture::atoms::xrRequestExitSession, session);
 
 		XrResult result;
 		try {
@@ -639,6 +698,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session);
 		TraceLoggingWriteStop(local, "xrRequestExitSession", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrRequestExitSession failed with %s\n", xr::ToCString(result));
@@ -650,6 +710,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrWaitFrame(XrSession session, const XrFrameWaitInfo* frameWaitInfo, XrFrameState* frameState) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrWaitFrame");
+		capture::Call call("xrWaitFrame", capture::atoms::xrWaitFrame, session, frameWaitInfo, frameState);
 
 		XrResult result;
 		try {
@@ -660,6 +721,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, frameWaitInfo, frameState);
 		TraceLoggingWriteStop(local, "xrWaitFrame", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrWaitFrame failed with %s\n", xr::ToCString(result));
@@ -671,6 +733,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrBeginFrame(XrSession session, const XrFrameBeginInfo* frameBeginInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrBeginFrame");
+		capture::Call call("xrBeginFrame", capture::atoms::xrBeginFrame, session, frameBeginInfo);
 
 		XrResult result;
 		try {
@@ -681,6 +744,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, frameBeginInfo);
 		TraceLoggingWriteStop(local, "xrBeginFrame", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrBeginFrame failed with %s\n", xr::ToCString(result));
@@ -692,6 +756,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEndFrame(XrSession session, const XrFrameEndInfo* frameEndInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEndFrame");
+		capture::Call call("xrEndFrame", capture::atoms::xrEndFrame, session, frameEndInfo);
 
 		XrResult result;
 		try {
@@ -702,6 +767,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, frameEndInfo);
 		TraceLoggingWriteStop(local, "xrEndFrame", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrEndFrame failed with %s\n", xr::ToCString(result));
@@ -713,6 +779,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrLocateViews(XrSession session, const XrViewLocateInfo* viewLocateInfo, XrViewState* viewState, uint32_t viewCapacityInput, uint32_t* viewCountOutput, XrView* views) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrLocateViews");
+		capture::Call call("xrLocateViews", capture::atoms::xrLocateViews, session, viewLocateInfo, viewState, viewCapacityInput, viewCountOutput, views);
 
 		XrResult result;
 		try {
@@ -723,6 +790,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, viewLocateInfo, viewState, viewCapacityInput, viewCountOutput, views);
 		TraceLoggingWriteStop(local, "xrLocateViews", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrLocateViews failed with %s\n", xr::ToCString(result));
@@ -734,6 +802,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrStringToPath(XrInstance instance, const char* pathString, XrPath* path) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrStringToPath");
+		capture::Call call("xrStringToPath", capture::atoms::xrStringToPath, instance, pathString, path);
 
 		XrResult result;
 		try {
@@ -744,6 +813,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, pathString, path);
 		TraceLoggingWriteStop(local, "xrStringToPath", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrStringToPath failed with %s\n", xr::ToCString(result));
@@ -755,6 +825,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrPathToString(XrInstance instance, XrPath path, uint32_t bufferCapacityInput, uint32_t* bufferCountOutput, char* buffer) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrPathToString");
+		capture::Call call("xrPathToString", capture::atoms::xrPathToString, instance, path, bufferCapacityInput, bufferCountOutput, buffer);
 
 		XrResult result;
 		try {
@@ -765,6 +836,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, path, bufferCapacityInput, bufferCountOutput, buffer);
 		TraceLoggingWriteStop(local, "xrPathToString", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrPathToString failed with %s\n", xr::ToCString(result));
@@ -776,6 +848,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateActionSet(XrInstance instance, const XrActionSetCreateInfo* createInfo, XrActionSet* actionSet) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateActionSet");
+		capture::Call call("xrCreateActionSet", capture::atoms::xrCreateActionSet, instance, createInfo, actionSet);
 
 		XrResult result;
 		try {
@@ -786,6 +859,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, createInfo, actionSet);
 		TraceLoggingWriteStop(local, "xrCreateActionSet", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrCreateActionSet failed with %s\n", xr::ToCString(result));
@@ -797,6 +871,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrDestroyActionSet(XrActionSet actionSet) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrDestroyActionSet");
+		capture::Call call("xrDestroyActionSet", capture::atoms::xrDestroyActionSet, actionSet);
 
 		XrResult result;
 		try {
@@ -807,6 +882,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, actionSet);
 		TraceLoggingWriteStop(local, "xrDestroyActionSet", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrDestroyActionSet failed with %s\n", xr::ToCString(result));
@@ -818,6 +894,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateAction(XrActionSet actionSet, const XrActionCreateInfo* createInfo, XrAction* action) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateAction");
+		capture::Call call("xrCreateAction", capture::atoms::xrCreateAction, actionSet, createInfo, action);
 
 		XrResult result;
 		try {
@@ -828,6 +905,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, actionSet, createInfo, action);
 		TraceLoggingWriteStop(local, "xrCreateAction", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrCreateAction failed with %s\n", xr::ToCString(result));
@@ -839,6 +917,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrDestroyAction(XrAction action) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrDestroyAction");
+		capture::Call call("xrDestroyAction", capture::atoms::xrDestroyAction, action);
 
 		XrResult result;
 		try {
@@ -849,6 +928,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, action);
 		TraceLoggingWriteStop(local, "xrDestroyAction", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrDestroyAction failed with %s\n", xr::ToCString(result));
@@ -860,6 +940,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrSuggestInteractionProfileBindings(XrInstance instance, const XrInteractionProfileSuggestedBinding* suggestedBindings) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrSuggestInteractionProfileBindings");
+		capture::Call call("xrSuggestInteractionProfileBindings", capture::atoms::xrSuggestInteractionProfileBindings, instance, suggestedBindings);
 
 		XrResult result;
 		try {
@@ -870,6 +951,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, suggestedBindings);
 		TraceLoggingWriteStop(local, "xrSuggestInteractionProfileBindings", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result) && result != XR_ERROR_PATH_UNSUPPORTED) {
 			ErrorLog("xrSuggestInteractionProfileBindings failed with %s\n", xr::ToCString(result));
@@ -881,6 +963,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrAttachSessionActionSets(XrSession session, const XrSessionActionSetsAttachInfo* attachInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrAttachSessionActionSets");
+		capture::Call call("xrAttachSessionActionSets", capture::atoms::xrAttachSessionActionSets, session, attachInfo);
 
 		XrResult result;
 		try {
@@ -891,6 +974,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, attachInfo);
 		TraceLoggingWriteStop(local, "xrAttachSessionActionSets", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrAttachSessionActionSets failed with %s\n", xr::ToCString(result));
@@ -902,6 +986,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetCurrentInteractionProfile(XrSession session, XrPath topLevelUserPath, XrInteractionProfileState* interactionProfile) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetCurrentInteractionProfile");
+		capture::Call call("xrGetCurrentInteractionProfile", capture::atoms::xrGetCurrentInteractionProfile, session, topLevelUserPath, interactionProfile);
 
 		XrResult result;
 		try {
@@ -912,6 +997,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, topLevelUserPath, interactionProfile);
 		TraceLoggingWriteStop(local, "xrGetCurrentInteractionProfile", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetCurrentInteractionProfile failed with %s\n", xr::ToCString(result));
@@ -923,6 +1009,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetActionStateBoolean(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStateBoolean* state) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetActionStateBoolean");
+		capture::Call call("xrGetActionStateBoolean", capture::atoms::xrGetActionStateBoolean, session, getInfo, state);
 
 		XrResult result;
 		try {
@@ -933,6 +1020,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, getInfo, state);
 		TraceLoggingWriteStop(local, "xrGetActionStateBoolean", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetActionStateBoolean failed with %s\n", xr::ToCString(result));
@@ -944,6 +1032,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetActionStateFloat(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStateFloat* state) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetActionStateFloat");
+		capture::Call call("xrGetActionStateFloat", capture::atoms::xrGetActionStateFloat, session, getInfo, state);
 
 		XrResult result;
 		try {
@@ -954,6 +1043,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, getInfo, state);
 		TraceLoggingWriteStop(local, "xrGetActionStateFloat", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetActionStateFloat failed with %s\n", xr::ToCString(result));
@@ -965,6 +1055,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetActionStateVector2f(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStateVector2f* state) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetActionStateVector2f");
+		capture::Call call("xrGetActionStateVector2f", capture::atoms::xrGetActionStateVector2f, session, getInfo, state);
 
 		XrResult result;
 		try {
@@ -975,6 +1066,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, getInfo, state);
 		TraceLoggingWriteStop(local, "xrGetActionStateVector2f", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetActionStateVector2f failed with %s\n", xr::ToCString(result));
@@ -986,6 +1078,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetActionStatePose(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStatePose* state) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetActionStatePose");
+		capture::Call call("xrGetActionStatePose", capture::atoms::xrGetActionStatePose, session, getInfo, state);
 
 		XrResult result;
 		try {
@@ -996,6 +1089,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, getInfo, state);
 		TraceLoggingWriteStop(local, "xrGetActionStatePose", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetActionStatePose failed with %s\n", xr::ToCString(result));
@@ -1007,6 +1101,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrSyncActions(XrSession session, const XrActionsSyncInfo* syncInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrSyncActions");
+		capture::Call call("xrSyncActions", capture::atoms::xrSyncActions, session, syncInfo);
 
 		XrResult result;
 		try {
@@ -1017,6 +1112,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, syncInfo);
 		TraceLoggingWriteStop(local, "xrSyncActions", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrSyncActions failed with %s\n", xr::ToCString(result));
@@ -1028,6 +1124,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateBoundSourcesForAction(XrSession session, const XrBoundSourcesForActionEnumerateInfo* enumerateInfo, uint32_t sourceCapacityInput, uint32_t* sourceCountOutput, XrPath* sources) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateBoundSourcesForAction");
+		capture::Call call("xrEnumerateBoundSourcesForAction", capture::atoms::xrEnumerateBoundSourcesForAction, session, enumerateInfo, sourceCapacityInput, sourceCountOutput, sources);
 
 		XrResult result;
 		try {
@@ -1038,6 +1135,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, enumerateInfo, sourceCapacityInput, sourceCountOutput, sources);
 		TraceLoggingWriteStop(local, "xrEnumerateBoundSourcesForAction", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrEnumerateBoundSourcesForAction failed with %s\n", xr::ToCString(result));
@@ -1049,6 +1147,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetInputSourceLocalizedName(XrSession session, const XrInputSourceLocalizedNameGetInfo* getInfo, uint32_t bufferCapacityInput, uint32_t* bufferCountOutput, char* buffer) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetInputSourceLocalizedName");
+		capture::Call call("xrGetInputSourceLocalizedName", capture::atoms::xrGetInputSourceLocalizedName, session, getInfo, bufferCapacityInput, bufferCountOutput, buffer);
 
 		XrResult result;
 		try {
@@ -1059,6 +1158,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, getInfo, bufferCapacityInput, bufferCountOutput, buffer);
 		TraceLoggingWriteStop(local, "xrGetInputSourceLocalizedName", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetInputSourceLocalizedName failed with %s\n", xr::ToCString(result));
@@ -1070,6 +1170,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrApplyHapticFeedback(XrSession session, const XrHapticActionInfo* hapticActionInfo, const XrHapticBaseHeader* hapticFeedback) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrApplyHapticFeedback");
+		capture::Call call("xrApplyHapticFeedback", capture::atoms::xrApplyHapticFeedback, session, hapticActionInfo, hapticFeedback);
 
 		XrResult result;
 		try {
@@ -1080,6 +1181,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, hapticActionInfo, hapticFeedback);
 		TraceLoggingWriteStop(local, "xrApplyHapticFeedback", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrApplyHapticFeedback failed with %s\n", xr::ToCString(result));
@@ -1091,6 +1193,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrStopHapticFeedback(XrSession session, const XrHapticActionInfo* hapticActionInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrStopHapticFeedback");
+		capture::Call call("xrStopHapticFeedback", capture::atoms::xrStopHapticFeedback, session, hapticActionInfo);
 
 		XrResult result;
 		try {
@@ -1101,6 +1204,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, hapticActionInfo);
 		TraceLoggingWriteStop(local, "xrStopHapticFeedback", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrStopHapticFeedback failed with %s\n", xr::ToCString(result));
@@ -1112,6 +1216,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrLocateSpaces(XrSession session, const XrSpacesLocateInfo* locateInfo, XrSpaceLocations* spaceLocations) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrLocateSpaces");
+		capture::Call call("xrLocateSpaces", capture::atoms::xrLocateSpaces, session, locateInfo, spaceLocations);
 
 		XrResult result;
 		try {
@@ -1122,6 +1227,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, locateInfo, spaceLocations);
 		TraceLoggingWriteStop(local, "xrLocateSpaces", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrLocateSpaces failed with %s\n", xr::ToCString(result));
@@ -1133,6 +1239,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetOpenGLGraphicsRequirementsKHR(XrInstance instance, XrSystemId systemId, XrGraphicsRequirementsOpenGLKHR* graphicsRequirements) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetOpenGLGraphicsRequirementsKHR");
+		capture::Call call("xrGetOpenGLGraphicsRequirementsKHR", capture::atoms::xrGetOpenGLGraphicsRequirementsKHR, instance, systemId, graphicsRequirements);
 
 		XrResult result;
 		try {
@@ -1143,6 +1250,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, systemId, graphicsRequirements);
 		TraceLoggingWriteStop(local, "xrGetOpenGLGraphicsRequirementsKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetOpenGLGraphicsRequirementsKHR failed with %s\n", xr::ToCString(result));
@@ -1154,6 +1262,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetVulkanInstanceExtensionsKHR(XrInstance instance, XrSystemId systemId, uint32_t bufferCapacityInput, uint32_t* bufferCountOutput, char* buffer) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetVulkanInstanceExtensionsKHR");
+		capture::Call call("xrGetVulkanInstanceExtensionsKHR", capture::atoms::xrGetVulkanInstanceExtensionsKHR, instance, systemId, bufferCapacityInput, bufferCountOutput, buffer);
 
 		XrResult result;
 		try {
@@ -1164,6 +1273,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, systemId, bufferCapacityInput, bufferCountOutput, buffer);
 		TraceLoggingWriteStop(local, "xrGetVulkanInstanceExtensionsKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetVulkanInstanceExtensionsKHR failed with %s\n", xr::ToCString(result));
@@ -1175,6 +1285,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetVulkanDeviceExtensionsKHR(XrInstance instance, XrSystemId systemId, uint32_t bufferCapacityInput, uint32_t* bufferCountOutput, char* buffer) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetVulkanDeviceExtensionsKHR");
+		capture::Call call("xrGetVulkanDeviceExtensionsKHR", capture::atoms::xrGetVulkanDeviceExtensionsKHR, instance, systemId, bufferCapacityInput, bufferCountOutput, buffer);
 
 		XrResult result;
 		try {
@@ -1185,6 +1296,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, systemId, bufferCapacityInput, bufferCountOutput, buffer);
 		TraceLoggingWriteStop(local, "xrGetVulkanDeviceExtensionsKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetVulkanDeviceExtensionsKHR failed with %s\n", xr::ToCString(result));
@@ -1196,6 +1308,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetVulkanGraphicsDeviceKHR(XrInstance instance, XrSystemId systemId, VkInstance vkInstance, VkPhysicalDevice* vkPhysicalDevice) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetVulkanGraphicsDeviceKHR");
+		capture::Call call("xrGetVulkanGraphicsDeviceKHR", capture::atoms::xrGetVulkanGraphicsDeviceKHR, instance, systemId, vkInstance, vkPhysicalDevice);
 
 		XrResult result;
 		try {
@@ -1206,6 +1319,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, systemId, vkInstance, vkPhysicalDevice);
 		TraceLoggingWriteStop(local, "xrGetVulkanGraphicsDeviceKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetVulkanGraphicsDeviceKHR failed with %s\n", xr::ToCString(result));
@@ -1217,6 +1331,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetVulkanGraphicsRequirementsKHR(XrInstance instance, XrSystemId systemId, XrGraphicsRequirementsVulkanKHR* graphicsRequirements) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetVulkanGraphicsRequirementsKHR");
+		capture::Call call("xrGetVulkanGraphicsRequirementsKHR", capture::atoms::xrGetVulkanGraphicsRequirementsKHR, instance, systemId, graphicsRequirements);
 
 		XrResult result;
 		try {
@@ -1227,6 +1342,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, systemId, graphicsRequirements);
 		TraceLoggingWriteStop(local, "xrGetVulkanGraphicsRequirementsKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetVulkanGraphicsRequirementsKHR failed with %s\n", xr::ToCString(result));
@@ -1238,6 +1354,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetD3D11GraphicsRequirementsKHR(XrInstance instance, XrSystemId systemId, XrGraphicsRequirementsD3D11KHR* graphicsRequirements) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetD3D11GraphicsRequirementsKHR");
+		capture::Call call("xrGetD3D11GraphicsRequirementsKHR", capture::atoms::xrGetD3D11GraphicsRequirementsKHR, instance, systemId, graphicsRequirements);
 
 		XrResult result;
 		try {
@@ -1248,6 +1365,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, systemId, graphicsRequirements);
 		TraceLoggingWriteStop(local, "xrGetD3D11GraphicsRequirementsKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetD3D11GraphicsRequirementsKHR failed with %s\n", xr::ToCString(result));
@@ -1259,6 +1377,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetD3D12GraphicsRequirementsKHR(XrInstance instance, XrSystemId systemId, XrGraphicsRequirementsD3D12KHR* graphicsRequirements) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetD3D12GraphicsRequirementsKHR");
+		capture::Call call("xrGetD3D12GraphicsRequirementsKHR", capture::atoms::xrGetD3D12GraphicsRequirementsKHR, instance, systemId, graphicsRequirements);
 
 		XrResult result;
 		try {
@@ -1269,6 +1388,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, systemId, graphicsRequirements);
 		TraceLoggingWriteStop(local, "xrGetD3D12GraphicsRequirementsKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetD3D12GraphicsRequirementsKHR failed with %s\n", xr::ToCString(result));
@@ -1280,6 +1400,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetVisibilityMaskKHR(XrSession session, XrViewConfigurationType viewConfigurationType, uint32_t viewIndex, XrVisibilityMaskTypeKHR visibilityMaskType, XrVisibilityMaskKHR* visibilityMask) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetVisibilityMaskKHR");
+		capture::Call call("xrGetVisibilityMaskKHR", capture::atoms::xrGetVisibilityMaskKHR, session, viewConfigurationType, viewIndex, visibilityMaskType, visibilityMask);
 
 		XrResult result;
 		try {
@@ -1290,6 +1411,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, viewConfigurationType, viewIndex, visibilityMaskType, visibilityMask);
 		TraceLoggingWriteStop(local, "xrGetVisibilityMaskKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetVisibilityMaskKHR failed with %s\n", xr::ToCString(result));
@@ -1301,6 +1423,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrConvertWin32PerformanceCounterToTimeKHR(XrInstance instance, const LARGE_INTEGER* performanceCounter, XrTime* time) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrConvertWin32PerformanceCounterToTimeKHR");
+		capture::Call call("xrConvertWin32PerformanceCounterToTimeKHR", capture::atoms::xrConvertWin32PerformanceCounterToTimeKHR, instance, performanceCounter, time);
 
 		XrResult result;
 		try {
@@ -1311,6 +1434,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, performanceCounter, time);
 		TraceLoggingWriteStop(local, "xrConvertWin32PerformanceCounterToTimeKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrConvertWin32PerformanceCounterToTimeKHR failed with %s\n", xr::ToCString(result));
@@ -1322,6 +1446,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrConvertTimeToWin32PerformanceCounterKHR(XrInstance instance, XrTime time, LARGE_INTEGER* performanceCounter) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrConvertTimeToWin32PerformanceCounterKHR");
+		capture::Call call("xrConvertTimeToWin32PerformanceCounterKHR", capture::atoms::xrConvertTimeToWin32PerformanceCounterKHR, instance, time, performanceCounter);
 
 		XrResult result;
 		try {
@@ -1332,6 +1457,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, time, performanceCounter);
 		TraceLoggingWriteStop(local, "xrConvertTimeToWin32PerformanceCounterKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrConvertTimeToWin32PerformanceCounterKHR failed with %s\n", xr::ToCString(result));
@@ -1343,6 +1469,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrConvertTimespecTimeToTimeKHR(XrInstance instance, const struct timespec* timespecTime, XrTime* time) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrConvertTimespecTimeToTimeKHR");
+		capture::Call call("xrConvertTimespecTimeToTimeKHR", capture::atoms::xrConvertTimespecTimeToTimeKHR, instance, timespecTime, time);
 
 		XrResult result;
 		try {
@@ -1353,6 +1480,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, timespecTime, time);
 		TraceLoggingWriteStop(local, "xrConvertTimespecTimeToTimeKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrConvertTimespecTimeToTimeKHR failed with %s\n", xr::ToCString(result));
@@ -1364,6 +1492,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrConvertTimeToTimespecTimeKHR(XrInstance instance, XrTime time, struct timespec* timespecTime) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrConvertTimeToTimespecTimeKHR");
+		capture::Call call("xrConvertTimeToTimespecTimeKHR", capture::atoms::xrConvertTimeToTimespecTimeKHR, instance, time, timespecTime);
 
 		XrResult result;
 		try {
@@ -1374,6 +1503,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, time, timespecTime);
 		TraceLoggingWriteStop(local, "xrConvertTimeToTimespecTimeKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrConvertTimeToTimespecTimeKHR failed with %s\n", xr::ToCString(result));
@@ -1385,6 +1515,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateVulkanInstanceKHR(XrInstance instance, const XrVulkanInstanceCreateInfoKHR* createInfo, VkInstance* vulkanInstance, VkResult* vulkanResult) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateVulkanInstanceKHR");
+		capture::Call call("xrCreateVulkanInstanceKHR", capture::atoms::xrCreateVulkanInstanceKHR, instance, createInfo, vulkanInstance, vulkanResult);
 
 		XrResult result;
 		try {
@@ -1395,6 +1526,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, createInfo, vulkanInstance, vulkanResult);
 		TraceLoggingWriteStop(local, "xrCreateVulkanInstanceKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrCreateVulkanInstanceKHR failed with %s\n", xr::ToCString(result));
@@ -1406,6 +1538,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateVulkanDeviceKHR(XrInstance instance, const XrVulkanDeviceCreateInfoKHR* createInfo, VkDevice* vulkanDevice, VkResult* vulkanResult) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateVulkanDeviceKHR");
+		capture::Call call("xrCreateVulkanDeviceKHR", capture::atoms::xrCreateVulkanDeviceKHR, instance, createInfo, vulkanDevice, vulkanResult);
 
 		XrResult result;
 		try {
@@ -1416,6 +1549,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, createInfo, vulkanDevice, vulkanResult);
 		TraceLoggingWriteStop(local, "xrCreateVulkanDeviceKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrCreateVulkanDeviceKHR failed with %s\n", xr::ToCString(result));
@@ -1427,6 +1561,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetVulkanGraphicsDevice2KHR(XrInstance instance, const XrVulkanGraphicsDeviceGetInfoKHR* getInfo, VkPhysicalDevice* vulkanPhysicalDevice) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetVulkanGraphicsDevice2KHR");
+		capture::Call call("xrGetVulkanGraphicsDevice2KHR", capture::atoms::xrGetVulkanGraphicsDevice2KHR, instance, getInfo, vulkanPhysicalDevice);
 
 		XrResult result;
 		try {
@@ -1437,6 +1572,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, getInfo, vulkanPhysicalDevice);
 		TraceLoggingWriteStop(local, "xrGetVulkanGraphicsDevice2KHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetVulkanGraphicsDevice2KHR failed with %s\n", xr::ToCString(result));
@@ -1448,6 +1584,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetVulkanGraphicsRequirements2KHR(XrInstance instance, XrSystemId systemId, XrGraphicsRequirementsVulkanKHR* graphicsRequirements) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetVulkanGraphicsRequirements2KHR");
+		capture::Call call("xrGetVulkanGraphicsRequirements2KHR", capture::atoms::xrGetVulkanGraphicsRequirements2KHR, instance, systemId, graphicsRequirements);
 
 		XrResult result;
 		try {
@@ -1458,6 +1595,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, systemId, graphicsRequirements);
 		TraceLoggingWriteStop(local, "xrGetVulkanGraphicsRequirements2KHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetVulkanGraphicsRequirements2KHR failed with %s\n", xr::ToCString(result));
@@ -1469,6 +1607,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrLocateSpacesKHR(XrSession session, const XrSpacesLocateInfo* locateInfo, XrSpaceLocations* spaceLocations) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrLocateSpacesKHR");
+		capture::Call call("xrLocateSpacesKHR", capture::atoms::xrLocateSpacesKHR, session, locateInfo, spaceLocations);
 
 		XrResult result;
 		try {
@@ -1479,6 +1618,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, locateInfo, spaceLocations);
 		TraceLoggingWriteStop(local, "xrLocateSpacesKHR", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrLocateSpacesKHR failed with %s\n", xr::ToCString(result));
@@ -1490,6 +1630,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateHandTrackerEXT(XrSession session, const XrHandTrackerCreateInfoEXT* createInfo, XrHandTrackerEXT* handTracker) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateHandTrackerEXT");
+		capture::Call call("xrCreateHandTrackerEXT", capture::atoms::xrCreateHandTrackerEXT, session, createInfo, handTracker);
 
 		XrResult result;
 		try {
@@ -1500,6 +1641,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, createInfo, handTracker);
 		TraceLoggingWriteStop(local, "xrCreateHandTrackerEXT", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrCreateHandTrackerEXT failed with %s\n", xr::ToCString(result));
@@ -1511,6 +1653,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrDestroyHandTrackerEXT(XrHandTrackerEXT handTracker) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrDestroyHandTrackerEXT");
+		capture::Call call("xrDestroyHandTrackerEXT", capture::atoms::xrDestroyHandTrackerEXT, handTracker);
 
 		XrResult result;
 		try {
@@ -1521,6 +1664,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, handTracker);
 		TraceLoggingWriteStop(local, "xrDestroyHandTrackerEXT", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrDestroyHandTrackerEXT failed with %s\n", xr::ToCString(result));
@@ -1532,6 +1676,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrLocateHandJointsEXT(XrHandTrackerEXT handTracker, const XrHandJointsLocateInfoEXT* locateInfo, XrHandJointLocationsEXT* locations) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrLocateHandJointsEXT");
+		capture::Call call("xrLocateHandJointsEXT", capture::atoms::xrLocateHandJointsEXT, handTracker, locateInfo, locations);
 
 		XrResult result;
 		try {
@@ -1542,6 +1687,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, handTracker, locateInfo, locations);
 		TraceLoggingWriteStop(local, "xrLocateHandJointsEXT", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrLocateHandJointsEXT failed with %s\n", xr::ToCString(result));
@@ -1553,6 +1699,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateBodyTrackerFB(XrSession session, const XrBodyTrackerCreateInfoFB* createInfo, XrBodyTrackerFB* bodyTracker) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateBodyTrackerFB");
+		capture::Call call("xrCreateBodyTrackerFB", capture::atoms::xrCreateBodyTrackerFB, session, createInfo, bodyTracker);
 
 		XrResult result;
 		try {
@@ -1563,6 +1710,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, createInfo, bodyTracker);
 		TraceLoggingWriteStop(local, "xrCreateBodyTrackerFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrCreateBodyTrackerFB failed with %s\n", xr::ToCString(result));
@@ -1574,6 +1722,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrDestroyBodyTrackerFB(XrBodyTrackerFB bodyTracker) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrDestroyBodyTrackerFB");
+		capture::Call call("xrDestroyBodyTrackerFB", capture::atoms::xrDestroyBodyTrackerFB, bodyTracker);
 
 		XrResult result;
 		try {
@@ -1584,6 +1733,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, bodyTracker);
 		TraceLoggingWriteStop(local, "xrDestroyBodyTrackerFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrDestroyBodyTrackerFB failed with %s\n", xr::ToCString(result));
@@ -1595,6 +1745,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrLocateBodyJointsFB(XrBodyTrackerFB bodyTracker, const XrBodyJointsLocateInfoFB* locateInfo, XrBodyJointLocationsFB* locations) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrLocateBodyJointsFB");
+		capture::Call call("xrLocateBodyJointsFB", capture::atoms::xrLocateBodyJointsFB, bodyTracker, locateInfo, locations);
 
 		XrResult result;
 		try {
@@ -1605,6 +1756,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, bodyTracker, locateInfo, locations);
 		TraceLoggingWriteStop(local, "xrLocateBodyJointsFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrLocateBodyJointsFB failed with %s\n", xr::ToCString(result));
@@ -1616,6 +1768,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetBodySkeletonFB(XrBodyTrackerFB bodyTracker, XrBodySkeletonFB* skeleton) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetBodySkeletonFB");
+		capture::Call call("xrGetBodySkeletonFB", capture::atoms::xrGetBodySkeletonFB, bodyTracker, skeleton);
 
 		XrResult result;
 		try {
@@ -1626,6 +1779,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, bodyTracker, skeleton);
 		TraceLoggingWriteStop(local, "xrGetBodySkeletonFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetBodySkeletonFB failed with %s\n", xr::ToCString(result));
@@ -1637,6 +1791,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateDisplayRefreshRatesFB(XrSession session, uint32_t displayRefreshRateCapacityInput, uint32_t* displayRefreshRateCountOutput, float* displayRefreshRates) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateDisplayRefreshRatesFB");
+		capture::Call call("xrEnumerateDisplayRefreshRatesFB", capture::atoms::xrEnumerateDisplayRefreshRatesFB, session, displayRefreshRateCapacityInput, displayRefreshRateCountOutput, displayRefreshRates);
 
 		XrResult result;
 		try {
@@ -1647,6 +1802,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, displayRefreshRateCapacityInput, displayRefreshRateCountOutput, displayRefreshRates);
 		TraceLoggingWriteStop(local, "xrEnumerateDisplayRefreshRatesFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrEnumerateDisplayRefreshRatesFB failed with %s\n", xr::ToCString(result));
@@ -1658,6 +1814,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetDisplayRefreshRateFB(XrSession session, float* displayRefreshRate) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetDisplayRefreshRateFB");
+		capture::Call call("xrGetDisplayRefreshRateFB", capture::atoms::xrGetDisplayRefreshRateFB, session, displayRefreshRate);
 
 		XrResult result;
 		try {
@@ -1668,6 +1825,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, displayRefreshRate);
 		TraceLoggingWriteStop(local, "xrGetDisplayRefreshRateFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetDisplayRefreshRateFB failed with %s\n", xr::ToCString(result));
@@ -1679,6 +1837,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrRequestDisplayRefreshRateFB(XrSession session, float displayRefreshRate) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrRequestDisplayRefreshRateFB");
+		capture::Call call("xrRequestDisplayRefreshRateFB", capture::atoms::xrRequestDisplayRefreshRateFB, session, displayRefreshRate);
 
 		XrResult result;
 		try {
@@ -1689,6 +1848,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, displayRefreshRate);
 		TraceLoggingWriteStop(local, "xrRequestDisplayRefreshRateFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrRequestDisplayRefreshRateFB failed with %s\n", xr::ToCString(result));
@@ -1700,6 +1860,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrEnumerateViveTrackerPathsHTCX(XrInstance instance, uint32_t pathCapacityInput, uint32_t* pathCountOutput, XrViveTrackerPathsHTCX* paths) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrEnumerateViveTrackerPathsHTCX");
+		capture::Call call("xrEnumerateViveTrackerPathsHTCX", capture::atoms::xrEnumerateViveTrackerPathsHTCX, instance, pathCapacityInput, pathCountOutput, paths);
 
 		XrResult result;
 		try {
@@ -1710,6 +1871,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, pathCapacityInput, pathCountOutput, paths);
 		TraceLoggingWriteStop(local, "xrEnumerateViveTrackerPathsHTCX", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrEnumerateViveTrackerPathsHTCX failed with %s\n", xr::ToCString(result));
@@ -1721,6 +1883,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetAudioOutputDeviceGuidOculus(XrInstance instance, wchar_t buffer[XR_MAX_AUDIO_DEVICE_STR_SIZE_OCULUS]) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetAudioOutputDeviceGuidOculus");
+		capture::Call call("xrGetAudioOutputDeviceGuidOculus", capture::atoms::xrGetAudioOutputDeviceGuidOculus, instance, buffer);
 
 		XrResult result;
 		try {
@@ -1731,6 +1894,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, buffer);
 		TraceLoggingWriteStop(local, "xrGetAudioOutputDeviceGuidOculus", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result) && result != XR_ERROR_FEATURE_UNSUPPORTED) {
 			ErrorLog("xrGetAudioOutputDeviceGuidOculus failed with %s\n", xr::ToCString(result));
@@ -1742,6 +1906,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetAudioInputDeviceGuidOculus(XrInstance instance, wchar_t buffer[XR_MAX_AUDIO_DEVICE_STR_SIZE_OCULUS]) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetAudioInputDeviceGuidOculus");
+		capture::Call call("xrGetAudioInputDeviceGuidOculus", capture::atoms::xrGetAudioInputDeviceGuidOculus, instance, buffer);
 
 		XrResult result;
 		try {
@@ -1752,6 +1917,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, instance, buffer);
 		TraceLoggingWriteStop(local, "xrGetAudioInputDeviceGuidOculus", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result) && result != XR_ERROR_FEATURE_UNSUPPORTED) {
 			ErrorLog("xrGetAudioInputDeviceGuidOculus failed with %s\n", xr::ToCString(result));
@@ -1763,6 +1929,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateFaceTrackerFB(XrSession session, const XrFaceTrackerCreateInfoFB* createInfo, XrFaceTrackerFB* faceTracker) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateFaceTrackerFB");
+		capture::Call call("xrCreateFaceTrackerFB", capture::atoms::xrCreateFaceTrackerFB, session, createInfo, faceTracker);
 
 		XrResult result;
 		try {
@@ -1773,6 +1940,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, createInfo, faceTracker);
 		TraceLoggingWriteStop(local, "xrCreateFaceTrackerFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrCreateFaceTrackerFB failed with %s\n", xr::ToCString(result));
@@ -1784,6 +1952,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrDestroyFaceTrackerFB(XrFaceTrackerFB faceTracker) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrDestroyFaceTrackerFB");
+		capture::Call call("xrDestroyFaceTrackerFB", capture::atoms::xrDestroyFaceTrackerFB, faceTracker);
 
 		XrResult result;
 		try {
@@ -1794,6 +1963,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, faceTracker);
 		TraceLoggingWriteStop(local, "xrDestroyFaceTrackerFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrDestroyFaceTrackerFB failed with %s\n", xr::ToCString(result));
@@ -1805,6 +1975,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetFaceExpressionWeightsFB(XrFaceTrackerFB faceTracker, const XrFaceExpressionInfoFB* expressionInfo, XrFaceExpressionWeightsFB* expressionWeights) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetFaceExpressionWeightsFB");
+		capture::Call call("xrGetFaceExpressionWeightsFB", capture::atoms::xrGetFaceExpressionWeightsFB, faceTracker, expressionInfo, expressionWeights);
 
 		XrResult result;
 		try {
@@ -1815,6 +1986,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, faceTracker, expressionInfo, expressionWeights);
 		TraceLoggingWriteStop(local, "xrGetFaceExpressionWeightsFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetFaceExpressionWeightsFB failed with %s\n", xr::ToCString(result));
@@ -1826,6 +1998,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateEyeTrackerFB(XrSession session, const XrEyeTrackerCreateInfoFB* createInfo, XrEyeTrackerFB* eyeTracker) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateEyeTrackerFB");
+		capture::Call call("xrCreateEyeTrackerFB", capture::atoms::xrCreateEyeTrackerFB, session, createInfo, eyeTracker);
 
 		XrResult result;
 		try {
@@ -1836,6 +2009,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, createInfo, eyeTracker);
 		TraceLoggingWriteStop(local, "xrCreateEyeTrackerFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrCreateEyeTrackerFB failed with %s\n", xr::ToCString(result));
@@ -1847,6 +2021,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrDestroyEyeTrackerFB(XrEyeTrackerFB eyeTracker) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrDestroyEyeTrackerFB");
+		capture::Call call("xrDestroyEyeTrackerFB", capture::atoms::xrDestroyEyeTrackerFB, eyeTracker);
 
 		XrResult result;
 		try {
@@ -1857,6 +2032,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, eyeTracker);
 		TraceLoggingWriteStop(local, "xrDestroyEyeTrackerFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrDestroyEyeTrackerFB failed with %s\n", xr::ToCString(result));
@@ -1868,6 +2044,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetEyeGazesFB(XrEyeTrackerFB eyeTracker, const XrEyeGazesInfoFB* gazeInfo, XrEyeGazesFB* eyeGazes) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetEyeGazesFB");
+		capture::Call call("xrGetEyeGazesFB", capture::atoms::xrGetEyeGazesFB, eyeTracker, gazeInfo, eyeGazes);
 
 		XrResult result;
 		try {
@@ -1878,6 +2055,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, eyeTracker, gazeInfo, eyeGazes);
 		TraceLoggingWriteStop(local, "xrGetEyeGazesFB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetEyeGazesFB failed with %s\n", xr::ToCString(result));
@@ -1889,6 +2067,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrSuggestBodyTrackingCalibrationOverrideMETA(XrBodyTrackerFB bodyTracker, const XrBodyTrackingCalibrationInfoMETA* calibrationInfo) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrSuggestBodyTrackingCalibrationOverrideMETA");
+		capture::Call call("xrSuggestBodyTrackingCalibrationOverrideMETA", capture::atoms::xrSuggestBodyTrackingCalibrationOverrideMETA, bodyTracker, calibrationInfo);
 
 		XrResult result;
 		try {
@@ -1899,6 +2078,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, bodyTracker, calibrationInfo);
 		TraceLoggingWriteStop(local, "xrSuggestBodyTrackingCalibrationOverrideMETA", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrSuggestBodyTrackingCalibrationOverrideMETA failed with %s\n", xr::ToCString(result));
@@ -1910,6 +2090,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrResetBodyTrackingCalibrationMETA(XrBodyTrackerFB bodyTracker) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrResetBodyTrackingCalibrationMETA");
+		capture::Call call("xrResetBodyTrackingCalibrationMETA", capture::atoms::xrResetBodyTrackingCalibrationMETA, bodyTracker);
 
 		XrResult result;
 		try {
@@ -1920,6 +2101,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, bodyTracker);
 		TraceLoggingWriteStop(local, "xrResetBodyTrackingCalibrationMETA", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrResetBodyTrackingCalibrationMETA failed with %s\n", xr::ToCString(result));
@@ -1931,6 +2113,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrRequestBodyTrackingFidelityMETA(XrBodyTrackerFB bodyTracker, const XrBodyTrackingFidelityMETA fidelity) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrRequestBodyTrackingFidelityMETA");
+		capture::Call call("xrRequestBodyTrackingFidelityMETA", capture::atoms::xrRequestBodyTrackingFidelityMETA, bodyTracker, fidelity);
 
 		XrResult result;
 		try {
@@ -1941,6 +2124,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, bodyTracker, fidelity);
 		TraceLoggingWriteStop(local, "xrRequestBodyTrackingFidelityMETA", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrRequestBodyTrackingFidelityMETA failed with %s\n", xr::ToCString(result));
@@ -1952,6 +2136,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrCreateFaceTracker2FB(XrSession session, const XrFaceTrackerCreateInfo2FB* createInfo, XrFaceTracker2FB* faceTracker) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrCreateFaceTracker2FB");
+		capture::Call call("xrCreateFaceTracker2FB", capture::atoms::xrCreateFaceTracker2FB, session, createInfo, faceTracker);
 
 		XrResult result;
 		try {
@@ -1962,6 +2147,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, session, createInfo, faceTracker);
 		TraceLoggingWriteStop(local, "xrCreateFaceTracker2FB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrCreateFaceTracker2FB failed with %s\n", xr::ToCString(result));
@@ -1973,6 +2159,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrDestroyFaceTracker2FB(XrFaceTracker2FB faceTracker) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrDestroyFaceTracker2FB");
+		capture::Call call("xrDestroyFaceTracker2FB", capture::atoms::xrDestroyFaceTracker2FB, faceTracker);
 
 		XrResult result;
 		try {
@@ -1983,6 +2170,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, faceTracker);
 		TraceLoggingWriteStop(local, "xrDestroyFaceTracker2FB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrDestroyFaceTracker2FB failed with %s\n", xr::ToCString(result));
@@ -1994,6 +2182,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL xrGetFaceExpressionWeights2FB(XrFaceTracker2FB faceTracker, const XrFaceExpressionInfo2FB* expressionInfo, XrFaceExpressionWeights2FB* expressionWeights) {
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "xrGetFaceExpressionWeights2FB");
+		capture::Call call("xrGetFaceExpressionWeights2FB", capture::atoms::xrGetFaceExpressionWeights2FB, faceTracker, expressionInfo, expressionWeights);
 
 		XrResult result;
 		try {
@@ -2004,6 +2193,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}
 
+		call.end(result, faceTracker, expressionInfo, expressionWeights);
 		TraceLoggingWriteStop(local, "xrGetFaceExpressionWeights2FB", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result)) {
 			ErrorLog("xrGetFaceExpressionWeights2FB failed with %s\n", xr::ToCString(result));
@@ -2012,6 +2202,29 @@ namespace RUNTIME_NAMESPACE {
 		return result;
 	}
 
+	XrResult XRAPI_CALL xrGetRecommendedLayerResolutionMETA(XrSession session, const XrRecommendedLayerResolutionGetInfoMETA* info, XrRecommendedLayerResolutionMETA* resolution) {
+		TraceLocalActivity(local);
+		TraceLoggingWriteStart(local, "xrGetRecommendedLayerResolutionMETA");
+		capture::Call call("xrGetRecommendedLayerResolutionMETA", capture::atoms::xrGetRecommendedLayerResolutionMETA, session, info, resolution);
+
+		XrResult result;
+		try {
+			result = RUNTIME_NAMESPACE::GetInstance()->xrGetRecommendedLayerResolutionMETA(session, info, resolution);
+		} catch (std::exception& exc) {
+			TraceLoggingWriteTagged(local, "xrGetRecommendedLayerResolutionMETA_Error", TLArg(exc.what(), "Error"));
+			ErrorLog("xrGetRecommendedLayerResolutionMETA: %s\n", exc.what());
+			result = XR_ERROR_RUNTIME_FAILURE;
+		}
+
+		call.end(result, session, info, resolution);
+		TraceLoggingWriteStop(local, "xrGetRecommendedLayerResolutionMETA", TLArg(xr::ToCString(result), "Result"));
+		if (XR_FAILED(result)) {
+			ErrorLog("xrGetRecommendedLayerResolutionMETA failed with %s\n", xr::ToCString(result));
+		}
+
+		return result;
+	}
+
 
 	// Auto-generated dispatcher handler.
 	XrResult OpenXrApi::xrGetInstanceProcAddr(XrInstance instance, const char* name, PFN_xrVoidFunction* function) {
@@ -2308,6 +2521,9 @@ namespace RUNTIME_NAMESPACE {
 		else if (has_XR_FB_face_tracking2 && apiName == "xrGetFaceExpressionWeights2FB") {
 			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetFaceExpressionWeights2FB);
 		}
+		else if (has_XR_META_recommended_layer_resolution && apiName == "xrGetRecommendedLayerResolutionMETA") {
+			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrGetRecommendedLayerResolutionMETA);
+		}
 		else {
 			return XR_ERROR_FUNCTION_UNSUPPORTED;
 		}
@@ -2418,6 +2634,18 @@ namespace RUNTIME_NAMESPACE {
 		else if (extensionName == "XR_EXT_palm_pose") {
 			has_XR_EXT_palm_pose = true;
 		}
+		else if (extensionName == "XR_META_recommended_layer_resolution") {
+			has_XR_META_recommended_layer_resolution = true;
+		}
+		else if (extensionName == "XR_VARJO_quad_views") {
+			has_XR_VARJO_quad_views = true;
+		}
+		else if (extensionName == "XR_VARJO_foveated_rendering") {
+			has_XR_VARJO_foveated_rendering = true;
+		}
+		else if (extensionName == "XR_VDXR_swapchain_damage_region") {
+			has_XR_VDXR_swapchain_damage_region = true;
+		}
 
 	}
 
@@ -137,6 +137,7 @@ namespace RUNTIME_NAMESPACE {
 		virtual XrResult xrCreateFaceTracker2FB(XrSession session, const XrFaceTrackerCreateInfo2FB* createInfo, XrFaceTracker2FB* faceTracker) = 0;
 		virtual XrResult xrDestroyFaceTracker2FB(XrFaceTracker2FB faceTracker) = 0;
 		virtual XrResult xrGetFaceExpressionWeights2FB(XrFaceTracker2FB faceTracker, const XrFaceExpressionInfo2FB* expressionInfo, XrFaceExpressionWeights2FB* expressionWeights) = 0;
+		virtual XrResult xrGetRecommendedLayerResolutionMETA(XrSession session, const XrRecommendedLayerResolutionGetInfoMETA* info, XrRecommendedLayerResolutionMETA* resolution) = 0;
 
 
 	protected:
@@ -177,6 +178,10 @@ namespace RUNTIME_NAMESPACE {
 		bool has_XR_KHR_maintenance1{false};
 		bool has_XR_EXT_local_floor{false};
 		bool has_XR_EXT_palm_pose{false};
+		bool has_XR_META_recommended_layer_resolution{false};
+		bool has_XR_VARJO_quad_views{false};
+		bool has_XR_VARJO_foveated_rendering{false};
+		bool has_XR_VDXR_swapchain_damage_region{false};
 
 
 	};
@@ -50,7 +50,13 @@ EXTENSIONS = ['XR_KHR_D3D11_enable', 'XR_KHR_D3D12_enable', 'XR_KHR_vulkan_enabl
               'XR_EXT_eye_gaze_interaction', 'XR_EXT_uuid', 'XR_META_headset_id', 'XR_OCULUS_audio_device_guid', 'XR_MND_headless',
               'XR_FB_eye_tracking_social', 'XR_FB_face_tracking', 'XR_FB_face_tracking2', 'XR_FB_hand_tracking_aim',
               'XR_FB_body_tracking', 'XR_META_body_tracking_full_body', 'XR_META_body_tracking_fidelity', 'XR_META_body_tracking_calibration', 'XR_HTCX_vive_tracker_interaction',
-              'XR_EXT_active_action_set_priority', 'XR_KHR_locate_spaces', 'XR_KHR_maintenance1', 'XR_EXT_local_floor', 'XR_EXT_palm_pose']
+              'XR_EXT_active_action_set_priority', 'XR_KHR_locate_spaces', 'XR_KHR_maintenance1', 'XR_EXT_local_floor', 'XR_EXT_palm_pose',
+              'XR_META_recommended_layer_resolution', 'XR_VARJO_quad_views', 'XR_VARJO_foveated_rendering',
+              'XR_VDXR_swapchain_damage_region']
+
+# Values produced by the runtime that the replay must translate, besides handles. They are plain 64-bit integers in C, like
+# flags or IDs that must be replayed as-is, so only the registry can tell them apart.
+ATOM_TYPES = ['XrPath', 'XrSystemId']
 
 SILENT_ERRORS = {
     'xrSuggestInteractionProfileBindings': ['XR_ERROR_PATH_UNSUPPORTED'],
@@ -118,6 +124,8 @@ class DispatchGenCppOutputGenerator(DispatchGenOutputGenerator):
 
 #include <runtime.h>
 
+#include "capture.h"
+#include "capture.gen.h"
 #include "dispatch.h"
 #include "log.h"
 
@@ -168,6 +176,7 @@ namespace RUNTIME_NAMESPACE {
 	XrResult XRAPI_CALL {cur_cmd.name}({parameters_list}) {{
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "{cur_cmd.name}");
+		capture::Call call("{cur_cmd.name}", capture::atoms::{cur_cmd.name}, {arguments_list});
 
 		XrResult result;
 		try {{
@@ -178,6 +187,7 @@ namespace RUNTIME_NAMESPACE {
 			result = XR_ERROR_RUNTIME_FAILURE;
 		}}
 
+		call.end(result, {arguments_list});
 		TraceLoggingWriteStop(local, "{cur_cmd.name}", TLArg(xr::ToCString(result), "Result"));
 		if (XR_FAILED(result){silentErrors}) {{
 			ErrorLog("{cur_cmd.name} failed with %s\\n", xr::ToCString(result));
@@ -191,6 +201,7 @@ namespace RUNTIME_NAMESPACE {
 	void XRAPI_CALL {cur_cmd.name}({parameters_list}) {{
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "{cur_cmd.name}");
+		capture::Call call("{cur_cmd.name}", capture::atoms::{cur_cmd.name}, {arguments_list});
 
 		try {{
 			RUNTIME_NAMESPACE::GetInstance()->{cur_cmd.name}({arguments_list});
@@ -199,6 +210,7 @@ namespace RUNTIME_NAMESPACE {
 			ErrorLog("{cur_cmd.name}: %s\\n", exc.what());
 		}}
 
+		call.end(XR_SUCCESS, {arguments_list});
 		TraceLoggingWriteStop(local, "{cur_cmd.name}");
 	}}
 '''
@@ -325,6 +337,48 @@ namespace RUNTIME_NAMESPACE {
 
         return generated
 
+class DispatchGenCaptureHOutputGenerator(DispatchGenOutputGenerator):
+    '''Generator for capture.gen.h.'''
+    def beginFile(self, genOpts):
+        DispatchGenOutputGenerator.beginFile(self, genOpts)
+        preamble = '''#pragma once
+
+namespace virtualdesktop_openxr::capture::atoms {
+'''
+        write(preamble, file=self.outFile)
+
+    def endFile(self):
+        generated_atom_masks = self.genAtomMasks()
+
+        postamble = '''
+} // namespace virtualdesktop_openxr::capture::atoms
+'''
+
+        contents = f'''
+	// Auto-generated masks of the parameters that are atoms (handles, paths and system IDs), or that point to atoms:
+	// bit N is set for the N-th parameter.
+{generated_atom_masks}
+{postamble}'''
+
+        write(contents, file=self.outFile)
+
+        DispatchGenOutputGenerator.endFile(self)
+
+    def genAtomMasks(self):
+        generated = ''
+
+        for cur_cmd in self.core_commands + self.ext_commands:
+            if cur_cmd.name not in EXCLUDED_API:
+                mask = 0
+                for index, param in enumerate(cur_cmd.params):
+                    if param.is_handle or param.type in ATOM_TYPES:
+                        mask |= 1 << index
+
+                generated += f'''	inline constexpr uint32_t {cur_cmd.name} = 0x{mask:x};
+'''
+
+        return generated
+
 def makeREstring(strings, default=None):
     """Turn a list of strings into a regexp string matching exactly those strings."""
     if strings or default is None:
@@ -365,3 +419,18 @@ if __name__ == '__main__':
                                                         emitExtensions    = extensionsPat))
     registry.loadFile(os.path.join(sdk_dir, 'specification', 'registry', 'xr.xml'))
     registry.apiGen()
+
+    registry = Registry(DispatchGenCaptureHOutputGenerator(diagFile=None),
+                        AutomaticSourceGeneratorOptions(conventions       = conventions,
+                                                        filename          = 'capture.gen.h',
+                                                        directory         = cur_dir,
+                                                        apiname           = 'openxr',
+                                                        profile           = None,
+                                                        versions          = featuresPat,
+                                                        emitversions      = featuresPat,
+                                                        defaultExtensions = 'openxr',
+                                                        addExtensions     = None,
+                                                        removeExtensions  = None,
+                                                        emitExtensions    = extensionsPat))
+    registry.loadFile(os.path.join(sdk_dir, 'specification', 'registry', 'xr.xml'))
+    registry.apiGen()
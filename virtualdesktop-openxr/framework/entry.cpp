@@ -24,6 +24,7 @@
 
 #include <runtime.h>
 
+#include "capture.h"
 #include "dispatch.h"
 #include "log.h"
 
@@ -125,6 +126,16 @@ XrResult __declspec(dllexport) XRAPI_CALL xrNegotiateLoaderRuntimeInterface(cons
     }
 #endif
 
+    // Opt-in capture of the API calls, for replay with the benchmarks tool.
+    if (!capture::g_writer.load() && RegGetDword(HKEY_LOCAL_MACHINE, RegPrefix, "capture").value_or(0)) {
+        const auto captureFile = programData / "OpenXR.capture";
+        if (capture::Start(captureFile)) {
+            Log("Capturing API calls to %ls\n", captureFile.wstring().c_str());
+        } else {
+            ErrorLog("Failed to open %ls\n", captureFile.wstring().c_str());
+        }
+    }
+
     if (!loaderInfo || !runtimeRequest || loaderInfo->structType != XR_LOADER_INTERFACE_STRUCT_LOADER_INFO ||
         loaderInfo->structVersion != XR_LOADER_INFO_STRUCT_VERSION ||
         loaderInfo->structSize != sizeof(XrNegotiateLoaderInfo) ||
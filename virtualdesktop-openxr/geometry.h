@@ -0,0 +1,207 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    // The smallest rectangle containing both rectangles.
+    static inline XrRect2Di unionRect(const XrRect2Di& a, const XrRect2Di& b) {
+        const int32_t left = std::min(a.offset.x, b.offset.x);
+        const int32_t top = std::min(a.offset.y, b.offset.y);
+        const int32_t right = std::max(a.offset.x + a.extent.width, b.offset.x + b.extent.width);
+        const int32_t bottom = std::max(a.offset.y + a.extent.height, b.offset.y + b.extent.height);
+        return {{left, top}, {right - left, bottom - top}};
+    }
+
+    // The overlap of both rectangles, with a zero extent when they do not overlap.
+    static inline XrRect2Di intersectRect(const XrRect2Di& a, const XrRect2Di& b) {
+        const int32_t left = std::max(a.offset.x, b.offset.x);
+        const int32_t top = std::max(a.offset.y, b.offset.y);
+        const int32_t right = std::min(a.offset.x + a.extent.width, b.offset.x + b.extent.width);
+        const int32_t bottom = std::min(a.offset.y + a.extent.height, b.offset.y + b.extent.height);
+        return {{left, top}, {std::max(right - left, 0), std::max(bottom - top, 0)}};
+    }
+
+    // The number of pixels in a rectangle, zero when it is empty.
+    static inline uint64_t getArea(const XrRect2Di& rect) {
+        return (uint64_t)std::max(rect.extent.width, 0) * std::max(rect.extent.height, 0);
+    }
+
+    // Grow a rectangle on all sides, without going past the image.
+    static inline XrRect2Di inflateRect(const XrRect2Di& rect, int32_t margin, int32_t width, int32_t height) {
+        return intersectRect({{rect.offset.x - margin, rect.offset.y - margin},
+                              {rect.extent.width + 2 * margin, rect.extent.height + 2 * margin}},
+                             {{0, 0}, {width, height}});
+    }
+
+    // Compute which tiles of an image need to be processed, given the hidden area mesh (in the tangent space of the
+    // eye, as produced by convertSteamVRToOpenXRHiddenMesh()) and the field of view covered by the image. A tile is
+    // only skipped when all of its pixels are hidden and so are all of its neighbors, so that bilinear sampling at the
+    // edge of the visible area never reads a skipped tile. The FOV is given as the tangents of its half-angles, like
+    // ovrFovPort.
+    template <typename FovPort>
+    static std::vector<uint8_t> computeVisibleTiles(const std::vector<XrVector2f>& hiddenAreaVertices,
+                                                    const std::vector<uint32_t>& hiddenAreaIndices,
+                                                    const FovPort& fov,
+                                                    uint32_t width,
+                                                    uint32_t height,
+                                                    uint32_t tileSize,
+                                                    uint32_t* hiddenTilesCount = nullptr) {
+        const uint32_t tilesX = (width + tileSize - 1) / tileSize;
+        const uint32_t tilesY = (height + tileSize - 1) / tileSize;
+
+        // Mark all the hidden pixels. We test pixel centers, and we include pixels that are exactly on the edge of a
+        // triangle so that there are no cracks between adjacent triangles.
+        std::vector<uint8_t> hidden(width * height, 0);
+        const float uScale = width / (fov.LeftTan + fov.RightTan);
+        const float vScale = height / (fov.UpTan + fov.DownTan);
+        for (size_t i = 0; i + 2 < hiddenAreaIndices.size(); i += 3) {
+            XrVector2f p[3];
+            for (uint32_t j = 0; j < 3; j++) {
+                const XrVector2f& v = hiddenAreaVertices[hiddenAreaIndices[i + j]];
+                p[j] = {(v.x + fov.LeftTan) * uScale, (fov.UpTan - v.y) * vScale};
+            }
+
+            const float minY = std::min({p[0].y, p[1].y, p[2].y});
+            const float maxY = std::max({p[0].y, p[1].y, p[2].y});
+            const int firstRow = std::max((int)std::ceil(minY - 0.5f), 0);
+            const int lastRow = std::min((int)std::floor(maxY - 0.5f), (int)height - 1);
+            for (int y = firstRow; y <= lastRow; y++) {
+                const float yc = y + 0.5f;
+
+                // Find the span of the triangle on this row.
+                float minX = +INFINITY;
+                float maxX = -INFINITY;
+                for (uint32_t j = 0; j < 3; j++) {
+                    const XrVector2f& a = p[j];
+                    const XrVector2f& b = p[(j + 1) % 3];
+                    if (yc < std::min(a.y, b.y) || yc > std::max(a.y, b.y)) {
+                        continue;
+                    }
+                    if (std::abs(b.y - a.y) <= FLT_EPSILON) {
+                        minX = std::min({minX, a.x, b.x});
+                        maxX = std::max({maxX, a.x, b.x});
+                    } else {
+                        const float x = a.x + (yc - a.y) * (b.x - a.x) / (b.y - a.y);
+                        minX = std::min(minX, x);
+                        maxX = std::max(maxX, x);
+                    }
+                }
+                if (minX > maxX) {
+                    continue;
+                }
+
+                const int firstColumn = std::max((int)std::ceil(minX - 0.5f), 0);
+                const int lastColumn = std::min((int)std::floor(maxX - 0.5f), (int)width - 1);
+                for (int x = firstColumn; x <= lastColumn; x++) {
+                    hidden[y * width + x] = 1;
+                }
+            }
+        }
+
+        // A tile is visible if any of its pixels is visible.
+        std::vector<uint8_t> visibleTiles(tilesX * tilesY, 0);
+        for (uint32_t y = 0; y < height; y++) {
+            for (uint32_t x = 0; x < width; x++) {
+                if (!hidden[y * width + x]) {
+                    visibleTiles[(y / tileSize) * tilesX + (x / tileSize)] = 1;
+                }
+            }
+        }
+
+        // Grow the visible area by one tile.
+        std::vector<uint8_t> tiles(visibleTiles);
+        uint32_t hiddenTiles = 0;
+        for (uint32_t y = 0; y < tilesY; y++) {
+            for (uint32_t x = 0; x < tilesX; x++) {
+                for (uint32_t ny = y ? y - 1 : 0; ny <= std::min(y + 1, tilesY - 1) && !tiles[y * tilesX + x]; ny++) {
+                    for (uint32_t nx = x ? x - 1 : 0; nx <= std::min(x + 1, tilesX - 1); nx++) {
+                        if (visibleTiles[ny * tilesX + nx]) {
+                            tiles[y * tilesX + x] = 1;
+                            break;
+                        }
+                    }
+                }
+                if (!tiles[y * tilesX + x]) {
+                    hiddenTiles++;
+                }
+            }
+        }
+
+        if (hiddenTilesCount) {
+            *hiddenTilesCount = hiddenTiles;
+        }
+
+        return tiles;
+    }
+
+    // Compute the FOV of a quad views focus view. The size is a fraction of the tangent span of the full FOV. The focus
+    // view is centered on the gaze when available, or straight ahead otherwise, and it never extends past the full FOV.
+    static XrFovf computeFocusFov(const XrFovf& fullFov,
+                                  float horizontalSize,
+                                  float verticalSize,
+                                  const std::optional<XrVector3f>& gazeUnitVector = {}) {
+        const float left = std::tan(fullFov.angleLeft);
+        const float right = std::tan(fullFov.angleRight);
+        const float down = std::tan(fullFov.angleDown);
+        const float up = std::tan(fullFov.angleUp);
+
+        const float halfWidth = (right - left) * std::clamp(horizontalSize, 0.f, 1.f) / 2;
+        const float halfHeight = (up - down) * std::clamp(verticalSize, 0.f, 1.f) / 2;
+
+        float centerX = 0.f;
+        float centerY = 0.f;
+        if (gazeUnitVector && gazeUnitVector->z < -FLT_EPSILON) {
+            centerX = gazeUnitVector->x / -gazeUnitVector->z;
+            centerY = gazeUnitVector->y / -gazeUnitVector->z;
+        }
+        centerX = std::clamp(centerX, left + halfWidth, right - halfWidth);
+        centerY = std::clamp(centerY, down + halfHeight, up - halfHeight);
+
+        XrFovf focusFov;
+        focusFov.angleLeft = std::atan(centerX - halfWidth);
+        focusFov.angleRight = std::atan(centerX + halfWidth);
+        focusFov.angleDown = std::atan(centerY - halfHeight);
+        focusFov.angleUp = std::atan(centerY + halfHeight);
+
+        return focusFov;
+    }
+
+    // Compute where an image covering the focus FOV lands within an image covering the full FOV, in normalized
+    // coordinates with the origin at the top-left corner.
+    static XrRect2Df computeFocusRect(const XrFovf& fullFov, const XrFovf& focusFov) {
+        const float left = std::tan(fullFov.angleLeft);
+        const float right = std::tan(fullFov.angleRight);
+        const float down = std::tan(fullFov.angleDown);
+        const float up = std::tan(fullFov.angleUp);
+
+        XrRect2Df rect;
+        rect.offset.x = (std::tan(focusFov.angleLeft) - left) / (right - left);
+        rect.offset.y = (up - std::tan(focusFov.angleUp)) / (up - down);
+        rect.extent.width = (std::tan(focusFov.angleRight) - std::tan(focusFov.angleLeft)) / (right - left);
+        rect.extent.height = (std::tan(focusFov.angleUp) - std::tan(focusFov.angleDown)) / (up - down);
+
+        return rect;
+    }
+
+} // namespace virtualdesktop_openxr::utils
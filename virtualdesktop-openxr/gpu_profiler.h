@@ -0,0 +1,131 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+namespace virtualdesktop_openxr::profiler {
+
+    // Rolling statistics of a profiling scope, over the last samples.
+    struct ScopeStatistics {
+        static constexpr size_t WindowSize = 90;
+
+        uint64_t count{0};
+        uint64_t lastUs{0};
+        uint64_t averageUs{0};
+        uint64_t minUs{0};
+        uint64_t maxUs{0};
+        // Nesting level of the scope, 0 for top-level scopes.
+        uint32_t depth{0};
+    };
+
+    // Aggregation of the measurements of hierarchical scopes, identified by their path (eg: "Layer0/Resolve").
+    // Thread-safe: measurements are recorded by the frame thread and the statistics can be read from any thread.
+    class ProfilerStatistics {
+      public:
+        void record(const std::string& path, uint64_t durationUs) {
+            std::unique_lock lock(m_mutex);
+            auto& scope = m_scopes[path];
+            scope.samples.push_back(durationUs);
+            if (scope.samples.size() > ScopeStatistics::WindowSize) {
+                scope.samples.pop_front();
+            }
+            scope.count++;
+            scope.lastUs = durationUs;
+        }
+
+        // Returns the statistics of all scopes, in hierarchical order (parents before their children).
+        std::vector<std::pair<std::string, ScopeStatistics>> snapshot() const {
+            std::unique_lock lock(m_mutex);
+            std::vector<std::pair<std::string, ScopeStatistics>> result;
+            for (const auto& [path, scope] : m_scopes) {
+                ScopeStatistics statistics;
+                statistics.count = scope.count;
+                statistics.lastUs = scope.lastUs;
+                statistics.depth = (uint32_t)std::count(path.begin(), path.end(), Separator);
+                if (!scope.samples.empty()) {
+                    uint64_t total = 0;
+                    statistics.minUs = UINT64_MAX;
+                    for (const auto sample : scope.samples) {
+                        total += sample;
+                        statistics.minUs = std::min(statistics.minUs, sample);
+                        statistics.maxUs = std::max(statistics.maxUs, sample);
+                    }
+                    statistics.averageUs = total / scope.samples.size();
+                }
+                result.emplace_back(path, statistics);
+            }
+            return result;
+        }
+
+        void reset() {
+            std::unique_lock lock(m_mutex);
+            m_scopes.clear();
+        }
+
+        static constexpr char Separator = '/';
+
+      private:
+        struct Scope {
+            std::deque<uint64_t> samples;
+            uint64_t count{0};
+            uint64_t lastUs{0};
+        };
+
+        mutable std::mutex m_mutex;
+        // Ordered by path, so that children follow their parent.
+        std::map<std::string, Scope> m_scopes;
+    };
+
+    // Builds the path of nested scopes.
+    class ScopeStack {
+      public:
+        // Returns the path of the new scope.
+        const std::string& push(std::string_view name, std::optional<uint32_t> index = {}) {
+            m_lengths.push_back(m_path.size());
+            if (!m_path.empty()) {
+                m_path += ProfilerStatistics::Separator;
+            }
+            m_path += name;
+            if (index) {
+                m_path += std::to_string(index.value());
+            }
+            return m_path;
+        }
+
+        void pop() {
+            if (!m_lengths.empty()) {
+                m_path.resize(m_lengths.back());
+                m_lengths.pop_back();
+            }
+        }
+
+        bool empty() const {
+            return m_lengths.empty();
+        }
+
+      private:
+        std::string m_path;
+        std::vector<size_t> m_lengths;
+    };
+
+} // namespace virtualdesktop_openxr::profiler
@@ -2,6 +2,9 @@
 
 #include "pch.h"
 
+#include "gpu_profiler.h"
+#include "timestamp_ring.h"
+
 namespace virtualdesktop_openxr::utils {
 
     // An asynchronous GPU timer for Direct3D 11.
@@ -54,28 +57,68 @@ namespace virtualdesktop_openxr::utils {
         mutable bool m_valid{false};
     };
 
-    // An asynchronous GPU timer for Direct3D 12.
-    struct D3D12GpuTimer : public ITimer {
-        D3D12GpuTimer(ID3D12Device* device, ID3D12CommandQueue* queue) : m_queue(queue) {
-            // Create the command context.
-            for (uint32_t i = 0; i < 2; i++) {
-                CHECK_HRCMD(device->CreateCommandAllocator(
-                    D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(m_commandAllocator[i].ReleaseAndGetAddressOf())));
-                m_commandAllocator[i]->SetName(L"Timer Command Allocator");
-                CHECK_HRCMD(device->CreateCommandList(0,
-                                                      D3D12_COMMAND_LIST_TYPE_DIRECT,
-                                                      m_commandAllocator[i].Get(),
-                                                      nullptr,
-                                                      IID_PPV_ARGS(m_commandList[i].ReleaseAndGetAddressOf())));
-                m_commandList[i]->SetName(L"Timer Command List");
-                CHECK_HRCMD(m_commandList[i]->Close());
+    // An asynchronous GPU timer using a slot of a query pool shared with other timers for each measurement.
+    template <typename QueryPool>
+    struct PooledGpuTimer : public ITimer {
+        PooledGpuTimer(std::shared_ptr<QueryPool> pool) : m_pool(std::move(pool)) {
+        }
+
+        ~PooledGpuTimer() override {
+            if (m_slot) {
+                m_pool->release(m_slot.value());
+            }
+        }
+
+        void start() override {
+            if (m_slot) {
+                m_pool->release(m_slot.value());
+            }
+            m_slot = m_pool->start();
+            m_valid = false;
+        }
+
+        void stop() override {
+            if (m_slot) {
+                m_pool->stop(m_slot.value());
+                m_valid = true;
+            }
+        }
+
+        uint64_t query(bool reset = true) const override {
+            uint64_t duration = 0;
+            if (m_valid) {
+                duration = m_pool->read(m_slot.value()).value_or(0);
+                if (reset) {
+                    // The measurement is dropped if not ready yet. The slot is reclaimed once the GPU is done with it.
+                    m_pool->release(m_slot.value());
+                    m_slot.reset();
+                }
+                m_valid = !reset;
             }
+            return duration;
+        }
+
+      private:
+        const std::shared_ptr<QueryPool> m_pool;
+        mutable std::optional<uint32_t> m_slot;
+
+        // Can the timer be queried (it might still only read 0).
+        mutable bool m_valid{false};
+    };
+
+    // A timestamp query heap shared by the D3D12 timers of a queue. The command lists writing and resolving the
+    // timestamps of each slot are recorded once upfront, so a measurement only costs the execution of two tiny command
+    // lists and a fence signal.
+    class D3D12TimestampQueryPool {
+      public:
+        D3D12TimestampQueryPool(ID3D12Device* device, ID3D12CommandQueue* queue, uint32_t slotCount)
+            : m_queue(queue), m_ring(slotCount) {
             CHECK_HRCMD(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(m_fence.ReleaseAndGetAddressOf())));
             m_fence->SetName(L"Timer Readback Fence");
 
             // Create the query heap and readback resources.
             D3D12_QUERY_HEAP_DESC heapDesc{};
-            heapDesc.Count = 2;
+            heapDesc.Count = 2 * slotCount;
             heapDesc.NodeMask = 0;
             heapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
             CHECK_HRCMD(device->CreateQueryHeap(&heapDesc, IID_PPV_ARGS(m_queryHeap.ReleaseAndGetAddressOf())));
@@ -97,71 +140,112 @@ namespace virtualdesktop_openxr::utils {
                                                         nullptr,
                                                         IID_PPV_ARGS(m_queryReadbackBuffer.ReleaseAndGetAddressOf())));
             m_queryReadbackBuffer->SetName(L"Query Readback Buffer");
+
+            // Record the command lists for all slots. They are never reset, so the allocator is never reset either.
+            CHECK_HRCMD(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT,
+                                                       IID_PPV_ARGS(m_commandAllocator.ReleaseAndGetAddressOf())));
+            m_commandAllocator->SetName(L"Timer Command Allocator");
+            m_startCommandLists.resize(slotCount);
+            m_stopCommandLists.resize(slotCount);
+            for (uint32_t slot = 0; slot < slotCount; slot++) {
+                CHECK_HRCMD(
+                    device->CreateCommandList(0,
+                                              D3D12_COMMAND_LIST_TYPE_DIRECT,
+                                              m_commandAllocator.Get(),
+                                              nullptr,
+                                              IID_PPV_ARGS(m_startCommandLists[slot].ReleaseAndGetAddressOf())));
+                m_startCommandLists[slot]->SetName(L"Timer Start Command List");
+                m_startCommandLists[slot]->EndQuery(
+                    m_queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, TimestampRing::startQuery(slot));
+                CHECK_HRCMD(m_startCommandLists[slot]->Close());
+
+                CHECK_HRCMD(device->CreateCommandList(0,
+                                                      D3D12_COMMAND_LIST_TYPE_DIRECT,
+                                                      m_commandAllocator.Get(),
+                                                      nullptr,
+                                                      IID_PPV_ARGS(m_stopCommandLists[slot].ReleaseAndGetAddressOf())));
+                m_stopCommandLists[slot]->SetName(L"Timer Stop Command List");
+                m_stopCommandLists[slot]->EndQuery(
+                    m_queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, TimestampRing::stopQuery(slot));
+                m_stopCommandLists[slot]->ResolveQueryData(m_queryHeap.Get(),
+                                                           D3D12_QUERY_TYPE_TIMESTAMP,
+                                                           TimestampRing::startQuery(slot),
+                                                           2,
+                                                           m_queryReadbackBuffer.Get(),
+                                                           TimestampRing::startQuery(slot) * sizeof(uint64_t));
+                CHECK_HRCMD(m_stopCommandLists[slot]->Close());
+            }
         }
 
-        void start() override {
-            CHECK_HRCMD(m_commandAllocator[0]->Reset());
-            CHECK_HRCMD(m_commandList[0]->Reset(m_commandAllocator[0].Get(), nullptr));
-            m_commandList[0]->EndQuery(m_queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, 0);
-            CHECK_HRCMD(m_commandList[0]->Close());
-            ID3D12CommandList* const lists[] = {m_commandList[0].Get()};
-            m_queue->ExecuteCommandLists(1, lists);
+        std::optional<uint32_t> start() {
+            const auto slot = m_ring.acquire(m_fence->GetCompletedValue());
+            if (slot) {
+                ID3D12CommandList* const lists[] = {m_startCommandLists[slot.value()].Get()};
+                m_queue->ExecuteCommandLists(1, lists);
+            }
+            return slot;
         }
 
-        void stop() override {
-            CHECK_HRCMD(m_commandAllocator[1]->Reset());
-            CHECK_HRCMD(m_commandList[1]->Reset(m_commandAllocator[1].Get(), nullptr));
-            m_commandList[1]->EndQuery(m_queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, 1);
-            m_commandList[1]->ResolveQueryData(
-                m_queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, 0, 2, m_queryReadbackBuffer.Get(), 0);
-            CHECK_HRCMD(m_commandList[1]->Close());
-            ID3D12CommandList* const lists[] = {m_commandList[1].Get()};
+        void stop(uint32_t slot) {
+            ID3D12CommandList* const lists[] = {m_stopCommandLists[slot].Get()};
             m_queue->ExecuteCommandLists(1, lists);
 
             // Signal a fence for completion.
-            m_queue->Signal(m_fence.Get(), ++m_fenceValue);
-            m_valid = true;
+            CHECK_HRCMD(m_queue->Signal(m_fence.Get(), ++m_fenceValue));
+            m_ring.submit(slot, m_fenceValue);
         }
 
-        uint64_t query(bool reset = true) const override {
-            uint64_t duration = 0;
-            if (m_valid) {
-                uint64_t gpuTickFrequency;
-                if (m_fence->GetCompletedValue() >= m_fenceValue &&
-                    SUCCEEDED(m_queue->GetTimestampFrequency(&gpuTickFrequency))) {
-                    uint64_t* mappedBuffer;
-                    D3D12_RANGE range{0, 2 * sizeof(uint64_t)};
-                    CHECK_HRCMD(m_queryReadbackBuffer->Map(0, &range, reinterpret_cast<void**>(&mappedBuffer)));
-                    duration = ((mappedBuffer[1] - mappedBuffer[0]) * 1000000) / gpuTickFrequency;
-                    m_queryReadbackBuffer->Unmap(0, nullptr);
-                }
-                m_valid = !reset;
+        // Returns the duration in microseconds, or nothing if the GPU has not completed the measurement yet.
+        std::optional<uint64_t> read(uint32_t slot) const {
+            uint64_t gpuTickFrequency;
+            if (!m_ring.isReady(slot, m_fence->GetCompletedValue()) ||
+                FAILED(m_queue->GetTimestampFrequency(&gpuTickFrequency))) {
+                return {};
             }
+
+            uint64_t* mappedBuffer;
+            D3D12_RANGE range{TimestampRing::startQuery(slot) * sizeof(uint64_t),
+                              (TimestampRing::stopQuery(slot) + 1) * sizeof(uint64_t)};
+            CHECK_HRCMD(m_queryReadbackBuffer->Map(0, &range, reinterpret_cast<void**>(&mappedBuffer)));
+            const uint64_t duration = ((mappedBuffer[TimestampRing::stopQuery(slot)] -
+                                        mappedBuffer[TimestampRing::startQuery(slot)]) *
+                                       1000000) /
+                                      gpuTickFrequency;
+            D3D12_RANGE noWrite{0, 0};
+            m_queryReadbackBuffer->Unmap(0, &noWrite);
             return duration;
         }
 
+        void release(uint32_t slot) {
+            m_ring.release(slot);
+        }
+
       private:
         const ComPtr<ID3D12CommandQueue> m_queue;
-        ComPtr<ID3D12CommandAllocator> m_commandAllocator[2];
-        ComPtr<ID3D12GraphicsCommandList> m_commandList[2];
+        TimestampRing m_ring;
+        ComPtr<ID3D12CommandAllocator> m_commandAllocator;
+        std::vector<ComPtr<ID3D12GraphicsCommandList>> m_startCommandLists;
+        std::vector<ComPtr<ID3D12GraphicsCommandList>> m_stopCommandLists;
         ComPtr<ID3D12Fence> m_fence;
         uint64_t m_fenceValue{0};
         ComPtr<ID3D12QueryHeap> m_queryHeap;
         ComPtr<ID3D12Resource> m_queryReadbackBuffer;
-
-        // Can the timer be queried (it might still only read 0).
-        mutable bool m_valid{false};
     };
 
-    // An asynchronous GPU timer for Vulkan.
-    struct VulkanGpuTimer : public ITimer {
-        VulkanGpuTimer(const VulkanDispatch& dispatch,
-                       VkPhysicalDevice physicalDevice,
-                       VkDevice device,
-                       VkQueue queue,
-                       uint32_t queueFamilyIndex,
-                       const std::optional<VkAllocationCallbacks>& allocator)
-            : m_dispatch(dispatch), m_device(device), m_queue(queue), m_allocator(allocator) {
+    using D3D12GpuTimer = PooledGpuTimer<D3D12TimestampQueryPool>;
+
+    // A timestamp query pool shared by the Vulkan timers of a queue. The command buffers writing the timestamps of each
+    // slot are recorded once upfront, so a measurement only costs two tiny submissions.
+    class VulkanTimestampQueryPool {
+      public:
+        VulkanTimestampQueryPool(const VulkanDispatch& dispatch,
+                                 VkPhysicalDevice physicalDevice,
+                                 VkDevice device,
+                                 VkQueue queue,
+                                 uint32_t queueFamilyIndex,
+                                 const std::optional<VkAllocationCallbacks>& allocator,
+                                 uint32_t slotCount)
+            : m_dispatch(dispatch), m_device(device), m_queue(queue), m_allocator(allocator), m_ring(slotCount) {
             // Query the timestamp period.
             VkPhysicalDeviceProperties2 properties{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
             m_dispatch.vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
@@ -169,97 +253,156 @@ namespace virtualdesktop_openxr::utils {
 
             // Create the command context.
             VkCommandPoolCreateInfo poolCreateInfo{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
-            poolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
             poolCreateInfo.queueFamilyIndex = queueFamilyIndex;
             CHECK_VKCMD(m_dispatch.vkCreateCommandPool(
                 m_device, &poolCreateInfo, m_allocator ? &m_allocator.value() : nullptr, &m_cmdPool));
+            m_cmdBuffers.resize(2 * slotCount, VK_NULL_HANDLE);
             VkCommandBufferAllocateInfo allocateInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
             allocateInfo.commandPool = m_cmdPool;
             allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-            allocateInfo.commandBufferCount = 2;
-            CHECK_VKCMD(m_dispatch.vkAllocateCommandBuffers(m_device, &allocateInfo, m_cmdBuffer));
+            allocateInfo.commandBufferCount = (uint32_t)m_cmdBuffers.size();
+            CHECK_VKCMD(m_dispatch.vkAllocateCommandBuffers(m_device, &allocateInfo, m_cmdBuffers.data()));
 
             // Create the query pool.
             VkQueryPoolCreateInfo createInfo{VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
             createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
-            createInfo.queryCount = 2;
+            createInfo.queryCount = 2 * slotCount;
             CHECK_VKCMD(m_dispatch.vkCreateQueryPool(
                 m_device, &createInfo, m_allocator ? &m_allocator.value() : nullptr, &m_queryPool));
+
+            // One fence per command buffer tells when it can be submitted again.
+            m_fences.resize(2 * slotCount, VK_NULL_HANDLE);
+            m_fenceValues.resize(2 * slotCount, 0);
+            for (uint32_t i = 0; i < m_fences.size(); i++) {
+                VkFenceCreateInfo fenceCreateInfo{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+                CHECK_VKCMD(m_dispatch.vkCreateFence(
+                    m_device, &fenceCreateInfo, m_allocator ? &m_allocator.value() : nullptr, &m_fences[i]));
+            }
+
+            // Record the command buffers for all slots.
+            for (uint32_t slot = 0; slot < slotCount; slot++) {
+                VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+                CHECK_VKCMD(m_dispatch.vkBeginCommandBuffer(m_cmdBuffers[TimestampRing::startQuery(slot)], &beginInfo));
+                m_dispatch.vkCmdResetQueryPool(
+                    m_cmdBuffers[TimestampRing::startQuery(slot)], m_queryPool, TimestampRing::startQuery(slot), 2);
+                m_dispatch.vkCmdWriteTimestamp(m_cmdBuffers[TimestampRing::startQuery(slot)],
+                                               VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                               m_queryPool,
+                                               TimestampRing::startQuery(slot));
+                CHECK_VKCMD(m_dispatch.vkEndCommandBuffer(m_cmdBuffers[TimestampRing::startQuery(slot)]));
+
+                CHECK_VKCMD(m_dispatch.vkBeginCommandBuffer(m_cmdBuffers[TimestampRing::stopQuery(slot)], &beginInfo));
+                m_dispatch.vkCmdWriteTimestamp(m_cmdBuffers[TimestampRing::stopQuery(slot)],
+                                               VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                               m_queryPool,
+                                               TimestampRing::stopQuery(slot));
+                CHECK_VKCMD(m_dispatch.vkEndCommandBuffer(m_cmdBuffers[TimestampRing::stopQuery(slot)]));
+            }
         }
 
-        ~VulkanGpuTimer() override {
+        ~VulkanTimestampQueryPool() {
+            for (auto fence : m_fences) {
+                if (fence != VK_NULL_HANDLE) {
+                    m_dispatch.vkDestroyFence(m_device, fence, m_allocator ? &m_allocator.value() : nullptr);
+                }
+            }
             if (m_queryPool != VK_NULL_HANDLE) {
                 m_dispatch.vkDestroyQueryPool(m_device, m_queryPool, m_allocator ? &m_allocator.value() : nullptr);
             }
-            if (m_cmdBuffer[0] != VK_NULL_HANDLE) {
-                m_dispatch.vkFreeCommandBuffers(m_device, m_cmdPool, 2, m_cmdBuffer);
+            if (!m_cmdBuffers.empty() && m_cmdBuffers[0] != VK_NULL_HANDLE) {
+                m_dispatch.vkFreeCommandBuffers(
+                    m_device, m_cmdPool, (uint32_t)m_cmdBuffers.size(), m_cmdBuffers.data());
             }
             if (m_cmdPool != VK_NULL_HANDLE) {
                 m_dispatch.vkDestroyCommandPool(m_device, m_cmdPool, m_allocator ? &m_allocator.value() : nullptr);
             }
         }
 
-        void start() override {
-            VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
-            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-            CHECK_VKCMD(m_dispatch.vkBeginCommandBuffer(m_cmdBuffer[0], &beginInfo));
-            m_dispatch.vkCmdResetQueryPool(m_cmdBuffer[0], m_queryPool, 0, 2);
-            m_dispatch.vkCmdWriteTimestamp(m_cmdBuffer[0], VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_queryPool, 0);
-            CHECK_VKCMD(m_dispatch.vkEndCommandBuffer(m_cmdBuffer[0]));
-            VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
-            submitInfo.commandBufferCount = 1;
-            submitInfo.pCommandBuffers = &m_cmdBuffer[0];
-            CHECK_VKCMD(m_dispatch.vkQueueSubmit(m_queue, 1, &submitInfo, VK_NULL_HANDLE));
+        std::optional<uint32_t> start() {
+            const auto slot = m_ring.acquire(getCompletedValue());
+            if (slot) {
+                // The previous submissions of the slot, if any, are complete.
+                const VkFence fences[] = {m_fences[TimestampRing::startQuery(slot.value())],
+                                          m_fences[TimestampRing::stopQuery(slot.value())]};
+                CHECK_VKCMD(m_dispatch.vkResetFences(m_device, 2, fences));
+                m_fenceValues[TimestampRing::startQuery(slot.value())] = 0;
+                m_fenceValues[TimestampRing::stopQuery(slot.value())] = 0;
+
+                // Track the start submission too, so that a slot released without stop() is not handed out again
+                // while its start command buffer is still pending.
+                submitWithFence(TimestampRing::startQuery(slot.value()));
+                m_ring.submit(slot.value(), m_fenceValue);
+            }
+            return slot;
         }
 
-        void stop() override {
-            VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
-            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-            CHECK_VKCMD(m_dispatch.vkBeginCommandBuffer(m_cmdBuffer[1], &beginInfo));
-            m_dispatch.vkCmdWriteTimestamp(m_cmdBuffer[1], VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_queryPool, 1);
-            CHECK_VKCMD(m_dispatch.vkEndCommandBuffer(m_cmdBuffer[1]));
+        void stop(uint32_t slot) {
+            submitWithFence(TimestampRing::stopQuery(slot));
+            m_ring.submit(slot, m_fenceValue);
+        }
+
+        // Returns the duration in microseconds, or nothing if the GPU has not completed the measurement yet.
+        std::optional<uint64_t> read(uint32_t slot) const {
+            if (!m_ring.isReady(slot, getCompletedValue())) {
+                return {};
+            }
+
+            uint64_t buffer[2];
+            const VkResult result = m_dispatch.vkGetQueryPoolResults(m_device,
+                                                                     m_queryPool,
+                                                                     TimestampRing::startQuery(slot),
+                                                                     2,
+                                                                     sizeof(uint64_t) * 2,
+                                                                     buffer,
+                                                                     sizeof(uint64_t),
+                                                                     VK_QUERY_RESULT_64_BIT);
+            if (result != VK_SUCCESS) {
+                return {};
+            }
+            return static_cast<uint64_t>(((buffer[1] - buffer[0]) * m_timestampPeriod) / 1000);
+        }
+
+        void release(uint32_t slot) {
+            m_ring.release(slot);
+        }
+
+      private:
+        void submitWithFence(uint32_t query) {
             VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
             submitInfo.commandBufferCount = 1;
-            submitInfo.pCommandBuffers = &m_cmdBuffer[1];
-            CHECK_VKCMD(m_dispatch.vkQueueSubmit(m_queue, 1, &submitInfo, VK_NULL_HANDLE));
-            m_valid = true;
+            submitInfo.pCommandBuffers = &m_cmdBuffers[query];
+            CHECK_VKCMD(m_dispatch.vkQueueSubmit(m_queue, 1, &submitInfo, m_fences[query]));
+            m_fenceValues[query] = ++m_fenceValue;
         }
 
-        uint64_t query(bool reset = true) const override {
-            uint64_t duration = 0;
-            if (m_valid) {
-                uint64_t buffer[2];
-                VkResult result = m_dispatch.vkGetQueryPoolResults(m_device,
-                                                                   m_queryPool,
-                                                                   0,
-                                                                   2,
-                                                                   sizeof(uint64_t) * 2,
-                                                                   buffer,
-                                                                   sizeof(uint64_t),
-                                                                   VK_QUERY_RESULT_64_BIT);
-                if (result == VK_SUCCESS) {
-                    duration = static_cast<uint64_t>(((buffer[1] - buffer[0]) * m_timestampPeriod) / 1000);
+        // Submissions to the queue complete in order, so the most recent signaled fence tells what is completed.
+        uint64_t getCompletedValue() const {
+            uint64_t completedValue = 0;
+            for (uint32_t i = 0; i < m_fences.size(); i++) {
+                if (m_fenceValues[i] > completedValue &&
+                    m_dispatch.vkGetFenceStatus(m_device, m_fences[i]) == VK_SUCCESS) {
+                    completedValue = m_fenceValues[i];
                 }
-
-                m_valid = !reset;
             }
-            return duration;
+            return completedValue;
         }
 
-      private:
         const VulkanDispatch& m_dispatch;
         const VkDevice m_device;
         const VkQueue m_queue;
         const std::optional<VkAllocationCallbacks> m_allocator;
+        TimestampRing m_ring;
         float m_timestampPeriod{};
         VkCommandPool m_cmdPool{VK_NULL_HANDLE};
-        VkCommandBuffer m_cmdBuffer[2]{VK_NULL_HANDLE, VK_NULL_HANDLE};
+        std::vector<VkCommandBuffer> m_cmdBuffers;
         VkQueryPool m_queryPool{VK_NULL_HANDLE};
-
-        // Can the timer be queried (it might still only read 0).
-        mutable bool m_valid{false};
+        std::vector<VkFence> m_fences;
+        std::vector<uint64_t> m_fenceValues;
+        uint64_t m_fenceValue{0};
     };
 
+    using VulkanGpuTimer = PooledGpuTimer<VulkanTimestampQueryPool>;
+
     // An asynchronous GPU timer for OpenGL.
     struct GlGpuTimer : public ITimer {
         GlGpuTimer(const GlDispatch& dispatch, const GlContext& context) : m_dispatch(dispatch), m_context(context) {
@@ -315,4 +458,171 @@ namespace virtualdesktop_openxr::utils {
         mutable bool m_valid{false};
     };
 
+    // A profiler measuring named, nested GPU scopes for Direct3D 11.
+    // The queries of a frame are collected frameLatency frames later, in order to never stall on the GPU.
+    class D3D11GpuProfiler {
+      public:
+        D3D11GpuProfiler(ID3D11Device* device,
+                         ID3D11DeviceContext* context,
+                         uint32_t frameLatency,
+                         profiler::ProfilerStatistics& statistics)
+            : m_device(device), m_context(context), m_frames(frameLatency), m_statistics(statistics) {
+            for (auto& frame : m_frames) {
+                D3D11_QUERY_DESC queryDesc{};
+                queryDesc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+                CHECK_HRCMD(device->CreateQuery(&queryDesc, frame.disjoint.ReleaseAndGetAddressOf()));
+            }
+        }
+
+        void beginFrame() {
+            auto& frame = m_frames[m_frameIndex % m_frames.size()];
+            if (frame.pending) {
+                collect(frame);
+            }
+
+            m_context->Begin(frame.disjoint.Get());
+            frame.usedScopes = 0;
+            m_isFrameActive = true;
+        }
+
+        void endFrame() {
+            if (!m_isFrameActive) {
+                return;
+            }
+
+            // Close any scope left open by an early exit.
+            while (!m_openScopes.empty()) {
+                pop();
+            }
+
+            auto& frame = m_frames[m_frameIndex % m_frames.size()];
+            m_context->End(frame.disjoint.Get());
+            frame.pending = true;
+            m_isFrameActive = false;
+            m_frameIndex++;
+        }
+
+        void push(std::string_view name, std::optional<uint32_t> index = {}) {
+            const auto& path = m_stack.push(name, index);
+            if (!m_isFrameActive) {
+                m_openScopes.push_back(SIZE_MAX);
+                return;
+            }
+
+            auto& frame = m_frames[m_frameIndex % m_frames.size()];
+            if (frame.usedScopes == frame.scopes.size()) {
+                Scope scope;
+                D3D11_QUERY_DESC queryDesc{};
+                queryDesc.Query = D3D11_QUERY_TIMESTAMP;
+                CHECK_HRCMD(m_device->CreateQuery(&queryDesc, scope.start.ReleaseAndGetAddressOf()));
+                CHECK_HRCMD(m_device->CreateQuery(&queryDesc, scope.end.ReleaseAndGetAddressOf()));
+                frame.scopes.push_back(std::move(scope));
+            }
+
+            auto& scope = frame.scopes[frame.usedScopes];
+            scope.path = path;
+            m_context->End(scope.start.Get());
+            m_openScopes.push_back(frame.usedScopes++);
+        }
+
+        void pop() {
+            if (m_openScopes.empty()) {
+                return;
+            }
+
+            const auto index = m_openScopes.back();
+            m_openScopes.pop_back();
+            m_stack.pop();
+            if (index != SIZE_MAX && m_isFrameActive) {
+                m_context->End(m_frames[m_frameIndex % m_frames.size()].scopes[index].end.Get());
+            }
+        }
+
+        bool isFrameActive() const {
+            return m_isFrameActive;
+        }
+
+        // The measurements of the frame collected by the last call to beginFrame().
+        const std::vector<std::pair<std::string, uint64_t>>& getLastMeasurements() const {
+            return m_lastMeasurements;
+        }
+
+      private:
+        struct Scope {
+            std::string path;
+            ComPtr<ID3D11Query> start;
+            ComPtr<ID3D11Query> end;
+        };
+
+        struct Frame {
+            ComPtr<ID3D11Query> disjoint;
+            std::vector<Scope> scopes;
+            size_t usedScopes{0};
+            bool pending{false};
+        };
+
+        void collect(Frame& frame) {
+            frame.pending = false;
+            m_lastMeasurements.clear();
+
+            // Measurements that are not available yet are dropped rather than waited for.
+            D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disData{};
+            if (m_context->GetData(frame.disjoint.Get(),
+                                   &disData,
+                                   sizeof(disData),
+                                   D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK ||
+                disData.Disjoint) {
+                return;
+            }
+
+            for (size_t i = 0; i < frame.usedScopes; i++) {
+                const auto& scope = frame.scopes[i];
+                UINT64 startTime = 0, endTime = 0;
+                if (m_context->GetData(
+                        scope.start.Get(), &startTime, sizeof(UINT64), D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK &&
+                    m_context->GetData(scope.end.Get(), &endTime, sizeof(UINT64), D3D11_ASYNC_GETDATA_DONOTFLUSH) ==
+                        S_OK &&
+                    endTime >= startTime) {
+                    const auto durationUs = static_cast<uint64_t>(((endTime - startTime) * 1e6) / disData.Frequency);
+                    m_statistics.record(scope.path, durationUs);
+                    m_lastMeasurements.emplace_back(scope.path, durationUs);
+                }
+            }
+        }
+
+        const ComPtr<ID3D11Device> m_device;
+        const ComPtr<ID3D11DeviceContext> m_context;
+        std::vector<Frame> m_frames;
+        uint64_t m_frameIndex{0};
+        bool m_isFrameActive{false};
+
+        profiler::ScopeStack m_stack;
+        std::vector<size_t> m_openScopes;
+        std::vector<std::pair<std::string, uint64_t>> m_lastMeasurements;
+        profiler::ProfilerStatistics& m_statistics;
+    };
+
+    // Measures a named GPU scope for the duration of the C++ scope. No-op unless the profiler is capturing a frame.
+    class GpuProfilerScope {
+      public:
+        GpuProfilerScope(D3D11GpuProfiler* profiler, std::string_view name, std::optional<uint32_t> index = {})
+            : m_profiler(profiler && profiler->isFrameActive() ? profiler : nullptr) {
+            if (m_profiler) {
+                m_profiler->push(name, index);
+            }
+        }
+
+        ~GpuProfilerScope() {
+            if (m_profiler) {
+                m_profiler->pop();
+            }
+        }
+
+        GpuProfilerScope(const GpuProfilerScope&) = delete;
+        GpuProfilerScope& operator=(const GpuProfilerScope&) = delete;
+
+      private:
+        D3D11GpuProfiler* const m_profiler;
+    };
+
 } // namespace virtualdesktop_openxr::utils
@@ -0,0 +1,147 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+namespace virtualdesktop_openxr::graphics {
+
+    enum class Api {
+        Headless = 0,
+        D3D11,
+        D3D12,
+        Vulkan,
+        OpenGL,
+
+        Count
+    };
+
+    static inline const char* ToString(Api api) {
+        switch (api) {
+        case Api::Headless:
+            return "Headless";
+        case Api::D3D11:
+            return "D3D11";
+        case Api::D3D12:
+            return "D3D12";
+        case Api::Vulkan:
+            return "Vulkan";
+        case Api::OpenGL:
+            return "OpenGL";
+        default:
+            return "Unknown";
+        }
+    }
+
+    // The only operations on the application's graphics API that the frame, swapchain and session logic needs. All
+    // the rest of the core runtime logic must stay agnostic of the graphics API.
+    template <typename TSwapchain>
+    struct IBackend {
+        virtual ~IBackend() = default;
+
+        virtual Api getApi() const = 0;
+
+        // Order the application's work before the submission device accesses the swapchain images.
+        virtual void serializeFrame() = 0;
+
+        // Wait for all the application's work in flight.
+        virtual void flush() = 0;
+
+        virtual XrResult getSwapchainImages(TSwapchain& swapchain,
+                                            XrSwapchainImageBaseHeader* images,
+                                            uint32_t count) = 0;
+        virtual void cleanupSwapchainImages(TSwapchain& swapchain) = 0;
+    };
+
+    // Forwards to the per-API implementation, with TImage being the API-specific XrSwapchainImage structure.
+    template <typename TSwapchain, typename TImage>
+    class DelegateBackend : public IBackend<TSwapchain> {
+      public:
+        using GetSwapchainImages = std::function<XrResult(TSwapchain&, TImage*, uint32_t)>;
+        using CleanupSwapchainImages = std::function<void(TSwapchain&)>;
+
+        DelegateBackend(Api api,
+                        std::function<void()> serializeFrame,
+                        std::function<void()> flush,
+                        GetSwapchainImages getSwapchainImages,
+                        CleanupSwapchainImages cleanupSwapchainImages = {})
+            : m_api(api), m_serializeFrame(std::move(serializeFrame)), m_flush(std::move(flush)),
+              m_getSwapchainImages(std::move(getSwapchainImages)),
+              m_cleanupSwapchainImages(std::move(cleanupSwapchainImages)) {
+        }
+
+        Api getApi() const override {
+            return m_api;
+        }
+
+        void serializeFrame() override {
+            m_serializeFrame();
+        }
+
+        void flush() override {
+            m_flush();
+        }
+
+        XrResult getSwapchainImages(TSwapchain& swapchain,
+                                    XrSwapchainImageBaseHeader* images,
+                                    uint32_t count) override {
+            return m_getSwapchainImages(swapchain, reinterpret_cast<TImage*>(images), count);
+        }
+
+        void cleanupSwapchainImages(TSwapchain& swapchain) override {
+            if (m_cleanupSwapchainImages) {
+                m_cleanupSwapchainImages(swapchain);
+            }
+        }
+
+      private:
+        const Api m_api;
+        const std::function<void()> m_serializeFrame;
+        const std::function<void()> m_flush;
+        const GetSwapchainImages m_getSwapchainImages;
+        const CleanupSwapchainImages m_cleanupSwapchainImages;
+    };
+
+    // No-op backend for sessions without graphics bindings (XR_MND_headless). Such sessions cannot create swapchains.
+    template <typename TSwapchain>
+    class HeadlessBackend : public IBackend<TSwapchain> {
+      public:
+        Api getApi() const override {
+            return Api::Headless;
+        }
+
+        void serializeFrame() override {
+        }
+
+        void flush() override {
+        }
+
+        XrResult getSwapchainImages(TSwapchain& swapchain,
+                                    XrSwapchainImageBaseHeader* images,
+                                    uint32_t count) override {
+            return XR_ERROR_RUNTIME_FAILURE;
+        }
+
+        void cleanupSwapchainImages(TSwapchain& swapchain) override {
+        }
+    };
+
+} // namespace virtualdesktop_openxr::graphics
@@ -319,7 +319,7 @@ namespace virtualdesktop_openxr {
 
             // Check the hand state.
             bool needHeightAdjustment = ovr_GetTrackingOriginType(m_ovrSession) == ovrTrackingOrigin_FloorLevel;
-            if (m_bodyState && xrHandTracker.useOpticalTracking &&
+            if (m_bodyStateSource && xrHandTracker.useOpticalTracking &&
                 ((xrHandTracker.side == xr::Side::Left && m_cachedBodyState.LeftHandActive) ||
                  (xrHandTracker.side == xr::Side::Right && m_cachedBodyState.RightHandActive))) {
                 joints = xrHandTracker.side == xr::Side::Left ? m_cachedBodyState.LeftHandJointStates
@@ -502,7 +502,7 @@ namespace virtualdesktop_openxr {
     void OpenXrRuntime::processHandGestures(uint32_t side) {
         std::shared_lock lock(m_bodyStateMutex);
 
-        if (m_bodyState &&
+        if (m_bodyStateSource &&
             ((side == xr::Side::Left && m_cachedBodyState.LeftHandActive) || m_cachedBodyState.RightHandActive)) {
             const BodyTracking::FingerJointState* joints =
                 side == xr::Side::Left ? m_cachedBodyState.LeftHandJointStates : m_cachedBodyState.RightHandJointStates;
@@ -585,7 +585,7 @@ namespace virtualdesktop_openxr {
     bool OpenXrRuntime::getPinchPose(int side, const XrPosef& controllerPose, XrPosef& pose) const {
         std::shared_lock lock(m_bodyStateMutex);
 
-        if (m_bodyState &&
+        if (m_bodyStateSource &&
             ((side == xr::Side::Left && m_cachedBodyState.LeftHandActive) || m_cachedBodyState.RightHandActive)) {
             const BodyTracking::HandTrackingAimState& aimState =
                 side == xr::Side::Left ? m_cachedBodyState.LeftAimState : m_cachedBodyState.RightAimState;
@@ -52,11 +52,25 @@ namespace virtualdesktop_openxr {
         RuntimeVersionPatch,
         RuntimeCommitHash);
 
+    // The configuration as written by the Virtual Desktop Streamer or the standalone settings tool.
+    struct RegistrySettingsStore : platform::ISettingsStore {
+        std::optional<int> getDword(const std::string& name) const override {
+            return RegGetDword(HKEY_LOCAL_MACHINE, RegPrefix, name);
+        }
+    };
+
     OpenXrRuntime::OpenXrRuntime() {
         const auto runtimeVersion =
             xr::ToString(XR_MAKE_VERSION(RuntimeVersionMajor, RuntimeVersionMinor, RuntimeVersionPatch));
         TraceLoggingWrite(g_traceProvider, "VirtualDesktopOpenXR", TLArg(runtimeVersion.c_str(), "Version"));
 
+        m_settingsStore = std::make_shared<RegistrySettingsStore>();
+
+        // Keep the log file off the frame loop while the instance exists.
+        if (getSetting("async_logging").value_or(true)) {
+            StartAsyncLogging();
+        }
+
         m_useApplicationDeviceForSubmission = getSetting("quirk_use_application_device_for_submission").value_or(false);
 
         // Latch the disabled trackers now.
@@ -101,14 +115,13 @@ namespace virtualdesktop_openxr {
             xrDestroySession((XrSession)1);
         }
 
-        if (m_bodyState) {
-            UnmapViewOfFile(m_bodyState);
-        }
-
         if (m_ovrSession) {
             ovr_Destroy(m_ovrSession);
         }
         ovr_Shutdown();
+
+        // The writer thread must not outlive the instance, since the runtime may be unloaded afterwards.
+        StopAsyncLogging();
     }
 
     // https://www.khronos.org/registry/OpenXR/specs/1.0/html/xrspec.html#xrGetInstanceProcAddr
@@ -588,6 +601,20 @@ namespace virtualdesktop_openxr {
         m_extensionsTable.push_back( // Audio GUID.
             {XR_OCULUS_AUDIO_DEVICE_GUID_EXTENSION_NAME, XR_OCULUS_audio_device_guid_SPEC_VERSION});
 
+        m_extensionsTable.push_back( // Dynamic resolution.
+            {XR_META_RECOMMENDED_LAYER_RESOLUTION_EXTENSION_NAME, XR_META_recommended_layer_resolution_SPEC_VERSION});
+
+        m_extensionsTable.push_back( // Quad views rendering.
+            {XR_VARJO_QUAD_VIEWS_EXTENSION_NAME, XR_VARJO_quad_views_SPEC_VERSION});
+        m_extensionsTable.push_back( // Quad views rendering.
+            {XR_VARJO_FOVEATED_RENDERING_EXTENSION_NAME, XR_VARJO_foveated_rendering_SPEC_VERSION});
+
+        // Partial resolves. Vendor-internal, see vdxr_swapchain_damage_region.h.
+        if (getSetting("swapchain_damage_region").value_or(false)) {
+            m_extensionsTable.push_back(
+                {XR_VDXR_SWAPCHAIN_DAMAGE_REGION_EXTENSION_NAME, XR_VDXR_swapchain_damage_region_SPEC_VERSION});
+        }
+
 #ifdef HAS_CYLINDER_LAYERS
         m_extensionsTable.push_back( // Cylinder layers.
             {XR_KHR_COMPOSITION_LAYER_CYLINDER_EXTENSION_NAME, XR_KHR_composition_layer_cylinder_SPEC_VERSION});
@@ -668,7 +695,7 @@ namespace virtualdesktop_openxr {
     }
 
     std::optional<int> OpenXrRuntime::getSetting(const std::string& value) const {
-        return RegGetDword(HKEY_LOCAL_MACHINE, RegPrefix, value);
+        return m_settingsStore->getDword(value);
     }
 
     // Singleton class instance.
@@ -0,0 +1,170 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+namespace virtualdesktop_openxr::interop {
+
+    // A queue of work items executed in submission order by a single dedicated thread, which may own resources that
+    // cannot move between threads (such as a graphics context).
+    class WorkerQueue {
+      public:
+        using Ticket = uint64_t;
+
+        // onStart() and onStop() are invoked on the worker thread. An exception thrown by onStart() is rethrown by the
+        // constructor.
+        WorkerQueue(std::function<void()> onStart = {}, std::function<void()> onStop = {})
+            : m_onStop(std::move(onStop)) {
+            std::promise<void> started;
+            auto startedFuture = started.get_future();
+            m_thread = std::thread([this, onStart = std::move(onStart), started = std::move(started)]() mutable {
+                try {
+                    if (onStart) {
+                        onStart();
+                    }
+                } catch (...) {
+                    started.set_exception(std::current_exception());
+                    return;
+                }
+                started.set_value();
+                threadMain();
+            });
+
+            try {
+                startedFuture.get();
+            } catch (...) {
+                m_thread.join();
+                throw;
+            }
+        }
+
+        ~WorkerQueue() {
+            stop();
+        }
+
+        WorkerQueue(const WorkerQueue&) = delete;
+        WorkerQueue& operator=(const WorkerQueue&) = delete;
+
+        // Queue work without waiting for it. An exception thrown by the work is rethrown by the next wait.
+        Ticket submit(std::function<void()> work) {
+            std::unique_lock lock(m_mutex);
+            m_queue.push_back(std::move(work));
+            const Ticket ticket = ++m_submitted;
+            lock.unlock();
+            m_workAvailable.notify_one();
+            return ticket;
+        }
+
+        // Wait for the completion of the work for a ticket and all the work submitted before it.
+        void waitFor(Ticket ticket) {
+            std::unique_lock lock(m_mutex);
+            m_workCompleted.wait(lock, [&] { return m_completed >= ticket || m_stopped; });
+            if (m_error) {
+                std::rethrow_exception(std::exchange(m_error, nullptr));
+            }
+        }
+
+        // Run work on the worker thread and wait for its result.
+        template <typename Work>
+        auto run(Work&& work) -> decltype(work()) {
+            using Result = decltype(work());
+            std::packaged_task<Result()> task(std::forward<Work>(work));
+            auto result = task.get_future();
+            // std::function requires a copyable callable.
+            auto sharedTask = std::make_shared<std::packaged_task<Result()>>(std::move(task));
+            waitFor(submit([sharedTask] { (*sharedTask)(); }));
+            return result.get();
+        }
+
+        Ticket getCompletedTicket() const {
+            std::unique_lock lock(m_mutex);
+            return m_completed;
+        }
+
+        // Complete all the submitted work and terminate the worker thread.
+        void stop() {
+            {
+                std::unique_lock lock(m_mutex);
+                if (!m_thread.joinable()) {
+                    return;
+                }
+                m_stopRequested = true;
+            }
+            m_workAvailable.notify_one();
+            m_thread.join();
+        }
+
+      private:
+        void threadMain() {
+            std::unique_lock lock(m_mutex);
+            while (true) {
+                m_workAvailable.wait(lock, [&] { return !m_queue.empty() || m_stopRequested; });
+                if (m_queue.empty()) {
+                    break;
+                }
+
+                auto work = std::move(m_queue.front());
+                m_queue.pop_front();
+                lock.unlock();
+                std::exception_ptr error;
+                try {
+                    work();
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                lock.lock();
+                if (error && !m_error) {
+                    m_error = error;
+                }
+                m_completed++;
+                m_workCompleted.notify_all();
+            }
+            lock.unlock();
+
+            if (m_onStop) {
+                try {
+                    m_onStop();
+                } catch (...) {
+                }
+            }
+
+            lock.lock();
+            m_stopped = true;
+            m_workCompleted.notify_all();
+        }
+
+        std::thread m_thread;
+        const std::function<void()> m_onStop;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_workAvailable;
+        std::condition_variable m_workCompleted;
+        std::deque<std::function<void()>> m_queue;
+        Ticket m_submitted{0};
+        Ticket m_completed{0};
+        std::exception_ptr m_error;
+        bool m_stopRequested{false};
+        bool m_stopped{false};
+    };
+
+} // namespace virtualdesktop_openxr::interop
@@ -0,0 +1,123 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+namespace virtualdesktop_openxr::density {
+
+    // Angular size of a layer, in radians.
+    struct AngularExtent {
+        float width;
+        float height;
+    };
+
+    // Layers closer than this are considered at this distance, in meters.
+    constexpr float MinDistance = 0.05f;
+
+    // Never reduce an image below this size, in pixels.
+    constexpr int32_t MinExtent = 16;
+
+    constexpr uint32_t MaxLevel = 4;
+
+    // Hysteresis before increasing the downsampling level, so that small head motion does not cause the layer to
+    // bounce between two resolutions.
+    constexpr float LevelUpHysteresis = 1.15f;
+
+    static inline float Distance(const XrVector3f& a, const XrVector3f& b) {
+        const float dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    // Angular resolution of the display at the center of the FOV (where it is the highest), in pixels per radian.
+    static inline XrVector2f GetDisplayDensity(const XrFovf& fov, const XrExtent2Di& nativeSize) {
+        return {nativeSize.width / (std::tan(fov.angleRight) - std::tan(fov.angleLeft)),
+                nativeSize.height / (std::tan(fov.angleUp) - std::tan(fov.angleDown))};
+    }
+
+    // Upper bound of the angular size of a quad: the quad is assumed to face the viewer.
+    static inline AngularExtent GetQuadAngularExtent(const XrVector3f& center,
+                                                     const XrExtent2Df& size,
+                                                     const XrVector3f& eyePosition) {
+        const float distance = std::max(Distance(center, eyePosition), MinDistance);
+        return {2.f * std::atan(size.width / 2.f / distance), 2.f * std::atan(size.height / 2.f / distance)};
+    }
+
+    // Approximate angular size of a cylinder. Exact when the viewer is on the axis of the cylinder, and an upper bound
+    // from the closest point of the surface otherwise.
+    static inline AngularExtent GetCylinderAngularExtent(const XrVector3f& center,
+                                                         float radius,
+                                                         float centralAngle,
+                                                         float aspectRatio,
+                                                         const XrVector3f& eyePosition) {
+        const float arcLength = radius * centralAngle;
+        const float height = aspectRatio > 0.f ? arcLength / aspectRatio : 0.f;
+        const float offset = Distance(center, eyePosition);
+        if (offset < radius) {
+            // Inside the cylinder: the arc wraps around the viewer.
+            const float distance = std::max(radius - offset, MinDistance);
+            return {std::min(arcLength / distance, 2.f * 3.14159265f), 2.f * std::atan(height / 2.f / distance)};
+        }
+
+        // Outside the cylinder: treat it as a quad spanning the chord of the arc.
+        const float chord = 2.f * radius * std::sin(std::min(centralAngle, 3.14159265f) / 2.f);
+        const float distance = std::max(offset - radius, MinDistance);
+        return {2.f * std::atan(chord / 2.f / distance), 2.f * std::atan(height / 2.f / distance)};
+    }
+
+    // How many times the image density exceeds the display density (the smallest of both axes).
+    static inline float GetOversampling(const XrExtent2Di& imageExtent,
+                                        const AngularExtent& angularExtent,
+                                        const XrVector2f& displayDensity) {
+        if (angularExtent.width <= 0.f || angularExtent.height <= 0.f || displayDensity.x <= 0.f ||
+            displayDensity.y <= 0.f) {
+            return 1.f;
+        }
+        const float densityX = imageExtent.width / angularExtent.width;
+        const float densityY = imageExtent.height / angularExtent.height;
+        return std::min(densityX / displayDensity.x, densityY / displayDensity.y);
+    }
+
+    // The number of times the image can be halved (like a mip level) while staying above the display density.
+    static inline uint32_t GetDownsamplingLevel(float oversampling,
+                                                const XrExtent2Di& imageExtent,
+                                                uint32_t previousLevel = 0) {
+        if (!(oversampling >= 2.f)) {
+            return 0;
+        }
+
+        uint32_t level = (uint32_t)std::floor(std::log2(oversampling));
+        if (level > previousLevel) {
+            level = std::max(previousLevel, (uint32_t)std::floor(std::log2(oversampling / LevelUpHysteresis)));
+        }
+        level = std::min(level, MaxLevel);
+        while (level && std::min(imageExtent.width >> level, imageExtent.height >> level) < MinExtent) {
+            level--;
+        }
+        return level;
+    }
+
+    static inline XrExtent2Di GetDownsampledExtent(const XrExtent2Di& imageExtent, uint32_t level) {
+        return {std::max(imageExtent.width >> level, 1), std::max(imageExtent.height >> level, 1)};
+    }
+
+} // namespace virtualdesktop_openxr::density
@@ -23,6 +23,7 @@
 #include "pch.h"
 
 #include "runtime.h"
+#include "framework/async_log.h"
 
 namespace {
 #ifdef _DEBUG
@@ -45,21 +46,51 @@ namespace virtualdesktop_openxr::log {
 
     namespace {
 
-        // Utility logging function.
-        void InternalLog(const char* fmt, va_list va) {
+        // Serializes the writer thread with the messages that are written synchronously.
+        std::mutex g_writeMutex;
+
+        void Write(const char* text) {
+            std::unique_lock lock(g_writeMutex);
+            OutputDebugStringA(text);
+            if (logStream.is_open()) {
+                logStream << text;
+                logStream.flush();
+            }
+        }
+
+        // While the instance exists, messages are formatted and written by a background thread. The logger is never
+        // destroyed: joining its thread from a static destructor would happen under the loader lock, and the thread is
+        // already stopped by ~OpenXrRuntime.
+        AsyncLogger& g_asyncLogger = *new AsyncLogger([](const std::string& batch) { Write(batch.c_str()); });
+
+        // Format and write a message on the calling thread.
+        void SynchronousLog(const char* fmt, va_list va) {
             const std::time_t now = std::time(nullptr);
 
             char buf[1024];
             size_t offset = std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S %z: ", std::localtime(&now));
             vsnprintf_s(buf + offset, sizeof(buf) - offset, _TRUNCATE, fmt, va);
-            OutputDebugStringA(buf);
-            if (logStream.is_open()) {
-                logStream << buf;
-                logStream.flush();
+            Write(buf);
+        }
+
+        // Utility logging function.
+        void InternalLog(const char* fmt, va_list va) {
+            if (g_asyncLogger.vlog(fmt, va)) {
+                return;
             }
+
+            SynchronousLog(fmt, va);
         }
     } // namespace
 
+    void StartAsyncLogging() {
+        g_asyncLogger.start();
+    }
+
+    void StopAsyncLogging() {
+        g_asyncLogger.stop();
+    }
+
     void Log(const char* fmt, ...) {
         va_list va;
         va_start(va, fmt);
@@ -69,9 +100,13 @@ namespace virtualdesktop_openxr::log {
 
     void ErrorLog(const char* fmt, ...) {
         if (g_globalErrorCount++ < k_maxLoggedErrors) {
+            // Errors are written before returning, so they are not lost if the process crashes right after. The pending
+            // messages are written first to keep the log in order.
+            g_asyncLogger.flush();
+
             va_list va;
             va_start(va, fmt);
-            InternalLog(fmt, va);
+            SynchronousLog(fmt, va);
             va_end(va);
             if (g_globalErrorCount == k_maxLoggedErrors) {
                 Log("Maximum number of errors logged. Going silent.\n");
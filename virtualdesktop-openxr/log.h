@@ -49,9 +49,15 @@ namespace virtualdesktop_openxr::log {
     // Debug logging function. Can make things very slow (only enabled on Debug builds).
     void DebugLog(const char* fmt, ...);
 
-    // Error logging function. Goes silent after too many errors.
+    // Error logging function. Goes silent after too many errors. Always written before returning, even when logging
+    // asynchronously.
     void ErrorLog(const char* fmt, ...);
 
+    // Defer the formatting and writing of the messages to a background thread, so that logging does not block the
+    // caller. Until started (and after stopping), messages are written synchronously.
+    void StartAsyncLogging();
+    void StopAsyncLogging();
+
 #define OnceLog(...)                                                                                                   \
     {                                                                                                                  \
         static bool logged = false;                                                                                    \
@@ -72,11 +72,44 @@ namespace virtualdesktop_openxr {
             ShowWindow(m_mirrorWindowHwnd, SW_SHOWNOACTIVATE);
             UpdateWindow(m_mirrorWindowHwnd);
 
-            // Service the window.
-            MSG msg;
-            while (GetMessage(&msg, m_mirrorWindowHwnd, 0, 0) > 0) {
-                TranslateMessage(&msg);
-                DispatchMessage(&msg);
+            // The mirror window uses its own device, so that its copy and present are never serialized with the
+            // frame submission.
+            try {
+                initializeMirrorWindowDevice();
+            } catch (std::exception& exc) {
+                TraceLoggingWrite(g_traceProvider, "MirrorWindow", TLArg(exc.what(), "Error"));
+                ErrorLog("Failed to initialize the mirror window: %s\n", exc.what());
+            }
+
+            // Service the window, and present in-between messages at the requested rate.
+            RateLimiter presentRate;
+            bool quit = false;
+            while (!quit) {
+                presentRate.setRate(m_mirrorWindowFrameRate);
+                const auto timeout = std::chrono::ceil<std::chrono::milliseconds>(presentRate.timeUntilNext());
+                MsgWaitForMultipleObjects(0, nullptr, FALSE, static_cast<DWORD>(timeout.count()), QS_ALLINPUT);
+
+                MSG msg;
+                while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
+                    if (msg.message == WM_QUIT) {
+                        quit = true;
+                        break;
+                    }
+                    TranslateMessage(&msg);
+                    DispatchMessage(&msg);
+                }
+
+                // Always consume the present slot, even without a device, otherwise the next timeout stays at 0 and
+                // the loop spins.
+                const bool isPresentDue = presentRate.poll();
+                if (!quit && isPresentDue && m_mirrorWindowDevice) {
+                    try {
+                        presentMirrorWindow();
+                    } catch (std::exception& exc) {
+                        TraceLoggingWrite(g_traceProvider, "MirrorWindow", TLArg(exc.what(), "Error"));
+                        ErrorLog("Failed to update the mirror window: %s\n", exc.what());
+                    }
+                }
             }
 
             // Free resources ASAP.
@@ -86,12 +119,53 @@ namespace virtualdesktop_openxr {
                 m_mirrorTexture.Reset();
                 ovr_DestroyMirrorTexture(m_ovrSession, m_ovrMirrorSwapChain);
                 m_ovrMirrorSwapChain = nullptr;
+                m_vramBudget.release(&m_ovrMirrorSwapChain);
+                m_mirrorWindowGpuTimer.reset();
+                m_mirrorWindowContext.Reset();
+                m_mirrorWindowDevice.Reset();
                 m_mirrorWindowHwnd = nullptr;
             }
         });
     }
 
-    void OpenXrRuntime::updateMirrorWindow(bool preferSRGB) {
+    void OpenXrRuntime::initializeMirrorWindowDevice() {
+        ComPtr<IDXGIFactory1> dxgiFactory;
+        CHECK_HRCMD(CreateDXGIFactory1(IID_PPV_ARGS(dxgiFactory.ReleaseAndGetAddressOf())));
+
+        ComPtr<IDXGIAdapter1> dxgiAdapter;
+        for (UINT adapterIndex = 0;; adapterIndex++) {
+            // EnumAdapters1 will fail with DXGI_ERROR_NOT_FOUND when there are no more adapters to
+            // enumerate.
+            CHECK_HRCMD(dxgiFactory->EnumAdapters1(adapterIndex, dxgiAdapter.ReleaseAndGetAddressOf()));
+
+            DXGI_ADAPTER_DESC1 desc;
+            CHECK_HRCMD(dxgiAdapter->GetDesc1(&desc));
+            if (!memcmp(&desc.AdapterLuid, &m_adapterLuid, sizeof(LUID))) {
+                break;
+            }
+        }
+
+        D3D_FEATURE_LEVEL featureLevel = D3D_FEATURE_LEVEL_11_0;
+        UINT flags = D3D11_CREATE_DEVICE_BGRA_SUPPORT;
+#ifdef _DEBUG
+        flags |= D3D11_CREATE_DEVICE_DEBUG;
+#endif
+        CHECK_HRCMD(D3D11CreateDevice(dxgiAdapter.Get(),
+                                      D3D_DRIVER_TYPE_UNKNOWN,
+                                      0,
+                                      flags,
+                                      &featureLevel,
+                                      1,
+                                      D3D11_SDK_VERSION,
+                                      m_mirrorWindowDevice.ReleaseAndGetAddressOf(),
+                                      nullptr,
+                                      m_mirrorWindowContext.ReleaseAndGetAddressOf()));
+
+        m_mirrorWindowGpuTimer =
+            std::make_unique<D3D11GpuTimer>(m_mirrorWindowDevice.Get(), m_mirrorWindowContext.Get());
+    }
+
+    void OpenXrRuntime::presentMirrorWindow() {
         std::unique_lock lock(m_mirrorWindowMutex);
 
         if (!m_mirrorWindowReady || !IsWindowVisible(m_mirrorWindowHwnd)) {
@@ -101,14 +175,25 @@ namespace virtualdesktop_openxr {
         RECT rect{};
         GetClientRect(m_mirrorWindowHwnd, &rect);
         AdjustWindowRect(&rect, WS_OVERLAPPEDWINDOW, false);
-        const auto width = rect.right - rect.left;
-        const auto height = rect.bottom - rect.top;
+        // The swapchain is stretched to the window upon presentation. Lower the resolution further when running low on
+        // video memory.
+        const float scale = m_mirrorWindowScale * (!m_vramBudget.getSheddingPolicy().shrinkMirrorWindow ? 1.f : 0.5f);
+        const auto width = static_cast<UINT>((rect.right - rect.left) * scale);
+        const auto height = static_cast<UINT>((rect.bottom - rect.top) * scale);
 
         // Check if visible.
         if (!width || !height) {
             return;
         }
 
+        // Report the cost of the previous presentation, separately from the frame timings.
+        const auto gpuTimeUs = m_mirrorWindowGpuTimer->query();
+        if (gpuTimeUs) {
+            TraceLoggingWrite(g_traceProvider, "MirrorWindow_Stats", TLArg(gpuTimeUs, "GpuTimeUs"));
+            m_gpuProfilerStatistics.record("MirrorWindow", gpuTimeUs);
+        }
+
+        const bool preferSRGB = m_mirrorWindowPreferSRGB;
         bool isSRGB = preferSRGB;
         D3D11_TEXTURE2D_DESC mirrorDesc;
         if (m_mirrorTexture) {
@@ -120,7 +205,7 @@ namespace virtualdesktop_openxr {
         if (!m_mirrorWindowSwapchain || preferSRGB != isSRGB) {
             ComPtr<IDXGIFactory2> dxgiFactory;
             ComPtr<IDXGIDevice1> dxgiDevice;
-            CHECK_HRCMD(m_ovrSubmissionDevice->QueryInterface(IID_PPV_ARGS(dxgiDevice.ReleaseAndGetAddressOf())));
+            CHECK_HRCMD(m_mirrorWindowDevice->QueryInterface(IID_PPV_ARGS(dxgiDevice.ReleaseAndGetAddressOf())));
 
             ComPtr<IDXGIAdapter> dxgiAdapter;
             CHECK_HRCMD(dxgiDevice->GetAdapter(&dxgiAdapter));
@@ -133,8 +218,10 @@ namespace virtualdesktop_openxr {
             swapchainDesc.SampleDesc.Count = 1;
             swapchainDesc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
             swapchainDesc.BufferCount = 2;
+            swapchainDesc.Scaling = DXGI_SCALING_STRETCH;
             swapchainDesc.SwapEffect = DXGI_SWAP_EFFECT_DISCARD;
-            CHECK_HRCMD(dxgiFactory->CreateSwapChainForHwnd(m_ovrSubmissionDevice.Get(),
+            m_mirrorWindowSwapchain.Reset();
+            CHECK_HRCMD(dxgiFactory->CreateSwapChainForHwnd(m_mirrorWindowDevice.Get(),
                                                             m_mirrorWindowHwnd,
                                                             &swapchainDesc,
                                                             nullptr,
@@ -142,9 +229,20 @@ namespace virtualdesktop_openxr {
                                                             m_mirrorWindowSwapchain.ReleaseAndGetAddressOf()));
         }
 
+        // The mirror texture is larger than the swapchain when zooming, and we only copy its center.
+        const auto mirrorWidth = static_cast<UINT>(width * m_mirrorWindowZoom);
+        const auto mirrorHeight = static_cast<UINT>(height * m_mirrorWindowZoom);
+
         // Check for resizing or initial creation.
-        if (!m_mirrorTexture || mirrorDesc.Width != width || mirrorDesc.Height != height || preferSRGB != isSRGB) {
-            TraceLoggingWrite(g_traceProvider, "MirrorWindow", TLArg(width, "Width"), TLArg(height, "Height"));
+        if (!m_mirrorTexture || mirrorDesc.Width != mirrorWidth || mirrorDesc.Height != mirrorHeight ||
+            preferSRGB != isSRGB || m_mirrorTextureEye != m_mirrorWindowEye) {
+            TraceLoggingWrite(g_traceProvider,
+                              "MirrorWindow",
+                              TLArg(width, "Width"),
+                              TLArg(height, "Height"),
+                              TLArg(mirrorWidth, "MirrorWidth"),
+                              TLArg(mirrorHeight, "MirrorHeight"),
+                              TLArg(m_mirrorWindowEye, "Eye"));
 
             CHECK_HRCMD(m_mirrorWindowSwapchain->ResizeBuffers(0, width, height, DXGI_FORMAT_UNKNOWN, 0));
 
@@ -152,27 +250,57 @@ namespace virtualdesktop_openxr {
             if (m_ovrMirrorSwapChain) {
                 m_mirrorTexture.Reset();
                 ovr_DestroyMirrorTexture(m_ovrSession, m_ovrMirrorSwapChain);
+                m_ovrMirrorSwapChain = nullptr;
             }
 
+            // The compositor does the downscaling of the selected eye(s) into the mirror texture.
             ovrMirrorTextureDesc mirrorDesc{};
             mirrorDesc.Format = preferSRGB ? OVR_FORMAT_R8G8B8A8_UNORM_SRGB : OVR_FORMAT_R8G8B8A8_UNORM;
-            mirrorDesc.Width = width;
-            mirrorDesc.Height = height;
-            mirrorDesc.MirrorOptions = ovrMirrorOption_RightEyeOnly;
+            mirrorDesc.Width = mirrorWidth;
+            mirrorDesc.Height = mirrorHeight;
+            switch (m_mirrorWindowEye) {
+            case 0:
+                mirrorDesc.MirrorOptions = ovrMirrorOption_LeftEyeOnly;
+                break;
+            case 2:
+                mirrorDesc.MirrorOptions = ovrMirrorOption_Default;
+                break;
+            default:
+                mirrorDesc.MirrorOptions = ovrMirrorOption_RightEyeOnly;
+                break;
+            }
             CHECK_OVRCMD(ovr_CreateMirrorTextureWithOptionsDX(
-                m_ovrSession, m_ovrSubmissionDevice.Get(), &mirrorDesc, &m_ovrMirrorSwapChain));
+                m_ovrSession, m_mirrorWindowDevice.Get(), &mirrorDesc, &m_ovrMirrorSwapChain));
             CHECK_OVRCMD(ovr_GetMirrorTextureBufferDX(
                 m_ovrSession, m_ovrMirrorSwapChain, IID_PPV_ARGS(m_mirrorTexture.ReleaseAndGetAddressOf())));
+            m_mirrorTextureEye = m_mirrorWindowEye;
+
+            // Account for the mirror texture and the two swapchain buffers.
+            m_vramBudget.set(vram::Category::MirrorWindow,
+                             &m_ovrMirrorSwapChain,
+                             ((uint64_t)mirrorWidth * mirrorHeight + 2ull * width * height) * 4);
         }
 
         TraceLocalActivity(presentMirrorWindow);
         TraceLoggingWriteStart(presentMirrorWindow, "PresentMirrorWindow");
 
+        m_mirrorWindowGpuTimer->start();
+
         // Let those fail silently below so we do not crash the application.
         ComPtr<ID3D11Texture2D> frameBuffer;
         m_mirrorWindowSwapchain->GetBuffer(0, IID_PPV_ARGS(frameBuffer.ReleaseAndGetAddressOf()));
-        m_ovrSubmissionContext->CopyResource(frameBuffer.Get(), m_mirrorTexture.Get());
-        m_mirrorWindowSwapchain->Present(0, 0);
+        D3D11_BOX box{};
+        box.left = (mirrorWidth - width) / 2;
+        box.top = (mirrorHeight - height) / 2;
+        box.right = box.left + width;
+        box.bottom = box.top + height;
+        box.back = 1;
+        m_mirrorWindowContext->CopySubresourceRegion(frameBuffer.Get(), 0, 0, 0, 0, m_mirrorTexture.Get(), 0, &box);
+
+        m_mirrorWindowGpuTimer->stop();
+
+        // Never block on the display, we will simply try again next time.
+        m_mirrorWindowSwapchain->Present(0, DXGI_PRESENT_DO_NOT_WAIT);
         TraceLoggingWriteStop(presentMirrorWindow, "PresentMirrorWindow");
     }
 
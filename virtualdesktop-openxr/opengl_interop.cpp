@@ -119,10 +119,16 @@ namespace virtualdesktop_openxr {
         CHECK_HRCMD(m_ovrSubmissionFence->CreateSharedHandle(
             nullptr, GENERIC_ALL, nullptr, m_fenceHandleForAMDWorkaround.put()));
 
-        // On the OpenGL side, it is called a semaphore.
-        m_glDispatch.glGenSemaphoresEXT(1, &m_glSemaphore);
-        m_glDispatch.glImportSemaphoreWin32HandleEXT(
-            m_glSemaphore, GL_HANDLE_TYPE_D3D12_FENCE_EXT, m_fenceHandleForAMDWorkaround.get());
+        if (!getSetting("quirk_disable_opengl_interop_worker").value_or(false)) {
+            initializeOpenGLWorker();
+        }
+
+        // On the OpenGL side, it is called a semaphore. It is only signaled from the context that created it.
+        runOnOpenGLContext([&] {
+            m_glDispatch.glGenSemaphoresEXT(1, &m_glSemaphore);
+            m_glDispatch.glImportSemaphoreWin32HandleEXT(
+                m_glSemaphore, GL_HANDLE_TYPE_D3D12_FENCE_EXT, m_fenceHandleForAMDWorkaround.get());
+        });
 
         // Frame timers.
         for (uint32_t i = 0; i < k_numGpuTimers; i++) {
@@ -157,6 +163,9 @@ namespace virtualdesktop_openxr {
         GL_GET_PTR(glQueryCounter);
         GL_GET_PTR(glGetQueryObjectiv);
         GL_GET_PTR(glGetQueryObjectui64v);
+        GL_GET_PTR(glFenceSync);
+        GL_GET_PTR(glWaitSync);
+        GL_GET_PTR(glDeleteSync);
 
 #ifdef _DEBUG
         GL_GET_PTR(glDebugMessageCallback);
@@ -165,6 +174,86 @@ namespace virtualdesktop_openxr {
 #undef GL_GET_PTR
     }
 
+    // Create a context sharing its objects with the application context, and dedicate a thread to it.
+    // Must be called with the application context current.
+    void OpenXrRuntime::initializeOpenGLWorker() {
+        const auto wglCreateContextAttribsARB =
+            reinterpret_cast<PFNWGLCREATECONTEXTATTRIBSARBPROC>(wglGetProcAddress("wglCreateContextAttribsARB"));
+        if (!wglCreateContextAttribsARB) {
+            Log("OpenGL driver does not support wglCreateContextAttribsARB, not using interop worker\n");
+            return;
+        }
+
+        // Match the version and profile of the application context.
+        GLint majorVersion = 0, minorVersion = 0, profileMask = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &majorVersion);
+        glGetIntegerv(GL_MINOR_VERSION, &minorVersion);
+        glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &profileMask);
+        const int attributes[] = {WGL_CONTEXT_MAJOR_VERSION_ARB,
+                                  majorVersion,
+                                  WGL_CONTEXT_MINOR_VERSION_ARB,
+                                  minorVersion,
+                                  WGL_CONTEXT_PROFILE_MASK_ARB,
+                                  profileMask ? profileMask : WGL_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB,
+                                  0};
+
+        GlContext workerContext{};
+        workerContext.glDC = m_glContext.glDC;
+        workerContext.glRC = wglCreateContextAttribsARB(m_glContext.glDC, m_glContext.glRC, attributes);
+        if (!workerContext.glRC) {
+            Log("Failed to create OpenGL interop worker context: %d\n", GetLastError());
+            return;
+        }
+        workerContext.valid = true;
+
+        TraceLoggingWrite(g_traceProvider,
+                          "OpenGLInteropWorker",
+                          TLArg(majorVersion, "MajorVersion"),
+                          TLArg(minorVersion, "MinorVersion"),
+                          TLArg(profileMask, "ProfileMask"));
+
+        try {
+            // The worker context stays current on the worker thread for the whole session.
+            m_glWorker = std::make_unique<interop::WorkerQueue>(
+                [workerContext] {
+                    CHECK_MSG(wglMakeCurrent(workerContext.glDC, workerContext.glRC),
+                              "Failed to make the OpenGL interop worker context current");
+                },
+                [workerContext] {
+                    wglMakeCurrent(nullptr, nullptr);
+                    wglDeleteContext(workerContext.glRC);
+                });
+        } catch (std::exception& exc) {
+            Log("Failed to start OpenGL interop worker: %s\n", exc.what());
+            wglDeleteContext(workerContext.glRC);
+        }
+    }
+
+    // Run OpenGL work on the interop worker thread when available, otherwise on the application context.
+    void OpenXrRuntime::runOnOpenGLContext(const std::function<void()>& work) {
+        if (!m_glWorker) {
+            GlContextSwitch context(m_glContext);
+
+            work();
+            return;
+        }
+
+        m_glWorker->run([&] {
+            // Reset error codes.
+            while (glGetError() != GL_NO_ERROR)
+                ;
+
+            work();
+
+            // Objects created in a shared context may only be used by the application context once the commands
+            // creating them have completed.
+            glFinish();
+
+            const auto error = glGetError();
+            CHECK_MSG(error == GL_NO_ERROR, fmt::format("OpenGL error: 0x{:x}", error));
+        });
+    }
+
     void OpenXrRuntime::cleanupOpenGL() {
         if (m_glContext.valid) {
             GlContextSwitch context(m_glContext, true /* ignoreErrors */);
@@ -175,7 +264,15 @@ namespace virtualdesktop_openxr {
                 m_gpuTimerApp[i].reset();
             }
 
-            m_glDispatch.glDeleteSemaphoresEXT(1, &m_glSemaphore);
+            if (m_glWorker) {
+                m_glWorker->run([&] {
+                    m_glDispatch.glDeleteSemaphoresEXT(1, &m_glSemaphore);
+                    glFinish();
+                });
+                m_glWorker.reset();
+            } else {
+                m_glDispatch.glDeleteSemaphoresEXT(1, &m_glSemaphore);
+            }
             m_fenceHandleForAMDWorkaround.reset();
 
             m_glContext.valid = false;
@@ -190,91 +287,93 @@ namespace virtualdesktop_openxr {
     XrResult OpenXrRuntime::getSwapchainImagesOpenGL(Swapchain& xrSwapchain,
                                                      XrSwapchainImageOpenGLKHR* glImages,
                                                      uint32_t count) {
-        GlContextSwitch context(m_glContext);
+        for (uint32_t i = 0; i < count; i++) {
+            if (glImages[i].type != XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_KHR) {
+                return XR_ERROR_VALIDATION_FAILURE;
+            }
+        }
 
         // Detect whether this is the first call for this swapchain.
         const bool initialized = !xrSwapchain.appSwapchain.images.empty();
 
-        std::vector<HANDLE> textureHandles;
         if (!initialized) {
             // Query the swapchain textures.
-            textureHandles = getSwapchainImages(xrSwapchain);
-        }
-
-        // Export each D3D11 texture to OpenGL.
-        for (uint32_t i = 0; i < count; i++) {
-            if (glImages[i].type != XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_KHR) {
-                return XR_ERROR_VALIDATION_FAILURE;
-            }
-
-            if (!initialized) {
-                // Import the device memory from D3D.
-                GLuint memory;
-                m_glDispatch.glCreateMemoryObjectsEXT(1, &memory);
-                xrSwapchain.glMemory.push_back(memory);
-
-                const size_t bytePerPixels = glGetBytePerPixels((GLenum)xrSwapchain.xrDesc.format);
-
-                // TODO: Not sure why we need to multiply by 2. Mipmapping?
-                // https://stackoverflow.com/questions/71108346/how-to-use-glimportmemorywin32handleext-to-share-an-id3d11texture2d-keyedmutex-s
-                const auto memorySize = xrSwapchain.xrDesc.arraySize * xrSwapchain.xrDesc.width *
-                                        xrSwapchain.xrDesc.height * xrSwapchain.xrDesc.sampleCount * bytePerPixels * 2;
-                m_glDispatch.glImportMemoryWin32HandleEXT(memory,
-                                                          memorySize,
-                                                          !requireNTHandleSharing() ? GL_HANDLE_TYPE_D3D11_IMAGE_KMT_EXT
-                                                                                    : GL_HANDLE_TYPE_D3D11_IMAGE_EXT,
-                                                          textureHandles[i]);
-
-                // Create the texture that the app will use.
-                GLuint image;
-                if (xrSwapchain.xrDesc.arraySize == 1) {
-                    if (xrSwapchain.xrDesc.sampleCount == 1) {
-                        m_glDispatch.glCreateTextures(GL_TEXTURE_2D, 1, &image);
-                        m_glDispatch.glTextureStorageMem2DEXT(image,
-                                                              xrSwapchain.xrDesc.mipCount,
-                                                              (GLenum)xrSwapchain.xrDesc.format,
-                                                              xrSwapchain.xrDesc.width,
-                                                              xrSwapchain.xrDesc.height,
-                                                              memory,
-                                                              0);
+            const std::vector<HANDLE> textureHandles = getSwapchainImages(xrSwapchain);
+
+            // Export each D3D11 texture to OpenGL. The textures are shared with the application context.
+            runOnOpenGLContext([&] {
+                for (uint32_t i = 0; i < count; i++) {
+                    // Import the device memory from D3D.
+                    GLuint memory;
+                    m_glDispatch.glCreateMemoryObjectsEXT(1, &memory);
+                    xrSwapchain.glMemory.push_back(memory);
+
+                    const size_t bytePerPixels = glGetBytePerPixels((GLenum)xrSwapchain.xrDesc.format);
+
+                    // TODO: Not sure why we need to multiply by 2. Mipmapping?
+                    // https://stackoverflow.com/questions/71108346/how-to-use-glimportmemorywin32handleext-to-share-an-id3d11texture2d-keyedmutex-s
+                    const auto memorySize = xrSwapchain.xrDesc.arraySize * xrSwapchain.xrDesc.width *
+                                            xrSwapchain.xrDesc.height * xrSwapchain.xrDesc.sampleCount *
+                                            bytePerPixels * 2;
+                    m_glDispatch.glImportMemoryWin32HandleEXT(
+                        memory,
+                        memorySize,
+                        !requireNTHandleSharing() ? GL_HANDLE_TYPE_D3D11_IMAGE_KMT_EXT : GL_HANDLE_TYPE_D3D11_IMAGE_EXT,
+                        textureHandles[i]);
+
+                    // Create the texture that the app will use.
+                    GLuint image;
+                    if (xrSwapchain.xrDesc.arraySize == 1) {
+                        if (xrSwapchain.xrDesc.sampleCount == 1) {
+                            m_glDispatch.glCreateTextures(GL_TEXTURE_2D, 1, &image);
+                            m_glDispatch.glTextureStorageMem2DEXT(image,
+                                                                  xrSwapchain.xrDesc.mipCount,
+                                                                  (GLenum)xrSwapchain.xrDesc.format,
+                                                                  xrSwapchain.xrDesc.width,
+                                                                  xrSwapchain.xrDesc.height,
+                                                                  memory,
+                                                                  0);
+                        } else {
+                            m_glDispatch.glCreateTextures(GL_TEXTURE_2D_MULTISAMPLE, 1, &image);
+                            m_glDispatch.glTextureStorageMem2DMultisampleEXT(image,
+                                                                             xrSwapchain.xrDesc.sampleCount,
+                                                                             (GLenum)xrSwapchain.xrDesc.format,
+                                                                             xrSwapchain.xrDesc.width,
+                                                                             xrSwapchain.xrDesc.height,
+                                                                             GL_TRUE,
+                                                                             memory,
+                                                                             0);
+                        }
                     } else {
-                        m_glDispatch.glCreateTextures(GL_TEXTURE_2D_MULTISAMPLE, 1, &image);
-                        m_glDispatch.glTextureStorageMem2DMultisampleEXT(image,
-                                                                         xrSwapchain.xrDesc.sampleCount,
-                                                                         (GLenum)xrSwapchain.xrDesc.format,
-                                                                         xrSwapchain.xrDesc.width,
-                                                                         xrSwapchain.xrDesc.height,
-                                                                         GL_TRUE,
-                                                                         memory,
-                                                                         0);
-                    }
-                } else {
-                    if (xrSwapchain.xrDesc.sampleCount == 1) {
-                        m_glDispatch.glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &image);
-                        m_glDispatch.glTextureStorageMem3DEXT(image,
-                                                              xrSwapchain.xrDesc.mipCount,
-                                                              (GLenum)xrSwapchain.xrDesc.format,
-                                                              xrSwapchain.xrDesc.width,
-                                                              xrSwapchain.xrDesc.height,
-                                                              xrSwapchain.xrDesc.arraySize,
-                                                              memory,
-                                                              0);
-                    } else {
-                        m_glDispatch.glCreateTextures(GL_TEXTURE_2D_MULTISAMPLE_ARRAY, 1, &image);
-                        m_glDispatch.glTextureStorageMem3DMultisampleEXT(image,
-                                                                         xrSwapchain.xrDesc.sampleCount,
-                                                                         (GLenum)xrSwapchain.xrDesc.format,
-                                                                         xrSwapchain.xrDesc.width,
-                                                                         xrSwapchain.xrDesc.height,
-                                                                         xrSwapchain.xrDesc.arraySize,
-                                                                         GL_TRUE,
-                                                                         memory,
-                                                                         0);
+                        if (xrSwapchain.xrDesc.sampleCount == 1) {
+                            m_glDispatch.glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &image);
+                            m_glDispatch.glTextureStorageMem3DEXT(image,
+                                                                  xrSwapchain.xrDesc.mipCount,
+                                                                  (GLenum)xrSwapchain.xrDesc.format,
+                                                                  xrSwapchain.xrDesc.width,
+                                                                  xrSwapchain.xrDesc.height,
+                                                                  xrSwapchain.xrDesc.arraySize,
+                                                                  memory,
+                                                                  0);
+                        } else {
+                            m_glDispatch.glCreateTextures(GL_TEXTURE_2D_MULTISAMPLE_ARRAY, 1, &image);
+                            m_glDispatch.glTextureStorageMem3DMultisampleEXT(image,
+                                                                             xrSwapchain.xrDesc.sampleCount,
+                                                                             (GLenum)xrSwapchain.xrDesc.format,
+                                                                             xrSwapchain.xrDesc.width,
+                                                                             xrSwapchain.xrDesc.height,
+                                                                             xrSwapchain.xrDesc.arraySize,
+                                                                             GL_TRUE,
+                                                                             memory,
+                                                                             0);
+                        }
                     }
+                    xrSwapchain.glImages.push_back(image);
                 }
-                xrSwapchain.glImages.push_back(image);
-            }
+            });
+        }
 
+        for (uint32_t i = 0; i < count; i++) {
             glImages[i].image = xrSwapchain.glImages[i];
 
             TraceLoggingWrite(g_traceProvider,
@@ -288,38 +387,73 @@ namespace virtualdesktop_openxr {
 
     void OpenXrRuntime::cleanupSwapchainImagesOpenGL(Swapchain& xrSwapchain) {
         // This will be a no-op if OpenGL is not used.
-        GlContextSwitch context(m_glContext);
-
-        while (!xrSwapchain.glImages.empty()) {
-            GLuint image = xrSwapchain.glImages.back();
-            glDeleteTextures(1, &image);
-            xrSwapchain.glImages.pop_back();
+        if (xrSwapchain.glImages.empty() && xrSwapchain.glMemory.empty()) {
+            return;
         }
 
-        while (!xrSwapchain.glMemory.empty()) {
-            GLuint memory = xrSwapchain.glMemory.back();
-            m_glDispatch.glDeleteMemoryObjectsEXT(1, &memory);
-            xrSwapchain.glMemory.pop_back();
-        }
+        runOnOpenGLContext([&] {
+            while (!xrSwapchain.glImages.empty()) {
+                GLuint image = xrSwapchain.glImages.back();
+                glDeleteTextures(1, &image);
+                xrSwapchain.glImages.pop_back();
+            }
+
+            while (!xrSwapchain.glMemory.empty()) {
+                GLuint memory = xrSwapchain.glMemory.back();
+                m_glDispatch.glDeleteMemoryObjectsEXT(1, &memory);
+                xrSwapchain.glMemory.pop_back();
+            }
+        });
     }
 
     // Flush any pending work.
     void OpenXrRuntime::flushOpenGLContext() {
-        GlContextSwitch context(m_glContext);
+        {
+            GlContextSwitch context(m_glContext);
 
-        glFinish();
+            glFinish();
+        }
+
+        if (m_glWorker) {
+            m_glWorker->run([] { glFinish(); });
+        }
     }
 
     // Serialize commands from the OpenGL context to the D3D11 context used by OVR.
     void OpenXrRuntime::serializeOpenGLFrame() {
+        // This is not switching contexts when called from the application's render thread.
         GlContextSwitch context(m_glContext);
 
         m_fenceValue++;
         TraceLoggingWrite(
             g_traceProvider, "xrEndFrame_Sync", TLArg("OpenGL", "Api"), TLArg(m_fenceValue, "FenceValue"));
-        m_glDispatch.glSemaphoreParameterui64vEXT(m_glSemaphore, GL_D3D12_FENCE_VALUE_EXT, &m_fenceValue);
-        m_glDispatch.glSignalSemaphoreEXT(m_glSemaphore, 0, nullptr, 0, nullptr, nullptr);
-        glFlush();
+
+        if (m_glWorker) {
+            // Mark the end of the application work in its context, and let the worker order the signal of the shared
+            // fence after it. The wait is on the GPU, so the worker only costs a thread hand-off here. We still wait
+            // for the worker, so that an error is reported on the frame that caused it.
+            const GLsync appWorkDone = m_glDispatch.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+
+            m_glWorker->run([&] {
+                // Reset error codes.
+                while (glGetError() != GL_NO_ERROR)
+                    ;
+
+                m_glDispatch.glWaitSync(appWorkDone, 0, GL_TIMEOUT_IGNORED);
+                m_glDispatch.glDeleteSync(appWorkDone);
+                m_glDispatch.glSemaphoreParameterui64vEXT(m_glSemaphore, GL_D3D12_FENCE_VALUE_EXT, &m_fenceValue);
+                m_glDispatch.glSignalSemaphoreEXT(m_glSemaphore, 0, nullptr, 0, nullptr, nullptr);
+                glFlush();
+
+                const auto error = glGetError();
+                CHECK_MSG(error == GL_NO_ERROR, fmt::format("OpenGL error: 0x{:x}", error));
+            });
+        } else {
+            m_glDispatch.glSemaphoreParameterui64vEXT(m_glSemaphore, GL_D3D12_FENCE_VALUE_EXT, &m_fenceValue);
+            m_glDispatch.glSignalSemaphoreEXT(m_glSemaphore, 0, nullptr, 0, nullptr, nullptr);
+            glFlush();
+        }
 
         waitOnSubmissionDevice();
     }
@@ -25,6 +25,8 @@
 // Standard library.
 #define _USE_MATH_DEFINES
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cctype>
 #include <chrono>
 #include <cmath>
@@ -38,6 +40,8 @@
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <future>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -47,6 +51,7 @@
 #include <optional>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #pragma intrinsic(_ReturnAddress)
@@ -102,6 +107,8 @@ using Microsoft::WRL::ComPtr;
 #include "meta_body_tracking_full_body.h"
 #include "meta_body_tracking_fidelity.h"
 #include "meta_body_tracking_calibration.h"
+#include "meta_recommended_layer_resolution.h"
+#include "vdxr_swapchain_damage_region.h"
 
 // OpenXR loader interfaces.
 #include <openxr/openxr_loader_negotiation.h>
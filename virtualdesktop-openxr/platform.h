@@ -0,0 +1,68 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+namespace virtualdesktop_openxr::platform {
+
+    // Source of the runtime configuration. On Windows, this is the registry.
+    struct ISettingsStore {
+        virtual ~ISettingsStore() = default;
+
+        virtual std::optional<int> getDword(const std::string& name) const = 0;
+    };
+
+    // In-memory configuration, optionally layered on top of another store.
+    class MemorySettingsStore : public ISettingsStore {
+      public:
+        MemorySettingsStore(std::shared_ptr<const ISettingsStore> fallback = {}) : m_fallback(std::move(fallback)) {
+        }
+
+        void set(const std::string& name, int value) {
+            std::unique_lock lock(m_mutex);
+            m_values[name] = value;
+        }
+
+        void clear(const std::string& name) {
+            std::unique_lock lock(m_mutex);
+            m_values.erase(name);
+        }
+
+        std::optional<int> getDword(const std::string& name) const override {
+            {
+                std::unique_lock lock(m_mutex);
+                const auto it = m_values.find(name);
+                if (it != m_values.cend()) {
+                    return it->second;
+                }
+            }
+            return m_fallback ? m_fallback->getDword(name) : std::nullopt;
+        }
+
+      private:
+        const std::shared_ptr<const ISettingsStore> m_fallback;
+
+        mutable std::mutex m_mutex;
+        std::map<std::string, int> m_values;
+    };
+
+} // namespace virtualdesktop_openxr::platform
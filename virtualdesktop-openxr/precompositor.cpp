@@ -26,6 +26,7 @@
 #include "runtime.h"
 #include "utils.h"
 
+#include "DownsamplingCS.h"
 #include "UpscalingCS.h"
 #include "SharpeningCS.h"
 
@@ -43,33 +44,80 @@ namespace virtualdesktop_openxr {
     struct UpscaleCSConstants {
         alignas(8) XrOffset2Df topLeftNormalized;
         alignas(4) bool isSRGB;
-        alignas(4) uint32_t padding;
+        alignas(4) bool useTileMask;
         alignas(16) uint32_t const0[4];
         alignas(16) uint32_t const1[4];
         alignas(16) uint32_t const2[4];
         alignas(16) uint32_t const3[4];
     };
 
+    struct DownsampleCSConstants {
+        alignas(8) XrOffset2Di topLeft;
+        alignas(8) XrExtent2Di sourceSize;
+        alignas(8) XrVector2f scale;
+        alignas(8) uint32_t destSize[2];
+        alignas(4) uint32_t filter;
+        alignas(4) bool isSRGB;
+        alignas(4) bool useTileMask;
+        alignas(4) bool preserveAlpha;
+    };
+
     struct SharpenCSConstants {
         alignas(8) XrOffset2Di topLeft;
         alignas(4) bool isSRGB;
-        alignas(4) uint32_t padding;
+        alignas(4) bool useTileMask;
         alignas(16) uint32_t const0[4];
         alignas(16) uint32_t const1[4];
     };
 
+    // Each thread group of the upscaling and sharpening shaders processes a 16x16 tile.
+    constexpr uint32_t PrecompositorTileSize = 16;
+
     void OpenXrRuntime::upscaler(Swapchain** swapchains, const XrSwapchainSubImage** subImages, ovrLayerEyeFov& layer) {
-        const bool upscaling = std::abs(m_upscalingMultiplier - 1.f) > FLT_EPSILON;
-        const bool sharpening = m_sharpenFactor > 0.f;
+        bool dynamicResolutionUpscaling = false;
+        for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+            dynamicResolutionUpscaling =
+                dynamicResolutionUpscaling || needDynamicResolutionUpscaling(subImages[eye]->imageRect, eye);
+        }
+        const bool upscaling = std::abs(m_upscalingMultiplier - 1.f) > FLT_EPSILON || dynamicResolutionUpscaling;
+        // Supersampled images are brought back to the native resolution of the compositor with an explicit filter.
+        const bool downsampling = !upscaling && needSupersamplingDownsampling();
+        const bool resampling = upscaling || downsampling;
+        // When running low on video memory, give up on sharpening after resampling, which needs intermediate textures.
+        const bool sharpening =
+            m_sharpenFactor > 0.f && !(resampling && m_vramBudget.getSheddingPolicy().skipSharpeningIntermediate);
 
         // We will store our stereo projection in the left eye swapchain.
+        // With dynamic resolution, the output resolution remains constant regardless of the input resolution.
         Swapchain& xrSwapchain = *swapchains[xr::StereoView::Left];
-        ovrSizei resolution = ovrSizei{
-            (int)xr::math::AlignTo<4>((uint32_t)(subImages[0]->imageRect.extent.width / m_upscalingMultiplier)),
-            (int)xr::math::AlignTo<4>((uint32_t)(subImages[0]->imageRect.extent.height / m_upscalingMultiplier))};
-        ensureSwapchainPrecompositorResources(xrSwapchain, resolution);
-        if (upscaling && sharpening) {
+        ovrSizei resolutions[xr::StereoView::Count];
+        for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+            const XrExtent2Di& extent = subImages[eye]->imageRect.extent;
+            resolutions[eye] =
+                dynamicResolutionUpscaling
+                    ? m_dynamicResolutionNativeSize[eye]
+                    : ovrSizei{(int)xr::math::AlignTo<4>((uint32_t)(extent.width / m_upscalingMultiplier)),
+                               (int)xr::math::AlignTo<4>((uint32_t)(extent.height / m_upscalingMultiplier))};
+            if (downsampling) {
+                const ovrSizei nativeResolution = ovr_GetFovTextureSize(
+                    m_ovrSession, eye == xr::StereoView::Left ? ovrEye_Left : ovrEye_Right, layer.Fov[eye], 1.f);
+                resolutions[eye].w = std::min((int)xr::math::AlignTo<4>((uint32_t)nativeResolution.w), extent.width);
+                resolutions[eye].h = std::min((int)xr::math::AlignTo<4>((uint32_t)nativeResolution.h), extent.height);
+            }
+        }
+        ensureSwapchainPrecompositorResources(xrSwapchain, resolutions);
+        if (!(resampling && sharpening) && xrSwapchain.intermediate[0].image) {
+            for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+                xrSwapchain.intermediate[eye] = {};
+            }
+            m_vramBudget.set(vram::Category::Intermediate, &xrSwapchain, 0);
+        }
+        if (resampling && sharpening) {
+            uint64_t intermediateMemory = 0;
+            bool isIntermediateCreated = false;
             for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+                const ovrSizei& resolution = resolutions[eye];
+                intermediateMemory += (uint64_t)resolution.w * resolution.h * 8;
                 ovrSizei currentResolution{};
                 if (xrSwapchain.intermediate[eye].image) {
                     D3D11_TEXTURE2D_DESC desc{};
@@ -90,6 +138,7 @@ namespace virtualdesktop_openxr {
                         desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
                         CHECK_HRCMD(m_ovrSubmissionDevice->CreateTexture2D(
                             &desc, nullptr, xrSwapchain.intermediate[eye].image.ReleaseAndGetAddressOf()));
+                        isIntermediateCreated = true;
                         setDebugName(
                             xrSwapchain.intermediate[eye].uav.Get(),
                             fmt::format("Precompositor Intermediate Texture [{}, {}]", eye, (void*)&xrSwapchain));
@@ -119,6 +168,9 @@ namespace virtualdesktop_openxr {
                     }
                 }
             }
+            if (isIntermediateCreated) {
+                m_vramBudget.set(vram::Category::Intermediate, &xrSwapchain, intermediateMemory);
+            }
         }
 
         // We are about to do something destructive to the application context. Save the context. It will be
@@ -129,26 +181,17 @@ namespace virtualdesktop_openxr {
         }
 
         for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
-            // Prepare swapchain input.
-            auto& slice = swapchains[eye]->resolvedSlices[subImages[eye]->imageArrayIndex];
-            if ((int)slice.srvs.size() <= slice.lastCommittedIndex) {
-                slice.srvs.resize(slice.lastCommittedIndex + 1);
-            }
-            if (!slice.srvs[slice.lastCommittedIndex]) {
-                D3D11_SHADER_RESOURCE_VIEW_DESC desc{};
-                desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-                desc.Format = getShaderResourceViewFormat(xrSwapchain.dxgiFormatForSubmission);
-                desc.Texture2D.MipLevels = -1;
-                CHECK_HRCMD(m_ovrSubmissionDevice->CreateShaderResourceView(
-                    slice.images[slice.lastCommittedIndex].Get(),
-                    &desc,
-                    slice.srvs[slice.lastCommittedIndex].ReleaseAndGetAddressOf()));
-                setDebugName(slice.srvs[slice.lastCommittedIndex].Get(),
-                             fmt::format("Runtime Slice Copy SRV[{}, {}, {}]",
-                                         subImages[eye]->imageArrayIndex,
-                                         slice.lastCommittedIndex,
-                                         (void*)swapchains[eye]));
+            GpuProfilerScope gpuProfilerEyeScope(m_gpuProfiler.get(), "Eye", eye);
+            const ovrSizei& resolution = resolutions[eye];
+
+            if (m_useVisibilityTileMask) {
+                ensureVisibilityTileMask(eye, layer.Fov[eye], resolution);
             }
+            const bool useTileMask = m_useVisibilityTileMask && m_visibilityTileMask[eye].hiddenTiles;
+
+            // Prepare swapchain input.
+            ID3D11ShaderResourceView* const input =
+                getPrecompositorShaderResourceView(*swapchains[eye], subImages[eye]->imageArrayIndex);
 
             // Prepare swapchain outputs.
             int imageIndex = 0;
@@ -156,6 +199,8 @@ namespace virtualdesktop_openxr {
                 m_ovrSession, xrSwapchain.stereoProjection[eye].ovrSwapchain, &imageIndex));
 
             if (upscaling) {
+                GpuProfilerScope gpuProfilerScope(m_gpuProfiler.get(), "Upscaling");
+
                 m_ovrSubmissionContext->CSSetShader(m_upscaleShader.Get(), nullptr, 0);
                 {
                     UpscaleCSConstants constants{};
@@ -165,6 +210,7 @@ namespace virtualdesktop_openxr {
                     // If we apply sharpening at the next stage, we use half-precision floats for the intermediate
                     // texture and we will do conversion to sRGB at the sharpening stage.
                     constants.isSRGB = !sharpening ? isSRGBFormat((DXGI_FORMAT)swapchains[eye]->xrDesc.format) : false;
+                    constants.useTileMask = useTileMask;
 
                     FsrEasuCon(constants.const0,
                                constants.const1,
@@ -192,22 +238,65 @@ namespace virtualdesktop_openxr {
                         0, 1, xrSwapchain.stereoProjection[eye].uavs[imageIndex].GetAddressOf(), nullptr);
                 }
                 m_ovrSubmissionContext->CSSetSamplers(0, 1, m_linearClampSampler.GetAddressOf());
-                m_ovrSubmissionContext->CSSetShaderResources(0, 1, slice.srvs[slice.lastCommittedIndex].GetAddressOf());
+                m_ovrSubmissionContext->CSSetShaderResources(0, 1, &input);
+                m_ovrSubmissionContext->CSSetShaderResources(1, 1, m_visibilityTileMask[eye].srv.GetAddressOf());
+
+                const uint32_t blockWidth = PrecompositorTileSize;
+                const uint32_t blockHeight = PrecompositorTileSize;
+                m_ovrSubmissionContext->Dispatch(((resolution.w + blockWidth - 1) / blockWidth),
+                                                 ((resolution.h + blockHeight - 1) / blockHeight),
+                                                 1);
+            } else if (downsampling) {
+                GpuProfilerScope gpuProfilerScope(m_gpuProfiler.get(), "Downsampling");
 
-                const uint32_t blockWidth = 16;
-                const uint32_t blockHeight = 16;
+                m_ovrSubmissionContext->CSSetShader(m_downsampleShader.Get(), nullptr, 0);
+                {
+                    DownsampleCSConstants constants{};
+                    constants.topLeft = subImages[eye]->imageRect.offset;
+                    constants.sourceSize = subImages[eye]->imageRect.extent;
+                    constants.scale = {(float)subImages[eye]->imageRect.extent.width / resolution.w,
+                                       (float)subImages[eye]->imageRect.extent.height / resolution.h};
+                    constants.destSize[0] = resolution.w;
+                    constants.destSize[1] = resolution.h;
+                    constants.filter = (uint32_t)m_downsamplingFilter;
+                    // If we apply sharpening at the next stage, we will do conversion to sRGB at the sharpening stage.
+                    constants.isSRGB = !sharpening ? isSRGBFormat((DXGI_FORMAT)swapchains[eye]->xrDesc.format) : false;
+                    constants.useTileMask = useTileMask;
+
+                    D3D11_MAPPED_SUBRESOURCE mappedResources;
+                    CHECK_HRCMD(m_ovrSubmissionContext->Map(
+                        m_upscalerConstants.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResources));
+                    memcpy(mappedResources.pData, &constants, sizeof(constants));
+                    m_ovrSubmissionContext->Unmap(m_upscalerConstants.Get(), 0);
+                    m_ovrSubmissionContext->CSSetConstantBuffers(0, 1, m_upscalerConstants.GetAddressOf());
+                }
+                if (sharpening) {
+                    m_ovrSubmissionContext->CSSetUnorderedAccessViews(
+                        0, 1, xrSwapchain.intermediate[eye].uav.GetAddressOf(), nullptr);
+                } else {
+                    m_ovrSubmissionContext->CSSetUnorderedAccessViews(
+                        0, 1, xrSwapchain.stereoProjection[eye].uavs[imageIndex].GetAddressOf(), nullptr);
+                }
+                m_ovrSubmissionContext->CSSetShaderResources(0, 1, &input);
+                m_ovrSubmissionContext->CSSetShaderResources(1, 1, m_visibilityTileMask[eye].srv.GetAddressOf());
+
+                const uint32_t blockWidth = PrecompositorTileSize;
+                const uint32_t blockHeight = PrecompositorTileSize;
                 m_ovrSubmissionContext->Dispatch(((resolution.w + blockWidth - 1) / blockWidth),
                                                  ((resolution.h + blockHeight - 1) / blockHeight),
                                                  1);
             }
 
             if (sharpening) {
+                GpuProfilerScope gpuProfilerScope(m_gpuProfiler.get(), "Sharpening");
+
                 m_ovrSubmissionContext->CSSetShader(m_sharpenShader.Get(), nullptr, 0);
                 {
                     SharpenCSConstants constants{};
-                    // If we upscaled at the previous stage, the image occupies the entire texture.
-                    constants.topLeft = !upscaling ? subImages[eye]->imageRect.offset : XrOffset2Di{0, 0};
+                    // If we resampled at the previous stage, the image occupies the entire texture.
+                    constants.topLeft = !resampling ? subImages[eye]->imageRect.offset : XrOffset2Di{0, 0};
                     constants.isSRGB = isSRGBFormat((DXGI_FORMAT)swapchains[eye]->xrDesc.format);
+                    constants.useTileMask = useTileMask;
 
                     CasSetup(constants.const0,
                              constants.const1,
@@ -226,16 +315,16 @@ namespace virtualdesktop_openxr {
                 }
                 m_ovrSubmissionContext->CSSetUnorderedAccessViews(
                     0, 1, xrSwapchain.stereoProjection[eye].uavs[imageIndex].GetAddressOf(), nullptr);
-                if (upscaling) {
+                if (resampling) {
                     m_ovrSubmissionContext->CSSetShaderResources(
                         0, 1, xrSwapchain.intermediate[eye].srv.GetAddressOf());
                 } else {
-                    m_ovrSubmissionContext->CSSetShaderResources(
-                        0, 1, slice.srvs[slice.lastCommittedIndex].GetAddressOf());
+                    m_ovrSubmissionContext->CSSetShaderResources(0, 1, &input);
                 }
+                m_ovrSubmissionContext->CSSetShaderResources(1, 1, m_visibilityTileMask[eye].srv.GetAddressOf());
 
-                const uint32_t blockWidth = 16;
-                const uint32_t blockHeight = 16;
+                const uint32_t blockWidth = PrecompositorTileSize;
+                const uint32_t blockHeight = PrecompositorTileSize;
                 m_ovrSubmissionContext->Dispatch(((resolution.w + blockWidth - 1) / blockWidth),
                                                  ((resolution.h + blockHeight - 1) / blockHeight),
                                                  1);
@@ -256,13 +345,161 @@ namespace virtualdesktop_openxr {
             m_ovrSubmissionContext->CSSetConstantBuffers(0, 1, nullCBV);
             ID3D11SamplerState* nullSampler[] = {nullptr};
             m_ovrSubmissionContext->CSSetSamplers(0, 1, nullSampler);
-            ID3D11ShaderResourceView* nullSRV[] = {nullptr};
-            m_ovrSubmissionContext->CSSetShaderResources(0, 1, nullSRV);
+            ID3D11ShaderResourceView* nullSRV[] = {nullptr, nullptr};
+            m_ovrSubmissionContext->CSSetShaderResources(0, 2, nullSRV);
             ID3D11UnorderedAccessView* nullUAV[] = {nullptr};
             m_ovrSubmissionContext->CSSetUnorderedAccessViews(0, 1, nullUAV, nullptr);
         }
     }
 
+    // Reduce a quad or cylinder layer sampled at a much higher angular resolution than the display, by halving its
+    // resolution like a mip level. The reduced image is reused while the application does not submit new content.
+    void OpenXrRuntime::downsampleQuadLayer(Swapchain& xrSwapchain,
+                                            const XrSwapchainSubImage& subImage,
+                                            const density::AngularExtent& angularExtent,
+                                            ovrLayerQuad& layer) {
+        // The reduced image is kept per swapchain, it cannot serve several layers submitting the same swapchain.
+        const auto references = m_precompositor.quadLayerReferences.find(&xrSwapchain);
+        if (references != m_precompositor.quadLayerReferences.end() && references->second > 1) {
+            return;
+        }
+
+        DownsampledLayer& state = xrSwapchain.downsampledLayer;
+
+        const ovrSizei nativeSize =
+            ovr_GetFovTextureSize(m_ovrSession, ovrEye_Left, m_cachedEyeInfo[xr::StereoView::Left].Fov, 1.f);
+        const XrVector2f displayDensity =
+            density::GetDisplayDensity(m_cachedEyeFov[xr::StereoView::Left], {nativeSize.w, nativeSize.h});
+        const float oversampling = density::GetOversampling(subImage.imageRect.extent, angularExtent, displayDensity);
+        state.level = density::GetDownsamplingLevel(oversampling, subImage.imageRect.extent, state.level);
+
+        const int sourceIndex = xrSwapchain.resolvedSlices[subImage.imageArrayIndex].lastCommittedIndex;
+
+        TraceLoggingWrite(g_traceProvider,
+                          "DownsampleQuadLayer",
+                          TLArg(angularExtent.width, "AngularWidth"),
+                          TLArg(angularExtent.height, "AngularHeight"),
+                          TLArg(oversampling, "Oversampling"),
+                          TLArg(state.level, "Level"),
+                          TLArg(sourceIndex, "SourceIndex"));
+
+        if (!state.level || sourceIndex < 0) {
+            return;
+        }
+
+        const XrExtent2Di extent = density::GetDownsampledExtent(subImage.imageRect.extent, state.level);
+        const ovrSizei resolution{extent.width, extent.height};
+        const auto allocatedMemory =
+            ensurePrecompositorOutputSlice(xrSwapchain, state.slice, 0, resolution, "Downsampled Layer");
+        if (allocatedMemory) {
+            m_vramBudget.set(vram::Category::DownsampledLayer, &xrSwapchain, allocatedMemory.value());
+            state.sourceIndex = -1;
+        }
+
+        // The content is unchanged if the application did not release an image since the last downsampling.
+        const bool isContentUnchanged = xrSwapchain.releaseGeneration == xrSwapchain.consumedGeneration &&
+                                        state.sourceIndex == sourceIndex &&
+                                        state.imageArrayIndex == subImage.imageArrayIndex &&
+                                        !memcmp(&state.imageRect, &subImage.imageRect, sizeof(XrRect2Di));
+        if (!isContentUnchanged) {
+            GpuProfilerScope gpuProfilerScope(m_gpuProfiler.get(), "LayerDownsampling");
+
+            // We are about to do something destructive to the application context. Save the context. It will be
+            // restored at the end of xrEndFrame().
+            if (m_d3d11Device == m_ovrSubmissionDevice && !m_d3d11ContextState) {
+                m_ovrSubmissionContext->SwapDeviceContextState(m_ovrSubmissionContextState.Get(),
+                                                               m_d3d11ContextState.ReleaseAndGetAddressOf());
+            }
+
+            ID3D11ShaderResourceView* const input =
+                getPrecompositorShaderResourceView(xrSwapchain, subImage.imageArrayIndex);
+
+            int imageIndex = 0;
+            CHECK_OVRCMD(ovr_GetTextureSwapChainCurrentIndex(m_ovrSession, state.slice.ovrSwapchain, &imageIndex));
+
+            m_ovrSubmissionContext->CSSetShader(m_downsampleShader.Get(), nullptr, 0);
+            {
+                DownsampleCSConstants constants{};
+                constants.topLeft = subImage.imageRect.offset;
+                constants.sourceSize = subImage.imageRect.extent;
+                constants.scale = {(float)subImage.imageRect.extent.width / resolution.w,
+                                   (float)subImage.imageRect.extent.height / resolution.h};
+                constants.destSize[0] = resolution.w;
+                constants.destSize[1] = resolution.h;
+                // A box filter over a power-of-two reduction is the same as a mip level.
+                constants.filter = (uint32_t)(m_downsamplingFilter != downsampling::Filter::None
+                                                  ? m_downsamplingFilter
+                                                  : downsampling::Filter::Box);
+                constants.isSRGB = isSRGBFormat((DXGI_FORMAT)xrSwapchain.xrDesc.format);
+                constants.useTileMask = false;
+                constants.preserveAlpha = true;
+
+                D3D11_MAPPED_SUBRESOURCE mappedResources;
+                CHECK_HRCMD(m_ovrSubmissionContext->Map(
+                    m_upscalerConstants.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResources));
+                memcpy(mappedResources.pData, &constants, sizeof(constants));
+                m_ovrSubmissionContext->Unmap(m_upscalerConstants.Get(), 0);
+                m_ovrSubmissionContext->CSSetConstantBuffers(0, 1, m_upscalerConstants.GetAddressOf());
+            }
+            m_ovrSubmissionContext->CSSetUnorderedAccessViews(
+                0, 1, state.slice.uavs[imageIndex].GetAddressOf(), nullptr);
+            m_ovrSubmissionContext->CSSetShaderResources(0, 1, &input);
+
+            const uint32_t blockWidth = PrecompositorTileSize;
+            const uint32_t blockHeight = PrecompositorTileSize;
+            m_ovrSubmissionContext->Dispatch(((resolution.w + blockWidth - 1) / blockWidth),
+                                             ((resolution.h + blockHeight - 1) / blockHeight),
+                                             1);
+
+            // Unbind all resources to avoid D3D validation errors.
+            {
+                m_ovrSubmissionContext->CSSetShader(nullptr, nullptr, 0);
+                ID3D11Buffer* nullCBV[] = {nullptr};
+                m_ovrSubmissionContext->CSSetConstantBuffers(0, 1, nullCBV);
+                ID3D11ShaderResourceView* nullSRV[] = {nullptr};
+                m_ovrSubmissionContext->CSSetShaderResources(0, 1, nullSRV);
+                ID3D11UnorderedAccessView* nullUAV[] = {nullptr};
+                m_ovrSubmissionContext->CSSetUnorderedAccessViews(0, 1, nullUAV, nullptr);
+            }
+
+            CHECK_OVRCMD(ovr_CommitTextureSwapChain(m_ovrSession, state.slice.ovrSwapchain));
+
+            state.sourceIndex = sourceIndex;
+            state.imageArrayIndex = subImage.imageArrayIndex;
+            state.imageRect = subImage.imageRect;
+        }
+
+        // Patch the layer.
+        layer.ColorTexture = state.slice.ovrSwapchain;
+        layer.Viewport.Pos = {0, 0};
+        layer.Viewport.Size = resolution;
+    }
+
+    ID3D11ShaderResourceView* OpenXrRuntime::getPrecompositorShaderResourceView(Swapchain& xrSwapchain,
+                                                                               uint32_t imageArrayIndex) {
+        auto& slice = xrSwapchain.resolvedSlices[imageArrayIndex];
+        if ((int)slice.srvs.size() <= slice.lastCommittedIndex) {
+            slice.srvs.resize(slice.lastCommittedIndex + 1);
+        }
+        if (!slice.srvs[slice.lastCommittedIndex]) {
+            D3D11_SHADER_RESOURCE_VIEW_DESC desc{};
+            desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+            desc.Format = getShaderResourceViewFormat(xrSwapchain.dxgiFormatForSubmission);
+            desc.Texture2D.MipLevels = -1;
+            CHECK_HRCMD(m_ovrSubmissionDevice->CreateShaderResourceView(
+                slice.images[slice.lastCommittedIndex].Get(),
+                &desc,
+                slice.srvs[slice.lastCommittedIndex].ReleaseAndGetAddressOf()));
+            setDebugName(slice.srvs[slice.lastCommittedIndex].Get(),
+                         fmt::format("Runtime Slice Copy SRV[{}, {}, {}]",
+                                     imageArrayIndex,
+                                     slice.lastCommittedIndex,
+                                     (void*)&xrSwapchain));
+        }
+
+        return slice.srvs[slice.lastCommittedIndex].Get();
+    }
+
     void OpenXrRuntime::initializePrecompositorResources() {
         CHECK_HRCMD(m_ovrSubmissionDevice->CreateComputeShader(
             g_SharpeningCS, sizeof(g_SharpeningCS), nullptr, m_sharpenShader.ReleaseAndGetAddressOf()));
@@ -270,9 +507,14 @@ namespace virtualdesktop_openxr {
         CHECK_HRCMD(m_ovrSubmissionDevice->CreateComputeShader(
             g_UpscalingCS, sizeof(g_UpscalingCS), nullptr, m_upscaleShader.ReleaseAndGetAddressOf()));
         setDebugName(m_sharpenShader.Get(), "Upscale CS");
+        CHECK_HRCMD(m_ovrSubmissionDevice->CreateComputeShader(
+            g_DownsamplingCS, sizeof(g_DownsamplingCS), nullptr, m_downsampleShader.ReleaseAndGetAddressOf()));
+        setDebugName(m_downsampleShader.Get(), "Downsample CS");
         {
             D3D11_BUFFER_DESC desc{};
-            desc.ByteWidth = (UINT)((std::max(sizeof(SharpenCSConstants), sizeof(UpscaleCSConstants)) + 15) / 16) * 16;
+            const size_t constantsSize =
+                std::max({sizeof(SharpenCSConstants), sizeof(UpscaleCSConstants), sizeof(DownsampleCSConstants)});
+            desc.ByteWidth = (UINT)((constantsSize + 15) / 16) * 16;
             desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
             desc.Usage = D3D11_USAGE_DYNAMIC;
             desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
@@ -283,4 +525,83 @@ namespace virtualdesktop_openxr {
         }
     }
 
+    bool OpenXrRuntime::needSupersamplingDownsampling() const {
+        return m_downsamplingFilter != downsampling::Filter::None && m_supersamplingFactor > 1.f + FLT_EPSILON;
+    }
+
+    void OpenXrRuntime::ensureVisibilityTileMask(uint32_t eye, const ovrFovPort& fov, const ovrSizei& resolution) {
+        VisibilityTileMask& tileMask = m_visibilityTileMask[eye];
+        if (tileMask.srv && tileMask.resolution.w == resolution.w && tileMask.resolution.h == resolution.h &&
+            !memcmp(&tileMask.fov, &fov, sizeof(fov))) {
+            return;
+        }
+
+        // Retrieve the hidden area mesh. It is given for the FOV of the headset, and we convert it to tangent space so
+        // we can project it onto the FOV submitted by the application.
+        ovrFovStencilDesc stencilDesc{};
+        stencilDesc.StencilType = ovrFovStencil_HiddenArea;
+        stencilDesc.Eye = !eye ? ovrEye_Left : ovrEye_Right;
+        stencilDesc.FovPort = m_cachedEyeInfo[eye].Fov;
+        stencilDesc.HmdToEyeRotation = m_cachedEyeInfo[eye].HmdToEyePose.Orientation;
+        ovrFovStencilMeshBuffer buffer{};
+        CHECK_OVRCMD(ovr_GetFovStencil(m_ovrSession, &stencilDesc, &buffer));
+
+        std::vector<XrVector2f> vertices(buffer.UsedVertexCount);
+        std::vector<uint32_t> indices;
+        if (buffer.UsedVertexCount && buffer.UsedIndexCount) {
+            static_assert(sizeof(XrVector2f) == sizeof(ovrVector2f));
+            std::vector<uint16_t> indices16(buffer.UsedIndexCount);
+            buffer.AllocVertexCount = buffer.UsedVertexCount;
+            buffer.VertexBuffer = reinterpret_cast<ovrVector2f*>(vertices.data());
+            buffer.AllocIndexCount = buffer.UsedIndexCount;
+            buffer.IndexBuffer = indices16.data();
+            CHECK_OVRCMD(ovr_GetFovStencil(m_ovrSession, &stencilDesc, &buffer));
+
+            convertSteamVRToOpenXRHiddenMesh(m_cachedEyeInfo[eye].Fov, vertices.data(), (uint32_t)vertices.size());
+            indices.assign(indices16.cbegin(), indices16.cend());
+        }
+
+        const std::vector<uint8_t> tiles = computeVisibleTiles(
+            vertices, indices, fov, resolution.w, resolution.h, PrecompositorTileSize, &tileMask.hiddenTiles);
+
+        {
+            D3D11_TEXTURE2D_DESC desc{};
+            desc.Format = DXGI_FORMAT_R8_UINT;
+            desc.Width = (resolution.w + PrecompositorTileSize - 1) / PrecompositorTileSize;
+            desc.Height = (resolution.h + PrecompositorTileSize - 1) / PrecompositorTileSize;
+            desc.ArraySize = 1;
+            desc.MipLevels = 1;
+            desc.SampleDesc.Count = 1;
+            desc.Usage = D3D11_USAGE_IMMUTABLE;
+            desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+            D3D11_SUBRESOURCE_DATA data{};
+            data.pSysMem = tiles.data();
+            data.SysMemPitch = desc.Width;
+            CHECK_HRCMD(
+                m_ovrSubmissionDevice->CreateTexture2D(&desc, &data, tileMask.texture.ReleaseAndGetAddressOf()));
+            setDebugName(tileMask.texture.Get(), fmt::format("Visibility Tile Mask [{}]", eye));
+        }
+        {
+            D3D11_SHADER_RESOURCE_VIEW_DESC desc{};
+            desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+            desc.Format = DXGI_FORMAT_R8_UINT;
+            desc.Texture2D.MipLevels = 1;
+            CHECK_HRCMD(m_ovrSubmissionDevice->CreateShaderResourceView(
+                tileMask.texture.Get(), &desc, tileMask.srv.ReleaseAndGetAddressOf()));
+            setDebugName(tileMask.srv.Get(), fmt::format("Visibility Tile Mask SRV [{}]", eye));
+        }
+
+        tileMask.resolution = resolution;
+        tileMask.fov = fov;
+
+        TraceLoggingWrite(g_traceProvider,
+                          "VisibilityTileMask",
+                          TLArg(eye, "Eye"),
+                          TLArg(resolution.w, "Width"),
+                          TLArg(resolution.h, "Height"),
+                          TLArg(tiles.size(), "Tiles"),
+                          TLArg(tileMask.hiddenTiles, "HiddenTiles"));
+    }
+
 } // namespace virtualdesktop_openxr
@@ -0,0 +1,213 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "log.h"
+#include "runtime.h"
+#include "utils.h"
+
+#include "QuadViewsCS.h"
+
+// Implements quad views rendering, where the application renders a low resolution peripheral view and a high
+// resolution focus view for each eye:
+// https://registry.khronos.org/OpenXR/specs/1.0/html/xrspec.html#XR_VARJO_quad_views
+// https://registry.khronos.org/OpenXR/specs/1.0/html/xrspec.html#XR_VARJO_foveated_rendering
+
+namespace virtualdesktop_openxr {
+
+    using namespace virtualdesktop_openxr::log;
+    using namespace virtualdesktop_openxr::utils;
+
+    struct QuadViewsCSConstants {
+        alignas(8) XrVector2f peripheralTopLeft;
+        alignas(8) XrVector2f peripheralSize;
+        alignas(8) XrVector2f focusTopLeft;
+        alignas(8) XrVector2f focusSize;
+        alignas(8) XrVector2f focusRectTopLeft;
+        alignas(8) XrVector2f focusRectSize;
+        alignas(4) float featherWidth;
+        alignas(4) bool isSRGB;
+    };
+
+    void OpenXrRuntime::initializeQuadViews() {
+        m_quadViewsPeripheralDensity =
+            std::clamp(getSetting("quad_views_peripheral_density").value_or(50) / 100.f, 0.1f, 1.f);
+        m_quadViewsFocusDensity = std::clamp(getSetting("quad_views_focus_density").value_or(100) / 100.f, 0.1f, 2.f);
+        m_quadViewsFocusSize = std::clamp(getSetting("quad_views_focus_size").value_or(50) / 100.f, 0.1f, 1.f);
+        m_quadViewsFoveatedFocusSize =
+            std::clamp(getSetting("quad_views_foveated_focus_size").value_or(35) / 100.f, 0.1f, 1.f);
+        m_quadViewsFeatherWidth = std::clamp(getSetting("quad_views_feather").value_or(5) / 100.f, 0.f, 0.5f);
+
+        TraceLoggingWrite(g_traceProvider,
+                          "VDXR_Config",
+                          TLArg(m_quadViewsPeripheralDensity, "QuadViewsPeripheralDensity"),
+                          TLArg(m_quadViewsFocusDensity, "QuadViewsFocusDensity"),
+                          TLArg(m_quadViewsFocusSize, "QuadViewsFocusSize"),
+                          TLArg(m_quadViewsFoveatedFocusSize, "QuadViewsFoveatedFocusSize"),
+                          TLArg(m_quadViewsFeatherWidth, "QuadViewsFeatherWidth"));
+    }
+
+    XrFovf OpenXrRuntime::getQuadViewsFov(uint32_t viewIndex, bool foveated, std::optional<XrTime> time) const {
+        if (viewIndex < xr::StereoView::Count) {
+            return m_cachedEyeFov[viewIndex];
+        }
+
+        const uint32_t eye = viewIndex - xr::StereoView::Count;
+        const float size = foveated ? m_quadViewsFoveatedFocusSize : m_quadViewsFocusSize;
+
+        // Without a time, we want the recommended (centered) focus view.
+        std::optional<XrVector3f> gaze;
+        if (foveated && time) {
+            XrVector3f eyeGazeVector{0, 0, -1};
+            XrTime sampleTime;
+            if (getEyeGaze(time.value(), false /* getStateOnly */, eyeGazeVector, sampleTime)) {
+                gaze = eyeGazeVector;
+            }
+        }
+
+        return computeFocusFov(m_cachedEyeFov[eye], size, size, gaze);
+    }
+
+    void OpenXrRuntime::stitchQuadViews(Swapchain** swapchains,
+                                        const XrSwapchainSubImage** subImages,
+                                        const XrFovf* fovs,
+                                        ovrLayerEyeFov& layer) {
+        // We will store our stereo projection in the left eye swapchain.
+        Swapchain& xrSwapchain = *swapchains[xr::StereoView::Left];
+
+        // The output is rendered at the native resolution for the peripheral FOV of each eye.
+        ovrSizei resolutions[xr::StereoView::Count];
+        for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+            resolutions[eye] = ovr_GetFovTextureSize(m_ovrSession,
+                                                     eye == xr::StereoView::Left ? ovrEye_Left : ovrEye_Right,
+                                                     layer.Fov[eye],
+                                                     m_supersamplingFactor);
+            resolutions[eye].w = (int)xr::math::AlignTo<4>((uint32_t)resolutions[eye].w);
+            resolutions[eye].h = (int)xr::math::AlignTo<4>((uint32_t)resolutions[eye].h);
+        }
+        ensureSwapchainPrecompositorResources(xrSwapchain, resolutions);
+
+        if (!m_quadViewsShader) {
+            CHECK_HRCMD(m_ovrSubmissionDevice->CreateComputeShader(
+                g_QuadViewsCS, sizeof(g_QuadViewsCS), nullptr, m_quadViewsShader.ReleaseAndGetAddressOf()));
+            setDebugName(m_quadViewsShader.Get(), "QuadViews CS");
+            {
+                D3D11_BUFFER_DESC desc{};
+                desc.ByteWidth = ((sizeof(QuadViewsCSConstants) + 15) / 16) * 16;
+                desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+                desc.Usage = D3D11_USAGE_DYNAMIC;
+                desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+                CHECK_HRCMD(
+                    m_ovrSubmissionDevice->CreateBuffer(&desc, nullptr, m_quadViewsConstants.ReleaseAndGetAddressOf()));
+                setDebugName(m_quadViewsConstants.Get(), "QuadViews Constants");
+            }
+        }
+
+        // We are about to do something destructive to the application context. Save the context. It will be
+        // restored at the end of xrEndFrame().
+        if (m_d3d11Device == m_ovrSubmissionDevice && !m_d3d11ContextState) {
+            m_ovrSubmissionContext->SwapDeviceContextState(m_ovrSubmissionContextState.Get(),
+                                                           m_d3d11ContextState.ReleaseAndGetAddressOf());
+        }
+
+        for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+            GpuProfilerScope gpuProfilerScope(m_gpuProfiler.get(), "QuadViews", eye);
+
+            const uint32_t focus = xr::StereoView::Count + eye;
+            const ovrSizei& resolution = resolutions[eye];
+
+            // Prepare swapchain outputs.
+            int imageIndex = 0;
+            CHECK_OVRCMD(ovr_GetTextureSwapChainCurrentIndex(
+                m_ovrSession, xrSwapchain.stereoProjection[eye].ovrSwapchain, &imageIndex));
+
+            m_ovrSubmissionContext->CSSetShader(m_quadViewsShader.Get(), nullptr, 0);
+            {
+                const XrRect2Df focusRect = computeFocusRect(fovs[eye], fovs[focus]);
+
+                QuadViewsCSConstants constants{};
+                constants.peripheralTopLeft = {
+                    (float)subImages[eye]->imageRect.offset.x / swapchains[eye]->ovrDesc.Width,
+                    (float)subImages[eye]->imageRect.offset.y / swapchains[eye]->ovrDesc.Height};
+                constants.peripheralSize = {
+                    (float)subImages[eye]->imageRect.extent.width / swapchains[eye]->ovrDesc.Width,
+                    (float)subImages[eye]->imageRect.extent.height / swapchains[eye]->ovrDesc.Height};
+                constants.focusTopLeft = {
+                    (float)subImages[focus]->imageRect.offset.x / swapchains[focus]->ovrDesc.Width,
+                    (float)subImages[focus]->imageRect.offset.y / swapchains[focus]->ovrDesc.Height};
+                constants.focusSize = {
+                    (float)subImages[focus]->imageRect.extent.width / swapchains[focus]->ovrDesc.Width,
+                    (float)subImages[focus]->imageRect.extent.height / swapchains[focus]->ovrDesc.Height};
+                constants.focusRectTopLeft = {focusRect.offset.x, focusRect.offset.y};
+                constants.focusRectSize = {focusRect.extent.width, focusRect.extent.height};
+                constants.featherWidth = m_quadViewsFeatherWidth;
+                constants.isSRGB = isSRGBFormat((DXGI_FORMAT)swapchains[eye]->xrDesc.format);
+
+                D3D11_MAPPED_SUBRESOURCE mappedResources;
+                CHECK_HRCMD(m_ovrSubmissionContext->Map(
+                    m_quadViewsConstants.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResources));
+                memcpy(mappedResources.pData, &constants, sizeof(constants));
+                m_ovrSubmissionContext->Unmap(m_quadViewsConstants.Get(), 0);
+                m_ovrSubmissionContext->CSSetConstantBuffers(0, 1, m_quadViewsConstants.GetAddressOf());
+            }
+            m_ovrSubmissionContext->CSSetUnorderedAccessViews(
+                0, 1, xrSwapchain.stereoProjection[eye].uavs[imageIndex].GetAddressOf(), nullptr);
+            m_ovrSubmissionContext->CSSetSamplers(0, 1, m_linearClampSampler.GetAddressOf());
+            ID3D11ShaderResourceView* srvs[] = {
+                getPrecompositorShaderResourceView(*swapchains[eye], subImages[eye]->imageArrayIndex),
+                getPrecompositorShaderResourceView(*swapchains[focus], subImages[focus]->imageArrayIndex)};
+            m_ovrSubmissionContext->CSSetShaderResources(0, 2, srvs);
+
+            m_ovrSubmissionContext->Dispatch((resolution.w + 15) / 16, (resolution.h + 15) / 16, 1);
+
+            CHECK_OVRCMD(ovr_CommitTextureSwapChain(m_ovrSession, xrSwapchain.stereoProjection[eye].ovrSwapchain));
+
+            // Patch the layer.
+            layer.ColorTexture[eye] = xrSwapchain.stereoProjection[eye].ovrSwapchain;
+            layer.Viewport[eye].Pos = {0, 0};
+            layer.Viewport[eye].Size = resolution;
+
+            TraceLoggingWrite(g_traceProvider,
+                              "StitchQuadViews",
+                              TLArg(eye, "Eye"),
+                              TLArg(xr::ToString(fovs[focus]).c_str(), "FocusFov"),
+                              TLArg(resolution.w, "Width"),
+                              TLArg(resolution.h, "Height"));
+        }
+
+        // Unbind all resources to avoid D3D validation errors.
+        {
+            m_ovrSubmissionContext->CSSetShader(nullptr, nullptr, 0);
+            ID3D11Buffer* nullCBV[] = {nullptr};
+            m_ovrSubmissionContext->CSSetConstantBuffers(0, 1, nullCBV);
+            ID3D11SamplerState* nullSampler[] = {nullptr};
+            m_ovrSubmissionContext->CSSetSamplers(0, 1, nullSampler);
+            ID3D11ShaderResourceView* nullSRV[] = {nullptr, nullptr};
+            m_ovrSubmissionContext->CSSetShaderResources(0, 2, nullSRV);
+            ID3D11UnorderedAccessView* nullUAV[] = {nullptr};
+            m_ovrSubmissionContext->CSSetUnorderedAccessViews(0, 1, nullUAV, nullptr);
+        }
+    }
+
+} // namespace virtualdesktop_openxr
@@ -0,0 +1,113 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+namespace virtualdesktop_openxr::pool {
+
+    // A pool of objects that are expensive to create, kept around after their release so they can be handed out again
+    // for a request with identical parameters (the key). When the pool is full, the least recently released objects
+    // are evicted. The pool never destroys objects itself: evicted objects are returned to the caller.
+    template <typename Key, typename Value>
+    class RecyclingPool {
+      public:
+        RecyclingPool(size_t capacity = 0) : m_capacity(capacity) {
+        }
+
+        // Returns the objects evicted to honor the new capacity.
+        std::vector<Value> setCapacity(size_t capacity) {
+            m_capacity = capacity;
+            return trim();
+        }
+
+        // Take an object matching the key out of the pool, if any.
+        std::optional<Value> acquire(const Key& key) {
+            for (auto it = m_entries.begin(); it != m_entries.end(); it++) {
+                if (it->first == key) {
+                    Value value = std::move(it->second);
+                    m_entries.erase(it);
+                    m_hits++;
+                    return value;
+                }
+            }
+            m_misses++;
+            return {};
+        }
+
+        // Put an object back into the pool. Returns the objects evicted to make room for it (possibly itself).
+        std::vector<Value> recycle(const Key& key, Value value) {
+            m_entries.emplace_front(key, std::move(value));
+            return trim();
+        }
+
+        // Returns all the objects in the pool.
+        std::vector<Value> drain() {
+            std::vector<Value> values;
+            for (auto& entry : m_entries) {
+                values.push_back(std::move(entry.second));
+            }
+            m_entries.clear();
+            return values;
+        }
+
+        size_t size() const {
+            return m_entries.size();
+        }
+
+        uint64_t hits() const {
+            return m_hits;
+        }
+
+        uint64_t misses() const {
+            return m_misses;
+        }
+
+        uint64_t evictions() const {
+            return m_evictions;
+        }
+
+        void resetStatistics() {
+            m_hits = m_misses = m_evictions = 0;
+        }
+
+      private:
+        std::vector<Value> trim() {
+            std::vector<Value> evicted;
+            while (m_entries.size() > m_capacity) {
+                evicted.push_back(std::move(m_entries.back().second));
+                m_entries.pop_back();
+                m_evictions++;
+            }
+            return evicted;
+        }
+
+        size_t m_capacity;
+
+        // Most recently released first.
+        std::list<std::pair<Key, Value>> m_entries;
+
+        uint64_t m_hits{0};
+        uint64_t m_misses{0};
+        uint64_t m_evictions{0};
+    };
+
+} // namespace virtualdesktop_openxr::pool
@@ -0,0 +1,107 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+namespace virtualdesktop_openxr::dynres {
+
+    // Weight of the newest GPU time sample in the moving average.
+    constexpr double GpuTimeSmoothing = 0.1;
+
+    // Maximum change of the scale (per axis) in a single frame. We react faster to overload than to headroom, to avoid
+    // falling back to ASW.
+    constexpr float MaxScaleDecreasePerFrame = 0.04f;
+    constexpr float MaxScaleIncreasePerFrame = 0.01f;
+
+    // Do not react to errors smaller than this.
+    constexpr float ScaleHysteresis = 0.02f;
+
+    // Closed-loop control of the resolution scale (per axis) from the GPU time of the frames.
+    class ScaleController {
+      public:
+        // The budget is the fraction of the frame duration that the GPU work may use.
+        void reset(float minScale, float gpuBudget) {
+            m_minScale = minScale;
+            m_gpuBudget = gpuBudget;
+            m_scale = 1.f;
+            m_filteredGpuTimeUs = 0;
+        }
+
+        void addSample(double gpuTimeUs) {
+            if (m_filteredGpuTimeUs > 0) {
+                m_filteredGpuTimeUs = GpuTimeSmoothing * gpuTimeUs + (1 - GpuTimeSmoothing) * m_filteredGpuTimeUs;
+            } else {
+                m_filteredGpuTimeUs = gpuTimeUs;
+            }
+        }
+
+        // Move the scale toward the one fitting the GPU time budget.
+        void adjust(double frameDuration) {
+            if (m_filteredGpuTimeUs <= 0) {
+                return;
+            }
+
+            // The GPU cost is roughly proportional to the number of pixels, therefore the scale on each axis is
+            // proportional to the square root of the time.
+            const float idealScale = m_scale * (float)std::sqrt(getGpuBudgetUs(frameDuration) / m_filteredGpuTimeUs);
+
+            // Do not bother the application with tiny changes.
+            if (std::abs(idealScale - m_scale) >= ScaleHysteresis) {
+                const float newScale =
+                    std::clamp(idealScale, m_scale - MaxScaleDecreasePerFrame, m_scale + MaxScaleIncreasePerFrame);
+                m_scale = std::clamp(newScale, m_minScale, 1.f);
+            }
+        }
+
+        // Stop scaling down, eg: when the application does not follow the recommendation.
+        void resetScale() {
+            m_scale = 1.f;
+        }
+
+        double getGpuBudgetUs(double frameDuration) const {
+            return frameDuration * 1e6 * m_gpuBudget;
+        }
+
+        float getScale() const {
+            return m_scale;
+        }
+
+        float getMinScale() const {
+            return m_minScale;
+        }
+
+        float getGpuBudget() const {
+            return m_gpuBudget;
+        }
+
+        double getFilteredGpuTimeUs() const {
+            return m_filteredGpuTimeUs;
+        }
+
+      private:
+        float m_minScale{1.f};
+        float m_gpuBudget{0.9f};
+        float m_scale{1.f};
+        double m_filteredGpuTimeUs{0};
+    };
+
+} // namespace virtualdesktop_openxr::dynres
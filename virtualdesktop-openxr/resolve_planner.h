@@ -0,0 +1,178 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+namespace virtualdesktop_openxr::resolve {
+
+    // The GPU work needed to make one slice of an application swapchain image consumable by OVR.
+    enum class Operation {
+        // The OVR swapchain is the application swapchain, there is nothing to do.
+        None = 0,
+        Copy,
+        ResolveColor,
+        ResolveDepth,
+    };
+
+    static inline const char* ToString(Operation operation) {
+        switch (operation) {
+        case Operation::None:
+            return "None";
+        case Operation::Copy:
+            return "Copy";
+        case Operation::ResolveColor:
+            return "Color";
+        case Operation::ResolveDepth:
+            return "Depth";
+        default:
+            return "Unknown";
+        }
+    }
+
+    static inline Operation SelectOperation(bool needCopy, uint32_t sampleCount, bool isDepth) {
+        if (!needCopy) {
+            return Operation::None;
+        }
+        if (sampleCount == 1) {
+            return Operation::Copy;
+        }
+        return !isDepth ? Operation::ResolveColor : Operation::ResolveDepth;
+    }
+
+    struct SliceWork {
+        uint32_t slice{0};
+        // The index of the OVR swapchain image to write to.
+        int destIndex{-1};
+        XrRect2Di region{};
+
+        bool isEmpty() const {
+            return region.extent.width <= 0 || region.extent.height <= 0;
+        }
+    };
+
+    // All the slices of one swapchain image that are processed together. Since all slices of a swapchain share the
+    // same format and sample count, they share the same operation, and the pipeline state only needs to be set once.
+    struct Batch {
+        Operation operation{Operation::None};
+        std::vector<SliceWork> slices;
+
+        // The slices that require GPU work, in order.
+        std::vector<const SliceWork*> work() const {
+            std::vector<const SliceWork*> result;
+            if (operation != Operation::None) {
+                for (const auto& entry : slices) {
+                    if (!entry.isEmpty()) {
+                        result.push_back(&entry);
+                    }
+                }
+            }
+            return result;
+        }
+
+        uint64_t pixels() const {
+            uint64_t count = 0;
+            for (const auto* entry : work()) {
+                count += (uint64_t)entry->region.extent.width * entry->region.extent.height;
+            }
+            return count;
+        }
+    };
+
+    // Order the slices and drop duplicates, so that consecutive operations touch consecutive subresources.
+    static inline Batch MakeBatch(Operation operation, std::vector<SliceWork> slices) {
+        std::sort(slices.begin(), slices.end(), [](const SliceWork& a, const SliceWork& b) {
+            return a.slice < b.slice;
+        });
+        slices.erase(std::unique(slices.begin(),
+                                 slices.end(),
+                                 [](const SliceWork& a, const SliceWork& b) { return a.slice == b.slice; }),
+                     slices.end());
+
+        Batch batch;
+        batch.operation = operation;
+        batch.slices = std::move(slices);
+        return batch;
+    }
+
+    // Reference implementation of ResolveMultisampledDepthPS for one texel: keep the largest depth value across the
+    // samples. loadSample(i) returns the depth of sample i.
+    template <typename LoadSample>
+    static inline float ResolveDepthTexel(uint32_t sampleCount, LoadSample&& loadSample) {
+        float depth = 0;
+        for (uint32_t i = 0; i < sampleCount; i++) {
+            depth = std::max(depth, (float)loadSample(i));
+        }
+        return depth;
+    }
+
+    // The regions updated by the application upon each release of a swapchain (XR_VDXR_swapchain_damage_region). The
+    // OVR swapchain images receiving the copies rotate, so each of them needs the union of the damage since it was
+    // last written, not only the damage of the last release.
+    class DamageHistory {
+      public:
+        static constexpr size_t MaxEntries = 16;
+
+        // No damage region means that the whole image was updated.
+        void record(uint64_t generation, const std::optional<XrRect2Di>& damageRect) {
+            m_entries.push_back({generation, damageRect});
+            if (m_entries.size() > MaxEntries) {
+                m_entries.pop_front();
+            }
+        }
+
+        // The region updated by the releases after the given generation. An empty extent means no update, and no value
+        // means the whole image (including when the history does not go back far enough).
+        std::optional<XrRect2Di> getDamageSince(uint64_t generation) const {
+            if (!generation || (!m_entries.empty() && m_entries.front().generation > generation + 1)) {
+                return {};
+            }
+
+            XrRect2Di damage{};
+            bool isEmpty = true;
+            for (const auto& entry : m_entries) {
+                if (entry.generation <= generation || (entry.damageRect && !utils::getArea(entry.damageRect.value()))) {
+                    continue;
+                }
+                if (!entry.damageRect) {
+                    return {};
+                }
+                damage = isEmpty ? entry.damageRect.value() : utils::unionRect(damage, entry.damageRect.value());
+                isEmpty = false;
+            }
+            return damage;
+        }
+
+        void clear() {
+            m_entries.clear();
+        }
+
+      private:
+        struct Entry {
+            uint64_t generation;
+            std::optional<XrRect2Di> damageRect;
+        };
+
+        std::deque<Entry> m_entries;
+    };
+
+} // namespace virtualdesktop_openxr::resolve
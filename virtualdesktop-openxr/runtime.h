@@ -28,8 +28,19 @@
 #include "utils.h"
 
 #include "BodyState.h"
+#include "body_state_source.h"
 #include <hand_simulation.h>
 #include "trackers.h"
+#include "sync_policy.h"
+#include "recycling_pool.h"
+#include "resolve_planner.h"
+#include "vram_budget.h"
+#include "interop_worker.h"
+#include "downsampler.h"
+#include "layer_density.h"
+#include "graphics_backend.h"
+#include "platform.h"
+#include "resolution_controller.h"
 
 #include <RuntimeConfiguration.h>
 
@@ -307,6 +318,9 @@ namespace virtualdesktop_openxr {
                                                  uint32_t pathCapacityInput,
                                                  uint32_t* pathCountOutput,
                                                  XrViveTrackerPathsHTCX* paths) override;
+        XrResult xrGetRecommendedLayerResolutionMETA(XrSession session,
+                                                     const XrRecommendedLayerResolutionGetInfoMETA* info,
+                                                     XrRecommendedLayerResolutionMETA* resolution) override;
 
       private:
         struct Extension {
@@ -319,6 +333,10 @@ namespace virtualdesktop_openxr {
             std::vector<ComPtr<ID3D11Texture2D>> images;
             int lastCommittedIndex{-1};
 
+            // When the images receive copies of an application swapchain, the release generation that each image is
+            // up to date with, or 0.
+            std::vector<uint64_t> writtenGenerations;
+
             // Resources for copy/resolve/pre-processing.
             std::vector<ComPtr<ID3D11ShaderResourceView>> srvs;
             std::vector<ComPtr<ID3D11UnorderedAccessView>> uavs;
@@ -332,7 +350,18 @@ namespace virtualdesktop_openxr {
             ComPtr<ID3D11UnorderedAccessView> uav;
         };
 
+        // A reduced copy of an oversampled quad or cylinder layer, and the content it was produced from.
+        struct DownsampledLayer {
+            SwapchainSlice slice;
+            uint32_t level{0};
+            uint32_t imageArrayIndex{0};
+            int sourceIndex{-1};
+            XrRect2Di imageRect{};
+        };
+
         struct Swapchain {
+            static constexpr size_t MaxLength = 8;
+
             // The OVR swapchain objects and images we return to the application.
             SwapchainSlice appSwapchain;
             int ovrSwapchainLength{0};
@@ -341,19 +370,30 @@ namespace virtualdesktop_openxr {
             // be used by OVR.
             std::vector<SwapchainSlice> resolvedSlices;
 
-            // The last manipulated swapchain image index.
-            std::deque<int> acquiredIndices;
-            int lastWaitedIndex{-1};
-            int lastReleasedIndex{-1};
-            bool dirty{false};
-            uint32_t nextIndex{0};
+            // The last manipulated swapchain image index. Applications may acquire and release on different threads,
+            // and concurrently with frame submission, so these are accessed without locking.
+            SpscRing<int, MaxLength> acquiredIndices;
+            std::atomic<int> lastWaitedIndex{-1};
+            std::atomic<int> lastReleasedIndex{-1};
+            std::atomic<uint32_t> nextIndex{0};
+
+            // Incremented upon every release. The swapchain is dirty until frame submission consumed the latest
+            // generation, so that a release landing in the middle of frame submission is not lost.
+            std::atomic<uint64_t> releaseGeneration{0};
+            uint64_t consumedGeneration{0};
+
+            // The regions updated by the application upon each release, if declared.
+            std::mutex damageHistoryMutex;
+            resolve::DamageHistory damageHistory;
 
             // For precompositor needs (drawing our own stereo projection).
             SwapchainSlice stereoProjection[xr::StereoView::Count];
+            uint64_t stereoProjectionMemory[xr::StereoView::Count]{};
             IntermediateTexture intermediate[xr::StereoView::Count];
+            DownsampledLayer downsampledLayer;
 
             // Whether a static image swapchain has been acquired at least once.
-            bool frozen{false};
+            std::atomic<bool> frozen{false};
 
             // Resources needed for interop.
             std::vector<ComPtr<ID3D11Texture2D>> d3d11Images;
@@ -369,15 +409,69 @@ namespace virtualdesktop_openxr {
             ovrTextureSwapChainDesc ovrDesc;
         };
 
+        // The creation parameters that make two swapchains interchangeable.
+        struct SwapchainPoolKey {
+            SwapchainPoolKey(const XrSwapchainCreateInfo& createInfo)
+                : createFlags(createInfo.createFlags), usageFlags(createInfo.usageFlags), format(createInfo.format),
+                  sampleCount(createInfo.sampleCount), width(createInfo.width), height(createInfo.height),
+                  faceCount(createInfo.faceCount), arraySize(createInfo.arraySize), mipCount(createInfo.mipCount) {
+            }
+
+            bool operator==(const SwapchainPoolKey& other) const {
+                return std::tie(createFlags,
+                                usageFlags,
+                                format,
+                                sampleCount,
+                                width,
+                                height,
+                                faceCount,
+                                arraySize,
+                                mipCount) == std::tie(other.createFlags,
+                                                      other.usageFlags,
+                                                      other.format,
+                                                      other.sampleCount,
+                                                      other.width,
+                                                      other.height,
+                                                      other.faceCount,
+                                                      other.arraySize,
+                                                      other.mipCount);
+            }
+
+            XrSwapchainCreateFlags createFlags;
+            XrSwapchainUsageFlags usageFlags;
+            int64_t format;
+            uint32_t sampleCount;
+            uint32_t width;
+            uint32_t height;
+            uint32_t faceCount;
+            uint32_t arraySize;
+            uint32_t mipCount;
+        };
+
         struct PrecompositorState {
             // State for the current frame.
             std::set<std::pair<Swapchain*, uint32_t>> resolvedSwapchainImages;
+            std::map<Swapchain*, uint64_t> consumedGenerations;
+            std::map<std::pair<Swapchain*, uint32_t>, XrRect2Di> resolveRegions;
+            std::map<Swapchain*, uint32_t> quadLayerReferences;
             XrTime displayTime{0};
+            std::optional<XrPosef> headPose;
             bool isProj0SRGB{false};
             bool isFirstProjectionLayer{true};
             uint32_t layerIndex{0};
         };
 
+        struct VisibilityTileMask {
+            // The resolution and FOV that the mask was computed for.
+            ovrSizei resolution{};
+            ovrFovPort fov{};
+
+            // One texel per tile, 0 when the tile can be skipped.
+            ComPtr<ID3D11Texture2D> texture;
+            ComPtr<ID3D11ShaderResourceView> srv;
+            uint32_t hiddenTiles{0};
+        };
+
         struct Space {
             // Information recorded at creation.
             XrReferenceSpaceType referenceType;
@@ -503,12 +597,13 @@ namespace virtualdesktop_openxr {
         void enterVisibleMode();
         bool ensureOVRSession();
         void initializeSystem();
-        void initializeBodyTrackingMmf();
+        void initializeBodyStateSource();
         void bodyStateWatcherThread();
 
         // session.cpp
         void updateSessionState(bool forceSendEvent = false);
         void refreshSettings();
+        void initializeGraphicsBackend();
 
         // action.cpp
         void rebindControllerActions(int side);
@@ -568,6 +663,7 @@ namespace virtualdesktop_openxr {
                                          const XrCompositionLayerCylinderKHR& cylinder,
                                          ovrLayer_Union& layer);
         XrResult handleCubeLayer(const XrCompositionLayerCubeKHR& cube, ovrLayer_Union& layer);
+        void collectResolveRegions(const XrFrameEndInfo& frameEndInfo);
         void preprocessSwapchainImage(Swapchain& xrSwapchain,
                                       uint32_t layerIndex,
                                       uint32_t slice,
@@ -577,6 +673,13 @@ namespace virtualdesktop_openxr {
         void asyncSubmissionThread();
         void waitForAsyncSubmissionIdle(bool doRunningStart = false);
 
+        // swapchain.cpp
+        void destroySwapchain(Swapchain& xrSwapchain);
+        std::shared_lock<std::shared_mutex> lockSwapchainsShared();
+        std::unique_lock<std::shared_mutex> lockSwapchainsExclusive();
+        void recordSwapchainsLockWait(uint64_t durationUs);
+        void updateVideoMemoryBudget();
+
         // d3d11_native.cpp
         XrResult initializeD3D11(const XrGraphicsBindingD3D11KHR& d3dBindings);
         void cleanupD3D11();
@@ -589,8 +692,17 @@ namespace virtualdesktop_openxr {
                                    uint32_t slice,
                                    std::set<std::pair<Swapchain*, uint32_t>>& resolved,
                                    bool skipCommit = false);
+        void resolveSwapchainImages(Swapchain& xrSwapchain,
+                                    const std::vector<uint32_t>& slices,
+                                    std::set<std::pair<Swapchain*, uint32_t>>& resolved,
+                                    bool skipCommit = false);
         void ensureSwapchainSliceResources(Swapchain& xrSwapchain, uint32_t slice) const;
-        void ensureSwapchainPrecompositorResources(Swapchain& xrSwapchain, const ovrSizei& resolution) const;
+        void ensureSwapchainPrecompositorResources(Swapchain& xrSwapchain, const ovrSizei* resolutions) const;
+        std::optional<uint64_t> ensurePrecompositorOutputSlice(const Swapchain& xrSwapchain,
+                                                               SwapchainSlice& slice,
+                                                               uint32_t sliceIndex,
+                                                               const ovrSizei& resolution,
+                                                               const char* debugName) const;
         void populateSwapchainSlice(const Swapchain& xrSwapchain,
                                     const ovrTextureSwapChainDesc& desc,
                                     SwapchainSlice& slice,
@@ -600,6 +712,18 @@ namespace virtualdesktop_openxr {
         void flushSubmissionContext();
         void serializeD3D11Frame();
         void waitOnSubmissionDevice();
+        bool waitForFence(sync::WaitSite site,
+                          ID3D11Fence* fence,
+                          uint64_t value,
+                          std::optional<uint64_t> budgetUs = {},
+                          uint64_t* durationUs = nullptr);
+        bool waitForFenceEvent(sync::WaitSite site,
+                               uint64_t value,
+                               std::optional<uint64_t> budgetUs,
+                               uint64_t* durationUs,
+                               const std::function<uint64_t()>& getCompletedValue);
+        void waitForFenceEventInfinite(sync::WaitSite site);
+        void recordWait(sync::WaitSite site, uint64_t durationUs, bool timedOut);
         bool requireNTHandleSharing() const;
 
         // d3d12_interop.cpp
@@ -608,6 +732,7 @@ namespace virtualdesktop_openxr {
         bool isD3D12Session() const;
         XrResult getSwapchainImagesD3D12(Swapchain& xrSwapchain, XrSwapchainImageD3D12KHR* d3d12Images, uint32_t count);
         void flushD3D12CommandQueue();
+        bool waitForFence(sync::WaitSite site, ID3D12Fence* fence, uint64_t value);
         void serializeD3D12Frame();
 
         // vulkan_interop.cpp
@@ -623,6 +748,8 @@ namespace virtualdesktop_openxr {
         // opengl_interop.cpp
         XrResult initializeOpenGL(const XrGraphicsBindingOpenGLWin32KHR& glBindings);
         void initializeOpenGLDispatch();
+        void initializeOpenGLWorker();
+        void runOnOpenGLContext(const std::function<void()>& work);
         void cleanupOpenGL();
         bool isOpenGLSession() const;
         XrResult getSwapchainImagesOpenGL(Swapchain& xrSwapchain, XrSwapchainImageOpenGLKHR* glImages, uint32_t count);
@@ -632,14 +759,37 @@ namespace virtualdesktop_openxr {
 
         // precompositor.cpp
         void upscaler(Swapchain** swapchains, const XrSwapchainSubImage** subImages, ovrLayerEyeFov& layer);
+        bool needSupersamplingDownsampling() const;
+        void downsampleQuadLayer(Swapchain& xrSwapchain,
+                                 const XrSwapchainSubImage& subImage,
+                                 const density::AngularExtent& angularExtent,
+                                 ovrLayerQuad& layer);
+        ID3D11ShaderResourceView* getPrecompositorShaderResourceView(Swapchain& xrSwapchain,
+                                                                     uint32_t imageArrayIndex);
         void initializePrecompositorResources();
+        void ensureVisibilityTileMask(uint32_t eye, const ovrFovPort& fov, const ovrSizei& resolution);
+
+        // dynamic_resolution.cpp
+        void initializeDynamicResolution();
+        void updateDynamicResolution(uint64_t appGpuTimeUs, uint64_t precompositionGpuTimeUs);
+        XrExtent2Di getDynamicResolutionRecommendedSize(uint32_t eye) const;
+        bool needDynamicResolutionUpscaling(const XrRect2Di& imageRect, uint32_t eye) const;
+
+        // quad_views.cpp
+        void initializeQuadViews();
+        XrFovf getQuadViewsFov(uint32_t viewIndex, bool foveated, std::optional<XrTime> time = {}) const;
+        void stitchQuadViews(Swapchain** swapchains,
+                             const XrSwapchainSubImage** subImages,
+                             const XrFovf* fovs,
+                             ovrLayerEyeFov& layer);
 
         // visibility_mask.cpp
         void convertSteamVRToOpenXRHiddenMesh(const ovrFovPort& fov, XrVector2f* vertices, uint32_t count) const;
 
         // mirror_window.cpp
         void createMirrorWindow();
-        void updateMirrorWindow(bool preferSRGB = false);
+        void initializeMirrorWindowDevice();
+        void presentMirrorWindow();
         LRESULT CALLBACK mirrorWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
         friend LRESULT CALLBACK wndProcWrapper(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
@@ -669,6 +819,7 @@ namespace virtualdesktop_openxr {
         using CheckValidPathFunction = std::function<bool(const std::string&)>;
         std::map<std::pair<std::string, std::string>, MappingFunction> m_controllerMappingTable;
         std::map<std::string, CheckValidPathFunction> m_controllerValidPathsTable;
+        std::shared_ptr<const platform::ISettingsStore> m_settingsStore;
         wil::unique_registry_watcher m_registryWatcher;
         bool m_loggedResolution{false};
         std::string m_applicationName;
@@ -676,8 +827,8 @@ namespace virtualdesktop_openxr {
         bool m_isUnity{false};
         bool m_useApplicationDeviceForSubmission{true};
         EyeTracking m_eyeTrackingType{EyeTracking::None};
-        wil::unique_handle m_bodyStateFile;
-        BodyTracking::BodyStateV2* m_bodyState{nullptr};
+        std::unique_ptr<BodyTracking::BodyStateSource> m_bodyStateSource;
+        bool m_isBodyStateEmulated{false};
         bool m_supportsHandTracking{false};
         bool m_supportsFaceTracking{false};
         bool m_supportsBodyTracking{false};
@@ -689,19 +840,24 @@ namespace virtualdesktop_openxr {
         bool m_isConformanceTest{false};
         bool m_isOpenComposite{false};
         bool m_isLowVideoMemorySystem{false};
+        ComPtr<IDXGIAdapter3> m_dxgiAdapter;
         ovrTextureSwapChain m_headlessSwapchain{nullptr};
         bool m_allowStaticSwapchainsReuse{false};
         bool m_forceSlowpathSwapchains{false};
 
         // Session state.
         bool m_isHeadless{false};
+        std::unique_ptr<graphics::IBackend<Swapchain>> m_graphicsBackend;
         ComPtr<ID3D11Device5> m_ovrSubmissionDevice;
         ComPtr<ID3D11DeviceContext4> m_ovrSubmissionContext;
         ComPtr<ID3DDeviceContextState> m_ovrSubmissionContextState;
         ComPtr<ID3D11Fence> m_ovrSubmissionFence;
-        wil::unique_handle m_eventForSubmissionFence;
+        // One event and one deadline timer per wait site, so that concurrent waits never steal each other's signal.
+        wil::unique_handle m_eventForFenceWait[(uint32_t)sync::WaitSite::Count];
+        wil::unique_handle m_timerForFenceWait[(uint32_t)sync::WaitSite::Count];
+        static constexpr uint64_t k_fenceWaitTimeoutUs = 1'000'000;
         UINT m_gpuVendor{0};
-        bool m_syncGpuWorkInEndFrame{false};
+        sync::SyncPolicy m_syncPolicy;
         ComPtr<ID3D11SamplerState> m_linearClampSampler;
         ComPtr<ID3D11SamplerState> m_pointClampSampler;
         ComPtr<ID3D11DepthStencilState> m_noDepthReadState;
@@ -712,7 +868,11 @@ namespace virtualdesktop_openxr {
         ComPtr<ID3D11Buffer> m_alphaCorrectConstants;
         ComPtr<ID3D11ComputeShader> m_sharpenShader;
         ComPtr<ID3D11ComputeShader> m_upscaleShader;
+        ComPtr<ID3D11ComputeShader> m_downsampleShader;
         ComPtr<ID3D11Buffer> m_upscalerConstants;
+        VisibilityTileMask m_visibilityTileMask[xr::StereoView::Count];
+        ComPtr<ID3D11ComputeShader> m_quadViewsShader;
+        ComPtr<ID3D11Buffer> m_quadViewsConstants;
         ComPtr<IDXGISwapChain1> m_dxgiSwapchain;
         bool m_sessionCreated{false};
         XrSessionState m_sessionState{XR_SESSION_STATE_UNKNOWN};
@@ -768,25 +928,60 @@ namespace virtualdesktop_openxr {
         float m_supersamplingFactor{1.f};
         float m_upscalingMultiplier{1.f};
         float m_sharpenFactor{0.f};
+        downsampling::Filter m_downsamplingFilter{downsampling::Filter::None};
+        bool m_useVisibilityTileMask{true};
+        bool m_useResolveRegions{true};
+        bool m_useLayerDownsampling{true};
         float m_overrideWorldScale{1.f};
         float m_overrideVisibilityMaskScale{1.f};
         uint32_t m_visibilityMaskDirty{0};
         int64_t m_controllerLingerTimeout{5'000'000'000};
         std::unique_ptr<AccessibilityHelper> m_accessibilityHelper;
 
+        // Quad views.
+        XrViewConfigurationType m_primaryViewConfigurationType{XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO};
+        float m_quadViewsPeripheralDensity{0.5f};
+        float m_quadViewsFocusDensity{1.f};
+        float m_quadViewsFocusSize{0.5f};
+        float m_quadViewsFoveatedFocusSize{0.35f};
+        float m_quadViewsFeatherWidth{0.05f};
+
+        // Dynamic resolution.
+        bool m_useDynamicResolution{false};
+        dynres::ScaleController m_dynamicResolutionController;
+        ovrSizei m_dynamicResolutionNativeSize[xr::StereoView::Count]{};
+        XrExtent2Di m_dynamicResolutionSubmittedSize[xr::StereoView::Count]{};
+        uint32_t m_dynamicResolutionIgnoredFrames{0};
+        bool m_dynamicResolutionIsIgnored{false};
+
         // Swapchains and other graphics stuff.
-        std::mutex m_swapchainsMutex;
+        std::shared_mutex m_swapchainsMutex;
         std::set<XrSwapchain> m_swapchains;
+        pool::RecyclingPool<SwapchainPoolKey, Swapchain*> m_swapchainPool;
+        int m_swapchainPoolSize{4};
+        bool m_preWarmSwapchains{true};
+        mutable vram::BudgetManager m_vramBudget;
+        bool m_useVideoMemoryBudget{true};
+        double m_lastVideoMemoryBudgetUpdate{0};
 
         // Mirror window.
         bool m_useMirrorWindow{false};
+        int m_mirrorWindowFrameRate{30};
+        float m_mirrorWindowScale{0.5f};
+        float m_mirrorWindowZoom{1.f};
+        int m_mirrorWindowEye{1};
+        std::atomic<bool> m_mirrorWindowPreferSRGB{false};
         std::mutex m_mirrorWindowMutex;
         HWND m_mirrorWindowHwnd{nullptr};
         bool m_mirrorWindowReady{false};
         std::thread m_mirrorWindowThread;
+        ComPtr<ID3D11Device> m_mirrorWindowDevice;
+        ComPtr<ID3D11DeviceContext> m_mirrorWindowContext;
+        std::unique_ptr<ITimer> m_mirrorWindowGpuTimer;
         ComPtr<IDXGISwapChain1> m_mirrorWindowSwapchain;
         ovrMirrorTexture m_ovrMirrorSwapChain{nullptr};
         ComPtr<ID3D11Texture2D> m_mirrorTexture;
+        int m_mirrorTextureEye{-1};
 
         // Async submission thread.
         bool m_useAsyncSubmission{false};
@@ -802,7 +997,6 @@ namespace virtualdesktop_openxr {
         bool m_terminateBodyStateThread{false};
         std::thread m_bodyStateWatcherThread;
         mutable std::shared_mutex m_bodyStateMutex;
-        wil::unique_handle m_bodyStateEvent;
 
         // Graphics API interop.
         ComPtr<ID3D11Device5> m_d3d11Device;
@@ -827,6 +1021,9 @@ namespace virtualdesktop_openxr {
         GlContext m_glContext{};
         // Pointers in the dispatcher must be initialized in initializeOpenGLDispatch().
         GlDispatch m_glDispatch;
+        // A thread owning a context that shares objects with the application context, so that the interop work does
+        // not require switching contexts on the application thread.
+        std::unique_ptr<interop::WorkerQueue> m_glWorker;
 
         ComPtr<ID3D11Fence> m_d3d11Fence;
         ComPtr<ID3D12Fence> m_d3d12Fence;
@@ -866,11 +1063,19 @@ namespace virtualdesktop_openxr {
         double m_sessionStartTime{0.0};
         uint64_t m_sessionTotalFrameCount{0};
         std::deque<double> m_frameTimes;
+        sync::WaitStatistics m_waitStatistics[(uint32_t)sync::WaitSite::Count];
+        uint64_t m_resolvedPixels{0};
+        uint64_t m_resolvablePixels{0};
+        std::mutex m_swapchainsLockStatisticsMutex;
+        sync::WaitStatistics m_swapchainsLockWaits;
         CpuTimer m_frameTimerApp;
         CpuTimer m_renderTimerApp;
         static constexpr uint32_t k_numGpuTimers = 3;
         std::unique_ptr<ITimer> m_gpuTimerApp[k_numGpuTimers];
         std::unique_ptr<ITimer> m_gpuTimerPrecomposition[k_numGpuTimers];
+        bool m_useGpuProfiler{false};
+        std::unique_ptr<D3D11GpuProfiler> m_gpuProfiler;
+        profiler::ProfilerStatistics m_gpuProfilerStatistics;
         uint32_t m_currentTimerIndex{0};
     };
 
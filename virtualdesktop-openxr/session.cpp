@@ -154,6 +154,7 @@ namespace virtualdesktop_openxr {
             // frames.
             initializeSubmissionDevice("Headless");
         }
+        initializeGraphicsBackend();
 
         // Read configuration and set up the session accordingly.
         refreshSettings();
@@ -283,6 +284,35 @@ namespace virtualdesktop_openxr {
             // deadlocks.
             CHECK_XRCMD(xrDestroySwapchain(*m_swapchains.begin()));
         }
+        for (auto xrSwapchain : m_swapchainPool.drain()) {
+            destroySwapchain(*xrSwapchain);
+        }
+        if (m_swapchainPool.hits() || m_swapchainPool.misses()) {
+            TraceLoggingWrite(g_traceProvider,
+                              "SwapchainPool_Stats",
+                              TLArg(m_swapchainPool.hits(), "Hits"),
+                              TLArg(m_swapchainPool.misses(), "Misses"),
+                              TLArg(m_swapchainPool.evictions(), "Evictions"));
+            Log("Swapchain pool: %llu hits, %llu misses, %llu evictions\n",
+                m_swapchainPool.hits(),
+                m_swapchainPool.misses(),
+                m_swapchainPool.evictions());
+            m_swapchainPool.resetStatistics();
+        }
+        if (m_resolvablePixels) {
+            Log("Resolved %llu pixels out of %llu (%.1f%%)\n",
+                m_resolvedPixels,
+                m_resolvablePixels,
+                100.0 * m_resolvedPixels / m_resolvablePixels);
+            m_resolvedPixels = m_resolvablePixels = 0;
+        }
+        if (m_swapchainsLockWaits.count) {
+            Log("Contended swapchain lock: %llu waits, %.3f ms total, %.3f ms max\n",
+                m_swapchainsLockWaits.count,
+                m_swapchainsLockWaits.totalUs / 1000.0,
+                m_swapchainsLockWaits.maxUs / 1000.0);
+            m_swapchainsLockWaits = {};
+        }
         if (m_headlessSwapchain) {
             ovr_DestroyTextureSwapChain(m_ovrSession, m_headlessSwapchain);
         }
@@ -296,6 +326,7 @@ namespace virtualdesktop_openxr {
         cleanupD3D12();
         cleanupD3D11();
         cleanupSubmissionDevice();
+        m_graphicsBackend.reset();
         m_sessionState = XR_SESSION_STATE_UNKNOWN;
         m_sessionCreated = false;
         m_sessionBegun = false;
@@ -327,7 +358,9 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        if (!m_isHeadless && beginInfo->primaryViewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO) {
+        if (!m_isHeadless && beginInfo->primaryViewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO &&
+            !(has_XR_VARJO_quad_views &&
+              beginInfo->primaryViewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_QUAD_VARJO)) {
             if (beginInfo->primaryViewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_MONO ||
                 (m_apiMinor >= 1 && beginInfo->primaryViewConfigurationType ==
                                         XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO_WITH_FOVEATED_INSET)) {
@@ -351,7 +384,7 @@ namespace virtualdesktop_openxr {
 
         // Start the body watcher thread.
         if (m_supportsHandTracking ||
-            ((has_XR_EXT_eye_gaze_interaction || has_XR_FB_eye_tracking_social) &&
+            ((has_XR_EXT_eye_gaze_interaction || has_XR_FB_eye_tracking_social || has_XR_VARJO_foveated_rendering) &&
              m_eyeTrackingType == EyeTracking::Mmf) ||
             ((has_XR_FB_face_tracking || has_XR_FB_face_tracking2) && m_supportsFaceTracking) ||
             ((has_XR_FB_body_tracking || has_XR_HTCX_vive_tracker_interaction) && m_supportsBodyTracking)) {
@@ -359,6 +392,9 @@ namespace virtualdesktop_openxr {
             m_bodyStateWatcherThread = std::thread([&]() { bodyStateWatcherThread(); });
         }
 
+        m_primaryViewConfigurationType =
+            !m_isHeadless ? beginInfo->primaryViewConfigurationType : XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+
         m_sessionBegun = true;
         updateSessionState();
 
@@ -519,7 +555,15 @@ namespace virtualdesktop_openxr {
             }
         }
 
+        m_swapchainPoolSize = std::max(getSetting("swapchain_pool_size").value_or(4), 0);
+        m_preWarmSwapchains = getSetting("swapchain_prewarm").value_or(true);
+        m_useVideoMemoryBudget = getSetting("vram_budget").value_or(true);
+
         m_useMirrorWindow = getSetting("mirror_window").value_or(false);
+        m_mirrorWindowFrameRate = std::clamp(getSetting("mirror_window_fps").value_or(30), 1, 120);
+        m_mirrorWindowScale = std::clamp(getSetting("mirror_window_scale").value_or(50), 10, 100) / 100.f;
+        m_mirrorWindowZoom = std::max(getSetting("mirror_window_zoom").value_or(100), 100) / 100.f;
+        m_mirrorWindowEye = getSetting("mirror_window_eye").value_or(1);
 
         m_useRunningStart = !getSetting("quirk_disable_running_start").value_or(false);
         m_useDeferredFrameWait = getSetting("defer_frame_wait").value_or(false);
@@ -532,11 +576,25 @@ namespace virtualdesktop_openxr {
 #endif
         m_shouldUseDepth = getSetting("quirk_use_depth").value_or(shouldUseDepth);
 
-        m_syncGpuWorkInEndFrame = getSetting("quirk_sync_gpu_work_in_end_frame").value_or(false);
+        {
+            // GPU waits are the default. The legacy quirk forces CPU waits, and the adaptive policy is opt-in, unless a
+            // policy is explicitly requested.
+            const bool syncGpuWorkInEndFrame = getSetting("quirk_sync_gpu_work_in_end_frame").value_or(false);
+            const auto syncPolicy =
+                getSetting("sync_policy")
+                    .value_or((int)(syncGpuWorkInEndFrame ? sync::WaitMode::Cpu : sync::WaitMode::Gpu));
+            m_syncPolicy.setMode((sync::WaitMode)std::clamp(syncPolicy, 0, 2));
+        }
 
         m_jiggleViewRotations = getSetting("jiggle_view_rotations").value_or(false);
 
         m_sharpenFactor = getSetting("sharpen").value_or(0) / 100.f;
+        m_downsamplingFilter = (downsampling::Filter)std::clamp(
+            getSetting("downsampling").value_or(0), 0, (int)downsampling::Filter::Count - 1);
+        m_useVisibilityTileMask = getSetting("visibility_tile_mask").value_or(true);
+        m_useResolveRegions = getSetting("resolve_regions").value_or(true);
+        m_useLayerDownsampling = getSetting("layer_downsampling").value_or(true);
+        m_useGpuProfiler = getSetting("gpu_profiler").value_or(false);
 
         m_overrideWorldScale = getSetting("world_scale").value_or(100) / 100.f;
 
@@ -552,16 +610,73 @@ namespace virtualdesktop_openxr {
 
         TraceLoggingWrite(g_traceProvider,
                           "VDXR_Config",
+                          TLArg(m_swapchainPoolSize, "SwapchainPoolSize"),
+                          TLArg(m_preWarmSwapchains, "PreWarmSwapchains"),
+                          TLArg(m_useVideoMemoryBudget, "UseVideoMemoryBudget"),
                           TLArg(m_useMirrorWindow, "MirrorWindow"),
+                          TLArg(m_mirrorWindowFrameRate, "MirrorWindowFrameRate"),
+                          TLArg(m_mirrorWindowScale, "MirrorWindowScale"),
+                          TLArg(m_mirrorWindowZoom, "MirrorWindowZoom"),
+                          TLArg(m_mirrorWindowEye, "MirrorWindowEye"),
                           TLArg(m_useRunningStart, "UseRunningStart"),
                           TLArg(m_useDeferredFrameWait, "UseDeferredFrameWait"),
                           TLArg(m_shouldUseDepth, "ShouldUseDepth"),
-                          TLArg(m_syncGpuWorkInEndFrame, "SyncGpuWorkInEndFrame"),
+                          TLArg((int)m_syncPolicy.getMode(), "SyncPolicy"),
                           TLArg(m_jiggleViewRotations, "JiggleViewRotations"),
                           TLArg(m_sharpenFactor, "SharpenFactor"),
+                          TLArg(downsampling::ToString(m_downsamplingFilter), "DownsamplingFilter"),
+                          TLArg(m_useVisibilityTileMask, "UseVisibilityTileMask"),
+                          TLArg(m_useResolveRegions, "UseResolveRegions"),
+                          TLArg(m_useLayerDownsampling, "UseLayerDownsampling"),
+                          TLArg(m_useGpuProfiler, "UseGpuProfiler"),
                           TLArg(m_overrideWorldScale, "OverrideWorldScale"),
                           TLArg(m_overrideVisibilityMaskScale, "OverrideVisibilityMaskScale"),
                           TLArg(m_controllerLingerTimeout, "ControllerLingerTimeout"));
     }
 
+    // Select the implementation of the graphics API-specific operations, once the graphics bindings are known.
+    void OpenXrRuntime::initializeGraphicsBackend() {
+        using namespace graphics;
+
+        if (m_isHeadless) {
+            m_graphicsBackend = std::make_unique<HeadlessBackend<Swapchain>>();
+        } else if (isD3D12Session()) {
+            m_graphicsBackend = std::make_unique<DelegateBackend<Swapchain, XrSwapchainImageD3D12KHR>>(
+                Api::D3D12,
+                [&] { serializeD3D12Frame(); },
+                [&] { flushD3D12CommandQueue(); },
+                [&](Swapchain& xrSwapchain, XrSwapchainImageD3D12KHR* images, uint32_t count) {
+                    return getSwapchainImagesD3D12(xrSwapchain, images, count);
+                });
+        } else if (isVulkanSession()) {
+            m_graphicsBackend = std::make_unique<DelegateBackend<Swapchain, XrSwapchainImageVulkanKHR>>(
+                Api::Vulkan,
+                [&] { serializeVulkanFrame(); },
+                [&] { flushVulkanCommandQueue(); },
+                [&](Swapchain& xrSwapchain, XrSwapchainImageVulkanKHR* images, uint32_t count) {
+                    return getSwapchainImagesVulkan(xrSwapchain, images, count);
+                },
+                [&](Swapchain& xrSwapchain) { cleanupSwapchainImagesVulkan(xrSwapchain); });
+        } else if (isOpenGLSession()) {
+            m_graphicsBackend = std::make_unique<DelegateBackend<Swapchain, XrSwapchainImageOpenGLKHR>>(
+                Api::OpenGL,
+                [&] { serializeOpenGLFrame(); },
+                [&] { flushOpenGLContext(); },
+                [&](Swapchain& xrSwapchain, XrSwapchainImageOpenGLKHR* images, uint32_t count) {
+                    return getSwapchainImagesOpenGL(xrSwapchain, images, count);
+                },
+                [&](Swapchain& xrSwapchain) { cleanupSwapchainImagesOpenGL(xrSwapchain); });
+        } else {
+            m_graphicsBackend = std::make_unique<DelegateBackend<Swapchain, XrSwapchainImageD3D11KHR>>(
+                Api::D3D11,
+                [&] { serializeD3D11Frame(); },
+                [&] { flushD3D11Context(); },
+                [&](Swapchain& xrSwapchain, XrSwapchainImageD3D11KHR* images, uint32_t count) {
+                    return getSwapchainImagesD3D11(xrSwapchain, images, count);
+                });
+        }
+
+        TraceLoggingWrite(g_traceProvider, "GraphicsBackend", TLArg(ToString(m_graphicsBackend->getApi()), "Api"));
+    }
+
 } // namespace virtualdesktop_openxr
@@ -328,7 +328,9 @@ namespace virtualdesktop_openxr {
             }
         }
 
-        if (viewLocateInfo->viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO) {
+        if (viewLocateInfo->viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO &&
+            !(has_XR_VARJO_quad_views &&
+              viewLocateInfo->viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_QUAD_VARJO)) {
             if (viewLocateInfo->viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_MONO ||
                 (m_apiMinor >= 1 && viewLocateInfo->viewConfigurationType ==
                                         XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO_WITH_FOVEATED_INSET)) {
@@ -337,17 +339,31 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
-        if (viewCapacityInput && viewCapacityInput < xr::StereoView::Count) {
+        const bool isQuadViews = viewLocateInfo->viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_QUAD_VARJO;
+        const uint32_t viewCount = !isQuadViews ? xr::StereoView::Count : xr::QuadView::Count;
+        if (viewCapacityInput && viewCapacityInput < viewCount) {
             return XR_ERROR_SIZE_INSUFFICIENT;
         }
 
+        bool foveatedRenderingActive = false;
+        if (has_XR_VARJO_foveated_rendering) {
+            const XrBaseInStructure* entry = reinterpret_cast<const XrBaseInStructure*>(viewLocateInfo->next);
+            while (entry) {
+                if (entry->type == XR_TYPE_VIEW_LOCATE_FOVEATED_RENDERING_VARJO) {
+                    foveatedRenderingActive =
+                        reinterpret_cast<const XrViewLocateFoveatedRenderingVARJO*>(entry)->foveatedRenderingActive;
+                }
+                entry = entry->next;
+            }
+        }
+
         std::shared_lock lock(m_actionsAndSpacesMutex);
 
         if (!m_spaces.count(viewLocateInfo->space)) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        *viewCountOutput = xr::StereoView::Count;
+        *viewCountOutput = viewCount;
         TraceLoggingWrite(g_traceProvider, "xrLocateViews", TLArg(*viewCountOutput, "ViewCountOutput"));
 
         if (viewCapacityInput && views) {
@@ -372,8 +388,11 @@ namespace virtualdesktop_openxr {
                         return XR_ERROR_VALIDATION_FAILURE;
                     }
 
-                    views[i].pose = ovrPoseToXrPose(eyePoses[i]);
-                    views[i].fov = m_cachedEyeFov[i];
+                    views[i].pose = ovrPoseToXrPose(eyePoses[i % xr::StereoView::Count]);
+                    views[i].fov = !isQuadViews ? m_cachedEyeFov[i]
+                                                : getQuadViewsFov(i,
+                                                                  foveatedRenderingActive,
+                                                                  viewLocateInfo->displayTime);
 
                     // Debug option to test reprojection.
                     if (m_jiggleViewRotations) {
@@ -411,6 +430,10 @@ namespace virtualdesktop_openxr {
                     // Store the actual IPD as reported by the runtime so we can restore it later in xrEndFrame().
                     m_lastSeenIpd = overrideIpd(
                         views[xr::StereoView::Left].pose, views[xr::StereoView::Right].pose, m_overrideWorldScale);
+                    if (isQuadViews) {
+                        views[xr::QuadView::FocusLeft].pose = views[xr::StereoView::Left].pose;
+                        views[xr::QuadView::FocusRight].pose = views[xr::StereoView::Right].pose;
+                    }
                 } else {
                     m_lastSeenIpd.reset();
                 }
@@ -0,0 +1,77 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    // A fixed-capacity FIFO that needs no locking between one producer thread and one consumer thread.
+    template <typename T, size_t Capacity>
+    class SpscRing {
+      public:
+        bool push(const T& value) {
+            const auto tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) == Capacity) {
+                return false;
+            }
+            m_slots[tail % Capacity] = value;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        std::optional<T> front() const {
+            const auto head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire)) {
+                return {};
+            }
+            return m_slots[head % Capacity];
+        }
+
+        bool pop() {
+            const auto head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_t size() const {
+            return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        // Not safe against concurrent pushes or pops.
+        void clear() {
+            m_head = m_tail.load();
+        }
+
+      private:
+        std::array<T, Capacity> m_slots{};
+        std::atomic<size_t> m_head{0};
+        std::atomic<size_t> m_tail{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
@@ -39,6 +39,9 @@ namespace virtualdesktop_openxr {
                                                           XrViewConfigurationType* viewConfigurationTypes) {
         std::vector<XrViewConfigurationType> types;
         types.push_back(XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO);
+        if (has_XR_VARJO_quad_views) {
+            types.push_back(XR_VIEW_CONFIGURATION_TYPE_PRIMARY_QUAD_VARJO);
+        }
 
         TraceLoggingWrite(g_traceProvider,
                           "xrEnumerateViewConfigurations",
@@ -102,7 +105,8 @@ namespace virtualdesktop_openxr {
 
         CHECK_MSG(ensureOVRSession(), "Failed to re-create OVR session\n");
 
-        if (viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO) {
+        if (viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO &&
+            !(has_XR_VARJO_quad_views && viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_QUAD_VARJO)) {
             if (viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_MONO ||
                 (m_apiMinor >= 1 &&
                  viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO_WITH_FOVEATED_INSET)) {
@@ -146,7 +150,8 @@ namespace virtualdesktop_openxr {
 
         CHECK_MSG(ensureOVRSession(), "Failed to re-create OVR session\n");
 
-        if (viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO) {
+        if (viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO &&
+            !(has_XR_VARJO_quad_views && viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_QUAD_VARJO)) {
             if (viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_MONO ||
                 (m_apiMinor >= 1 &&
                  viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO_WITH_FOVEATED_INSET)) {
@@ -155,11 +160,13 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
-        if (viewCapacityInput && viewCapacityInput < xr::StereoView::Count) {
+        const bool isQuadViews = viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_QUAD_VARJO;
+        const uint32_t viewCount = !isQuadViews ? xr::StereoView::Count : xr::QuadView::Count;
+        if (viewCapacityInput && viewCapacityInput < viewCount) {
             return XR_ERROR_SIZE_INSUFFICIENT;
         }
 
-        *viewCountOutput = xr::StereoView::Count;
+        *viewCountOutput = viewCount;
         TraceLoggingWrite(
             g_traceProvider, "xrEnumerateViewConfigurationViews", TLArg(*viewCountOutput, "ViewCountOutput"));
 
@@ -181,14 +188,34 @@ namespace virtualdesktop_openxr {
                 views[i].maxSwapchainSampleCount = 4;
                 views[i].recommendedSwapchainSampleCount = 1;
 
+                // With quad views, the peripheral and focus views are rendered at different pixel densities.
+                XrFovf viewFov = m_cachedEyeFov[i % xr::StereoView::Count];
+                float pixelDensity = m_supersamplingFactor * m_upscalingMultiplier;
+                if (isQuadViews) {
+                    bool foveatedRenderingActive = false;
+                    const XrBaseInStructure* entry = reinterpret_cast<const XrBaseInStructure*>(views[i].next);
+                    while (entry) {
+                        if (has_XR_VARJO_foveated_rendering &&
+                            entry->type == XR_TYPE_FOVEATED_VIEW_CONFIGURATION_VIEW_VARJO) {
+                            foveatedRenderingActive =
+                                reinterpret_cast<const XrFoveatedViewConfigurationViewVARJO*>(entry)
+                                    ->foveatedRenderingActive;
+                        }
+                        entry = entry->next;
+                    }
+
+                    viewFov = getQuadViewsFov(i, foveatedRenderingActive);
+                    pixelDensity = m_supersamplingFactor * (i < xr::StereoView::Count ? m_quadViewsPeripheralDensity
+                                                                                      : m_quadViewsFocusDensity);
+                }
+
                 // Recommend the resolution with distortion accounted for.
                 ovrFovPort fov;
-                fov.UpTan = tan(m_cachedEyeFov[i].angleUp);
-                fov.DownTan = tan(-m_cachedEyeFov[i].angleDown);
-                fov.LeftTan = tan(-m_cachedEyeFov[i].angleLeft);
-                fov.RightTan = tan(m_cachedEyeFov[i].angleRight);
+                fov.UpTan = tan(viewFov.angleUp);
+                fov.DownTan = tan(-viewFov.angleDown);
+                fov.LeftTan = tan(-viewFov.angleLeft);
+                fov.RightTan = tan(viewFov.angleRight);
 
-                const float pixelDensity = m_supersamplingFactor * m_upscalingMultiplier;
                 const ovrSizei viewportSize = ovr_GetFovTextureSize(
                     m_ovrSession, (i % xr::StereoView::Count) == 0 ? ovrEye_Left : ovrEye_Right, fov, pixelDensity);
                 views[i].recommendedImageRectWidth =
@@ -388,6 +415,61 @@ namespace virtualdesktop_openxr {
             desc.BindFlags |= ovrTextureBind_DX_UnorderedAccess;
         }
 
+        // Reuse a recently destroyed swapchain with the same parameters, along with all the resources created for it.
+        Swapchain* recycledSwapchain = nullptr;
+        size_t swapchainPoolSize = 0;
+        if (!desc.StaticImage && m_swapchainPoolSize > 0) {
+            auto lock = lockSwapchainsExclusive();
+
+            recycledSwapchain = m_swapchainPool.acquire(*createInfo).value_or(nullptr);
+            swapchainPoolSize = m_swapchainPool.size();
+        }
+        TraceLoggingWrite(g_traceProvider,
+                          "SwapchainPool",
+                          TLArg(!!recycledSwapchain, "Hit"),
+                          TLArg(swapchainPoolSize, "Size"));
+        if (recycledSwapchain) {
+            Swapchain& xrSwapchain = *recycledSwapchain;
+            m_vramBudget.setPooled(&xrSwapchain, false);
+            xrSwapchain.xrDesc = *createInfo;
+            xrSwapchain.acquiredIndices.clear();
+            xrSwapchain.lastWaitedIndex = -1;
+            xrSwapchain.lastReleasedIndex = -1;
+            xrSwapchain.releaseGeneration = 0;
+            xrSwapchain.consumedGeneration = 0;
+            xrSwapchain.nextIndex = 0;
+            xrSwapchain.frozen = false;
+            xrSwapchain.appSwapchain.lastCommittedIndex = -1;
+            for (auto& slice : xrSwapchain.resolvedSlices) {
+                slice.lastCommittedIndex = -1;
+            }
+            for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+                xrSwapchain.stereoProjection[eye].lastCommittedIndex = -1;
+            }
+            xrSwapchain.downsampledLayer.slice.lastCommittedIndex = -1;
+            xrSwapchain.downsampledLayer.level = 0;
+            xrSwapchain.downsampledLayer.sourceIndex = -1;
+            for (auto& slice : xrSwapchain.resolvedSlices) {
+                std::fill(slice.writtenGenerations.begin(), slice.writtenGenerations.end(), 0);
+            }
+            {
+                std::unique_lock lock(xrSwapchain.damageHistoryMutex);
+                xrSwapchain.damageHistory.clear();
+            }
+
+            *swapchain = (XrSwapchain)&xrSwapchain;
+
+            {
+                auto lock = lockSwapchainsExclusive();
+
+                m_swapchains.insert(*swapchain);
+            }
+
+            TraceLoggingWrite(g_traceProvider, "xrCreateSwapchain", TLXArg(*swapchain, "Swapchain"));
+
+            return XR_SUCCESS;
+        }
+
         ovrTextureSwapChain ovrSwapchain{};
         int length = 0;
         // If and only if the swapchain images are directly usable by LibOVR, we create an OVR swapchain. Otherwise, we
@@ -401,7 +483,17 @@ namespace virtualdesktop_openxr {
                 Log("Creating a swapchain with texture array\n");
             }
             CHECK_OVRCMD(ovr_CreateTextureSwapChainDX(m_ovrSession, m_ovrSubmissionDevice.Get(), &desc, &ovrSwapchain));
+
+            // Do not leak the OVR swapchain if we cannot use it.
+            bool isUsable = false;
+            auto scopeGuard = MakeScopeGuard([&] {
+                if (!isUsable) {
+                    ovr_DestroyTextureSwapChain(m_ovrSession, ovrSwapchain);
+                }
+            });
             CHECK_OVRCMD(ovr_GetTextureSwapChainLength(m_ovrSession, ovrSwapchain, &length));
+            CHECK_MSG(length <= (int)Swapchain::MaxLength, "Swapchain is too long");
+            isUsable = true;
         } else {
             Log("Creating a slow-path swapchain (reason: %d)\n",
                 desc.Type != ovrTexture_2D ? 1
@@ -417,16 +509,27 @@ namespace virtualdesktop_openxr {
         xrSwapchain.ovrDesc = desc;
         xrSwapchain.xrDesc = *createInfo;
         xrSwapchain.dxgiFormatForSubmission = dxgiFormatForSubmission;
+        m_vramBudget.add(vram::Category::AppSwapchain, &xrSwapchain, estimateSwapchainMemory(desc, length));
 
         *swapchain = (XrSwapchain)&xrSwapchain;
 
         // Maintain a list of known swapchains for validation and cleanup.
         {
-            std::unique_lock lock(m_swapchainsMutex);
+            auto lock = lockSwapchainsExclusive();
 
             m_swapchains.insert(*swapchain);
         }
 
+        // Create the swapchains used to resolve texture arrays and multisampling now, rather than upon the first frame
+        // submitting them.
+        if (m_preWarmSwapchains && desc.Type == ovrTexture_2D &&
+            !(createInfo->usageFlags & XR_SWAPCHAIN_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) &&
+            (desc.ArraySize > 1 || !ovrSwapchain)) {
+            for (uint32_t slice = 0; slice < (uint32_t)desc.ArraySize; slice++) {
+                ensureSwapchainSliceResources(xrSwapchain, slice);
+            }
+        }
+
         TraceLoggingWrite(g_traceProvider, "xrCreateSwapchain", TLXArg(*swapchain, "Swapchain"));
 
         return XR_SUCCESS;
@@ -436,29 +539,42 @@ namespace virtualdesktop_openxr {
     XrResult OpenXrRuntime::xrDestroySwapchain(XrSwapchain swapchain) {
         TraceLoggingWrite(g_traceProvider, "xrDestroySwapchain", TLXArg(swapchain, "Swapchain"));
 
-        std::unique_lock lock(m_swapchainsMutex);
+        auto lock = lockSwapchainsExclusive();
 
         if (!m_swapchains.count(swapchain)) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
         // Make sure there are no pending operations.
-        if (isD3D12Session()) {
-            flushD3D12CommandQueue();
-        } else if (isVulkanSession()) {
-            flushVulkanCommandQueue();
-        } else if (isOpenGLSession()) {
-            flushOpenGLContext();
-        } else {
-            flushD3D11Context();
-        }
+        m_graphicsBackend->flush();
         if (m_useAsyncSubmission && !m_needStartAsyncSubmissionThread) {
             waitForAsyncSubmissionIdle();
         }
         flushSubmissionContext();
 
         Swapchain& xrSwapchain = *(Swapchain*)swapchain;
+        m_swapchains.erase(swapchain);
+
+        // Static images can only be committed once, they cannot be reused. Do not hold on to unused swapchains when
+        // running low on video memory.
+        auto evictedSwapchains = m_swapchainPool.setCapacity(
+            !m_vramBudget.getSheddingPolicy().releaseSwapchainPool ? m_swapchainPoolSize : 0);
+        if (!xrSwapchain.ovrDesc.StaticImage) {
+            m_vramBudget.setPooled(&xrSwapchain, true);
+            const auto overflow = m_swapchainPool.recycle(xrSwapchain.xrDesc, &xrSwapchain);
+            evictedSwapchains.insert(evictedSwapchains.end(), overflow.begin(), overflow.end());
+        } else {
+            evictedSwapchains.push_back(&xrSwapchain);
+        }
+
+        for (auto evictedSwapchain : evictedSwapchains) {
+            destroySwapchain(*evictedSwapchain);
+        }
+
+        return XR_SUCCESS;
+    }
 
+    void OpenXrRuntime::destroySwapchain(Swapchain& xrSwapchain) {
         if (!xrSwapchain.resolvedSlices.empty() && xrSwapchain.appSwapchain.ovrSwapchain &&
             xrSwapchain.resolvedSlices[0].ovrSwapchain != xrSwapchain.appSwapchain.ovrSwapchain) {
             ovr_DestroyTextureSwapChain(m_ovrSession, xrSwapchain.appSwapchain.ovrSwapchain);
@@ -475,14 +591,99 @@ namespace virtualdesktop_openxr {
                 ovr_DestroyTextureSwapChain(m_ovrSession, xrSwapchain.stereoProjection[eye].ovrSwapchain);
             }
         }
+        if (xrSwapchain.downsampledLayer.slice.ovrSwapchain) {
+            ovr_DestroyTextureSwapChain(m_ovrSession, xrSwapchain.downsampledLayer.slice.ovrSwapchain);
+        }
 
-        cleanupSwapchainImagesVulkan(xrSwapchain);
-        cleanupSwapchainImagesOpenGL(xrSwapchain);
+        if (m_graphicsBackend) {
+            m_graphicsBackend->cleanupSwapchainImages(xrSwapchain);
+        }
 
+        m_vramBudget.release(&xrSwapchain);
         delete &xrSwapchain;
-        m_swapchains.erase(swapchain);
+    }
 
-        return XR_SUCCESS;
+    // Monitor the video memory budget given by the OS, and release optional resources when getting close to it.
+    void OpenXrRuntime::updateVideoMemoryBudget() {
+        if (!m_useVideoMemoryBudget || !m_dxgiAdapter) {
+            // An unknown budget never causes pressure.
+            m_vramBudget.update(0, 0);
+            return;
+        }
+
+        const double now = ovr_GetTimeInSeconds();
+        if (now - m_lastVideoMemoryBudgetUpdate < 1.0) {
+            return;
+        }
+        m_lastVideoMemoryBudgetUpdate = now;
+
+        DXGI_QUERY_VIDEO_MEMORY_INFO queryVideoMemory{};
+        if (FAILED(m_dxgiAdapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &queryVideoMemory))) {
+            return;
+        }
+
+        const bool pressureChanged = m_vramBudget.update(queryVideoMemory.Budget, queryVideoMemory.CurrentUsage);
+        TraceLoggingWrite(g_traceProvider,
+                          "VideoMemoryBudget",
+                          TLArg(queryVideoMemory.Budget, "Budget"),
+                          TLArg(queryVideoMemory.CurrentUsage, "CurrentUsage"),
+                          TLArg(m_vramBudget.getUsage(vram::Category::AppSwapchain), "AppSwapchain"),
+                          TLArg(m_vramBudget.getUsage(vram::Category::ResolvedSlice), "ResolvedSlice"),
+                          TLArg(m_vramBudget.getUsage(vram::Category::StereoProjection), "StereoProjection"),
+                          TLArg(m_vramBudget.getUsage(vram::Category::Intermediate), "Intermediate"),
+                          TLArg(m_vramBudget.getUsage(vram::Category::DownsampledLayer), "DownsampledLayer"),
+                          TLArg(m_vramBudget.getUsage(vram::Category::MirrorWindow), "MirrorWindow"),
+                          TLArg(m_vramBudget.getPooledUsage(), "Pooled"),
+                          TLArg(vram::ToString(m_vramBudget.getPressure()), "Pressure"));
+        if (pressureChanged) {
+            Log("Video memory pressure: %s (%llu MB used out of %llu MB, %llu MB allocated by the runtime)\n",
+                vram::ToString(m_vramBudget.getPressure()),
+                queryVideoMemory.CurrentUsage >> 20,
+                queryVideoMemory.Budget >> 20,
+                m_vramBudget.getTotalUsage() >> 20);
+        }
+
+        if (m_vramBudget.getSheddingPolicy().releaseSwapchainPool && m_swapchainPool.size()) {
+            TraceLoggingWrite(g_traceProvider,
+                              "VideoMemoryBudget_ReleaseSwapchainPool",
+                              TLArg(m_swapchainPool.size(), "Size"),
+                              TLArg(m_vramBudget.getPooledUsage(), "Pooled"));
+            for (auto xrSwapchain : m_swapchainPool.drain()) {
+                destroySwapchain(*xrSwapchain);
+            }
+        }
+    }
+
+    // Take the swapchains registry lock, accounting for the time spent waiting when it is contended.
+    std::shared_lock<std::shared_mutex> OpenXrRuntime::lockSwapchainsShared() {
+        std::shared_lock lock(m_swapchainsMutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            CpuTimer timer;
+            timer.start();
+            lock.lock();
+            timer.stop();
+            recordSwapchainsLockWait(timer.query());
+        }
+        return lock;
+    }
+
+    std::unique_lock<std::shared_mutex> OpenXrRuntime::lockSwapchainsExclusive() {
+        std::unique_lock lock(m_swapchainsMutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            CpuTimer timer;
+            timer.start();
+            lock.lock();
+            timer.stop();
+            recordSwapchainsLockWait(timer.query());
+        }
+        return lock;
+    }
+
+    void OpenXrRuntime::recordSwapchainsLockWait(uint64_t durationUs) {
+        TraceLoggingWrite(g_traceProvider, "SwapchainsLock_Wait", TLArg(durationUs, "DurationUs"));
+
+        std::unique_lock lock(m_swapchainsLockStatisticsMutex);
+        m_swapchainsLockWaits.record(durationUs, false);
     }
 
     // https://www.khronos.org/registry/OpenXR/specs/1.0/html/xrspec.html#xrEnumerateSwapchainImages
@@ -495,7 +696,7 @@ namespace virtualdesktop_openxr {
                           TLXArg(swapchain, "Swapchain"),
                           TLArg(imageCapacityInput, "ImageCapacityInput"));
 
-        std::unique_lock lock(m_swapchainsMutex);
+        auto lock = lockSwapchainsExclusive();
 
         if (!m_swapchains.count(swapchain)) {
             return XR_ERROR_HANDLE_INVALID;
@@ -513,19 +714,7 @@ namespace virtualdesktop_openxr {
         TraceLoggingWrite(g_traceProvider, "xrEnumerateSwapchainImages", TLArg(*imageCountOutput, "ImageCountOutput"));
 
         if (imageCapacityInput && images) {
-            if (isD3D12Session()) {
-                XrSwapchainImageD3D12KHR* d3d12Images = reinterpret_cast<XrSwapchainImageD3D12KHR*>(images);
-                return getSwapchainImagesD3D12(xrSwapchain, d3d12Images, *imageCountOutput);
-            } else if (isVulkanSession()) {
-                XrSwapchainImageVulkanKHR* vkImages = reinterpret_cast<XrSwapchainImageVulkanKHR*>(images);
-                return getSwapchainImagesVulkan(xrSwapchain, vkImages, *imageCountOutput);
-            } else if (isOpenGLSession()) {
-                XrSwapchainImageOpenGLKHR* glImages = reinterpret_cast<XrSwapchainImageOpenGLKHR*>(images);
-                return getSwapchainImagesOpenGL(xrSwapchain, glImages, *imageCountOutput);
-            } else {
-                XrSwapchainImageD3D11KHR* d3d11Images = reinterpret_cast<XrSwapchainImageD3D11KHR*>(images);
-                return getSwapchainImagesD3D11(xrSwapchain, d3d11Images, *imageCountOutput);
-            }
+            return m_graphicsBackend->getSwapchainImages(xrSwapchain, images, *imageCountOutput);
         }
 
         return XR_SUCCESS;
@@ -541,7 +730,7 @@ namespace virtualdesktop_openxr {
 
         TraceLoggingWrite(g_traceProvider, "xrAcquireSwapchainImage", TLXArg(swapchain, "Swapchain"));
 
-        std::unique_lock lock(m_swapchainsMutex);
+        auto lock = lockSwapchainsShared();
 
         if (!m_swapchains.count(swapchain)) {
             return XR_ERROR_HANDLE_INVALID;
@@ -551,7 +740,7 @@ namespace virtualdesktop_openxr {
 
         // Check that we can acquire an image.
         if ((xrSwapchain.frozen && !m_allowStaticSwapchainsReuse) ||
-            xrSwapchain.acquiredIndices.size() == xrSwapchain.ovrSwapchainLength) {
+            xrSwapchain.acquiredIndices.size() == (size_t)xrSwapchain.ovrSwapchainLength) {
             return XR_ERROR_CALL_ORDER_INVALID;
         }
 
@@ -559,12 +748,9 @@ namespace virtualdesktop_openxr {
         // differently than OpenXR. We maintain our own index and there is logic in preprocessSwapchainImage() to ensure
         // we pass the correct image to the compositor.
         const int imageIndex = xrSwapchain.nextIndex;
-        xrSwapchain.acquiredIndices.push_back(imageIndex);
+        xrSwapchain.acquiredIndices.push(imageIndex);
         xrSwapchain.frozen = xrSwapchain.ovrDesc.StaticImage;
-        xrSwapchain.nextIndex = imageIndex + 1;
-        if ((int)xrSwapchain.nextIndex >= xrSwapchain.ovrSwapchainLength) {
-            xrSwapchain.nextIndex = 0;
-        }
+        xrSwapchain.nextIndex = (imageIndex + 1) % xrSwapchain.ovrSwapchainLength;
         *index = imageIndex;
 
         TraceLoggingWrite(g_traceProvider, "xrAcquireSwapchainImage", TLArg(*index, "Index"));
@@ -583,7 +769,7 @@ namespace virtualdesktop_openxr {
                           TLXArg(swapchain, "Swapchain"),
                           TLArg(waitInfo->timeout, "Timeout"));
 
-        std::unique_lock lock(m_swapchainsMutex);
+        auto lock = lockSwapchainsShared();
 
         if (!m_swapchains.count(swapchain)) {
             return XR_ERROR_HANDLE_INVALID;
@@ -592,12 +778,13 @@ namespace virtualdesktop_openxr {
         Swapchain& xrSwapchain = *(Swapchain*)swapchain;
 
         // Check an image is acquired but not waited.
-        if (xrSwapchain.acquiredIndices.empty() || xrSwapchain.acquiredIndices.front() == xrSwapchain.lastWaitedIndex) {
+        const auto acquiredIndex = xrSwapchain.acquiredIndices.front();
+        if (!acquiredIndex || acquiredIndex.value() == xrSwapchain.lastWaitedIndex) {
             return XR_ERROR_CALL_ORDER_INVALID;
         }
 
         // We assume that our frame timing in xrWaitFrame() guaranteed availability of the next image. No wait.
-        xrSwapchain.lastWaitedIndex = xrSwapchain.acquiredIndices.front();
+        xrSwapchain.lastWaitedIndex = acquiredIndex.value();
 
         return XR_SUCCESS;
     }
@@ -611,7 +798,7 @@ namespace virtualdesktop_openxr {
 
         TraceLoggingWrite(g_traceProvider, "xrReleaseSwapchainImage", TLXArg(swapchain, "Swapchain"));
 
-        std::unique_lock lock(m_swapchainsMutex);
+        auto lock = lockSwapchainsShared();
 
         if (!m_swapchains.count(swapchain)) {
             return XR_ERROR_HANDLE_INVALID;
@@ -620,17 +807,37 @@ namespace virtualdesktop_openxr {
         Swapchain& xrSwapchain = *(Swapchain*)swapchain;
 
         // Check an image is acquired and waited.
-        if (xrSwapchain.acquiredIndices.empty() || xrSwapchain.acquiredIndices.front() != xrSwapchain.lastWaitedIndex) {
+        const auto acquiredIndex = xrSwapchain.acquiredIndices.front();
+        if (!acquiredIndex || acquiredIndex.value() != xrSwapchain.lastWaitedIndex) {
             return XR_ERROR_CALL_ORDER_INVALID;
         }
 
+        std::optional<XrRect2Di> damageRect;
+        if (releaseInfo && has_XR_VDXR_swapchain_damage_region) {
+            const XrBaseInStructure* entry = reinterpret_cast<const XrBaseInStructure*>(releaseInfo->next);
+            while (entry) {
+                if (entry->type == XR_TYPE_SWAPCHAIN_IMAGE_DAMAGE_REGION_VDXR) {
+                    damageRect = reinterpret_cast<const XrSwapchainImageDamageRegionVDXR*>(entry)->damageRect;
+                    TraceLoggingWrite(g_traceProvider,
+                                      "xrReleaseSwapchainImage",
+                                      TLArg(xr::ToString(damageRect.value()).c_str(), "DamageRect"));
+                }
+                entry = entry->next;
+            }
+        }
+        {
+            // Recorded before publishing the new index, so that the resolve of this image finds its damage.
+            std::unique_lock lock(xrSwapchain.damageHistoryMutex);
+            xrSwapchain.damageHistory.record(xrSwapchain.releaseGeneration + 1, damageRect);
+        }
+
         // Update the state of the swapchain.
         // We never commit images here: this is because LibOVR producer/consumer model works much differently than
         // OpenXR. We will perform swapchain commits in preprocessSwapchainImage().
-        xrSwapchain.lastReleasedIndex = xrSwapchain.lastWaitedIndex;
+        xrSwapchain.lastReleasedIndex = acquiredIndex.value();
         xrSwapchain.lastWaitedIndex = -1;
-        xrSwapchain.dirty = true;
-        xrSwapchain.acquiredIndices.pop_front();
+        xrSwapchain.releaseGeneration++;
+        xrSwapchain.acquiredIndices.pop();
 
         return XR_SUCCESS;
     }
@@ -0,0 +1,166 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+namespace virtualdesktop_openxr::sync {
+
+    // How the submission device waits for the application's GPU work.
+    enum class WaitMode : int {
+        // Queue a wait on the submission context, the CPU never blocks.
+        Gpu = 0,
+        // Block the application thread until the fence is signaled.
+        Cpu,
+        // Block the application thread only while it is measured to be cheap, otherwise queue a wait on the GPU.
+        Adaptive,
+    };
+
+    enum class WaitDecision {
+        None,
+        Gpu,
+        Cpu,
+    };
+
+    // Where a blocking wait happens. Used to attribute time spent waiting.
+    enum class WaitSite : uint32_t {
+        FlushD3D11Context = 0,
+        FlushSubmissionContext,
+        FlushD3D12CommandQueue,
+        FlushVulkanCommandQueue,
+        EndFrameSync,
+
+        Count
+    };
+
+    static inline const char* ToString(WaitSite site) {
+        switch (site) {
+        case WaitSite::FlushD3D11Context:
+            return "FlushD3D11Context";
+        case WaitSite::FlushSubmissionContext:
+            return "FlushSubmissionContext";
+        case WaitSite::FlushD3D12CommandQueue:
+            return "FlushD3D12CommandQueue";
+        case WaitSite::FlushVulkanCommandQueue:
+            return "FlushVulkanCommandQueue";
+        case WaitSite::EndFrameSync:
+            return "EndFrameSync";
+        default:
+            return "Unknown";
+        }
+    }
+
+    // Accounting of the blocking waits for a given site.
+    struct WaitStatistics {
+        uint64_t count{0};
+        uint64_t timeouts{0};
+        uint64_t totalUs{0};
+        uint64_t maxUs{0};
+
+        void record(uint64_t durationUs, bool timedOut) {
+            count++;
+            timeouts += timedOut ? 1 : 0;
+            totalUs += durationUs;
+            maxUs = std::max(maxUs, durationUs);
+        }
+    };
+
+    // Chooses between GPU-side and CPU-side waits based on the outcome of the previous CPU waits. A CPU wait gives
+    // strict ordering and leaves the submission context free of pending waits, but it is only worth it when the
+    // application's GPU work is (nearly) done by the time we need it. In adaptive mode, CPU waits are bounded by a
+    // budget, and are re-attempted after falling back to GPU waits only when most of the frames of the last period
+    // found the work already done. A GPU-bound application never gets there, and is never stalled by a probe.
+    class SyncPolicy {
+      public:
+        SyncPolicy(uint64_t cpuWaitBudgetUs = 500, uint32_t probePeriod = 90)
+            : m_cpuWaitBudgetUs(cpuWaitBudgetUs), m_probePeriod(probePeriod) {
+        }
+
+        void setMode(WaitMode mode) {
+            if (mode != m_mode) {
+                m_mode = mode;
+                m_preferCpu = false;
+                m_framesSinceProbe = 0;
+                m_readyFramesSinceProbe = 0;
+                m_averageCpuWaitUs = 0;
+            }
+        }
+
+        WaitMode getMode() const {
+            return m_mode;
+        }
+
+        WaitDecision decide(uint64_t completedValue, uint64_t targetValue) {
+            const bool isReady = completedValue >= targetValue;
+            bool shouldProbe = false;
+            if (m_mode == WaitMode::Adaptive && !m_preferCpu) {
+                m_readyFramesSinceProbe += isReady ? 1 : 0;
+                if (++m_framesSinceProbe >= m_probePeriod) {
+                    shouldProbe = 2 * m_readyFramesSinceProbe >= m_probePeriod;
+                    m_framesSinceProbe = 0;
+                    m_readyFramesSinceProbe = 0;
+                }
+            }
+
+            if (isReady) {
+                return WaitDecision::None;
+            }
+
+            switch (m_mode) {
+            case WaitMode::Cpu:
+                return WaitDecision::Cpu;
+
+            case WaitMode::Adaptive:
+                return m_preferCpu || shouldProbe ? WaitDecision::Cpu : WaitDecision::Gpu;
+
+            default:
+                return WaitDecision::Gpu;
+            }
+        }
+
+        // How long a CPU wait may block before falling back to a GPU wait. 0 means no limit.
+        uint64_t getCpuWaitBudgetUs() const {
+            return m_mode == WaitMode::Adaptive ? m_cpuWaitBudgetUs : 0;
+        }
+
+        // Record the outcome of a CPU wait decided by this policy.
+        void recordCpuWait(uint64_t durationUs, bool completed) {
+            // Exponentially-weighted average, so that a single hitch does not flip the policy.
+            m_averageCpuWaitUs = m_averageCpuWaitUs ? (3 * m_averageCpuWaitUs + durationUs) / 4 : durationUs;
+            m_preferCpu = completed && m_averageCpuWaitUs < m_cpuWaitBudgetUs / 2;
+        }
+
+        bool isPreferringCpu() const {
+            return m_mode == WaitMode::Cpu || (m_mode == WaitMode::Adaptive && m_preferCpu);
+        }
+
+      private:
+        const uint64_t m_cpuWaitBudgetUs;
+        const uint32_t m_probePeriod;
+
+        WaitMode m_mode{WaitMode::Gpu};
+        bool m_preferCpu{false};
+        uint32_t m_framesSinceProbe{0};
+        uint32_t m_readyFramesSinceProbe{0};
+        uint64_t m_averageCpuWaitUs{0};
+    };
+
+} // namespace virtualdesktop_openxr::sync
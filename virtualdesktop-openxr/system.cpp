@@ -101,6 +101,7 @@ namespace virtualdesktop_openxr {
         XrSystemPropertiesBodyTrackingFullBodyMETA* fullBodyTrackingProperties = nullptr;
         XrSystemPropertiesBodyTrackingFidelityMETA* bodyTrackingFidelityProperties = nullptr;
         XrSystemHeadsetIdPropertiesMETA* headsetIdProperties = nullptr;
+        XrSystemFoveatedRenderingPropertiesVARJO* foveatedRenderingProperties = nullptr;
 
         XrBaseOutStructure* entry = reinterpret_cast<XrBaseOutStructure*>(properties->next);
         while (entry) {
@@ -132,6 +133,9 @@ namespace virtualdesktop_openxr {
             case XR_TYPE_SYSTEM_HEADSET_ID_PROPERTIES_META:
                 headsetIdProperties = reinterpret_cast<XrSystemHeadsetIdPropertiesMETA*>(entry);
                 break;
+            case XR_TYPE_SYSTEM_FOVEATED_RENDERING_PROPERTIES_VARJO:
+                foveatedRenderingProperties = reinterpret_cast<XrSystemFoveatedRenderingPropertiesVARJO*>(entry);
+                break;
             }
 
             entry = reinterpret_cast<XrBaseOutStructure*>(entry->next);
@@ -241,6 +245,16 @@ namespace virtualdesktop_openxr {
             memcpy(&headsetIdProperties->id, uuid, sizeof(uuid));
         }
 
+        if (has_XR_VARJO_foveated_rendering && foveatedRenderingProperties) {
+            foveatedRenderingProperties->supportsFoveatedRendering =
+                (m_eyeTrackingType != EyeTracking::None) ? XR_TRUE : XR_FALSE;
+
+            TraceLoggingWrite(
+                g_traceProvider,
+                "xrGetSystemProperties",
+                TLArg(!!foveatedRenderingProperties->supportsFoveatedRendering, "SupportsFoveatedRendering"));
+        }
+
         return XR_SUCCESS;
     }
 
@@ -271,7 +285,8 @@ namespace virtualdesktop_openxr {
 
         CHECK_MSG(ensureOVRSession(), "Failed to re-create OVR session\n");
 
-        if (viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO) {
+        if (viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO &&
+            !(has_XR_VARJO_quad_views && viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_QUAD_VARJO)) {
             if (viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_MONO ||
                 (m_apiMinor >= 1 &&
                  viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO_WITH_FOVEATED_INSET)) {
@@ -476,6 +491,7 @@ namespace virtualdesktop_openxr {
                           TLArg(m_ovrTimeFromTimeSpecTimeOffset, "OvrTimeFromTimeSpecTimeOffset"));
 
         m_isLowVideoMemorySystem = false;
+        m_dxgiAdapter.Reset();
         {
             // Detect low memory systems.
             ComPtr<IDXGIFactory1> dxgiFactory;
@@ -490,10 +506,10 @@ namespace virtualdesktop_openxr {
                 DXGI_ADAPTER_DESC1 desc;
                 CHECK_HRCMD(dxgiAdapter->GetDesc1(&desc));
                 if (!memcmp(&desc.AdapterLuid, &m_adapterLuid, sizeof(LUID))) {
-                    ComPtr<IDXGIAdapter3> dxgiAdapter3;
-                    if (SUCCEEDED(dxgiAdapter->QueryInterface(dxgiAdapter3.ReleaseAndGetAddressOf()))) {
+                    // Keep the adapter to monitor the video memory budget during the session.
+                    if (SUCCEEDED(dxgiAdapter->QueryInterface(m_dxgiAdapter.ReleaseAndGetAddressOf()))) {
                         DXGI_QUERY_VIDEO_MEMORY_INFO queryVideoMemory;
-                        if (SUCCEEDED(dxgiAdapter3->QueryVideoMemoryInfo(
+                        if (SUCCEEDED(m_dxgiAdapter->QueryVideoMemoryInfo(
                                 0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &queryVideoMemory))) {
                             m_isLowVideoMemorySystem = queryVideoMemory.Budget < 3'758'096'384;
                         }
@@ -531,24 +547,29 @@ namespace virtualdesktop_openxr {
             Log("Device is: %s (%d)\n", m_cachedHmdInfo.ProductName, m_cachedHmdInfo.Type);
 
             // Try initializing the body and eye tracking data through Virtual Desktop.
-            initializeBodyTrackingMmf();
+            initializeBodyStateSource();
 
             // We must latch the body tracking capabilities now, as they are not allowed to change later during the
             // lifetime of the system.
             m_eyeTrackingType = EyeTracking::None;
             if (!getSetting("simulate_eye_tracking").value_or(false)) {
-                if (m_bodyState && ovr_GetBool(m_ovrSession, "SupportsEyeTracking", false)) {
+                if (m_bodyStateSource &&
+                    (m_isBodyStateEmulated || ovr_GetBool(m_ovrSession, "SupportsEyeTracking", false))) {
                     m_eyeTrackingType = EyeTracking::Mmf;
                 }
             } else {
                 m_eyeTrackingType = EyeTracking::Simulated;
             }
 
-            if (m_bodyState) {
-                m_supportsHandTracking = ovr_GetBool(m_ovrSession, "SupportsHandTracking", false);
-                m_supportsFaceTracking = ovr_GetBool(m_ovrSession, "SupportsFaceTracking", false);
-                m_supportsBodyTracking = ovr_GetBool(m_ovrSession, "SupportsBodyTracking", false);
-                m_supportsFullBodyTracking = ovr_GetBool(m_ovrSession, "SupportsFullBodyTracking", false);
+            if (m_bodyStateSource) {
+                // Replayed and synthetic body state may provide any tracking, regardless of the headset.
+                const auto supports = [&](const char* key) {
+                    return m_isBodyStateEmulated || ovr_GetBool(m_ovrSession, key, false);
+                };
+                m_supportsHandTracking = supports("SupportsHandTracking");
+                m_supportsFaceTracking = supports("SupportsFaceTracking");
+                m_supportsBodyTracking = supports("SupportsBodyTracking");
+                m_supportsFullBodyTracking = supports("SupportsFullBodyTracking");
                 m_emulateViveTrackers = ovr_GetBool(m_ovrSession, "EmulateTrackers", false);
                 m_emulateIndexControllers = ovr_GetBool(m_ovrSession, "EmulateIndexControllers", false);
             } else {
@@ -558,7 +579,7 @@ namespace virtualdesktop_openxr {
 
             TraceLoggingWrite(g_traceProvider,
                               "OVR_ExtendedSupport",
-                              TLArg(!!m_bodyState, "HasBodyState"),
+                              TLArg(m_bodyStateSource ? m_bodyStateSource->GetName() : "None", "BodyStateSource"),
                               TLArg((int)m_eyeTrackingType, "EyeTrackingType"),
                               TLArg(m_supportsHandTracking, "SupportsHandTracking"),
                               TLArg(m_supportsFaceTracking, "SupportsFaceTracking"),
@@ -597,6 +618,9 @@ namespace virtualdesktop_openxr {
                           TLArg(m_supersamplingFactor, "SupersamplingFactor"),
                           TLArg(m_upscalingMultiplier, "UpscalingMultiplier"));
 
+        initializeDynamicResolution();
+        initializeQuadViews();
+
         // Setup common parameters.
         // Virtual Desktop has a mode called "Stage Tracking" which requires us to use floor as the origin. For Oculus,
         // we use eye level for convenience.
@@ -614,20 +638,29 @@ namespace virtualdesktop_openxr {
         }
     }
 
-    void OpenXrRuntime::initializeBodyTrackingMmf() {
-        *m_bodyStateFile.put() = OpenFileMapping(FILE_MAP_READ, false, L"VirtualDesktop.BodyState");
-        if (!m_bodyStateFile) {
-            TraceLoggingWrite(g_traceProvider, "VirtualDesktopBodyTracker_NotAvailable");
-            return;
-        }
-
-        m_bodyState = reinterpret_cast<BodyTracking::BodyStateV2*>(
-            MapViewOfFile(m_bodyStateFile.get(), FILE_MAP_READ, 0, 0, sizeof(BodyTracking::BodyStateV2)));
-        if (!m_bodyState) {
-            TraceLoggingWrite(g_traceProvider, "VirtualDesktopBodyTracker_MappingError_BodyStateV2");
+    void OpenXrRuntime::initializeBodyStateSource() {
+        // The body state normally comes from Virtual Desktop, but it can be replaced by a recording or a procedural
+        // animation in order to exercise hand, body, eye and face tracking without a headset.
+        // 0: Virtual Desktop, 1: synthetic, 2: replay.
+        const int sourceType = getSetting("body_state_source").value_or(0);
+        m_isBodyStateEmulated = sourceType != 0;
+        if (sourceType == 1) {
+            m_bodyStateSource = BodyTracking::CreateSyntheticBodyStateSource(
+                getSetting("body_state_synthetic_parts").value_or(BodyTracking::SyntheticAll),
+                getSetting("body_state_synthetic_rate").value_or(90));
+        } else if (sourceType == 2) {
+            m_bodyStateSource =
+                BodyTracking::CreateBodyStateReplayer(programData / "body_state.bin",
+                                                      getSetting("body_state_replay_speed").value_or(100) / 100.0,
+                                                      getSetting("body_state_replay_loop").value_or(true));
+        } else {
+            m_bodyStateSource = BodyTracking::CreateMmfBodyStateSource();
+        }
+
+        if (m_bodyStateSource && getSetting("body_state_record").value_or(false)) {
+            m_bodyStateSource = BodyTracking::CreateBodyStateRecorder(std::move(m_bodyStateSource),
+                                                                      programData / "body_state_record.bin");
         }
-
-        *m_bodyStateEvent.put() = OpenEvent(SYNCHRONIZE, false, L"VirtualDesktop.BodyStateEvent2");
     }
 
     void OpenXrRuntime::bodyStateWatcherThread() {
@@ -637,27 +670,20 @@ namespace virtualdesktop_openxr {
         SetThreadPriority(GetCurrentThread(),
                           getSetting("body_state_watcher_priority").value_or(THREAD_PRIORITY_TIME_CRITICAL));
 
+        BodyTracking::BodyStateV2 state{};
         while (true) {
             // Wait for the next update.
-            {
-                TraceLocalActivity(wait);
-                TraceLoggingWriteStart(wait, "BodyStateWatcherThread_Wait");
-                const auto status = WaitForSingleObject(m_bodyStateEvent.get(), 100 /* ms */);
-                TraceLoggingWriteStop(wait, "BodyStateWatcherThread_Wait", TLArg(status, "Status"));
-            }
+            const bool hasSample = m_bodyStateSource->WaitForSample(std::chrono::milliseconds(100), state);
 
             if (m_terminateBodyStateThread) {
                 break;
             }
 
             // Cache the new state.
-            {
+            if (hasSample) {
                 std::unique_lock lock(m_bodyStateMutex);
-                m_cachedBodyState = *m_bodyState;
+                m_cachedBodyState = state;
             }
-
-            // Avoid spurious wakeup when the event was not reset quickly-enough.
-            std::this_thread::sleep_for(std::chrono::milliseconds(5));
         }
 
         TraceLoggingWriteStop(local, "BodyStateWatcherThread");
@@ -0,0 +1,94 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    // Allocation of the slots of a timestamp query heap shared by several GPU timers. Each slot holds a pair of
+    // timestamp queries (start and stop) and the command lists to write them. A slot is owned by a timer from
+    // acquire() until release(), and cannot be handed out again until the GPU is done with its last submission.
+    class TimestampRing {
+      public:
+        explicit TimestampRing(uint32_t slotCount) : m_slots(slotCount) {
+        }
+
+        uint32_t size() const {
+            return (uint32_t)m_slots.size();
+        }
+
+        // Returns a slot that is not in use, or nothing if all slots are busy (the measurement is then skipped).
+        std::optional<uint32_t> acquire(uint64_t completedFenceValue) {
+            for (uint32_t i = 0; i < size(); i++) {
+                const uint32_t slot = (m_next + i) % size();
+                if (!m_slots[slot].isOwned && m_slots[slot].fenceValue <= completedFenceValue) {
+                    m_slots[slot].isOwned = true;
+                    m_slots[slot].fenceValue = 0;
+                    m_next = (slot + 1) % size();
+                    return slot;
+                }
+            }
+            m_exhausted++;
+            return {};
+        }
+
+        // The stop timestamp of the slot will be available once the fence reaches this value.
+        void submit(uint32_t slot, uint64_t fenceValue) {
+            m_slots[slot].fenceValue = fenceValue;
+        }
+
+        bool isReady(uint32_t slot, uint64_t completedFenceValue) const {
+            return m_slots[slot].fenceValue && m_slots[slot].fenceValue <= completedFenceValue;
+        }
+
+        // The slot may still be in flight, in which case it becomes available once the GPU completes it.
+        void release(uint32_t slot) {
+            m_slots[slot].isOwned = false;
+        }
+
+        // The number of times a measurement was skipped because all slots were busy.
+        uint64_t exhausted() const {
+            return m_exhausted;
+        }
+
+        static uint32_t startQuery(uint32_t slot) {
+            return slot * 2;
+        }
+
+        static uint32_t stopQuery(uint32_t slot) {
+            return slot * 2 + 1;
+        }
+
+      private:
+        struct Slot {
+            bool isOwned{false};
+            // The fence value of the last submission, 0 when nothing is in flight.
+            uint64_t fenceValue{0};
+        };
+
+        std::vector<Slot> m_slots;
+        uint32_t m_next{0};
+        uint64_t m_exhausted{0};
+    };
+
+} // namespace virtualdesktop_openxr::utils
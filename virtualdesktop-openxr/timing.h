@@ -0,0 +1,96 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+namespace virtualdesktop_openxr::utils {
+
+    // A generic timer.
+    struct ITimer {
+        virtual ~ITimer() = default;
+
+        virtual void start() = 0;
+        virtual void stop() = 0;
+
+        virtual uint64_t query(bool reset = true) const = 0;
+    };
+
+    // A synchronous CPU timer.
+    class CpuTimer : public ITimer {
+        using clock = std::chrono::high_resolution_clock;
+
+      public:
+        void start() override {
+            m_timeStart = clock::now();
+        }
+
+        void stop() override {
+            m_duration += clock::now() - m_timeStart;
+        }
+
+        uint64_t query(bool reset = true) const override {
+            const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(m_duration);
+            if (reset)
+                m_duration = clock::duration::zero();
+            return duration.count();
+        }
+
+      private:
+        clock::time_point m_timeStart;
+        mutable clock::duration m_duration{0};
+    };
+
+    // Paces a periodic task. Occurrences are scheduled on a fixed grid so that the rate does not drift, but when the
+    // task falls behind, the grid is moved forward instead of running a burst of late occurrences.
+    class RateLimiter {
+      public:
+        using clock = std::chrono::steady_clock;
+
+        void setRate(double occurrencesPerSecond) {
+            m_period = occurrencesPerSecond > 0 ? std::chrono::duration_cast<clock::duration>(
+                                                      std::chrono::duration<double>(1.0 / occurrencesPerSecond))
+                                                : clock::duration::zero();
+        }
+
+        // Returns true when the task is due, and schedules its next occurrence.
+        bool poll(clock::time_point now = clock::now()) {
+            if (now < m_next) {
+                return false;
+            }
+
+            m_next += m_period;
+            if (m_next <= now) {
+                m_next = now + m_period;
+            }
+            return true;
+        }
+
+        clock::duration timeUntilNext(clock::time_point now = clock::now()) const {
+            return now < m_next ? m_next - now : clock::duration::zero();
+        }
+
+      private:
+        clock::duration m_period{0};
+        clock::time_point m_next{};
+    };
+
+} // namespace virtualdesktop_openxr::utils
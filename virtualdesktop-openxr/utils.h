@@ -25,6 +25,9 @@
 #include "pch.h"
 
 #include "BodyState.h"
+#include "geometry.h"
+#include "spsc_ring.h"
+#include "timing.h"
 
 #define CHECK_OVRCMD(cmd) xr::detail::_CheckOVRResult(cmd, #cmd, FILE_AND_LINE)
 #define CHECK_VKCMD(cmd) xr::detail::_CheckVKResult(cmd, #cmd, FILE_AND_LINE)
@@ -230,41 +233,6 @@ namespace virtualdesktop_openxr::utils {
         return found;
     }
 
-    // A generic timer.
-    struct ITimer {
-        virtual ~ITimer() = default;
-
-        virtual void start() = 0;
-        virtual void stop() = 0;
-
-        virtual uint64_t query(bool reset = true) const = 0;
-    };
-
-    // A synchronous CPU timer.
-    class CpuTimer : public ITimer {
-        using clock = std::chrono::high_resolution_clock;
-
-      public:
-        void start() override {
-            m_timeStart = clock::now();
-        }
-
-        void stop() override {
-            m_duration += clock::now() - m_timeStart;
-        }
-
-        uint64_t query(bool reset = true) const override {
-            const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(m_duration);
-            if (reset)
-                m_duration = clock::duration::zero();
-            return duration.count();
-        }
-
-      private:
-        clock::time_point m_timeStart;
-        mutable clock::duration m_duration{0};
-    };
-
     // API dispatch table for Vulkan.
     struct VulkanDispatch {
         PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr{nullptr};
@@ -297,6 +265,7 @@ namespace virtualdesktop_openxr::utils {
         PFN_vkDestroyFence vkDestroyFence{nullptr};
         PFN_vkResetFences vkResetFences{nullptr};
         PFN_vkWaitForFences vkWaitForFences{nullptr};
+        PFN_vkGetFenceStatus vkGetFenceStatus{nullptr};
         PFN_vkDeviceWaitIdle vkDeviceWaitIdle{nullptr};
         PFN_vkCreateQueryPool vkCreateQueryPool{nullptr};
         PFN_vkDestroyQueryPool vkDestroyQueryPool{nullptr};
@@ -324,6 +293,9 @@ namespace virtualdesktop_openxr::utils {
         PFNGLQUERYCOUNTERPROC glQueryCounter{nullptr};
         PFNGLGETQUERYOBJECTIVPROC glGetQueryObjectiv{nullptr};
         PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v{nullptr};
+        PFNGLFENCESYNCPROC glFenceSync{nullptr};
+        PFNGLWAITSYNCPROC glWaitSync{nullptr};
+        PFNGLDELETESYNCPROC glDeleteSync{nullptr};
 
 #ifdef _DEBUG
         PFNGLDEBUGMESSAGECALLBACKPROC glDebugMessageCallback{nullptr};
@@ -345,7 +317,12 @@ namespace virtualdesktop_openxr::utils {
                 m_glDC = wglGetCurrentDC();
                 m_glRC = wglGetCurrentContext();
 
-                wglMakeCurrent(context.glDC, context.glRC);
+                // Making a context current flushes it: skip it when the context is already current, which is the
+                // case for most calls from the application's render thread.
+                m_needSwitch = m_glDC != context.glDC || m_glRC != context.glRC;
+                if (m_needSwitch) {
+                    wglMakeCurrent(context.glDC, context.glRC);
+                }
 
                 if (!m_ignoreErrors) {
                     // Reset error codes.
@@ -359,7 +336,9 @@ namespace virtualdesktop_openxr::utils {
             if (m_valid) {
                 const auto error = glGetError();
 
-                wglMakeCurrent(m_glDC, m_glRC);
+                if (m_needSwitch) {
+                    wglMakeCurrent(m_glDC, m_glRC);
+                }
 
                 if (!m_ignoreErrors) {
                     CHECK_MSG(error == GL_NO_ERROR, fmt::format("OpenGL error: 0x{:x}", error));
@@ -370,6 +349,7 @@ namespace virtualdesktop_openxr::utils {
       private:
         const bool m_valid;
         const bool m_ignoreErrors;
+        bool m_needSwitch{false};
         HDC m_glDC;
         HGLRC m_glRC;
     };
@@ -651,6 +631,28 @@ namespace virtualdesktop_openxr::utils {
         }
     }
 
+    static size_t ovrGetBytePerPixels(ovrTextureFormat format) {
+        switch (format) {
+        case OVR_FORMAT_D16_UNORM:
+            return 2;
+        case OVR_FORMAT_R16G16B16A16_FLOAT:
+        case OVR_FORMAT_D32_FLOAT_S8X24_UINT:
+            return 8;
+        default:
+            return 4;
+        }
+    }
+
+    // An estimate of the video memory used by a swapchain, ignoring alignment and compression.
+    static uint64_t estimateSwapchainMemory(const ovrTextureSwapChainDesc& desc, int length) {
+        uint64_t bytes = (uint64_t)desc.Width * desc.Height * ovrGetBytePerPixels(desc.Format) *
+                         std::max(desc.ArraySize, 1) * std::max(desc.SampleCount, 1);
+        if (desc.MipLevels != 1) {
+            bytes += bytes / 3;
+        }
+        return bytes * length;
+    }
+
     static inline bool isValidSwapchainRect(ovrTextureSwapChainDesc desc, const XrRect2Di& rect) {
         if (rect.offset.x < 0 || rect.offset.y < 0 || rect.extent.width <= 0 || rect.extent.height <= 0) {
             return false;
@@ -0,0 +1,39 @@
+#ifndef VDXR_SWAPCHAIN_DAMAGE_REGION_H_
+#define VDXR_SWAPCHAIN_DAMAGE_REGION_H_ 1
+
+/**********************
+Vendor-internal extension of this runtime, not part of the OpenXR XML API registry. The structure type value is NOT
+reserved with Khronos and may collide with a future registered extension: the runtime only advertises this extension
+when the swapchain_damage_region setting is enabled, for testing with cooperating applications.
+Language    :   C99
+***********************/
+
+#include <openxr/openxr.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef XR_VDXR_swapchain_damage_region
+
+#define XR_VDXR_swapchain_damage_region 1
+#define XR_VDXR_swapchain_damage_region_SPEC_VERSION 1
+#define XR_VDXR_SWAPCHAIN_DAMAGE_REGION_EXTENSION_NAME "XR_VDXR_swapchain_damage_region"
+static const XrStructureType XR_TYPE_SWAPCHAIN_IMAGE_DAMAGE_REGION_VDXR = (XrStructureType) 1000999000;
+
+// Chained to XrSwapchainImageReleaseInfo. The region of the image that the application updated since the previous
+// release of the swapchain. The content outside of this region must be identical to the previously released image.
+typedef struct XrSwapchainImageDamageRegionVDXR {
+    XrStructureType             type;
+    const void* XR_MAY_ALIAS    next;
+    XrRect2Di                   damageRect;
+} XrSwapchainImageDamageRegionVDXR;
+
+#endif /* XR_VDXR_swapchain_damage_region */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -62,7 +62,8 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        if (viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO) {
+        if (viewConfigurationType != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO &&
+            !(has_XR_VARJO_quad_views && viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_QUAD_VARJO)) {
             if (viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_MONO ||
                 (m_apiMinor >= 1 &&
                  viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO_WITH_FOVEATED_INSET)) {
@@ -71,10 +72,18 @@ namespace virtualdesktop_openxr {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
-        if (viewIndex >= xr::StereoView::Count) {
+        const bool isQuadViews = viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_QUAD_VARJO;
+        if (viewIndex >= (!isQuadViews ? xr::StereoView::Count : xr::QuadView::Count)) {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
+        // The focus views of quad views rendering do not reach the edges of the lenses.
+        if (viewIndex >= xr::StereoView::Count) {
+            visibilityMask->vertexCountOutput = 0;
+            visibilityMask->indexCountOutput = 0;
+            return XR_SUCCESS;
+        }
+
         // Ignore ridiculously big masks.
         if (m_overrideVisibilityMaskScale > 10.f) {
             visibilityMask->vertexCountOutput = 0;
@@ -0,0 +1,249 @@
+// MIT License
+//
+// Copyright(c) 2022-2024 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+namespace virtualdesktop_openxr::vram {
+
+    // The kinds of GPU resources allocated by the runtime (as opposed to the application).
+    enum class Category : uint32_t {
+        // OVR swapchains (or our own textures) backing the application swapchains.
+        AppSwapchain = 0,
+        // OVR swapchains receiving the copies/resolves of texture arrays and MSAA swapchains.
+        ResolvedSlice,
+        // OVR swapchains receiving the output of the upscaler and sharpener.
+        StereoProjection,
+        // Half-precision intermediate textures between upscaling and sharpening.
+        Intermediate,
+        // OVR swapchains receiving the reduced copies of oversampled quad and cylinder layers.
+        DownsampledLayer,
+        MirrorWindow,
+
+        Count
+    };
+
+    static inline const char* ToString(Category category) {
+        switch (category) {
+        case Category::AppSwapchain:
+            return "AppSwapchain";
+        case Category::ResolvedSlice:
+            return "ResolvedSlice";
+        case Category::StereoProjection:
+            return "StereoProjection";
+        case Category::Intermediate:
+            return "Intermediate";
+        case Category::DownsampledLayer:
+            return "DownsampledLayer";
+        case Category::MirrorWindow:
+            return "MirrorWindow";
+        default:
+            return "Unknown";
+        }
+    }
+
+    enum class Pressure {
+        None = 0,
+        // Release the resources that only serve to speed things up.
+        Moderate,
+        // Also degrade optional features.
+        Critical,
+    };
+
+    static inline const char* ToString(Pressure pressure) {
+        switch (pressure) {
+        case Pressure::None:
+            return "None";
+        case Pressure::Moderate:
+            return "Moderate";
+        case Pressure::Critical:
+            return "Critical";
+        default:
+            return "Unknown";
+        }
+    }
+
+    // What the runtime should give up on under the current memory pressure.
+    struct SheddingPolicy {
+        // Destroy the recycled swapchains and stop recycling.
+        bool releaseSwapchainPool{false};
+        // Upscale directly into the output, skipping sharpening and its intermediate textures.
+        bool skipSharpeningIntermediate{false};
+        // Reduce the resolution of the mirror window texture.
+        bool shrinkMirrorWindow{false};
+    };
+
+    // Accounting of the GPU memory allocated by the runtime, by category and by owner, and the policy deciding which
+    // optional resources to shed when the process approaches the OS-provided video memory budget.
+    // Thread-safe: the mirror window thread allocates concurrently with the application threads.
+    class BudgetManager {
+      public:
+        // Fractions of the budget at which the pressure raises, and below which it is lifted.
+        static constexpr double ModerateThreshold = 0.85;
+        static constexpr double CriticalThreshold = 0.95;
+        static constexpr double ReleaseThreshold = 0.75;
+
+        // Replace the size of the allocations of an owner for a category.
+        void set(Category category, const void* owner, uint64_t bytes) {
+            std::unique_lock lock(m_mutex);
+            auto& entry = m_owners[owner];
+            const uint64_t previous = entry.bytes[(uint32_t)category];
+            entry.bytes[(uint32_t)category] = bytes;
+            m_usage[(uint32_t)category] += bytes - previous;
+            if (entry.isPooled) {
+                m_pooledUsage += bytes - previous;
+            }
+        }
+
+        void add(Category category, const void* owner, uint64_t bytes) {
+            std::unique_lock lock(m_mutex);
+            auto& entry = m_owners[owner];
+            entry.bytes[(uint32_t)category] += bytes;
+            m_usage[(uint32_t)category] += bytes;
+            if (entry.isPooled) {
+                m_pooledUsage += bytes;
+            }
+        }
+
+        // Forget all the allocations of an owner.
+        void release(const void* owner) {
+            std::unique_lock lock(m_mutex);
+            const auto it = m_owners.find(owner);
+            if (it == m_owners.end()) {
+                return;
+            }
+            for (uint32_t i = 0; i < (uint32_t)Category::Count; i++) {
+                m_usage[i] -= it->second.bytes[i];
+            }
+            if (it->second.isPooled) {
+                m_pooledUsage -= it->second.total();
+            }
+            m_owners.erase(it);
+        }
+
+        // Owners sitting in a recycling pool still hold memory, but are accounted separately.
+        void setPooled(const void* owner, bool isPooled) {
+            std::unique_lock lock(m_mutex);
+            const auto it = m_owners.find(owner);
+            if (it == m_owners.end() || it->second.isPooled == isPooled) {
+                return;
+            }
+            it->second.isPooled = isPooled;
+            if (isPooled) {
+                m_pooledUsage += it->second.total();
+            } else {
+                m_pooledUsage -= it->second.total();
+            }
+        }
+
+        uint64_t getUsage(Category category) const {
+            std::unique_lock lock(m_mutex);
+            return m_usage[(uint32_t)category];
+        }
+
+        uint64_t getPooledUsage() const {
+            std::unique_lock lock(m_mutex);
+            return m_pooledUsage;
+        }
+
+        uint64_t getTotalUsage() const {
+            std::unique_lock lock(m_mutex);
+            uint64_t total = 0;
+            for (uint32_t i = 0; i < (uint32_t)Category::Count; i++) {
+                total += m_usage[i];
+            }
+            return total;
+        }
+
+        // Update the pressure from the budget and the current usage of the whole process (which includes the
+        // application's resources), as reported by the OS. Returns true when the pressure changed.
+        bool update(uint64_t budget, uint64_t processUsage) {
+            std::unique_lock lock(m_mutex);
+            m_budget = budget;
+            m_processUsage = processUsage;
+
+            const Pressure previous = m_pressure;
+            if (!budget) {
+                m_pressure = Pressure::None;
+            } else {
+                const double ratio = (double)processUsage / budget;
+                if (ratio >= CriticalThreshold) {
+                    m_pressure = Pressure::Critical;
+                } else if (ratio >= ModerateThreshold) {
+                    m_pressure = std::max(m_pressure, Pressure::Moderate);
+                } else if (ratio < ReleaseThreshold) {
+                    m_pressure = Pressure::None;
+                }
+                // Otherwise, keep the current pressure to avoid oscillating between allocating and freeing.
+            }
+            return m_pressure != previous;
+        }
+
+        Pressure getPressure() const {
+            std::unique_lock lock(m_mutex);
+            return m_pressure;
+        }
+
+        SheddingPolicy getSheddingPolicy() const {
+            std::unique_lock lock(m_mutex);
+            SheddingPolicy policy;
+            policy.releaseSwapchainPool = m_pressure >= Pressure::Moderate;
+            policy.skipSharpeningIntermediate = m_pressure >= Pressure::Critical;
+            policy.shrinkMirrorWindow = m_pressure >= Pressure::Critical;
+            return policy;
+        }
+
+        uint64_t getBudget() const {
+            std::unique_lock lock(m_mutex);
+            return m_budget;
+        }
+
+        uint64_t getProcessUsage() const {
+            std::unique_lock lock(m_mutex);
+            return m_processUsage;
+        }
+
+      private:
+        struct Owner {
+            uint64_t bytes[(uint32_t)Category::Count]{};
+            bool isPooled{false};
+
+            uint64_t total() const {
+                uint64_t total = 0;
+                for (uint32_t i = 0; i < (uint32_t)Category::Count; i++) {
+                    total += bytes[i];
+                }
+                return total;
+            }
+        };
+
+        mutable std::mutex m_mutex;
+        std::map<const void*, Owner> m_owners;
+        uint64_t m_usage[(uint32_t)Category::Count]{};
+        uint64_t m_pooledUsage{0};
+
+        uint64_t m_budget{0};
+        uint64_t m_processUsage{0};
+        Pressure m_pressure{Pressure::None};
+    };
+
+} // namespace virtualdesktop_openxr::vram
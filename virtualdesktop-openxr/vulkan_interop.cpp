@@ -518,13 +518,16 @@ namespace virtualdesktop_openxr {
 
         // Frame timers.
         if (queueSupportsTimers) {
+            // The timers share a query pool, with spare slots for measurements still in flight when queried.
+            auto queryPool = std::make_shared<VulkanTimestampQueryPool>(m_vkDispatch,
+                                                                        m_vkPhysicalDevice,
+                                                                        m_vkDevice,
+                                                                        m_vkQueue,
+                                                                        vkBindings.queueFamilyIndex,
+                                                                        m_vkAllocator,
+                                                                        2 * k_numGpuTimers);
             for (uint32_t i = 0; i < k_numGpuTimers; i++) {
-                m_gpuTimerApp[i] = std::make_unique<VulkanGpuTimer>(m_vkDispatch,
-                                                                    m_vkPhysicalDevice,
-                                                                    m_vkDevice,
-                                                                    m_vkQueue,
-                                                                    vkBindings.queueFamilyIndex,
-                                                                    m_vkAllocator);
+                m_gpuTimerApp[i] = std::make_unique<VulkanGpuTimer>(queryPool);
             }
         } else {
             Log("Queue does not support timestamps. Smart Smoothing will not work properly.\n");
@@ -568,6 +571,7 @@ namespace virtualdesktop_openxr {
         VK_GET_PTR(vkDestroyFence);
         VK_GET_PTR(vkResetFences);
         VK_GET_PTR(vkWaitForFences);
+        VK_GET_PTR(vkGetFenceStatus);
         VK_GET_PTR(vkDeviceWaitIdle);
         VK_GET_PTR(vkCreateQueryPool);
         VK_GET_PTR(vkDestroyQueryPool);
@@ -830,7 +834,24 @@ namespace virtualdesktop_openxr {
             CHECK_VKCMD(m_vkDispatch.vkResetFences(m_vkDevice, 1, &m_vkFenceForFlush));
             VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
             CHECK_VKCMD(m_vkDispatch.vkQueueSubmit(m_vkQueue, 1, &submitInfo, m_vkFenceForFlush));
-            CHECK_VKCMD(m_vkDispatch.vkWaitForFences(m_vkDevice, 1, &m_vkFenceForFlush, true, 1'000'000'000));
+
+            CpuTimer timer;
+            timer.start();
+            const VkResult result =
+                m_vkDispatch.vkWaitForFences(m_vkDevice, 1, &m_vkFenceForFlush, true, k_fenceWaitTimeoutUs * 1000);
+            timer.stop();
+
+            const bool timedOut = result == VK_TIMEOUT;
+            if (!timedOut) {
+                CHECK_VKCMD(result);
+            }
+            recordWait(sync::WaitSite::FlushVulkanCommandQueue, timer.query(), timedOut);
+            if (timedOut) {
+                ErrorLog("Timed out waiting in %s\n", sync::ToString(sync::WaitSite::FlushVulkanCommandQueue));
+
+                // The resources are released after the flush, keep waiting.
+                CHECK_VKCMD(m_vkDispatch.vkWaitForFences(m_vkDevice, 1, &m_vkFenceForFlush, true, UINT64_MAX));
+            }
         }
     }
 